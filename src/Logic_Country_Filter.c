@@ -44,6 +44,7 @@
 /* Global list of all tile polygons loaded from the CSV. */
 static GList *all_polygons  = NULL;
 static GList *all_countries = NULL;
+static gchar *csv_digest    = NULL;   /* SHA-256 of the loaded CSV */
 
 /* -------- Rectangular fast-path metadata -------- */
 /**
@@ -54,6 +55,7 @@ static GList *all_countries = NULL;
 typedef struct {
     double lat_min, lat_max;
     double lon_min, lon_max;
+    guint  index;      /* position in all_polygons / all_countries */
 } TileRect;
 
 /* Map original polygon pointer -> TileRect* (owned here) */
@@ -236,7 +238,8 @@ _free_all_polygons(void)
         g_free(l->data);
     g_list_free(all_countries);
     all_countries = NULL;
-
+    g_free(csv_digest);
+    csv_digest = NULL;
 }
 
 /**
@@ -244,23 +247,32 @@ _free_all_polygons(void)
  *   [3]=longitude center, [4]=latitude center,
  *   [5]=width, [6]=height
  * and appending one 4-corner polygon per row to all_polygons.
+ * The lines read are hashed into csv_digest.
  */
 static void
 _load_csv(const char *filename)
 {
+    g_free(csv_digest);
+    csv_digest = NULL;
+
     FILE *f = fopen(filename, "r");
     if (!f) {
         g_error("tool_init: cannot open CSV '%s': %s", filename, strerror(errno));
         return;
     }
     char line[1024];
+    guint n_rows = 0;
+    GChecksum *sum = g_checksum_new(G_CHECKSUM_SHA256);
     /* skip header, bail if we didn’t get one */
     if (fgets(line, sizeof(line), f) == NULL) {
+        g_checksum_free(sum);
         fclose(f);
         return;
     }
+    g_checksum_update(sum, (const guchar *)line, strlen(line));
 
     while (fgets(line, sizeof(line), f)) {
+        g_checksum_update(sum, (const guchar *)line, strlen(line));
         gchar **fld = g_strsplit(line, ",", -1);
         
         if (!fld[3] || !fld[4] || !fld[5] || !fld[6]) {
@@ -293,6 +305,7 @@ _load_csv(const char *filename)
         R->lat_max = fmax(fmax(corners[0].lat, corners[1].lat), fmax(corners[2].lat, corners[3].lat));
         R->lon_min = fmin(fmin(corners[0].lon, corners[1].lon), fmin(corners[2].lon, corners[3].lon));
         R->lon_max = fmax(fmax(corners[0].lon, corners[1].lon), fmax(corners[2].lon, corners[3].lon));
+        R->index   = n_rows++;
         g_hash_table_insert(rect_meta, arr, R);
 
         /* Index the rectangle bbox into the spatial grid (stores arr ptr) */
@@ -312,6 +325,8 @@ _load_csv(const char *filename)
     /* restore original order after prepend inserts */
     all_polygons  = g_list_reverse(all_polygons);
     all_countries = g_list_reverse(all_countries);
+    csv_digest = g_strdup(g_checksum_get_string(sum));
+    g_checksum_free(sum);
     fclose(f);
 
 }
@@ -360,6 +375,17 @@ void tool_cleanup(void)
     _free_all_polygons();
 }
 
+/**
+ * tool_get_digest() → const gchar*
+ * SHA-256 of the CSV read by the last tool_init(), or NULL if none was read.
+ * Taken at load time, so it always matches the polygons in memory.
+ */
+const gchar*
+tool_get_digest(void)
+{
+    return csv_digest;
+}
+
 /**
  * Get the list of all tile polygons (GArray* of GeoPoint) loaded from CSV.
  */
@@ -424,92 +450,30 @@ ephemeris_filter_by_polygons(GList *pass, GList *polygons)
 }
 
 /**
- * Build a GtkListStore from filtered ephemeris points,
- * inserting blank rows when time gaps exceed 30s.
+ * tool_find_territory(lat, lon) → gint
+ * Point lookup on the spatial grid: probe the 3×3 neighbourhood of the cell,
+ * test rectangles with the constant-time fast path and return the index of
+ * the first matching tile (aligned with tool_get_all_countries()), or -1.
  */
-GtkListStore*
-build_ephemeris_store(GList *filtered_pass)
+gint
+tool_find_territory(double lat, double lon)
 {
-    enum { COL_TIME, COL_LAT, COL_LON, N_COLS };
-    GtkListStore *store = gtk_list_store_new(
-        N_COLS,
-        G_TYPE_STRING,
-        G_TYPE_DOUBLE,
-        G_TYPE_DOUBLE);
-    GtkTreeIter iter;
-    guint last_t = 0;
-    for (GList *l = filtered_pass; l; l = l->next) {
-        ToolEphemPoint *pt = (ToolEphemPoint*)l->data;
-        if (last_t && pt->timestamp - last_t > 30) {
-            gtk_list_store_append(store, &iter);
-            gtk_list_store_set(store, &iter,
-                               COL_TIME, "",
-                               COL_LAT,  0.0,
-                               COL_LON,  0.0,
-                               -1);
+    if (!grid || !rect_meta)
+        return -1;
+
+    int cr, cc; latlon_to_cell(lat, lon, &cr, &cc);
+    for (int dr = -1; dr <= 1; ++dr) {
+        for (int dc = -1; dc <= 1; ++dc) {
+            CellKey key = { cr + dr, cc + dc };
+            GPtrArray *bucket = g_hash_table_lookup(grid, &key);
+            if (!bucket) continue;
+            for (guint i = 0; i < bucket->len; ++i) {
+                const TileRect *R = g_hash_table_lookup(rect_meta,
+                                                        g_ptr_array_index(bucket, i));
+                if (R && rect_contains(R, lat, lon))
+                    return (gint)R->index;
+            }
         }
-        char buf[64];
-        struct tm tm;
-        time_t t = pt->timestamp;
-        gmtime_r(&t, &tm);
-        strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S", &tm);
-        gtk_list_store_append(store, &iter);
-        gtk_list_store_set(store, &iter,
-                           COL_TIME, buf,
-                           COL_LAT,  pt->lat,
-                           COL_LON,  pt->lon,
-                           -1);
-        last_t = pt->timestamp;
     }
-    return store;
+    return -1;
 }
-
-/**
- * Convert a GtkTreeModel back into a list of ToolEphemPoint*.
- */
-GList*
-tool_list_from_model(GtkTreeModel *model)
-{
-    GList *out = NULL;
-    GtkTreeIter iter;
-
-    enum { COL_TIME, COL_LAT, COL_LON, N_COLS };
-
-    /* Start at the first row; if none, return NULL */
-    if (!gtk_tree_model_get_iter_first(model, &iter))
-        return NULL;
-
-    do {
-        gchar *timestr;
-        double lat, lon;
-
-        /* Pull the original timestamp string and coordinates */
-        gtk_tree_model_get(model, &iter,
-                           COL_TIME, &timestr,
-                           COL_LAT,  &lat,
-                           COL_LON,  &lon,
-                           -1);
-
-        /* Parse the timestamp string into a time_t */
-        struct tm tm = {0};
-        strptime(timestr, "%Y-%m-%d %H:%M:%S", &tm);
-        time_t t = timegm(&tm);
-
-        /* Allocate and populate the ephemeris point */
-        ToolEphemPoint *pt = g_new0(ToolEphemPoint, 1);
-        pt->timestamp = (guint)t;
-        pt->lat       = lat;
-        pt->lon       = lon;
-        pt->time_str  = timestr;  /* take ownership of the string */
-
-        out = g_list_prepend(out, pt);
-
-        /* Do NOT g_free(timestr)—we store it in pt->time_str */
-    } while (gtk_tree_model_iter_next(model, &iter));
-
-        /* restore chronological order */
-    out = g_list_reverse(out);
-    return out;
-
-}
-
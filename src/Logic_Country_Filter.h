@@ -21,7 +21,6 @@
 #define TOOL_H
 
 #include <glib.h>
-#include <gtk/gtk.h>
 
 /**
  * A lightweight ephemeris point used internally by the territory filter.
@@ -51,6 +50,9 @@ gboolean _point_in_poly(const GeoPoint *pts,
                         double          lat,
                         double          lon);
 
+/** Path to the territory tiles CSV shipped with the app */
+#define TERRITORY_CSV_FILE "src/Countries_tiles.csv"
+
 /**
  * Load tile polygons from a CSV file.
  * CSV must have columns:
@@ -62,6 +64,12 @@ void tool_init(const char *csv_path);
 /** Free all loaded territory data. */
 void tool_cleanup(void);
 
+/**
+ * SHA-256 (hex) of the CSV read by the last tool_init(), or NULL.
+ * Caller must not free the string.
+ */
+const gchar* tool_get_digest(void);
+
 /**
  * Return a GList of gchar* country names, in **exact** one‐to‐one order
  * with the polygons list. Caller must not free these strings.
@@ -81,18 +89,11 @@ GList* ephemeris_filter_by_polygons(GList *pass,
                                    GList *polygons);
 
 /**
- * Build a GtkListStore from filtered pass:
- *   - COL_TIME (string),
- *   - COL_LAT  (double),
- *   - COL_LON  (double),
- * inserting blank rows whenever >30 s gaps occur.
- */
-GtkListStore* build_ephemeris_store(GList *filtered_pass);
-
-/**
- * Convert an existing GtkTreeModel (with columns Time, Lat, Lon) into
- * a GList of ToolEphemPoint*. Caller must free each point and the list.
+ * Return the index of the tile containing (lat,lon), aligned with
+ * tool_get_all_countries() / tool_get_all_polygons(), or -1 if the point
+ * is outside every tile. Read-only; safe to call from worker threads once
+ * tool_init() has completed.
  */
-GList* tool_list_from_model(GtkTreeModel *model);
+gint tool_find_territory(double lat, double lon);
 
 #endif // TOOL_H
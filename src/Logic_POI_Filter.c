@@ -46,9 +46,11 @@
 #include <math.h>
 
 #include "Logic_Country_Filter.h"    /* for _point_in_poly prototype */
+#include "locator.h"                 /* great-circle kernels */
 
 /* Internal globals */
 static GList *all_polygons = NULL;
+static gchar *csv_digest   = NULL;   /* SHA-256 of the CSV read by lp_init */
 
 
 /**
@@ -213,10 +215,13 @@ static void grid_insert_bbox(double lat_min, double lat_max,
  * - Fallback: Center_Lat/Center_Lon + Tile_km (≤10 km squares) → convert to degrees at that latitude.
  * - For each tile: build 4-corner polygon (compat), store TileRect in poi_rects, index into grid.
  * - Prepend rows (O(1)); reverse once after reading to preserve CSV order.
+ * - Hash the lines read into csv_digest, see lp_get_digest().
  */
 gboolean lp_init(const char *csv_path, GError **err_out)
 {
     grid_reset();
+    g_free(csv_digest);
+    csv_digest = NULL;
 
     FILE *f = fopen(csv_path, "r");
     if (!f) {
@@ -226,11 +231,14 @@ gboolean lp_init(const char *csv_path, GError **err_out)
     }
 
     char line[2048];
+    GChecksum *sum = g_checksum_new(G_CHECKSUM_SHA256);
     /* read header */
     if (!fgets(line, sizeof(line), f)) {
+        g_checksum_free(sum);
         fclose(f);
         return FALSE;
     }
+    g_checksum_update(sum, (const guchar *)line, strlen(line));
 
     /* map header columns */
     gchar **hdr = g_strsplit(line, ",", -1);
@@ -250,6 +258,7 @@ gboolean lp_init(const char *csv_path, GError **err_out)
 
 
     while (fgets(line, sizeof(line), f)) {
+        g_checksum_update(sum, (const guchar *)line, strlen(line));
         gchar **fld = g_strsplit(line, ",", -1);
         
         /* Preferred path: read explicit bounds from CSV (Lat_min/Lat_max/Lon_min/Lon_max) */
@@ -316,6 +325,8 @@ gboolean lp_init(const char *csv_path, GError **err_out)
 
     /* restore original order after prepend insertions */
     all_polygons = g_list_reverse(all_polygons);
+    csv_digest = g_strdup(g_checksum_get_string(sum));
+    g_checksum_free(sum);
     fclose(f);
     return TRUE;
 
@@ -338,7 +349,8 @@ void lp_cleanup(void)
     all_polygons = NULL;
     if (poi_rects) { g_hash_table_destroy(poi_rects); poi_rects = NULL; }
     if (grid)      { g_hash_table_destroy(grid);      grid = NULL; }
-
+    g_free(csv_digest);
+    csv_digest = NULL;
 }
 
 /*----------------------------------------------------------------------*/
@@ -353,6 +365,16 @@ GList* lp_get_all_polygons(void)
     return all_polygons;
 }
 
+/**
+ * lp_get_digest() → const gchar*
+ * SHA-256 of the CSV read by the last lp_init(), or NULL if none was read.
+ * Taken at load time, so it always matches the polygons in memory.
+ */
+const gchar* lp_get_digest(void)
+{
+    return csv_digest;
+}
+
 /* Compute the centroid of a rectangular tile (average of corners 0 & 2) */
 LP_GeoPoint
 lp_polygon_center(GArray *poly)
@@ -437,18 +459,12 @@ gboolean lp_point_in_poly(const LP_GeoPoint *pts, guint n_pts,
 /**
  * lp_compute_distance_km(a, b) → km
  * Great-circle distance via haversine; helper for diagnostics/UI.
+ * Shares the math with the batch kernels in locator.c.
  */
 double lp_compute_distance_km(const LP_GeoPoint *a,
                               const LP_GeoPoint *b)
 {
-    const double R = 6371.0; /* Earth radius in km */
-    double dlat = (b->lat - a->lat) * G_PI/180.0;
-    double dlon = (b->lon - a->lon) * G_PI/180.0;
-    double lat1 = a->lat * G_PI/180.0;
-    double lat2 = b->lat * G_PI/180.0;
-    double h = sin(dlat/2)*sin(dlat/2) +
-               sin(dlon/2)*sin(dlon/2) * cos(lat1)*cos(lat2);
-    return 2 * R * atan2(sqrt(h), sqrt(1-h));
+    return gc_distance_km(a->lat, a->lon, b->lat, b->lon);
 }
 
 /*----------------------------------------------------------------------*/
@@ -461,14 +477,7 @@ double lp_compute_distance_km(const LP_GeoPoint *a,
 double lp_compute_bearing_deg(const LP_GeoPoint *from,
                               const LP_GeoPoint *to)
 {
-    double φ1 = from->lat * G_PI/180.0;
-    double φ2 = to->lat   * G_PI/180.0;
-    double Δλ = (to->lon - from->lon) * G_PI/180.0;
-    double y = sin(Δλ) * cos(φ2);
-    double x = cos(φ1)*sin(φ2) -
-               sin(φ1)*cos(φ2)*cos(Δλ);
-    double θ = atan2(y, x) * 180.0/G_PI;
-    return fmod(θ + 360.0, 360.0);
+    return gc_bearing_deg(from->lat, from->lon, to->lat, to->lon);
 }
 
 
@@ -43,6 +43,9 @@ void     lp_cleanup(void);
 /* Get loaded polygons (GArray* of LP_GeoPoint) */
 GList*   lp_get_all_polygons(void);
 
+/* SHA-256 (hex) of the CSV read by lp_init(), or NULL; do not free */
+const gchar* lp_get_digest(void);
+
 /* Filter ephemeris list to only points inside any tile */
 GList*   lp_filter_points_by_tiles(GList *all_ephemirs);
 
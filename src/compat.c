@@ -26,9 +26,11 @@
 #include <build-config.h>
 #endif
 #include <glib.h>
+#include <glib/gi18n.h>
 #include <stdlib.h>
 #include <locale.h>
 #include "compat.h"
+#include "sat-log.h"
 
 /**
  * Get data directory.
@@ -410,3 +412,28 @@ gchar const* get_locale_thousands_sep()
 
 	return locale->thousands_sep;
 }
+
+/**
+ * Save a GKeyFile structure to a file
+ *
+ * @param cfgdata is a pointer to the GKeyFile.
+ * @param filename is a pointer the filename string.
+ * @return 1 on error and zero on success.
+ *
+ */
+gboolean gpredict_save_key_file(GKeyFile * cfgdata, const char *filename)
+{
+    GError         *error = NULL; 
+
+    if (!g_key_file_save_to_file(cfgdata, filename, &error))
+    {
+        sat_log_log(SAT_LOG_LEVEL_ERROR,
+                    _("%s: Error writing config data (%s)."),
+                    __func__,
+                    error != NULL ? error->message : "unknown error");
+        g_clear_error(&error);
+        return 1;
+    }
+
+    return 0;
+}
@@ -25,4 +25,7 @@ gchar          *sat_file_name_from_catnum_s(gchar * catnum);
 
 gchar    const* get_locale_thousands_sep();
 
+gboolean        gpredict_save_key_file(GKeyFile * cfgdata,
+                                       const char *filename);
+
 #endif
@@ -0,0 +1,766 @@
+/*
+  OGpredict — extensions to Gpredict for operations planning
+
+  Copyright (C) 2025 Axel Osika <osikaaxel@gmail.com>
+
+  This file is part of OGpredict, a derivative of Gpredict.
+
+  OGpredict is free software: you can redistribute it and/or modify it
+  under the terms of the GNU General Public License as published by the
+  Free Software Foundation; either version 2 of the License, or (at your
+  option) any later version.  See the GNU General Public License for details.
+*/
+
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/**
+ * coverage-engine.c — grid coverage and revisit statistics
+ *
+ * Answers "how often does the constellation see each cell / each country
+ * and what is the longest gap": every satellite of the module is sampled
+ * at a fixed step, the footprint (or instrument swath) around the
+ * sub-satellite point is rasterised into a lat/lon grid, and each cell keeps
+ * its access count, first/last access and maximum revisit gap. Territories
+ * from Countries_tiles.csv are aggregated as a whole: a territory is covered
+ * at a sample if any of its cells is.
+ *
+ * Parallelism: the time axis is cut into chunks processed by a GThreadPool.
+ * Each chunk propagates its own satellite copies over its samples and fills
+ * its own statistics; chunks are then merged in time order. The chunking
+ * is fixed, the merge associative and its order fixed, so the result does
+ * not depend on the thread count or on scheduling.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <build-config.h>
+#endif
+
+#include <glib/gi18n.h>
+#include <math.h>
+#include <string.h>
+
+#include "coverage-engine.h"
+#include "gtk-sat-data.h"
+#include "Logic_Country_Filter.h"
+#include "predict-tools.h"
+#include "sat-log.h"
+#include "sgpsdp/sgp4sdp4.h"
+
+#define COV_EARTH_RADIUS_KM 6371.0
+
+/** Number of time chunks; enough to balance the load on up to 8 threads. */
+#define COV_NCHUNKS 32
+
+/** Binary export header. */
+#define COV_FILE_MAGIC   "OGCOVGRD"
+#define COV_FILE_VERSION 1
+
+/** Read-only analysis input, shared by all chunks. */
+typedef struct {
+    cov_params_t    params;
+    guint           nrows, ncols;
+    guint32         nsamples;
+    qth_t           qth;        /* dummy observer needed by predict_calc */
+    GPtrArray      *sats;       /* sat_t* master copies */
+    guint32        *cell_terr_off;      /* CSR offsets, ncells + 1 */
+    GArray         *cell_terr;  /* guint32 territory ids */
+    GPtrArray      *territories;        /* territory names */
+} CovJob;
+
+/** One time chunk and its private statistics. */
+typedef struct {
+    const CovJob   *job;
+    guint32         i0, i1;     /* samples [i0, i1) */
+    cov_stat_t     *cells;
+    cov_stat_t     *terr;
+    GCancellable   *cancel;
+} CovChunk;
+
+
+void cov_params_init(cov_params_t * params, gdouble start)
+{
+    g_return_if_fail(params != NULL);
+
+    params->start = start;
+    params->duration = 1.0;
+    params->step_sec = 60.0;
+    params->cell_deg = 1.0;
+    params->mode = COV_MODE_FOOTPRINT;
+    params->swath_km = 100.0;
+}
+
+/** Record that stat is covered at sample i. Returns FALSE if already done. */
+static inline gboolean cov_stat_hit(cov_stat_t * s, guint32 i)
+{
+    if (s->count == 0)
+    {
+        s->count = 1;
+        s->first = i;
+    }
+    else if (s->last == i)
+    {
+        /* already counted for this sample (other satellite) */
+        return FALSE;
+    }
+    else if (s->last + 1 != i)
+    {
+        /* new access after a gap */
+        s->count++;
+        if (i - s->last > s->max_gap)
+            s->max_gap = i - s->last;
+    }
+    s->last = i;
+
+    return TRUE;
+}
+
+/** Merge b into a; b covers samples after a. */
+static void cov_stat_merge(cov_stat_t * a, const cov_stat_t * b)
+{
+    guint32         gap;
+
+    if (b->count == 0)
+        return;
+
+    if (a->count == 0)
+    {
+        *a = *b;
+        return;
+    }
+
+    gap = b->first - a->last;
+    if (gap == 1)
+    {
+        /* the access continues across the chunk boundary */
+        a->count += b->count - 1;
+    }
+    else
+    {
+        a->count += b->count;
+        a->max_gap = MAX(a->max_gap, gap);
+    }
+    a->max_gap = MAX(a->max_gap, b->max_gap);
+    a->last = b->last;
+}
+
+static void cov_mark_cell(CovChunk * chunk, guint cell, guint32 i)
+{
+    const CovJob   *job = chunk->job;
+    guint32         k;
+
+    if (!cov_stat_hit(&chunk->cells[cell], i))
+        return;
+
+    for (k = job->cell_terr_off[cell]; k < job->cell_terr_off[cell + 1]; k++)
+        cov_stat_hit(&chunk->terr[g_array_index(job->cell_terr, guint32, k)],
+                     i);
+}
+
+/**
+ * Rasterise a spherical cap of radius radius_km around (lat0, lon0).
+ *
+ * A cell is covered when its centre lies inside the cap. For each row the
+ * longitude half-width follows from the spherical law of cosines.
+ */
+static void cov_rasterise(CovChunk * chunk, gdouble lat0, gdouble lon0,
+                          gdouble radius_km, guint32 i)
+{
+    const CovJob   *job = chunk->job;
+    gdouble         cell = job->params.cell_deg;
+    gdouble         cap = radius_km / COV_EARTH_RADIUS_KM;
+    gdouble         cap_deg = cap * 180.0 / G_PI;
+    gdouble         phi0 = lat0 * G_PI / 180.0;
+    gdouble         cos_cap = cos(cap);
+    gint            r0, r1, r, c0, c1, c;
+    gdouble         phi, arg, dlon;
+
+    r0 = (gint) floor((90.0 - MIN(lat0 + cap_deg, 90.0)) / cell);
+    r1 = (gint) floor((90.0 - MAX(lat0 - cap_deg, -90.0)) / cell);
+    r0 = CLAMP(r0, 0, (gint) job->nrows - 1);
+    r1 = CLAMP(r1, 0, (gint) job->nrows - 1);
+
+    for (r = r0; r <= r1; r++)
+    {
+        phi = (90.0 - (r + 0.5) * cell) * G_PI / 180.0;
+
+        if (fabs(cos(phi0) * cos(phi)) < 1e-12)
+            arg = (sin(phi0) * sin(phi) >= cos_cap) ? -1.0 : 2.0;
+        else
+            arg = (cos_cap - sin(phi0) * sin(phi)) / (cos(phi0) * cos(phi));
+
+        if (arg > 1.0)
+            continue;
+
+        if (arg <= -1.0)
+        {
+            /* the whole latitude circle is inside the cap */
+            for (c = 0; c < (gint) job->ncols; c++)
+                cov_mark_cell(chunk, r * job->ncols + c, i);
+            continue;
+        }
+
+        dlon = acos(arg) * 180.0 / G_PI;
+        c0 = (gint) floor((lon0 - dlon + 180.0) / cell);
+        c1 = (gint) floor((lon0 + dlon + 180.0) / cell);
+        if (c1 - c0 + 1 >= (gint) job->ncols)
+        {
+            c0 = 0;
+            c1 = job->ncols - 1;
+        }
+        for (c = c0; c <= c1; c++)
+        {
+            gint            cw = ((c % (gint) job->ncols) + job->ncols) %
+                job->ncols;
+
+            cov_mark_cell(chunk, r * job->ncols + cw, i);
+        }
+    }
+}
+
+static void cov_chunk_worker(gpointer data, gpointer user_data)
+{
+    CovChunk       *chunk = data;
+    const CovJob   *job = chunk->job;
+    qth_t          *qth = (qth_t *) & job->qth;
+    gdouble         step = job->params.step_sec / 86400.0;
+    GPtrArray      *sats;
+    guint32         i;
+    guint           k;
+
+    (void)user_data;
+
+    /* private copies; the propagator keeps state in sat_t */
+    sats = g_ptr_array_sized_new(job->sats->len);
+    for (k = 0; k < job->sats->len; k++)
+    {
+        sat_t          *copy = g_new0(sat_t, 1);
+
+        gtk_sat_data_copy_sat(g_ptr_array_index(job->sats, k), copy, qth);
+        g_ptr_array_add(sats, copy);
+    }
+
+    for (i = chunk->i0; i < chunk->i1; i++)
+    {
+        /* index * step from the exact start: no accumulated rounding */
+        gdouble         t = job->params.start + (gdouble) i * step;
+
+        if (g_cancellable_is_cancelled(chunk->cancel))
+            break;
+
+        for (k = 0; k < sats->len; k++)
+        {
+            sat_t          *sat = g_ptr_array_index(sats, k);
+            gdouble         radius;
+
+            predict_calc(sat, qth, t);
+            radius = (job->params.mode == COV_MODE_SWATH) ?
+                0.5 * job->params.swath_km : 0.5 * sat->footprint;
+            cov_rasterise(chunk, sat->ssplat, sat->ssplon, radius, i);
+        }
+    }
+
+    for (k = 0; k < sats->len; k++)
+        gtk_sat_data_free_sat(g_ptr_array_index(sats, k));
+    g_ptr_array_free(sats, TRUE);
+}
+
+static void cov_job_free(gpointer data)
+{
+    CovJob         *job = data;
+    guint           i;
+
+    if (job == NULL)
+        return;
+
+    for (i = 0; i < job->sats->len; i++)
+        gtk_sat_data_free_sat(g_ptr_array_index(job->sats, i));
+    g_ptr_array_free(job->sats, TRUE);
+    g_free(job->cell_terr_off);
+    g_array_unref(job->cell_terr);
+    if (job->territories)
+        g_ptr_array_unref(job->territories);
+    g_free(job);
+}
+
+/**
+ * Build the cell -> territory mapping from the tile list.
+ *
+ * Each tile marks the cells whose centre lies in its bounding box, and the
+ * cell containing the tile centre, so that tiles smaller than a cell are
+ * still represented.
+ */
+static void cov_job_map_territories(CovJob * job)
+{
+    guint           ncells = job->nrows * job->ncols;
+    GPtrArray     **lists = g_new0(GPtrArray *, ncells);
+    GHashTable     *ids = g_hash_table_new(g_str_hash, g_str_equal);
+    GList          *p, *n;
+    gdouble         cell = job->params.cell_deg;
+    guint           k;
+
+    job->territories = g_ptr_array_new_with_free_func(g_free);
+
+    for (p = tool_get_all_polygons(), n = tool_get_all_countries();
+         p != NULL && n != NULL; p = p->next, n = n->next)
+    {
+        GArray         *poly = p->data;
+        gdouble         lat_min = 90.0, lat_max = -90.0;
+        gdouble         lon_min = 180.0, lon_max = -180.0;
+        gpointer        idp;
+        guint           id;
+        gint            r, c, r0, r1, c0, c1;
+
+        if (!g_hash_table_lookup_extended(ids, n->data, NULL, &idp))
+        {
+            idp = GUINT_TO_POINTER(job->territories->len);
+            g_hash_table_insert(ids, n->data, idp);
+            g_ptr_array_add(job->territories, g_strdup(n->data));
+        }
+        id = GPOINTER_TO_UINT(idp);
+
+        for (k = 0; k < poly->len; k++)
+        {
+            GeoPoint       *pt = &g_array_index(poly, GeoPoint, k);
+
+            lat_min = MIN(lat_min, pt->lat);
+            lat_max = MAX(lat_max, pt->lat);
+            lon_min = MIN(lon_min, pt->lon);
+            lon_max = MAX(lon_max, pt->lon);
+        }
+
+        /* rows/cols whose centres fall inside the box, at least the
+           centre cell */
+        r0 = (gint) ceil((90.0 - lat_max) / cell - 0.5);
+        r1 = (gint) floor((90.0 - lat_min) / cell - 0.5);
+        c0 = (gint) ceil((lon_min + 180.0) / cell - 0.5);
+        c1 = (gint) floor((lon_max + 180.0) / cell - 0.5);
+        if (r0 > r1)
+            r0 = r1 = (gint) floor((90.0 - 0.5 * (lat_min + lat_max)) / cell);
+        if (c0 > c1)
+            c0 = c1 = (gint) floor((0.5 * (lon_min + lon_max) + 180.0) / cell);
+        r0 = CLAMP(r0, 0, (gint) job->nrows - 1);
+        r1 = CLAMP(r1, 0, (gint) job->nrows - 1);
+
+        for (r = r0; r <= r1; r++)
+        {
+            for (c = c0; c <= c1; c++)
+            {
+                guint           cw = ((c % (gint) job->ncols) + job->ncols) %
+                    job->ncols;
+                guint           idx = r * job->ncols + cw;
+                gboolean        dup = FALSE;
+
+                if (lists[idx] == NULL)
+                    lists[idx] = g_ptr_array_new();
+                for (k = 0; k < lists[idx]->len && !dup; k++)
+                    dup = GPOINTER_TO_UINT(g_ptr_array_index(lists[idx], k)) ==
+                        id;
+                if (!dup)
+                    g_ptr_array_add(lists[idx], GUINT_TO_POINTER(id));
+            }
+        }
+    }
+    g_hash_table_destroy(ids);
+
+    /* flatten into CSR arrays */
+    job->cell_terr_off = g_new0(guint32, ncells + 1);
+    job->cell_terr = g_array_new(FALSE, FALSE, sizeof(guint32));
+    for (k = 0; k < ncells; k++)
+    {
+        job->cell_terr_off[k] = job->cell_terr->len;
+        if (lists[k] != NULL)
+        {
+            guint           j;
+
+            for (j = 0; j < lists[k]->len; j++)
+            {
+                guint32         id =
+                    GPOINTER_TO_UINT(g_ptr_array_index(lists[k], j));
+
+                g_array_append_val(job->cell_terr, id);
+            }
+            g_ptr_array_free(lists[k], TRUE);
+        }
+    }
+    job->cell_terr_off[ncells] = job->cell_terr->len;
+    g_free(lists);
+}
+
+/** Snapshot satellites and territories; call from the main loop. */
+static CovJob  *cov_job_new(GHashTable * sats, const cov_params_t * params)
+{
+    CovJob         *job = g_new0(CovJob, 1);
+    GHashTableIter  iter;
+    gpointer        value;
+    gdouble         n;
+
+    job->params = *params;
+    job->nrows = (guint) ceil(180.0 / params->cell_deg);
+    job->ncols = (guint) ceil(360.0 / params->cell_deg);
+    n = floor(params->duration * 86400.0 / params->step_sec) + 1.0;
+    job->nsamples = (guint32) MIN(n, (gdouble) G_MAXUINT32 - 1);
+
+    job->sats = g_ptr_array_sized_new(sats ? g_hash_table_size(sats) : 0);
+    if (sats != NULL)
+    {
+        g_hash_table_iter_init(&iter, sats);
+        while (g_hash_table_iter_next(&iter, NULL, &value))
+        {
+            sat_t          *copy = g_new0(sat_t, 1);
+
+            gtk_sat_data_copy_sat(SAT(value), copy, &job->qth);
+            g_ptr_array_add(job->sats, copy);
+        }
+    }
+
+    cov_job_map_territories(job);
+
+    return job;
+}
+
+static cov_grid_t *cov_job_execute(CovJob * job, GCancellable * cancel)
+{
+    cov_grid_t     *grid;
+    CovChunk       *chunks;
+    GThreadPool    *pool;
+    guint           ncells = job->nrows * job->ncols;
+    guint           nthreads, nchunks, k;
+    guint32         per;
+
+    nthreads = CLAMP((guint) g_get_num_processors(), 1, 8);
+
+    /* fixed chunking, so that chunk boundaries do not follow the CPU count */
+    nchunks = MIN(COV_NCHUNKS, MAX(job->nsamples, 1));
+    per = (job->nsamples + nchunks - 1) / nchunks;
+
+    chunks = g_new0(CovChunk, nchunks);
+    pool = g_thread_pool_new(cov_chunk_worker, NULL, (gint) nthreads, FALSE,
+                             NULL);
+    for (k = 0; k < nchunks; k++)
+    {
+        chunks[k].job = job;
+        chunks[k].i0 = MIN(k * per, job->nsamples);
+        chunks[k].i1 = MIN((k + 1) * per, job->nsamples);
+        chunks[k].cells = g_new0(cov_stat_t, ncells);
+        chunks[k].terr = g_new0(cov_stat_t, MAX(job->territories->len, 1));
+        chunks[k].cancel = cancel;
+        g_thread_pool_push(pool, &chunks[k], NULL);
+    }
+    g_thread_pool_free(pool, FALSE, TRUE);      /* wait for completion */
+
+    grid = g_new0(cov_grid_t, 1);
+    grid->params = job->params;
+    grid->nrows = job->nrows;
+    grid->ncols = job->ncols;
+    grid->nsamples = job->nsamples;
+    grid->territories = g_ptr_array_ref(job->territories);
+
+    /* merge in time order */
+    grid->cells = chunks[0].cells;
+    grid->terr = chunks[0].terr;
+    for (k = 1; k < nchunks; k++)
+    {
+        guint           j;
+
+        for (j = 0; j < ncells; j++)
+            cov_stat_merge(&grid->cells[j], &chunks[k].cells[j]);
+        for (j = 0; j < job->territories->len; j++)
+            cov_stat_merge(&grid->terr[j], &chunks[k].terr[j]);
+        g_free(chunks[k].cells);
+        g_free(chunks[k].terr);
+    }
+    g_free(chunks);
+
+    return grid;
+}
+
+static gboolean cov_params_valid(const cov_params_t * params, GError ** error)
+{
+    if (params->duration <= 0.0 || params->step_sec <= 0.0 ||
+        params->cell_deg <= 0.0 || params->cell_deg > 90.0 ||
+        (params->mode == COV_MODE_SWATH && params->swath_km <= 0.0))
+    {
+        g_set_error(error, G_IO_ERROR, G_IO_ERROR_INVALID_ARGUMENT,
+                    _("Invalid coverage parameters"));
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+/**
+ * Run a coverage analysis synchronously.
+ *
+ * @param sats Satellites (catnr -> sat_t*); they are not modified.
+ * @param params Analysis parameters.
+ * @param cancel Optional cancellable.
+ * @param error Location for a GError or NULL.
+ * @return A new grid or NULL on error/cancellation.
+ */
+cov_grid_t     *coverage_run(GHashTable * sats, const cov_params_t * params,
+                             GCancellable * cancel, GError ** error)
+{
+    CovJob         *job;
+    cov_grid_t     *grid;
+
+    g_return_val_if_fail(params != NULL, NULL);
+
+    if (!cov_params_valid(params, error))
+        return NULL;
+
+    job = cov_job_new(sats, params);
+    grid = cov_job_execute(job, cancel);
+    cov_job_free(job);
+
+    if (g_cancellable_set_error_if_cancelled(cancel, error))
+    {
+        cov_grid_free(grid);
+        return NULL;
+    }
+
+    return grid;
+}
+
+static void cov_task_thread(GTask * task, gpointer source_object,
+                            gpointer task_data, GCancellable * cancel)
+{
+    cov_grid_t     *grid;
+
+    (void)source_object;
+
+    grid = cov_job_execute(task_data, cancel);
+    if (g_task_return_error_if_cancelled(task))
+    {
+        cov_grid_free(grid);
+        return;
+    }
+
+    g_task_return_pointer(task, grid, (GDestroyNotify) cov_grid_free);
+}
+
+/** Run a coverage analysis in a worker thread. */
+void coverage_run_async(GHashTable * sats, const cov_params_t * params,
+                        GCancellable * cancel, GAsyncReadyCallback callback,
+                        gpointer user_data)
+{
+    GTask          *task;
+    GError         *error = NULL;
+
+    g_return_if_fail(params != NULL);
+
+    task = g_task_new(NULL, cancel, callback, user_data);
+    g_task_set_source_tag(task, coverage_run_async);
+
+    if (!cov_params_valid(params, &error))
+    {
+        g_task_return_error(task, error);
+        g_object_unref(task);
+        return;
+    }
+
+    g_task_set_task_data(task, cov_job_new(sats, params), cov_job_free);
+    g_task_run_in_thread(task, cov_task_thread);
+    g_object_unref(task);
+}
+
+cov_grid_t     *coverage_run_finish(GAsyncResult * res, GError ** error)
+{
+    g_return_val_if_fail(g_task_is_valid(res, NULL), NULL);
+
+    return g_task_propagate_pointer(G_TASK(res), error);
+}
+
+void cov_grid_free(cov_grid_t * grid)
+{
+    if (grid == NULL)
+        return;
+
+    g_free(grid->cells);
+    g_free(grid->terr);
+    if (grid->territories)
+        g_ptr_array_unref(grid->territories);
+    g_free(grid);
+}
+
+/** Statistics of the cell containing (lat, lon). */
+const cov_stat_t *cov_grid_lookup(const cov_grid_t * grid, gdouble lat,
+                                  gdouble lon)
+{
+    gint            r, c;
+
+    r = (gint) floor((90.0 - lat) / grid->params.cell_deg);
+    c = (gint) floor((lon + 180.0) / grid->params.cell_deg);
+    r = CLAMP(r, 0, (gint) grid->nrows - 1);
+    c = ((c % (gint) grid->ncols) + grid->ncols) % grid->ncols;
+
+    return &grid->cells[r * grid->ncols + c];
+}
+
+gdouble cov_sample_to_jd(const cov_grid_t * grid, guint32 sample)
+{
+    return grid->params.start +
+        (gdouble) sample * grid->params.step_sec / 86400.0;
+}
+
+gdouble cov_gap_to_sec(const cov_grid_t * grid, guint32 gap)
+{
+    return (gdouble) gap * grid->params.step_sec;
+}
+
+static void put_u32(GByteArray * buf, guint32 v)
+{
+    v = GUINT32_TO_LE(v);
+    g_byte_array_append(buf, (const guint8 *)&v, sizeof(v));
+}
+
+static void put_f64(GByteArray * buf, gdouble d)
+{
+    guint64         v;
+
+    memcpy(&v, &d, sizeof(v));
+    v = GUINT64_TO_LE(v);
+    g_byte_array_append(buf, (const guint8 *)&v, sizeof(v));
+}
+
+static void put_stat(GByteArray * buf, const cov_stat_t * s)
+{
+    put_u32(buf, s->count);
+    put_u32(buf, s->first);
+    put_u32(buf, s->last);
+    put_u32(buf, s->max_gap);
+}
+
+/**
+ * Save the grid in binary form.
+ *
+ * Layout (all little-endian):
+ *
+ *   char[8]  "OGCOVGRD"
+ *   u32      version, nrows, ncols, nsamples, mode
+ *   f64      start_jd, step_sec, cell_deg, swath_km
+ *   nrows*ncols x { u32 count, first, last, max_gap }   row 0 = north
+ *   u32      nterritories
+ *   nterritories x { u32 len, char[len] name, u32 count, first, last, max_gap }
+ */
+gboolean cov_grid_save(const cov_grid_t * grid, const gchar * fname,
+                       GError ** error)
+{
+    GByteArray     *buf;
+    gboolean        ok;
+    guint           i, ncells;
+
+    g_return_val_if_fail(grid != NULL && fname != NULL, FALSE);
+
+    ncells = grid->nrows * grid->ncols;
+    buf = g_byte_array_sized_new(64 + ncells * sizeof(cov_stat_t));
+
+    g_byte_array_append(buf, (const guint8 *)COV_FILE_MAGIC, 8);
+    put_u32(buf, COV_FILE_VERSION);
+    put_u32(buf, grid->nrows);
+    put_u32(buf, grid->ncols);
+    put_u32(buf, grid->nsamples);
+    put_u32(buf, grid->params.mode);
+    put_f64(buf, grid->params.start);
+    put_f64(buf, grid->params.step_sec);
+    put_f64(buf, grid->params.cell_deg);
+    put_f64(buf, grid->params.swath_km);
+
+    for (i = 0; i < ncells; i++)
+        put_stat(buf, &grid->cells[i]);
+
+    put_u32(buf, grid->territories->len);
+    for (i = 0; i < grid->territories->len; i++)
+    {
+        const gchar    *name = g_ptr_array_index(grid->territories, i);
+        guint32         len = strlen(name);
+
+        put_u32(buf, len);
+        g_byte_array_append(buf, (const guint8 *)name, len);
+        put_stat(buf, &grid->terr[i]);
+    }
+
+    ok = g_file_set_contents(fname, (const gchar *)buf->data, buf->len,
+                             error);
+    g_byte_array_unref(buf);
+
+    if (ok)
+        sat_log_log(SAT_LOG_LEVEL_INFO,
+                    _("%s: Coverage grid written to %s"), __func__, fname);
+
+    return ok;
+}
+
+/* Append a sample time as ISO 8601 UTC. */
+static void put_sample_time(GString * out, const cov_grid_t * grid,
+                            guint32 sample)
+{
+    GDateTime      *dt;
+    gchar          *str;
+    gint64          usec;
+
+    usec = (gint64) llround((cov_sample_to_jd(grid, sample) - 2440587.5) *
+                            86400.0e6);
+    dt = g_date_time_new_from_unix_utc(usec / G_USEC_PER_SEC);
+    str = g_date_time_format(dt, "%Y-%m-%dT%H:%M:%SZ");
+    g_string_append(out, str);
+    g_free(str);
+    g_date_time_unref(dt);
+}
+
+/**
+ * Save the per-territory statistics as CSV.
+ *
+ * One line per territory: name, number of accesses, first and last covered
+ * sample (UTC, empty when never accessed) and the longest revisit gap in
+ * seconds. Names are quoted, with embedded quotes doubled.
+ */
+gboolean cov_grid_save_territories(const cov_grid_t * grid,
+                                   const gchar * fname, GError ** error)
+{
+    GString        *out;
+    gboolean        ok;
+    guint           i;
+
+    g_return_val_if_fail(grid != NULL && fname != NULL, FALSE);
+
+    out = g_string_new("territory,accesses,first_utc,last_utc,max_gap_s\n");
+
+    for (i = 0; i < grid->territories->len; i++)
+    {
+        const gchar    *name = g_ptr_array_index(grid->territories, i);
+        const cov_stat_t *s = &grid->terr[i];
+        const gchar    *p;
+
+        g_string_append_c(out, '"');
+        for (p = name; *p; p++)
+        {
+            if (*p == '"')
+                g_string_append_c(out, '"');
+            g_string_append_c(out, *p);
+        }
+        g_string_append_printf(out, "\",%u,", s->count);
+
+        if (s->count)
+        {
+            put_sample_time(out, grid, s->first);
+            g_string_append_c(out, ',');
+            put_sample_time(out, grid, s->last);
+        }
+        else
+        {
+            g_string_append_c(out, ',');
+        }
+        g_string_append_printf(out, ",%.0f\n",
+                               cov_gap_to_sec(grid, s->max_gap));
+    }
+
+    ok = g_file_set_contents(fname, out->str, out->len, error);
+    g_string_free(out, TRUE);
+
+    if (ok)
+        sat_log_log(SAT_LOG_LEVEL_INFO,
+                    _("%s: Territory coverage written to %s"), __func__,
+                    fname);
+
+    return ok;
+}
@@ -0,0 +1,97 @@
+/*
+  OGpredict — extensions to Gpredict for operations planning
+
+  Copyright (C) 2025 Axel Osika <osikaaxel@gmail.com>
+
+  This file is part of OGpredict, a derivative of Gpredict.
+
+  OGpredict is free software: you can redistribute it and/or modify it
+  under the terms of the GNU General Public License as published by the
+  Free Software Foundation; either version 2 of the License, or (at your
+  option) any later version.  See the GNU General Public License for details.
+*/
+
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#ifndef __COVERAGE_ENGINE_H__
+#define __COVERAGE_ENGINE_H__ 1
+
+#include <gio/gio.h>
+#include <glib.h>
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/** What is rasterised around the sub-satellite point. */
+typedef enum {
+    COV_MODE_FOOTPRINT = 0,     /*!< Full radio footprint (horizon circle) */
+    COV_MODE_SWATH              /*!< Instrument swath of params.swath_km */
+} cov_mode_t;
+
+/** Coverage analysis parameters. */
+typedef struct {
+    gdouble         start;      /*!< Start time (Julian date) */
+    gdouble         duration;   /*!< Duration in days */
+    gdouble         step_sec;   /*!< Sampling step in seconds */
+    gdouble         cell_deg;   /*!< Grid resolution in degrees */
+    cov_mode_t      mode;       /*!< Footprint or swath */
+    gdouble         swath_km;   /*!< Full swath width for COV_MODE_SWATH */
+} cov_params_t;
+
+/**
+ * Access statistics of one grid cell or territory.
+ *
+ * Times are sample indices; sample i is at params.start + i * step. An access
+ * is a run of consecutive covered samples, and gaps are measured from the
+ * last sample of one access to the first sample of the next.
+ */
+typedef struct {
+    guint32         count;      /*!< Number of accesses */
+    guint32         first;      /*!< First covered sample */
+    guint32         last;       /*!< Last covered sample */
+    guint32         max_gap;    /*!< Longest revisit gap in samples */
+} cov_stat_t;
+
+/** Result of a coverage analysis. */
+typedef struct {
+    cov_params_t    params;
+    guint           nrows;      /*!< Rows; row 0 is the northern edge */
+    guint           ncols;      /*!< Columns; column 0 starts at -180 deg */
+    guint32         nsamples;   /*!< Number of time samples */
+    cov_stat_t     *cells;      /*!< nrows * ncols cell statistics */
+    GPtrArray      *territories;        /*!< Territory names */
+    cov_stat_t     *terr;       /*!< Statistics aligned with territories */
+} cov_grid_t;
+
+void            cov_params_init(cov_params_t * params, gdouble start);
+
+cov_grid_t     *coverage_run(GHashTable * sats, const cov_params_t * params,
+                             GCancellable * cancel, GError ** error);
+void            coverage_run_async(GHashTable * sats,
+                                   const cov_params_t * params,
+                                   GCancellable * cancel,
+                                   GAsyncReadyCallback callback,
+                                   gpointer user_data);
+cov_grid_t     *coverage_run_finish(GAsyncResult * res, GError ** error);
+
+void            cov_grid_free(cov_grid_t * grid);
+const cov_stat_t *cov_grid_lookup(const cov_grid_t * grid, gdouble lat,
+                                  gdouble lon);
+gdouble         cov_sample_to_jd(const cov_grid_t * grid, guint32 sample);
+gdouble         cov_gap_to_sec(const cov_grid_t * grid, guint32 gap);
+gboolean        cov_grid_save(const cov_grid_t * grid, const gchar * fname,
+                              GError ** error);
+gboolean        cov_grid_save_territories(const cov_grid_t * grid,
+                                          const gchar * fname,
+                                          GError ** error);
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+}
+#endif
+/* *INDENT-ON* */
+
+#endif
@@ -0,0 +1,626 @@
+/*
+  OGpredict — extensions to Gpredict for operations planning
+
+  Copyright (C) 2025 Axel Osika <osikaaxel@gmail.com>
+
+  This file is part of OGpredict, a derivative of Gpredict.
+
+  OGpredict is free software: you can redistribute it and/or modify it
+  under the terms of the GNU General Public License as published by the
+  Free Software Foundation; either version 2 of the License, or (at your
+  option) any later version.  See the GNU General Public License for details.
+*/
+
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/**
+ * ephem-pipe.c — streaming ephemeris generation
+ *
+ * The ephemeris is produced in blocks of EPHEM_PIPE_BLOCK samples and each
+ * block is handed to every consumer through a bounded queue as soon as it
+ * is full.  Consumers (table fill, territory classification, POI matching)
+ * therefore run while the propagation is still going, and a run takes about
+ * as long as its slowest stage instead of the sum of all stages.
+ *
+ * A queue holds at most `capacity` blocks; the producer waits when a
+ * consumer falls behind, so memory stays bounded whatever the run length.
+ * Blocks are shared between the queues and reference counted.
+ *
+ * Waits poll the GCancellable every 50 ms, so cancelling the run releases
+ * the producer and all consumers without extra signalling.
+ *
+ * Several satellites are generated into one stream each, by
+ * ephem_pipe_run_n() on a few threads that take the satellites in turns;
+ * ephem_pipe_merge() then interleaves the streams by time into a single
+ * stream, so the consumers see one time-ordered ephemeris tagged with the
+ * satellite.
+ *
+ * Sample times come from an ephem_grid_t: an exact epoch and step in
+ * integer seconds and nanoseconds.  Sample i is computed from i alone, never
+ * by adding steps, so a week at 1 Hz keeps whole seconds, sub-second steps
+ * are exact, and every producer or slice of a run agrees on the time of a
+ * sample without having seen the ones before it.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <build-config.h>
+#endif
+
+#include <math.h>
+#include <string.h>
+
+#include "ephem-pipe.h"
+#include "predict-tools.h"
+
+/** Longest wait before the cancellable is polled again [us]. */
+#define EPHEM_PIPE_POLL 50000
+
+/** Julian date of 1970-01-01 00:00 UTC. */
+#define EPHEM_JD_UNIX 2440587.5
+
+#define NS_PER_S G_GINT64_CONSTANT(1000000000)
+#define S_PER_DAY G_GINT64_CONSTANT(86400)
+
+struct _ephem_queue {
+    GMutex          lock;
+    GCond           cond;       /* signalled on push, pop and close */
+    GQueue          blocks;
+    guint           capacity;
+    gboolean        closed;
+};
+
+static ephem_block_t *ephem_block_new(guint first)
+{
+    ephem_block_t  *block = g_new(ephem_block_t, 1);
+
+    block->first = first;
+    block->n = 0;
+    block->ref = 1;
+
+    return block;
+}
+
+ephem_block_t  *ephem_block_ref(ephem_block_t * block)
+{
+    g_atomic_int_inc(&block->ref);
+
+    return block;
+}
+
+void ephem_block_unref(ephem_block_t * block)
+{
+    if (block != NULL && g_atomic_int_dec_and_test(&block->ref))
+        g_free(block);
+}
+
+/**
+ * Create a queue.
+ *
+ * @param capacity Number of blocks the queue holds before push() waits.
+ */
+ephem_queue_t  *ephem_queue_new(guint capacity)
+{
+    ephem_queue_t  *queue = g_new0(ephem_queue_t, 1);
+
+    g_mutex_init(&queue->lock);
+    g_cond_init(&queue->cond);
+    g_queue_init(&queue->blocks);
+    queue->capacity = MAX(capacity, 1);
+
+    return queue;
+}
+
+/** Free a queue and the blocks left in it. */
+void ephem_queue_free(ephem_queue_t * queue)
+{
+    ephem_block_t  *block;
+
+    if (queue == NULL)
+        return;
+
+    while ((block = g_queue_pop_head(&queue->blocks)) != NULL)
+        ephem_block_unref(block);
+
+    g_cond_clear(&queue->cond);
+    g_mutex_clear(&queue->lock);
+    g_free(queue);
+}
+
+/**
+ * Append a block, waiting while the queue is full.
+ *
+ * @return TRUE if the block was queued; the queue then owns the reference.
+ *         FALSE if the queue is closed or the operation was cancelled; the
+ *         reference stays with the caller.
+ */
+gboolean ephem_queue_push(ephem_queue_t * queue, ephem_block_t * block,
+                          GCancellable * cancel)
+{
+    gboolean        ok = FALSE;
+
+    g_mutex_lock(&queue->lock);
+    while (!queue->closed && queue->blocks.length >= queue->capacity &&
+           !g_cancellable_is_cancelled(cancel))
+    {
+        g_cond_wait_until(&queue->cond, &queue->lock,
+                          g_get_monotonic_time() + EPHEM_PIPE_POLL);
+    }
+
+    if (!queue->closed && !g_cancellable_is_cancelled(cancel))
+    {
+        g_queue_push_tail(&queue->blocks, block);
+        g_cond_broadcast(&queue->cond);
+        ok = TRUE;
+    }
+    g_mutex_unlock(&queue->lock);
+
+    return ok;
+}
+
+/**
+ * Take the next block, waiting while the queue is empty.
+ *
+ * @return The block (the caller owns the reference) or NULL once the queue
+ *         is closed and drained, or the operation was cancelled.
+ */
+ephem_block_t  *ephem_queue_pop(ephem_queue_t * queue, GCancellable * cancel)
+{
+    ephem_block_t  *block = NULL;
+
+    g_mutex_lock(&queue->lock);
+    while (!queue->closed && queue->blocks.length == 0 &&
+           !g_cancellable_is_cancelled(cancel))
+    {
+        g_cond_wait_until(&queue->cond, &queue->lock,
+                          g_get_monotonic_time() + EPHEM_PIPE_POLL);
+    }
+
+    if (!g_cancellable_is_cancelled(cancel))
+    {
+        block = g_queue_pop_head(&queue->blocks);
+        if (block != NULL)
+            g_cond_broadcast(&queue->cond);
+    }
+    g_mutex_unlock(&queue->lock);
+
+    return block;
+}
+
+/**
+ * Take the next block without waiting.
+ *
+ * For consumers in the main loop.  done is set to TRUE when the queue is
+ * closed and drained.
+ */
+ephem_block_t  *ephem_queue_try_pop(ephem_queue_t * queue, gboolean * done)
+{
+    ephem_block_t  *block;
+
+    g_mutex_lock(&queue->lock);
+    block = g_queue_pop_head(&queue->blocks);
+    if (block != NULL)
+        g_cond_broadcast(&queue->cond);
+    *done = (block == NULL && queue->closed);
+    g_mutex_unlock(&queue->lock);
+
+    return block;
+}
+
+/** Mark the end of the stream; wakes up waiting consumers. */
+void ephem_queue_close(ephem_queue_t * queue)
+{
+    g_mutex_lock(&queue->lock);
+    queue->closed = TRUE;
+    g_cond_broadcast(&queue->cond);
+    g_mutex_unlock(&queue->lock);
+}
+
+/* Hand a block to every queue.  FALSE once the operation is cancelled or
+   every queue is closed, so that a producer stops when nobody listens. */
+static gboolean push_all(ephem_block_t * block, ephem_queue_t ** queues,
+                         guint nqueues, GCancellable * cancel)
+{
+    guint           i;
+    guint           open = 0;
+
+    for (i = 0; i < nqueues; i++)
+    {
+        if (queues[i] == NULL)
+            continue;
+
+        ephem_block_ref(block);
+        if (ephem_queue_push(queues[i], block, cancel))
+        {
+            open++;
+            continue;
+        }
+
+        ephem_block_unref(block);
+        if (g_cancellable_is_cancelled(cancel))
+            return FALSE;
+    }
+
+    return open > 0;
+}
+
+static gint64 floor_div(gint64 a, gint64 b)
+{
+    return (a / b) - ((a % b) < 0);
+}
+
+/**
+ * Set up a time grid.
+ *
+ * @param jd Epoch (Julian date, UTC).  It is kept to the millisecond; a
+ *           Julian date in a double carries no more than ~40 us anyway.
+ * @param step_ns Step [ns].
+ */
+void ephem_grid_init(ephem_grid_t * grid, gdouble jd, gint64 step_ns)
+{
+    gdouble         days = floor(jd - EPHEM_JD_UNIX);
+    gdouble         secs = (jd - EPHEM_JD_UNIX - days) * 86400.0;
+    gdouble         whole = floor(secs);
+    gint64          ms = (gint64) llround((secs - whole) * 1000.0);
+
+    grid->sec = (gint64) days * S_PER_DAY + (gint64) whole + ms / 1000;
+    grid->ns = (gint32) ((ms % 1000) * 1000000);
+    grid->step_ns = MAX(step_ns, 1);
+}
+
+/** Number of samples from the epoch to epoch + duration_s, both included. */
+guint ephem_grid_count(const ephem_grid_t * grid, guint duration_s)
+{
+    gint64          n = (gint64) duration_s * NS_PER_S / grid->step_ns + 1;
+
+    return (guint) MIN(n, (gint64) G_MAXUINT32);
+}
+
+/* Exact time of sample i as seconds since 1970 plus nanoseconds.  The step
+   is split into whole seconds and the rest so i * step cannot overflow. */
+static void grid_time(const ephem_grid_t * grid, guint64 i, gint64 * sec,
+                      gint64 * ns)
+{
+    gint64          step_s = grid->step_ns / NS_PER_S;
+    gint64          frac = grid->ns + (gint64) i * (grid->step_ns % NS_PER_S);
+
+    *sec = grid->sec + (gint64) i * step_s + frac / NS_PER_S;
+    *ns = frac % NS_PER_S;
+}
+
+/** Time of sample i (Julian date, UTC). */
+gdouble ephem_grid_jd(const ephem_grid_t * grid, guint64 i)
+{
+    gint64          sec, ns, day;
+
+    grid_time(grid, i, &sec, &ns);
+    day = floor_div(sec, S_PER_DAY);
+
+    /* whole days and the time of day are summed once, at the end */
+    return (EPHEM_JD_UNIX + (gdouble) day) +
+        ((gdouble) (sec - day * S_PER_DAY) + (gdouble) ns * 1e-9) / 86400.0;
+}
+
+/* Gregorian date of a day count since 1970-01-01 (H. Hinnant's
+   civil_from_days), in integers only. */
+static void civil_from_days(gint64 z, gint * y, gint * m, gint * d)
+{
+    gint64          era, yy;
+    guint           doe, yoe, doy, mp;
+
+    z += 719468;
+    era = (z >= 0 ? z : z - 146096) / 146097;
+    doe = (guint) (z - era * 146097);
+    yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    yy = (gint64) yoe + era * 400;
+    doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    mp = (5 * doy + 2) / 153;
+    *d = (gint) (doy - (153 * mp + 2) / 5 + 1);
+    *m = (gint) (mp < 10 ? mp + 3 : mp - 9);
+    *y = (gint) (yy + (*m <= 2));
+}
+
+/**
+ * Format the time of sample i as "YYYY/MM/DD HH:MM:SS".
+ *
+ * Milliseconds (".mmm") are added when the step is not a whole number of
+ * seconds.  The time is truncated to the last digit shown, not rounded, so
+ * samples a step apart never share a label.
+ */
+void ephem_grid_format(const ephem_grid_t * grid, guint64 i, gchar * buf,
+                       gsize len)
+{
+    gint64          sec, ns, day, sod;
+    gint            y, mo, d;
+
+    grid_time(grid, i, &sec, &ns);
+    day = floor_div(sec, S_PER_DAY);
+    sod = sec - day * S_PER_DAY;
+    civil_from_days(day, &y, &mo, &d);
+
+    if (grid->step_ns % NS_PER_S == 0)
+        g_snprintf(buf, len, "%04d/%02d/%02d %02d:%02d:%02d", y, mo, d,
+                   (gint) (sod / 3600), (gint) (sod / 60 % 60),
+                   (gint) (sod % 60));
+    else
+        g_snprintf(buf, len, "%04d/%02d/%02d %02d:%02d:%02d.%03d", y, mo, d,
+                   (gint) (sod / 3600), (gint) (sod / 60 % 60),
+                   (gint) (sod % 60), (gint) (ns / 1000000));
+}
+
+/** Compute samples first .. first + EPHEM_PIPE_BLOCK - 1 (at most n) of sat. */
+static ephem_block_t *run_block(sat_t * sat, qth_t * qth,
+                                const ephem_grid_t * grid, guint first,
+                                guint n)
+{
+    ephem_block_t  *block = ephem_block_new(first);
+    ephem_sample_t *s;
+    guint           i;
+
+    for (i = first; i < n && block->n < EPHEM_PIPE_BLOCK; i++)
+    {
+        s = &block->samples[block->n++];
+        s->jd = ephem_grid_jd(grid, i);
+        s->t = i;
+        s->sat = 0;
+        predict_calc(sat, qth, s->jd);
+        predict_get_subsatellite_coords(sat, &s->lat, &s->lon);
+    }
+
+    return block;
+}
+
+/**
+ * Generate an ephemeris into a set of queues.
+ *
+ * @param sat The satellite; a private copy is propagated.
+ * @param qth The observer.
+ * @param grid Sample times.
+ * @param n Number of samples, see ephem_grid_count().
+ * @param queues Consumer queues; NULL entries are skipped.
+ * @param nqueues Number of entries in queues.
+ * @param cancel Optional cancellable.
+ * @return The number of samples produced.
+ *
+ * Sample i is at ephem_grid_jd(grid, i).  The run stops early once every
+ * queue has been closed by its consumer.  All queues are closed on return,
+ * including on cancellation.  Runs in a worker thread.
+ */
+guint ephem_pipe_run(const sat_t * sat, qth_t * qth,
+                     const ephem_grid_t * grid, guint n,
+                     ephem_queue_t ** queues, guint nqueues,
+                     GCancellable * cancel)
+{
+    sat_t           sat_copy = *sat;
+    ephem_block_t  *block;
+    guint           first, i;
+    guint           done = 0;
+
+    for (first = 0; first < n && done == first; first += EPHEM_PIPE_BLOCK)
+    {
+        if (g_cancellable_is_cancelled(cancel))
+            break;
+
+        block = run_block(&sat_copy, qth, grid, first, n);
+        if (push_all(block, queues, nqueues, cancel))
+            done += block->n;
+        ephem_block_unref(block);
+    }
+
+    for (i = 0; i < nqueues; i++)
+        if (queues[i] != NULL)
+            ephem_queue_close(queues[i]);
+
+    return g_cancellable_is_cancelled(cancel) ? 0 : done;
+}
+
+/**
+ * Generate the ephemerides of several satellites, one stream each.
+ *
+ * @param sats The satellites; private copies are propagated.
+ * @param nsats Number of satellites.
+ * @param qth The observer.
+ * @param grid Sample times, shared by all satellites.
+ * @param n Number of samples per satellite.
+ * @param queues One queue per satellite; NULL entries are skipped.
+ * @param cancel Optional cancellable.
+ * @return The number of samples produced for the longest stream.
+ *
+ * The satellites take turns block by block, so every stream advances in
+ * step with the others.  ephem_pipe_merge() needs a block of each stream
+ * at the same time; with the streams advancing together one thread can
+ * feed any number of them without waiting on itself, and a fixed number
+ * of threads can share the satellites of a run.  A satellite is dropped
+ * once its queue is closed by the consumer, the run once all are.  All
+ * queues are closed on return, including on cancellation.  Runs in a
+ * worker thread.
+ */
+guint ephem_pipe_run_n(const sat_t * sats, guint nsats, qth_t * qth,
+                       const ephem_grid_t * grid, guint n,
+                       ephem_queue_t ** queues, GCancellable * cancel)
+{
+    sat_t          *copies = g_new(sat_t, MAX(nsats, 1));
+    gboolean       *closed = g_new0(gboolean, MAX(nsats, 1));
+    ephem_block_t  *block;
+    guint           first, k;
+    guint           live = 0;
+    guint           done = 0;
+
+    memcpy(copies, sats, nsats * sizeof(sat_t));
+    for (k = 0; k < nsats; k++)
+    {
+        closed[k] = (queues[k] == NULL);
+        live += !closed[k];
+    }
+
+    for (first = 0; first < n && live > 0; first += EPHEM_PIPE_BLOCK)
+    {
+        for (k = 0; k < nsats && live > 0; k++)
+        {
+            if (g_cancellable_is_cancelled(cancel))
+            {
+                live = 0;
+                break;
+            }
+            if (closed[k])
+                continue;
+
+            /* a stream whose consumer has left is not computed further */
+            block = run_block(&copies[k], qth, grid, first, n);
+            if (push_all(block, &queues[k], 1, cancel))
+            {
+                done = MAX(done, first + block->n);
+            }
+            else
+            {
+                closed[k] = TRUE;
+                live--;
+            }
+            ephem_block_unref(block);
+        }
+    }
+
+    for (k = 0; k < nsats; k++)
+        if (queues[k] != NULL)
+            ephem_queue_close(queues[k]);
+    g_free(closed);
+    g_free(copies);
+
+    return g_cancellable_is_cancelled(cancel) ? 0 : done;
+}
+
+/**
+ * Feed recorded samples into a set of queues.
+ *
+ * @param samples The samples of an earlier run, in stream order.
+ * @param n Number of samples.
+ * @param queues Consumer queues; NULL entries are skipped.
+ * @param nqueues Number of entries in queues.
+ * @param cancel Optional cancellable.
+ * @return The number of samples fed.
+ *
+ * The consumers get the same blocks as from the run that produced the
+ * samples.  Feeding stops early once every queue has been closed by its
+ * consumer.  All queues are closed on return, including on cancellation.
+ * Runs in a worker thread.
+ */
+guint ephem_pipe_replay(const ephem_sample_t * samples, guint n,
+                        ephem_queue_t ** queues, guint nqueues,
+                        GCancellable * cancel)
+{
+    ephem_block_t  *block;
+    guint           first, i;
+    guint           done = 0;
+
+    for (first = 0; first < n && done == first; first += EPHEM_PIPE_BLOCK)
+    {
+        if (g_cancellable_is_cancelled(cancel))
+            break;
+
+        block = ephem_block_new(first);
+        block->n = MIN(EPHEM_PIPE_BLOCK, n - first);
+        memcpy(block->samples, samples + first,
+               block->n * sizeof(ephem_sample_t));
+        if (push_all(block, queues, nqueues, cancel))
+            done += block->n;
+        ephem_block_unref(block);
+    }
+
+    for (i = 0; i < nqueues; i++)
+        if (queues[i] != NULL)
+            ephem_queue_close(queues[i]);
+
+    return g_cancellable_is_cancelled(cancel) ? 0 : done;
+}
+
+/**
+ * Merge time-ordered streams into one.
+ *
+ * @param in Input queues, each in time order; NULL entries are skipped.
+ * @param nin Number of entries in in.
+ * @param out Consumer queues; NULL entries are skipped.
+ * @param nout Number of entries in out.
+ * @param cancel Optional cancellable.
+ * @return The number of samples produced.
+ *
+ * Output samples keep their time and index; their sat field is set to the
+ * input they came from.  Samples with the same time come out in input
+ * order.  All queues, input and output, are closed on return, including
+ * on cancellation.  Runs in a worker thread.
+ */
+guint ephem_pipe_merge(ephem_queue_t ** in, guint nin, ephem_queue_t ** out,
+                       guint nout, GCancellable * cancel)
+{
+    ephem_block_t **cur = g_new0(ephem_block_t *, MAX(nin, 1));
+    guint          *pos = g_new0(guint, MAX(nin, 1));
+    gboolean       *done = g_new0(gboolean, MAX(nin, 1));
+    ephem_block_t  *block = NULL;
+    ephem_sample_t *s;
+    guint           n = 0;
+    guint           i;
+    gint            best;
+    gboolean        ok = TRUE;
+
+    while (ok)
+    {
+        best = -1;
+        for (i = 0; i < nin; i++)
+        {
+            if (cur[i] != NULL && pos[i] == cur[i]->n)
+            {
+                ephem_block_unref(cur[i]);
+                cur[i] = NULL;
+            }
+            if (cur[i] == NULL && in[i] != NULL && !done[i])
+            {
+                cur[i] = ephem_queue_pop(in[i], cancel);
+                pos[i] = 0;
+                done[i] = (cur[i] == NULL);
+            }
+            if (cur[i] != NULL &&
+                (best < 0 || cur[i]->samples[pos[i]].jd <
+                 cur[best]->samples[pos[best]].jd))
+                best = (gint) i;
+        }
+        if (best < 0)
+            break;
+
+        if (block == NULL)
+            block = ephem_block_new(n);
+
+        s = &block->samples[block->n++];
+        *s = cur[best]->samples[pos[best]++];
+        s->sat = (guint32) best;
+        n++;
+
+        if (block->n == EPHEM_PIPE_BLOCK)
+        {
+            ok = push_all(block, out, nout, cancel);
+            ephem_block_unref(block);
+            block = NULL;
+        }
+    }
+
+    if (block != NULL)
+    {
+        if (ok)
+            push_all(block, out, nout, cancel);
+        ephem_block_unref(block);
+    }
+
+    /* leaving early must not stall the producers */
+    for (i = 0; i < nin; i++)
+    {
+        ephem_block_unref(cur[i]);
+        if (in[i] != NULL)
+            ephem_queue_close(in[i]);
+    }
+    g_free(cur);
+    g_free(pos);
+    g_free(done);
+
+    for (i = 0; i < nout; i++)
+        if (out[i] != NULL)
+            ephem_queue_close(out[i]);
+
+    return g_cancellable_is_cancelled(cancel) ? 0 : n;
+}
@@ -0,0 +1,108 @@
+/*
+  OGpredict — extensions to Gpredict for operations planning
+
+  Copyright (C) 2025 Axel Osika <osikaaxel@gmail.com>
+
+  This file is part of OGpredict, a derivative of Gpredict.
+
+  OGpredict is free software: you can redistribute it and/or modify it
+  under the terms of the GNU General Public License as published by the
+  Free Software Foundation; either version 2 of the License, or (at your
+  option) any later version.  See the GNU General Public License for details.
+*/
+
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#ifndef __EPHEM_PIPE_H__
+#define __EPHEM_PIPE_H__ 1
+
+#include <gio/gio.h>
+#include <glib.h>
+
+#include "qth-data.h"
+#include "sgpsdp/sgp4sdp4.h"
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/** Samples per block. */
+#define EPHEM_PIPE_BLOCK 4096
+
+/**
+ * Time grid of a run: sample i is at epoch + i * step.
+ *
+ * The epoch is held as whole seconds plus nanoseconds and the step in
+ * nanoseconds, so the time of any sample is exact and does not depend on
+ * how the samples before it were produced.
+ */
+typedef struct {
+    gint64          sec;        /*!< Epoch, seconds since 1970-01-01 00:00 UTC */
+    gint32          ns;         /*!< Epoch, nanoseconds into sec, 0..999999999 */
+    gint64          step_ns;    /*!< Step [ns], > 0 */
+} ephem_grid_t;
+
+/** One ephemeris sample. */
+typedef struct {
+    gdouble         jd;         /*!< Time (Julian date, UTC) */
+    gdouble         lat;        /*!< Sub-satellite latitude [deg] */
+    gdouble         lon;        /*!< Sub-satellite longitude [deg] */
+    guint32         t;          /*!< Sample index in its satellite's run */
+    guint32         sat;        /*!< Input of ephem_pipe_merge(), else 0 */
+} ephem_sample_t;
+
+/** A reference counted block of consecutive samples. */
+typedef struct {
+    guint           first;      /*!< Index of samples[0] in the run */
+    guint           n;          /*!< Number of valid samples */
+    gint            ref;        /*!< Reference count */
+    ephem_sample_t  samples[EPHEM_PIPE_BLOCK];
+} ephem_block_t;
+
+typedef struct _ephem_queue ephem_queue_t;
+
+ephem_block_t  *ephem_block_ref(ephem_block_t * block);
+void            ephem_block_unref(ephem_block_t * block);
+
+ephem_queue_t  *ephem_queue_new(guint capacity);
+void            ephem_queue_free(ephem_queue_t * queue);
+gboolean        ephem_queue_push(ephem_queue_t * queue,
+                                 ephem_block_t * block,
+                                 GCancellable * cancel);
+ephem_block_t  *ephem_queue_pop(ephem_queue_t * queue, GCancellable * cancel);
+ephem_block_t  *ephem_queue_try_pop(ephem_queue_t * queue,
+                                    gboolean * done);
+void            ephem_queue_close(ephem_queue_t * queue);
+
+void            ephem_grid_init(ephem_grid_t * grid, gdouble jd,
+                                gint64 step_ns);
+guint           ephem_grid_count(const ephem_grid_t * grid,
+                                 guint duration_s);
+gdouble         ephem_grid_jd(const ephem_grid_t * grid, guint64 i);
+void            ephem_grid_format(const ephem_grid_t * grid, guint64 i,
+                                  gchar * buf, gsize len);
+
+guint           ephem_pipe_run(const sat_t * sat, qth_t * qth,
+                               const ephem_grid_t * grid, guint n,
+                               ephem_queue_t ** queues, guint nqueues,
+                               GCancellable * cancel);
+guint           ephem_pipe_run_n(const sat_t * sats, guint nsats,
+                                 qth_t * qth, const ephem_grid_t * grid,
+                                 guint n, ephem_queue_t ** queues,
+                                 GCancellable * cancel);
+guint           ephem_pipe_merge(ephem_queue_t ** in, guint nin,
+                                 ephem_queue_t ** out, guint nout,
+                                 GCancellable * cancel);
+guint           ephem_pipe_replay(const ephem_sample_t * samples, guint n,
+                                  ephem_queue_t ** queues, guint nqueues,
+                                  GCancellable * cancel);
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+}
+#endif
+/* *INDENT-ON* */
+
+#endif
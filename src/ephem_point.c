@@ -18,20 +18,11 @@
 
 #include "ephem_point.h"
 #include "predict-tools.h"    /* for predict_calc() */
+#include "time-tools.h"       /* for jd_to_gregorian() */
 #include <glib/gprintf.h>     /* for g_strdup_printf */
 #include <stdlib.h>
 #include <math.h>
 
-/* Forward‐declare the Gregorian converter from gtk-sat-map-ground-track.c */
-void jd_to_gregorian(double jd,
-                    int   *year_out,
-                    int   *month_out,
-                    int   *day_out,
-                    int   *hour_out,
-                    int   *min_out,
-                    int   *sec_out);
-
-
 void free_ephem_point(gpointer data) {
     EphemPoint *p = (EphemPoint*)data;
     g_free(p->time_str);
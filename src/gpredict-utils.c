@@ -480,32 +480,6 @@ char           *gpredict_strcasestr(const char *s1, const char *s2)
     return NULL;
 }
 
-/**
- * Save a GKeyFile structure to a file
- *
- * @param cfgdata is a pointer to the GKeyFile.
- * @param filename is a pointer the filename string.
- * @return 1 on error and zero on success.
- *
- */
-gboolean gpredict_save_key_file(GKeyFile * cfgdata, const char *filename)
-{
-    GError         *error = NULL; 
-
-    if (!g_key_file_save_to_file(cfgdata, filename, &error))
-    {
-        sat_log_log(SAT_LOG_LEVEL_ERROR,
-                    _("%s: Error writing config data (%s)."),
-                    __func__,
-                    error != NULL ? error->message : "unknown error");
-        g_clear_error(&error);
-        return 1;
-    }
-
-    return 0;
-}
-
-
 /**
  * Check if \c ch is an alpha-num; in range \c "[0-9a-zA-F]".
  * Or \c "ch == '-'" or \c "ch == '_'".
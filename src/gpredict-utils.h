@@ -3,6 +3,8 @@
 
 #include <gtk/gtk.h>
 
+#include "compat.h"
+
 #define M_TO_FT(x) (3.2808399*x)
 #define FT_TO_M(x) (x/3.2808399)
 #define KM_TO_MI(x) (x/1.609344)
@@ -44,7 +46,5 @@ void            gdk2rgba(const GdkColor * color, guint16 alpha, guint * rgba);
 gchar          *rgba2html(guint rgba);
 int             gpredict_strcmp(const char *s1, const char *s2);
 char           *gpredict_strcasestr(const char *s1, const char *s2);
-gboolean        gpredict_save_key_file(GKeyFile * cfgdata,
-                                       const char *filename);
 gboolean        gpredict_legal_char(int ch);
 #endif
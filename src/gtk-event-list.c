@@ -100,7 +100,8 @@ static gboolean event_list_update_sats(GtkTreeModel * model,
                                        GtkTreeIter * iter, gpointer data);
 
 /* cell rendering related functions */
-static void     check_and_set_cell_renderer(GtkTreeViewColumn * column,
+static void     check_and_set_cell_renderer(GtkEventList * evlist,
+                                            GtkTreeViewColumn * column,
                                             GtkCellRenderer * renderer,
                                             gint i);
 static void     evtype_cell_data_function(GtkTreeViewColumn * col,
@@ -110,7 +111,7 @@ static void     evtype_cell_data_function(GtkTreeViewColumn * col,
 static void     time_cell_data_function(GtkTreeViewColumn * col,
                                         GtkCellRenderer * renderer,
                                         GtkTreeModel * model,
-                                        GtkTreeIter * iter, gpointer column);
+                                        GtkTreeIter * iter, gpointer data);
 static void     degree_cell_data_function(GtkTreeViewColumn * col,
                                           GtkCellRenderer * renderer,
                                           GtkTreeModel * model,
@@ -271,7 +272,7 @@ GtkWidget      *gtk_event_list_new(GKeyFile * cfgdata, GHashTable * sats,
                                     column, -1);
         gtk_tree_view_column_set_alignment(column, EVENT_LIST_HEAD_XALIGN[i]);
         gtk_tree_view_column_set_sort_column_id(column, i);
-        check_and_set_cell_renderer(column, renderer, i);
+        check_and_set_cell_renderer(evlist, column, renderer, i);
 
         /* hide columns that have not been specified */
         if (!(evlist->flags & (1 << i)))
@@ -331,7 +332,7 @@ static GtkTreeModel *create_and_fill_model(GHashTable * sats)
                                    G_TYPE_DOUBLE,       // az
                                    G_TYPE_DOUBLE,       // el
                                    G_TYPE_BOOLEAN,      // TRUE if AOS, FALSE if LOS
-                                   G_TYPE_DOUBLE,       // time
+                                   G_TYPE_DOUBLE,       // event time
                                    G_TYPE_BOOLEAN,      // decayed 
                                    G_TYPE_INT); // bold for storing weight
 
@@ -365,7 +366,7 @@ static void event_list_add_satellites(gpointer key, gpointer value,
                        EVENT_LIST_COL_AZ, sat->az,
                        EVENT_LIST_COL_EL, sat->el,
                        EVENT_LIST_COL_EVT, (sat->el >= 0) ? TRUE : FALSE,
-                       EVENT_LIST_COL_TIME, 0.0,
+                       EVENT_LIST_COL_TIME, -1.0,
                        EVENT_LIST_COL_DECAY, !decayed(sat), -1);
 }
 
@@ -397,9 +398,12 @@ void gtk_event_list_update(GtkWidget * widget)
                                          &(evlist->sort_column),
                                          &(evlist->sort_order));
 
-    /* update */
+    /* update; rows only move when an event has passed */
     gtk_tree_model_foreach(model, event_list_update_sats, evlist);
 
+    /* countdowns are computed from tstamp when the cells are rendered */
+    gtk_widget_queue_draw(evlist->treeview);
+
 #if 0
     /* check refresh rate */
     if (evlist->counter < evlist->refresh)
@@ -428,74 +432,80 @@ static gboolean event_list_update_sats(GtkTreeModel * model,
                                        GtkTreeIter * iter, gpointer data)
 {
     GtkEventList   *evlist = GTK_EVENT_LIST(data);
-    guint          *catnum;
-    sat_t          *sat;
-    gdouble         number, now;
+    guint           catnum;
+    gint            idx;
+    const sat_state_t *st;
+    gdouble         number, oldnum;
+    gboolean        evt, visible;
+    gint            bold;
 
     (void)path;
 
     /* get the catalogue number for this row
-       then look it up in the hash table
+       then look it up in the state table
      */
-    catnum = g_new0(guint, 1);
-    gtk_tree_model_get(model, iter, EVENT_LIST_COL_CATNUM, catnum, -1);
-    sat = SAT(g_hash_table_lookup(evlist->satellites, catnum));
+    if (evlist->table == NULL)
+        return FALSE;
 
-    if (sat == NULL)
+    gtk_tree_model_get(model, iter, EVENT_LIST_COL_CATNUM, &catnum, -1);
+    idx = sat_table_find(evlist->table, catnum);
+
+    if (idx < 0)
     {
         /* satellite not tracked anymore => remove */
         sat_log_log(SAT_LOG_LEVEL_INFO,
-                    _("%s: Failed to get data for #%d."), __func__, *catnum);
+                    _("%s: Failed to get data for #%d."), __func__, catnum);
 
         gtk_list_store_remove(GTK_LIST_STORE(model), iter);
 
         sat_log_log(SAT_LOG_LEVEL_ERROR,
                     _("%s: Satellite #%d removed from list."),
-                    __func__, *catnum);
+                    __func__, catnum);
     }
     else
     {
-        /* update data */
-        now = evlist->tstamp;
+        st = SAT_TABLE_STATE(evlist->table, idx);
 
-        if (sat->el > 0.0)
+        /* next event; the countdown is rendered from this */
+        if (st->el > 0.0)
+            number = (st->los > 0.0) ? st->los : -1.0;
+        else
+            number = (st->aos > 0.0) ? st->aos : -1.0;
+        /* -1.0: sat is stationary or no event */
+
+        gtk_tree_model_get(model, iter,
+                           EVENT_LIST_COL_EVT, &evt,
+                           EVENT_LIST_COL_TIME, &oldnum,
+                           EVENT_LIST_COL_DECAY, &visible,
+                           EVENT_LIST_COL_BOLD, &bold, -1);
+
+        /* position and everything that only changes at an event */
+        if (number == oldnum && evt == (st->el >= 0.0) &&
+            visible == !(st->flags & SAT_STATE_DECAYED) &&
+            bold == ((st->el > 0.0) ? PANGO_WEIGHT_BOLD :
+                     PANGO_WEIGHT_NORMAL))
         {
-            if (sat->los > 0.0)
-            {
-                number = sat->los - now;
-            }
-            else
-            {
-                number = -1.0;  /* Sat is staionary or no event */
-            }
+            gtk_list_store_set(GTK_LIST_STORE(model), iter,
+                               EVENT_LIST_COL_AZ, st->az,
+                               EVENT_LIST_COL_EL, st->el, -1);
         }
         else
         {
-            if (sat->aos > 0.0)
-            {
-                number = sat->aos - now;
-            }
-            else
-            {
-                number = -1.0;  /* Sat is staionary or no event */
-            }
+            gtk_list_store_set(GTK_LIST_STORE(model), iter,
+                               EVENT_LIST_COL_AZ, st->az,
+                               EVENT_LIST_COL_EL, st->el,
+                               EVENT_LIST_COL_EVT,
+                               (st->el >= 0) ? TRUE : FALSE,
+                               EVENT_LIST_COL_TIME, number,
+                               EVENT_LIST_COL_DECAY,
+                               !(st->flags & SAT_STATE_DECAYED),
+                               EVENT_LIST_COL_BOLD,
+                               (st->el >
+                                0.0) ? PANGO_WEIGHT_BOLD :
+                               PANGO_WEIGHT_NORMAL, -1);
         }
-
-        /* store new data */
-        gtk_list_store_set(GTK_LIST_STORE(model), iter,
-                           EVENT_LIST_COL_AZ, sat->az,
-                           EVENT_LIST_COL_EL, sat->el,
-                           EVENT_LIST_COL_EVT, (sat->el >= 0) ? TRUE : FALSE,
-                           EVENT_LIST_COL_TIME, number,
-                           EVENT_LIST_COL_DECAY, !decayed(sat),
-                           EVENT_LIST_COL_BOLD,
-                           (sat->el >
-                            0.0) ? PANGO_WEIGHT_BOLD : PANGO_WEIGHT_NORMAL,
-                           -1);
     }
 
-    g_free(catnum);
-
     /* Return value not documented what to return, but it seems that
        FALSE continues to next row while TRUE breaks
      */
@@ -503,7 +513,8 @@ static gboolean event_list_update_sats(GtkTreeModel * model,
 }
 
 /** Set cell renderer function. */
-static void check_and_set_cell_renderer(GtkTreeViewColumn * column,
+static void check_and_set_cell_renderer(GtkEventList * evlist,
+                                        GtkTreeViewColumn * column,
                                         GtkCellRenderer * renderer, gint i)
 {
     switch (i)
@@ -530,7 +541,7 @@ static void check_and_set_cell_renderer(GtkTreeViewColumn * column,
         gtk_tree_view_column_set_cell_data_func(column,
                                                 renderer,
                                                 time_cell_data_function,
-                                                GUINT_TO_POINTER(i), NULL);
+                                                evlist, NULL);
         break;
 
     default:
@@ -572,22 +583,22 @@ static void evtype_cell_data_function(GtkTreeViewColumn * col,
     g_free(buff);
 }
 
-/* AOS/LOS; convert julian date to string */
+/* AOS/LOS; render the time left until the event */
 static void time_cell_data_function(GtkTreeViewColumn * col,
                                     GtkCellRenderer * renderer,
                                     GtkTreeModel * model,
-                                    GtkTreeIter * iter, gpointer column)
+                                    GtkTreeIter * iter, gpointer data)
 {
     (void)col;
 
+    GtkEventList   *evlist = GTK_EVENT_LIST(data);
     gdouble         number;
     gchar          *buff;
-    guint           coli = GPOINTER_TO_UINT(column);
 
     guint           h, m, s;
 
-    /* get cell data */
-    gtk_tree_model_get(model, iter, coli, &number, -1);
+    /* get event time */
+    gtk_tree_model_get(model, iter, EVENT_LIST_COL_TIME, &number, -1);
 
     /* format the time code */
     if (number < 0.0)
@@ -597,6 +608,7 @@ static void time_cell_data_function(GtkTreeViewColumn * col,
     else
     {
         /* convert julian date to seconds */
+        number = MAX(number - evlist->tstamp, 0.0);
         s = (guint) (number * 86400);
 
         /* extract hours */
@@ -656,7 +668,9 @@ static void degree_cell_data_function(GtkTreeViewColumn * col,
  * This function is used by the SatList sort function to determine whether
  * AOS/LOS cell a is greater than b or not. The cells a and b contain the
  * time of the event in Julian days, thus the result can be computed by a
- * simple comparison between the two numbers contained in the cells.
+ * simple comparison between the two numbers contained in the cells. The
+ * event times do not change while time passes, so the order only changes
+ * when an event occurs.
  *
  * The function returns -1 if a < b; +1 if a > b; 0 otherwise.
  */
@@ -7,6 +7,7 @@
 #include <gtk/gtk.h>
 
 #include "gtk-sat-data.h"
+#include "sat-table.h"
 
 /* *INDENT-OFF* */
 #ifdef __cplusplus
@@ -40,6 +41,7 @@ struct _gtk_event_list {
     guint32         flags;      /*!< Flags indicating which columns are visible */
 
     gdouble         tstamp;     /*!< time stamp of calculations; set by GtkSatModule */
+    sat_table_t    *table;      /*!< per-tick satellite state; set by GtkSatModule */
     GKeyFile       *cfgdata;
     gint            sort_column;
     GtkSortType     sort_order;
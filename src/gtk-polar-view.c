@@ -946,6 +946,47 @@ static void update_polv_size(GtkPolarView * polv)
     }
 }
 
+/**
+ * Update all satellites.
+ *
+ * Satellites below the horizon that are not on the canvas need nothing but
+ * the next AOS, which is read from the state table without touching their
+ * sat_t.
+ */
+static void update_sats(GtkPolarView * polv)
+{
+    const sat_state_t *st;
+    gint            catnr;
+    guint           i;
+
+    if (polv->table == NULL)
+    {
+        g_hash_table_foreach(polv->sats, update_sat, polv);
+        return;
+    }
+
+    for (i = 0; i < SAT_TABLE_LEN(polv->table); i++)
+    {
+        st = SAT_TABLE_STATE(polv->table, i);
+
+        if ((st->el < 0.0) || (st->flags & SAT_STATE_DECAYED))
+        {
+            if ((st->aos > polv->tstamp) &&
+                ((st->aos < polv->naos) || (polv->naos == 0.0)))
+            {
+                polv->naos = st->aos;
+                polv->ncat = st->catnr;
+            }
+
+            catnr = st->catnr;
+            if (g_hash_table_lookup(polv->obj, &catnr) == NULL)
+                continue;
+        }
+
+        update_sat(NULL, SAT_TABLE_SAT(polv->table, i), polv);
+    }
+}
+
 void gtk_polar_view_update(GtkWidget * widget)
 {
     GtkPolarView   *polv = GTK_POLAR_VIEW(widget);
@@ -975,7 +1016,7 @@ void gtk_polar_view_update(GtkWidget * widget)
         polv->ncat = 0;
 
         /* update sats */
-        g_hash_table_foreach(polv->sats, update_sat, polv);
+        update_sats(polv);
 
         /* update countdown to NEXT AOS label */
         if (polv->eventinfo)
@@ -1631,6 +1672,30 @@ void gtk_polar_view_reload_sats(GtkWidget * polv, GHashTable * sats)
     GTK_POLAR_VIEW(polv)->ncat = 0;
 }
 
+/** Recalculate the pass of a satellite whose elements have changed. */
+void gtk_polar_view_reload_sat(GtkWidget * widget, sat_t * sat)
+{
+    GtkPolarView   *polv = GTK_POLAR_VIEW(widget);
+    sat_obj_t      *obj;
+
+    /* next event may belong to this satellite */
+    polv->naos = 0.0;
+    polv->ncat = 0;
+
+    obj = SAT_OBJ(g_hash_table_lookup(polv->obj, &sat->tle.catnr));
+    if (obj == NULL || obj->pass == NULL)
+        return;
+
+    if (obj->showtrack)
+        gtk_polar_view_delete_track(polv, obj, sat);
+
+    free_pass(obj->pass);
+    obj->pass = get_current_pass(sat, polv->qth, polv->tstamp);
+
+    if (obj->showtrack)
+        gtk_polar_view_create_track(polv, obj, sat);
+}
+
 /** Select a satellite */
 void gtk_polar_view_select_sat(GtkWidget * widget, gint catnum)
 {
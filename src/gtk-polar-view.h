@@ -9,6 +9,8 @@
 
 #include "gtk-sat-data.h"
 #include "predict-tools.h"
+#include "sat-table.h"
+#include "view-flags.h"
 
 /* *INDENT-OFF* */
 #ifdef __cplusplus
@@ -45,23 +47,6 @@ typedef struct {
 #define SAT_OBJ(obj) ((sat_obj_t *)obj)
 
 
-    /* graph orientation; start at 12
-       o'clock and go clockwise */
-typedef enum {
-    POLAR_VIEW_NESW = 0,        /*!< Normal / usual */
-    POLAR_VIEW_NWSE = 1,
-    POLAR_VIEW_SENW = 2,
-    POLAR_VIEW_SWNE = 3
-} polar_view_swap_t;
-
-
-    /* pole identifier */
-typedef enum {
-    POLAR_VIEW_POLE_N = 0,
-    POLAR_VIEW_POLE_E = 1,
-    POLAR_VIEW_POLE_S = 2,
-    POLAR_VIEW_POLE_W = 3
-} polar_view_pole_t;
 
 
 struct _GtkPolarView {
@@ -85,6 +70,7 @@ struct _GtkPolarView {
     gint            ncat;       /*!< Next event catnum */
 
     gdouble         tstamp;     /*!< Time stamp for calculations; set by GtkSatModule */
+    sat_table_t    *table;      /*!< Per-tick satellite state; set by GtkSatModule */
 
     GKeyFile       *cfgdata;    /*!< module configuration data */
     GHashTable     *sats;       /*!< Satellites. */
@@ -123,6 +109,7 @@ void            gtk_polar_view_update(GtkWidget * widget);
 void            gtk_polar_view_reconf(GtkWidget * widget, GKeyFile * cfgdat);
 void            gtk_polar_view_reload_sats(GtkWidget * polv,
                                            GHashTable * sats);
+void            gtk_polar_view_reload_sat(GtkWidget * polv, sat_t * sat);
 void            gtk_polar_view_select_sat(GtkWidget * widget, gint catnum);
 void            gtk_polar_view_create_track(GtkPolarView * pv, sat_obj_t * obj,
                                             sat_t * sat);
@@ -169,6 +169,7 @@ static void gtk_rig_ctrl_init(GtkRigCtrl * ctrl,
     ctrl->trsplist = NULL;
     ctrl->trsplock = FALSE;
     ctrl->tracking = FALSE;
+    ctrl->cmd_catnr = -1;
     ctrl->prev_ele = 0.0;
     ctrl->sock = 0;
     ctrl->sock2 = 0;
@@ -272,6 +273,7 @@ static void update_count_down(GtkRigCtrl * ctrl, gdouble t)
 void gtk_rig_ctrl_update(GtkRigCtrl * ctrl, gdouble t)
 {
     gdouble         satfreq;
+    gdouble         rr;
     gchar          *buff;
 
     g_mutex_lock(&ctrl->rig_ctrl_updatelock);
@@ -310,16 +312,22 @@ void gtk_rig_ctrl_update(GtkRigCtrl * ctrl, gdouble t)
         gtk_label_set_text(GTK_LABEL(ctrl->SatRngRate), buff);
         g_free(buff);
 
+        /* range rate commanded by the simulation timeline, if any */
+        if (ctrl->cmd_catnr == ctrl->target->tle.catnr)
+            rr = ctrl->cmd_rr;
+        else
+            rr = ctrl->target->range_rate;
+
         /* Doppler shift down */
         satfreq = gtk_freq_knob_get_value(GTK_FREQ_KNOB(ctrl->SatFreqDown));
-        ctrl->dd = -satfreq * (ctrl->target->range_rate / 299792.4580); // Hz
+        ctrl->dd = -satfreq * (rr / 299792.4580);       // Hz
         buff = g_strdup_printf("%.0f Hz", ctrl->dd);
         gtk_label_set_text(GTK_LABEL(ctrl->SatDopDown), buff);
         g_free(buff);
 
         /* Doppler shift up */
         satfreq = gtk_freq_knob_get_value(GTK_FREQ_KNOB(ctrl->SatFreqUp));
-        ctrl->du = satfreq * (ctrl->target->range_rate / 299792.4580);  // Hz
+        ctrl->du = satfreq * (rr / 299792.4580);        // Hz
         buff = g_strdup_printf("%.0f Hz", ctrl->du);
         gtk_label_set_text(GTK_LABEL(ctrl->SatDopUp), buff);
         g_free(buff);
@@ -396,6 +404,23 @@ static void track_uplink(GtkRigCtrl * ctrl)
     }
 }
 
+/*
+ * Set the range rate commanded by a simulation timeline.
+ *
+ * The module calls this for every rig command of the timeline crossed by its
+ * tick, before gtk_rig_ctrl_update(). The Doppler shift of the satellite is
+ * then computed from the commanded range rate, so the radio is retuned in the
+ * steps planned by the timeline. A catnum of -1 clears the command.
+ */
+void gtk_rig_ctrl_set_command(GtkRigCtrl * ctrl, gint catnum,
+                              gdouble range_rate)
+{
+    g_mutex_lock(&ctrl->rig_ctrl_updatelock);
+    ctrl->cmd_catnr = catnum;
+    ctrl->cmd_rr = range_rate;
+    g_mutex_unlock(&ctrl->rig_ctrl_updatelock);
+}
+
 void gtk_rig_ctrl_select_sat(GtkRigCtrl * ctrl, gint catnum)
 {
     sat_t          *sat;
@@ -77,6 +77,8 @@ struct _gtk_rig_ctrl {
     gdouble         lastrxf;    /*!< Last frequency sent to receiver. */
     gdouble         lasttxf;    /*!< Last frequency sent to tranmitter. */
     gdouble         du, dd;     /*!< Last computed up/down Doppler shift; computed in update() */
+    gint            cmd_catnr;  /*!< Satellite of the replayed command or -1 */
+    gdouble         cmd_rr;     /*!< Range rate commanded by a simulation timeline */
 
     gint64          last_toggle_tx;     /*!< Last time when exec_toggle_tx_cycle() was executed (seconds)
                                            -1 indicates that an update should be performed ASAP */
@@ -106,5 +108,7 @@ GType           gtk_rig_ctrl_get_type(void);
 GtkWidget      *gtk_rig_ctrl_new(GtkSatModule * module);
 void            gtk_rig_ctrl_update(GtkRigCtrl * ctrl, gdouble t);
 void            gtk_rig_ctrl_select_sat(GtkRigCtrl * ctrl, gint catnum);
+void            gtk_rig_ctrl_set_command(GtkRigCtrl * ctrl, gint catnum,
+                                         gdouble range_rate);
 
 #endif /* __GTK_RIG_CTRL_H__ */
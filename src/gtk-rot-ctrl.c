@@ -636,6 +636,22 @@ void gtk_rot_ctrl_select_sat(GtkRotCtrl * ctrl, gint catnum)
     }
 }
 
+/*
+ * Set the position commanded by a simulation timeline.
+ *
+ * The module calls this for every rotator command of the timeline crossed by
+ * its tick. While the satellite is up and tracked, the control cycle aims at
+ * the commanded position instead of the current one, so the rotator moves in
+ * the steps planned by the timeline. A catnum of -1 clears the command.
+ */
+void gtk_rot_ctrl_set_command(GtkRotCtrl * ctrl, gint catnum, gdouble az,
+                              gdouble el)
+{
+    ctrl->cmd_catnr = catnum;
+    ctrl->cmd_az = az;
+    ctrl->cmd_el = el;
+}
+
 /*
  * Create azimuth control widgets.
  * 
@@ -771,6 +787,12 @@ static gboolean rot_ctrl_timeout_cb(gpointer data)
                 }
             }
         }
+        else if (ctrl->cmd_catnr == ctrl->target->tle.catnr)
+        {
+            /* position commanded by the simulation timeline */
+            setaz = SAFE_AZI(ctrl->cmd_az);
+            setel = SAFE_ELE(ctrl->cmd_el);
+        }
         else
         {
             setaz = SAFE_AZI(ctrl->target->az);
@@ -1547,6 +1569,7 @@ static void gtk_rot_ctrl_init(GtkRotCtrl * ctrl,
     ctrl->pass = NULL;
     ctrl->qth = NULL;
     ctrl->plot = NULL;
+    ctrl->cmd_catnr = -1;
 
     ctrl->tracking = FALSE;
     ctrl->engaged = FALSE;
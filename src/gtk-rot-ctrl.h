@@ -57,6 +57,9 @@ struct _gtk_rot_ctrl {
     pass_t         *pass;       /*!< Next pass of target satellite */
     qth_t          *qth;        /*!< The QTH for this module */
     gboolean        flipped;    /*!< Whether the current pass loaded is a flip pass or not */
+    gint            cmd_catnr;  /*!< Satellite of the replayed command or -1 */
+    gdouble         cmd_az;     /*!< Azimuth commanded by a simulation timeline */
+    gdouble         cmd_el;     /*!< Elevation commanded by a simulation timeline */
 
     guint           delay;      /*!< Timeout delay. */
     guint           timerid;    /*!< Timer ID */
@@ -92,6 +95,8 @@ GType           gtk_rot_ctrl_get_type(void);
 GtkWidget      *gtk_rot_ctrl_new(GtkSatModule * module);
 void            gtk_rot_ctrl_update(GtkRotCtrl * ctrl, gdouble t);
 void            gtk_rot_ctrl_select_sat(GtkRotCtrl * ctrl, gint catnum);
+void            gtk_rot_ctrl_set_command(GtkRotCtrl * ctrl, gint catnum,
+                                         gdouble az, gdouble el);
 
 #ifdef __cplusplus
 }
@@ -172,8 +172,12 @@ gint gtk_sat_data_read_sat(gint catnum, sat_t * sat)
         sat->aos = 0.0;
         sat->los = 0.0;
 
-        /* calculate satellite data at epoch */
-        gtk_sat_data_init_sat(sat, NULL);
+        /* only what needs no propagation; the state at epoch is left to
+           gtk_sat_data_init_sat() for the callers that need it, the
+           others call predict_calc() anyway */
+        sat->jul_epoch = Julian_Date_of_Epoch(sat->tle.epoch);
+        sat->orbit = sat->tle.revnum;
+        sat->otype = get_orbit_type(sat);
     }
 
     g_free(filename);
@@ -190,7 +194,9 @@ gint gtk_sat_data_read_sat(gint catnum, sat_t * sat)
  * @param qth Optional QTH info, use (0,0) if NULL.
  *
  * This function calculates the satellite data at t = 0, ie. epoch time
- * The function is called automatically by gtk_sat_data_read_sat.
+ * gtk_sat_data_read_sat only maps the elements into the propagator model;
+ * call this function if the satellite must be displayed before the first
+ * predict_calc.
  */
 void gtk_sat_data_init_sat(sat_t * sat, qth_t * qth)
 {
@@ -334,6 +340,48 @@ void gtk_sat_data_copy_sat(const sat_t * source, sat_t * dest, qth_t * qth)
     gtk_sat_data_init_sat(dest, qth);
 }
 
+/**
+ * Check whether two element sets differ.
+ *
+ * @param a The current elements.
+ * @param b The fresh elements.
+ * @return TRUE if the propagation would differ.
+ */
+gboolean gtk_sat_data_tle_changed(const tle_t * a, const tle_t * b)
+{
+    return a->epoch != b->epoch ||
+        a->xndt2o != b->xndt2o || a->xndd6o != b->xndd6o ||
+        a->bstar != b->bstar || a->xincl != b->xincl ||
+        a->xnodeo != b->xnodeo || a->eo != b->eo ||
+        a->omegao != b->omegao || a->xmo != b->xmo || a->xno != b->xno ||
+        a->elset != b->elset || a->revnum != b->revnum ||
+        a->status != b->status;
+}
+
+/**
+ * Replace the propagator model of a satellite.
+ *
+ * @param sat The satellite in use.
+ * @param fresh A satellite read and initialised from the new elements.
+ *
+ * Everything but the name strings is taken from fresh, so the sat_t keeps
+ * its address and the views referring to it stay valid.  AOS/LOS are
+ * cleared; the caller recalculates them.
+ */
+void gtk_sat_data_swap_model(sat_t * sat, const sat_t * fresh)
+{
+    gchar          *name = sat->name;
+    gchar          *nickname = sat->nickname;
+    gchar          *website = sat->website;
+
+    *sat = *fresh;
+    sat->name = name;
+    sat->nickname = nickname;
+    sat->website = website;
+    sat->aos = 0.0;
+    sat->los = 0.0;
+}
+
 /**
  * Free satellite data
  *
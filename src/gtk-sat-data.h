@@ -35,5 +35,7 @@ void            gtk_sat_data_init_sat(sat_t * sat, qth_t * qth);
 void            gtk_sat_data_copy_sat(const sat_t * source, sat_t * dest,
                                       qth_t * qth);
 void            gtk_sat_data_free_sat(sat_t * sat);
+gboolean        gtk_sat_data_tle_changed(const tle_t * a, const tle_t * b);
+void            gtk_sat_data_swap_model(sat_t * sat, const sat_t * fresh);
 
 #endif
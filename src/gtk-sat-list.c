@@ -215,8 +215,6 @@ static void     row_activated_cb(GtkTreeView * tree_view, GtkTreePath * path,
 
 static void     view_popup_menu(GtkWidget * treeview, GdkEventButton * event,
                                 gpointer list);
-static void     Calculate_RADec(sat_t * sat, qth_t * qth,
-                                obs_astro_t * obs_set);
 
 static GtkVBoxClass *parent_class = NULL;
 
@@ -571,8 +569,9 @@ static gboolean sat_list_update_sats(GtkTreeModel * model, GtkTreePath * path,
                                      GtkTreeIter * iter, gpointer data)
 {
     GtkSatList     *satlist = GTK_SAT_LIST(data);
-    guint          *catnum;
-    sat_t          *sat;
+    guint           catnum;
+    gint            idx;
+    const sat_state_t *st;
     gchar          *buff;
     gdouble         doppler;
     gdouble         delay;
@@ -583,50 +582,56 @@ static gboolean sat_list_update_sats(GtkTreeModel * model, GtkTreePath * path,
     (void)path;
 
     /* get the catalogue number for this row
-       then look it up in the hash table
+       then look it up in the state table; RA/Dec and visibility are
+       computed once per state and shared with the other views
      */
-    catnum = g_new0(guint, 1);
-    gtk_tree_model_get(model, iter, SAT_LIST_COL_CATNUM, catnum, -1);
-    sat = SAT(g_hash_table_lookup(satlist->satellites, catnum));
+    if (satlist->table == NULL)
+        return FALSE;
 
-    if (sat == NULL)
+    gtk_tree_model_get(model, iter, SAT_LIST_COL_CATNUM, &catnum, -1);
+    idx = sat_table_find(satlist->table, catnum);
+
+    if (idx < 0)
     {
         /* satellite not tracked anymore => remove */
         sat_log_log(SAT_LOG_LEVEL_INFO,
-                    _("%s: Failed to get data for #%d."), __func__, *catnum);
+                    _("%s: Failed to get data for #%d."), __func__, catnum);
 
         gtk_list_store_remove(GTK_LIST_STORE(model), iter);
 
         sat_log_log(SAT_LOG_LEVEL_ERROR,
                     _("%s: Satellite #%d removed from list."), __func__,
-                    *catnum);
+                    catnum);
     }
     else
     {
+        st = SAT_TABLE_STATE(satlist->table, idx);
+
         /* store new data */
         gtk_list_store_set(GTK_LIST_STORE(model), iter,
-                           SAT_LIST_COL_AZ, sat->az,
-                           SAT_LIST_COL_EL, sat->el,
-                           SAT_LIST_COL_RANGE, sat->range,
-                           SAT_LIST_COL_RANGE_RATE, sat->range_rate,
-                           SAT_LIST_COL_LAT, sat->ssplat,
-                           SAT_LIST_COL_LON, sat->ssplon,
-                           SAT_LIST_COL_FOOTPRINT, sat->footprint,
-                           SAT_LIST_COL_ALT, sat->alt,
-                           SAT_LIST_COL_VEL, sat->velo,
-                           SAT_LIST_COL_MA, sat->ma,
-                           SAT_LIST_COL_PHASE, sat->phase,
-                           SAT_LIST_COL_ORBIT, sat->orbit,
-                           SAT_LIST_COL_DECAY, !decayed(sat),
+                           SAT_LIST_COL_AZ, st->az,
+                           SAT_LIST_COL_EL, st->el,
+                           SAT_LIST_COL_RANGE, st->range,
+                           SAT_LIST_COL_RANGE_RATE, st->range_rate,
+                           SAT_LIST_COL_LAT, st->ssplat,
+                           SAT_LIST_COL_LON, st->ssplon,
+                           SAT_LIST_COL_FOOTPRINT, st->footprint,
+                           SAT_LIST_COL_ALT, st->alt,
+                           SAT_LIST_COL_VEL, st->velo,
+                           SAT_LIST_COL_MA, st->ma,
+                           SAT_LIST_COL_PHASE, st->phase,
+                           SAT_LIST_COL_ORBIT, st->orbit,
+                           SAT_LIST_COL_DECAY,
+                           !(st->flags & SAT_STATE_DECAYED),
                            SAT_LIST_COL_BOLD,
-                           (sat->el >
+                           (st->el >
                             0.0) ? PANGO_WEIGHT_BOLD : PANGO_WEIGHT_NORMAL,
                            -1);
 
         /* doppler shift @ 100 MHz */
         if (satlist->flags & SAT_LIST_FLAG_DOPPLER)
         {
-            doppler = -100.0e06 * (sat->range_rate / 299792.4580);      // Hz
+            doppler = -100.0e06 * (st->range_rate / 299792.4580);      // Hz
             gtk_list_store_set(GTK_LIST_STORE(model), iter,
                                SAT_LIST_COL_DOPPLER, doppler, -1);
         }
@@ -634,7 +639,7 @@ static gboolean sat_list_update_sats(GtkTreeModel * model, GtkTreePath * path,
         /* delay */
         if (satlist->flags & SAT_LIST_FLAG_DELAY)
         {
-            delay = sat->range / 299.7924580;   // msec 
+            delay = st->range / 299.7924580;   // msec 
             gtk_list_store_set(GTK_LIST_STORE(model), iter, SAT_LIST_COL_DELAY,
                                delay, -1);
         }
@@ -642,7 +647,7 @@ static gboolean sat_list_update_sats(GtkTreeModel * model, GtkTreePath * path,
         /* path loss */
         if (satlist->flags & SAT_LIST_FLAG_LOSS)
         {
-            loss = 72.4 + 20.0 * log10(sat->range);     // dB
+            loss = 72.4 + 20.0 * log10(st->range);     // dB
             gtk_list_store_set(GTK_LIST_STORE(model), iter, SAT_LIST_COL_LOSS,
                                loss, -1);
         }
@@ -650,25 +655,25 @@ static gboolean sat_list_update_sats(GtkTreeModel * model, GtkTreePath * path,
         /* calculate direction */
         if (satlist->flags & SAT_LIST_FLAG_DIR)
         {
-            if (sat->otype == ORBIT_TYPE_GEO)
+            if (st->otype == ORBIT_TYPE_GEO)
             {
                 buff = g_strdup("G");
             }
-            else if (decayed(sat))
+            else if (st->flags & SAT_STATE_DECAYED)
             {
                 buff = g_strdup("D");
             }
-            else if (sat->range_rate > 0.001)
+            else if (st->range_rate > 0.001)
             {
                 /* going down */
                 buff = g_strdup("\342\206\223");
             }
-            else if ((sat->range_rate <= 0.001) && (sat->range_rate >= -0.001))
+            else if ((st->range_rate <= 0.001) && (st->range_rate >= -0.001))
             {
                 gtk_tree_model_get(model, iter, SAT_LIST_COL_RANGE_RATE,
                                    &oldrate, -1);
                 /* turning around; don't know which way ? */
-                if (sat->range_rate < oldrate)
+                if (st->range_rate < oldrate)
                 {
                     /* starting to approach */
                     buff = g_strdup("\342\206\272");
@@ -679,7 +684,7 @@ static gboolean sat_list_update_sats(GtkTreeModel * model, GtkTreePath * path,
                     buff = g_strdup("\342\206\267");
                 }
             }
-            else if (sat->range_rate < -0.001)
+            else if (st->range_rate < -0.001)
             {
                 /* coming up */
                 buff = g_strdup("\342\206\221");
@@ -703,7 +708,7 @@ static gboolean sat_list_update_sats(GtkTreeModel * model, GtkTreePath * path,
 
             buff = g_try_malloc(7);
 
-            retcode = longlat2locator(sat->ssplon, sat->ssplat, buff, 3);
+            retcode = longlat2locator(st->ssplon, st->ssplat, buff, 3);
             if (retcode == RIG_OK)
             {
                 buff[6] = '\0';
@@ -716,16 +721,11 @@ static gboolean sat_list_update_sats(GtkTreeModel * model, GtkTreePath * path,
         /* Ra and Dec */
         if (satlist->flags & (SAT_LIST_FLAG_RA | SAT_LIST_FLAG_DEC))
         {
-            obs_astro_t     astro;
-
-            Calculate_RADec(sat, satlist->qth, &astro);
-
-            sat->ra = Degrees(astro.ra);
-            sat->dec = Degrees(astro.dec);
+            st = sat_table_radec(satlist->table, idx, satlist->qth);
 
             gtk_list_store_set(GTK_LIST_STORE(model), iter,
-                               SAT_LIST_COL_RA, sat->ra, SAT_LIST_COL_DEC,
-                               sat->dec, -1);
+                               SAT_LIST_COL_RA, st->ra, SAT_LIST_COL_DEC,
+                               st->dec, -1);
         }
 
         /* upcoming events */
@@ -733,12 +733,12 @@ static gboolean sat_list_update_sats(GtkTreeModel * model, GtkTreePath * path,
         if (satlist->flags & SAT_LIST_FLAG_AOS)
         {
             gtk_list_store_set(GTK_LIST_STORE(model), iter, SAT_LIST_COL_AOS,
-                               sat->aos, -1);
+                               st->aos, -1);
         }
         if (satlist->flags & SAT_LIST_FLAG_LOS)
         {
             gtk_list_store_set(GTK_LIST_STORE(model), iter, SAT_LIST_COL_LOS,
-                               sat->los, -1);
+                               st->los, -1);
 
         }
         if (satlist->flags & SAT_LIST_FLAG_NEXT_EVENT)
@@ -750,16 +750,16 @@ static gboolean sat_list_update_sats(GtkTreeModel * model, GtkTreePath * path,
             gchar          *alstr;
 
 
-            if (sat->aos > sat->los)
+            if (st->aos > st->los)
             {
                 /* next event is LOS */
-                number = sat->los;
+                number = st->los;
                 alstr = g_strdup(" (LOS)");
             }
             else
             {
                 /* next event is AOS */
-                number = sat->aos;
+                number = st->aos;
                 alstr = g_strdup(" (AOS)");
             }
 
@@ -792,7 +792,7 @@ static gboolean sat_list_update_sats(GtkTreeModel * model, GtkTreePath * path,
         {
             sat_vis_t       vis;
 
-            vis = get_sat_vis(sat, satlist->qth, sat->jul_utc);
+            vis = sat_table_vis(satlist->table, idx, satlist->qth);
             buff = g_strdup_printf("%c", vis_to_chr(vis));
             gtk_list_store_set(GTK_LIST_STORE(model), iter,
                                SAT_LIST_COL_VISIBILITY, buff, -1);
@@ -800,8 +800,6 @@ static gboolean sat_list_update_sats(GtkTreeModel * model, GtkTreePath * path,
         }
     }
 
-    g_free(catnum);
-
     /* Return value not documented what to return, but it seems that
        FALSE continues to next row while TRUE breaks
      */
@@ -1361,53 +1359,6 @@ static void view_popup_menu(GtkWidget * treeview, GdkEventButton * event,
     g_free(catnum);
 }
 
-/*** FIXME: formalise with other copies, only need az,el and jul_utc */
-static void Calculate_RADec(sat_t * sat, qth_t * qth, obs_astro_t * obs_set)
-{
-    /* Reference:  Methods of Orbit Determination by  */
-    /*                Pedro Ramon Escobal, pp. 401-402 */
-
-    double          phi, theta, sin_theta, cos_theta, sin_phi, cos_phi,
-        az, el, Lxh, Lyh, Lzh, Sx, Ex, Zx, Sy, Ey, Zy, Sz, Ez, Zz,
-        Lx, Ly, Lz, cos_delta, sin_alpha, cos_alpha;
-    geodetic_t      geodetic;
-
-    geodetic.lon = qth->lon * de2ra;
-    geodetic.lat = qth->lat * de2ra;
-    geodetic.alt = qth->alt / 1000.0;
-    geodetic.theta = 0;
-
-    az = sat->az * de2ra;
-    el = sat->el * de2ra;
-    phi = geodetic.lat;
-    theta = FMod2p(ThetaG_JD(sat->jul_utc) + geodetic.lon);
-    sin_theta = sin(theta);
-    cos_theta = cos(theta);
-    sin_phi = sin(phi);
-    cos_phi = cos(phi);
-    Lxh = -cos(az) * cos(el);
-    Lyh = sin(az) * cos(el);
-    Lzh = sin(el);
-    Sx = sin_phi * cos_theta;
-    Ex = -sin_theta;
-    Zx = cos_theta * cos_phi;
-    Sy = sin_phi * sin_theta;
-    Ey = cos_theta;
-    Zy = sin_theta * cos_phi;
-    Sz = -cos_phi;
-    Ez = 0;
-    Zz = sin_phi;
-    Lx = Sx * Lxh + Ex * Lyh + Zx * Lzh;
-    Ly = Sy * Lxh + Ey * Lyh + Zy * Lzh;
-    Lz = Sz * Lxh + Ez * Lyh + Zz * Lzh;
-    obs_set->dec = ArcSin(Lz);  /* Declination (radians) */
-    cos_delta = sqrt(1 - Sqr(Lz));
-    sin_alpha = Ly / cos_delta;
-    cos_alpha = Lx / cos_delta;
-    obs_set->ra = AcTan(sin_alpha, cos_alpha);  /* Right Ascension (radians) */
-    obs_set->ra = FMod2p(obs_set->ra);
-}
-
 /** Reload reference to satellites (e.g. after TLE update). */
 void gtk_sat_list_reload_sats(GtkWidget * satlist, GHashTable * sats)
 {
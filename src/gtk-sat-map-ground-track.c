@@ -46,126 +46,9 @@
 #include "sgpsdp/sgp4sdp4.h"
 #include <stdio.h>            /* for printf */
 #include "ephem_point.h"      /* our EphemPoint + g_ephem_buffer */
+#include "time-tools.h"       /* jd_to_gregorian() */
 #include <math.h>    /* for floor(), fmod() */
 
-/**
- * jd_to_gregorian():
- *
- *   Given a Julian Date (jd, in UTC), compute the corresponding
- *   Gregorian calendar date and time (year, month, day, hour, minute, second).
- *
- *   Algorithm is from Fliegel & Van Flandern (1968) / Jean Meeus.
- *
- * Inputs:
- *   jd       : Julian Date in UTC (e.g. 2460832.43600475)
- * Outputs (all output pointers must be non-NULL):
- *   year_out : 4-digit year (e.g. 2024)
- *   month_out: month (1–12)
- *   day_out  : day of month (1–31)
- *   hour_out : hour of day (0–23)
- *   min_out  : minute (0–59)
- *   sec_out  : second (0–59, rounded to nearest integer)
- */
-
-/*-------------------------------------------------------------------------------------
- * Helper to free a single EphemPoint, including its time_str.
- * This function matches the GDestroyNotify signature (i.e. takes one gpointer).
- *-----------------------------------------------------------------------------------*/
-
-
-void
-jd_to_gregorian(double jd,
-                int   *year_out,
-                int   *month_out,
-                int   *day_out,
-                int   *hour_out,
-                int   *min_out,
-                int   *sec_out){
-
-    /* 1) Convert JD to “Julian day number” (integer) plus fractional day */
-    double Z, F;
-    long   J;
-    Z = floor(jd + 0.5);
-    F = (jd + 0.5) - Z;            /* fractional part of day */
-    J = (long) Z;                  /* integer part */
-
-    long   A;
-    if (J >= 2299161L) {
-        /* Gregorian reform: */
-        long alpha = (long) floor((J - 1867216.25) / 36524.25);
-        A = J + 1 + alpha - (long)floor(alpha / 4.0);
-    } else {
-        A = J;
-    }
-
-    /* 2) Convert to “B” */
-    long B = A + 1524;
-
-    /* 3) Year and month calculations */
-    long C = (long) floor((B - 122.1) / 365.25);
-    long D = (long) floor(365.25 * C);
-    long E = (long) floor((B - D) / 30.6001);
-
-    double day_decimal = B - D - floor(30.6001 * E) + F; 
-    /* day_decimal is day-of-month + fractional day */
-
-    int day = (int) floor(day_decimal);  /* integer day-of-month */
-
-    int month;
-    if (E < 14) {
-        month = (int) (E - 1);
-    } else {
-        month = (int) (E - 13);
-    }
-
-    int year;
-    if (month > 2) {
-        year = (int) (C - 4716);
-    } else {
-        year = (int) (C - 4715);
-    }
-
-    /* 4) Extract time from fractional part of day_decimal */
-    double fractional_day = day_decimal - day; 
-    /* fractional_day is in [0,1) of one day (i.e. 24h) */
-
-    double total_seconds = fractional_day * 86400.0; 
-    /* total seconds since 00:00:00 of that day */
-
-    int hour = (int) floor(total_seconds / 3600.0);
-    double rem = total_seconds - (hour * 3600.0);
-    int minute = (int) floor(rem / 60.0);
-    double seconds = rem - (minute * 60.0);
-
-    /* Round to nearest integer second (you could also floor) */
-    int second = (int) floor(seconds + 0.5);
-    if (second >= 60) {
-        second -= 60;
-        minute += 1;
-        if (minute >= 60) {
-            minute -= 60;
-            hour += 1;
-            if (hour >= 24) {
-                /* Roll into next day */
-                hour -= 24;
-                day += 1;
-                /* Naïvely increment day without re-checking month boundaries;
-                   in practice the JD → Gregorian algorithm above produces
-                   day already in correct range, and rounding might only add
-                   one second. If it exactly hits 24:00:00, you could adjust
-                   more robustly, but this is seldom needed for ground-track. */
-            }
-        }
-    }
-
-    /* 5) Store outputs */
-    *year_out  = year;
-    *month_out = month;
-    *day_out   = day;
-    *hour_out  = hour;
-    *min_out   = minute;
-    *sec_out   = second;
-}
 
 /**
  * print_all_ephemeris_points()
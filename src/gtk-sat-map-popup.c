@@ -52,6 +52,7 @@
 #include <gio/gio.h>   
 /* Forward decls for handlers used before their definitions */
 static void on_poi_refresh_clicked(GtkButton *button, gpointer user_data);
+static void on_orbits_value_changed(GtkSpinButton *spin, gpointer user_data);
 /* Always provide our own stubs so g_task_report_progress()
 // ──────────────────────────────────────────────────────────────
 // COMMON — Dialog / Helpers / Shared
@@ -89,6 +90,7 @@ g_task_get_progress_fraction(GTask *task)
 }
 #endif
 
+#include "compat.h"
 #include "config-keys.h"
 #include "sat-cfg.h"
 #include "sat-log.h"
@@ -103,9 +105,12 @@ g_task_get_progress_fraction(GTask *task)
 #include "sat-info.h"
 #include "sat-pass-dialogs.h"
 #include "sgpsdp/sgp4sdp4.h"
+#include "tle-diff.h"
+#include "time-tools.h"
 #include <glib/gprintf.h>                 /* for g_strdup_printf() */
 #include <glib.h>                       /* for g_idle_add_full */
 #include <math.h>
+#include <string.h>                     /* memset() */
 
 /* New Code*/
 /* Filters */
@@ -114,7 +119,10 @@ g_task_get_progress_fraction(GTask *task)
 
 /* Loading data*/
 #include "ephem_point.h"                 /* Loading EphemPoint, buffer */
+#include "ephem-pipe.h"                  /* Streaming ephemeris blocks */
 #include "points_interests.h"           /* Loading points of interests */
+#include "result-cache.h"               /* Stage results kept on disk */
+#include "result-index.h"               /* Time/segment/grid lookups on tables */
 
 /* Helper */
 #include "sub_window_ephemeris.h"  /* helper for sub window in tab3 */
@@ -153,17 +161,22 @@ static inline gboolean bbox_contains(const BBox *b, double lat, double lon) {
     return !(lon < b->min_lon || lon > b->max_lon);
 }
 
-/*───────────────────────────────────────────────────────────────────────────*/
-/* We need this to format YYYY/MM/DD HH:MM:SS from a Julian date:           */
-void jd_to_gregorian(double jd,
-                    int   *year_out,
-                    int   *month_out,
-                    int   *day_out,
-                    int   *hour_out,
-                    int   *min_out,
-                    int   *sec_out);
-/*───────────────────────────────────────────────────────────────────────────*/
-
+/*
+ * @brief Loads the POI tiles and checks the cached POI results against them.
+ * @function poi_tiles_load
+ * @thread Runs on the GTK main thread (GLib main loop).
+ * @note Cached POI entries of an older file are dropped here, once per load
+ *       rather than on every run.
+ * @return (gboolean) FALSE if the tiles could not be read
+ */
+static gboolean
+poi_tiles_load(void)
+{
+    if (!lp_init(POI_CSV_FILE, NULL))
+        return FALSE;
+    result_cache_set_input("poi", POI_CSV_FILE, lp_get_digest());
+    return TRUE;
+}
 
 // ──────────────────────────────────────────────────────────────
 // TAB 1 — Ephemeris
@@ -175,6 +188,33 @@ typedef struct {
     qth_t     *qth;
 } ShowEphemCtx;
 
+/* Consumers of one ephemeris run. Each stage has its own queue; a NULL
+   queue means the stage does not take part in the run. STAGE_CACHE keeps
+   the samples of a run that was not in the result cache. */
+enum { STAGE_EPHEM = 0, STAGE_ZONE, STAGE_POI, STAGE_CACHE, N_STAGES };
+
+/* Blocks a stage may lag behind the propagation before it stalls it */
+#define EPHEM_QUEUE_DEPTH 8
+
+/* One ephemeris run, shared by the producer threads and the stages. With
+   several satellites a pool of producers, one per CPU, feeds src[i] for
+   slices of the satellites, and the merged stream goes to the stages. */
+typedef struct _EphemRun {
+    gint            ref;
+    ephem_queue_t  *queue[N_STAGES];
+    guint           nsats;
+    sat_t          *sats;          /* snapshots taken on the main thread */
+    ephem_queue_t **src;           /* per-satellite streams, nsats > 1 only */
+    GPtrArray      *names;         /* satellite names, by sample sat */
+    qth_t          *qth;
+    ephem_grid_t    grid;          /* sample times, shared by all satellites */
+    guint           n;             /* samples per satellite */
+    guint32        *catnr;         /* catalogue numbers, by sample sat */
+    gchar          *key[N_STAGES]; /* result cache entries, NULL = not cached */
+    gboolean        cached;        /* samples are replayed from key[STAGE_EPHEM] */
+    guint64         cache_max;     /* result cache size [bytes] */
+} EphemRun;
+
 typedef struct {
     GtkSatMap    *satmap;
     sat_t        *sat;
@@ -182,13 +222,16 @@ typedef struct {
     GtkListStore *store;
     GtkTreeView  *treeview;
     GtkSpinButton *hours_spin;  /* number‐of‐hours selector */
-    GtkSpinButton *step_spin;   /* time‐step selector (seconds) */
+    GtkSpinButton *step_spin;   /* time‐step selector (seconds, tenths allowed) */
     GtkProgressBar *progress_bar;
+    GPtrArray     *sats;        /* sat_t * of the run; [0] is the popup's satellite */
+    GtkWidget     *sats_button; /* “Satellites” chooser */
+    gboolean       sats_changed; /* set changed since the chooser opened */
 
     /* ── our private popup buffer ───────────────────────────────────────── */
-    struct _POISelectionCtx *poi_ctx;  /* NEW: link to the POI context for auto-refresh */
-    GSList        *buffer;
-    guint          buffer_count;
+    struct _POISelectionCtx *poi_ctx;  /* NEW: link to Tab 3 for the streamed filter */
+    struct _CountrySelectionCtx *country_ctx; /* link to Tab 2 for the streamed filter */
+    guint          buffer_count;   /* samples in the current run */
     GtkLabel      *count_label;    /* NEW: shows total points */    
 
     guint           pulse_source_id; /* for pulsing progress bar */
@@ -196,15 +239,14 @@ typedef struct {
     GtkLabel       *time_label;      /* shows elapsed seconds */
     guint           timer_source_id; /* id of the 1s timeout */
     guint64         start_time;      /* g_get_monotonic_time() at refresh */
-    /* ← Capture these on the main thread before launching the GTask */
-    int duration_s;
-    int step_sec;
     /* streaming insert */
-    GSList         *append_ptr;   /* next node in buffer to append */
-    guint           idle_id;       /* idle source id for chunked appends */
+    EphemRun       *run;           /* run feeding the table, NULL when idle */
+    GCancellable   *cancel;        /* cancels the producer of the run */
+    guint           idle_id;       /* source id for chunked appends */
     gboolean running;
     guint           inserted_count;   /* running count while streaming */
     gboolean        model_detached;   /* TRUE while tv model is detached */
+    result_index_t *index;            /* lookups on the rows of store */
 
 } EphemUpdateCtx;
 
@@ -212,20 +254,31 @@ typedef struct {
 // ──────────────────────────────────────────────────────────────
 // TAB 2 — Territory / Countries
 // ──────────────────────────────────────────────────────────────
-/*
- * @brief Callback / helper function.
- * @function zone_row_free
- * @param r ZoneRow *r
- * @return (void)
- */
 /* A small struct to carry our context into the callback */
 
 typedef struct {              /* for Tab 2 */
-   gchar *time;
    gdouble lat, lon;
-   gchar *country;
+   guint32 t;                 /* sample index, see RowTimes */
+   gint32  country;           /* index in tool_get_all_countries() */
+   guint32 sat;               /* index in RowTimes sats */
 } ZoneRow;
 
+/* Times of the samples a result table was filtered from: the time base of
+   the run (sample t at grid time t), or the Tab 1 strings when the
+   filter read the Tab 1 model. Satellites are named through sats. */
+typedef struct {
+    ephem_grid_t grid;
+    GPtrArray *strs;          /* Tab 1 time strings, or NULL */
+    GPtrArray *sats;          /* satellite names, by sample sat */
+} RowTimes;
+
+/* Result records of a filter pass, in sample order. Records are plain
+   values; names are resolved from the catalogues when rows are shown. */
+typedef struct _ResultRows {
+    GArray    *rows;          /* ZoneRow or PoiRow */
+    RowTimes   times;
+} ResultRows;
+
 /* ─── Tab 2: CountrySelectionCtx ───────────────────────────────────────── */
 typedef struct _CountrySelectionCtx {
     GtkWidget      *button;        /* “Select Region” button */
@@ -244,39 +297,36 @@ typedef struct _CountrySelectionCtx {
     guint64         start_time;      /* g_get_monotonic_time() at refresh */
     /* streaming insert + cancel */
     GCancellable   *cancel;
-    GPtrArray      *pending_rows;
+    ResultRows     *pending_rows;
     guint           next_row;
     guint           idle_id;
     gboolean        model_detached; /* TRUE while tv model is detached */
+    result_index_t *index;          /* lookups on the rows of store */
 
 } CountrySelectionCtx;
 
-static void zone_row_free(ZoneRow *r){ if(!r) return; g_free(r->time); g_free(r->country); g_free(r); }
 
 
 // ──────────────────────────────────────────────────────────────
 // TAB 3 — Points of Interest
 // ──────────────────────────────────────────────────────────────
-/*
- * @brief Callback / helper function.
- * @function poi_row_free
- * @param r PoiRow *r
- * @return (void)
- */
 /* A small struct to carry our context into the callback */
 
 typedef struct {              /* for Tab 3 */
-   gchar *time, *dir, *name, *type;
-   gdouble lat, lon, range_km;
+   gdouble lat, lon;
+   guint32 t;                 /* sample index, see RowTimes */
+   gint32  poi;               /* index in POISelectionCtx names/types, -1 = none */
+   gfloat  range_km;
+   gfloat  bearing;           /* formatted when shown or exported */
+   guint32 sat;               /* index in RowTimes sats */
 } PoiRow;
 
-static void poi_row_free(PoiRow *r){ if(!r) return; g_free(r->time); g_free(r->dir); g_free(r->name); g_free(r->type); g_free(r); }
-
 typedef struct _POISelectionCtx {
-    GtkTreeView   *tab1_tree;
+    EphemUpdateCtx *ephem;   /* Tab 1, whose runs feed this tab */
+    gboolean       active;   /* runs feed this tab once refreshed */
     GtkEntry      *entry;    /* the type-ahead text input */
     GtkWidget     *progress_bar;    /* +++ our new progress bar +++ */
-    gchar          name[128];/* selected POI name */
+    gchar          name[128];/* POI filter, empty for all */
     GPtrArray     *types;          /*  catched list of point types */
     GPtrArray     *names;    /* cached list from points_interests */
     GtkListStore  *store;    /* POI table model */
@@ -287,10 +337,7 @@ typedef struct _POISelectionCtx {
     guint          timer_source_id; /* NEW: id of the 1 s timeout */
     guint64        start_time;      /* NEW: g_get_monotonic_time() at refresh */
     GCancellable *cancel;
-    GPtrArray    *pending_rows;   /* from worker thread */
-    guint         next_row;       /* next row index to append */
-    guint         idle_id;        /* idle source for chunk appends */
-    gboolean      model_detached; /* TRUE while tv model is detached */
+    result_index_t *index;        /* lookups on the rows of store */
 
 } POISelectionCtx;
 
@@ -306,7 +353,7 @@ GTK main loop in sync and the code self-documenting.
 
 
 // for the ephemeris table
-enum { COL_TIME = 0, COL_LAT, COL_LON, N_COLS };
+enum { COL_TIME = 0, COL_LAT, COL_LON, COL_SAT, N_COLS };
 
 // for the country pop-over list
 enum { COL_COUNTRY = 0, N_COUNTRY_COLS };
@@ -317,6 +364,7 @@ enum {
     ZONE_COL_LAT,
     ZONE_COL_LON,
     ZONE_COL_COUNTRY,
+    ZONE_COL_SAT,
     ZONE_N_COLS
 };
 
@@ -328,6 +376,7 @@ enum {
     POI_COL_DIR,
     POI_COL_NAME,
     POI_COL_TYPE,
+    POI_COL_SAT,
     POI_N_COLS
 };
 
@@ -377,42 +426,298 @@ on_nb_switch_page (GtkNotebook *nb,
 }
 
 
-/* ── ensure compiler knows the real signature, not int() ───────────── */
-static gchar *format_bearing_text(double bearing);
 
 
 
-/* ─── timeout callback to pulse the ephemeris progress bar ────────────────────── */
 // ──────────────────────────────────────────────────────────────
 // TAB 1 — Ephemeris
 // ──────────────────────────────────────────────────────────────
 /*
- * @brief GLib timeout to pulse an indeterminate GtkProgressBar while work is in progress.
- * @function ephem_pulse_timeout
+ * @brief Takes a reference on an ephemeris run.
+ * @function ephem_run_ref
+ * @param run EphemRun *run
+ * @return (EphemRun *)
+ */
+static EphemRun *
+ephem_run_ref(EphemRun *run)
+{
+    g_atomic_int_inc(&run->ref);
+    return run;
+}
+
+/*
+ * @brief Drops a reference on an ephemeris run; the last one frees the queues.
+ * @function ephem_run_unref
+ * @param data gpointer data (EphemRun *)
+ * @return (void)
+ */
+static void
+ephem_run_unref(gpointer data)
+{
+    EphemRun *run = data;
+    if (!run || !g_atomic_int_dec_and_test(&run->ref))
+        return;
+    for (guint i = 0; i < N_STAGES; ++i)
+        ephem_queue_free(run->queue[i]);
+    for (guint i = 0; run->src && i < run->nsats; ++i)
+        ephem_queue_free(run->src[i]);
+    for (guint i = 0; i < N_STAGES; ++i)
+        g_free(run->key[i]);
+    g_free(run->src);
+    g_free(run->sats);
+    g_free(run->catnr);
+    g_ptr_array_unref(run->names);
+    g_free(run);
+}
+
+/*
+ * @brief Returns the time text of sample t, formatting into buf when needed.
+ * @function row_time_text
+ * @param rt const RowTimes *rt
+ * @param t guint32 t
+ * @param buf gchar *buf
+ * @param len gsize len
+ * @return (const gchar *) valid while buf and rt are
+ */
+static const gchar *
+row_time_text(const RowTimes *rt, guint32 t, gchar *buf, gsize len)
+{
+    if (rt->strs)
+        return g_ptr_array_index(rt->strs, t);
+    /* same grid as ephem_pipe_run(), so the text matches Tab 1 */
+    ephem_grid_format(&rt->grid, t, buf, len);
+    return buf;
+}
+
+static const gchar *
+row_sat_name(const RowTimes *rt, guint32 sat)
+{
+    return (rt->sats && sat < rt->sats->len) ? g_ptr_array_index(rt->sats, sat) : "";
+}
+
+/*
+ * @brief Sets the satellite names the Tab 1 COL_SAT indices refer to.
+ * @function tab1_set_sat_names
  * @thread Runs on the GTK main thread (GLib main loop).
- * @note Performance/UX critical: keeps UI responsive via chunked inserts, progress updates, and cancellability.
- * @param data gpointer data
- * @return (gboolean)
+ * @note Set before the rows of a run are added; Tab 1 stores the index only.
+ * @param store GtkListStore *store  the Tab 1 store
+ * @param names GPtrArray *names  satellite names, referenced
+ * @return (void)
  */
-static gboolean
-ephem_pulse_timeout(gpointer data)
+static void
+tab1_set_sat_names(GtkListStore *store, GPtrArray *names)
 {
-    EphemUpdateCtx *ctx = data;
-    if (!ctx || !GTK_IS_PROGRESS_BAR(ctx->progress_bar))
-        return G_SOURCE_REMOVE;
-    gtk_progress_bar_pulse(GTK_PROGRESS_BAR(ctx->progress_bar));
-    return G_SOURCE_CONTINUE;
+    g_object_set_data_full(G_OBJECT(store), "sat-names", g_ptr_array_ref(names),
+                           (GDestroyNotify)g_ptr_array_unref);
 }
 
+static gpointer
+sat_names_dup(gpointer names, gpointer user_data)
+{
+    (void)user_data;
+    return names ? g_ptr_array_ref(names) : NULL;
+}
 
-/* forward decl so Tab 1 idle can call it without implicit int */
-static void on_poi_entry_activate(GtkEntry *entry, gpointer user_data);
+/*
+ * @brief Returns the satellite names of the Tab 1 store.
+ * @function tab1_sat_names
+ * @thread Any thread; the names are referenced under the object data lock.
+ * @param store GtkTreeModel *store  the Tab 1 store
+ * @return (GPtrArray *) new reference, or NULL
+ */
+static GPtrArray *
+tab1_sat_names(GtkTreeModel *store)
+{
+    return g_object_dup_data(G_OBJECT(store), "sat-names", sat_names_dup, NULL);
+}
 
 /*
- * @brief Idle callback that streams batched rows into the GtkListStore to keep UI responsive.
+ * @brief Allocates an empty result set.
+ * @function result_rows_new
+ * @param elt guint elt  sizeof(ZoneRow) or sizeof(PoiRow)
+ * @param times const RowTimes *times  copied; takes over times->strs, refs times->sats
+ * @return (ResultRows *)
+ */
+static ResultRows *
+result_rows_new(guint elt, const RowTimes *times)
+{
+    ResultRows *res = g_new0(ResultRows, 1);
+    res->rows  = g_array_new(FALSE, FALSE, elt);
+    res->times = *times;
+    if (res->times.sats) g_ptr_array_ref(res->times.sats);
+    return res;
+}
+
+static void
+result_rows_free(gpointer data)
+{
+    ResultRows *res = data;
+    if (!res) return;
+    g_array_free(res->rows, TRUE);
+    if (res->times.strs) g_ptr_array_unref(res->times.strs);
+    if (res->times.sats) g_ptr_array_unref(res->times.sats);
+    g_free(res);
+}
+
+/*
+ * @brief tool_get_all_countries() as an array, for id → name lookups.
+ * @function country_catalogue
+ * @thread Any thread; the list is loaded once at startup.
+ * @return (GPtrArray *) owned by this function
+ */
+static GPtrArray *
+country_catalogue(void)
+{
+    static GPtrArray *names = NULL;
+    if (g_once_init_enter(&names)) {
+        GPtrArray *a = g_ptr_array_new();
+        for (GList *l = tool_get_all_countries(); l; l = l->next)
+            g_ptr_array_add(a, l->data);
+        g_once_init_leave(&names, a);
+    }
+    return names;
+}
+
+/*
+ * @brief Flattens the Tab 1 model for a filter pass.
+ * @function tab1_samples
+ * @thread Worker thread (reads the model like the filters always did).
+ * @param model GtkTreeModel *model
+ * @param times RowTimes *times  receives the Tab 1 time strings and a reference to the satellite names
+ * @param n guint *n  number of samples
+ * @return (ephem_sample_t *) g_free() when done; jd is not set, t is the Tab 1 row
+ */
+static ephem_sample_t *
+tab1_samples(GtkTreeModel *model, RowTimes *times, guint *n)
+{
+    guint  total = model ? (guint)gtk_tree_model_iter_n_children(model, NULL) : 0;
+    ephem_sample_t *out = g_new(ephem_sample_t, MAX(total, 1));
+    GtkTreeIter it;
+    guint  i = 0;
+
+    times->strs = g_ptr_array_new_full(total, g_free);
+    times->sats = model ? tab1_sat_names(model) : NULL;
+    gboolean ok = model && gtk_tree_model_get_iter_first(model, &it);
+    for (; ok && i < total; ok = gtk_tree_model_iter_next(model, &it), ++i) {
+        gchar *tstr = NULL;
+        gdouble lat = 0.0, lon = 0.0;
+        guint sat = 0;
+        gtk_tree_model_get(model, &it, COL_TIME, &tstr, COL_LAT, &lat,
+                           COL_LON, &lon, COL_SAT, &sat, -1);
+        out[i].jd  = 0.0;
+        out[i].lat = lat;
+        out[i].lon = lon;
+        out[i].t   = i;
+        out[i].sat = sat;
+        g_ptr_array_add(times->strs, tstr);   /* takes ownership */
+    }
+    *n = i;
+    return out;
+}
+
+/*
+ * @brief Returns the Julian date of sample t for the table index.
+ * @function row_time_jd
+ * @note A Tab 1 string that does not parse takes the time of the last row
+ *       in the index, or of the first Tab 1 row that parses, so the index
+ *       stays aligned with the store and in time order.
+ * @param rt const RowTimes *rt
+ * @param t guint32 t
+ * @param index const result_index_t *index  rows appended so far
+ * @return (gdouble) 0.0 only if no Tab 1 string parses
+ */
+static gdouble
+row_time_jd(const RowTimes *rt, guint32 t, const result_index_t *index)
+{
+    gdouble jd;
+    guint n = RESULT_INDEX_LEN(index);
+    if (!rt->strs)
+        return ephem_grid_jd(&rt->grid, t);
+    if (result_index_parse_time(g_ptr_array_index(rt->strs, t), &jd))
+        return jd;
+    if (n > 0)
+        return g_array_index(index->jd, gdouble, n - 1);
+    for (guint i = 0; i < rt->strs->len; ++i)
+        if (result_index_parse_time(g_ptr_array_index(rt->strs, i), &jd))
+            return jd;
+    return 0.0;
+}
+
+/*
+ * @brief Gap between rows that starts a new pass in a filtered table.
+ * @function row_times_gap
+ * @note One and a half sample steps: consecutive samples stay in one pass.
+ * @param rt const RowTimes *rt
+ * @return (gdouble) days
+ */
+static gdouble
+row_times_gap(const RowTimes *rt)
+{
+    gdouble a, b;
+    if (!rt->strs)
+        return 1.5e-9 * rt->grid.step_ns / 86400.0;
+    /* Tab 1 rows are consecutive samples (one row per satellite at each
+       time), so the first change of time gives the step */
+    if (rt->strs->len >= 2 &&
+        result_index_parse_time(g_ptr_array_index(rt->strs, 0), &a)) {
+        for (guint i = 1; i < rt->strs->len && i <= 64; ++i)
+            if (result_index_parse_time(g_ptr_array_index(rt->strs, i), &b) && b > a)
+                return 1.5 * (b - a);
+    }
+    return 1.5 / 86400.0;
+}
+
+/*
+ * @brief Replaces a table index with an empty one.
+ * @function table_index_reset
+ * @param index result_index_t **index
+ * @param mode result_seg_mode_t mode
+ * @param gap gdouble gap
+ * @return (void)
+ */
+static void
+table_index_reset(result_index_t **index, result_seg_mode_t mode, gdouble gap)
+{
+    result_index_free(*index);
+    *index = result_index_new(mode, gap);
+}
+
+/* Query bar under a result table (jump to time, filter by orbit/pass and
+   lat/lon box). A filter shows a copy of the matching rows; the full store
+   stays owned by the tab and keeps receiving rows. */
+typedef struct {
+    GtkTreeView     *tv;
+    GtkListStore   **store;        /* the tab's full store */
+    result_index_t **index;        /* its index */
+    GtkEntry        *time_entry;
+    GtkSpinButton   *seg_spin;     /* orbit or pass number, 0 = all */
+    GtkEntry        *box_entry;    /* "lat1,lat2,lon1,lon2" */
+    GtkLabel        *status;
+    GtkListStore    *sub;          /* filtered copy, or NULL */
+    GArray          *shown;        /* guint rows of *store listed in sub */
+} TableQuery;
+
+/*
+ * @brief Returns the full model of a result table, even while a filter is shown.
+ * @function table_source_model
+ * @param tv GtkTreeView *tv
+ * @return (GtkTreeModel *) may be NULL while the table is being filled
+ */
+static GtkTreeModel *
+table_source_model(GtkTreeView *tv)
+{
+    TableQuery   *q = g_object_get_data(G_OBJECT(tv), "table-query");
+    GtkTreeModel *m = gtk_tree_view_get_model(tv);
+    if (q && q->sub && m == GTK_TREE_MODEL(q->sub))
+        return GTK_TREE_MODEL(*q->store);
+    return m;
+}
+
+/*
+ * @brief Main-loop consumer of the Tab 1 queue; appends the blocks produced so far.
  * @function ephem_append_chunk_idle
- * @thread Runs on the GTK main thread (GLib main loop).
- * @note Performance/UX critical: keeps UI responsive via chunked inserts, progress updates, and cancellability.
+ * @thread Runs on the GTK main thread (GLib main loop), from a low-priority timeout.
+ * @note Performance/UX critical: never waits on the producer, which keeps propagating while rows are inserted.
  * @param data gpointer data
  * @return (gboolean)
  */
@@ -420,33 +725,48 @@ static void on_poi_entry_activate(GtkEntry *entry, gpointer user_data);
 static gboolean ephem_append_chunk_idle(gpointer data)
 {
     EphemUpdateCtx *ctx = data;
-    if (!ctx || !GTK_IS_LIST_STORE(ctx->store) || !ctx->append_ptr)
+    if (!ctx || !ctx->run || !GTK_IS_LIST_STORE(ctx->store))
         return G_SOURCE_REMOVE;
     const guint CHUNK = 20000;  /* ephemeris can be huge */
+    ephem_queue_t *q = ctx->run->queue[STAGE_EPHEM];
+    ephem_block_t *blk;
+    gboolean done = FALSE;
     guint added = 0;
-    while (ctx->append_ptr && added < CHUNK) {
-        EphemPoint *pp = ctx->append_ptr->data;
-        /* single-call insert is a tad cheaper than append+set */
-        gtk_list_store_insert_with_values(ctx->store, NULL, -1,
-                           COL_TIME, pp->time_str,
-                           COL_LAT,  pp->lat_deg,
-                           COL_LON,  pp->lon_deg,
-                           -1);
-        ctx->append_ptr = ctx->append_ptr->next;
-        ++added;
+    gchar tbuf[32];
+
+    while (added < CHUNK && (blk = ephem_queue_try_pop(q, &done)) != NULL) {
+        for (guint k = 0; k < blk->n; ++k) {
+            const ephem_sample_t *sm = &blk->samples[k];
+            ephem_grid_format(&ctx->run->grid, sm->t, tbuf, sizeof(tbuf));
+            if (ctx->index)
+                result_index_append(ctx->index, sm->jd, sm->lat, sm->lon);
+            /* single-call insert is a tad cheaper than append+set */
+            gtk_list_store_insert_with_values(ctx->store, NULL, -1,
+                               COL_TIME, tbuf,
+                               COL_LAT,  sm->lat,
+                               COL_LON,  sm->lon,
+                               COL_SAT,  (guint)sm->sat,
+                               -1);
+        }
+        added += blk->n;
+        ephem_block_unref(blk);
     }
-    /* track how many were appended (optional debug), but don't rewrite "Total:" */
     ctx->inserted_count += added;
 
-    if (!ctx->append_ptr) {
-            /* finished streaming rows — now stop pulse/timer */
-            if (ctx->pulse_source_id) { g_source_remove(ctx->pulse_source_id); ctx->pulse_source_id = 0; }
+    /* the run length is known up front, so the bar is determinate */
+    if (added && ctx->buffer_count && GTK_IS_PROGRESS_BAR(ctx->progress_bar))
+        gtk_progress_bar_set_fraction(ctx->progress_bar,
+            MIN(1.0, (gdouble)ctx->inserted_count / ctx->buffer_count));
+
+    if (done) {
+            /* queue closed and drained — now stop the timer */
             if (ctx->timer_source_id) { g_source_remove(ctx->timer_source_id); ctx->timer_source_id = 0; }
             /* reset bar and re-enable controls */
             if (GTK_IS_PROGRESS_BAR(ctx->progress_bar))
                 gtk_progress_bar_set_fraction(ctx->progress_bar, 0.0);
             safe_set_sensitive(GTK_WIDGET(ctx->hours_spin), TRUE);
             safe_set_sensitive(GTK_WIDGET(ctx->step_spin), TRUE);
+            safe_set_sensitive(ctx->sats_button, TRUE);
             /* allow next run */
             ctx->running = FALSE;
             /* reattach model now that it’s full */
@@ -454,9 +774,8 @@ static gboolean ephem_append_chunk_idle(gpointer data)
                 gtk_tree_view_set_model(ctx->treeview, GTK_TREE_MODEL(ctx->store));
                 ctx->model_detached = FALSE;
             }
-            /* now that Tab 1’s model is fully updated, auto-refresh POI if needed */
-            if (ctx->poi_ctx && ctx->poi_ctx->name[0] != '\0')
-                on_poi_entry_activate(ctx->poi_ctx->entry, ctx->poi_ctx);
+            ephem_run_unref(ctx->run);
+            ctx->run = NULL;
             ctx->idle_id = 0;
             return G_SOURCE_REMOVE;
     }
@@ -546,7 +865,7 @@ static void on_ephem_dialog_response(GtkDialog *dlg, gint response, gpointer use
                     }
                     /* Reload POI polygons and refresh Tab 3 immediately */
                     lp_cleanup();
-                    lp_init(POI_CSV_FILE, NULL);
+                    poi_tiles_load();
                     POISelectionCtx *poi = g_object_get_data(G_OBJECT(dlg), "poi_ctx");
                     if (poi) on_poi_refresh_clicked(NULL, poi);
                     GtkWidget *okmsg = gtk_message_dialog_new(GTK_WINDOW(sub),
@@ -582,7 +901,8 @@ static void on_ephem_dialog_response(GtkDialog *dlg, gint response, gpointer use
                     .col_range = POI_COL_RANGE,
                     .col_dir   = POI_COL_DIR,
                     .col_name  = POI_COL_NAME,
-                    .col_type  = POI_COL_TYPE
+                    .col_type  = POI_COL_TYPE,
+                    .col_sat   = POI_COL_SAT
                 };
                 GError *err = NULL;
                 if (sub_window_ephemeris_export_poi(poi->treeview, &spec, &cols, &err)) {
@@ -630,39 +950,40 @@ country_worker(GTask        *task,
 
     (void)source_object; 
     CountrySelectionCtx *ctx = user_data;
-    GtkTreeModel *src = gtk_tree_view_get_model(ctx->tv_tab1);
-    GList *pass = tool_list_from_model(src);
-    guint done  = 0;
+    GtkTreeModel *src = table_source_model(ctx->tv_tab1);
+    RowTimes times = { 0 };
+    guint total = 0;
+    ephem_sample_t *pts = tab1_samples(src, &times, &total);
 
-    /* Build a simple array of rows (no GTK in worker thread) */
-    GPtrArray *rows = g_ptr_array_new_with_free_func((GDestroyNotify)zone_row_free);
+    /* Build a flat array of records (no GTK in worker thread) */
+    ResultRows *res = result_rows_new(sizeof(ZoneRow), &times);
+    if (times.sats) g_ptr_array_unref(times.sats);
 
     /* Get static lists once, not per-point */
-    GList *all_polys     = tool_get_all_polygons();
-    GList *all_countries = tool_get_all_countries();
+    GList *all_polys = tool_get_all_polygons();
+    GPtrArray *countries = country_catalogue();
 
-    for (GList *l = pass; l; l = l->next) {
+    for (guint i = 0; i < total; ++i) {
             /* abort quickly if the user started another run/closed dialog */
             if (g_cancellable_is_cancelled(cancellable)) {
                 g_task_return_new_error(task, G_IO_ERROR, G_IO_ERROR_CANCELLED,
                                         "Operation was cancelled");
-                g_list_free_full(pass, (GDestroyNotify)g_free);
-                g_ptr_array_unref(rows);
+                g_free(pts);
+                result_rows_free(res);
                 return;
             }
-        ToolEphemPoint *pt = l->data;
-        gchar *hit_country = NULL;
+        const ephem_sample_t *pt = &pts[i];
+        gint hit = -1;
 
         /* Find the first polygon that contains this point */
-        GList *pp = all_polys;
-        GList *cc = all_countries;
-        for (; pp && cc; pp = pp->next, cc = cc->next) {
+        gint idx = 0;
+        for (GList *pp = all_polys; pp && (guint)idx < countries->len; pp = pp->next, ++idx) {
             GArray   *poly = pp->data;
             if (_point_in_poly((GeoPoint*)poly->data,
                                poly->len,
                                pt->lat, pt->lon))
             {
-                hit_country = (gchar*)cc->data;
+                hit = idx;
                 break;
             }
         }
@@ -670,27 +991,48 @@ country_worker(GTask        *task,
          *  - user selected "Territory" (all land), OR
          *  - hit_country matches the selected country
          */
-        if (hit_country &&
+        if (hit >= 0 &&
             (g_strcmp0(ctx->name, "Territory") == 0 ||
-             g_strcmp0(hit_country, ctx->name) == 0)) {
-            ZoneRow *r = g_new0(ZoneRow,1);
-            r->time    = g_strdup(pt->time_str);
-            r->lat     = pt->lat;
-            r->lon     = pt->lon;
-            r->country = g_strdup(hit_country);
-            g_ptr_array_add(rows, r);
+             g_strcmp0(g_ptr_array_index(countries, hit), ctx->name) == 0)) {
+            ZoneRow r;
+            memset(&r, 0, sizeof(r));   /* padding goes to the result cache */
+            r.lat = pt->lat; r.lon = pt->lon;
+            r.t = pt->t; r.country = hit; r.sat = pt->sat;
+            g_array_append_val(res->rows, r);
         }
-
-
-        done++;
     }
 
-    g_list_free_full(pass, (GDestroyNotify)g_free);
+    g_free(pts);
     /* hand off rows to main thread */
-    g_task_return_pointer(task, rows, (GDestroyNotify)g_ptr_array_unref);
+    g_task_return_pointer(task, res, result_rows_free);
 }
 
 
+/*
+ * @brief Appends record i of a Territory result set to the Tab 2 store and index.
+ * @function zone_store_append
+ * @thread Runs on the GTK main thread (GLib main loop).
+ * @param ctx CountrySelectionCtx *ctx
+ * @param res const ResultRows *res
+ * @param i guint i
+ * @return (void)
+ */
+static void
+zone_store_append(CountrySelectionCtx *ctx, const ResultRows *res, guint i)
+{
+    const ZoneRow *r = &g_array_index(res->rows, ZoneRow, i);
+    gchar tbuf[32];
+    if (ctx->index)
+        result_index_append(ctx->index, row_time_jd(&res->times, r->t, ctx->index),
+                            r->lat, r->lon);
+    gtk_list_store_insert_with_values(ctx->store, NULL, -1,
+        ZONE_COL_TIME,    row_time_text(&res->times, r->t, tbuf, sizeof(tbuf)),
+        ZONE_COL_LAT,     r->lat,
+        ZONE_COL_LON,     r->lon,
+        ZONE_COL_COUNTRY, g_ptr_array_index(country_catalogue(), r->country),
+        ZONE_COL_SAT,     row_sat_name(&res->times, r->sat), -1);
+}
+
 /*
  * @brief Idle callback that streams batched rows into the GtkListStore to keep UI responsive.
  * @function country_append_chunk_idle
@@ -707,17 +1049,10 @@ static gboolean country_append_chunk_idle(gpointer data)
     if (!ctx->pending_rows) return G_SOURCE_REMOVE;
 
     const guint CHUNK = 20000; /* territory lists are big; tune as needed */
+    const guint total = ctx->pending_rows->rows->len;
     guint added = 0;
-    for (; ctx->next_row < ctx->pending_rows->len && added < CHUNK; ++ctx->next_row, ++added) {
-        ZoneRow *r = ctx->pending_rows->pdata[ctx->next_row];
-        GtkTreeIter it;
-        gtk_list_store_append(ctx->store, &it);
-        gtk_list_store_set(ctx->store, &it,
-            ZONE_COL_TIME,    r->time,
-            ZONE_COL_LAT,     r->lat,
-            ZONE_COL_LON,     r->lon,
-            ZONE_COL_COUNTRY, r->country, -1);
-    }
+    for (; ctx->next_row < total && added < CHUNK; ++ctx->next_row, ++added)
+        zone_store_append(ctx, ctx->pending_rows, ctx->next_row);
 
     /* update total counter as we go (cheap) */
     if (GTK_IS_LABEL(ctx->count_label)) {
@@ -726,7 +1061,7 @@ static gboolean country_append_chunk_idle(gpointer data)
         g_free(txt);
     }
 
-    if (ctx->next_row >= ctx->pending_rows->len) {
+    if (ctx->next_row >= total) {
         /* all rows streamed — stop pulse/timer and finalize UI */
         if (ctx->pulse_source_id) { g_source_remove(ctx->pulse_source_id); ctx->pulse_source_id = 0; }
         if (ctx->timer_source_id) { g_source_remove(ctx->timer_source_id); ctx->timer_source_id = 0; }
@@ -751,7 +1086,7 @@ static gboolean country_append_chunk_idle(gpointer data)
             gtk_tree_view_set_model(GTK_TREE_VIEW(ctx->treeview), GTK_TREE_MODEL(ctx->store));
             ctx->model_detached = FALSE;
         }
-        g_ptr_array_unref(ctx->pending_rows);
+        result_rows_free(ctx->pending_rows);
         ctx->pending_rows = NULL;
         ctx->idle_id = 0;
         return G_SOURCE_REMOVE;
@@ -782,7 +1117,7 @@ on_country_done(GObject      *source,
     CountrySelectionCtx *ctx = user_data;
     GError *error = NULL;
 
-    GPtrArray *rows = g_task_propagate_pointer(G_TASK(res), &error);
+    ResultRows *rows = g_task_propagate_pointer(G_TASK(res), &error);
     if (error) {
         if (g_error_matches(error, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
             /* expected: user cancelled / restarted */
@@ -798,9 +1133,12 @@ on_country_done(GObject      *source,
     } else {
         /* create target model, DETACH view, then stream rows in idle */
         ctx->store = gtk_list_store_new(
-            ZONE_N_COLS, G_TYPE_STRING, G_TYPE_DOUBLE, G_TYPE_DOUBLE, G_TYPE_STRING);
+            ZONE_N_COLS, G_TYPE_STRING, G_TYPE_DOUBLE, G_TYPE_DOUBLE, G_TYPE_STRING,
+            G_TYPE_STRING);
         gtk_tree_view_set_model(GTK_TREE_VIEW(ctx->treeview), NULL); /* detach for speed */
         ctx->model_detached = TRUE;
+        table_index_reset(&ctx->index, RESULT_SEG_PASS, row_times_gap(&rows->times));
+        result_rows_free(ctx->pending_rows);
         ctx->pending_rows = rows;
         ctx->next_row     = 0;
         if (ctx->idle_id) g_source_remove(ctx->idle_id);
@@ -851,286 +1189,117 @@ static void cancel_poi_if_running(GtkWidget *w, gpointer user_data) {
 
 
 
-/* Idle callback to update the POI progress bar fraction and “XX%” text */
-typedef struct { POISelectionCtx *ctx; double fraction; } POIProgressUpdate;
-/*
- * @brief Idle callback to update the GtkProgressBar fraction/text from a worker thread.
- * @function poi_progress_idle
- * @thread Runs on the GTK main thread (GLib main loop).
- * @note Performance/UX critical: keeps UI responsive via chunked inserts, progress updates, and cancellability.
- * @param data gpointer data
- * @return (gboolean)
- */
-
-static gboolean G_GNUC_UNUSED
-poi_progress_idle(gpointer data){
-
-    POIProgressUpdate *up = data;
-
-    /* if the bar has been destroyed (dialog closed), stop immediately */
-    if (!GTK_IS_PROGRESS_BAR(up->ctx->progress_bar)) {
-        g_free(up);
-        return G_SOURCE_REMOVE;
-    }
-    gtk_progress_bar_set_fraction(
-        GTK_PROGRESS_BAR(up->ctx->progress_bar), up->fraction);
-    /* display “XX%” */
-    gchar *pct = g_strdup_printf("%d%%", (int)(up->fraction * 100));
-    gtk_progress_bar_set_text(GTK_PROGRESS_BAR(up->ctx->progress_bar), pct);
-    g_free(pct);
-    return G_SOURCE_REMOVE;
-}
-
-/* Background worker: builds a new ListStore and reports progress */
-/*
- * @brief Background worker thread function. Performs heavy computation off the GTK main loop.
- * @function poi_worker
- * @thread Runs in a background GTask thread. Do NOT touch GTK here.
- * @note Performance/UX critical: keeps UI responsive via chunked inserts, progress updates, and cancellability.
- * @param task GTask        *task
- * @param source_object gpointer      source_object
- * @param user_data gpointer      user_data
- * @param cancellable GCancellable *cancellable
- * @return (void)
- */
-
+/* Read-only inputs of a POI match */
 typedef struct {
-    GList       *begin;     /* first ToolEphemPoint node for this slice */
-    guint        count;     /* how many points in this slice */
     GList       *polys;     /* shared list (do not free) */
-    GPtrArray   *bboxes;    /* shared bboxes (do not free) */
+    GPtrArray   *bboxes;    /* one BBox per polygon */
     gint         filter_idx;
-    POISelectionCtx *ctx;   /* shared names/types (do not free) */
-    GPtrArray   *out;       /* per-slice result rows */
     GCancellable *cancellable;
-} POISlice;
-
-static void poi_slice_worker(gpointer data, gpointer user_data) {
-    POISlice *s = data; (void)user_data;
-    GList *qfixed = (s->filter_idx >= 0) ? g_list_nth(s->polys, s->filter_idx) : NULL;
-    gint   idxfixed = s->filter_idx;
-    GList *node = s->begin;
-    for (guint k=0; k < s->count && node; ++k, node=node->next) {
-        if (g_cancellable_is_cancelled(s->cancellable)) return;
-        ToolEphemPoint *t = node->data;
-        gint idx = 0;
-        for (GList *q = (qfixed ? qfixed : s->polys);
-             q; q = (qfixed ? NULL : q->next), ++idx)
-        {
-            if (qfixed) idx = idxfixed;
-            GArray *poly = q->data;
-            BBox   *bb   = g_ptr_array_index(s->bboxes, idx);
-            if (!bbox_contains(bb, t->lat, t->lon)) continue;
-            if (lp_point_in_poly((LP_GeoPoint*)poly->data, poly->len, t->lat, t->lon)) {
-                if (s->ctx->name[0] &&
-                    g_strcmp0(s->ctx->name, g_ptr_array_index(s->ctx->names, idx)) != 0)
-                    break;
-                LP_GeoPoint ctr = lp_polygon_center(poly);
-                LP_GeoPoint pt  = (LP_GeoPoint){ t->lat, t->lon };
-                double dist = lp_compute_distance_km(&ctr, &pt);
-                double brg  = lp_compute_bearing_deg(&ctr, &pt);
-                gchar *dir  = format_bearing_text(brg);
-                gchar *nm   = g_ptr_array_index(s->ctx->names, idx);
-                gchar *tp   = g_ptr_array_index(s->ctx->types, idx);
-                PoiRow *r   = g_new0(PoiRow,1);
-                r->time     = g_strdup(t->time_str);
-                r->lat      = t->lat; r->lon = t->lon;
-                r->range_km = dist;   r->dir = dir;
-                r->name     = g_strdup(nm); r->type = g_strdup(tp);
-                g_ptr_array_add(s->out, r);
-                break;
-            }
-        }
-    }
-}
+} POIMatch;
 
+/*
+ * @brief Loads the POI polygons and resolves the filter once per match.
+ * @function poi_match_init
+ * @thread Worker thread; reads only the cached name list of ctx.
+ * @param m POIMatch *m
+ * @param ctx POISelectionCtx *ctx
+ * @param poi const gchar *poi  name used to pin a single polygon; any other
+ *            text, or none, matches all of them
+ * @param cancellable GCancellable *cancellable
+ * @return (void)
+ */
 static void
-poi_worker(GTask        *task,
-           gpointer      source_object,
-           gpointer      user_data,
-           GCancellable *cancellable)
+poi_match_init(POIMatch *m, POISelectionCtx *ctx, const gchar *poi,
+               GCancellable *cancellable)
 {
-            
-    (void)source_object; 
-    POISelectionCtx *ctx = user_data;
-    /* 1) snapshot filter name */
-    const gchar *poi = gtk_entry_get_text(ctx->entry);
-
-    /* 2) grab ephemeris from Tab 1 */
-    GtkTreeModel *m1 = gtk_tree_view_get_model(ctx->tab1_tree);
-    GList       *tool_pts = tool_list_from_model(m1);
-    guint total = g_list_length(tool_pts);
-
-    /* 3) prepare temporary store (must list all 7 column types!) */
-    /* reserve a bit to reduce reallocs; keep your free func */
-    GPtrArray *rows = g_ptr_array_sized_new(total > 16384 ? 16384 : total);
-    g_ptr_array_set_free_func(rows, (GDestroyNotify)poi_row_free);
-
-    /* 4) load polygons once + precompute bboxes (massive prune) */
-    GList *polys = lp_get_all_polygons();
-    const guint npolys = g_list_length(polys);
-    GPtrArray *bboxes = g_ptr_array_sized_new(npolys);
-    g_ptr_array_set_free_func(bboxes, g_free);
-    for (GList *q = polys; q; q = q->next) {
+    /* load polygons once + precompute bboxes (massive prune) */
+    m->polys = lp_get_all_polygons();
+    m->bboxes = g_ptr_array_sized_new(g_list_length(m->polys));
+    g_ptr_array_set_free_func(m->bboxes, g_free);
+    for (GList *q = m->polys; q; q = q->next) {
         BBox bb = bbox_from_poly((GArray*)q->data);
-        g_ptr_array_add(bboxes, g_memdup2(&bb, sizeof(BBox)));
+        g_ptr_array_add(m->bboxes, g_memdup2(&bb, sizeof(BBox)));
     }
     /* If a specific POI name is typed, resolve its index once */
-    gint filter_idx = -1;
+    m->filter_idx = -1;
     if (poi && poi[0] != '\0' && ctx->names) {
         for (guint i = 0; i < ctx->names->len; ++i)
-            if (g_strcmp0(poi, g_ptr_array_index(ctx->names, i)) == 0) { filter_idx = (gint)i; break; }
-    }
-
-    /* Split points into slices and process in parallel */
-    const guint nthreads = CLAMP((guint)g_get_num_processors(), 2, 8);
-    GThreadPool *pool = g_thread_pool_new(poi_slice_worker, NULL, nthreads, FALSE, NULL);
-    GPtrArray   *slices = g_ptr_array_new_with_free_func(g_free);
-    /* count nodes and slice size */
-    guint npts = total, per = (npts + nthreads - 1) / nthreads;
-    GList *start = tool_pts;
-    for (guint i=0; i<nthreads && start; ++i) {
-        POISlice *s = g_new0(POISlice,1);
-        s->begin = start; s->count = MIN(per, npts - i*per);
-        /* advance 'start' by s->count */
-        for (guint k=0; k<s->count && start; ++k) start = start->next;
-        s->polys = polys; s->bboxes = bboxes;
-        s->filter_idx = filter_idx; s->ctx = ctx; s->cancellable = cancellable;
-        s->out = g_ptr_array_new_with_free_func((GDestroyNotify)poi_row_free);
-        g_ptr_array_add(slices, s);
-        g_thread_pool_push(pool, s, NULL);
-    }
-    g_thread_pool_free(pool, FALSE, TRUE); /* wait for completion */
-    /* Concatenate per-slice outputs into 'rows' (preserve approx order) */
-    for (guint i=0; i<slices->len; ++i) {
-        POISlice *s = g_ptr_array_index(slices, i);
-        for (guint k=0; k<s->out->len; ++k)
-            g_ptr_array_add(rows, g_ptr_array_index(s->out, k));
-        g_ptr_array_free(s->out, FALSE);
-    }
-    g_ptr_array_free(slices, TRUE);
-
-    /* cleanup only the list nodes; do NOT free the ToolEphemPoint pointers */
-    g_list_free(tool_pts);
-    g_ptr_array_free(bboxes, TRUE);
-
-    /* hand back the new store */
-    g_task_return_pointer(task, rows, (GDestroyNotify)g_ptr_array_unref);
+            if (g_strcmp0(poi, g_ptr_array_index(ctx->names, i)) == 0) { m->filter_idx = (gint)i; break; }
+    }
+    m->cancellable = cancellable;
 }
+
 /*
- * @brief Idle callback that streams batched rows into the GtkListStore to keep UI responsive.
- * @function poi_append_chunk_idle
- * @thread Runs on the GTK main thread (GLib main loop).
- * @note Performance/UX critical: keeps UI responsive via chunked inserts, progress updates, and cancellability.
- * @param data gpointer data
- * @return (gboolean)
+ * @brief Matches n points against the POI polygons.
+ * @function poi_match_points
+ * @thread Stage worker thread; the zone stage and the producers run in
+ *         parallel with it.
+ * @note A point matches at most one POI, so records come out in point order.
+ * @param m const POIMatch *m
+ * @param pts const ephem_sample_t *pts
+ * @param n guint n
+ * @param rows GArray *rows  receives the matched PoiRow records
+ * @return (void)
  */
-
-static gboolean poi_append_chunk_idle(gpointer data)
+static void
+poi_match_points(const POIMatch *m, const ephem_sample_t *pts,
+                 guint n, GArray *rows)
 {
-    POISelectionCtx *ctx = data;
-    if (!ctx || !GTK_IS_LIST_STORE(ctx->store)) return FALSE;
-    if (!ctx->pending_rows) return FALSE;
-
-    const guint CHUNK = 20000;            /* tune for snappiness vs speed */
-    guint added = 0;
-
-    for (; ctx->next_row < ctx->pending_rows->len && added < CHUNK; ++ctx->next_row, ++added) {
-        PoiRow *r = ctx->pending_rows->pdata[ctx->next_row];
-        GtkTreeIter it;
-        gtk_list_store_append(ctx->store, &it);
-        gtk_list_store_set(ctx->store, &it,
-            POI_COL_TIME,  r->time,
-            POI_COL_LAT,   r->lat,
-            POI_COL_LON,   r->lon,
-            POI_COL_RANGE, r->range_km,
-            POI_COL_DIR,   r->dir,
-            POI_COL_NAME,  r->name,
-            POI_COL_TYPE,  r->type, -1);
-    }
-
-    if (ctx->next_row >= ctx->pending_rows->len) {
-        /* all rows streamed — stop pulse/timer and finalize UI */
-        if (ctx->pulse_source_id) { g_source_remove(ctx->pulse_source_id); ctx->pulse_source_id = 0; }
-        if (ctx->timer_source_id) { g_source_remove(ctx->timer_source_id); ctx->timer_source_id = 0; }
-        if (GTK_IS_LABEL(ctx->time_label)) {
-            guint64 now = g_get_monotonic_time();
-            guint   secs = (now - ctx->start_time) / G_USEC_PER_SEC;
-            gchar  *txt  = g_strdup_printf("%us", secs);
-            gtk_label_set_text(GTK_LABEL(ctx->time_label), txt);
-            g_free(txt);
-        }
-        if (GTK_IS_PROGRESS_BAR(ctx->progress_bar)) {
-            gtk_progress_bar_set_fraction(GTK_PROGRESS_BAR(ctx->progress_bar), 1.0);
-            gtk_progress_bar_set_text(GTK_PROGRESS_BAR(ctx->progress_bar), "100%");
-        }
-        safe_set_sensitive(GTK_WIDGET(ctx->entry), TRUE);
-        safe_set_sensitive(ctx->button, TRUE);  /* re-enable together */
-        /* reattach model for one-shot layout & paint */
-        if (ctx->model_detached && GTK_IS_TREE_VIEW(ctx->treeview)) {
-            gtk_tree_view_set_model(GTK_TREE_VIEW(ctx->treeview), GTK_TREE_MODEL(ctx->store));
-            ctx->model_detached = FALSE;
+    for (guint k = 0; k < n; ++k) {
+        if (g_cancellable_is_cancelled(m->cancellable)) return;
+        const ephem_sample_t *t = &pts[k];
+        GList *q   = (m->filter_idx >= 0) ? g_list_nth(m->polys, m->filter_idx) : m->polys;
+        gint   idx = (m->filter_idx >= 0) ? m->filter_idx : 0;
+        for (; q; q = (m->filter_idx >= 0) ? NULL : q->next, ++idx) {
+            GArray *poly = q->data;
+            BBox   *bb   = g_ptr_array_index(m->bboxes, idx);
+            if (!bbox_contains(bb, t->lat, t->lon)) continue;
+            if (lp_point_in_poly((LP_GeoPoint*)poly->data, poly->len, t->lat, t->lon)) {
+                LP_GeoPoint ctr = lp_polygon_center(poly);
+                LP_GeoPoint pt  = (LP_GeoPoint){ t->lat, t->lon };
+                PoiRow r;
+                memset(&r, 0, sizeof(r));   /* padding goes to the result cache */
+                r.lat      = t->lat; r.lon = t->lon;
+                r.t        = t->t;
+                r.sat      = t->sat;
+                r.poi      = idx;
+                r.range_km = (gfloat)lp_compute_distance_km(&ctr, &pt);
+                r.bearing  = (gfloat)lp_compute_bearing_deg(&ctr, &pt);
+                g_array_append_val(rows, r);
+                break;
+            }
         }
-        g_ptr_array_unref(ctx->pending_rows);
-        ctx->pending_rows = NULL;
-        ctx->idle_id = 0;
-        return G_SOURCE_REMOVE;
     }
-    return G_SOURCE_CONTINUE;
 }
 
-
-
-/* Runs on the main thread when poi_worker finishes */
 /*
- * @brief GTask "finished" handler executed on the GTK main thread.
- * @function on_poi_done
+ * @brief Appends record i of a POI result set to the Tab 3 store and index.
+ * @function poi_store_append
  * @thread Runs on the GTK main thread (GLib main loop).
- * @param source GObject      *source
- * @param res GAsyncResult *res
- * @param user_data gpointer      user_data
+ * @note The bearing is stored as a number and formatted by the cell renderer.
+ * @param ctx POISelectionCtx *ctx  catalogue of names/types
+ * @param res const ResultRows *res
+ * @param i guint i
  * @return (void)
  */
 static void
-on_poi_done(GObject      *source,
-            GAsyncResult *res,
-            gpointer      user_data){
-
-    (void)source;
-    POISelectionCtx *ctx = user_data;
-
-    /* if the treeview is gone, don’t try to update */
-    if (!GTK_IS_TREE_VIEW(ctx->treeview))
-        return;  
-    GError *error = NULL;
-
-    GPtrArray *rows = g_task_propagate_pointer(G_TASK(res), &error);
-    if (error) {
-        if (g_error_matches(error, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
-            if (ctx->pulse_source_id) { g_source_remove(ctx->pulse_source_id); ctx->pulse_source_id = 0; }
-            if (ctx->timer_source_id) { g_source_remove(ctx->timer_source_id); ctx->timer_source_id = 0; }
-            safe_set_sensitive(GTK_WIDGET(ctx->entry), TRUE);
-        } else {
-            g_warning("POI filter error: %s", error->message);
-        }
-        g_clear_error(&error);
-        return;
-    }
-    /* Create the target model, but DETACH the view while we stream rows. */
-    ctx->store = gtk_list_store_new(
-        POI_N_COLS, G_TYPE_STRING, G_TYPE_DOUBLE, G_TYPE_DOUBLE,
-        G_TYPE_DOUBLE, G_TYPE_STRING, G_TYPE_STRING, G_TYPE_STRING);
-    gtk_tree_view_set_model(ctx->treeview, NULL);   /* <- detach for speed */
-    ctx->model_detached = TRUE;
-    ctx->pending_rows = rows;
-    ctx->next_row     = 0;
-    if (ctx->idle_id) g_source_remove(ctx->idle_id);
-    ctx->idle_id = g_idle_add_full(G_PRIORITY_LOW, poi_append_chunk_idle, ctx, NULL);
-
-
+poi_store_append(POISelectionCtx *ctx, const ResultRows *res, guint i)
+{
+    const PoiRow *r = &g_array_index(res->rows, PoiRow, i);
+    gchar tbuf[32];
+    if (ctx->index)
+        result_index_append(ctx->index, row_time_jd(&res->times, r->t, ctx->index),
+                            r->lat, r->lon);
+    gtk_list_store_insert_with_values(ctx->store, NULL, -1,
+        POI_COL_TIME,  row_time_text(&res->times, r->t, tbuf, sizeof(tbuf)),
+        POI_COL_LAT,   r->lat,
+        POI_COL_LON,   r->lon,
+        POI_COL_RANGE, (gdouble)r->range_km,
+        POI_COL_DIR,   (gdouble)r->bearing,
+        POI_COL_NAME,  g_ptr_array_index(ctx->names, r->poi),
+        POI_COL_TYPE,  g_ptr_array_index(ctx->types, r->poi),
+        POI_COL_SAT,   row_sat_name(&res->times, r->sat), -1);
 }
-
-
 /* ─── Handler for POI entry completion: trigger activate to filter ─── */
 /*
  * @brief GtkEntryCompletion "match-selected" handler that triggers the corresponding action.
@@ -1287,55 +1456,42 @@ update_poi_timer(gpointer user_data)
 }
 
 /* ───────────────────────────────────────────────────────────────────── */
-/* wrapper for the “Refresh” button, so we pass the real entry */
 /*
- * @brief Callback / helper function.
- * @function on_poi_refresh_clicked
- * @param button GtkButton   *button
- * @param user_data gpointer     user_data
+ * @brief Matches the POIs again with the filter in the entry.
+ * @function poi_rerun
+ * @thread Runs on the GTK main thread (GLib main loop).
+ * @note Tab 3 is filled by the POI stage of a Tab 1 run, so this restarts
+ *       the run; its samples come from the result cache when they are in it.
+ *       A run in progress is left alone and the filter applies to the next.
+ * @param ctx POISelectionCtx *ctx
  * @return (void)
  */
 static void
-on_poi_refresh_clicked(GtkButton   *button,
-                       gpointer     user_data){
-                        
-                        
+poi_rerun(POISelectionCtx *ctx)
+{
+    g_strlcpy(ctx->name, gtk_entry_get_text(ctx->entry), sizeof(ctx->name));
+    ctx->active = TRUE;
+    if (ctx->ephem && !ctx->ephem->running)
+        on_orbits_value_changed(NULL, ctx->ephem);
+}
+
+/*
+ * @brief "Refresh" button: clears the filter and matches all POIs again.
+ * @function on_poi_refresh_clicked
+ * @param button GtkButton   *button
+ * @param user_data gpointer     user_data
+ * @return (void)
+ */
+static void
+on_poi_refresh_clicked(GtkButton   *button,
+                       gpointer     user_data){
+
     (void)button;
     POISelectionCtx *ctx = user_data;
 
-    if (ctx->cancel) {
-        g_cancellable_cancel(ctx->cancel);
-        g_clear_object(&ctx->cancel);
-    }
     /* clear filter entry so Refresh restores all POIs */
     gtk_entry_set_text(GTK_ENTRY(ctx->entry), "");
-    
-    /* disable input during filter */
-    safe_set_sensitive(GTK_WIDGET(ctx->entry), FALSE);
-
-    /* reset bar */
-    if (GTK_IS_PROGRESS_BAR(ctx->progress_bar))
-        gtk_progress_bar_set_fraction(GTK_PROGRESS_BAR(ctx->progress_bar), 0.0);
-    /* start the elapsed‐time counter */
-    ctx->start_time      = g_get_monotonic_time();
-    gtk_label_set_text(GTK_LABEL(ctx->time_label), "0s");
-    ctx->timer_source_id = g_timeout_add_seconds(1,
-                                                 update_poi_timer,
-                                                 ctx);
-
-
-    /* launch async filter; idle callbacks drive the bar */
-    ctx->cancel = g_cancellable_new();
-    GTask *task = g_task_new(NULL, ctx->cancel, on_poi_done, ctx);
-    g_task_set_check_cancellable(task, TRUE);
-    g_task_set_task_data(task, ctx, NULL);
-    g_task_run_in_thread(task, poi_worker);
-    g_object_unref(task);
-
-    /* ── start the pulse immediately so the bar “moves” right away ── */
-    ctx->pulse_source_id = g_timeout_add(100, poi_pulse_timeout, ctx);
-
-
+    poi_rerun(ctx);
 }
 
 
@@ -1366,17 +1522,19 @@ on_country_match_selected(GtkEntryCompletion *completion,
     return FALSE;
 }
 
-/* Tab 3: Returns a newly-allocated string for bearing, e.g. "123.4°" */
+/* Tab 3: Formats a bearing into buf, e.g. "123.4°" */
 /* 
  * @brief Formats a bearing in degrees into a short human-readable string.
  * @function format_bearing_text
  * @param bearing double bearing
- * @return (gchar *)
+ * @param buf gchar *buf
+ * @param len gsize len
+ * @return (void)
  */
-static gchar *
-format_bearing_text(double bearing)
+static void
+format_bearing_text(double bearing, gchar *buf, gsize len)
 {
-    return g_strdup_printf("%.1f°", bearing);
+    g_snprintf(buf, len, "%.1f°", bearing);
 }
 
 /* Helper: format the “Latitude (°)” cell as text from a double. */
@@ -1432,6 +1590,57 @@ lon_cell_data_func(GtkTreeViewColumn *column,
     (void)column;
     (void)data;
 }
+/* Helper: format the “Direction” cell from the stored bearing. */
+/*
+ * @brief GtkTreeViewColumn cell-data function to format numeric cells.
+ * @function dir_cell_data_func
+ * @param column GtkTreeViewColumn *column
+ * @param renderer GtkCellRenderer   *renderer
+ * @param model GtkTreeModel      *model
+ * @param iter GtkTreeIter       *iter
+ * @param data gpointer           data  (model column, as GINT_TO_POINTER)
+ * @return (void)
+ */
+static void
+dir_cell_data_func(GtkTreeViewColumn *column,
+                   GtkCellRenderer   *renderer,
+                   GtkTreeModel      *model,
+                   GtkTreeIter       *iter,
+                   gpointer           data)
+{
+    double brg;
+    gchar buf[32];
+    gtk_tree_model_get(model, iter, GPOINTER_TO_INT(data), &brg, -1);
+    format_bearing_text(brg, buf, sizeof(buf));
+    g_object_set(renderer, "text", buf, NULL);
+    (void)column;
+}
+
+/*
+ * @brief Cell data function that shows the satellite name of a Tab 1 row.
+ * @function sat_cell_data_func
+ * @param column GtkTreeViewColumn *column
+ * @param renderer GtkCellRenderer   *renderer
+ * @param model GtkTreeModel      *model  the Tab 1 store or a filtered copy
+ * @param iter GtkTreeIter       *iter
+ * @param data gpointer           data  (the Tab 1 store, which holds the names)
+ * @return (void)
+ */
+static void
+sat_cell_data_func(GtkTreeViewColumn *column,
+                   GtkCellRenderer   *renderer,
+                   GtkTreeModel      *model,
+                   GtkTreeIter       *iter,
+                   gpointer           data)
+{
+    GPtrArray *names = g_object_get_data(G_OBJECT(data), "sat-names");
+    guint sat = 0;
+    gtk_tree_model_get(model, iter, COL_SAT, &sat, -1);
+    g_object_set(renderer, "text",
+                 (names && sat < names->len) ? g_ptr_array_index(names, sat) : "",
+                 NULL);
+    (void)column;
+}
 /*
  * @brief GtkEntry "activate" handler to launch the associated action.
  * @function on_poi_entry_activate
@@ -1445,10 +1654,562 @@ static void
 on_poi_entry_activate(GtkEntry *entry, gpointer user_data){
     (void)entry;
     POISelectionCtx *ctx = user_data;
-    /* Simply kick off the existing asynchronous worker: */
-    on_poi_refresh_clicked(NULL, ctx);
+    poi_rerun(ctx);
+}
+
+
+
+// ──────────────────────────────────────────────────────────────
+// Territory / POI stages of an ephemeris run
+// ──────────────────────────────────────────────────────────────
+/*
+ When Tab 2 has a selection, or Tab 3 has been refreshed, a new ephemeris
+ run feeds it directly: each stage pops blocks from its own queue in a
+ worker thread while the propagation is still going, and posts the rows it
+ keeps to the main loop.
+ The views stay attached, so partial results show up as they arrive.
+ Cancelling a stage closes its queue and the run continues without it.
+*/
+
+/* Task data of a stage worker */
+typedef struct {
+    EphemRun      *run;
+    gpointer       ctx;        /* CountrySelectionCtx or POISelectionCtx */
+    gchar          name[128];  /* selection when the run started */
+} StageData;
+
+/* Rows kept from one block, on their way to the main loop */
+typedef struct {
+    gpointer       ctx;
+    ResultRows    *res;
+    GCancellable  *cancel;     /* the stage's; a cancelled batch is dropped */
+    gboolean       last;       /* TRUE on the batch that ends the stage */
+} StageRows;
+
+static void
+stage_data_free(gpointer data)
+{
+    StageData *sd = data;
+    ephem_run_unref(sd->run);
+    g_free(sd);
+}
+
+static void
+stage_rows_free(gpointer data)
+{
+    StageRows *sr = data;
+    result_rows_free(sr->res);
+    g_object_unref(sr->cancel);
+    g_free(sr);
+}
+
+/*
+ * @brief Hands a batch of rows to the main loop.
+ * @function stage_post_rows
+ * @thread Worker thread. Batches are delivered in the order they are posted.
+ * @param ctx gpointer ctx
+ * @param res ResultRows *res  (ownership is transferred)
+ * @param cancel GCancellable *cancel
+ * @param last gboolean last
+ * @param func GSourceFunc func  idle handler receiving the StageRows
+ * @return (void)
+ */
+static void
+stage_post_rows(gpointer ctx, ResultRows *res, GCancellable *cancel,
+                gboolean last, GSourceFunc func)
+{
+    StageRows *sr = g_new0(StageRows, 1);
+    sr->ctx    = ctx;
+    sr->res    = res;
+    sr->cancel = g_object_ref(cancel);
+    sr->last   = last;
+    g_idle_add_full(G_PRIORITY_DEFAULT_IDLE, func, sr, stage_rows_free);
+}
+
+/*
+ * @brief Loads the records of a stage from the result cache.
+ * @function stage_cache_load
+ * @thread Worker thread.
+ * @param run const EphemRun *run
+ * @param stage guint stage
+ * @param elt guint elt  size of one record
+ * @return (GBytes *) NULL on a miss or when the stage is not cached
+ */
+static GBytes *
+stage_cache_load(const EphemRun *run, guint stage, guint elt)
+{
+    return run->key[stage] ? result_cache_load(run->key[stage], elt) : NULL;
+}
+
+/*
+ * @brief Hands cached rows to the main loop in batches of one block.
+ * @function stage_post_cached
+ * @thread Worker thread.
+ * @param ctx gpointer ctx
+ * @param rows GBytes *rows  ZoneRow or PoiRow records
+ * @param elt guint elt
+ * @param times const RowTimes *times
+ * @param cancel GCancellable *cancel
+ * @param func GSourceFunc func  idle handler receiving the StageRows
+ * @return (void)
+ */
+static void
+stage_post_cached(gpointer ctx, GBytes *rows, guint elt, const RowTimes *times,
+                  GCancellable *cancel, GSourceFunc func)
+{
+    gsize len = 0;
+    const guint8 *data = g_bytes_get_data(rows, &len);
+    guint n = (guint)(len / elt);
+
+    for (guint i = 0; i < n && !g_cancellable_is_cancelled(cancel); i += EPHEM_PIPE_BLOCK) {
+        ResultRows *res = result_rows_new(elt, times);
+        g_array_append_vals(res->rows, data + (gsize)i * elt, MIN(EPHEM_PIPE_BLOCK, n - i));
+        stage_post_rows(ctx, res, cancel, FALSE, func);
+    }
+}
+
+/*
+ * @brief Keeps records for the result cache, up to what it would store.
+ * @function stage_keep
+ * @param all GArray **all  set to NULL once the records are too many
+ * @param data gconstpointer data
+ * @param n guint n
+ * @param max guint64 max  result cache size [bytes]
+ * @return (void)
+ */
+static void
+stage_keep(GArray **all, gconstpointer data, guint n, guint64 max)
+{
+    if (!*all)
+        return;
+    if (((guint64)(*all)->len + n) * g_array_get_element_size(*all) > max / 4) {
+        g_array_free(*all, TRUE);
+        *all = NULL;
+        return;
+    }
+    g_array_append_vals(*all, data, n);
+}
+
+/*
+ * @brief Stores the records of a stage that consumed the whole run.
+ * @function stage_cache_store
+ * @thread Worker thread.
+ * @param run const EphemRun *run
+ * @param key const gchar *key  entry of the stage, or NULL
+ * @param seen guint64 seen  samples the stage consumed
+ * @param all GArray *all  records kept by stage_keep(), or NULL
+ * @param cancel GCancellable *cancel
+ * @return (void)
+ */
+static void
+stage_cache_store(const EphemRun *run, const gchar *key, guint64 seen,
+                  GArray *all, GCancellable *cancel)
+{
+    /* a cancelled run closes the queues early: never keep a partial result */
+    if (!key || !all || g_cancellable_is_cancelled(cancel) ||
+        seen != (guint64)run->n * run->nsats)
+        return;
+    result_cache_store(key, g_array_get_element_size(all), run->catnr, run->nsats,
+                       all->data, all->len, run->cache_max);
+}
+
+/*
+ * @brief Idle callback appending one batch of streamed Territory rows.
+ * @function zone_stage_rows_idle
+ * @thread Runs on the GTK main thread (GLib main loop).
+ * @param data gpointer data (StageRows *)
+ * @return (gboolean)
+ */
+static gboolean
+zone_stage_rows_idle(gpointer data)
+{
+    StageRows *sr = data;
+    CountrySelectionCtx *ctx = sr->ctx;
+    if (g_cancellable_is_cancelled(sr->cancel) || !GTK_IS_LIST_STORE(ctx->store))
+        return G_SOURCE_REMOVE;
+
+    for (guint i = 0; i < sr->res->rows->len; ++i)
+        zone_store_append(ctx, sr->res, i);
+    ctx->next_row += sr->res->rows->len;   /* rows appended so far */
+    if (GTK_IS_LABEL(ctx->count_label)) {
+        gchar *txt = g_strdup_printf("Total: %u", ctx->next_row);
+        gtk_label_set_text(ctx->count_label, txt);
+        g_free(txt);
+    }
+
+    if (sr->last) {
+        if (ctx->pulse_source_id) { g_source_remove(ctx->pulse_source_id); ctx->pulse_source_id = 0; }
+        if (ctx->timer_source_id) { g_source_remove(ctx->timer_source_id); ctx->timer_source_id = 0; }
+        if (GTK_IS_LABEL(ctx->time_label)) {
+            guint secs = (g_get_monotonic_time() - ctx->start_time) / G_USEC_PER_SEC;
+            gchar *txt = g_strdup_printf("%us", secs);
+            gtk_label_set_text(GTK_LABEL(ctx->time_label), txt);
+            g_free(txt);
+        }
+        if (GTK_IS_PROGRESS_BAR(ctx->progress_bar)) {
+            gtk_progress_bar_set_fraction(GTK_PROGRESS_BAR(ctx->progress_bar), 1.0);
+            gtk_progress_bar_set_text(GTK_PROGRESS_BAR(ctx->progress_bar), "100%");
+        }
+        safe_set_sensitive(GTK_WIDGET(ctx->entry), TRUE);
+        safe_set_sensitive(ctx->button, TRUE);
+    }
+    return G_SOURCE_REMOVE;
+}
+
+/*
+ * @brief Stage worker classifying streamed samples by territory.
+ * @function zone_stage_worker
+ * @thread Runs in a background GTask thread. Do NOT touch GTK here.
+ * @note Uses the tile grid lookup (tool_find_territory) instead of a scan over all polygons.
+ * @param task GTask *task
+ * @param source_object gpointer source_object
+ * @param task_data gpointer task_data (StageData *)
+ * @param cancellable GCancellable *cancellable
+ * @return (void)
+ */
+static void
+zone_stage_worker(GTask        *task,
+                  gpointer      source_object,
+                  gpointer      task_data,
+                  GCancellable *cancellable)
+{
+    (void)source_object;
+    StageData     *sd  = task_data;
+    ephem_queue_t *q   = sd->run->queue[STAGE_ZONE];
+    const gboolean all = g_strcmp0(sd->name, "Territory") == 0;
+    const RowTimes times = { sd->run->grid, NULL, sd->run->names };
+    GPtrArray     *countries = country_catalogue();
+    GBytes        *hit = stage_cache_load(sd->run, STAGE_ZONE, sizeof(ZoneRow));
+    ephem_block_t *blk;
+
+    if (hit) {
+        /* same run and selection as before; the producer skips a closed queue */
+        ephem_queue_close(q);
+        stage_post_cached(sd->ctx, hit, sizeof(ZoneRow), &times, cancellable,
+                          zone_stage_rows_idle);
+        g_bytes_unref(hit);
+    } else {
+        GArray *kept = sd->run->key[STAGE_ZONE] ?
+            g_array_new(FALSE, FALSE, sizeof(ZoneRow)) : NULL;
+        guint64 seen = 0;
+
+        while ((blk = ephem_queue_pop(q, cancellable)) != NULL) {
+            ResultRows *res = result_rows_new(sizeof(ZoneRow), &times);
+            for (guint k = 0; k < blk->n; ++k) {
+                const ephem_sample_t *sm = &blk->samples[k];
+                gint idx = tool_find_territory(sm->lat, sm->lon);
+                if (idx < 0 || (guint)idx >= countries->len)
+                    continue;
+                if (!all && g_strcmp0(g_ptr_array_index(countries, idx), sd->name) != 0)
+                    continue;
+                ZoneRow r;
+                memset(&r, 0, sizeof(r));   /* padding goes to the result cache */
+                r.lat = sm->lat; r.lon = sm->lon;
+                r.t = sm->t; r.country = idx; r.sat = sm->sat;
+                g_array_append_val(res->rows, r);
+            }
+            seen += blk->n;
+            ephem_block_unref(blk);
+            stage_keep(&kept, res->rows->data, res->rows->len, sd->run->cache_max);
+            if (res->rows->len)
+                stage_post_rows(sd->ctx, res, cancellable, FALSE, zone_stage_rows_idle);
+            else
+                result_rows_free(res);
+        }
+        /* leaving early must not stall the producer */
+        ephem_queue_close(q);
+        stage_cache_store(sd->run, sd->run->key[STAGE_ZONE], seen, kept, cancellable);
+        if (kept) g_array_free(kept, TRUE);
+    }
+
+    if (!g_cancellable_is_cancelled(cancellable))
+        stage_post_rows(sd->ctx, result_rows_new(sizeof(ZoneRow), &times),
+                        cancellable, TRUE, zone_stage_rows_idle);
+    g_task_return_boolean(task, TRUE);
+}
+
+/*
+ * @brief Idle callback appending one batch of streamed POI rows.
+ * @function poi_stage_rows_idle
+ * @thread Runs on the GTK main thread (GLib main loop).
+ * @param data gpointer data (StageRows *)
+ * @return (gboolean)
+ */
+static gboolean
+poi_stage_rows_idle(gpointer data)
+{
+    StageRows *sr = data;
+    POISelectionCtx *ctx = sr->ctx;
+    if (g_cancellable_is_cancelled(sr->cancel) || !GTK_IS_LIST_STORE(ctx->store))
+        return G_SOURCE_REMOVE;
+
+    for (guint i = 0; i < sr->res->rows->len; ++i)
+        poi_store_append(ctx, sr->res, i);
+
+    if (sr->last) {
+        if (ctx->pulse_source_id) { g_source_remove(ctx->pulse_source_id); ctx->pulse_source_id = 0; }
+        if (ctx->timer_source_id) { g_source_remove(ctx->timer_source_id); ctx->timer_source_id = 0; }
+        if (GTK_IS_LABEL(ctx->time_label)) {
+            guint secs = (g_get_monotonic_time() - ctx->start_time) / G_USEC_PER_SEC;
+            gchar *txt = g_strdup_printf("%us", secs);
+            gtk_label_set_text(GTK_LABEL(ctx->time_label), txt);
+            g_free(txt);
+        }
+        if (GTK_IS_PROGRESS_BAR(ctx->progress_bar)) {
+            gtk_progress_bar_set_fraction(GTK_PROGRESS_BAR(ctx->progress_bar), 1.0);
+            gtk_progress_bar_set_text(GTK_PROGRESS_BAR(ctx->progress_bar), "100%");
+        }
+        safe_set_sensitive(GTK_WIDGET(ctx->entry), TRUE);
+        safe_set_sensitive(ctx->button, TRUE);
+    }
+    return G_SOURCE_REMOVE;
+}
+
+/*
+ * @brief Stage worker matching streamed samples against the POI polygons.
+ * @function poi_stage_worker
+ * @thread Runs in a background GTask thread. Do NOT touch GTK here.
+ * @note An empty or unknown selection matches every POI.
+ * @param task GTask *task
+ * @param source_object gpointer source_object
+ * @param task_data gpointer task_data (StageData *)
+ * @param cancellable GCancellable *cancellable
+ * @return (void)
+ */
+static void
+poi_stage_worker(GTask        *task,
+                 gpointer      source_object,
+                 gpointer      task_data,
+                 GCancellable *cancellable)
+{
+    (void)source_object;
+    StageData     *sd = task_data;
+    ephem_queue_t *q  = sd->run->queue[STAGE_POI];
+    const RowTimes times = { sd->run->grid, NULL, sd->run->names };
+    GBytes        *hit = stage_cache_load(sd->run, STAGE_POI, sizeof(PoiRow));
+    ephem_block_t *blk;
+    POIMatch m;
+
+    if (hit) {
+        /* same run and selection as before; the producer skips a closed queue */
+        ephem_queue_close(q);
+        stage_post_cached(sd->ctx, hit, sizeof(PoiRow), &times, cancellable,
+                          poi_stage_rows_idle);
+        g_bytes_unref(hit);
+    } else {
+        GArray *kept = sd->run->key[STAGE_POI] ?
+            g_array_new(FALSE, FALSE, sizeof(PoiRow)) : NULL;
+        guint64 seen = 0;
+
+        poi_match_init(&m, sd->ctx, sd->name, cancellable);
+
+        while ((blk = ephem_queue_pop(q, cancellable)) != NULL) {
+            ResultRows *res = result_rows_new(sizeof(PoiRow), &times);
+            poi_match_points(&m, blk->samples, blk->n, res->rows);
+            seen += blk->n;
+            ephem_block_unref(blk);
+            stage_keep(&kept, res->rows->data, res->rows->len, sd->run->cache_max);
+            if (res->rows->len)
+                stage_post_rows(sd->ctx, res, cancellable, FALSE, poi_stage_rows_idle);
+            else
+                result_rows_free(res);
+        }
+        /* leaving early must not stall the producer */
+        ephem_queue_close(q);
+        g_ptr_array_free(m.bboxes, TRUE);
+        stage_cache_store(sd->run, sd->run->key[STAGE_POI], seen, kept, cancellable);
+        if (kept) g_array_free(kept, TRUE);
+    }
+
+    if (!g_cancellable_is_cancelled(cancellable))
+        stage_post_rows(sd->ctx, result_rows_new(sizeof(PoiRow), &times),
+                        cancellable, TRUE, poi_stage_rows_idle);
+    g_task_return_boolean(task, TRUE);
+}
+
+/*
+ * @brief Stage worker keeping the samples of a run for the result cache.
+ * @function cache_stage_worker
+ * @thread Runs in a background GTask thread. Do NOT touch GTK here.
+ * @param task GTask *task
+ * @param source_object gpointer source_object
+ * @param task_data gpointer task_data (StageData *)
+ * @param cancellable GCancellable *cancellable  the run's
+ * @return (void)
+ */
+static void
+cache_stage_worker(GTask        *task,
+                   gpointer      source_object,
+                   gpointer      task_data,
+                   GCancellable *cancellable)
+{
+    (void)source_object;
+    StageData     *sd   = task_data;
+    ephem_queue_t *q    = sd->run->queue[STAGE_CACHE];
+    GArray        *kept = g_array_new(FALSE, FALSE, sizeof(ephem_sample_t));
+    guint64        seen = 0;
+    ephem_block_t *blk;
+
+    while ((blk = ephem_queue_pop(q, cancellable)) != NULL) {
+        seen += blk->n;
+        stage_keep(&kept, blk->samples, blk->n, sd->run->cache_max);
+        ephem_block_unref(blk);
+    }
+    ephem_queue_close(q);
+    stage_cache_store(sd->run, sd->run->key[STAGE_EPHEM], seen, kept, cancellable);
+    if (kept) g_array_free(kept, TRUE);
+    g_task_return_boolean(task, TRUE);
 }
 
+/*
+ * @brief Starts a stage worker on a fresh queue of the run.
+ * @function stage_start
+ * @thread Main thread, before the producer is launched.
+ * @return (void)
+ */
+static void
+stage_start(EphemRun *run, guint stage, gpointer ctx, const gchar *name,
+            GCancellable *cancel, GTaskThreadFunc worker)
+{
+    StageData *sd = g_new0(StageData, 1);
+    sd->run = ephem_run_ref(run);
+    sd->ctx = ctx;
+    g_strlcpy(sd->name, name, sizeof(sd->name));
+    run->queue[stage] = ephem_queue_new(EPHEM_QUEUE_DEPTH);
+
+    GTask *task = g_task_new(NULL, cancel, NULL, NULL);
+    g_task_set_task_data(task, sd, stage_data_free);
+    g_task_run_in_thread(task, worker);
+    g_object_unref(task);
+}
+
+/*
+ * @brief Result cache key of the samples of a run.
+ * @function ephem_cache_key
+ * @note Covers all the samples depend on: the time grid and the elements
+ *       of each satellite, in run order.
+ * @param run const EphemRun *run
+ * @return (gchar *)
+ */
+static gchar *
+ephem_cache_key(const EphemRun *run)
+{
+    GChecksum *sum = g_checksum_new(G_CHECKSUM_SHA256);
+    const gint64 grid[] = { run->grid.sec, run->grid.ns, run->grid.step_ns,
+                            run->n, sizeof(ephem_sample_t) };
+
+    g_checksum_update(sum, (const guchar *)grid, sizeof(grid));
+    for (guint i = 0; i < run->nsats; ++i)
+        result_cache_add_tle(sum, &run->sats[i].tle);
+    gchar *key = result_cache_key("ephem", sum);
+    g_checksum_free(sum);
+    return key;
+}
+
+/*
+ * @brief Result cache key of a Territory or POI stage of a run.
+ * @function stage_cache_key
+ * @note The digest is the one taken when the data file was loaded, so the
+ *       key matches the tiles in memory. A changed file gives new keys; the
+ *       old entries were dropped when it was loaded, see
+ *       result_cache_set_input().
+ * @param run const EphemRun *run
+ * @param stage const gchar *stage  "zone" or "poi"
+ * @param name const gchar *name  selection of the stage
+ * @param digest const gchar *digest  SHA-256 of what was loaded for the stage
+ * @return (gchar *) NULL if the stage is not cached
+ */
+static gchar *
+stage_cache_key(const EphemRun *run, const gchar *stage, const gchar *name,
+                const gchar *digest)
+{
+    if (!run->key[STAGE_EPHEM] || !digest)
+        return NULL;
+
+    GChecksum *sum = g_checksum_new(G_CHECKSUM_SHA256);
+    g_checksum_update(sum, (const guchar *)run->key[STAGE_EPHEM], -1);
+    g_checksum_update(sum, (const guchar *)digest, -1);
+    g_checksum_update(sum, (const guchar *)name, -1);
+    gchar *key = result_cache_key(stage, sum);
+    g_checksum_free(sum);
+    return key;
+}
+
+/*
+ * @brief Attaches the Territory and POI stages that have a selection to a new run.
+ * @function ephem_start_stages
+ * @thread Runs on the GTK main thread (GLib main loop).
+ * @param ectx EphemUpdateCtx *ectx
+ * @param run EphemRun *run
+ * @return (void)
+ */
+static void
+ephem_start_stages(EphemUpdateCtx *ectx, EphemRun *run)
+{
+    CountrySelectionCtx *c = ectx->country_ctx;
+    if (c && c->name[0] != '\0' && GTK_IS_TREE_VIEW(c->treeview)) {
+        /* supersede any manual filter still in flight */
+        if (c->cancel)          { g_cancellable_cancel(c->cancel); g_clear_object(&c->cancel); }
+        if (c->idle_id)         { g_source_remove(c->idle_id);         c->idle_id = 0; }
+        if (c->pulse_source_id) { g_source_remove(c->pulse_source_id); c->pulse_source_id = 0; }
+        if (c->timer_source_id) { g_source_remove(c->timer_source_id); c->timer_source_id = 0; }
+        if (c->pending_rows)    { result_rows_free(c->pending_rows); c->pending_rows = NULL; }
+
+        /* the view stays attached: rows show up as blocks are classified */
+        c->store = gtk_list_store_new(
+            ZONE_N_COLS, G_TYPE_STRING, G_TYPE_DOUBLE, G_TYPE_DOUBLE, G_TYPE_STRING,
+            G_TYPE_STRING);
+        gtk_tree_view_set_model(GTK_TREE_VIEW(c->treeview), GTK_TREE_MODEL(c->store));
+        c->model_detached = FALSE;
+        table_index_reset(&c->index, RESULT_SEG_PASS, 1.5e-9 * run->grid.step_ns / 86400.0);
+        c->next_row = 0;
+        if (GTK_IS_LABEL(c->count_label))
+            gtk_label_set_text(c->count_label, "Total: 0");
+
+        safe_set_sensitive(c->button, FALSE);
+        safe_set_sensitive(GTK_WIDGET(c->entry), FALSE);
+        if (GTK_IS_PROGRESS_BAR(c->progress_bar))
+            gtk_progress_bar_set_fraction(GTK_PROGRESS_BAR(c->progress_bar), 0.0);
+        c->start_time = g_get_monotonic_time();
+        if (GTK_IS_LABEL(c->time_label)) gtk_label_set_text(c->time_label, "0s");
+        c->timer_source_id = g_timeout_add_seconds(1, update_country_timer, c);
+        c->pulse_source_id = g_timeout_add(100, country_pulse_timeout, c);
+
+        c->cancel = g_cancellable_new();
+        run->key[STAGE_ZONE] = stage_cache_key(run, "zone", c->name, tool_get_digest());
+        stage_start(run, STAGE_ZONE, c, c->name, c->cancel, zone_stage_worker);
+    }
+
+    POISelectionCtx *p = ectx->poi_ctx;
+    if (p && p->active && GTK_IS_TREE_VIEW(p->treeview)) {
+        if (p->cancel)          { g_cancellable_cancel(p->cancel); g_clear_object(&p->cancel); }
+        if (p->pulse_source_id) { g_source_remove(p->pulse_source_id); p->pulse_source_id = 0; }
+        if (p->timer_source_id) { g_source_remove(p->timer_source_id); p->timer_source_id = 0; }
+
+        p->store = gtk_list_store_new(
+            POI_N_COLS, G_TYPE_STRING, G_TYPE_DOUBLE, G_TYPE_DOUBLE,
+            G_TYPE_DOUBLE, G_TYPE_DOUBLE, G_TYPE_STRING, G_TYPE_STRING, G_TYPE_STRING);
+        gtk_tree_view_set_model(p->treeview, GTK_TREE_MODEL(p->store));
+        table_index_reset(&p->index, RESULT_SEG_PASS, 1.5e-9 * run->grid.step_ns / 86400.0);
+
+        safe_set_sensitive(GTK_WIDGET(p->entry), FALSE);
+        safe_set_sensitive(p->button, FALSE);
+        if (GTK_IS_PROGRESS_BAR(p->progress_bar))
+            gtk_progress_bar_set_fraction(GTK_PROGRESS_BAR(p->progress_bar), 0.0);
+        p->start_time = g_get_monotonic_time();
+        if (GTK_IS_LABEL(p->time_label)) gtk_label_set_text(p->time_label, "0s");
+        p->timer_source_id = g_timeout_add_seconds(1, update_poi_timer, p);
+        p->pulse_source_id = g_timeout_add(100, poi_pulse_timeout, p);
+
+        p->cancel = g_cancellable_new();
+        /* the tiles and the names must have been read from the same file */
+        const gchar *digest = lp_get_digest();
+        if (g_strcmp0(digest, points_interest_get_digest()) != 0)
+            digest = NULL;
+        run->key[STAGE_POI] = stage_cache_key(run, "poi", p->name, digest);
+        stage_start(run, STAGE_POI, p, p->name, p->cancel, poi_stage_worker);
+    }
+}
 
 
 /* ========================================================================== /
@@ -1456,17 +2217,14 @@ on_poi_entry_activate(GtkEntry *entry, gpointer user_data){
 / ========================================================================== /
 
 Collect the ground track.
-Moves the freshly computed ephemeris buffer from the worker into the
-GtkListStore using a low-priority idle handler (chunked insert to keep the UI
-responsive). Updates the “Total” label, resets the progress bar, re-enables
-user controls, and stops the pulse and seconds timer. If a POI is currently
-selected, it re-issues the same POI query so Tab 3 reflects the new data.
-
-Samples the orbit at fixed “step” seconds over a “duration”, using a private
-copy of the satellite state to call Predict. For each sample, creates an
-EphemPoint (JD, formatted timestamp, sub-satellite lat/lon) and appends it to
-the thread-local buffer. Honors GCancellable, frees the previous run’s buffer,
-and returns TRUE/FALSE via g_task_return_boolean().
+A run samples the orbit at fixed “step” seconds over a “duration”, using a
+copy of the satellite state taken on the main thread. ephem_pipe_run()
+hands the samples over in blocks: Tab 1 appends them from a low-priority
+timeout while the propagation is still going (the bar shows the fraction of
+the known total), and the Territory / POI stages filter the same blocks in
+their own threads when a selection is active. When the Tab 1 queue is
+drained the timer is stopped, the model reattached and the controls
+re-enabled.
 
 
 now takes an extra step‐size argument */
@@ -1489,29 +2247,37 @@ on_ephem_done(GObject      *source,
               gpointer    user_data){
 
     (void)source;
-    EphemUpdateCtx *ctx = user_data;
-    gboolean ok = g_task_propagate_boolean(G_TASK(res), NULL);
-    if (ok) {
-        /* clear old rows; detach view for fast bulk insert; init counters */
-        gtk_list_store_clear(ctx->store);
-        if (GTK_IS_TREE_VIEW(ctx->treeview)) {
-            gtk_tree_view_set_model(ctx->treeview, NULL);   /* BIG speedup */
-            ctx->model_detached = TRUE;
-        }
-        ctx->inserted_count = 0;
-        ctx->append_ptr = ctx->buffer;
-        if (ctx->idle_id) g_source_remove(ctx->idle_id);
-        ctx->idle_id = g_idle_add_full(G_PRIORITY_LOW, ephem_append_chunk_idle, ctx, NULL);
-
-        /* +++ UPDATE the total‐points label +++ */
-        {
-            gchar *txt = g_strdup_printf("Total: %u", ctx->buffer_count);
-            gtk_label_set_text(ctx->count_label, txt);
-            g_free(txt);
-        }
+    (void)user_data;
+    /* rows are streamed by the consumers; the producer closed every queue */
+    g_task_propagate_boolean(G_TASK(res), NULL);
+}
 
-    }
+/* A contiguous slice of the satellites of a multi-satellite run */
+typedef struct {
+    EphemRun *run;
+    guint     first;
+    guint     count;
+} EphemSatSlice;
 
+/*
+ * @brief Propagates a slice of the satellites of a run into their streams.
+ * @function ephem_slice_worker
+ * @thread Runs in the run's own GThreadPool. Do NOT touch GTK here.
+ * @param data gpointer data (EphemSatSlice *, freed here)
+ * @param user_data gpointer user_data (GCancellable *)
+ * @return (void)
+ */
+static void
+ephem_slice_worker(gpointer data, gpointer user_data)
+{
+    EphemSatSlice *slice = data;
+    EphemRun      *run   = slice->run;
+
+    ephem_pipe_run_n(&run->sats[slice->first], slice->count, run->qth,
+                     &run->grid, run->n, &run->src[slice->first],
+                     G_CANCELLABLE(user_data));
+    ephem_run_unref(run);
+    g_free(slice);
 }
 
 /*
@@ -1533,183 +2299,48 @@ ephem_worker(GTask      *task,
              GCancellable *cancellable){
 
     (void)source_object;
-    (void)cancellable;
-    EphemUpdateCtx *ctx = task_data;
-    /* 1) Snapshot the spin-values on the main thread into locals */
-    const int duration = MAX (1, ctx->duration_s);
-    const int step     = MAX (1, ctx->step_sec);
-
-    /* 2) Copy the satellite struct for thread-safe Predict calls */
-    sat_t sat_copy = *ctx->sat;
-    qth_t *qth     = ctx->qth;
-    double jul0    = sat_copy.jul_utc;     /* <-- define before using it */
-
-    const double end_jd  = jul0 + ((double)duration) / 86400.0;
-    const double step_jd = ((double)step)     / 86400.0;
-
-    /* clear *our* previous run’s buffer (never touch the global!) */
-    if (ctx->buffer) {
-        g_slist_free_full(ctx->buffer, (GDestroyNotify)free_ephem_point);
-    }
-    ctx->buffer        = NULL;
-    ctx->buffer_count  = 0;
-
-
-    /* drive by time, not loop count → always stops at end_jd */
-    for (double t = jul0; t <= end_jd + 1e-9; t += step_jd) {
-        if (g_cancellable_is_cancelled(cancellable)) {
-            g_task_return_boolean(task, FALSE);
-            return;
-        }
-        /* advance in our private copy */
-        const double jul_pt = t;
-        predict_calc(&sat_copy, qth, jul_pt);
-
-        EphemPoint *p = g_new0(EphemPoint,1);
-        p->epoch_jd = jul_pt;
-        /* format Timestamp = “YYYY/MM/DD HH:MM:SS” */
-        {
-            int Y,Mo,D,h,m,s;
-            jd_to_gregorian(jul_pt, &Y,&Mo,&D,&h,&m,&s);
-            p->time_str = g_strdup_printf(
-                "%04d/%02d/%02d %02d:%02d:%02d",
-                Y,Mo,D,h,m,s
-            );
+    EphemRun *run = task_data;
+    GBytes   *hit = run->cached ?
+        result_cache_load(run->key[STAGE_EPHEM], sizeof(ephem_sample_t)) : NULL;
+    gsize     len = 0;
+    const ephem_sample_t *rec = hit ? g_bytes_get_data(hit, &len) : NULL;
+    guint n;
+
+    if (rec && len / sizeof(ephem_sample_t) == (gsize)run->n * run->nsats) {
+        /* same inputs as a stored run: nothing to propagate */
+        n = ephem_pipe_replay(rec, run->n * run->nsats, run->queue, N_STAGES,
+                              cancellable);
+    } else if (run->nsats == 1) {
+        n = ephem_pipe_run(&run->sats[0], run->qth, &run->grid, run->n,
+                           run->queue, N_STAGES, cancellable);
+    } else {
+        /* the producers get their own pool, one thread per CPU, each
+           taking a slice of the satellites in turns; they never wait for
+           a thread of the shared GTask pool, which this one blocks while
+           it interleaves their streams by time for the stages */
+        const guint nthreads = MIN(run->nsats, MAX((guint)g_get_num_processors(), 1));
+        GThreadPool *pool = g_thread_pool_new(ephem_slice_worker, cancellable,
+                                              nthreads, TRUE, NULL);
+        for (guint j = 0, first = 0; j < nthreads; ++j) {
+            EphemSatSlice *slice = g_new(EphemSatSlice, 1);
+            slice->run   = ephem_run_ref(run);
+            slice->first = first;
+            slice->count = run->nsats / nthreads + (j < run->nsats % nthreads);
+            first += slice->count;
+            g_thread_pool_push(pool, slice, NULL);
         }
-       /* extract subsatellite coords from our private copy */
-        predict_get_subsatellite_coords(&sat_copy,
-                                       &p->lat_deg,
-                                       &p->lon_deg);
-
-        /* use prepend to avoid O(n^2) on Windows builds, reverse later */
-        ctx->buffer = g_slist_prepend(ctx->buffer, p);
-        ctx->buffer_count++;
-
-
+        n = ephem_pipe_merge(run->src, run->nsats, run->queue, N_STAGES,
+                             cancellable);
+        g_thread_pool_free(pool, FALSE, TRUE);   /* wait for the producers */
     }
+    if (hit) g_bytes_unref(hit);
 
-    /* reverse once so buffer is in chronological order */
-    ctx->buffer = g_slist_reverse(ctx->buffer);
-    
     // signal completion
-    g_task_return_boolean(task, TRUE);
+    g_task_return_boolean(task, n > 0);
 }
 
 
 
-/* Helper: load polygons, filter by ctx->name, and rebuild Tab 2’s treeview */
-
-/* this old, synchronous filter is now superseded—mark it unused */
-/*
- * @brief Callback / helper function.
- * @function __attribute__
- * @param ctx (unused))
-ephem_update_with_country(CountrySelectionCtx *ctx
- * @return (void)
- */
-static void __attribute__((unused))
-ephem_update_with_country(CountrySelectionCtx *ctx){
-
-
-    /* a) Load the master lists (do NOT free these) */
-    GList *all_polys     = tool_get_all_polygons();
-    GList *all_countries = tool_get_all_countries();
-
-    /* b) Grab raw ephemeris from Tab 1 */
-    GtkTreeModel *src = gtk_tree_view_get_model(ctx->tv_tab1);
-    GList        *pass = tool_list_from_model(src);
-
-    /* c) Territory = special “all lands” case */
-    if (g_strcmp0(ctx->name, "Territory") == 0) {
-        GtkListStore *store = gtk_list_store_new(
-            ZONE_N_COLS,
-            G_TYPE_STRING, G_TYPE_DOUBLE,
-            G_TYPE_DOUBLE, G_TYPE_STRING
-        );
-        GtkTreeIter  tree_iter;
-        for (GList *l = pass; l; l = l->next) {
-            ToolEphemPoint *pt = l->data;
-            for (GList *pp = all_polys, *cc = all_countries;
-                 pp && cc;
-                 pp = pp->next, cc = cc->next)
-            {
-                GArray   *poly = pp->data;
-                GeoPoint *pts  = (GeoPoint*)poly->data;
-                guint     n    = poly->len;
-                if (_point_in_poly(pts, n, pt->lat, pt->lon)) {
-                    gtk_list_store_append(store, &tree_iter);
-                    gtk_list_store_set(store, &tree_iter,
-                        ZONE_COL_TIME,    pt->time_str,
-                        ZONE_COL_LAT,     pt->lat,
-                        ZONE_COL_LON,     pt->lon,
-                        ZONE_COL_COUNTRY, (gchar*)cc->data,
-                        -1);
-                    break;
-                }
-            }
-        }
-        gtk_tree_view_set_model(GTK_TREE_VIEW(ctx->treeview),
-                                GTK_TREE_MODEL(store));
-        g_object_unref(store);
-
-        /* cleanup */
-        for (GList *l = pass; l; l = l->next) {
-            ToolEphemPoint *pt = l->data;
-            g_free(pt->time_str);
-            g_free(pt);
-        }
-        g_list_free(pass);
-        return;
-    }
-
-    /* d) Country = filter just that country’s polys */
-    GList *my_polys = NULL;
-    for (GList *pp = all_polys, *cc = all_countries;
-         pp && cc;
-         pp = pp->next, cc = cc->next)
-    {
-        if (g_strcmp0((gchar*)cc->data, ctx->name) == 0)
-            my_polys = g_list_append(my_polys, pp->data);
-    }
-
-    GtkListStore *store = gtk_list_store_new(
-        ZONE_N_COLS,
-        G_TYPE_STRING, G_TYPE_DOUBLE,
-        G_TYPE_DOUBLE, G_TYPE_STRING
-    );
-    GtkTreeIter  tree_iter;
-    for (GList *l = pass; l; l = l->next) {
-        ToolEphemPoint *pt = l->data;
-        for (GList *pp = my_polys; pp; pp = pp->next) {
-            GArray   *poly = pp->data;
-            GeoPoint *pts  = (GeoPoint*)poly->data;
-            guint     n    = poly->len;
-            if (_point_in_poly(pts, n, pt->lat, pt->lon)) {
-                gtk_list_store_append(store, &tree_iter);
-                gtk_list_store_set(store, &tree_iter,
-                    ZONE_COL_TIME,    pt->time_str,
-                    ZONE_COL_LAT,     pt->lat,
-                    ZONE_COL_LON,     pt->lon,
-                    ZONE_COL_COUNTRY, ctx->name,
-                    -1);
-                break;
-            }
-        }
-    }
-    gtk_tree_view_set_model(GTK_TREE_VIEW(ctx->treeview),
-                            GTK_TREE_MODEL(store));
-    g_object_unref(store);
-
-    /* cleanup */
-    for (GList *l = pass; l; l = l->next) {
-        ToolEphemPoint *pt = l->data;
-        g_free(pt->time_str);
-        g_free(pt);
-    }
-    g_list_free(pass);
-    g_list_free(my_polys);
-}
-
 /* ========================================================================== /
 / TAB 2 — Territory / Countries  /
 / ========================================================================== /
@@ -1944,6 +2575,9 @@ static void on_dialog_destroy_cleanup(GtkWidget *dialog, gpointer user_data) {
         if (e->idle_id)         { g_source_remove(e->idle_id);         e->idle_id = 0; }
         if (e->pulse_source_id) { g_source_remove(e->pulse_source_id); e->pulse_source_id = 0; }
         if (e->timer_source_id) { g_source_remove(e->timer_source_id); e->timer_source_id = 0; }
+        if (e->cancel)          { g_cancellable_cancel(e->cancel); g_clear_object(&e->cancel); }
+        if (e->run)             { ephem_run_unref(e->run); e->run = NULL; }
+        g_clear_pointer(&e->index, result_index_free);
         /* Make late callbacks harmless by invalidating widget pointers */
         e->hours_spin   = NULL;
         e->step_spin    = NULL;
@@ -1951,6 +2585,7 @@ static void on_dialog_destroy_cleanup(GtkWidget *dialog, gpointer user_data) {
         e->treeview     = NULL;
         e->time_label   = NULL;
         e->count_label  = NULL;
+        e->sats_button  = NULL;
     }
 
     /* --- Tab 2: Countries --- */
@@ -1960,6 +2595,7 @@ static void on_dialog_destroy_cleanup(GtkWidget *dialog, gpointer user_data) {
         if (c->pulse_source_id) { g_source_remove(c->pulse_source_id); c->pulse_source_id = 0; }
         if (c->timer_source_id) { g_source_remove(c->timer_source_id); c->timer_source_id = 0; }
         if (c->cancel)          { g_cancellable_cancel(c->cancel); g_clear_object(&c->cancel); }
+        g_clear_pointer(&c->index, result_index_free);
         c->entry = NULL; c->button = NULL; c->treeview = NULL;
         c->progress_bar = NULL; c->count_label = NULL; c->time_label = NULL;
     }
@@ -1967,76 +2603,243 @@ static void on_dialog_destroy_cleanup(GtkWidget *dialog, gpointer user_data) {
     /* --- Tab 3: POIs --- */
     POISelectionCtx *p = g_object_get_data(G_OBJECT(dialog), "poi_ctx");
     if (p) {
-        if (p->idle_id)         { g_source_remove(p->idle_id);         p->idle_id = 0; }
         if (p->pulse_source_id) { g_source_remove(p->pulse_source_id); p->pulse_source_id = 0; }
         if (p->timer_source_id) { g_source_remove(p->timer_source_id); p->timer_source_id = 0; }
         if (p->cancel)          { g_cancellable_cancel(p->cancel); g_clear_object(&p->cancel); }
+        g_clear_pointer(&p->index, result_index_free);
         p->entry = NULL; p->treeview = NULL; p->progress_bar = NULL;
         p->time_label = NULL; /* POISelectionCtx has no count_label */
     }
 }
 
-
-// SIGNAL HANDLER MUST TAKE TWO PARAMS: the spin widget + user_data
+
+// SIGNAL HANDLER MUST TAKE TWO PARAMS: the spin widget + user_data
+/*
+ * @brief Callback / helper function.
+ * @function on_orbits_value_changed
+ * @param spin GtkSpinButton *spin
+ * @param user_data gpointer user_data
+ * @return (void)
+ */
+
+static void
+on_orbits_value_changed(GtkSpinButton *spin, gpointer user_data){
+
+    EphemUpdateCtx *ctx = (EphemUpdateCtx*) user_data;
+    (void)spin;  /* we ignore which spin triggered it */
+    if (ctx->running) return;            /* ignore while one job is running */
+    ctx->running = TRUE;
+
+    /* ensure no stale sources are running */
+    if (ctx->timer_source_id) { g_source_remove(ctx->timer_source_id); ctx->timer_source_id = 0; }
+    if (ctx->pulse_source_id) { g_source_remove(ctx->pulse_source_id); ctx->pulse_source_id = 0; }
+
+    // Reset progress bar + label
+    if (GTK_IS_PROGRESS_BAR(ctx->progress_bar)) {
+        gtk_progress_bar_set_fraction(ctx->progress_bar, 0.0);
+
+    }
+
+    // Start elapsed-seconds timer (1 Hz)
+    ctx->start_time = g_get_monotonic_time();
+    if (GTK_IS_LABEL(ctx->time_label)) gtk_label_set_text(ctx->time_label, "0s");
+    ctx->timer_source_id = g_timeout_add_seconds(1, update_ephem_timer, ctx);  // uses your Tab1 helper
+
+    /* disable controls while computing */
+    safe_set_sensitive(GTK_WIDGET(ctx->hours_spin), FALSE);
+    safe_set_sensitive(GTK_WIDGET(ctx->step_spin),  FALSE);
+    safe_set_sensitive(ctx->sats_button, FALSE);
+
+    /* cancel previous run if any */
+    if (ctx->cancel) { g_cancellable_cancel(ctx->cancel); g_clear_object(&ctx->cancel); }
+
+    /* ── Snapshot the spin-buttons and the satellite *right here* on the main thread ── */
+    EphemRun *run = g_new0(EphemRun, 1);
+    run->ref        = 1;
+    run->nsats      = ctx->sats->len;
+    run->sats       = g_new(sat_t, run->nsats);
+    run->names      = g_ptr_array_new_with_free_func(g_free);
+    run->catnr      = g_new(guint32, run->nsats);
+    for (guint i = 0; i < run->nsats; ++i) {
+        sat_t *s = g_ptr_array_index(ctx->sats, i);
+        run->sats[i] = *s;
+        run->catnr[i] = (guint32)s->tle.catnr;
+        g_ptr_array_add(run->names, g_strdup(s->nickname ? s->nickname : s->name));
+    }
+    run->qth        = ctx->qth;
+    /* one time grid for all satellites; the step is taken to the ms */
+    ephem_grid_init(&run->grid, ctx->sat->jul_utc,
+                    MAX(1, llround(gtk_spin_button_get_value(ctx->step_spin) * 1000.0)) * 1000000);
+    run->n          = ephem_grid_count(&run->grid,
+                          MAX(1, gtk_spin_button_get_value_as_int(ctx->hours_spin) * 3600));
+    ctx->buffer_count = run->n * run->nsats;
+
+    /* a run with the same inputs as a stored one is loaded, not computed */
+    run->cache_max  = (guint64)MAX(sat_cfg_get_int(SAT_CFG_INT_EPHEM_CACHE_SIZE), 0) << 20;
+    if (run->cache_max) {
+        run->key[STAGE_EPHEM] = ephem_cache_key(run);
+        run->cached = result_cache_has(run->key[STAGE_EPHEM]);
+    }
+
+    /* clear old rows; detach view for fast bulk insert; init counters */
+    gtk_list_store_clear(ctx->store);
+    tab1_set_sat_names(ctx->store, run->names);
+    table_index_reset(&ctx->index, RESULT_SEG_ORBIT, 0.0);
+    ctx->index->stride = run->nsats;   /* orbits of the popup's satellite */
+    if (GTK_IS_TREE_VIEW(ctx->treeview)) {
+        gtk_tree_view_set_model(ctx->treeview, NULL);   /* BIG speedup */
+        ctx->model_detached = TRUE;
+    }
+    ctx->inserted_count = 0;
+    if (GTK_IS_LABEL(ctx->count_label)) {
+        gchar *txt = g_strdup_printf("Total: %u", ctx->buffer_count);
+        gtk_label_set_text(ctx->count_label, txt);
+        g_free(txt);
+    }
+
+    /* every consumer gets its queue before the producer starts */
+    run->queue[STAGE_EPHEM] = ephem_queue_new(EPHEM_QUEUE_DEPTH);
+    if (run->nsats > 1) {
+        run->src = g_new(ephem_queue_t *, run->nsats);
+        for (guint i = 0; i < run->nsats; ++i)
+            run->src[i] = ephem_queue_new(EPHEM_QUEUE_DEPTH);
+    }
+    ephem_start_stages(ctx, run);
+    ctx->run = run;
+
+    ctx->cancel = g_cancellable_new();
+    if (run->key[STAGE_EPHEM] && !run->cached)
+        stage_start(run, STAGE_CACHE, NULL, "", ctx->cancel, cache_stage_worker);
+    GTask *task = g_task_new(NULL, ctx->cancel, on_ephem_done, ctx);
+    g_task_set_task_data(task, ephem_run_ref(run), ephem_run_unref);
+    g_task_run_in_thread(task, ephem_worker);
+    g_object_unref(task);
+
+    if (ctx->idle_id) g_source_remove(ctx->idle_id);
+    ctx->idle_id = g_timeout_add_full(G_PRIORITY_LOW, 20, ephem_append_chunk_idle, ctx, NULL);
+}
+
+/*
+ * @brief Shows the number of satellites of the run on the chooser button.
+ * @function update_sats_button
+ * @param ctx EphemUpdateCtx *ctx
+ * @return (void)
+ */
+static void
+update_sats_button(EphemUpdateCtx *ctx)
+{
+    if (!GTK_IS_BUTTON(ctx->sats_button)) return;
+    gchar *txt = g_strdup_printf("Satellites (%u)", ctx->sats->len);
+    gtk_button_set_label(GTK_BUTTON(ctx->sats_button), txt);
+    g_free(txt);
+}
+
+static gboolean
+sat_in_run(const EphemUpdateCtx *ctx, const sat_t *sat)
+{
+    for (guint i = 0; i < ctx->sats->len; ++i)
+        if (g_ptr_array_index(ctx->sats, i) == sat) return TRUE;
+    return FALSE;
+}
+
 /*
- * @brief Callback / helper function.
- * @function on_orbits_value_changed
- * @param spin GtkSpinButton *spin
- * @param user_data gpointer user_data
+ * @brief Adds or removes a satellite from the set used by the next run.
+ * @function on_sat_toggled
+ * @thread Runs on the GTK main thread (GLib main loop).
+ * @param check GtkToggleButton *check  carries its sat_t * as "sat"
+ * @param user_data gpointer user_data (EphemUpdateCtx *)
  * @return (void)
  */
-
 static void
-on_orbits_value_changed(GtkSpinButton *spin, gpointer user_data){
-
-    EphemUpdateCtx *ctx = (EphemUpdateCtx*) user_data;
-    (void)spin;  /* we ignore which spin triggered it */
-    if (ctx->running) return;            /* ignore while one job is running */
-    ctx->running = TRUE;
-
-    /* ensure no stale sources are running */
-    if (ctx->timer_source_id) { g_source_remove(ctx->timer_source_id); ctx->timer_source_id = 0; }
-    if (ctx->pulse_source_id) { g_source_remove(ctx->pulse_source_id); ctx->pulse_source_id = 0; }
-
-    // Reset progress bar + label
-    if (GTK_IS_PROGRESS_BAR(ctx->progress_bar)) {
-        gtk_progress_bar_set_fraction(ctx->progress_bar, 0.0);
+on_sat_toggled(GtkToggleButton *check, gpointer user_data)
+{
+    EphemUpdateCtx *ctx = user_data;
+    sat_t *sat = g_object_get_data(G_OBJECT(check), "sat");
 
+    if (gtk_toggle_button_get_active(check)) {
+        if (!sat_in_run(ctx, sat))
+            g_ptr_array_add(ctx->sats, sat);
+    } else {
+        g_ptr_array_remove(ctx->sats, sat);
     }
+    update_sats_button(ctx);
+    ctx->sats_changed = TRUE;
+}
 
-    // Start elapsed-seconds timer (1 Hz)
-    ctx->start_time = g_get_monotonic_time();
-    if (GTK_IS_LABEL(ctx->time_label)) gtk_label_set_text(ctx->time_label, "0s");
-    ctx->timer_source_id = g_timeout_add_seconds(1, update_ephem_timer, ctx);  // uses your Tab1 helper
-
-    // Start pulsing animation (~10 Hz)
-    ctx->pulse_source_id = g_timeout_add(100, ephem_pulse_timeout, ctx);
-    /* disable controls while computing */
-    safe_set_sensitive(GTK_WIDGET(ctx->hours_spin), FALSE);
-    safe_set_sensitive(GTK_WIDGET(ctx->step_spin),  FALSE);
+/*
+ * @brief Starts one run for all the changes made in the chooser.
+ * @function on_sats_popover_closed
+ * @thread Runs on the GTK main thread (GLib main loop).
+ * @param popover GtkPopover *popover
+ * @param user_data gpointer user_data (EphemUpdateCtx *)
+ * @return (void)
+ */
+static void
+on_sats_popover_closed(GtkPopover *popover, gpointer user_data)
+{
+    EphemUpdateCtx *ctx = user_data;
+    if (ctx->sats_changed && GTK_IS_SPIN_BUTTON(ctx->hours_spin)) {
+        ctx->sats_changed = FALSE;
+        on_orbits_value_changed(NULL, ctx);
+    }
+    gtk_widget_destroy(GTK_WIDGET(popover));
+}
 
-    /* cancel previous run if any */
-    static GCancellable *ephem_cancel = NULL;
-    if (ephem_cancel) { g_cancellable_cancel(ephem_cancel); g_clear_object(&ephem_cancel); }
-    /* regenerate ephemeris buffer in a background task */
+static gint
+compare_sat_names(gconstpointer a, gconstpointer b)
+{
+    const sat_t *sa = *(sat_t * const *)a;
+    const sat_t *sb = *(sat_t * const *)b;
+    return g_strcmp0(sa->nickname, sb->nickname);
+}
 
-    /* ── Read the two spin-buttons *right here* on the main thread ── */
-    {
-      int hours = gtk_spin_button_get_value_as_int(ctx->hours_spin);
-      ctx->duration_s = hours * 3600;
-      ctx->step_sec   = gtk_spin_button_get_value_as_int(ctx->step_spin);
-    }
+/*
+ * @brief Opens the list of the module's satellites to pick the run's set.
+ * @function on_sats_clicked
+ * @thread Runs on the GTK main thread (GLib main loop).
+ * @note The popup's own satellite is always part of the run; it sets the time grid.
+ * @param button GtkButton *button
+ * @param user_data gpointer user_data (EphemUpdateCtx *)
+ * @return (void)
+ */
+static void
+on_sats_clicked(GtkButton *button, gpointer user_data)
+{
+    EphemUpdateCtx *ctx = user_data;
+    GHashTable *all = ctx->satmap ? ctx->satmap->sats : NULL;
+    if (!all) return;
 
-    /* now spawn the background job using those stored ints */
+    GPtrArray *list = g_ptr_array_new();
+    GHashTableIter hi;
+    gpointer key, value;
+    g_hash_table_iter_init(&hi, all);
+    while (g_hash_table_iter_next(&hi, &key, &value))
+        g_ptr_array_add(list, value);
+    g_ptr_array_sort(list, compare_sat_names);
 
-    ephem_cancel = g_cancellable_new();
-    GTask *task = g_task_new(NULL, ephem_cancel, on_ephem_done, ctx);
-    g_task_set_check_cancellable(task, TRUE);
-    g_task_set_task_data(task, ctx, NULL);
+    GtkWidget *popover = gtk_popover_new(GTK_WIDGET(button));
+    gtk_popover_set_position(GTK_POPOVER(popover), GTK_POS_BOTTOM);
+    GtkWidget *sw = gtk_scrolled_window_new(NULL, NULL);
+    gtk_widget_set_size_request(sw, 200, 240);
+    GtkWidget *vbox = gtk_box_new(GTK_ORIENTATION_VERTICAL, 2);
+    gtk_container_add(GTK_CONTAINER(sw), vbox);
+    gtk_container_add(GTK_CONTAINER(popover), sw);
 
-    g_task_run_in_thread(task, ephem_worker);
-    g_object_unref(task);
+    for (guint i = 0; i < list->len; ++i) {
+        sat_t *sat = g_ptr_array_index(list, i);
+        GtkWidget *check = gtk_check_button_new_with_label(sat->nickname);
+        gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(check),
+                                     sat_in_run(ctx, sat));
+        gtk_widget_set_sensitive(check, sat != ctx->sat);
+        g_object_set_data(G_OBJECT(check), "sat", sat);
+        g_signal_connect(check, "toggled", G_CALLBACK(on_sat_toggled), ctx);
+        gtk_box_pack_start(GTK_BOX(vbox), check, FALSE, FALSE, 0);
+    }
+    g_ptr_array_free(list, TRUE);
 
+    g_signal_connect(popover, "closed", G_CALLBACK(on_sats_popover_closed), ctx);
+    gtk_widget_show_all(popover);
+    gtk_popover_popup(GTK_POPOVER(popover));
 }
 
 
@@ -2128,6 +2931,298 @@ void on_select_clicked(GtkButton *button, gpointer user_data) {
 }
 
 
+// ──────────────────────────────────────────────────────────────
+// COMMON — Table query bar (jump to time, orbit/pass and box filters)
+// ──────────────────────────────────────────────────────────────
+/*
+ Each result table gets a small bar under it. Lookups go through the
+ table's result_index_t, so they cost a binary search or a walk over a
+ few grid cells however many rows the table holds; GtkTreeView's own
+ search compares the text of every row.
+
+ The index is valid only when it has one entry per row of the store; a
+ table filled some other way (the ground track shown when the dialog
+ opens) answers "No index" until the next run.
+*/
+
+static void
+table_query_status(TableQuery *q, const gchar *fmt, ...) G_GNUC_PRINTF(2, 3);
+
+static void
+table_query_status(TableQuery *q, const gchar *fmt, ...)
+{
+    va_list ap;
+    if (!GTK_IS_LABEL(q->status)) return;
+    va_start(ap, fmt);
+    gchar *txt = g_strdup_vprintf(fmt, ap);
+    va_end(ap);
+    gtk_label_set_text(q->status, txt);
+    g_free(txt);
+}
+
+/*
+ * @brief Returns the index of the table if it describes the rows the store holds.
+ * @function table_query_index
+ * @param q TableQuery *q
+ * @return (result_index_t *) or NULL
+ */
+static result_index_t *
+table_query_index(TableQuery *q)
+{
+    result_index_t *idx = *q->index;
+    if (!idx || !GTK_IS_LIST_STORE(*q->store) ||
+        gtk_tree_view_get_model(q->tv) == NULL)   /* detached while filling */
+        return NULL;
+    if ((gint)RESULT_INDEX_LEN(idx) !=
+        gtk_tree_model_iter_n_children(GTK_TREE_MODEL(*q->store), NULL))
+        return NULL;
+    return idx;
+}
+
+static gboolean
+table_query_filtered(TableQuery *q)
+{
+    return q->sub && gtk_tree_view_get_model(q->tv) == GTK_TREE_MODEL(q->sub);
+}
+
+/*
+ * @brief Scrolls the view to the first row at or after the typed time.
+ * @function on_table_query_jump
+ * @thread Runs on the GTK main thread (GLib main loop).
+ * @param w GtkWidget *w
+ * @param user_data gpointer user_data (TableQuery *)
+ * @return (void)
+ */
+static void
+on_table_query_jump(GtkWidget *w, gpointer user_data)
+{
+    (void)w;
+    TableQuery *q = user_data;
+    result_index_t *idx = table_query_index(q);
+    gdouble jd;
+
+    if (!idx) { table_query_status(q, "No index"); return; }
+    if (!result_index_parse_time(gtk_entry_get_text(q->time_entry), &jd)) {
+        table_query_status(q, "Time: YYYY/MM/DD HH:MM:SS");
+        return;
+    }
+
+    guint row = result_index_find_time(idx, jd);
+    guint pos = row;
+    guint n   = RESULT_INDEX_LEN(idx);
+    if (table_query_filtered(q)) {
+        /* first shown row at or after it; shown is sorted */
+        guint lo = 0, hi = q->shown->len;
+        while (lo < hi) {
+            guint mid = lo + (hi - lo) / 2;
+            if (g_array_index(q->shown, guint, mid) < row) lo = mid + 1;
+            else hi = mid;
+        }
+        pos = lo;
+        n   = q->shown->len;
+    }
+    if (pos >= n) { table_query_status(q, "After the last row"); return; }
+
+    GtkTreePath *path = gtk_tree_path_new_from_indices((gint)pos, -1);
+    gtk_tree_view_scroll_to_cell(q->tv, path, NULL, TRUE, 0.0, 0.0);
+    gtk_tree_view_set_cursor(q->tv, path, NULL, FALSE);
+    gtk_tree_path_free(path);
+    table_query_status(q, "Row %u", pos + 1);
+}
+
+/*
+ * @brief Parses "lat1,lat2,lon1,lon2"; lon1 > lon2 crosses the date line.
+ * @function parse_box
+ * @param text const gchar *text
+ * @param box gdouble box[4]
+ * @return (gboolean)
+ */
+static gboolean
+parse_box(const gchar *text, gdouble box[4])
+{
+    gchar **f = g_strsplit(text, ",", -1);
+    gboolean ok = (g_strv_length(f) == 4);
+    for (guint i = 0; ok && i < 4; ++i) {
+        gchar *end = NULL;
+        box[i] = g_ascii_strtod(g_strstrip(f[i]), &end);
+        ok = (end != f[i] && *end == '\0' && isfinite(box[i]));
+    }
+    g_strfreev(f);
+    if (ok && box[0] > box[1]) { gdouble t = box[0]; box[0] = box[1]; box[1] = t; }
+    return ok;
+}
+
+/*
+ * @brief Clears the filter and shows the full table again.
+ * @function on_table_query_clear
+ * @thread Runs on the GTK main thread (GLib main loop).
+ * @param w GtkWidget *w
+ * @param user_data gpointer user_data (TableQuery *)
+ * @return (void)
+ */
+static void
+on_table_query_clear(GtkWidget *w, gpointer user_data)
+{
+    (void)w;
+    TableQuery *q = user_data;
+    if (table_query_filtered(q))
+        gtk_tree_view_set_model(q->tv, GTK_TREE_MODEL(*q->store));
+    g_clear_object(&q->sub);
+    g_array_set_size(q->shown, 0);
+    table_query_status(q, " ");
+}
+
+/*
+ * @brief Shows only the rows of the chosen orbit/pass and lat/lon box.
+ * @function on_table_query_filter
+ * @thread Runs on the GTK main thread (GLib main loop).
+ * @note The matching rows are copied; the cost follows the number of matches.
+ * @param w GtkWidget *w
+ * @param user_data gpointer user_data (TableQuery *)
+ * @return (void)
+ */
+static void
+on_table_query_filter(GtkWidget *w, gpointer user_data)
+{
+    (void)w;
+    TableQuery *q = user_data;
+    result_index_t *idx = table_query_index(q);
+    const gchar *btxt = gtk_entry_get_text(q->box_entry);
+    guint k = (guint)gtk_spin_button_get_value_as_int(q->seg_spin);
+    gboolean use_box = (btxt && *btxt);
+    gdouble box[4];
+    guint first = 0, end;
+
+    if (!idx) { table_query_status(q, "No index"); return; }
+    if (k == 0 && !use_box) { on_table_query_clear(NULL, q); return; }
+    if (use_box && !parse_box(btxt, box)) {
+        table_query_status(q, "Box: lat1,lat2,lon1,lon2");
+        return;
+    }
+    end = RESULT_INDEX_LEN(idx);
+    if (k > 0 && !result_index_segment(idx, k - 1, &first, &end)) {
+        table_query_status(q, "Only %u", result_index_n_segments(idx));
+        return;
+    }
+
+    /* rows to show, in table order */
+    GArray *rows;
+    if (use_box) {
+        GArray *hits = result_index_box(idx, box[0], box[1], box[2], box[3]);
+        rows = g_array_new(FALSE, FALSE, sizeof(guint));
+        for (guint i = 0; i < hits->len; ++i) {
+            guint r = g_array_index(hits, guint, i);
+            if (r >= first && r < end) g_array_append_val(rows, r);
+        }
+        g_array_free(hits, TRUE);
+    } else {
+        rows = g_array_sized_new(FALSE, FALSE, sizeof(guint), end - first);
+        for (guint r = first; r < end; ++r) g_array_append_val(rows, r);
+    }
+
+    /* copy them into a store of the same layout */
+    GtkTreeModel *src = GTK_TREE_MODEL(*q->store);
+    gint ncols = gtk_tree_model_get_n_columns(src);
+    GType *types = g_new(GType, ncols);
+    gint  *cols  = g_new(gint, ncols);
+    GValue *vals = g_new0(GValue, ncols);
+    for (gint c = 0; c < ncols; ++c) {
+        types[c] = gtk_tree_model_get_column_type(src, c);
+        cols[c]  = c;
+    }
+    GtkListStore *sub = gtk_list_store_newv(ncols, types);
+    for (guint i = 0; i < rows->len; ++i) {
+        GtkTreeIter it;
+        if (!gtk_tree_model_iter_nth_child(src, &it, NULL, g_array_index(rows, guint, i)))
+            continue;
+        for (gint c = 0; c < ncols; ++c)
+            gtk_tree_model_get_value(src, &it, c, &vals[c]);
+        gtk_list_store_insert_with_valuesv(sub, NULL, -1, cols, vals, ncols);
+        for (gint c = 0; c < ncols; ++c)
+            g_value_unset(&vals[c]);
+    }
+    g_free(vals);
+    g_free(cols);
+    g_free(types);
+
+    g_clear_object(&q->sub);
+    q->sub = sub;
+    g_array_free(q->shown, TRUE);
+    q->shown = rows;
+    gtk_tree_view_set_model(q->tv, GTK_TREE_MODEL(q->sub));
+    table_query_status(q, "%u rows", rows->len);
+}
+
+static void
+table_query_free(gpointer data)
+{
+    TableQuery *q = data;
+    g_clear_object(&q->sub);
+    g_array_free(q->shown, TRUE);
+    g_free(q);
+}
+
+/*
+ * @brief Builds the query bar of a result table.
+ * @function table_query_new
+ * @param tv GtkTreeView *tv
+ * @param store GtkListStore **store  the tab's full store (stays valid)
+ * @param index result_index_t **index  its index (stays valid)
+ * @param seg_name const gchar *seg_name  "Orbit" or "Pass"
+ * @return (GtkWidget *) the bar; the query lives as long as the view
+ */
+static GtkWidget *
+table_query_new(GtkTreeView *tv, GtkListStore **store, result_index_t **index,
+                const gchar *seg_name)
+{
+    TableQuery *q = g_new0(TableQuery, 1);
+    q->tv    = tv;
+    q->store = store;
+    q->index = index;
+    q->shown = g_array_new(FALSE, FALSE, sizeof(guint));
+    g_object_set_data_full(G_OBJECT(tv), "table-query", q, table_query_free);
+
+    GtkWidget *hbox = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 6);
+
+    gtk_box_pack_start(GTK_BOX(hbox), gtk_label_new("Go to:"), FALSE, FALSE, 0);
+    GtkWidget *time_entry = gtk_entry_new();
+    gtk_entry_set_placeholder_text(GTK_ENTRY(time_entry), "YYYY/MM/DD HH:MM:SS");
+    gtk_entry_set_width_chars(GTK_ENTRY(time_entry), 20);
+    gtk_box_pack_start(GTK_BOX(hbox), time_entry, FALSE, FALSE, 0);
+    q->time_entry = GTK_ENTRY(time_entry);
+    g_signal_connect(time_entry, "activate", G_CALLBACK(on_table_query_jump), q);
+
+    gchar *lbl = g_strdup_printf(" %s:", seg_name);
+    gtk_box_pack_start(GTK_BOX(hbox), gtk_label_new(lbl), FALSE, FALSE, 0);
+    g_free(lbl);
+    GtkWidget *seg_spin = gtk_spin_button_new_with_range(0.0, 1.0e6, 1.0);
+    gtk_widget_set_tooltip_text(seg_spin, "0 = all");
+    gtk_box_pack_start(GTK_BOX(hbox), seg_spin, FALSE, FALSE, 0);
+    q->seg_spin = GTK_SPIN_BUTTON(seg_spin);
+
+    gtk_box_pack_start(GTK_BOX(hbox), gtk_label_new(" Box:"), FALSE, FALSE, 0);
+    GtkWidget *box_entry = gtk_entry_new();
+    gtk_entry_set_placeholder_text(GTK_ENTRY(box_entry), "lat1,lat2,lon1,lon2");
+    gtk_box_pack_start(GTK_BOX(hbox), box_entry, TRUE, TRUE, 0);
+    q->box_entry = GTK_ENTRY(box_entry);
+    g_signal_connect(box_entry, "activate", G_CALLBACK(on_table_query_filter), q);
+
+    GtkWidget *filter_btn = gtk_button_new_with_label("Filter");
+    gtk_box_pack_start(GTK_BOX(hbox), filter_btn, FALSE, FALSE, 0);
+    g_signal_connect(filter_btn, "clicked", G_CALLBACK(on_table_query_filter), q);
+
+    GtkWidget *clear_btn = gtk_button_new_with_label("Clear");
+    gtk_box_pack_start(GTK_BOX(hbox), clear_btn, FALSE, FALSE, 0);
+    g_signal_connect(clear_btn, "clicked", G_CALLBACK(on_table_query_clear), q);
+
+    GtkWidget *status = gtk_label_new(" ");
+    gtk_box_pack_start(GTK_BOX(hbox), status, FALSE, FALSE, 6);
+    q->status = GTK_LABEL(status);
+
+    return hbox;
+}
+
+
 /*
 =================================================================================
 CORE ENTRYPOINT — BUILDS AND ORCHESTRATES THE “EPHEMERIS DATA” DIALOG Main Window
@@ -2173,7 +3268,7 @@ Initializes the POI index from CSV, builds an entry with completion and a
 “Refresh” action, and prepares a seven-column model (Time, Lat, Lon, Range,
 Direction, Name, Type). A POISelectionCtx keeps the entry, progress pulse,
 elapsed label, and table together. Actions (activation, completion, refresh)
-trigger the background POI computation; results stream in via idle callbacks.
+restart the Tab 1 run, whose POI stage streams the results via idle callbacks.
 
 The dialog keeps “Save” hidden until this tab is active to prevent exporting
 empty or irrelevant data. Tab 3 is also linked back to Tab 1’s updater so
@@ -2259,7 +3354,7 @@ on_show_ephemeris_activate(GtkMenuItem *menuitem, gpointer user_data)
     actual collection is done by on_orbits_value_changed() */   
     
     /* initialize our tile filter (once per popup) */
-    if (!lp_init(POI_CSV_FILE, NULL)) {
+    if (!poi_tiles_load()) {
         g_warning("Logic_Point: failed to load tiles CSV '%s'", POI_CSV_FILE);
     }
 
@@ -2287,13 +3382,13 @@ on_show_ephemeris_activate(GtkMenuItem *menuitem, gpointer user_data)
     gtk_box_pack_start(GTK_BOX(hbox_orbits), gtk_label_new(" Step (s):"), FALSE, FALSE, 0);
     GtkAdjustment *step_adj = gtk_adjustment_new(
             30.0,    /* default 30 s */
-            1.0,    /* min 1 s   */
+            0.1,    /* min 0.1 s */
         3600.0,    /* max 1 h   */
             1.0,    /* step 1 s  */
             10.0,    /* page 10 s */
             0.0     /* page‐overflow */
         );
-    GtkWidget *spin_step = gtk_spin_button_new(step_adj, 1.0, 0);
+    GtkWidget *spin_step = gtk_spin_button_new(step_adj, 1.0, 1);
     gtk_box_pack_start(GTK_BOX(hbox_orbits), spin_step, FALSE, FALSE, 0);
 
 
@@ -2311,7 +3406,14 @@ on_show_ephemeris_activate(GtkMenuItem *menuitem, gpointer user_data)
     GtkListStore *store = gtk_list_store_new(N_COLS,
                                              G_TYPE_STRING,
                                              G_TYPE_DOUBLE,
-                                             G_TYPE_DOUBLE);
+                                             G_TYPE_DOUBLE,
+                                             G_TYPE_UINT);   /* index in "sat-names" */
+    {
+        GPtrArray *names = g_ptr_array_new_with_free_func(g_free);
+        g_ptr_array_add(names, g_strdup(sat->nickname));
+        tab1_set_sat_names(store, names);
+        g_ptr_array_unref(names);
+    }
     /* Fill it from your g_ephem_buffer (already “now → next → …”) */
     for (GSList *l = g_ephem_buffer; l; l = l->next) {
         EphemPoint *pp = (EphemPoint*)l->data;
@@ -2321,6 +3423,7 @@ on_show_ephemeris_activate(GtkMenuItem *menuitem, gpointer user_data)
                            COL_TIME, pp->time_str,
                            COL_LAT,  pp->lat_deg,
                            COL_LON,  pp->lon_deg,
+                           COL_SAT,  0u,
                            -1);
     }
 
@@ -2341,6 +3444,16 @@ on_show_ephemeris_activate(GtkMenuItem *menuitem, gpointer user_data)
         gtk_tree_view_append_column(GTK_TREE_VIEW(tv_ephem), c);
         
     }
+    {
+        /* Satellite column */
+        GtkCellRenderer *r = gtk_cell_renderer_text_new();
+        GtkTreeViewColumn *c = gtk_tree_view_column_new();
+        gtk_tree_view_column_set_title(c, "Satellite");
+        gtk_tree_view_column_pack_start(c, r, TRUE);
+        gtk_tree_view_column_set_cell_data_func(c, r,
+            sat_cell_data_func, store, NULL);
+        gtk_tree_view_append_column(GTK_TREE_VIEW(tv_ephem), c);
+    }
     {
         /* Latitude column */
         GtkCellRenderer *r = gtk_cell_renderer_text_new();
@@ -2375,6 +3488,14 @@ on_show_ephemeris_activate(GtkMenuItem *menuitem, gpointer user_data)
         update_ctx->hours_spin  = GTK_SPIN_BUTTON(spin_hours);
         update_ctx->step_spin   = GTK_SPIN_BUTTON(spin_step);
 
+        /* satellites of the run: the popup's one, plus any picked from the module */
+        update_ctx->sats = g_ptr_array_new();
+        g_ptr_array_add(update_ctx->sats, sat);
+        GtkWidget *sats_button = gtk_button_new_with_label("Satellites (1)");
+        gtk_box_pack_start(GTK_BOX(hbox_orbits), sats_button, FALSE, FALSE, 6);
+        update_ctx->sats_button = sats_button;
+        g_signal_connect(sats_button, "clicked", G_CALLBACK(on_sats_clicked), update_ctx);
+
         // After you create spin_hours and spin_step, before the scrolled window:
         GtkWidget *progress = gtk_progress_bar_new();
         gtk_progress_bar_set_show_text(GTK_PROGRESS_BAR(progress), FALSE);
@@ -2404,6 +3525,12 @@ on_show_ephemeris_activate(GtkMenuItem *menuitem, gpointer user_data)
         g_signal_connect(spin_step, "value-changed",
                          G_CALLBACK(on_orbits_value_changed),
                          update_ctx);
+        /* jump/filter bar right above the table */
+        GtkWidget *query1 = table_query_new(GTK_TREE_VIEW(tv_ephem), &update_ctx->store,
+                                            &update_ctx->index, "Orbit");
+        gtk_box_pack_start(GTK_BOX(page1), query1, FALSE, FALSE, 0);
+        gtk_box_reorder_child(GTK_BOX(page1), query1, 1);
+
         /* immediately populate Tab 1 exactly as the spin-handler does */
         on_orbits_value_changed(GTK_SPIN_BUTTON(spin_hours), update_ctx);
 
@@ -2516,6 +3643,7 @@ on_show_ephemeris_activate(GtkMenuItem *menuitem, gpointer user_data)
         ZONE_COL_LAT,
         ZONE_COL_LON,
         ZONE_COL_COUNTRY,
+        ZONE_COL_SAT,
         ZONE_N_COLS
     };
 
@@ -2527,7 +3655,8 @@ on_show_ephemeris_activate(GtkMenuItem *menuitem, gpointer user_data)
         G_TYPE_STRING,  /* ZONE_COL_TIME    */
         G_TYPE_DOUBLE,  /* ZONE_COL_LAT     */
         G_TYPE_DOUBLE,  /* ZONE_COL_LON     */
-        G_TYPE_STRING   /* ZONE_COL_COUNTRY */
+        G_TYPE_STRING,  /* ZONE_COL_COUNTRY */
+        G_TYPE_STRING   /* ZONE_COL_SAT     */
     );
     country_ctx->store  = empty2;
 
@@ -2547,6 +3676,16 @@ on_show_ephemeris_activate(GtkMenuItem *menuitem, gpointer user_data)
         
     }
 
+    /* 3b) Add the “Satellite” column */
+    {
+        GtkCellRenderer *r = gtk_cell_renderer_text_new();
+        GtkTreeViewColumn *c = gtk_tree_view_column_new_with_attributes(
+            "Satellite", r,
+            "text", ZONE_COL_SAT,
+            NULL);
+        gtk_tree_view_append_column(GTK_TREE_VIEW(tv2), c);
+    }
+
     /* 4) Add the “Latitude” column */
     {
         GtkCellRenderer *r = gtk_cell_renderer_text_new();
@@ -2592,13 +3731,23 @@ on_show_ephemeris_activate(GtkMenuItem *menuitem, gpointer user_data)
     gtk_widget_set_hexpand(scrolled2, TRUE);
     gtk_container_add(GTK_CONTAINER(scrolled2), tv2);
 
-    /* 8) Pack into the Tab 2 page box */
+    /* 8) Pack into the Tab 2 page box, under its jump/filter bar */
+    gtk_box_pack_start(GTK_BOX(page2),
+                       table_query_new(GTK_TREE_VIEW(tv2), &country_ctx->store,
+                                       &country_ctx->index, "Pass"),
+                       FALSE, FALSE, 0);
     gtk_box_pack_start(GTK_BOX(page2), scrolled2, TRUE, TRUE, 0);
     
 
     /* 9) Store the TreeView pointer for the “Show Table” callback */
     country_ctx->treeview = tv2;
     g_object_set_data(G_OBJECT(dialog), "country_ctx", country_ctx);
+    {
+        EphemUpdateCtx *update_ctx =
+            g_object_get_data(G_OBJECT(dialog), "update_ctx");
+        if (update_ctx)
+            update_ctx->country_ctx = country_ctx;
+    }
 
     /* cancel any running territory task if the dialog is closed */
   g_signal_connect(dialog, "destroy",
@@ -2644,7 +3793,6 @@ on_show_ephemeris_activate(GtkMenuItem *menuitem, gpointer user_data)
 
     /* Make our context and hook signals */
     POISelectionCtx *poi_ctx = g_new0(POISelectionCtx, 1);
-    poi_ctx->tab1_tree = GTK_TREE_VIEW(tv_ephem);
     poi_ctx->names    = names;
     poi_ctx->types    = types;
 
@@ -2709,6 +3857,7 @@ on_show_ephemeris_activate(GtkMenuItem *menuitem, gpointer user_data)
         POI_COL_DIR,
         POI_COL_NAME,      /* existing: point-of-interest name */
         POI_COL_TYPE,      /* point-of-interest type */
+        POI_COL_SAT,       /* satellite */
         POI_N_COLS
     };
 
@@ -2719,9 +3868,10 @@ on_show_ephemeris_activate(GtkMenuItem *menuitem, gpointer user_data)
         G_TYPE_DOUBLE,  /* Lat */
         G_TYPE_DOUBLE,  /* Lon */
         G_TYPE_DOUBLE,  /* Range */
-        G_TYPE_STRING,  /* Direction */
+        G_TYPE_DOUBLE,  /* Direction (bearing, formatted by the cell) */
         G_TYPE_STRING,  /* Name */
-        G_TYPE_STRING   /* Type */
+        G_TYPE_STRING,  /* Type */
+        G_TYPE_STRING   /* Satellite */
     );  
 
     /* 2) Create the TreeView */
@@ -2739,6 +3889,16 @@ on_show_ephemeris_activate(GtkMenuItem *menuitem, gpointer user_data)
        gtk_tree_view_append_column(GTK_TREE_VIEW(poi_tree), c);
     }
 
+    /* 3b) Add “Satellite” column */
+    {
+        GtkCellRenderer *r = gtk_cell_renderer_text_new();
+        GtkTreeViewColumn *c = gtk_tree_view_column_new_with_attributes(
+            "Satellite", r,
+            "text", POI_COL_SAT,
+            NULL);
+        gtk_tree_view_append_column(GTK_TREE_VIEW(poi_tree), c);
+    }
+
     /* 4) Add “Latitude” column */
     {
         GtkCellRenderer *r = gtk_cell_renderer_text_new();
@@ -2777,10 +3937,11 @@ on_show_ephemeris_activate(GtkMenuItem *menuitem, gpointer user_data)
     /* 7) Add “Direction” column */
     {
         GtkCellRenderer *r = gtk_cell_renderer_text_new();
-        GtkTreeViewColumn *c = gtk_tree_view_column_new_with_attributes(
-            "Direction (N, S, E, W)", r,
-            "text", POI_COL_DIR,
-            NULL);
+        GtkTreeViewColumn *c = gtk_tree_view_column_new();
+        gtk_tree_view_column_set_title(c, "Direction (N, S, E, W)");
+        gtk_tree_view_column_pack_start(c, r, TRUE);
+        gtk_tree_view_column_set_cell_data_func(c, r,
+            dir_cell_data_func, GINT_TO_POINTER(POI_COL_DIR), NULL);
         gtk_tree_view_append_column(GTK_TREE_VIEW(poi_tree), c);
     }
 
@@ -2813,16 +3974,25 @@ on_show_ephemeris_activate(GtkMenuItem *menuitem, gpointer user_data)
     poi_ctx->store    = poi_store;
     poi_ctx->treeview = GTK_TREE_VIEW(poi_tree);
 
+    /* jump/filter bar right above the table */
+    {
+        GtkWidget *query3 = table_query_new(GTK_TREE_VIEW(poi_tree), &poi_ctx->store,
+                                            &poi_ctx->index, "Pass");
+        gtk_box_pack_start(GTK_BOX(vbox_poi), query3, FALSE, FALSE, 0);
+        gtk_box_reorder_child(GTK_BOX(vbox_poi), query3, 3);
+    }
+
     /* keep a handle so the Save handler can find Tab 3’s model */
     g_object_set_data(G_OBJECT(dialog), "poi_ctx", poi_ctx);
 
 
-    /* now that entry/store/treeview are set, hook auto‐refresh */
+    /* now that entry/store/treeview are set, let runs feed Tab 3 */
     {
         EphemUpdateCtx *update_ctx =
             g_object_get_data(G_OBJECT(dialog), "update_ctx");
         if (update_ctx)
             update_ctx->poi_ctx = poi_ctx;
+        poi_ctx->ephem = update_ctx;
     }
 
     /* Tab 3: initially populate with ALL points inside any tile */
@@ -2877,6 +4047,8 @@ on_show_ephemeris_activate(GtkMenuItem *menuitem, gpointer user_data)
 
 static void     coverage_toggled(GtkCheckMenuItem * item, gpointer data);
 static void     track_toggled(GtkCheckMenuItem * item, gpointer data);
+static void     tle_diff_cb(GtkWidget * menuitem, gpointer data);
+static void     center_cb(GtkWidget * menuitem, gpointer data);
 
 /* static void target_toggled (GtkCheckMenuItem *item, gpointer data); */
 
@@ -2965,6 +4137,12 @@ void gtk_sat_map_popup_exec(sat_t * sat,
                                    obj->showtrack);
     g_signal_connect(menuitem, "activate", G_CALLBACK(track_toggled), satmap);
 
+    /* centre the map on the satellite */
+    menuitem = gtk_menu_item_new_with_label(_("Center map on satellite"));
+    g_object_set_data(G_OBJECT(menuitem), "sat", sat);
+    g_signal_connect(menuitem, "activate", G_CALLBACK(center_cb), satmap);
+    gtk_menu_shell_append(GTK_MENU_SHELL(menu), menuitem);
+
     /* ── Step 5.1: Create “Show Ephemeris” and store our context pointers ── */
     menuitem = gtk_menu_item_new_with_label(_("Show Ephemeris"));
 
@@ -2979,6 +4157,12 @@ void gtk_sat_map_popup_exec(sat_t * sat,
                      ctx);
 
     gtk_menu_shell_append(GTK_MENU_SHELL(menu), menuitem);
+
+    /* TLE-age sensitivity */
+    menuitem = gtk_menu_item_new_with_label(_("Compare TLE sets..."));
+    g_object_set_data(G_OBJECT(menuitem), "sat", sat);
+    g_signal_connect(menuitem, "activate", G_CALLBACK(tle_diff_cb), satmap);
+    gtk_menu_shell_append(GTK_MENU_SHELL(menu), menuitem);
     /* ── end insertion ── */
     gtk_widget_show_all(menu);
 
@@ -3178,3 +4362,220 @@ static void target_toggled(GtkCheckMenuItem * item, gpointer data)
     gtk_check_menu_item_set_active(item, obj->istarget);
 }
 #endif
+
+/** State of a running TLE comparison. */
+typedef struct {
+    GtkWidget      *satmap;
+    GtkWidget      *dialog;     /* progress dialog */
+    GtkWidget      *bar;
+    GCancellable   *cancel;
+} TleDiffCtx;
+
+static void tle_diff_progress(guint done, guint total, gpointer data)
+{
+    TleDiffCtx     *ctx = data;
+    gchar          *text;
+
+    gtk_progress_bar_set_fraction(GTK_PROGRESS_BAR(ctx->bar),
+                                  total ? (gdouble) done / total : 1.0);
+    text = g_strdup_printf(_("%u of %u element sets"), done, total);
+    gtk_progress_bar_set_text(GTK_PROGRESS_BAR(ctx->bar), text);
+    g_free(text);
+}
+
+/* Cancel button or window closed; tle_diff_done() cleans up. */
+static void tle_diff_response(GtkDialog * dialog, gint response,
+                              gpointer data)
+{
+    TleDiffCtx     *ctx = data;
+
+    (void)dialog;
+    (void)response;
+
+    g_cancellable_cancel(ctx->cancel);
+}
+
+static void tle_diff_ctx_free(TleDiffCtx * ctx)
+{
+    gtk_widget_destroy(ctx->dialog);
+    g_object_unref(ctx->cancel);
+    g_object_unref(ctx->satmap);
+    g_free(ctx);
+}
+
+/** Show the TLE comparison report, or the error that prevented it. */
+static void tle_diff_done(GObject * source, GAsyncResult * res, gpointer data)
+{
+    TleDiffCtx     *ctx = data;
+    GtkWidget      *toplevel = gtk_widget_get_toplevel(ctx->satmap);
+    GtkWindow      *parent = NULL;
+    GtkWidget      *dialog, *swin, *view;
+    tle_diff_t     *diff;
+    GError         *err = NULL;
+    gchar          *text;
+
+    (void)source;
+
+    if (gtk_widget_is_toplevel(toplevel) && GTK_IS_WINDOW(toplevel))
+        parent = GTK_WINDOW(toplevel);
+
+    diff = tle_diff_run_finish(res, &err);
+    if (diff == NULL && g_error_matches(err, G_IO_ERROR, G_IO_ERROR_CANCELLED))
+    {
+        sat_log_log(SAT_LOG_LEVEL_INFO, _("%s: TLE comparison cancelled"),
+                    __func__);
+        g_clear_error(&err);
+        tle_diff_ctx_free(ctx);
+        return;
+    }
+    if (diff == NULL)
+    {
+        sat_log_log(SAT_LOG_LEVEL_ERROR, _("%s: TLE comparison failed (%s)"),
+                    __func__, err->message);
+        dialog = gtk_message_dialog_new(parent,
+                                        GTK_DIALOG_DESTROY_WITH_PARENT,
+                                        GTK_MESSAGE_ERROR, GTK_BUTTONS_CLOSE,
+                                        _("TLE comparison failed: %s"),
+                                        err->message);
+        g_signal_connect(dialog, "response", G_CALLBACK(gtk_widget_destroy),
+                         NULL);
+        gtk_widget_show_all(dialog);
+        g_clear_error(&err);
+        tle_diff_ctx_free(ctx);
+        return;
+    }
+
+    text = tle_diff_report(diff);
+    tle_diff_free(diff);
+
+    view = gtk_text_view_new();
+    gtk_text_view_set_editable(GTK_TEXT_VIEW(view), FALSE);
+    gtk_text_view_set_monospace(GTK_TEXT_VIEW(view), TRUE);
+    gtk_text_buffer_set_text(gtk_text_view_get_buffer(GTK_TEXT_VIEW(view)),
+                             text, -1);
+    g_free(text);
+
+    swin = gtk_scrolled_window_new(NULL, NULL);
+    gtk_widget_set_size_request(swin, 800, 400);
+    gtk_container_add(GTK_CONTAINER(swin), view);
+
+    dialog = gtk_dialog_new_with_buttons(_("TLE Sensitivity"), parent,
+                                         GTK_DIALOG_DESTROY_WITH_PARENT,
+                                         "_Close", GTK_RESPONSE_CLOSE, NULL);
+    gtk_box_pack_start(GTK_BOX
+                       (gtk_dialog_get_content_area(GTK_DIALOG(dialog))),
+                       swin, TRUE, TRUE, 0);
+    g_signal_connect(dialog, "response", G_CALLBACK(gtk_widget_destroy),
+                     NULL);
+    gtk_widget_show_all(dialog);
+
+    tle_diff_ctx_free(ctx);
+}
+
+/**
+ * Centre the map on the sub-satellite longitude.
+ *
+ * The whole degree is stored as the module's map centre, like the value
+ * from the map configuration, so later reconfigurations keep it.
+ */
+static void center_cb(GtkWidget * menuitem, gpointer data)
+{
+    GtkSatMap      *satmap = GTK_SAT_MAP(data);
+    sat_t          *sat = SAT(g_object_get_data(G_OBJECT(menuitem), "sat"));
+    gint            clon = (gint) lround(sat->ssplon);
+
+    g_key_file_set_integer(satmap->cfgdata, MOD_CFG_MAP_SECTION,
+                           MOD_CFG_MAP_CENTER, clon);
+    gtk_sat_map_set_center(GTK_WIDGET(satmap), clon);
+}
+
+/**
+ * Compare the satellite's current elements with sets from TLE files.
+ *
+ * The user picks one or more TLE files (the update cache by default); every
+ * set for this satellite is propagated next to the current elements over
+ * the next 24 hours in the background while a progress dialog is shown.
+ */
+static void tle_diff_cb(GtkWidget * menuitem, gpointer data)
+{
+    GtkSatMap      *satmap = GTK_SAT_MAP(data);
+    sat_t          *sat = SAT(g_object_get_data(G_OBJECT(menuitem), "sat"));
+    GtkWidget      *toplevel = gtk_widget_get_toplevel(GTK_WIDGET(satmap));
+    GtkWidget      *dialog;
+    GtkWidget      *area;
+    GSList         *files, *l;
+    GArray         *sets;
+    TleDiffCtx     *ctx;
+    tle_diff_params_t params;
+    tle_t           ref;
+    gchar          *dir;
+    GError         *err = NULL;
+
+    /* the module may reload its satellites while the chooser is open */
+    ref = sat->tle;
+    g_strlcpy(ref.sat_name, sat->name, sizeof(ref.sat_name));
+
+    dialog = gtk_file_chooser_dialog_new(_("Select TLE Files"),
+                                         GTK_IS_WINDOW(toplevel) ?
+                                         GTK_WINDOW(toplevel) : NULL,
+                                         GTK_FILE_CHOOSER_ACTION_OPEN,
+                                         "_Cancel", GTK_RESPONSE_CANCEL,
+                                         "_Open", GTK_RESPONSE_ACCEPT, NULL);
+    gtk_file_chooser_set_select_multiple(GTK_FILE_CHOOSER(dialog), TRUE);
+    dir = sat_file_name("cache");
+    if (g_file_test(dir, G_FILE_TEST_IS_DIR))
+        gtk_file_chooser_set_current_folder(GTK_FILE_CHOOSER(dialog), dir);
+    g_free(dir);
+
+    if (gtk_dialog_run(GTK_DIALOG(dialog)) != GTK_RESPONSE_ACCEPT)
+    {
+        gtk_widget_destroy(dialog);
+        return;
+    }
+    files = gtk_file_chooser_get_filenames(GTK_FILE_CHOOSER(dialog));
+    gtk_widget_destroy(dialog);
+
+    sets = g_array_new(FALSE, FALSE, sizeof(tle_t));
+    for (l = files; l != NULL; l = l->next)
+    {
+        if (tle_diff_load_file(l->data, ref.catnr, sets, &err) == 0 &&
+            err != NULL)
+        {
+            sat_log_log(SAT_LOG_LEVEL_WARN, _("%s: Could not read %s (%s)"),
+                        __func__, (gchar *) l->data, err->message);
+            g_clear_error(&err);
+        }
+    }
+    g_slist_free_full(files, g_free);
+
+    sat_log_log(SAT_LOG_LEVEL_INFO,
+                _("%s: Comparing %u element sets for %s"),
+                __func__, sets->len, ref.sat_name);
+
+    /* progress dialog */
+    ctx = g_new0(TleDiffCtx, 1);
+    ctx->satmap = g_object_ref(satmap);
+    ctx->cancel = g_cancellable_new();
+    ctx->dialog = gtk_dialog_new_with_buttons(_("TLE Sensitivity"),
+                                              GTK_IS_WINDOW(toplevel) ?
+                                              GTK_WINDOW(toplevel) : NULL,
+                                              GTK_DIALOG_DESTROY_WITH_PARENT,
+                                              "_Cancel", GTK_RESPONSE_CANCEL,
+                                              NULL);
+    ctx->bar = gtk_progress_bar_new();
+    gtk_progress_bar_set_show_text(GTK_PROGRESS_BAR(ctx->bar), TRUE);
+    area = gtk_dialog_get_content_area(GTK_DIALOG(ctx->dialog));
+    gtk_container_set_border_width(GTK_CONTAINER(area), 10);
+    gtk_box_pack_start(GTK_BOX(area), ctx->bar, TRUE, TRUE, 0);
+    g_signal_connect(ctx->dialog, "response",
+                     G_CALLBACK(tle_diff_response), ctx);
+    g_signal_connect(ctx->dialog, "delete-event",
+                     G_CALLBACK(gtk_true), NULL);
+    gtk_widget_show_all(ctx->dialog);
+    tle_diff_progress(0, sets->len + 1, ctx);
+
+    tle_diff_params_init(&params, satmap->tstamp);
+    tle_diff_run_async(&ref, sets, &params, ctx->cancel, tle_diff_progress,
+                       ctx, tle_diff_done, ctx);
+    g_array_unref(sets);
+}
@@ -36,7 +36,6 @@
 #include "gtk-sat-map-ground-track.h"
 #include "gtk-sat-map.h"
 #include "locator.h"
-#include "map-tools.h"
 #include "mod-cfg-get-param.h"
 #include "orbit-tools.h"
 #include "predict-tools.h"
@@ -59,6 +58,8 @@ static void     gtk_sat_map_destroy(GtkWidget * widget);
 static void     size_allocate_cb(GtkWidget * widget,
                                  GtkAllocation * allocation, gpointer data);
 static void     update_map_size(GtkSatMap * satmap);
+static void     update_map_image(GtkSatMap * satmap);
+static void     update_overlay(GtkSatMap * satmap);
 static void     update_sat(gpointer key, gpointer value, gpointer data);
 static void     plot_sat(gpointer key, gpointer value, gpointer data);
 static void     free_sat_obj(gpointer key, gpointer value, gpointer data);
@@ -181,6 +182,9 @@ static void gtk_sat_map_init(GtkSatMap * satmap,
     satmap->showgrid = FALSE;
     satmap->keepratio = FALSE;
     satmap->resize = FALSE;
+    satmap->overlay = NULL;
+    satmap->overlaysurf = NULL;
+    satmap->overlayimg = NULL;
 }
 
 static void gtk_sat_map_destroy(GtkWidget * widget)
@@ -204,6 +208,16 @@ static void gtk_sat_map_destroy(GtkWidget * widget)
         /* these objects destruct themselves cleanly */
         g_object_unref(satmap->origmap);
         satmap->origmap = NULL;
+        if (satmap->mapsurf)
+        {
+            cairo_surface_destroy(satmap->mapsurf);
+            satmap->mapsurf = NULL;
+        }
+        if (satmap->overlaysurf)
+        {
+            cairo_surface_destroy(satmap->overlaysurf);
+            satmap->overlaysurf = NULL;
+        }
         g_hash_table_destroy(satmap->showtracks);
         satmap->showtracks = NULL;
         g_hash_table_destroy(satmap->hidecovs);
@@ -272,10 +286,27 @@ static void gtk_sat_map_destroy(GtkWidget * widget)
             satmap->gridvlab[i] = NULL;
         }
 
+        if (satmap->overlayimg)
+        {
+            idx = goo_canvas_item_model_find_child(root, satmap->overlayimg);
+            if (idx != -1)
+                goo_canvas_item_model_remove_child(root, idx);
+            satmap->overlayimg = NULL;
+            satmap->overlaypart[0] = NULL;
+            satmap->overlaypart[1] = NULL;
+        }
+        if (satmap->overlay)
+        {
+            g_object_unref(satmap->overlay);
+            satmap->overlay = NULL;
+        }
+
         idx = goo_canvas_item_model_find_child(root, satmap->map);
         if (idx != -1)
             goo_canvas_item_model_remove_child(root, idx);
         satmap->map = NULL;
+        satmap->mapimg[0] = NULL;
+        satmap->mapimg[1] = NULL;
     }
     (*GTK_WIDGET_CLASS(parent_class)->destroy) (widget);
 }
@@ -399,9 +430,12 @@ static GooCanvasItemModel *create_canvas_model(GtkSatMap * satmap)
     satmap->y0 = 0;
 
     /* background map */
-    satmap->map = goo_canvas_image_model_new(root,
-                                             satmap->origmap,
-                                             satmap->x0, satmap->y0, NULL);
+    satmap->map = goo_canvas_group_model_new(root, NULL);
+    satmap->mapimg[0] = goo_canvas_image_model_new(satmap->map, NULL,
+                                                   0, 0, NULL);
+    satmap->mapimg[1] = goo_canvas_image_model_new(satmap->map, NULL,
+                                                   0, 0, NULL);
+    update_map_image(satmap);
 
     goo_canvas_item_model_lower(satmap->map, NULL);
     draw_grid_lines(satmap, root);
@@ -511,7 +545,6 @@ static void size_allocate_cb(GtkWidget * widget, GtkAllocation * allocation,
 static void update_map_size(GtkSatMap * satmap)
 {
     GtkAllocation   allocation;
-    GdkPixbuf      *pbuf;
     gfloat          x, y;
     gfloat          ratio;      /* ratio between map width and height */
     gfloat          size;       /* size = min (alloc.w, ratio*alloc.h) */
@@ -536,12 +569,6 @@ static void update_map_size(GtkSatMap * satmap)
 
             satmap->x0 = (allocation.width - satmap->width) / 2;
             satmap->y0 = (allocation.height - satmap->height) / 2;
-
-            /* rescale pixbuf */
-            pbuf = gdk_pixbuf_scale_simple(satmap->origmap,
-                                           satmap->width,
-                                           satmap->height,
-                                           GDK_INTERP_BILINEAR);
         }
         else
         {
@@ -549,12 +576,6 @@ static void update_map_size(GtkSatMap * satmap)
             satmap->y0 = 0;
             satmap->width = allocation.width;
             satmap->height = allocation.height;
-
-            /* rescale pixbuf */
-            pbuf = gdk_pixbuf_scale_simple(satmap->origmap,
-                                           satmap->width,
-                                           satmap->height,
-                                           GDK_INTERP_BILINEAR);
         }
 
         /* set canvas bounds to match new size */
@@ -563,12 +584,8 @@ static void update_map_size(GtkSatMap * satmap)
 
 
         /* redraw static elements */
-        g_object_set(satmap->map,
-                     "pixbuf", pbuf,
-                     "x", (gdouble) satmap->x0,
-                     "y", (gdouble) satmap->y0, NULL);
-        g_object_unref(pbuf);
-
+        update_map_image(satmap);
+        update_overlay(satmap);
         redraw_grid_lines(satmap);
 
         if (satmap->show_terminator)
@@ -601,6 +618,289 @@ static void update_map_size(GtkSatMap * satmap)
     }
 }
 
+/**
+ * Show a surface that starts at -180 deg on two image items.
+ *
+ * Columns off..w-1 go on the left and 0..off-1 are wrapped around to the
+ * right, so that the left edge is at left_side_lon. Only patterns into the
+ * surface are created; no pixels are copied.
+ */
+static void set_wrapped_parts(GtkSatMap * satmap, cairo_surface_t * surf,
+                              GooCanvasItemModel ** items)
+{
+    cairo_surface_t *part;
+    cairo_pattern_t *pattern;
+    gint            w = cairo_image_surface_get_width(surf);
+    gint            h = cairo_image_surface_get_height(surf);
+    gint            off;
+    gint            pw;
+    guint           i;
+
+    /* column of the scaled surface that is at the left edge */
+    off = (gint) lround((satmap->left_side_lon + 180.0) * w / 360.0);
+    off = ((off % w) + w) % w;
+
+    for (i = 0; i < 2; i++)
+    {
+        pw = (i == 0) ? w - off : off;
+        pattern = NULL;
+        if (pw > 0)
+        {
+            part = cairo_surface_create_for_rectangle(surf,
+                                                      (i == 0) ? off : 0, 0,
+                                                      pw, h);
+            pattern = cairo_pattern_create_for_surface(part);
+            cairo_surface_destroy(part);
+        }
+
+        g_object_set(items[i],
+                     "pattern", pattern,
+                     "x", (gdouble) satmap->x0 + ((i == 0) ? 0 : w - off),
+                     "y", (gdouble) satmap->y0,
+                     "width", (gdouble) pw, "height", (gdouble) h, NULL);
+        if (pattern)
+            cairo_pattern_destroy(pattern);
+    }
+}
+
+/**
+ * Show the background map at the current geometry and centre longitude.
+ *
+ * The map is scaled only when the geometry has changed; the scaled copy is
+ * kept centred on 0 deg. The centre longitude is applied by drawing two
+ * sub-surfaces of it side by side, so re-centring does not copy any pixels.
+ */
+static void update_map_image(GtkSatMap * satmap)
+{
+    GdkPixbuf      *pbuf;
+    cairo_t        *cr;
+    gint            w = (gint) satmap->width;
+    gint            h = (gint) satmap->height;
+
+    if (w <= 0 || h <= 0)
+        return;
+
+    if (satmap->mapsurf == NULL ||
+        cairo_image_surface_get_width(satmap->mapsurf) != w ||
+        cairo_image_surface_get_height(satmap->mapsurf) != h)
+    {
+        if (satmap->mapsurf)
+            cairo_surface_destroy(satmap->mapsurf);
+
+        pbuf = gdk_pixbuf_scale_simple(satmap->origmap, w, h,
+                                       GDK_INTERP_BILINEAR);
+        satmap->mapsurf =
+            cairo_image_surface_create(gdk_pixbuf_get_has_alpha(pbuf) ?
+                                       CAIRO_FORMAT_ARGB32 :
+                                       CAIRO_FORMAT_RGB24, w, h);
+        cr = cairo_create(satmap->mapsurf);
+        gdk_cairo_set_source_pixbuf(cr, pbuf, 0, 0);
+        cairo_paint(cr);
+        cairo_destroy(cr);
+        g_object_unref(pbuf);
+    }
+
+    set_wrapped_parts(satmap, satmap->mapsurf, satmap->mapimg);
+}
+
+/* Longitude at the left side of a map centred on clon. */
+static gdouble map_left_lon(gdouble clon)
+{
+    if (clon > 0.0)
+        return clon - 180.0;
+    else if (clon < 0.0)
+        return clon + 180.0;
+
+    return -180.0;
+}
+
+/**
+ * Set the longitude at the centre of the map.
+ *
+ * @param satmap The GtkSatMap widget.
+ * @param clon The centre longitude between -180 and 180 deg, East positive.
+ *
+ * The background is not rescaled; everything else is redrawn at the next
+ * update.
+ */
+void gtk_sat_map_set_center(GtkWidget * satmap, gdouble clon)
+{
+    GtkSatMap      *m = GTK_SAT_MAP(satmap);
+
+    m->left_side_lon = map_left_lon(CLAMP(clon, -180.0, 180.0));
+    update_map_image(m);
+    m->resize = TRUE;
+}
+
+/**
+ * Paint overlay cells into the scaled overlay surface.
+ *
+ * @param satmap The GtkSatMap widget.
+ * @param old The previous overlay with the same size, or NULL to repaint
+ *            every cell.
+ *
+ * Each overlay pixel is one cell. With a previous overlay only the runs of
+ * cells that differ are painted; the rest of the surface is kept.
+ *
+ * @return TRUE if anything was painted.
+ */
+static gboolean paint_overlay(GtkSatMap * satmap, GdkPixbuf * old)
+{
+    cairo_t        *cr;
+    const guchar   *np, *op;
+    gint            ow = gdk_pixbuf_get_width(satmap->overlay);
+    gint            oh = gdk_pixbuf_get_height(satmap->overlay);
+    gint            nch = gdk_pixbuf_get_n_channels(satmap->overlay);
+    gint            r, c, c0;
+    gboolean        any = (old == NULL);
+
+    cr = cairo_create(satmap->overlaysurf);
+    cairo_set_antialias(cr, CAIRO_ANTIALIAS_NONE);
+    cairo_scale(cr, cairo_image_surface_get_width(satmap->overlaysurf) /
+                (gdouble) ow,
+                cairo_image_surface_get_height(satmap->overlaysurf) /
+                (gdouble) oh);
+
+    for (r = 0; old != NULL && r < oh; r++)
+    {
+        np = gdk_pixbuf_get_pixels(satmap->overlay) +
+            r * gdk_pixbuf_get_rowstride(satmap->overlay);
+        op = gdk_pixbuf_get_pixels(old) + r * gdk_pixbuf_get_rowstride(old);
+
+        for (c = 0; c < ow;)
+        {
+            if (memcmp(np + c * nch, op + c * nch, nch) == 0)
+            {
+                c++;
+                continue;
+            }
+            for (c0 = c; c < ow && memcmp(np + c * nch, op + c * nch, nch);)
+                c++;
+            cairo_rectangle(cr, c0, r, c - c0, 1);
+            any = TRUE;
+        }
+    }
+
+    if (any)
+    {
+        if (old != NULL)
+            cairo_clip(cr);
+        cairo_set_operator(cr, CAIRO_OPERATOR_SOURCE);
+        gdk_cairo_set_source_pixbuf(cr, satmap->overlay, 0, 0);
+        cairo_pattern_set_filter(cairo_get_source(cr), CAIRO_FILTER_NEAREST);
+        cairo_paint(cr);
+    }
+    cairo_destroy(cr);
+
+    return any;
+}
+
+/**
+ * Fit the raster overlay to the current map geometry.
+ *
+ * The overlay is only rescaled when the map size changes; a new centre
+ * longitude just moves the wrap point like the background map. Nearest-
+ * neighbour scaling keeps the grid cells crisp.
+ */
+static void update_overlay(GtkSatMap * satmap)
+{
+    gint            w = (gint) satmap->width;
+    gint            h = (gint) satmap->height;
+
+    if (satmap->overlay == NULL || satmap->overlayimg == NULL ||
+        w <= 0 || h <= 0)
+        return;
+
+    if (satmap->overlaysurf == NULL ||
+        cairo_image_surface_get_width(satmap->overlaysurf) != w ||
+        cairo_image_surface_get_height(satmap->overlaysurf) != h)
+    {
+        if (satmap->overlaysurf)
+            cairo_surface_destroy(satmap->overlaysurf);
+        satmap->overlaysurf =
+            cairo_image_surface_create(CAIRO_FORMAT_ARGB32, w, h);
+        paint_overlay(satmap, NULL);
+    }
+
+    set_wrapped_parts(satmap, satmap->overlaysurf, satmap->overlaypart);
+}
+
+/**
+ * Set or clear a raster overlay.
+ *
+ * @param satmap The GtkSatMap widget.
+ * @param overlay Pixbuf covering the whole Earth with column 0 at -180 deg
+ *                longitude and row 0 at +90 deg latitude; usually with an
+ *                alpha channel. NULL removes the overlay.
+ *
+ * The overlay is drawn just above the background map and follows resizes.
+ * When the new overlay has the same layout as the previous one, only the
+ * cells that changed are repainted.
+ */
+void gtk_sat_map_set_overlay(GtkWidget * satmap, GdkPixbuf * overlay)
+{
+    GtkSatMap      *m = GTK_SAT_MAP(satmap);
+    GooCanvasItemModel *root;
+    GdkPixbuf      *old = m->overlay;
+    gint            idx;
+
+    root = goo_canvas_get_root_item_model(GOO_CANVAS(m->canvas));
+    m->overlay = NULL;
+
+    if (overlay == NULL)
+    {
+        if (m->overlayimg)
+        {
+            idx = goo_canvas_item_model_find_child(root, m->overlayimg);
+            if (idx != -1)
+                goo_canvas_item_model_remove_child(root, idx);
+            m->overlayimg = NULL;
+            m->overlaypart[0] = NULL;
+            m->overlaypart[1] = NULL;
+        }
+        if (m->overlaysurf)
+        {
+            cairo_surface_destroy(m->overlaysurf);
+            m->overlaysurf = NULL;
+        }
+        if (old)
+            g_object_unref(old);
+        return;
+    }
+
+    m->overlay = g_object_ref(overlay);
+    if (m->overlayimg == NULL)
+    {
+        m->overlayimg = goo_canvas_group_model_new(root, NULL);
+        m->overlaypart[0] = goo_canvas_image_model_new(m->overlayimg, NULL,
+                                                       0, 0, NULL);
+        m->overlaypart[1] = goo_canvas_image_model_new(m->overlayimg, NULL,
+                                                       0, 0, NULL);
+        goo_canvas_item_model_raise(m->overlayimg, m->map);
+    }
+
+    if (m->overlaysurf != NULL && old != NULL &&
+        gdk_pixbuf_get_width(old) == gdk_pixbuf_get_width(overlay) &&
+        gdk_pixbuf_get_height(old) == gdk_pixbuf_get_height(overlay) &&
+        gdk_pixbuf_get_n_channels(old) == gdk_pixbuf_get_n_channels(overlay))
+    {
+        if (paint_overlay(m, old))
+            set_wrapped_parts(m, m->overlaysurf, m->overlaypart);
+    }
+    else
+    {
+        if (m->overlaysurf)
+        {
+            cairo_surface_destroy(m->overlaysurf);
+            m->overlaysurf = NULL;
+        }
+        update_overlay(m);
+    }
+
+    if (old)
+        g_object_unref(old);
+}
+
 static void on_canvas_realized(GtkWidget * canvas, gpointer data)
 {
     GtkSatMap      *satmap = GTK_SAT_MAP(data);
@@ -613,6 +913,39 @@ static void on_canvas_realized(GtkWidget * canvas, gpointer data)
     goo_canvas_item_model_raise(satmap->curs, NULL);
 }
 
+/**
+ * Update all satellites.
+ *
+ * Decayed satellites that are not on the map are skipped from the state
+ * table without touching their sat_t.
+ */
+static void update_sats(GtkSatMap * satmap)
+{
+    const sat_state_t *st;
+    gint            catnr;
+    guint           i;
+
+    if (satmap->table == NULL)
+    {
+        g_hash_table_foreach(satmap->sats, update_sat, satmap);
+        return;
+    }
+
+    for (i = 0; i < SAT_TABLE_LEN(satmap->table); i++)
+    {
+        st = SAT_TABLE_STATE(satmap->table, i);
+
+        if (st->flags & SAT_STATE_DECAYED)
+        {
+            catnr = st->catnr;
+            if (g_hash_table_lookup(satmap->obj, &catnr) == NULL)
+                continue;
+        }
+
+        update_sat(NULL, SAT_TABLE_SAT(satmap->table, i), satmap);
+    }
+}
+
 /* Update the GtkSatMap widget. Called periodically from GtkSatModule. */
 void gtk_sat_map_update(GtkWidget * widget)
 {
@@ -669,7 +1002,7 @@ void gtk_sat_map_update(GtkWidget * widget)
                      "x", (gdouble) satmap->x0 + 2,
                      "y", (gdouble) satmap->y0 + 1, NULL);
 
-        g_hash_table_foreach(satmap->sats, update_sat, satmap);
+        update_sats(satmap);
 
         /* Update the Solar Terminator if necessary */
         if (satmap->show_terminator &&
@@ -1063,13 +1396,15 @@ void gtk_sat_map_select_sat(GtkWidget * satmap, gint catnum)
  * Reconfigure map.
  *
  * This function should eventually reload all configuration for the GtkSatMap.
- * Currently this function is not implemented for any of the views. Reconfiguration
- * is done by recreating the whole module.
+ * Currently only the centre longitude is applied; other changes still need
+ * the module to be recreated.
  */
 void gtk_sat_map_reconf(GtkWidget * widget, GKeyFile * cfgdat)
 {
-    (void)widget;
-    (void)cfgdat;
+    gtk_sat_map_set_center(widget, mod_cfg_get_int(cfgdat,
+                                                   MOD_CFG_MAP_SECTION,
+                                                   MOD_CFG_MAP_CENTER,
+                                                   SAT_CFG_INT_MAP_CENTER));
 }
 
 /*
@@ -1155,23 +1490,12 @@ static void load_map_file(GtkSatMap * satmap, float clon)
         gdk_pixbuf_fill(tmpbuf, 0x0F0F0F0F);
     }
 
-    /* create a blank map with same parameters as tmpbuf */
-    satmap->origmap = gdk_pixbuf_new(GDK_COLORSPACE_RGB,
-                                     FALSE,
-                                     gdk_pixbuf_get_bits_per_sample(tmpbuf),
-                                     gdk_pixbuf_get_width(tmpbuf),
-                                     gdk_pixbuf_get_height(tmpbuf));
-
-    map_tools_shift_center(tmpbuf, satmap->origmap, clon);
-    g_object_unref(tmpbuf);
+    /* the map stays centred on 0 deg; update_map_image() wraps it */
+    satmap->origmap = tmpbuf;
     g_free(mapfile);
 
     /* Calculate longitude at the left side (-180 deg if center is at 0 deg longitude) */
-    satmap->left_side_lon = -180.0;
-    if (clon > 0.0)
-        satmap->left_side_lon += clon;
-    else if (clon < 0.0)
-        satmap->left_side_lon = 180.0 + clon;
+    satmap->left_side_lon = map_left_lon(CLAMP(clon, -180.0, 180.0));
 }
 
 static gdouble arccos(gdouble x, gdouble y)
@@ -2750,6 +3074,22 @@ void gtk_sat_map_reload_sats(GtkWidget * satmap, GHashTable * sats)
     g_hash_table_foreach(GTK_SAT_MAP(satmap)->obj, reset_ground_track, NULL);
 }
 
+/** Drop the derived data of a satellite whose elements have changed. */
+void gtk_sat_map_reload_sat(GtkWidget * widget, sat_t * sat)
+{
+    GtkSatMap      *satmap = GTK_SAT_MAP(widget);
+    sat_map_obj_t  *obj;
+
+    /* next event may belong to this satellite */
+    satmap->naos = 0.0;
+    satmap->ncat = 0;
+
+    /* recalculate the ground track on the next update */
+    obj = SAT_MAP_OBJ(g_hash_table_lookup(satmap->obj, &sat->tle.catnr));
+    if (obj != NULL)
+        obj->track_orbit = 0;
+}
+
 static void reset_ground_track(gpointer key, gpointer value,
                                gpointer user_data)
 {
@@ -2777,6 +3117,10 @@ static gchar   *aoslos_time_to_str(GtkSatMap * satmap, sat_t * sat)
         number = sat->aos - now;
     }
 
+    /* not found yet by the event sweep of the module */
+    if (number < 0.0)
+        return g_strdup("");
+
     /* convert julian date to seconds */
     s = (guint) (number * 86400);
 
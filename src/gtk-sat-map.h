@@ -8,6 +8,7 @@
 #include <gtk/gtk.h>
 
 #include "gtk-sat-data.h"
+#include "sat-table.h"
 
 /* *INDENT-OFF* */
 #ifdef __cplusplus
@@ -80,7 +81,7 @@ typedef struct {
 
     GtkWidget      *canvas;     /*!< The canvas widget. */
 
-    GooCanvasItemModel *map;    /*!< The canvas map item. */
+    GooCanvasItemModel *map;    /*!< Group holding the map images. */
 
     gdouble         left_side_lon;      /*!< Left-most longitude (used when center is not 0 lon). */
 
@@ -105,6 +106,7 @@ typedef struct {
     gint            ncat;       /*!< Next event catnum. */
 
     gdouble         tstamp;     /*!< Time stamp for calculations; set by GtkSatModule */
+    sat_table_t    *table;      /*!< Per-tick satellite state; set by GtkSatModule */
 
     GKeyFile       *cfgdata;    /*!< Module configuration data. */
     GHashTable     *sats;       /*!< Pointer to satellites (owned by parent GtkSatModule). */
@@ -133,6 +135,13 @@ typedef struct {
     gchar          *infobgd;    /*!< Background color of info text. */
 
     GdkPixbuf      *origmap;    /*!< Original map kept here for high quality scaling. */
+    cairo_surface_t *mapsurf;   /*!< origmap scaled to width x height, centred on 0 deg. */
+    GooCanvasItemModel *mapimg[2];      /*!< Left and wrapped right part of the map. */
+
+    GdkPixbuf      *overlay;    /*!< Lat/lon raster overlay, e.g. coverage heat map. */
+    cairo_surface_t *overlaysurf;       /*!< overlay scaled to width x height, from -180 deg. */
+    GooCanvasItemModel *overlayimg;     /*!< Group holding the overlay parts. */
+    GooCanvasItemModel *overlaypart[2]; /*!< Left and wrapped right part of the overlay. */
 
 } GtkSatMap;
 
@@ -150,7 +159,11 @@ void            gtk_sat_map_lonlat_to_xy(GtkSatMap * m,
                                          gdouble * x, gdouble * y);
 
 void            gtk_sat_map_reload_sats(GtkWidget * satmap, GHashTable * sats);
+void            gtk_sat_map_reload_sat(GtkWidget * satmap, sat_t * sat);
 void            gtk_sat_map_select_sat(GtkWidget * satmap, gint catnum);
+void            gtk_sat_map_set_overlay(GtkWidget * satmap,
+                                        GdkPixbuf * overlay);
+void            gtk_sat_map_set_center(GtkWidget * satmap, gdouble clon);
 
 /* *INDENT-OFF* */
 #ifdef __cplusplus
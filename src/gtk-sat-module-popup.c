@@ -25,6 +25,7 @@
 #include <glib/gi18n.h>
 #include <glib/gstdio.h>
 #include <gtk/gtk.h>
+#include <math.h>
 #include <string.h>		// strerror
 
 #include "compat.h"
@@ -34,9 +35,12 @@
 #include "gtk-rot-ctrl.h"
 #include "gtk-sat-module.h"
 #include "gtk-sat-module-popup.h"
+#include "gtk-sat-map.h"
 #include "gtk-sat-module-tmg.h"
 #include "gtk-sky-glance.h"
 #include "mod-mgr.h"
+#include "pass-report.h"
+#include "qth-route.h"
 #include "sat-cfg.h"
 #include "sat-log.h"
 #include "sgpsdp/sgp4sdp4.h"
@@ -762,6 +766,477 @@ static void tmgr_cb(GtkWidget * menuitem, gpointer data)
     tmg_create(module);
 }
 
+/**
+ * Convert access counts into an RGBA heat map.
+ *
+ * Cells that are never accessed stay transparent; the others go from blue
+ * (few accesses) to red (most accesses).
+ */
+static GdkPixbuf *coverage_heat_map(const cov_grid_t * grid)
+{
+    GdkPixbuf      *pbuf;
+    guchar         *pixels;
+    gint            rowstride;
+    guint32         vmax = 1;
+    guint           r, c;
+
+    for (r = 0; r < grid->nrows * grid->ncols; r++)
+        vmax = MAX(vmax, grid->cells[r].count);
+
+    pbuf = gdk_pixbuf_new(GDK_COLORSPACE_RGB, TRUE, 8,
+                          grid->ncols, grid->nrows);
+    pixels = gdk_pixbuf_get_pixels(pbuf);
+    rowstride = gdk_pixbuf_get_rowstride(pbuf);
+
+    for (r = 0; r < grid->nrows; r++)
+    {
+        for (c = 0; c < grid->ncols; c++)
+        {
+            const cov_stat_t *s = &grid->cells[r * grid->ncols + c];
+            guchar         *p = pixels + r * rowstride + c * 4;
+            gdouble         v = (gdouble) s->count / vmax;
+
+            p[0] = (guchar) (255.0 * v);
+            p[1] = (guchar) (255.0 * (1.0 - fabs(2.0 * v - 1.0)));
+            p[2] = (guchar) (255.0 * (1.0 - v));
+            p[3] = s->count ? 0x80 : 0x00;
+        }
+    }
+
+    return pbuf;
+}
+
+/** Apply (or clear) the coverage overlay on every map view. */
+static void coverage_apply(GtkSatModule * module)
+{
+    GdkPixbuf      *pbuf = NULL;
+    GSList         *l;
+
+    if (module->coverage)
+        pbuf = coverage_heat_map(module->coverage);
+
+    for (l = module->views; l != NULL; l = l->next)
+    {
+        if (IS_GTK_SAT_MAP(l->data))
+            gtk_sat_map_set_overlay(GTK_WIDGET(l->data), pbuf);
+    }
+
+    if (pbuf)
+        g_object_unref(pbuf);
+}
+
+static void coverage_done(GObject * source, GAsyncResult * res, gpointer data)
+{
+    GtkSatModule   *module = GTK_SAT_MODULE(data);
+    cov_grid_t     *grid;
+    GError         *err = NULL;
+    guint           i, covered = 0;
+    guint32         worst = 0;
+
+    (void)source;
+
+    grid = coverage_run_finish(res, &err);
+    if (grid == NULL)
+    {
+        if (!g_error_matches(err, G_IO_ERROR, G_IO_ERROR_CANCELLED))
+        {
+            sat_log_log(SAT_LOG_LEVEL_ERROR,
+                        _("%s: Coverage analysis failed: %s"), __func__,
+                        err ? err->message : "");
+            g_clear_object(&module->covCancel);
+        }
+        g_clear_error(&err);
+        g_object_unref(module);
+        return;
+    }
+    g_clear_object(&module->covCancel);
+
+    for (i = 0; i < grid->nrows * grid->ncols; i++)
+    {
+        if (grid->cells[i].count)
+            covered++;
+        worst = MAX(worst, grid->cells[i].max_gap);
+    }
+    sat_log_log(SAT_LOG_LEVEL_INFO,
+                _("%s: %s: %u of %u cells accessed, max revisit gap %.0f s"),
+                __func__, module->name, covered, grid->nrows * grid->ncols,
+                cov_gap_to_sec(grid, worst));
+
+    for (i = 0; i < grid->territories->len; i++)
+        sat_log_log(SAT_LOG_LEVEL_DEBUG,
+                    _("%s: %s: %u accesses, max gap %.0f s"), __func__,
+                    (const gchar *)g_ptr_array_index(grid->territories, i),
+                    grid->terr[i].count,
+                    cov_gap_to_sec(grid, grid->terr[i].max_gap));
+
+    if (module->coverage)
+        cov_grid_free(module->coverage);
+    module->coverage = grid;
+    coverage_apply(module);
+
+    g_object_unref(module);
+}
+
+/**
+ * Start a coverage analysis.
+ *
+ * Analyses the next 24 hours from the current module time in the background
+ * and shows the access counts as a heat map on the map views.
+ */
+static void coverage_cb(GtkWidget * menuitem, gpointer data)
+{
+    GtkSatModule   *module = GTK_SAT_MODULE(data);
+    cov_params_t    params;
+
+    (void)menuitem;
+
+    if (module->covCancel)
+    {
+        sat_log_log(SAT_LOG_LEVEL_INFO,
+                    _("%s: Coverage analysis already running for %s"),
+                    __func__, module->name);
+        return;
+    }
+
+    cov_params_init(&params, module->tmgCdnum);
+    module->covCancel = g_cancellable_new();
+
+    g_mutex_lock(&module->busy);
+    coverage_run_async(module->satellites, &params, module->covCancel,
+                       coverage_done, g_object_ref(module));
+    g_mutex_unlock(&module->busy);
+}
+
+/**
+ * Save the last coverage results.
+ *
+ * The "territories" object data on the menu item selects the per-territory
+ * CSV instead of the binary grid.
+ */
+static void coverage_export_cb(GtkWidget * menuitem, gpointer data)
+{
+    GtkSatModule   *module = GTK_SAT_MODULE(data);
+    GtkWidget      *dialog;
+    gchar          *fname;
+    GError         *err = NULL;
+    gboolean        terr;
+    gboolean        ok;
+
+    if (module->coverage == NULL)
+        return;
+
+    terr = GPOINTER_TO_INT(g_object_get_data(G_OBJECT(menuitem),
+                                             "territories"));
+
+    dialog = gtk_file_chooser_dialog_new(terr ?
+                                         _("Export Territory Coverage") :
+                                         _("Export Coverage Grid"),
+                                         GTK_WINDOW(app),
+                                         GTK_FILE_CHOOSER_ACTION_SAVE,
+                                         "_Cancel", GTK_RESPONSE_CANCEL,
+                                         "_Save", GTK_RESPONSE_ACCEPT, NULL);
+    gtk_file_chooser_set_do_overwrite_confirmation(GTK_FILE_CHOOSER(dialog),
+                                                   TRUE);
+    fname = g_strconcat(module->name, terr ? "-territories.csv" :
+                        "-coverage.bin", NULL);
+    gtk_file_chooser_set_current_name(GTK_FILE_CHOOSER(dialog), fname);
+    g_free(fname);
+
+    if (gtk_dialog_run(GTK_DIALOG(dialog)) == GTK_RESPONSE_ACCEPT)
+    {
+        fname = gtk_file_chooser_get_filename(GTK_FILE_CHOOSER(dialog));
+        if (terr)
+            ok = cov_grid_save_territories(module->coverage, fname, &err);
+        else
+            ok = cov_grid_save(module->coverage, fname, &err);
+        if (!ok)
+        {
+            sat_log_log(SAT_LOG_LEVEL_ERROR,
+                        _("%s: Could not save %s (%s)"), __func__, fname,
+                        err->message);
+            g_clear_error(&err);
+        }
+        g_free(fname);
+    }
+    gtk_widget_destroy(dialog);
+}
+
+/** Remove the coverage overlay and drop the results. */
+static void coverage_clear_cb(GtkWidget * menuitem, gpointer data)
+{
+    GtkSatModule   *module = GTK_SAT_MODULE(data);
+
+    (void)menuitem;
+
+    if (module->coverage)
+    {
+        cov_grid_free(module->coverage);
+        module->coverage = NULL;
+    }
+    coverage_apply(module);
+}
+
+/** Replace the route of the module and redo its route-aware predictions. */
+static void route_set(GtkSatModule * module, qth_route_t * route)
+{
+    qth_route_free(module->qth->route);
+    module->qth->route = route;
+
+    module->event_count = 0;    /* recompute AOS/LOS on the next tick */
+    if (module->skg)
+        module->lastSkgUpd = 0.0;       /* and the sky at a glance */
+}
+
+/**
+ * Load a planned route for the ground station.
+ *
+ * Pass predictions of the module then follow the observer along the route.
+ */
+static void route_load_cb(GtkWidget * menuitem, gpointer data)
+{
+    GtkSatModule   *module = GTK_SAT_MODULE(data);
+    GtkWidget      *dialog;
+    qth_route_t    *route;
+    gchar          *fname;
+    GError         *err = NULL;
+
+    (void)menuitem;
+
+    dialog = gtk_file_chooser_dialog_new(_("Load Route"),
+                                         GTK_WINDOW(app),
+                                         GTK_FILE_CHOOSER_ACTION_OPEN,
+                                         "_Cancel", GTK_RESPONSE_CANCEL,
+                                         "_Open", GTK_RESPONSE_ACCEPT, NULL);
+
+    if (gtk_dialog_run(GTK_DIALOG(dialog)) == GTK_RESPONSE_ACCEPT)
+    {
+        fname = gtk_file_chooser_get_filename(GTK_FILE_CHOOSER(dialog));
+        gtk_widget_destroy(dialog);
+
+        route = qth_route_load_file(fname, &err);
+        if (route == NULL)
+        {
+            sat_log_log(SAT_LOG_LEVEL_ERROR,
+                        _("%s: Could not load route %s (%s)"), __func__,
+                        fname, err->message);
+
+            dialog = gtk_message_dialog_new(GTK_WINDOW(app),
+                                            GTK_DIALOG_MODAL |
+                                            GTK_DIALOG_DESTROY_WITH_PARENT,
+                                            GTK_MESSAGE_ERROR,
+                                            GTK_BUTTONS_CLOSE,
+                                            _("Could not load %s\n\n%s"),
+                                            fname, err->message);
+            gtk_dialog_run(GTK_DIALOG(dialog));
+            gtk_widget_destroy(dialog);
+            g_clear_error(&err);
+        }
+        else
+        {
+            route_set(module, route);
+        }
+        g_free(fname);
+    }
+    else
+    {
+        gtk_widget_destroy(dialog);
+    }
+}
+
+/** Go back to predictions for the fixed ground station. */
+static void route_clear_cb(GtkWidget * menuitem, gpointer data)
+{
+    GtkSatModule   *module = GTK_SAT_MODULE(data);
+
+    (void)menuitem;
+
+    route_set(module, NULL);
+}
+
+/** State of a running pass report. */
+typedef struct {
+    GtkWidget      *dialog;     /* progress dialog */
+    GtkWidget      *bar;
+    GCancellable   *cancel;
+    gchar          *fname;
+} PassReportCtx;
+
+static void pass_report_progress(guint done, guint total, gpointer data)
+{
+    PassReportCtx  *ctx = data;
+    gchar          *text;
+
+    gtk_progress_bar_set_fraction(GTK_PROGRESS_BAR(ctx->bar),
+                                  total ? (gdouble) done / total : 1.0);
+    text = g_strdup_printf(_("%u of %u satellites"), done, total);
+    gtk_progress_bar_set_text(GTK_PROGRESS_BAR(ctx->bar), text);
+    g_free(text);
+}
+
+static void pass_report_done(GObject * source, GAsyncResult * res,
+                             gpointer data)
+{
+    PassReportCtx  *ctx = data;
+    GtkWidget      *dialog;
+    gchar          *report;
+    GError         *err = NULL;
+
+    (void)source;
+
+    report = pass_report_run_finish(res, &err);
+    if (report != NULL)
+        g_file_set_contents(ctx->fname, report, -1, &err);
+
+    if (err != NULL && !g_error_matches(err, G_IO_ERROR, G_IO_ERROR_CANCELLED))
+    {
+        sat_log_log(SAT_LOG_LEVEL_ERROR, _("%s: Could not save %s (%s)"),
+                    __func__, ctx->fname, err->message);
+        dialog = gtk_message_dialog_new(GTK_WINDOW(app),
+                                        GTK_DIALOG_MODAL |
+                                        GTK_DIALOG_DESTROY_WITH_PARENT,
+                                        GTK_MESSAGE_ERROR, GTK_BUTTONS_CLOSE,
+                                        _("Could not save %s\n\n%s"),
+                                        ctx->fname, err->message);
+        gtk_dialog_run(GTK_DIALOG(dialog));
+        gtk_widget_destroy(dialog);
+    }
+    else if (err == NULL)
+    {
+        sat_log_log(SAT_LOG_LEVEL_INFO, _("%s: Pass report written to %s"),
+                    __func__, ctx->fname);
+    }
+    g_clear_error(&err);
+    g_free(report);
+
+    gtk_widget_destroy(ctx->dialog);
+    g_object_unref(ctx->cancel);
+    g_free(ctx->fname);
+    g_free(ctx);
+}
+
+/* Cancel button or window closed; pass_report_done() cleans up. */
+static void pass_report_response(GtkDialog * dialog, gint response,
+                                 gpointer data)
+{
+    PassReportCtx  *ctx = data;
+
+    (void)dialog;
+    (void)response;
+
+    g_cancellable_cancel(ctx->cancel);
+}
+
+/**
+ * Generate a pass report for all satellites of the module.
+ *
+ * Asks for the horizon, format and file, then predicts and renders the
+ * passes in the background while a progress dialog is shown.
+ */
+static void pass_report_cb(GtkWidget * menuitem, gpointer data)
+{
+    GtkSatModule   *module = GTK_SAT_MODULE(data);
+    GtkWidget      *dialog;
+    GtkWidget      *grid;
+    GtkWidget      *label;
+    GtkWidget      *days;
+    GtkWidget      *format;
+    GtkWidget      *details;
+    GtkWidget      *area;
+    PassReportCtx  *ctx;
+    pass_report_params_t params;
+    gchar          *fname;
+
+    (void)menuitem;
+
+    pass_report_params_init(&params, module->tmgCdnum);
+
+    dialog = gtk_file_chooser_dialog_new(_("Save Pass Report"),
+                                         GTK_WINDOW(app),
+                                         GTK_FILE_CHOOSER_ACTION_SAVE,
+                                         "_Cancel", GTK_RESPONSE_CANCEL,
+                                         "_Save", GTK_RESPONSE_ACCEPT, NULL);
+    gtk_file_chooser_set_do_overwrite_confirmation(GTK_FILE_CHOOSER(dialog),
+                                                   TRUE);
+    fname = g_strconcat(module->name, "-passes.txt", NULL);
+    gtk_file_chooser_set_current_name(GTK_FILE_CHOOSER(dialog), fname);
+    g_free(fname);
+
+    grid = gtk_grid_new();
+    gtk_grid_set_column_spacing(GTK_GRID(grid), 10);
+    gtk_grid_set_row_spacing(GTK_GRID(grid), 5);
+
+    label = gtk_label_new(_("Days:"));
+    gtk_grid_attach(GTK_GRID(grid), label, 0, 0, 1, 1);
+    days = gtk_spin_button_new_with_range(1, 30, 1);
+    gtk_spin_button_set_value(GTK_SPIN_BUTTON(days), params.duration);
+    gtk_grid_attach(GTK_GRID(grid), days, 1, 0, 1, 1);
+
+    label = gtk_label_new(_("Format:"));
+    gtk_grid_attach(GTK_GRID(grid), label, 2, 0, 1, 1);
+    format = gtk_combo_box_text_new();
+    gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(format),
+                                   _("Plain text"));
+    gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(format), "CSV");
+    gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(format), "JSON");
+    gtk_combo_box_set_active(GTK_COMBO_BOX(format), params.format);
+    gtk_grid_attach(GTK_GRID(grid), format, 3, 0, 1, 1);
+
+    details = gtk_check_button_new_with_label(_("Include pass details"));
+    gtk_grid_attach(GTK_GRID(grid), details, 4, 0, 1, 1);
+
+    gtk_widget_show_all(grid);
+    gtk_file_chooser_set_extra_widget(GTK_FILE_CHOOSER(dialog), grid);
+
+    if (gtk_dialog_run(GTK_DIALOG(dialog)) != GTK_RESPONSE_ACCEPT)
+    {
+        gtk_widget_destroy(dialog);
+        return;
+    }
+
+    params.duration =
+        gtk_spin_button_get_value(GTK_SPIN_BUTTON(days));
+    params.format = gtk_combo_box_get_active(GTK_COMBO_BOX(format));
+    params.details =
+        gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(details));
+
+    ctx = g_new0(PassReportCtx, 1);
+    fname = gtk_file_chooser_get_filename(GTK_FILE_CHOOSER(dialog));
+    if (g_str_has_suffix(fname, pass_report_extension(params.format)))
+        ctx->fname = fname;
+    else
+    {
+        ctx->fname = g_strconcat(fname, pass_report_extension(params.format),
+                                 NULL);
+        g_free(fname);
+    }
+    gtk_widget_destroy(dialog);
+
+    /* progress dialog */
+    ctx->cancel = g_cancellable_new();
+    ctx->dialog = gtk_dialog_new_with_buttons(_("Pass Report"),
+                                              GTK_WINDOW(app),
+                                              GTK_DIALOG_DESTROY_WITH_PARENT,
+                                              "_Cancel", GTK_RESPONSE_CANCEL,
+                                              NULL);
+    ctx->bar = gtk_progress_bar_new();
+    gtk_progress_bar_set_show_text(GTK_PROGRESS_BAR(ctx->bar), TRUE);
+    area = gtk_dialog_get_content_area(GTK_DIALOG(ctx->dialog));
+    gtk_container_set_border_width(GTK_CONTAINER(area), 10);
+    gtk_box_pack_start(GTK_BOX(area), ctx->bar, TRUE, TRUE, 0);
+    g_signal_connect(ctx->dialog, "response",
+                     G_CALLBACK(pass_report_response), ctx);
+    g_signal_connect(ctx->dialog, "delete-event",
+                     G_CALLBACK(gtk_true), NULL);
+    gtk_widget_show_all(ctx->dialog);
+    pass_report_progress(0, g_hash_table_size(module->satellites), ctx);
+
+    g_mutex_lock(&module->busy);
+    pass_report_run_async(module->satellites, module->qth, &params,
+                          ctx->cancel, pass_report_progress, ctx,
+                          pass_report_done, ctx);
+    g_mutex_unlock(&module->busy);
+}
+
 /**
  * Destroy radio control window.
  *
@@ -1184,6 +1659,47 @@ void gtk_sat_module_popup(GtkSatModule * module)
     gtk_menu_shell_append(GTK_MENU_SHELL(menu), menuitem);
     g_signal_connect(menuitem, "activate", G_CALLBACK(tmgr_cb), module);
 
+    /* coverage statistics */
+    menuitem = gtk_menu_item_new_with_label(_("Coverage statistics (24h)"));
+    gtk_menu_shell_append(GTK_MENU_SHELL(menu), menuitem);
+    gtk_widget_set_sensitive(menuitem, module->covCancel == NULL);
+    g_signal_connect(menuitem, "activate", G_CALLBACK(coverage_cb), module);
+
+    menuitem = gtk_menu_item_new_with_label(_("Export coverage grid..."));
+    gtk_menu_shell_append(GTK_MENU_SHELL(menu), menuitem);
+    gtk_widget_set_sensitive(menuitem, module->coverage != NULL);
+    g_signal_connect(menuitem, "activate",
+                     G_CALLBACK(coverage_export_cb), module);
+
+    menuitem =
+        gtk_menu_item_new_with_label(_("Export territory coverage..."));
+    gtk_menu_shell_append(GTK_MENU_SHELL(menu), menuitem);
+    gtk_widget_set_sensitive(menuitem, module->coverage != NULL);
+    g_object_set_data(G_OBJECT(menuitem), "territories", GINT_TO_POINTER(1));
+    g_signal_connect(menuitem, "activate",
+                     G_CALLBACK(coverage_export_cb), module);
+
+    menuitem = gtk_menu_item_new_with_label(_("Clear coverage overlay"));
+    gtk_menu_shell_append(GTK_MENU_SHELL(menu), menuitem);
+    gtk_widget_set_sensitive(menuitem, module->coverage != NULL);
+    g_signal_connect(menuitem, "activate",
+                     G_CALLBACK(coverage_clear_cb), module);
+
+    /* pass report */
+    menuitem = gtk_menu_item_new_with_label(_("Pass report..."));
+    gtk_menu_shell_append(GTK_MENU_SHELL(menu), menuitem);
+    g_signal_connect(menuitem, "activate", G_CALLBACK(pass_report_cb), module);
+
+    /* planned route of a mobile ground station */
+    menuitem = gtk_menu_item_new_with_label(_("Load route..."));
+    gtk_menu_shell_append(GTK_MENU_SHELL(menu), menuitem);
+    g_signal_connect(menuitem, "activate", G_CALLBACK(route_load_cb), module);
+
+    menuitem = gtk_menu_item_new_with_label(_("Clear route"));
+    gtk_menu_shell_append(GTK_MENU_SHELL(menu), menuitem);
+    gtk_widget_set_sensitive(menuitem, module->qth->route != NULL);
+    g_signal_connect(menuitem, "activate", G_CALLBACK(route_clear_cb), module);
+
     /* separator */
     menuitem = gtk_separator_menu_item_new();
     gtk_menu_shell_append(GTK_MENU_SHELL(menu), menuitem);
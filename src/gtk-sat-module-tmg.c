@@ -35,6 +35,7 @@ static void     tmg_stop(GtkWidget * widget, gpointer data);
 static void     tmg_fwd(GtkWidget * widget, gpointer data);
 static void     tmg_bwd(GtkWidget * widget, gpointer data);
 static void     tmg_reset(GtkWidget * widget, gpointer data);
+static void     tmg_simulate(GtkWidget * widget, gpointer data);
 static void     tmg_throttle(GtkWidget * widget, gpointer data);
 static void     tmg_time_set(GtkWidget * widget, gpointer data);
 static void     slider_moved(GtkWidget * widget, gpointer data);
@@ -130,6 +131,15 @@ void tmg_create(GtkSatModule * mod)
     g_signal_connect(mod->tmgReset, "clicked", G_CALLBACK(tmg_reset), mod);
     gtk_box_pack_end(GTK_BOX(hbox), mod->tmgReset, FALSE, FALSE, 10);
 
+    /* precompute events */
+    mod->tmgSim = gtk_button_new_with_label(_("Simulate 24h"));
+    gtk_widget_set_tooltip_text(mod->tmgSim,
+                                _("Precompute all events of the next 24 hours "
+                                  "so that they are not missed at high "
+                                  "throttle values"));
+    g_signal_connect(mod->tmgSim, "clicked", G_CALLBACK(tmg_simulate), mod);
+    gtk_box_pack_end(GTK_BOX(hbox), mod->tmgSim, FALSE, FALSE, 0);
+
     /* status label */
     mod->tmgState = gtk_label_new(NULL);
     g_object_set(mod->tmgState, "xalign", 0.0, "yalign", 0.5, NULL);
@@ -227,7 +237,7 @@ void tmg_create(GtkSatModule * mod)
     label = gtk_label_new(_("Throttle:"));
     g_object_set(label, "xalign", 1.0, "yalign", 0.5, NULL);
     gtk_grid_attach(GTK_GRID(table), label, 1, 4, 1, 1);
-    mod->tmgFactor = gtk_spin_button_new_with_range(1, 100, 1);
+    mod->tmgFactor = gtk_spin_button_new_with_range(1, 10000, 1);
     gtk_spin_button_set_numeric(GTK_SPIN_BUTTON(mod->tmgFactor), TRUE);
     gtk_spin_button_set_update_policy(GTK_SPIN_BUTTON(mod->tmgFactor),
                                       GTK_UPDATE_IF_VALID);
@@ -312,6 +322,13 @@ static void tmg_destroy(GtkWidget * tmg, gpointer data)
     mod->throttle = 1;
     mod->tmgActive = FALSE;
 
+    /* the timeline is kept but a running precomputation is not needed */
+    if (mod->simCancel)
+    {
+        g_cancellable_cancel(mod->simCancel);
+        g_clear_object(&mod->simCancel);
+    }
+
     /* reset time */
     tmg_reset(NULL, data);
 
@@ -424,6 +441,79 @@ static void tmg_reset(GtkWidget * widget, gpointer data)
     mod->reset = FALSE;
 }
 
+/** Simulation finished; install the new timeline. */
+static void tmg_simulate_done(GObject * source, GAsyncResult * res,
+                              gpointer data)
+{
+    GtkSatModule   *mod = GTK_SAT_MODULE(data);
+    sim_timeline_t *tl;
+    GError         *err = NULL;
+
+    (void)source;
+
+    tl = sim_engine_run_finish(res, &err);
+    if (tl == NULL)
+    {
+        /* on cancellation the canceller has already dropped simCancel */
+        if (!g_error_matches(err, G_IO_ERROR, G_IO_ERROR_CANCELLED))
+        {
+            sat_log_log(SAT_LOG_LEVEL_ERROR,
+                        _("%s: Simulation failed: %s"), __func__,
+                        err ? err->message : "");
+            g_clear_object(&mod->simCancel);
+        }
+        g_clear_error(&err);
+    }
+    else
+    {
+        sat_log_log(SAT_LOG_LEVEL_INFO,
+                    _("%s: %s: %u events precomputed"),
+                    __func__, mod->name, tl->events->len);
+
+        if (mod->simTimeline)
+            sim_timeline_free(mod->simTimeline);
+        mod->simTimeline = tl;
+        g_clear_object(&mod->simCancel);
+    }
+
+    if (mod->tmgActive)
+        gtk_widget_set_sensitive(mod->tmgSim, TRUE);
+
+    g_object_unref(mod);
+}
+
+/**
+ * Manage Simulate button clicks.
+ *
+ * Starts a background simulation of the next 24 hours from the current
+ * module time. While the resulting timeline covers the module time, AOS/LOS
+ * are taken from it and the crossed events are reported on every tick, so
+ * the throttle can be set high without skipping events.
+ */
+static void tmg_simulate(GtkWidget * widget, gpointer data)
+{
+    GtkSatModule   *mod = GTK_SAT_MODULE(data);
+    sim_params_t    params;
+
+    if (mod->simCancel)
+        return;
+
+    sim_params_init(&params, mod->tmgCdnum);
+    params.target = mod->target;
+
+    mod->simCancel = g_cancellable_new();
+    gtk_widget_set_sensitive(widget, FALSE);
+
+    sat_log_log(SAT_LOG_LEVEL_INFO,
+                _("%s: Simulating %s from %.5f"), __func__, mod->name,
+                mod->tmgCdnum);
+
+    g_mutex_lock(&mod->busy);
+    sim_engine_run_async(mod->satellites, mod->qth, &params, mod->simCancel,
+                         tmg_simulate_done, g_object_ref(mod));
+    g_mutex_unlock(&mod->busy);
+}
+
 static void tmg_throttle(GtkWidget * widget, gpointer data)
 {
     GtkSatModule   *mod = GTK_SAT_MODULE(data);
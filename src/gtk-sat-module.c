@@ -59,6 +59,7 @@
 #include "mod-mgr.h"
 #include "orbit-tools.h"
 #include "predict-tools.h"
+#include "result-cache.h"
 #include "sat-cfg.h"
 #include "sat-log.h"
 #include "sgpsdp/sgp4sdp4.h"
@@ -155,6 +156,30 @@ static void gtk_sat_module_destroy(GtkWidget * widget)
         module->tmgActive = FALSE;
     }
 
+    /* stop simulation and drop timeline */
+    if (module->simCancel)
+    {
+        g_cancellable_cancel(module->simCancel);
+        g_clear_object(&module->simCancel);
+    }
+    if (module->simTimeline)
+    {
+        sim_timeline_free(module->simTimeline);
+        module->simTimeline = NULL;
+    }
+
+    /* stop coverage analysis and drop results */
+    if (module->covCancel)
+    {
+        g_cancellable_cancel(module->covCancel);
+        g_clear_object(&module->covCancel);
+    }
+    if (module->coverage)
+    {
+        cov_grid_free(module->coverage);
+        module->coverage = NULL;
+    }
+
     /* destroy radio and rotator controllers */
     if (module->rigctrlwin)
     {
@@ -187,6 +212,8 @@ static void gtk_sat_module_destroy(GtkWidget * widget)
     }
 
     /* clean up satellites */
+    sat_table_free(module->table);
+    module->table = NULL;
     if (module->satellites)
     {
         g_hash_table_destroy(module->satellites);
@@ -258,6 +285,11 @@ static void gtk_sat_module_init(GtkSatModule * module,
     module->tmgCdnum = 0.0;
     module->tmgReset = FALSE;
 
+    module->simTimeline = NULL;
+    module->simCancel = NULL;
+    module->coverage = NULL;
+    module->covCancel = NULL;
+
     module->target = -1;
     module->autotrack = FALSE;
 }
@@ -471,7 +503,6 @@ static void gtk_sat_module_load_sats(GtkSatModule * module)
 
             if (g_hash_table_lookup(module->satellites, key) == NULL)
             {
-                gtk_sat_data_init_sat(sat, module->qth);
                 g_hash_table_insert(module->satellites, key, sat);
                 succ++;
                 sat_log_log(SAT_LOG_LEVEL_DEBUG,
@@ -494,6 +525,9 @@ static void gtk_sat_module_load_sats(GtkSatModule * module)
                 _("%s: Read %d out of %d satellites"), __func__, succ, length);
 
     g_free(sats);
+
+    sat_table_free(module->table);
+    module->table = sat_table_new(module->satellites);
 }
 
 /**
@@ -504,9 +538,9 @@ static void gtk_sat_module_load_sats(GtkSatModule * module)
  * This function checks to see if the sky-at-a-glance display needs to be
  * updated due to time or qth moving. It checks how long ago the GtkSkyGlance
  * widget was updated and performs an update if necessary. The current timeout
- * is set to 60 sec. It also checks how far away the qth is from where the
- * GtkSkyGlance widget was last updated and triggers an update if necessary.
- * The current distance is set to 1km.
+ * is set to 60 sec. When the qth has moved 1 km from where the GtkSkyGlance
+ * widget was last updated, qth_moved() clears the time of the last update so
+ * the next call updates it.
  *
  * This is a cheap/lazy implementation of automatic update. Instead of
  * performing a real update by "moving" the objects on the GtkSkyGlance canvas,
@@ -519,9 +553,9 @@ static void gtk_sat_module_load_sats(GtkSatModule * module)
  */
 static void update_skg(GtkSatModule * module)
 {
-    /* update SKG if ~60 seconds have passed or we have moved 1 km */
-    if (G_UNLIKELY(fabs(module->tmgCdnum - module->lastSkgUpd) > 7.0e-4) ||
-        G_UNLIKELY(qth_small_dist(module->qth, module->lastSkgUpdqth) > 1.0))
+    /* update SKG if ~60 seconds have passed; qth_moved() forces an
+       update after the QTH has moved 1 km */
+    if (G_UNLIKELY(fabs(module->tmgCdnum - module->lastSkgUpd) > 7.0e-4))
     {
 
         sat_log_log(SAT_LOG_LEVEL_INFO,
@@ -572,39 +606,46 @@ static void update_header(GtkSatModule * module)
  *
  * @param child Pointer to the child widget (views)
  * @param tstamp The current timestamp
+ * @param table The per-tick satellite state
  *
  * This function is called by the main loop of the GtkSatModule widget for
  * each view in the layout grid.
  */
-static void update_child(GtkWidget * child, gdouble tstamp)
+static void update_child(GtkWidget * child, gdouble tstamp,
+                         sat_table_t * table)
 {
     if (IS_GTK_SAT_LIST(child))
     {
         GTK_SAT_LIST(child)->tstamp = tstamp;
+        GTK_SAT_LIST(child)->table = table;
         gtk_sat_list_update(child);
     }
 
     else if (IS_GTK_SAT_MAP(child))
     {
         GTK_SAT_MAP(child)->tstamp = tstamp;
+        GTK_SAT_MAP(child)->table = table;
         gtk_sat_map_update(child);
     }
 
     else if (IS_GTK_POLAR_VIEW(child))
     {
         GTK_POLAR_VIEW(child)->tstamp = tstamp;
+        GTK_POLAR_VIEW(child)->table = table;
         gtk_polar_view_update(child);
     }
 
     else if (IS_GTK_SINGLE_SAT(child))
     {
         GTK_SINGLE_SAT(child)->tstamp = tstamp;
+        GTK_SINGLE_SAT(child)->state = table;
         gtk_single_sat_update(child);
     }
 
     else if (IS_GTK_EVENT_LIST(child))
     {
         GTK_EVENT_LIST(child)->tstamp = tstamp;
+        GTK_EVENT_LIST(child)->table = table;
         gtk_event_list_update(child);
     }
 
@@ -618,36 +659,42 @@ static void update_child(GtkWidget * child, gdouble tstamp)
 /**
  * Update a given satellite.
  *
- * @param key The hash table key (catnum)
- * @param val The hash table value (sat_t structure)
- * @param data User data (the GtkSatModule widget).
+ * @param module The GtkSatModule widget.
+ * @param sat The satellite.
+ * @param events Whether to recalculate the next AOS and LOS.
  *
  * This function updates the tracking data for a given satellite. It is called by
- * the timeout handler for each element in the hash table.
+ * the timeout handler for each satellite in the module.
  */
-static void gtk_sat_module_update_sat(gpointer key, gpointer val,
-                                      gpointer data)
+static void gtk_sat_module_update_sat(GtkSatModule * module, sat_t * sat,
+                                      gboolean events)
 {
-    sat_t          *sat;
-    GtkSatModule   *module;
     gdouble         daynum;
     gdouble         maxdt;
+    gdouble         aos, los;
 
-    (void)key;
+    g_return_if_fail((module != NULL) && (sat != NULL));
 
-    g_return_if_fail((val != NULL) && (data != NULL));
-
-    sat = SAT(val);
-    module = GTK_SAT_MODULE(data);
     maxdt = (gdouble) sat_cfg_get_int(SAT_CFG_INT_PRED_LOOK_AHEAD);
 
     /* get current time (real or simulated */
     daynum = module->tmgCdnum;
 
-    /* update events if the event counter has been reset
+    /* use the precomputed timeline when it covers the current time; this
+       keeps AOS/LOS exact at any throttle without calling find_aos/los */
+    if (sim_timeline_covers(module->simTimeline, module->qth, daynum) &&
+        sim_timeline_get_events(module->simTimeline, sat->tle.catnr, daynum,
+                                &aos, &los))
+    {
+        sat->aos = aos;
+        sat->los = los;
+        predict_calc(sat, module->qth, daynum);
+        return;
+    }
+
+    /* update events if requested by the sweep
        and the other requirements are fulfilled */
-    if ((GTK_SAT_MODULE(module)->event_count == 0) &&
-        has_aos(sat, module->qth))
+    if (events && has_aos(sat, module->qth))
     {
         /* Note that has_aos may return TRUE for geostationary sats
            whose orbit deviate from a true-geostat orbit, however,
@@ -702,6 +749,146 @@ static void gtk_sat_module_update_sat(gpointer key, gpointer val,
     predict_calc(sat, module->qth, daynum);
 }
 
+/**
+ * Update all satellites and their per-tick state.
+ *
+ * @param mod The GtkSatModule widget.
+ * @param sweep Whether to advance the AOS/LOS sweep.
+ *
+ * The satellites are walked in table order rather than through the hash so
+ * that the state records are written, and later read by the views,
+ * sequentially.
+ *
+ * The AOS/LOS search costs far more than the position and is spread over
+ * the ticks: each tick continues the sweep at mod->event_next and stops
+ * after a fifth of the refresh interval, so that a large module opens and
+ * keeps ticking without a stall.  Satellites not yet reached keep their
+ * previous events, or none right after loading.
+ */
+static void update_sats(GtkSatModule * mod, gboolean sweep)
+{
+    gint64          deadline;
+    gboolean        events;
+    gboolean        swept = FALSE;
+    guint           i;
+
+    if (mod->table == NULL)
+        return;
+
+    deadline = g_get_monotonic_time() + (gint64) mod->timeout * 200;
+
+    for (i = 0; i < SAT_TABLE_LEN(mod->table); i++)
+    {
+        events = FALSE;
+        if (sweep && i == mod->event_next &&
+            (!swept || g_get_monotonic_time() < deadline))
+        {
+            /* at least one satellite per tick */
+            events = TRUE;
+            swept = TRUE;
+            mod->event_next++;
+        }
+
+        gtk_sat_module_update_sat(mod, SAT_TABLE_SAT(mod->table, i), events);
+        sat_table_store(mod->table, i);
+    }
+}
+
+/**
+ * Drop the rotator and rig commands replayed for a satellite.
+ *
+ * @param module The module.
+ * @param catnr The satellite or -1 for any.
+ */
+static void clear_sim_commands(GtkSatModule * module, gint catnr)
+{
+    if (module->rotctrl &&
+        (catnr < 0 || GTK_ROT_CTRL(module->rotctrl)->cmd_catnr == catnr))
+        gtk_rot_ctrl_set_command(GTK_ROT_CTRL(module->rotctrl), -1, 0.0, 0.0);
+    if (module->rigctrl &&
+        (catnr < 0 || GTK_RIG_CTRL(module->rigctrl)->cmd_catnr == catnr))
+        gtk_rig_ctrl_set_command(GTK_RIG_CTRL(module->rigctrl), -1, 0.0);
+}
+
+/**
+ * Replay a timeline event crossed by the current tick.
+ *
+ * Rotator and rig commands become the set points of the rotator and radio
+ * controllers, which ignore them unless they track that satellite; they are
+ * dropped at the next AOS or LOS. The other events are logged.
+ */
+static void replay_sim_event(const sim_timeline_t * tl, const sim_event_t * ev,
+                             gpointer data)
+{
+    GtkSatModule   *module = GTK_SAT_MODULE(data);
+    sat_t          *sat;
+    const gchar    *name = NULL;
+    gchar           tbuf[TIME_FORMAT_MAX_LENGTH];
+
+    sat = SAT(g_hash_table_lookup(module->satellites, &ev->catnr));
+    if (sat == NULL)
+        return;
+
+    daynum_to_str(tbuf, TIME_FORMAT_MAX_LENGTH,
+                  sat_cfg_get_str(SAT_CFG_STR_TIME_FORMAT), ev->jd);
+
+    switch (ev->type)
+    {
+    case SIM_EVENT_AOS:
+    case SIM_EVENT_LOS:
+        clear_sim_commands(module, ev->catnr);
+        break;
+
+    case SIM_EVENT_TERRITORY_ENTRY:
+    case SIM_EVENT_TERRITORY_EXIT:
+        if (ev->index >= 0 && (guint) ev->index < tl->territories->len)
+            name = g_ptr_array_index(tl->territories, ev->index);
+        break;
+
+    case SIM_EVENT_POI_ENTRY:
+        if (ev->index >= 0 && (guint) ev->index < tl->pois->len)
+            name = g_ptr_array_index(tl->pois, ev->index);
+        break;
+
+    case SIM_EVENT_ROT_CMD:
+    case SIM_EVENT_RIG_CMD:
+        if (ev->type == SIM_EVENT_ROT_CMD && module->rotctrl)
+            gtk_rot_ctrl_set_command(GTK_ROT_CTRL(module->rotctrl), ev->catnr,
+                                     ev->az, ev->el);
+        if (ev->type == SIM_EVENT_RIG_CMD && module->rigctrl)
+            gtk_rig_ctrl_set_command(GTK_RIG_CTRL(module->rigctrl), ev->catnr,
+                                     ev->range_rate);
+        sat_log_log(SAT_LOG_LEVEL_DEBUG,
+                    _("%s: %s %s %s Az:%.1f El:%.1f RR:%.3f"), __func__,
+                    tbuf, sat->nickname, sim_event_type_to_str(ev->type),
+                    ev->az, ev->el, ev->range_rate);
+        return;
+
+    default:
+        break;
+    }
+
+    sat_log_log(SAT_LOG_LEVEL_INFO, _("%s: %s %s %s %s"), __func__,
+                tbuf, sat->nickname, sim_event_type_to_str(ev->type),
+                name ? name : "");
+}
+
+/**
+ * Invalidate what depends on the observer position.
+ *
+ * Called when qth_data_update() reports a new position. Moves of less than
+ * 1 km are ignored; the AOS/LOS sweep and GtkSkyGlance are refreshed once
+ * the QTH is 1 km away from where they were computed.
+ */
+static void qth_moved(GtkSatModule * mod)
+{
+    if (qth_small_dist(mod->qth, mod->qth_event) > 1.0)
+        mod->event_count = 0;   /* will trigger find_aos() and find_los() */
+
+    if (mod->skg && qth_small_dist(mod->qth, mod->lastSkgUpdqth) > 1.0)
+        mod->lastSkgUpd = 0.0;  /* picked up by update_skg() */
+}
+
 /** Module timeout callback. */
 static gboolean gtk_sat_module_timeout_cb(gpointer module)
 {
@@ -712,8 +899,10 @@ static gboolean gtk_sat_module_timeout_cb(gpointer module)
     gdouble         delta;
     guint           i;
 
-    /*update the qth position */
-    qth_data_update(mod->qth, mod->tmgCdnum);
+    /* update the qth position; only a static copy of the latest gpsd fix,
+       the gpsd I/O runs in its own thread */
+    if (qth_data_update(mod->qth, mod->tmgCdnum))
+        qth_moved(mod);
 
     /* in docked state, update only if tab is visible */
     switch (mod->state)
@@ -758,6 +947,14 @@ static gboolean gtk_sat_module_timeout_cb(gpointer module)
         /* else nothing to do since tmg_time_set updates
            mod->tmgCdnum every time */
 
+        /* replay the simulated events crossed by this tick; outside the
+           timeline the controllers follow the satellites again */
+        if (sim_timeline_covers(mod->simTimeline, mod->qth, mod->tmgCdnum))
+            sim_timeline_replay(mod->simTimeline, mod->tmgPdnum,
+                                mod->tmgCdnum, replay_sim_event, mod);
+        else
+            clear_sim_commands(mod, -1);
+
         /* time to update header? */
         mod->head_count++;
         if (mod->head_count >= mod->head_timeout)
@@ -767,36 +964,31 @@ static gboolean gtk_sat_module_timeout_cb(gpointer module)
             update_header(mod);
         }
 
-        /* reset event update counter if is has expired or if we have moved
-           significantly */
-        if (mod->event_count == mod->event_timeout ||
-            qth_small_dist(mod->qth, mod->qth_event) > 1.0)
-        {
+        /* reset event update counter if is has expired; qth_moved() resets
+           it when we have moved significantly */
+        if (mod->event_count == mod->event_timeout)
             mod->event_count = 0;       // will trigger find_aos() and find_los()
-        }
 
-        /* if the events are going to be recalculated store the position */
+        /* if the events are going to be recalculated store the position
+           and restart the sweep */
         if (mod->event_count == 0)
         {
             qth_small_save(mod->qth, &(mod->qth_event));
+            mod->event_next = 0;
         }
 
         /* update satellite data */
-        if (mod->satellites != NULL)
-            g_hash_table_foreach(mod->satellites,
-                                 gtk_sat_module_update_sat, module);
+        update_sats(mod, TRUE);
 
         /* update children */
         for (i = 0; i < mod->nviews; i++)
         {
             child = GTK_WIDGET(g_slist_nth_data(mod->views, i));
-            update_child(child, mod->tmgCdnum);
+            update_child(child, mod->tmgCdnum, mod->table);
         }
 
         /* update satellite data (it may have got out of sync during child updates) */
-        if (mod->satellites != NULL)
-            g_hash_table_foreach(mod->satellites,
-                                 gtk_sat_module_update_sat, module);
+        update_sats(mod, FALSE);
 
         /* update target if autotracking is enabled */
         if (mod->autotrack)
@@ -1055,6 +1247,10 @@ GtkWidget *gtk_sat_module_new(const gchar * cfgfile)
 
     gtk_sat_module_load_sats(module);
 
+    /* the views read the position when they are created; the events are
+       left to the sweep of the ticks */
+    update_sats(module, FALSE);
+
     /* menu */
     GtkWidget * image = gtk_image_new_from_icon_name("open-menu-symbolic",
                                          GTK_ICON_SIZE_BUTTON);
@@ -1393,19 +1589,21 @@ static void reload_sats_in_child(GtkWidget * widget, GtkSatModule * module)
     }
     else if (IS_GTK_POLAR_VIEW(widget))
     {
+        GTK_POLAR_VIEW(widget)->table = module->table;
         gtk_polar_view_reload_sats(widget, module->satellites);
     }
     else if (IS_GTK_SAT_MAP(widget))
     {
+        GTK_SAT_MAP(widget)->table = module->table;
         gtk_sat_map_reload_sats(widget, module->satellites);
     }
     else if (IS_GTK_SAT_LIST(widget))
     {
-        /* NOP */
+        GTK_SAT_LIST(widget)->table = module->table;
     }
     else if (IS_GTK_EVENT_LIST(widget))
     {
-        /* NOP */
+        GTK_EVENT_LIST(widget)->table = module->table;
     }
     else
     {
@@ -1444,13 +1642,23 @@ void gtk_sat_module_reload_sats(GtkSatModule * module)
                 __func__, module->name);
 
     /* remove each element from the hash table, but keep the hash table */
+    sat_table_free(module->table);
+    module->table = NULL;
     g_hash_table_remove_all(module->satellites);
 
+    /* a precomputed timeline refers to the old elements */
+    if (module->simTimeline)
+    {
+        sim_timeline_free(module->simTimeline);
+        module->simTimeline = NULL;
+    }
+
     /* reset event counter so that next AOS/LOS gets re-calculated */
     module->event_count = 0;
 
     /* load satellites */
     gtk_sat_module_load_sats(module);
+    update_sats(module, FALSE);
 
     /* update children */
     for (i = 0; i < module->nviews; i++)
@@ -1465,6 +1673,151 @@ void gtk_sat_module_reload_sats(GtkSatModule * module)
     g_mutex_unlock(&module->busy);
 }
 
+/** Refresh the derived data of a satellite with new elements in a view */
+static void reload_sat_in_child(GtkWidget * widget, sat_t * sat)
+{
+    if (IS_GTK_POLAR_VIEW(widget))
+        gtk_polar_view_reload_sat(widget, sat);
+    else if (IS_GTK_SAT_MAP(widget))
+        gtk_sat_map_reload_sat(widget, sat);
+
+    /* the single-sat view and the lists read the sat_t on every update */
+}
+
+/** TLE hot-swap state. */
+typedef struct {
+    GtkSatModule   *module;
+    GSList         *changed;    /* sat_t with new elements */
+} tle_swap_t;
+
+/** Replace the elements of a satellite if its .sat file has new ones. */
+static void update_tle(gpointer key, gpointer val, gpointer data)
+{
+    sat_t          *sat = SAT(val);
+    tle_swap_t     *swap = data;
+    GtkSatModule   *module = swap->module;
+    sat_t          *fresh;
+
+    (void)key;
+
+    fresh = g_new0(sat_t, 1);
+    if (gtk_sat_data_read_sat(sat->tle.catnr, fresh) == 0 &&
+        gtk_sat_data_tle_changed(&sat->tle, &fresh->tle))
+    {
+        gtk_sat_data_swap_model(sat, fresh);
+
+        /* state for the current module time; the events of the old
+           elements are void until the sweep reaches the satellite */
+        sat->aos = 0.0;
+        sat->los = 0.0;
+        predict_calc(sat, module->qth, module->tmgCdnum);
+
+        swap->changed = g_slist_prepend(swap->changed, sat);
+    }
+    gtk_sat_data_free_sat(fresh);
+}
+
+/**
+ * Hot-swap updated TLE data.
+ *
+ * @param module Pointer to a GtkSatModule widget.
+ * @return The number of satellites whose elements changed.
+ *
+ * Unlike gtk_sat_module_reload_sats(), the satellites are not freed: the
+ * propagator model of each satellite with new elements is replaced in its
+ * sat_t, under the module lock so that no tick sees a half-updated set.
+ * The views keep their canvas objects and rows; only the derived data of
+ * the changed satellites (current pass, sky track, ground track, sky at a
+ * glance row) is recalculated.  The next AOS/LOS are left to the event
+ * sweep of the following ticks, which is restarted.  If the module has satellites that could
+ * not be loaded before, they may be loadable now and a full reload is
+ * done instead.
+ */
+guint gtk_sat_module_update_tles(GtkSatModule * module)
+{
+    GtkWidget      *child;
+    GSList         *node;
+    tle_swap_t      swap;
+    gint           *sats;
+    gsize           length = 0;
+    guint           num, i;
+
+    g_return_val_if_fail(IS_GTK_SAT_MODULE(module), 0);
+
+    sats = g_key_file_get_integer_list(module->cfgdata,
+                                       MOD_CFG_GLOBAL_SECTION,
+                                       MOD_CFG_SATS_KEY, &length, NULL);
+    g_free(sats);
+    if (length != g_hash_table_size(module->satellites))
+    {
+        gtk_sat_module_reload_sats(module);
+        return g_hash_table_size(module->satellites);
+    }
+
+    /* lock module */
+    g_mutex_lock(&module->busy);
+
+    swap.module = module;
+    swap.changed = NULL;
+    g_hash_table_foreach(module->satellites, update_tle, &swap);
+    num = g_slist_length(swap.changed);
+
+    sat_log_log(SAT_LOG_LEVEL_INFO,
+                _("%s: New elements for %d satellites in module %s"),
+                __func__, num, module->name);
+
+    if (swap.changed != NULL)
+    {
+        GArray         *catnr = g_array_new(FALSE, FALSE, sizeof(guint32));
+
+        /* a precomputed timeline refers to the old elements */
+        if (module->simTimeline)
+        {
+            sim_timeline_free(module->simTimeline);
+            module->simTimeline = NULL;
+        }
+
+        /* restart the AOS/LOS sweep on the next tick */
+        module->event_count = 0;
+
+        for (node = swap.changed; node != NULL; node = node->next)
+        {
+            gint            idx;
+            guint32         id = (guint32) SAT(node->data)->tle.catnr;
+
+            g_array_append_val(catnr, id);
+            idx = sat_table_find(module->table, SAT(node->data)->tle.catnr);
+            if (idx >= 0)
+                sat_table_store(module->table, idx);
+
+            for (i = 0; i < module->nviews; i++)
+            {
+                child = GTK_WIDGET(g_slist_nth_data(module->views, i));
+                reload_sat_in_child(child, SAT(node->data));
+            }
+
+            /* rebuild sky at a glance on the next tick if a row appears
+               or disappears */
+            if (module->skg != NULL && IS_GTK_SKY_GLANCE(module->skg) &&
+                !gtk_sky_glance_reload_sat(GTK_SKY_GLANCE(module->skg),
+                                           SAT(node->data)))
+                module->lastSkgUpd = 0.0;
+        }
+
+        g_slist_free(swap.changed);
+
+        /* Ephemeris window results computed from the old elements */
+        result_cache_invalidate_sats((const guint32 *)catnr->data,
+                                     catnr->len);
+        g_array_free(catnr, TRUE);
+    }
+
+    /* unlock module */
+    g_mutex_unlock(&module->busy);
+
+    return num;
+}
+
 /** Select a new satellite */
 void gtk_sat_module_select_sat(GtkSatModule * module, gint catnum)
 {
@@ -1523,6 +1876,13 @@ void gtk_sat_module_select_sat(GtkSatModule * module, gint catnum)
  */
 void gtk_sat_module_reconf(GtkSatModule * module, gboolean local)
 {
-    (void)module;
+    GSList         *l;
+
     (void)local;
+
+    for (l = module->views; l != NULL; l = l->next)
+    {
+        if (IS_GTK_SAT_MAP(l->data))
+            gtk_sat_map_reconf(GTK_WIDGET(l->data), module->cfgdata);
+    }
 }
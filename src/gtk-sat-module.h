@@ -7,6 +7,10 @@
 
 #include "qth-data.h"
 #include "gtk-sat-data.h"
+#include "sat-table.h"
+#include "coverage-engine.h"
+#include "sim-engine.h"
+#include "view-flags.h"
 
 /* *INDENT-OFF* */
 #ifdef __cplusplus
@@ -21,16 +25,6 @@ typedef enum {
     GTK_SAT_MOD_STATE_FULLSCREEN        /*!< The module is in FULLSCREEN mode :-) */
 } gtk_sat_mod_state_t;
 
-/** View types */
-typedef enum {
-    GTK_SAT_MOD_VIEW_LIST = 0,  /*!< GtkSatList */
-    GTK_SAT_MOD_VIEW_MAP,       /*!< GtkSatMap */
-    GTK_SAT_MOD_VIEW_POLAR,     /*!< GtkPolarView */
-    GTK_SAT_MOD_VIEW_SINGLE,    /*!< GtkSingleSat */
-    GTK_SAT_MOD_VIEW_EVENT,     /*!< GtkEventList */
-    GTK_SAT_MOD_VIEW_NUM,       /*!< Number of modules */
-} gtk_sat_mod_view_t;
-
 
 #define GTK_TYPE_SAT_MODULE         (gtk_sat_module_get_type ())
 #define GTK_SAT_MODULE(obj)         G_TYPE_CHECK_INSTANCE_CAST (obj,\
@@ -68,6 +62,7 @@ struct _gtk_sat_module {
     guint           head_timeout;
     guint           event_count;
     guint           event_timeout;
+    guint           event_next; /*!< Table index where the AOS/LOS sweep continues */
 
     /* layout and children */
     guint          *grid;       /*!< The grid layout array [(type,left,right,top,bottom),...] */
@@ -78,6 +73,7 @@ struct _gtk_sat_module {
     qth_t          *qth;        /*!< QTH information. */
     qth_small_t     qth_event;  /*!< QTH information for last AOS/LOS update. */
     GHashTable     *satellites; /*!< Satellites. */
+    sat_table_t    *table;      /*!< Per-tick state of the satellites. */
 
     guint32         timeout;    /*!< Timeout value [msec] */
 
@@ -109,6 +105,13 @@ struct _gtk_sat_module {
     GtkWidget      *tmgReset;   /*!< Reset button */
     GtkWidget      *tmgWin;     /*!< Window containing the widgets. */
     GtkWidget      *tmgState;   /*!< Status label indicating RT/SRT/MAN */
+    GtkWidget      *tmgSim;     /*!< Button starting a timeline precomputation */
+
+    sim_timeline_t *simTimeline;        /*!< Precomputed events or NULL */
+    GCancellable   *simCancel;  /*!< Cancels a running precomputation */
+
+    cov_grid_t     *coverage;   /*!< Last coverage analysis or NULL */
+    GCancellable   *covCancel;  /*!< Cancels a running coverage analysis */
 
     gboolean        reset;      /*!< Flag indicating whether time reset is in progress */
 
@@ -131,6 +134,7 @@ void            gtk_sat_module_close_cb(GtkWidget * button, gpointer data);
 void            gtk_sat_module_config_cb(GtkWidget * button, gpointer data);
 
 void            gtk_sat_module_reload_sats(GtkSatModule * module);
+guint           gtk_sat_module_update_tles(GtkSatModule * module);
 void            gtk_sat_module_reconf(GtkSatModule * module, gboolean local);
 void            gtk_sat_module_select_sat(GtkSatModule * module, gint catnum);
 
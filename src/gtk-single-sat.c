@@ -22,6 +22,8 @@
 #endif
 #include <glib/gi18n.h>
 #include <gtk/gtk.h>
+#include <math.h>
+#include <time.h>
 
 #include "config-keys.h"
 #include "gpredict-utils.h"
@@ -106,6 +108,9 @@ static void gtk_single_sat_destroy(GtkWidget * widget)
         g_key_file_set_integer(ssat->cfgdata, MOD_CFG_SINGLE_SAT_SECTION,
                                MOD_CFG_SINGLE_SAT_SELECT, sat->tle.catnr);
 
+    g_free(ssat->shown_tfmt);
+    ssat->shown_tfmt = NULL;
+
     (*GTK_WIDGET_CLASS(parent_class)->destroy) (widget);
 }
 
@@ -128,150 +133,245 @@ static void gtk_single_sat_init(GtkSingleSat * list,
     (void)g_class;
 }
 
-/* Update a field in the GtkSingleSat view. */
-static void update_field(GtkSingleSat * ssat, guint i)
+/* Unit settings that change the text of a field. */
+#define SSAT_UNITS_IMPERIAL  (1 << 0)
+#define SSAT_UNITS_NSEW      (1 << 1)
+#define SSAT_UNITS_LOCALTIME (1 << 2)
+
+/* Key of a field that displays "N/A" or nothing. */
+#define SSAT_KEY_NONE G_MININT64
+
+/* Fields that display a time. */
+#define SSAT_TIME_FIELDS (SINGLE_SAT_FLAG_NEXT_EVENT | SINGLE_SAT_FLAG_AOS | \
+                          SINGLE_SAT_FLAG_LOS)
+
+/*
+ * Key of a value printed with prec decimals.
+ *
+ * The key is made of the printed digits, so it follows printf's rounding
+ * exactly; the lowest bit is the printed sign, as "-0.00" and "0.00" differ.
+ */
+static gint64 printed_key(gdouble value, gint prec)
 {
-    sat_t          *sat;
-    gchar          *buff = NULL;
-    gchar           tbuf[TIME_FORMAT_MAX_LENGTH];
-    gchar           hmf = ' ';
-    gdouble         number;
-    gint            retcode;
-    gchar          *fmtstr;
-    gchar          *alstr;
-    sat_vis_t       vis;
+    gchar           buf[48];
+    gchar          *p, *q;
+    gboolean        neg;
 
-    /* make some sanity checks */
-    if (ssat->labels[i] == NULL)
-    {
-        sat_log_log(SAT_LOG_LEVEL_ERROR,
-                    _("%s:%d: Can not update invisible field (I:%d F:%d)"),
-                    __FILE__, __LINE__, i, ssat->flags);
-        return;
-    }
+    if (!isfinite(value) || fabs(value) > 1.0e15)
+        return SSAT_KEY_NONE;
 
-    /* get selected satellite */
-    sat = SAT(g_slist_nth_data(ssat->sats, ssat->selected));
-    if (!sat)
+    g_snprintf(buf, sizeof(buf), "%.*f", prec, value);
+    neg = (buf[0] == '-');
+
+    /* keep the digits only; the decimal point depends on the locale */
+    for (p = q = buf; *p != '\0'; p++)
+        if (g_ascii_isdigit(*p))
+            *q++ = *p;
+    *q = '\0';
+
+    return 2 * g_ascii_strtoll(buf, NULL, 10) + neg;
+}
+
+/* Key of a latitude or longitude, which N/S/E/W prints as magnitude and
+   the hemisphere of "value < 0". */
+static gint64 coord_key(gdouble value, gboolean nsew)
+{
+    gint64          key;
+
+    if (!nsew)
+        return printed_key(value, 2);
+
+    key = printed_key(fabs(value), 2);
+    if (key == SSAT_KEY_NONE)
+        return key;
+
+    return 2 * key + (value < 0.0);
+}
+
+/* Key of a time: the second daynum_to_str() prints, computed the same way. */
+static gint64 time_key(gdouble jd)
+{
+    if (jd <= 0.0)
+        return SSAT_KEY_NONE;
+
+    return (gint64) (time_t) ((jd - 2440587.5) * 86400.0);
+}
+
+static const gchar *direction_str(gint64 dir)
+{
+    switch (dir)
     {
-        sat_log_log(SAT_LOG_LEVEL_ERROR,
-                    _("%s:%d: Can not update non-existing sat"),
-                    __FILE__, __LINE__);
-        return;
+    case 0:
+        return "Geostationary";
+    case 1:
+        return "Decayed";
+    case 2:
+        return "Receding";
+    case 3:
+        return "Approaching";
+    default:
+        return "N/A";
     }
+}
+
+/*
+ * Key of the text of field i.
+ *
+ * Two states of the satellite with the same key display the same text, as
+ * long as the unit settings and the time format are unchanged, so the label
+ * only needs to be rewritten when the key changes.
+ */
+static gint64 field_key(GtkSingleSat * ssat, sat_t * sat,
+                        const sat_state_t * st, guint i, guint units)
+{
+    gboolean        imperial = (units & SSAT_UNITS_IMPERIAL) != 0;
+    gboolean        nsew = (units & SSAT_UNITS_NSEW) != 0;
+    gdouble         number;
 
-    /* update requested field */
     switch (i)
     {
     case SINGLE_SAT_FIELD_AZ:
-        buff = g_strdup_printf("%6.2f\302\260", sat->az);
-        break;
+        return printed_key(sat->az, 2);
     case SINGLE_SAT_FIELD_EL:
-        buff = g_strdup_printf("%6.2f\302\260", sat->el);
-        break;
+        return printed_key(sat->el, 2);
     case SINGLE_SAT_FIELD_DIR:
         if (sat->otype == ORBIT_TYPE_GEO)
-        {
-            buff = g_strdup("Geostationary");
-        }
+            return 0;
         else if (decayed(sat))
-        {
-            buff = g_strdup("Decayed");
-        }
+            return 1;
         else if (sat->range_rate > 0.0)
-        {
-            /* Receding */
-            buff = g_strdup("Receding");
-        }
+            return 2;
         else if (sat->range_rate < 0.0)
-        {
-            /* Approaching */
-            buff = g_strdup("Approaching");
-        }
-        else
-        {
-            buff = g_strdup("N/A");
-        }
+            return 3;
+        return 4;
+    case SINGLE_SAT_FIELD_RA:
+        return printed_key(st->ra, 2);
+    case SINGLE_SAT_FIELD_DEC:
+        return printed_key(st->dec, 2);
+    case SINGLE_SAT_FIELD_RANGE:
+        return printed_key(imperial ? KM_TO_MI(sat->range) : sat->range, 0);
+    case SINGLE_SAT_FIELD_RANGE_RATE:
+        return printed_key(imperial ? KM_TO_MI(sat->range_rate) :
+                           sat->range_rate, 3);
+    case SINGLE_SAT_FIELD_NEXT_EVENT:
+        /* seconds, with the lowest bit telling AOS from LOS */
+        number = (sat->aos > sat->los) ? sat->los : sat->aos;
+        if (number <= 0.0)
+            return SSAT_KEY_NONE;
+        return 2 * time_key(number) + (sat->aos > sat->los);
+    case SINGLE_SAT_FIELD_AOS:
+        return time_key(sat->aos);
+    case SINGLE_SAT_FIELD_LOS:
+        return time_key(sat->los);
+    case SINGLE_SAT_FIELD_LAT:
+        return coord_key(sat->ssplat, nsew);
+    case SINGLE_SAT_FIELD_LON:
+        return coord_key(sat->ssplon, nsew);
+    case SINGLE_SAT_FIELD_SSP:
+        /* 6 character locators are 5' wide and 2.5' high */
+        return (gint64) floor((sat->ssplon + 180.0) * 12.0) * 8192 +
+            (gint64) floor((sat->ssplat + 90.0) * 24.0);
+    case SINGLE_SAT_FIELD_FOOTPRINT:
+        return printed_key(imperial ? KM_TO_MI(sat->footprint) :
+                           sat->footprint, 0);
+    case SINGLE_SAT_FIELD_ALT:
+        return printed_key(imperial ? KM_TO_MI(sat->alt) : sat->alt, 0);
+    case SINGLE_SAT_FIELD_VEL:
+        return printed_key(imperial ? KM_TO_MI(sat->velo) : sat->velo, 3);
+    case SINGLE_SAT_FIELD_DOPPLER:
+        return printed_key(-100.0e06 * (sat->range_rate / 299792.4580), 0);
+    case SINGLE_SAT_FIELD_LOSS:
+        return printed_key(72.4 + 20.0 * log10(sat->range), 2);
+    case SINGLE_SAT_FIELD_DELAY:
+        return printed_key(sat->range / 299.7924580, 2);
+    case SINGLE_SAT_FIELD_MA:
+        return printed_key(sat->ma, 2);
+    case SINGLE_SAT_FIELD_PHASE:
+        return printed_key(sat->phase, 2);
+    case SINGLE_SAT_FIELD_ORBIT:
+        return sat->orbit;
+    case SINGLE_SAT_FIELD_VISIBILITY:
+        return st->vis;
+    default:
+        return SSAT_KEY_NONE;
+    }
+}
+
+/*
+ * Update a field in the GtkSingleSat view.
+ *
+ * @param key The field_key() of the current satellite state.
+ * @param units SSAT_UNITS_* flags.
+ * @param tfmt The time format; only used for the time fields.
+ */
+static void update_field(GtkSingleSat * ssat, sat_t * sat,
+                         const sat_state_t * st, guint i, gint64 key,
+                         guint units, const gchar * tfmt)
+{
+    gchar           buff[TIME_FORMAT_MAX_LENGTH + 8];
+    gchar           tbuf[TIME_FORMAT_MAX_LENGTH];
+    gchar           hmf = ' ';
+    gdouble         number;
+    gboolean        imperial = (units & SSAT_UNITS_IMPERIAL) != 0;
+    gchar          *vstr;
+
+    buff[0] = '\0';
+
+    switch (i)
+    {
+    case SINGLE_SAT_FIELD_AZ:
+        g_snprintf(buff, sizeof(buff), "%6.2f\302\260", sat->az);
+        break;
+    case SINGLE_SAT_FIELD_EL:
+        g_snprintf(buff, sizeof(buff), "%6.2f\302\260", sat->el);
+        break;
+    case SINGLE_SAT_FIELD_DIR:
+        g_strlcpy(buff, direction_str(key), sizeof(buff));
         break;
     case SINGLE_SAT_FIELD_RA:
-        buff = g_strdup_printf("%6.2f\302\260", sat->ra);
+        g_snprintf(buff, sizeof(buff), "%6.2f\302\260", st->ra);
         break;
     case SINGLE_SAT_FIELD_DEC:
-        buff = g_strdup_printf("%6.2f\302\260", sat->dec);
+        g_snprintf(buff, sizeof(buff), "%6.2f\302\260", st->dec);
         break;
     case SINGLE_SAT_FIELD_RANGE:
-        if (sat_cfg_get_bool(SAT_CFG_BOOL_USE_IMPERIAL))
-            buff = g_strdup_printf("%.0f mi", KM_TO_MI(sat->range));
+        if (imperial)
+            g_snprintf(buff, sizeof(buff), "%.0f mi", KM_TO_MI(sat->range));
         else
-            buff = g_strdup_printf("%.0f km", sat->range);
+            g_snprintf(buff, sizeof(buff), "%.0f km", sat->range);
         break;
     case SINGLE_SAT_FIELD_RANGE_RATE:
-        if (sat_cfg_get_bool(SAT_CFG_BOOL_USE_IMPERIAL))
-            buff = g_strdup_printf("%.3f mi/sec", KM_TO_MI(sat->range_rate));
+        if (imperial)
+            g_snprintf(buff, sizeof(buff), "%.3f mi/sec",
+                       KM_TO_MI(sat->range_rate));
         else
-            buff = g_strdup_printf("%.3f km/sec", sat->range_rate);
+            g_snprintf(buff, sizeof(buff), "%.3f km/sec", sat->range_rate);
         break;
     case SINGLE_SAT_FIELD_NEXT_EVENT:
-        if (sat->aos > sat->los)
-        {
-            /* next event is LOS */
-            number = sat->los;
-            alstr = g_strdup("LOS: ");
-        }
-        else
+        if (key == SSAT_KEY_NONE)
         {
-            /* next event is AOS */
-            number = sat->aos;
-            alstr = g_strdup("AOS: ");
+            g_strlcpy(buff, _("N/A"), sizeof(buff));
+            break;
         }
-        if (number > 0.0)
-        {
-
-            /* format the number */
-            fmtstr = sat_cfg_get_str(SAT_CFG_STR_TIME_FORMAT);
-            daynum_to_str(tbuf, TIME_FORMAT_MAX_LENGTH, fmtstr, number);
-
-            g_free(fmtstr);
-
-            buff = g_strconcat(alstr, tbuf, NULL);
-
-        }
-        else
-        {
-            buff = g_strdup(_("N/A"));
-        }
-        g_free(alstr);
+        /* next event is LOS if aos > los */
+        number = (key & 1) ? sat->los : sat->aos;
+        daynum_to_str(tbuf, TIME_FORMAT_MAX_LENGTH, tfmt, number);
+        g_snprintf(buff, sizeof(buff), "%s%s", (key & 1) ? "LOS: " : "AOS: ",
+                   tbuf);
         break;
     case SINGLE_SAT_FIELD_AOS:
-        if (sat->aos > 0.0)
-        {
-            /* format the number */
-            fmtstr = sat_cfg_get_str(SAT_CFG_STR_TIME_FORMAT);
-            daynum_to_str(tbuf, TIME_FORMAT_MAX_LENGTH, fmtstr, sat->aos);
-            g_free(fmtstr);
-            buff = g_strdup(tbuf);
-        }
-        else
-        {
-            buff = g_strdup(_("N/A"));
-        }
-        break;
     case SINGLE_SAT_FIELD_LOS:
-        if (sat->los > 0.0)
+        if (key == SSAT_KEY_NONE)
         {
-            fmtstr = sat_cfg_get_str(SAT_CFG_STR_TIME_FORMAT);
-            daynum_to_str(tbuf, TIME_FORMAT_MAX_LENGTH, fmtstr, sat->los);
-            g_free(fmtstr);
-            buff = g_strdup(tbuf);
-        }
-        else
-        {
-            buff = g_strdup(_("N/A"));
+            g_strlcpy(buff, _("N/A"), sizeof(buff));
+            break;
         }
+        daynum_to_str(buff, TIME_FORMAT_MAX_LENGTH, tfmt,
+                      (i == SINGLE_SAT_FIELD_AOS) ? sat->aos : sat->los);
         break;
     case SINGLE_SAT_FIELD_LAT:
         number = sat->ssplat;
-        if (sat_cfg_get_bool(SAT_CFG_BOOL_USE_NSEW))
+        if (units & SSAT_UNITS_NSEW)
         {
             if (number < 0.00)
             {
@@ -283,11 +383,11 @@ static void update_field(GtkSingleSat * ssat, guint i)
                 hmf = 'N';
             }
         }
-        buff = g_strdup_printf("%.2f\302\260%c", number, hmf);
+        g_snprintf(buff, sizeof(buff), "%.2f\302\260%c", number, hmf);
         break;
     case SINGLE_SAT_FIELD_LON:
         number = sat->ssplon;
-        if (sat_cfg_get_bool(SAT_CFG_BOOL_USE_NSEW))
+        if (units & SSAT_UNITS_NSEW)
         {
             if (number < 0.00)
             {
@@ -299,82 +399,69 @@ static void update_field(GtkSingleSat * ssat, guint i)
                 hmf = 'E';
             }
         }
-        buff = g_strdup_printf("%.2f\302\260%c", number, hmf);
+        g_snprintf(buff, sizeof(buff), "%.2f\302\260%c", number, hmf);
         break;
     case SINGLE_SAT_FIELD_SSP:
-        /* SSP locator */
-        buff = g_try_malloc(7);
-        retcode = longlat2locator(sat->ssplon, sat->ssplat, buff, 3);
-        if (retcode == RIG_OK)
-        {
-            buff[6] = '\0';
-        }
-        else
-        {
-            g_free(buff);
-            buff = NULL;
-        }
-
+        /* SSP locator; the label is left alone on error */
+        if (longlat2locator(sat->ssplon, sat->ssplat, buff, 3) != RIG_OK)
+            return;
+        buff[6] = '\0';
         break;
     case SINGLE_SAT_FIELD_FOOTPRINT:
-        if (sat_cfg_get_bool(SAT_CFG_BOOL_USE_IMPERIAL))
-        {
-            buff = g_strdup_printf("%.0f mi", KM_TO_MI(sat->footprint));
-        }
+        if (imperial)
+            g_snprintf(buff, sizeof(buff), "%.0f mi",
+                       KM_TO_MI(sat->footprint));
         else
-        {
-            buff = g_strdup_printf("%.0f km", sat->footprint);
-        }
+            g_snprintf(buff, sizeof(buff), "%.0f km", sat->footprint);
         break;
     case SINGLE_SAT_FIELD_ALT:
-        if (sat_cfg_get_bool(SAT_CFG_BOOL_USE_IMPERIAL))
-            buff = g_strdup_printf("%.0f mi", KM_TO_MI(sat->alt));
+        if (imperial)
+            g_snprintf(buff, sizeof(buff), "%.0f mi", KM_TO_MI(sat->alt));
         else
-            buff = g_strdup_printf("%.0f km", sat->alt);
+            g_snprintf(buff, sizeof(buff), "%.0f km", sat->alt);
         break;
     case SINGLE_SAT_FIELD_VEL:
-        if (sat_cfg_get_bool(SAT_CFG_BOOL_USE_IMPERIAL))
-            buff = g_strdup_printf("%.3f mi/sec", KM_TO_MI(sat->velo));
+        if (imperial)
+            g_snprintf(buff, sizeof(buff), "%.3f mi/sec", KM_TO_MI(sat->velo));
         else
-            buff = g_strdup_printf("%.3f km/sec", sat->velo);
+            g_snprintf(buff, sizeof(buff), "%.3f km/sec", sat->velo);
         break;
     case SINGLE_SAT_FIELD_DOPPLER:
         number = -100.0e06 * (sat->range_rate / 299792.4580);   // Hz
-        buff = g_strdup_printf("%.0f Hz", number);
+        g_snprintf(buff, sizeof(buff), "%.0f Hz", number);
         break;
     case SINGLE_SAT_FIELD_LOSS:
         number = 72.4 + 20.0 * log10(sat->range);       // dB
-        buff = g_strdup_printf("%.2f dB", number);
+        g_snprintf(buff, sizeof(buff), "%.2f dB", number);
         break;
     case SINGLE_SAT_FIELD_DELAY:
         number = sat->range / 299.7924580;      // msec 
-        buff = g_strdup_printf("%.2f msec", number);
+        g_snprintf(buff, sizeof(buff), "%.2f msec", number);
         break;
     case SINGLE_SAT_FIELD_MA:
-        buff = g_strdup_printf("%.2f\302\260", sat->ma);
+        g_snprintf(buff, sizeof(buff), "%.2f\302\260", sat->ma);
         break;
     case SINGLE_SAT_FIELD_PHASE:
-        buff = g_strdup_printf("%.2f\302\260", sat->phase);
+        g_snprintf(buff, sizeof(buff), "%.2f\302\260", sat->phase);
         break;
     case SINGLE_SAT_FIELD_ORBIT:
-        buff = g_strdup_printf("%ld", sat->orbit);
+        g_snprintf(buff, sizeof(buff), "%ld", sat->orbit);
         break;
     case SINGLE_SAT_FIELD_VISIBILITY:
-        vis = get_sat_vis(sat, ssat->qth, sat->jul_utc);
-        buff = vis_to_str(vis);
+        vstr = vis_to_str((sat_vis_t) key);
+        g_strlcpy(buff, vstr, sizeof(buff));
+        g_free(vstr);
         break;
     default:
         sat_log_log(SAT_LOG_LEVEL_ERROR,
                     _("%s:%d: Invalid field number (%d)"),
                     __FILE__, __LINE__, i);
-        break;
+        return;
     }
 
-    if (buff != NULL)
-    {
+    /* rounding may still produce the text already shown */
+    if (g_strcmp0(gtk_label_get_text(GTK_LABEL(ssat->labels[i])), buff) != 0)
         gtk_label_set_text(GTK_LABEL(ssat->labels[i]), buff);
-        g_free(buff);
-    }
 }
 
 static gint sat_name_compare(sat_t * a, sat_t * b)
@@ -394,52 +481,6 @@ static void store_sats(gpointer key, gpointer value, gpointer user_data)
                                              (GCompareFunc) sat_name_compare);
 }
 
-static void Calculate_RADec(sat_t * sat, qth_t * qth, obs_astro_t * obs_set)
-{
-    /* Reference:  Methods of Orbit Determination by  */
-    /*                Pedro Ramon Escobal, pp. 401-402 */
-
-    double          phi, theta, sin_theta, cos_theta, sin_phi, cos_phi,
-        az, el, Lxh, Lyh, Lzh, Sx, Ex, Zx, Sy, Ey, Zy, Sz, Ez, Zz,
-        Lx, Ly, Lz, cos_delta, sin_alpha, cos_alpha;
-    geodetic_t      geodetic;
-
-    geodetic.lon = qth->lon * de2ra;
-    geodetic.lat = qth->lat * de2ra;
-    geodetic.alt = qth->alt / 1000.0;
-    geodetic.theta = 0;
-
-    az = sat->az * de2ra;
-    el = sat->el * de2ra;
-    phi = geodetic.lat;
-    theta = FMod2p(ThetaG_JD(sat->jul_utc) + geodetic.lon);
-    sin_theta = sin(theta);
-    cos_theta = cos(theta);
-    sin_phi = sin(phi);
-    cos_phi = cos(phi);
-    Lxh = -cos(az) * cos(el);
-    Lyh = sin(az) * cos(el);
-    Lzh = sin(el);
-    Sx = sin_phi * cos_theta;
-    Ex = -sin_theta;
-    Zx = cos_theta * cos_phi;
-    Sy = sin_phi * sin_theta;
-    Ey = cos_theta;
-    Zy = sin_theta * cos_phi;
-    Sz = -cos_phi;
-    Ez = 0;
-    Zz = sin_phi;
-    Lx = Sx * Lxh + Ex * Lyh + Zx * Lzh;
-    Ly = Sy * Lxh + Ey * Lyh + Zy * Lzh;
-    Lz = Sz * Lxh + Ez * Lyh + Zz * Lzh;
-    obs_set->dec = ArcSin(Lz);  /* Declination (radians) */
-    cos_delta = sqrt(1 - Sqr(Lz));
-    sin_alpha = Ly / cos_delta;
-    cos_alpha = Lx / cos_delta;
-    obs_set->ra = AcTan(sin_alpha, cos_alpha);  /* Right Ascension (radians) */
-    obs_set->ra = FMod2p(obs_set->ra);
-}
-
 static void select_satellite(GtkWidget * menuitem, gpointer data)
 {
     GtkSingleSat   *ssat = GTK_SINGLE_SAT(data);
@@ -637,6 +678,12 @@ void gtk_single_sat_select_sat(GtkWidget * single_sat, gint catnum)
 void gtk_single_sat_update(GtkWidget * widget)
 {
     GtkSingleSat   *ssat = GTK_SINGLE_SAT(widget);
+    sat_t          *sat;
+    const sat_state_t *st;
+    gchar          *tfmt;
+    guint           units;
+    gint64          key;
+    gint            idx;
     guint           i;
 
     /* first, do some sanity checks */
@@ -653,30 +700,76 @@ void gtk_single_sat_update(GtkWidget * widget)
     if (ssat->counter < ssat->refresh)
     {
         ssat->counter++;
+        return;
     }
-    else
+    ssat->counter = 1;
+
+    sat = SAT(g_slist_nth_data(ssat->sats, ssat->selected));
+    if (sat == NULL || ssat->state == NULL)
+        return;
+
+    /* nothing to show before the module has propagated the satellite */
+    idx = sat_table_find(ssat->state, sat->tle.catnr);
+    if (idx < 0)
+        return;
+    st = SAT_TABLE_STATE(ssat->state, idx);
+
+    /* text of the fields also depends on these settings */
+    units = 0;
+    if (sat_cfg_get_bool(SAT_CFG_BOOL_USE_IMPERIAL))
+        units |= SSAT_UNITS_IMPERIAL;
+    if (sat_cfg_get_bool(SAT_CFG_BOOL_USE_NSEW))
+        units |= SSAT_UNITS_NSEW;
+    if (sat_cfg_get_bool(SAT_CFG_BOOL_USE_LOCAL_TIME))
+        units |= SSAT_UNITS_LOCALTIME;
+    if (units != ssat->shown_units)
     {
-        /* we calculate here to avoid double calc */
-        if ((ssat->flags & SINGLE_SAT_FLAG_RA) ||
-            (ssat->flags & SINGLE_SAT_FLAG_DEC))
-        {
-            obs_astro_t     astro;
-            sat_t          *sat =
-                SAT(g_slist_nth_data(ssat->sats, ssat->selected));
+        ssat->shown_units = units;
+        ssat->shown_valid = 0;
+    }
 
-            Calculate_RADec(sat, ssat->qth, &astro);
-            sat->ra = Degrees(astro.ra);
-            sat->dec = Degrees(astro.dec);
+    if (ssat->flags & SSAT_TIME_FIELDS)
+    {
+        tfmt = sat_cfg_get_str(SAT_CFG_STR_TIME_FORMAT);
+        if (g_strcmp0(tfmt, ssat->shown_tfmt) != 0)
+        {
+            g_free(ssat->shown_tfmt);
+            ssat->shown_tfmt = tfmt;
+            ssat->shown_valid &= ~SSAT_TIME_FIELDS;
         }
-
-        /* update visible fields one by one */
-        for (i = 0; i < SINGLE_SAT_FIELD_NUMBER; i++)
+        else
         {
-            if (ssat->flags & (1 << i))
-                update_field(ssat, i);
-
+            g_free(tfmt);
         }
-        ssat->counter = 1;
+    }
+
+    /* shared with the other views; hidden fields are skipped */
+    if ((ssat->labels[SINGLE_SAT_FIELD_RA] != NULL &&
+         (ssat->flags & SINGLE_SAT_FLAG_RA)) ||
+        (ssat->labels[SINGLE_SAT_FIELD_DEC] != NULL &&
+         (ssat->flags & SINGLE_SAT_FLAG_DEC)))
+    {
+        sat_table_radec(ssat->state, idx, ssat->qth);
+    }
+    if (ssat->labels[SINGLE_SAT_FIELD_VISIBILITY] != NULL &&
+        (ssat->flags & SINGLE_SAT_FLAG_VISIBILITY))
+    {
+        sat_table_vis(ssat->state, idx, ssat->qth);
+    }
+
+    /* update visible fields whose displayed value has changed */
+    for (i = 0; i < SINGLE_SAT_FIELD_NUMBER; i++)
+    {
+        if (!(ssat->flags & (1 << i)) || ssat->labels[i] == NULL)
+            continue;
+
+        key = field_key(ssat, sat, st, i, units);
+        if ((ssat->shown_valid & (1 << i)) && ssat->shown[i] == key)
+            continue;
+
+        update_field(ssat, sat, st, i, key, units, ssat->shown_tfmt);
+        ssat->shown[i] = key;
+        ssat->shown_valid |= (1 << i);
     }
 }
 
@@ -7,6 +7,8 @@
 
 #include "gtk-sat-data.h"
 #include "gtk-sat-module.h"
+#include "sat-table.h"
+#include "view-flags.h"
 
 /* *INDENT-OFF* */
 #ifdef __cplusplus
@@ -14,60 +16,6 @@ extern "C" {
 #endif
 /* *INDENT-ON* */
 
-/** Symbolic references to columns */
-typedef enum {
-    SINGLE_SAT_FIELD_AZ = 0,    /*!< Azimuth. */
-    SINGLE_SAT_FIELD_EL,        /*!< Elvation. */
-    SINGLE_SAT_FIELD_DIR,       /*!< Direction, satellite on its way up or down. */
-    SINGLE_SAT_FIELD_RA,        /*!< Right Ascension. */
-    SINGLE_SAT_FIELD_DEC,       /*!< Declination. */
-    SINGLE_SAT_FIELD_RANGE,     /*!< Range. */
-    SINGLE_SAT_FIELD_RANGE_RATE,        /*!< Range rate. */
-    SINGLE_SAT_FIELD_NEXT_EVENT,        /*!< Next event AOS or LOS depending on El. */
-    SINGLE_SAT_FIELD_AOS,       /*!< Next AOS regardless of El. */
-    SINGLE_SAT_FIELD_LOS,       /*!< Next LOS regardless of El. */
-    SINGLE_SAT_FIELD_LAT,       /*!< Latitude. */
-    SINGLE_SAT_FIELD_LON,       /*!< Longitude. */
-    SINGLE_SAT_FIELD_SSP,       /*!< Sub satellite point grid square */
-    SINGLE_SAT_FIELD_FOOTPRINT, /*!< Footprint. */
-    SINGLE_SAT_FIELD_ALT,       /*!< Altitude. */
-    SINGLE_SAT_FIELD_VEL,       /*!< Velocity. */
-    SINGLE_SAT_FIELD_DOPPLER,   /*!< Doppler shift at 100 MHz. */
-    SINGLE_SAT_FIELD_LOSS,      /*!< Path Loss at 100 MHz. */
-    SINGLE_SAT_FIELD_DELAY,     /*!< Signal delay */
-    SINGLE_SAT_FIELD_MA,        /*!< Mean Anomaly. */
-    SINGLE_SAT_FIELD_PHASE,     /*!< Phase. */
-    SINGLE_SAT_FIELD_ORBIT,     /*!< Orbit Number. */
-    SINGLE_SAT_FIELD_VISIBILITY,        /*!< Visibility. */
-    SINGLE_SAT_FIELD_NUMBER
-} single_sat_field_t;
-
-/** Fieldnum Flags */
-typedef enum {
-    SINGLE_SAT_FLAG_AZ = 1 << SINGLE_SAT_FIELD_AZ,      /*!< Azimuth. */
-    SINGLE_SAT_FLAG_EL = 1 << SINGLE_SAT_FIELD_EL,      /*!< Elvation. */
-    SINGLE_SAT_FLAG_DIR = 1 << SINGLE_SAT_FIELD_DIR,    /*!< Direction */
-    SINGLE_SAT_FLAG_RA = 1 << SINGLE_SAT_FIELD_RA,      /*!< Right Ascension. */
-    SINGLE_SAT_FLAG_DEC = 1 << SINGLE_SAT_FIELD_DEC,    /*!< Declination. */
-    SINGLE_SAT_FLAG_RANGE = 1 << SINGLE_SAT_FIELD_RANGE,        /*!< Range. */
-    SINGLE_SAT_FLAG_RANGE_RATE = 1 << SINGLE_SAT_FIELD_RANGE_RATE,      /*!< Range rate. */
-    SINGLE_SAT_FLAG_NEXT_EVENT = 1 << SINGLE_SAT_FIELD_NEXT_EVENT,      /*!< Next event. */
-    SINGLE_SAT_FLAG_AOS = 1 << SINGLE_SAT_FIELD_AOS,    /*!< Next AOS. */
-    SINGLE_SAT_FLAG_LOS = 1 << SINGLE_SAT_FIELD_LOS,    /*!< Next LOS. */
-    SINGLE_SAT_FLAG_LAT = 1 << SINGLE_SAT_FIELD_LAT,    /*!< Latitude. */
-    SINGLE_SAT_FLAG_LON = 1 << SINGLE_SAT_FIELD_LON,    /*!< Longitude. */
-    SINGLE_SAT_FLAG_SSP = 1 << SINGLE_SAT_FIELD_SSP,    /*!< SSP grid square */
-    SINGLE_SAT_FLAG_FOOTPRINT = 1 << SINGLE_SAT_FIELD_FOOTPRINT,        /*!< Footprint. */
-    SINGLE_SAT_FLAG_ALT = 1 << SINGLE_SAT_FIELD_ALT,    /*!< Altitude. */
-    SINGLE_SAT_FLAG_VEL = 1 << SINGLE_SAT_FIELD_VEL,    /*!< Velocity. */
-    SINGLE_SAT_FLAG_DOPPLER = 1 << SINGLE_SAT_FIELD_DOPPLER,    /*!< Doppler shift. */
-    SINGLE_SAT_FLAG_LOSS = 1 << SINGLE_SAT_FIELD_LOSS,  /*!< Path Loss. */
-    SINGLE_SAT_FLAG_DELAY = 1 << SINGLE_SAT_FIELD_DELAY,        /*!< Delay */
-    SINGLE_SAT_FLAG_MA = 1 << SINGLE_SAT_FIELD_MA,      /*!< Mean Anomaly. */
-    SINGLE_SAT_FLAG_PHASE = 1 << SINGLE_SAT_FIELD_PHASE,        /*!< Phase. */
-    SINGLE_SAT_FLAG_ORBIT = 1 << SINGLE_SAT_FIELD_ORBIT,        /*!< Orbit Number. */
-    SINGLE_SAT_FLAG_VISIBILITY = 1 << SINGLE_SAT_FIELD_VISIBILITY       /*!< Visibility. */
-} single_sat_flag_t;
 
 #define GTK_TYPE_SINGLE_SAT          (gtk_single_sat_get_type ())
 #define GTK_SINGLE_SAT(obj)          G_TYPE_CHECK_INSTANCE_CAST (obj,\
@@ -97,6 +45,7 @@ struct _gtk_single_sat {
     GKeyFile       *cfgdata;    /*!< Configuration data. */
     GSList         *sats;       /*!< Satellites. */
     qth_t          *qth;        /*!< Pointer to current location. */
+    sat_table_t    *state;      /*!< per-tick satellite state; set by GtkSatModule */
 
 
     guint32         flags;      /*!< Flags indicating which columns are visible. */
@@ -106,6 +55,11 @@ struct _gtk_single_sat {
 
     gdouble         tstamp;     /*!< time stamp of calculations; update by GtkSatModule */
 
+    gint64          shown[SINGLE_SAT_FIELD_NUMBER];     /*!< Quantised value shown by each label. */
+    guint32         shown_valid;        /*!< Fields whose shown[] entry is current. */
+    guint           shown_units;        /*!< Unit settings used for shown[]. */
+    gchar          *shown_tfmt; /*!< Time format used for shown[]. */
+
     void            (*update) (GtkWidget * widget);     /*!< update function */
 };
 
@@ -77,7 +77,8 @@ static void gtk_sky_glance_init(GtkSkyGlance * skg,
     skg->sats = NULL;
     skg->qth = NULL;
     skg->passes = NULL;
-    skg->satlab = NULL;
+    skg->rows = NULL;
+    skg->boxes = NULL;
     skg->x0 = 0;
     skg->y0 = 0;
     skg->w = 0;
@@ -101,34 +102,26 @@ static void gtk_sky_glance_init(GtkSkyGlance * skg,
  */
 static void gtk_sky_glance_destroy(GtkWidget * widget)
 {
-    sky_pass_t     *skypass;
-    guint           i, n;
+    GtkSkyGlance   *skg = GTK_SKY_GLANCE(widget);
+    guint           i;
 
     /* free passes */
-    /* FIXME: TBC whether this is enough */
-    if (GTK_SKY_GLANCE(widget)->passes != NULL)
+    if (skg->passes != NULL)
     {
-        n = g_slist_length(GTK_SKY_GLANCE(widget)->passes);
-        for (i = 0; i < n; i++)
-        {
-            skypass =
-                (sky_pass_t *) g_slist_nth_data(GTK_SKY_GLANCE(widget)->passes,
-                                                i);
-            free_pass(skypass->pass);
-            g_free(skypass);
-        }
+        for (i = 0; i < skg->passes->len; i++)
+            free_pass(g_array_index(skg->passes, sky_pass_t, i).pass);
 
-        g_slist_free(GTK_SKY_GLANCE(widget)->passes);
-        GTK_SKY_GLANCE(widget)->passes = NULL;
+        g_array_free(skg->passes, TRUE);
+        skg->passes = NULL;
     }
 
-    /* for the rest we only need to free the GSList because the
+    /* for the rest we only need to free the containers because the
        canvas items will be freed when removed from canvas.
      */
-    if (GTK_SKY_GLANCE(widget)->satlab != NULL)
+    if (skg->rows != NULL)
     {
-        g_slist_free(GTK_SKY_GLANCE(widget)->satlab);
-        GTK_SKY_GLANCE(widget)->satlab = NULL;
+        g_array_free(skg->rows, TRUE);
+        skg->rows = NULL;
     }
     if (GTK_SKY_GLANCE(widget)->majors != NULL)
     {
@@ -226,6 +219,219 @@ static gdouble x2t(GtkSkyGlance * skg, gdouble x)
     return (skg->ts + frac * (skg->te - skg->ts));
 }
 
+/* Top of the boxes in a satellite row. */
+static gdouble row2y(GtkSkyGlance * skg, guint row)
+{
+    return row * (skg->pps + SKG_MARGIN) + SKG_MARGIN;
+}
+
+/**
+ * Find the pass under a point.
+ *
+ * @param skg The GtkSkyGlance widget.
+ * @param x The X coordinate.
+ * @param y The Y coordinate.
+ * @return The index of the pass in skg->passes or -1.
+ *
+ * The passes of a row are sorted by AOS and do not overlap, so the row is an
+ * interval index that can be searched with bisection.
+ */
+static gint pass_at(GtkSkyGlance * skg, gdouble x, gdouble y)
+{
+    sky_row_t      *row;
+    sky_pass_t     *skp;
+    guint           r, lo, hi, mid;
+    gdouble         t;
+
+    if (skg->rows == NULL || y < SKG_MARGIN)
+        return -1;
+
+    r = (guint) ((y - SKG_MARGIN) / (skg->pps + SKG_MARGIN));
+    if (r >= skg->rows->len || y > row2y(skg, r) + skg->pps)
+        return -1;
+
+    /* last pass with AOS before t; one pixel tolerance for short passes */
+    row = &g_array_index(skg->rows, sky_row_t, r);
+    t = x2t(skg, x + 1.0);
+    lo = row->first;
+    hi = row->first + row->num;
+    while (lo < hi)
+    {
+        mid = lo + (hi - lo) / 2;
+        if (g_array_index(skg->passes, sky_pass_t, mid).aos <= t)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    if (lo == row->first)
+        return -1;
+
+    skp = &g_array_index(skg->passes, sky_pass_t, lo - 1);
+    if (t2x(skg, skp->los) + 1.0 < x)
+        return -1;
+
+    return (gint) lo - 1;
+}
+
+/*
+ * Canvas item painting the passes.
+ *
+ * One canvas item per pass does not scale to modules with hundreds of
+ * satellites, so all passes are painted by a single item straight from
+ * skg->passes.
+ */
+typedef struct {
+    GooCanvasItemSimple parent;
+    GtkSkyGlance   *skg;
+} SkgPasses;
+
+typedef struct {
+    GooCanvasItemSimpleClass parent_class;
+} SkgPassesClass;
+
+static void skg_passes_update(GooCanvasItemSimple * simple, cairo_t * cr)
+{
+    GtkSkyGlance   *skg = ((SkgPasses *) simple)->skg;
+
+    (void)cr;
+
+    simple->bounds.x1 = skg->x0 - 1.0;
+    simple->bounds.y1 = skg->y0;
+    simple->bounds.x2 = skg->x0 + skg->w + 1.0;
+    simple->bounds.y2 = skg->y0 + skg->h;
+}
+
+static void set_source_rgba(cairo_t * cr, guint rgba)
+{
+    cairo_set_source_rgba(cr,
+                          ((rgba >> 24) & 0xFF) / 255.0,
+                          ((rgba >> 16) & 0xFF) / 255.0,
+                          ((rgba >> 8) & 0xFF) / 255.0,
+                          (rgba & 0xFF) / 255.0);
+}
+
+static void skg_passes_paint(GooCanvasItemSimple * simple, cairo_t * cr,
+                             const GooCanvasBounds * bounds)
+{
+    GtkSkyGlance   *skg = ((SkgPasses *) simple)->skg;
+    sky_row_t      *row;
+    sky_pass_t     *skp;
+    gdouble         t0, t1;
+    gdouble         x, y;
+    guint           r, i;
+
+    if (skg->rows == NULL)
+        return;
+
+    /* only the passes inside the exposed area */
+    t0 = x2t(skg, bounds->x1 - 1.0);
+    t1 = x2t(skg, bounds->x2 + 1.0);
+
+    cairo_save(cr);
+    cairo_set_antialias(cr, CAIRO_ANTIALIAS_NONE);
+    cairo_set_line_width(cr, 1.0);
+
+    for (r = 0; r < skg->rows->len; r++)
+    {
+        y = row2y(skg, r);
+        if (y > bounds->y2 || y + skg->pps < bounds->y1)
+            continue;
+
+        row = &g_array_index(skg->rows, sky_row_t, r);
+        for (i = row->first; i < row->first + row->num; i++)
+        {
+            skp = &g_array_index(skg->passes, sky_pass_t, i);
+            if (skp->los < t0)
+                continue;
+            if (skp->aos > t1)
+                break;
+
+            x = t2x(skg, skp->aos);
+            cairo_rectangle(cr, x, y, t2x(skg, skp->los) - x, skg->pps);
+        }
+
+        /* all boxes of a satellite share the colours */
+        set_source_rgba(cr, row->fcol);
+        cairo_fill_preserve(cr);
+        set_source_rgba(cr, row->bcol);
+        cairo_stroke(cr);
+    }
+
+    cairo_restore(cr);
+}
+
+static gboolean skg_passes_is_item_at(GooCanvasItemSimple * simple,
+                                      gdouble x, gdouble y, cairo_t * cr,
+                                      gboolean is_pointer_event)
+{
+    (void)cr;
+    (void)is_pointer_event;
+
+    return pass_at(((SkgPasses *) simple)->skg, x, y) >= 0;
+}
+
+static void skg_passes_class_init(SkgPassesClass * class, gpointer class_data)
+{
+    GooCanvasItemSimpleClass *simple_class;
+
+    (void)class_data;
+
+    simple_class = (GooCanvasItemSimpleClass *) class;
+    simple_class->simple_update = skg_passes_update;
+    simple_class->simple_paint = skg_passes_paint;
+    simple_class->simple_is_item_at = skg_passes_is_item_at;
+}
+
+static GType skg_passes_get_type(void)
+{
+    static GType    skg_passes_type = 0;
+
+    if (!skg_passes_type)
+    {
+        static const GTypeInfo skg_passes_info = {
+            sizeof(SkgPassesClass),
+            NULL,               /* base init */
+            NULL,               /* base finalise */
+            (GClassInitFunc) skg_passes_class_init,
+            NULL,               /* class finalise */
+            NULL,               /* class data */
+            sizeof(SkgPasses),
+            0,                  /* n_preallocs */
+            NULL,               /* instance init */
+            NULL
+        };
+
+        skg_passes_type = g_type_register_static(GOO_TYPE_CANVAS_ITEM_SIMPLE,
+                                                 "SkgPasses",
+                                                 &skg_passes_info, 0);
+    }
+
+    return skg_passes_type;
+}
+
+/** Place the label of a row next to its first pass. */
+static void place_row_label(GtkSkyGlance * skg, guint i)
+{
+    sky_row_t      *row;
+    sky_pass_t     *skp;
+    gdouble         x, y, w, h;
+
+    row = &g_array_index(skg->rows, sky_row_t, i);
+    skp = &g_array_index(skg->passes, sky_pass_t, row->first);
+
+    x = t2x(skg, skp->aos);
+    w = t2x(skg, skp->los) - x;
+    y = row2y(skg, i);
+    h = skg->pps;
+
+    if (x > (skg->x0 + 100))
+        g_object_set(row->label, "x", x - 5, "y", y + h / 2.0,
+                     "anchor", GOO_CANVAS_ANCHOR_E, NULL);
+    else
+        g_object_set(row->label, "x", x + w + 5, "y", y + h / 2.0,
+                     "anchor", GOO_CANVAS_ANCHOR_W, NULL);
+}
+
 /**
  * Manage new size allocation.
  *
@@ -239,12 +445,9 @@ static void size_allocate_cb(GtkWidget * widget, GtkAllocation * allocation,
     GtkSkyGlance   *skg;
     GooCanvasPoints *pts;
     GooCanvasItem  *obj;
-    gint            i, j, n;
-    guint           curcat;
+    gint            i, n;
     gdouble         th, tm;
     gdouble         xh, xm;
-    sky_pass_t     *skp;
-    gdouble         x, y, w, h;
 
     if (gtk_widget_get_realized(widget))
     {
@@ -332,43 +535,14 @@ static void size_allocate_cb(GtkWidget * widget, GtkAllocation * allocation,
             tm += 0.04167;
         }
 
-        /* update pass items */
-        n = g_slist_length(skg->passes);
-        j = -1;
-        curcat = 0;
-        y = 10.0;
-        h = 10.0;
-        for (i = 0; i < n; i++)
-        {
-            /* get pass */
-            skp = (sky_pass_t *) g_slist_nth_data(skg->passes, i);
-
-            x = t2x(skg, skp->pass->aos);
-            w = t2x(skg, skp->pass->los) - x;
-
-            /* new satellite? */
-            if (skp->catnum != curcat)
-            {
-                j++;
-                curcat = skp->catnum;
-                y = j * (skg->pps + SKG_MARGIN) + SKG_MARGIN;
-                h = skg->pps;
-
-                /* update label */
-                obj = g_slist_nth_data(skg->satlab, j);
-                if (x > (skg->x0 + 100))
-                    g_object_set(obj, "x", x - 5, "y", y + h / 2.0,
-                                 "anchor", GOO_CANVAS_ANCHOR_E, NULL);
-                else
-                    g_object_set(obj, "x", x + w + 5, "y", y + h / 2.0,
-                                 "anchor", GOO_CANVAS_ANCHOR_W, NULL);
-            }
-
-            g_object_set(skp->box,
-                         "x", x, "y", y, "width", w, "height", h, NULL);
-            /* need to raise item, otherwise it will not receive new events */
-            goo_canvas_item_raise(skp->box, NULL);
-        }
+        /* update satellite labels next to the first pass */
+        for (i = 0; skg->rows != NULL && i < (gint) skg->rows->len; i++)
+            place_row_label(skg, i);
+
+        /* pass boxes are painted from the new geometry */
+        if (skg->boxes != NULL)
+            goo_canvas_item_simple_changed(GOO_CANVAS_ITEM_SIMPLE(skg->boxes),
+                                           TRUE);
     }
 }
 
@@ -422,7 +596,7 @@ static gboolean on_motion_notify(GooCanvasItem * item, GooCanvasItem * target,
  * @return Always TRUE to prevent further propagation of the event.
  *
  * This function is called when the mouse button is released above
- * a satellite pass object.
+ * a satellite pass.
  */
 static gboolean on_button_release(GooCanvasItem * item, GooCanvasItem * target,
                                   GdkEventButton * event, gpointer data)
@@ -430,19 +604,16 @@ static gboolean on_button_release(GooCanvasItem * item, GooCanvasItem * target,
     GtkSkyGlance   *skg = GTK_SKY_GLANCE(data);
     pass_t         *pass;
     pass_t         *new_pass;
+    gint            idx;
 
+    (void)item;
     (void)target;
 
-    /* get pointer to pass_t structure */
-    pass = (pass_t *) g_object_get_data(G_OBJECT(item), "pass");
+    idx = pass_at(skg, event->x, event->y);
+    if (idx < 0)
+        return FALSE;
 
-    if (G_UNLIKELY(pass == NULL))
-    {
-        sat_log_log(SAT_LOG_LEVEL_ERROR,
-                    _("%s::%s: Could not retrieve pass_t object"),
-                    __FILE__, __func__);
-        return TRUE;
-    }
+    pass = g_array_index(skg->passes, sky_pass_t, idx).pass;
 
     switch (event->button)
     {
@@ -469,6 +640,49 @@ static gboolean on_button_release(GooCanvasItem * item, GooCanvasItem * target,
     return TRUE;
 }
 
+/** Show the pass summary of the pass under the pointer. */
+static gboolean on_query_tooltip(GooCanvasItem * item, gdouble x, gdouble y,
+                                 gboolean keyboard_tip, GtkTooltip * tooltip,
+                                 gpointer data)
+{
+    GtkSkyGlance   *skg = GTK_SKY_GLANCE(data);
+    pass_t         *pass;
+    gchar          *fmtstr;
+    gchar          *text;
+    gchar           aosstr[TIME_FORMAT_MAX_LENGTH];
+    gchar           losstr[TIME_FORMAT_MAX_LENGTH];
+    gchar           tcastr[TIME_FORMAT_MAX_LENGTH];
+    gint            idx;
+
+    (void)item;
+    (void)keyboard_tip;
+
+    idx = pass_at(skg, x, y);
+    if (idx < 0)
+        return FALSE;
+
+    pass = g_array_index(skg->passes, sky_pass_t, idx).pass;
+
+    fmtstr = sat_cfg_get_str(SAT_CFG_STR_TIME_FORMAT);
+    daynum_to_str(aosstr, TIME_FORMAT_MAX_LENGTH, fmtstr, pass->aos);
+    daynum_to_str(losstr, TIME_FORMAT_MAX_LENGTH, fmtstr, pass->los);
+    daynum_to_str(tcastr, TIME_FORMAT_MAX_LENGTH, fmtstr, pass->tca);
+    g_free(fmtstr);
+
+    text = g_markup_printf_escaped(_("<b>%s</b>\n"
+                                     "AOS: %s  Az:%.0f\302\260\n"
+                                     "TCA: %s  Az:%.0f\302\260  El:%.1f\302\260\n"
+                                     "LOS: %s  Az:%.0f\302\260\n"
+                                     "<i>Click for details</i>"),
+                                   pass->satname,
+                                   aosstr, pass->aos_az,
+                                   tcastr, pass->maxel_az, pass->max_el,
+                                   losstr, pass->los_az);
+    gtk_tooltip_set_markup(tooltip, text);
+    g_free(text);
+
+    return TRUE;
+}
 
 /**
  * Create the model for the GtkSkyGlance canvas
@@ -651,7 +865,7 @@ static void get_colors(guint i, guint * bcol, guint * fcol)
 }
 
 /**
- * Create canvas items for a satellite
+ * Add the passes of a satellite
  *
  * @param key Pointer to the hash key (catnum of sat)
  * @param value Pointer to the current satellite.
@@ -659,29 +873,22 @@ static void get_colors(guint i, guint * bcol, guint * fcol)
  *
  * This function is called by g_hash_table_foreach with each satellite in
  * the satellite hash table. It gets the passes for the current satellite
- * and creates the corresponding canvas items.
+ * and adds them as a new row together with the satellite label.
  */
 static void create_sat(gpointer key, gpointer value, gpointer data)
 {
     sat_t          *sat = SAT(value);
     GtkSkyGlance   *skg = GTK_SKY_GLANCE(data);
     GSList         *passes = NULL;
+    GSList         *node;
     gdouble         maxdt;
-    guint           i, n;
-    pass_t         *tmppass = NULL;
-    sky_pass_t     *skypass;
     guint           bcol, fcol; /* colors */
     GooCanvasItem  *root;
-    GooCanvasItem  *label;
+    sky_row_t       row;
+    sky_pass_t      skypass;
 
     (void)key;
 
-    /* tooltips vars */
-    gchar          *tooltip;    /* the complete tooltips string */
-    gchar           aosstr[100];        /* AOS time string */
-    gchar           losstr[100];        /* LOS time string */
-    gchar           tcastr[100];        /* TCA time string */
-
     /* get canvas root */
     root = goo_canvas_get_root_item(GOO_CANVAS(skg->canvas));
     get_colors(skg->satcnt++, &bcol, &fcol);
@@ -689,83 +896,55 @@ static void create_sat(gpointer key, gpointer value, gpointer data)
 
     /* get passes for satellite */
     passes = get_passes(sat, skg->qth, skg->ts, maxdt, 10);
-    n = g_slist_length(passes);
     sat_log_log(SAT_LOG_LEVEL_DEBUG,
                 _("%s:%d: %s has %d passes within %.4f days\n"),
-                __FILE__, __LINE__, sat->nickname, n, maxdt);
-
-    /* add sky_pass_t items to skg->passes */
-    if (passes != NULL)
+                __FILE__, __LINE__, sat->nickname, g_slist_length(passes),
+                maxdt);
+
+    if (passes == NULL)
+        return;
+
+    /* add pass items; get_passes() returns them by AOS */
+    row.catnum = sat->tle.catnr;
+    row.first = skg->passes->len;
+    row.bcol = bcol;
+    row.fcol = fcol;
+    skypass.row = skg->rows->len;
+    for (node = passes; node != NULL; node = node->next)
     {
-        /* add pass items */
-        for (i = 0; i < n; i++)
-        {
-            skypass = g_try_new(sky_pass_t, 1);
-            if (skypass == NULL)
-            {
-                sat_log_log(SAT_LOG_LEVEL_ERROR,
-                            _("%s:%s: Could not allocate memory."),
-                            __FILE__, __func__);
-                continue;
-            }
-
-            /* create pass structure items */
-            skypass->catnum = sat->tle.catnr;
-            tmppass = (pass_t *) g_slist_nth_data(passes, i);
-            skypass->pass = copy_pass(tmppass);
-
-            daynum_to_str(aosstr, TIME_FORMAT_MAX_LENGTH,
-                          sat_cfg_get_str(SAT_CFG_STR_TIME_FORMAT),
-                          skypass->pass->aos);
-            daynum_to_str(losstr, TIME_FORMAT_MAX_LENGTH,
-                          sat_cfg_get_str(SAT_CFG_STR_TIME_FORMAT),
-                          skypass->pass->los);
-            daynum_to_str(tcastr, TIME_FORMAT_MAX_LENGTH,
-                          sat_cfg_get_str(SAT_CFG_STR_TIME_FORMAT),
-                          skypass->pass->tca);
-
-            /* box tooltip will contain pass summary */
-            tooltip = g_strdup_printf(_("<b>%s</b>\n"
-                                      "AOS: %s  Az:%.0f\302\260\n"
-                                      "TCA: %s  Az:%.0f\302\260  El:%.1f\302\260\n"
-                                      "LOS: %s  Az:%.0f\302\260\n"
-                                      "<i>Click for details</i>"),
-                                      skypass->pass->satname,
-                                      aosstr, skypass->pass->aos_az,
-                                      tcastr, skypass->pass->maxel_az,
-                                      skypass->pass->max_el, losstr,
-                                      skypass->pass->los_az);
-
-            skypass->box = goo_canvas_rect_new(root, 10, 10, 20, 20,
-                                               "stroke-color-rgba", bcol,
-                                               "fill-color-rgba", fcol,
-                                               "line-width", 1.0,
-                                               "antialias",
-                                               CAIRO_ANTIALIAS_NONE, "tooltip",
-                                               tooltip, "can-focus", TRUE,
-                                               NULL);
-            g_free(tooltip);
-
-            /* store this pass in list */
-            skg->passes = g_slist_append(skg->passes, skypass);
-
-            /* store a pointer to the pass data in the GooCanvasItem so that we
-               can access it later during various events, e.g mouse click */
-            g_object_set_data(G_OBJECT(skypass->box), "pass", skypass->pass);
-
-            g_signal_connect(skypass->box, "button_release_event",
-                             (GCallback) on_button_release, skg);
-        }
+        skypass.pass = PASS(node->data);
+        skypass.aos = skypass.pass->aos;
+        skypass.los = skypass.pass->los;
+        g_array_append_val(skg->passes, skypass);
+    }
+    row.num = skg->passes->len - row.first;
 
-        free_passes(passes);
+    /* the pass_t structures are now owned by skg->passes */
+    g_slist_free(passes);
 
-        /* add satellite label */
-        label = goo_canvas_text_new(root, sat->nickname,
+    /* add satellite label */
+    row.label = goo_canvas_text_new(root, sat->nickname,
                                     5, 0, -1, GOO_CANVAS_ANCHOR_W,
                                     "font", "Sans 8",
                                     "fill-color-rgba", bcol, NULL);
-        skg->satlab = g_slist_append(skg->satlab, label);
-    }
+    g_array_append_val(skg->rows, row);
+}
+
+/* Create the canvas item painting the passes. */
+static void create_boxes(GtkSkyGlance * skg)
+{
+    GooCanvasItem  *root;
+
+    root = goo_canvas_get_root_item(GOO_CANVAS(skg->canvas));
+    skg->boxes = g_object_new(skg_passes_get_type(), NULL);
+    ((SkgPasses *) skg->boxes)->skg = skg;
+    goo_canvas_item_add_child(root, skg->boxes, -1);
+    g_object_unref(skg->boxes);
+
+    g_signal_connect(skg->boxes, "button_release_event",
+                     (GCallback) on_button_release, skg);
+    g_signal_connect(skg->boxes, "query-tooltip",
+                     (GCallback) on_query_tooltip, skg);
 }
 
 /**
@@ -822,9 +1001,79 @@ GtkWidget      *gtk_sky_glance_new(GHashTable * sats, qth_t * qth, gdouble ts)
 
     /* Create the canvas items */
     create_canvas_items(skg);
+    skg->passes = g_array_sized_new(FALSE, FALSE, sizeof(sky_pass_t),
+                                    10 * skg->numsat);
+    skg->rows = g_array_sized_new(FALSE, FALSE, sizeof(sky_row_t),
+                                  skg->numsat);
     g_hash_table_foreach(skg->sats, create_sat, skg);
+    create_boxes(skg);
 
     gtk_box_pack_start(GTK_BOX(skg), skg->canvas, TRUE, TRUE, 0);
 
     return GTK_WIDGET(skg);
 }
+
+/**
+ * Replace the passes of a satellite whose elements have changed.
+ *
+ * @param skg The GtkSkyGlance widget.
+ * @param sat The satellite.
+ * @return FALSE if the satellite gains or loses its row; the widget has to
+ *         be rebuilt in that case.
+ *
+ * The satellite keeps its row, label and colours; only its slice of the
+ * pass array is recalculated.
+ */
+gboolean gtk_sky_glance_reload_sat(GtkSkyGlance * skg, sat_t * sat)
+{
+    GSList         *passes, *node;
+    sky_row_t      *row = NULL;
+    sky_row_t      *next;
+    sky_pass_t      skypass;
+    guint           r, i, num;
+
+    for (r = 0; r < skg->rows->len; r++)
+    {
+        row = &g_array_index(skg->rows, sky_row_t, r);
+        if (row->catnum == (guint) sat->tle.catnr)
+            break;
+    }
+    if (r == skg->rows->len)
+        return FALSE;
+
+    passes = get_passes(sat, skg->qth, skg->ts, skg->te - skg->ts, 10);
+    if (passes == NULL)
+        return FALSE;
+
+    /* drop the old passes of the row */
+    for (i = row->first; i < row->first + row->num; i++)
+        free_pass(g_array_index(skg->passes, sky_pass_t, i).pass);
+    g_array_remove_range(skg->passes, row->first, row->num);
+
+    /* insert the new ones in their place, still by AOS */
+    num = 0;
+    skypass.row = r;
+    for (node = passes; node != NULL; node = node->next)
+    {
+        skypass.pass = PASS(node->data);
+        skypass.aos = skypass.pass->aos;
+        skypass.los = skypass.pass->los;
+        g_array_insert_val(skg->passes, row->first + num, skypass);
+        num++;
+    }
+    g_slist_free(passes);
+
+    /* shift the rows below */
+    for (i = r + 1; i < skg->rows->len; i++)
+    {
+        next = &g_array_index(skg->rows, sky_row_t, i);
+        next->first = next->first - row->num + num;
+    }
+    row->num = num;
+
+    if (gtk_widget_get_realized(skg->canvas))
+        place_row_label(skg, r);
+    goo_canvas_item_simple_changed(GOO_CANVAS_ITEM_SIMPLE(skg->boxes), TRUE);
+
+    return TRUE;
+}
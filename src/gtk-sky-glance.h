@@ -53,13 +53,24 @@ typedef struct _GtkSkyGlance GtkSkyGlance;
 typedef struct _GtkSkyGlanceClass GtkSkyGlanceClass;
 
 
-/** Satellite object on graph. */
+/** Pass on graph. */
 typedef struct {
-    guint           catnum;     /* Catalog number of satellite */
+    gdouble         aos;        /* AOS (Julian date) */
+    gdouble         los;        /* LOS (Julian date) */
+    guint           row;        /* Row of the satellite */
     pass_t         *pass;       /* Details of the corresponding pass. */
-    GooCanvasItem  *box;        /* Canvas item showing the pass */
 } sky_pass_t;
 
+/** Satellite row on graph. */
+typedef struct {
+    guint           catnum;     /* Catalog number of satellite */
+    guint           first;      /* Index of the first pass in passes */
+    guint           num;        /* Number of passes */
+    guint           bcol;       /* Border colour (RGBA) */
+    guint           fcol;       /* Fill colour (RGBA) */
+    GooCanvasItem  *label;      /* Canvas item showing the satellite name */
+} sky_row_t;
+
 
 #define SKY_PASS_T(obj) ((sky_pass_t *)obj)
 
@@ -73,10 +84,9 @@ struct _GtkSkyGlance {
     GHashTable     *sats;       /* Local copy of satellites. */
     qth_t          *qth;        /* Pointer to current location. */
 
-    GSList         *passes;     /* Canvas items representing each pass.
-                                 * Each element in the list is of type sky_pass_t.
-                                 */
-    GSList         *satlab;     /* Canvas items showing satellite names. */
+    GArray         *passes;     /* sky_pass_t, by row and AOS. */
+    GArray         *rows;       /* sky_row_t, one per satellite with passes. */
+    GooCanvasItem  *boxes;      /* Canvas item painting all passes. */
 
 
     guint           x0;
@@ -113,6 +123,7 @@ struct _GtkSkyGlanceClass {
 
 GType           gtk_sky_glance_get_type(void);
 GtkWidget      *gtk_sky_glance_new(GHashTable * sats, qth_t * qth, gdouble ts);
+gboolean        gtk_sky_glance_reload_sat(GtkSkyGlance * skg, sat_t * sat);
 
 /* *INDENT-OFF* */
 #ifdef __cplusplus
@@ -0,0 +1,580 @@
+/*
+  OGpredict — extensions to Gpredict for operations planning
+
+  Copyright (C) 2025 Axel Osika <osikaaxel@gmail.com>
+
+  This file is part of OGpredict, a derivative of Gpredict.
+
+  OGpredict is free software: you can redistribute it and/or modify it
+  under the terms of the GNU General Public License as published by the
+  Free Software Foundation; either version 2 of the License, or (at your
+  option) any later version.  See the GNU General Public License for details.
+*/
+
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/**
+ * http-fetch.c — concurrent, conditional file downloads
+ *
+ * Downloads a list of URLs with the curl multi interface: up to
+ * max_parallel transfers run at the same time (multiplexed over one
+ * connection per host when the server speaks HTTP/2) and the completion
+ * callback is invoked for each file as soon as it is done, so the caller
+ * can parse it while the remaining transfers are still in flight.
+ *
+ * The validators of every successful download (ETag, Last-Modified) are
+ * returned in the item; the caller records them in a small key file with
+ * http_fetch_save_validators() once it has used the new content, so a
+ * file that was downloaded but could not be applied is requested in full
+ * again next time.  Items flagged conditional are requested with
+ * If-None-Match / If-Modified-Since; a 304 answer leaves the destination
+ * file alone and is reported as HTTP_FETCH_NOT_MODIFIED, so an unchanged
+ * catalog costs one request round trip per file, all of them in parallel.
+ *
+ * Bodies are received into "<file>.part" and renamed over the destination
+ * only on success; a failed or not-modified transfer never truncates the
+ * previous copy.
+ *
+ * Nothing here depends on a particular server: pointing the URLs at a
+ * local HTTP server (or file:// URLs) that serves fixture files exercises
+ * the same code path as the real catalogs.
+ *
+ * On Windows the files are fetched one by one with win32_fetch() and
+ * without validators.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <build-config.h>
+#endif
+
+#include <errno.h>
+#include <glib/gi18n.h>
+#include <glib/gstdio.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifdef WIN32
+#include "win32-fetch.h"
+#else
+#include <curl/curl.h>
+#endif
+
+#include "http-fetch.h"
+#include "sat-log.h"
+
+#define HTTP_FETCH_DEF_PARALLEL 4
+#define HTTP_FETCH_DEF_TIMEOUT  10
+#define HTTP_FETCH_DEF_AGENT    "gpredict/curl"
+
+/** Upper bound for one wait in the transfer loop [ms]. */
+#define HTTP_FETCH_MAX_WAIT 100
+
+#define META_KEY_URL     "URL"
+#define META_KEY_ETAG    "ETAG"
+#define META_KEY_LASTMOD "LAST_MODIFIED"
+
+
+/** Initialise download parameters with the defaults. */
+void http_fetch_params_init(http_fetch_params_t * params)
+{
+    memset(params, 0, sizeof(*params));
+    params->user_agent = HTTP_FETCH_DEF_AGENT;
+    params->max_parallel = HTTP_FETCH_DEF_PARALLEL;
+    params->connect_timeout = HTTP_FETCH_DEF_TIMEOUT;
+}
+
+/** Free the error strings and validators of a set of items. */
+void http_fetch_items_clear(http_fetch_item_t * items, guint n)
+{
+    guint           i;
+
+    for (i = 0; i < n; i++)
+    {
+        g_clear_pointer(&items[i].error, g_free);
+        g_clear_pointer(&items[i].etag, g_free);
+        g_clear_pointer(&items[i].lastmod, g_free);
+    }
+}
+
+/* Validator cache: one group per URL, named by the URL digest. */
+
+static GKeyFile *meta_load(const gchar * fname)
+{
+    GKeyFile       *meta = g_key_file_new();
+
+    if (fname != NULL && g_file_test(fname, G_FILE_TEST_EXISTS))
+    {
+        if (!g_key_file_load_from_file(meta, fname, G_KEY_FILE_NONE, NULL))
+            sat_log_log(SAT_LOG_LEVEL_WARN,
+                        _("%s: Ignoring unreadable cache data %s"),
+                        __func__, fname);
+    }
+
+    return meta;
+}
+
+static gboolean meta_save(GKeyFile * meta, const gchar * fname)
+{
+    GError         *err = NULL;
+    gchar          *buf;
+    gsize           len;
+    gboolean        ok;
+
+    buf = g_key_file_to_data(meta, &len, NULL);
+    ok = g_file_set_contents(fname, buf, len, &err);
+    if (!ok)
+    {
+        sat_log_log(SAT_LOG_LEVEL_ERROR,
+                    _("%s: Could not save %s (%s)"),
+                    __func__, fname, err->message);
+        g_clear_error(&err);
+    }
+    g_free(buf);
+
+    return ok;
+}
+
+static gchar   *meta_group(const gchar * url)
+{
+    return g_compute_checksum_for_string(G_CHECKSUM_SHA1, url, -1);
+}
+
+/**
+ * Record the validators of the updated items.
+ *
+ * @param items The items of a finished http_fetch_run().
+ * @param n Number of items.
+ * @param meta_file The validator cache used for conditional requests.
+ * @return FALSE if the cache could not be written.
+ *
+ * Call this only after the new content has been put to use.  Items that
+ * were not updated keep their previous validators; pass only the items
+ * that were applied.
+ */
+gboolean http_fetch_save_validators(const http_fetch_item_t * items,
+                                    guint n, const gchar * meta_file)
+{
+    const http_fetch_item_t *item;
+    GKeyFile       *meta;
+    gchar          *group;
+    gboolean        changed = FALSE;
+    gboolean        ok = TRUE;
+    guint           i;
+
+    if (meta_file == NULL)
+        return TRUE;
+
+    meta = meta_load(meta_file);
+    for (i = 0; i < n; i++)
+    {
+        item = &items[i];
+        if (item->status != HTTP_FETCH_UPDATED)
+            continue;
+
+        group = meta_group(item->url);
+        g_key_file_remove_group(meta, group, NULL);
+        if (item->etag != NULL || item->lastmod != NULL)
+        {
+            g_key_file_set_string(meta, group, META_KEY_URL, item->url);
+            if (item->etag != NULL)
+                g_key_file_set_string(meta, group, META_KEY_ETAG,
+                                      item->etag);
+            if (item->lastmod != NULL)
+                g_key_file_set_string(meta, group, META_KEY_LASTMOD,
+                                      item->lastmod);
+        }
+        g_free(group);
+        changed = TRUE;
+    }
+
+    if (changed)
+        ok = meta_save(meta, meta_file);
+    g_key_file_free(meta);
+
+    return ok;
+}
+
+/** Replace the ".part" file over the destination. */
+static gboolean commit_part(const gchar * part, const gchar * file,
+                            gchar ** error)
+{
+#ifdef WIN32
+    /* rename() does not replace an existing file on Windows */
+    g_remove(file);
+#endif
+    if (g_rename(part, file) != 0)
+    {
+        *error = g_strdup_printf(_("Could not rename %s (%s)"),
+                                 part, g_strerror(errno));
+        g_remove(part);
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+#ifdef WIN32
+
+guint http_fetch_run(http_fetch_item_t * items, guint n,
+                     const http_fetch_params_t * params,
+                     http_fetch_done_func done, gpointer data)
+{
+    http_fetch_item_t *item;
+    FILE           *outfile;
+    gchar          *part;
+    guint           i, ok = 0;
+    int             res;
+
+    for (i = 0; i < n; i++)
+    {
+        item = &items[i];
+        item->status = HTTP_FETCH_FAILED;
+        item->response = 0;
+        item->error = NULL;
+        item->etag = NULL;
+        item->lastmod = NULL;
+
+        part = g_strconcat(item->file, ".part", NULL);
+        outfile = g_fopen(part, "wb");
+        if (outfile == NULL)
+        {
+            item->error = g_strdup_printf(_("Could not open %s"), part);
+        }
+        else
+        {
+            res = win32_fetch((char *)item->url, outfile,
+                              (char *)params->proxy, "gpredict/win32");
+            fclose(outfile);
+
+            if (res != 0)
+            {
+                item->error = g_strdup_printf("%x", res);
+                g_remove(part);
+            }
+            else if (commit_part(part, item->file, &item->error))
+            {
+                item->status = HTTP_FETCH_UPDATED;
+            }
+        }
+        g_free(part);
+
+        if (done != NULL)
+            done(item, data);
+        if (item->status != HTTP_FETCH_FAILED)
+            ok++;
+    }
+
+    return ok;
+}
+
+#else
+
+/** One running transfer. */
+typedef struct {
+    http_fetch_item_t *item;
+    CURL           *curl;
+    FILE           *outfile;
+    gchar          *part;
+    struct curl_slist *headers;
+    gchar          *etag;       /* validators of the final response */
+    gchar          *lastmod;
+} transfer_t;
+
+static void transfer_free(transfer_t * tr)
+{
+    if (tr->outfile != NULL)
+        fclose(tr->outfile);
+    if (tr->curl != NULL)
+        curl_easy_cleanup(tr->curl);
+    curl_slist_free_all(tr->headers);
+    g_free(tr->part);
+    g_free(tr->etag);
+    g_free(tr->lastmod);
+    g_free(tr);
+}
+
+static size_t write_func(void *ptr, size_t size, size_t nmemb, void *data)
+{
+    transfer_t     *tr = data;
+
+    return fwrite(ptr, size, nmemb, tr->outfile);
+}
+
+/** Return the value of header line if it is called name, else NULL. */
+static gchar   *header_value(const gchar * line, gsize len,
+                             const gchar * name)
+{
+    gsize           nlen = strlen(name);
+
+    if (len <= nlen || line[nlen] != ':' ||
+        g_ascii_strncasecmp(line, name, nlen) != 0)
+        return NULL;
+
+    return g_strstrip(g_strndup(line + nlen + 1, len - nlen - 1));
+}
+
+static size_t header_func(char *ptr, size_t size, size_t nmemb, void *data)
+{
+    transfer_t     *tr = data;
+    gsize           len = size * nmemb;
+    gchar          *val;
+
+    /* a new status line starts the headers of the next response
+       (redirect, 100 Continue); only the last one counts */
+    if (len > 5 && strncmp(ptr, "HTTP/", 5) == 0)
+    {
+        g_clear_pointer(&tr->etag, g_free);
+        g_clear_pointer(&tr->lastmod, g_free);
+    }
+    else if ((val = header_value(ptr, len, "ETag")) != NULL)
+    {
+        g_free(tr->etag);
+        tr->etag = val;
+    }
+    else if ((val = header_value(ptr, len, "Last-Modified")) != NULL)
+    {
+        g_free(tr->lastmod);
+        tr->lastmod = val;
+    }
+
+    return len;
+}
+
+static transfer_t *transfer_new(http_fetch_item_t * item,
+                                const http_fetch_params_t * params,
+                                GKeyFile * meta)
+{
+    transfer_t     *tr;
+    gchar          *group;
+    gchar          *val;
+    gchar          *hdr;
+
+    tr = g_new0(transfer_t, 1);
+    tr->item = item;
+    tr->part = g_strconcat(item->file, ".part", NULL);
+    tr->outfile = g_fopen(tr->part, "wb");
+    if (tr->outfile == NULL)
+    {
+        item->error = g_strdup_printf(_("Could not open %s (%s)"),
+                                      tr->part, g_strerror(errno));
+        transfer_free(tr);
+        return NULL;
+    }
+
+    tr->curl = curl_easy_init();
+    curl_easy_setopt(tr->curl, CURLOPT_URL, item->url);
+    if (params->proxy != NULL)
+        curl_easy_setopt(tr->curl, CURLOPT_PROXY, params->proxy);
+    curl_easy_setopt(tr->curl, CURLOPT_USERAGENT,
+                     params->user_agent ? params->user_agent :
+                     HTTP_FETCH_DEF_AGENT);
+    curl_easy_setopt(tr->curl, CURLOPT_CONNECTTIMEOUT,
+                     params->connect_timeout > 0 ? params->connect_timeout :
+                     HTTP_FETCH_DEF_TIMEOUT);
+    curl_easy_setopt(tr->curl, CURLOPT_FOLLOWLOCATION, 1L);
+    curl_easy_setopt(tr->curl, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(tr->curl, CURLOPT_WRITEFUNCTION, write_func);
+    curl_easy_setopt(tr->curl, CURLOPT_WRITEDATA, tr);
+    curl_easy_setopt(tr->curl, CURLOPT_HEADERFUNCTION, header_func);
+    curl_easy_setopt(tr->curl, CURLOPT_HEADERDATA, tr);
+#if LIBCURL_VERSION_NUM >= 0x071506
+    /* element sets compress about 3:1 */
+    curl_easy_setopt(tr->curl, CURLOPT_ACCEPT_ENCODING, "");
+#endif
+#ifdef CURLPIPE_MULTIPLEX
+    /* wait for the connection to the same host instead of opening another */
+    curl_easy_setopt(tr->curl, CURLOPT_PIPEWAIT, 1L);
+#endif
+
+    if (item->conditional)
+    {
+        group = meta_group(item->url);
+
+        val = g_key_file_get_string(meta, group, META_KEY_ETAG, NULL);
+        if (val != NULL)
+        {
+            hdr = g_strconcat("If-None-Match: ", val, NULL);
+            tr->headers = curl_slist_append(tr->headers, hdr);
+            g_free(hdr);
+            g_free(val);
+        }
+        val = g_key_file_get_string(meta, group, META_KEY_LASTMOD, NULL);
+        if (val != NULL)
+        {
+            hdr = g_strconcat("If-Modified-Since: ", val, NULL);
+            tr->headers = curl_slist_append(tr->headers, hdr);
+            g_free(hdr);
+            g_free(val);
+        }
+        g_free(group);
+
+        if (tr->headers != NULL)
+            curl_easy_setopt(tr->curl, CURLOPT_HTTPHEADER, tr->headers);
+    }
+
+    return tr;
+}
+
+/** Conclude a finished transfer. */
+static void transfer_finish(transfer_t * tr, CURLcode res)
+{
+    http_fetch_item_t *item = tr->item;
+
+    fclose(tr->outfile);
+    tr->outfile = NULL;
+    curl_easy_getinfo(tr->curl, CURLINFO_RESPONSE_CODE, &item->response);
+
+    if (res != CURLE_OK)
+    {
+        item->error = g_strdup(curl_easy_strerror(res));
+    }
+    else if (item->response == 304)
+    {
+        item->status = HTTP_FETCH_NOT_MODIFIED;
+    }
+    else if (item->response >= 400)
+    {
+        item->error = g_strdup_printf(_("HTTP error %ld"), item->response);
+    }
+    else if (commit_part(tr->part, item->file, &item->error))
+    {
+        /* handed to the caller, see http_fetch_save_validators() */
+        item->status = HTTP_FETCH_UPDATED;
+        item->etag = tr->etag;
+        item->lastmod = tr->lastmod;
+        tr->etag = NULL;
+        tr->lastmod = NULL;
+        return;
+    }
+
+    g_remove(tr->part);
+}
+
+/** Wait until one of the transfers has something to do. */
+static void wait_transfers(CURLM * multi)
+{
+#if LIBCURL_VERSION_NUM >= 0x074200
+    /* also returns at once when curl has no socket to wait on yet */
+    curl_multi_poll(multi, NULL, 0, HTTP_FETCH_MAX_WAIT, NULL);
+#else
+    long            timeo = -1;
+    int             numfds = 0;
+
+    curl_multi_timeout(multi, &timeo);
+    if (timeo < 0 || timeo > HTTP_FETCH_MAX_WAIT)
+        timeo = HTTP_FETCH_MAX_WAIT;
+    if (timeo == 0)
+        return;
+
+    curl_multi_wait(multi, NULL, 0, timeo, &numfds);
+    if (numfds == 0)
+        /* curl is waiting for something other than a socket
+           (name resolution, retry timer); curl_multi_wait() returns
+           immediately then */
+        g_usleep(MIN(timeo, 10) * 1000);
+#endif
+}
+
+/**
+ * Download a set of files.
+ *
+ * @param items The files to fetch; status, response, error and the
+ *              validators are set.
+ * @param n Number of items.
+ * @param params Download parameters (see http_fetch_params_init()).
+ * @param done Called for each item when its transfer is over (can be NULL).
+ * @param data User data passed to done.
+ * @return The number of items that did not fail.
+ *
+ * The call returns when all transfers are over.  The validator cache is
+ * only read; record the new validators with http_fetch_save_validators()
+ * after the files have been used.  Free the error strings and validators
+ * with http_fetch_items_clear().
+ */
+guint http_fetch_run(http_fetch_item_t * items, guint n,
+                     const http_fetch_params_t * params,
+                     http_fetch_done_func done, gpointer data)
+{
+    CURLM          *multi;
+    CURLMsg        *msg;
+    GKeyFile       *meta;
+    transfer_t     *tr;
+    http_fetch_item_t *item;
+    guint           max_parallel;
+    guint           next = 0, active = 0, ok = 0;
+    int             running, left;
+
+    for (next = 0; next < n; next++)
+    {
+        items[next].status = HTTP_FETCH_FAILED;
+        items[next].response = 0;
+        items[next].error = NULL;
+        items[next].etag = NULL;
+        items[next].lastmod = NULL;
+    }
+    next = 0;
+
+    max_parallel = params->max_parallel > 0 ? params->max_parallel :
+        HTTP_FETCH_DEF_PARALLEL;
+    meta = meta_load(params->meta_file);
+
+    multi = curl_multi_init();
+#ifdef CURLPIPE_MULTIPLEX
+    curl_multi_setopt(multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+#endif
+
+    while (next < n || active > 0)
+    {
+        /* keep the pipe full */
+        while (next < n && active < max_parallel)
+        {
+            tr = transfer_new(&items[next], params, meta);
+            if (tr == NULL)
+            {
+                if (done != NULL)
+                    done(&items[next], data);
+            }
+            else
+            {
+                curl_easy_setopt(tr->curl, CURLOPT_PRIVATE, tr);
+                curl_multi_add_handle(multi, tr->curl);
+                active++;
+            }
+            next++;
+        }
+
+        if (active == 0)
+            continue;
+
+        curl_multi_perform(multi, &running);
+
+        while ((msg = curl_multi_info_read(multi, &left)) != NULL)
+        {
+            if (msg->msg != CURLMSG_DONE)
+                continue;
+
+            curl_easy_getinfo(msg->easy_handle, CURLINFO_PRIVATE, &tr);
+            curl_multi_remove_handle(multi, tr->curl);
+            active--;
+
+            item = tr->item;
+            transfer_finish(tr, msg->data.result);
+            transfer_free(tr);
+
+            if (done != NULL)
+                done(item, data);
+            if (item->status != HTTP_FETCH_FAILED)
+                ok++;
+        }
+
+        if (running > 0)
+            wait_transfers(multi);
+    }
+
+    curl_multi_cleanup(multi);
+    g_key_file_free(meta);
+
+    return ok;
+}
+
+#endif
@@ -0,0 +1,84 @@
+/*
+  OGpredict — extensions to Gpredict for operations planning
+
+  Copyright (C) 2025 Axel Osika <osikaaxel@gmail.com>
+
+  This file is part of OGpredict, a derivative of Gpredict.
+
+  OGpredict is free software: you can redistribute it and/or modify it
+  under the terms of the GNU General Public License as published by the
+  Free Software Foundation; either version 2 of the License, or (at your
+  option) any later version.  See the GNU General Public License for details.
+*/
+
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#ifndef __HTTP_FETCH_H__
+#define __HTTP_FETCH_H__ 1
+
+#include <glib.h>
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/** Outcome of one transfer. */
+typedef enum {
+    HTTP_FETCH_FAILED = 0,      /*!< Transfer or server error; file untouched */
+    HTTP_FETCH_UPDATED,         /*!< New content written to the file */
+    HTTP_FETCH_NOT_MODIFIED     /*!< Server answered 304; file untouched */
+} http_fetch_status_t;
+
+/** One file to download. */
+typedef struct {
+    const gchar    *url;        /*!< Source URL (http, https or file) */
+    const gchar    *file;       /*!< Destination file, replaced on success */
+    gboolean        conditional;        /*!< Send If-None-Match / If-Modified-Since */
+    gpointer        data;       /*!< Caller data, not used by the fetcher */
+
+    http_fetch_status_t status; /*!< Set when the transfer completes */
+    glong           response;   /*!< HTTP response code (0 for non-HTTP) */
+    gchar          *error;      /*!< Error message when status is FAILED */
+    gchar          *etag;       /*!< ETag of an UPDATED response or NULL */
+    gchar          *lastmod;    /*!< Last-Modified of an UPDATED response or NULL */
+} http_fetch_item_t;
+
+/** Download parameters. */
+typedef struct {
+    const gchar    *proxy;      /*!< Proxy or NULL */
+    const gchar    *user_agent; /*!< User agent string or NULL */
+    const gchar    *meta_file;  /*!< Validators sent with conditional requests or NULL */
+    guint           max_parallel;       /*!< Concurrent transfers; 0 = default */
+    glong           connect_timeout;    /*!< Seconds; 0 = default */
+} http_fetch_params_t;
+
+/**
+ * Completion callback.
+ *
+ * Called in the calling thread as soon as one transfer is finished, while
+ * the others are still running.  Heavy work here delays the other
+ * transfers only by what does not fit in the socket buffers.  The callback
+ * may set the status of an UPDATED item to HTTP_FETCH_FAILED (with an
+ * error message) if the content is unusable; the item then counts as
+ * failed and its validators are not saved.
+ */
+typedef void    (*http_fetch_done_func) (http_fetch_item_t * item,
+                                         gpointer data);
+
+void            http_fetch_params_init(http_fetch_params_t * params);
+guint           http_fetch_run(http_fetch_item_t * items, guint n,
+                               const http_fetch_params_t * params,
+                               http_fetch_done_func done, gpointer data);
+gboolean        http_fetch_save_validators(const http_fetch_item_t * items,
+                                           guint n, const gchar * meta_file);
+void            http_fetch_items_clear(http_fetch_item_t * items, guint n);
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+}
+#endif
+/* *INDENT-ON* */
+
+#endif
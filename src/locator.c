@@ -60,7 +60,6 @@
 #include <ctype.h>
 #include <math.h>
 
-#include "gpredict-utils.h"
 #include "locator.h"
 
 
@@ -71,6 +70,12 @@
 /* arc length for 1 degree, 60 Nautical Miles */
 #define ARC_IN_KM 111.2
 
+/* mean earth radius used by the great-circle kernels */
+#define EARTH_RADIUS_KM 6371.0
+
+/* elements converted per block by longlat2locator_n() */
+#define LOC_BLOCK 64
+
 /* The following is contributed by Dave Hines M1CXW
  *
  * begin dph
@@ -445,6 +450,210 @@ int longlat2locator(double longitude, double latitude, char *locator, int pair_c
 
 /* end dph */
 
+/**
+ * \brief Convert an array of Maidenhead grid locators to longitude/latitude
+ * \param longitude     Array of \a n longitudes, decimal degrees
+ * \param latitude     Array of \a n latitudes, decimal degrees
+ * \param locators     Array of \a n locators
+ * \param n     Number of locators
+ *
+ *  Same conversion as locator2longlat() for each element.  Locators that
+ *  can not be converted yield NAN for both values.
+ *
+ * \return The number of locators converted.
+ *
+ * \sa locator2longlat()
+ */
+int locator2longlat_n (double *longitude, double *latitude,
+                       const char *const *locators, int n) {
+     int i, ok = 0;
+
+     for (i = 0;  i < n;  ++i) {
+          if (locators[i] &&
+              locator2longlat(&longitude[i], &latitude[i], locators[i]) == RIG_OK) {
+               ++ok;
+          } else {
+               longitude[i] = NAN;
+               latitude[i] = NAN;
+          }
+     }
+
+     return ok;
+}
+
+/**
+ * \brief Convert arrays of longitude/latitude to Maidenhead grid locators
+ * \param longitude     Array of \a n longitudes, decimal degrees
+ * \param latitude     Array of \a n latitudes, decimal degrees
+ * \param locators     Output, \a n locators of \a pair_count * 2 + 1 chars
+ * \param pair_count     Precision expressed as lon/lat pairs in the locator
+ * \param n     Number of positions
+ *
+ *  Same result as longlat2locator() for each element.  Locator i is stored
+ *  at \a locators + i * (\a pair_count * 2 + 1).  The elements are
+ *  converted in blocks, one locator pair at a time, so the inner loops are
+ *  branch free and can be vectorised by the compiler.
+ *
+ * \retval -RIG_EINVAL if \a locators is NULL or \a pair_count exceeds
+ *  length limit.
+ * \retval RIG_OK if conversion went OK.
+ *
+ * \sa longlat2locator()
+ */
+int longlat2locator_n (const double *longitude, const double *latitude,
+                       char *locators, int pair_count, int n) {
+     double x[LOC_BLOCK], y[LOC_BLOCK];
+     double square_size;
+     int stride = pair_count * 2 + 1;
+     int first, count, i, pair, divisions, vx, vy;
+     char base;
+     char *loc;
+
+     if (!locators)
+          return -RIG_EINVAL;
+
+     if (pair_count < MIN_LOCATOR_PAIRS || pair_count > MAX_LOCATOR_PAIRS)
+          return -RIG_EINVAL;
+
+     for (first = 0;  first < n;  first += LOC_BLOCK) {
+          count = (n - first < LOC_BLOCK) ? n - first : LOC_BLOCK;
+          loc = locators + first * stride;
+
+          /* The 1e-6 here guards against floating point rounding errors */
+          for (i = 0;  i < count;  ++i) {
+               x[i] = fmod(longitude[first + i] / 2.0 + 270.000001, 180.0);
+               y[i] = fmod(latitude[first + i] + 270.000001, 180.0);
+          }
+
+          divisions = 1;
+          for (pair = 0;  pair < pair_count;  ++pair) {
+               divisions *= loc_char_range[pair];
+               square_size = 180.0 / divisions;
+               base = (loc_char_range[pair] == 10) ? '0' : 'A';
+
+               for (i = 0;  i < count;  ++i) {
+                    vx = (int) (x[i] / square_size);
+                    vy = (int) (y[i] / square_size);
+                    x[i] -= square_size * vx;
+                    y[i] -= square_size * vy;
+                    loc[i * stride + pair * 2] = base + vx;
+                    loc[i * stride + pair * 2 + 1] = base + vy;
+               }
+          }
+
+          for (i = 0;  i < count;  ++i)
+               loc[i * stride + pair_count * 2] = '\0';
+     }
+
+     return RIG_OK;
+}
+
+/*
+ * Haversine distance and forward azimuth; shared by the scalar and batch
+ * great-circle functions.  Angles in radians, bearing in [0, 360).
+ */
+static inline double gc_dist (double phi1, double cos_phi1,
+                              double phi2, double cos_phi2, double dlam) {
+     double s1 = sin((phi2 - phi1) / 2.0);
+     double s2 = sin(dlam / 2.0);
+     double h = s1 * s1 + cos_phi1 * cos_phi2 * s2 * s2;
+
+     /* rounding takes h just above 1 for antipodal points */
+     h = h < 1.0 ? h : 1.0;
+
+     return 2.0 * EARTH_RADIUS_KM * atan2(sqrt(h), sqrt(1.0 - h));
+}
+
+static inline double gc_brg (double sin_phi1, double cos_phi1,
+                             double sin_phi2, double cos_phi2, double dlam) {
+     double theta = RADIAN * atan2(sin(dlam) * cos_phi2,
+                                   cos_phi1 * sin_phi2 -
+                                   sin_phi1 * cos_phi2 * cos(dlam));
+
+     /* a tiny negative angle rounds to 360.0 when wrapped; that is 0 */
+     theta += (theta < 0.0) ? 360.0 : 0.0;
+     return (theta >= 360.0) ? theta - 360.0 : theta;
+}
+
+/**
+ * \brief Great-circle distance between two points
+ * \param lat1     Latitude of the first point, decimal degrees
+ * \param lon1     Longitude of the first point, decimal degrees
+ * \param lat2     Latitude of the second point, decimal degrees
+ * \param lon2     Longitude of the second point, decimal degrees
+ *
+ * \return The haversine distance in kilometers on a sphere of the mean
+ *  earth radius.
+ *
+ * \sa gc_distance_bearing_n(), qrb()
+ */
+double gc_distance_km (double lat1, double lon1, double lat2, double lon2) {
+     double phi1 = lat1 / RADIAN;
+     double phi2 = lat2 / RADIAN;
+
+     return gc_dist(phi1, cos(phi1), phi2, cos(phi2), (lon2 - lon1) / RADIAN);
+}
+
+/**
+ * \brief Initial bearing from one point to another
+ * \param lat1     Latitude of the start point, decimal degrees
+ * \param lon1     Longitude of the start point, decimal degrees
+ * \param lat2     Latitude of the destination, decimal degrees
+ * \param lon2     Longitude of the destination, decimal degrees
+ *
+ * \return The forward azimuth in decimal degrees, 0 to 360.
+ *
+ * \sa gc_distance_bearing_n(), qrb()
+ */
+double gc_bearing_deg (double lat1, double lon1, double lat2, double lon2) {
+     double phi1 = lat1 / RADIAN;
+     double phi2 = lat2 / RADIAN;
+
+     return gc_brg(sin(phi1), cos(phi1), sin(phi2), cos(phi2),
+                   (lon2 - lon1) / RADIAN);
+}
+
+/**
+ * \brief Distance and bearing from one point to many
+ * \param lat1     Latitude of the start point, decimal degrees
+ * \param lon1     Longitude of the start point, decimal degrees
+ * \param lat2     Array of \a n destination latitudes, decimal degrees
+ * \param lon2     Array of \a n destination longitudes, decimal degrees
+ * \param distance     Output array for the distances (km) or NULL
+ * \param bearing     Output array for the bearings (deg) or NULL
+ * \param n     Number of destinations
+ *
+ *  Same results as gc_distance_km() and gc_bearing_deg().  The start point
+ *  terms are computed once and the loop has no data dependent branches, so
+ *  it can be vectorised by the compiler.
+ */
+void gc_distance_bearing_n (double lat1, double lon1,
+                            const double *lat2, const double *lon2,
+                            double *distance, double *bearing, int n) {
+     double phi1 = lat1 / RADIAN;
+     double sin_phi1 = sin(phi1);
+     double cos_phi1 = cos(phi1);
+     double phi2, dlam;
+     int i;
+
+     if (distance) {
+          for (i = 0;  i < n;  ++i) {
+               phi2 = lat2[i] / RADIAN;
+               dlam = (lon2[i] - lon1) / RADIAN;
+               distance[i] = gc_dist(phi1, cos_phi1, phi2, cos(phi2), dlam);
+          }
+     }
+
+     if (bearing) {
+          for (i = 0;  i < n;  ++i) {
+               phi2 = lat2[i] / RADIAN;
+               dlam = (lon2[i] - lon1) / RADIAN;
+               bearing[i] = gc_brg(sin_phi1, cos_phi1, sin(phi2), cos(phi2),
+                                   dlam);
+          }
+     }
+}
+
 /**
  * \brief Calculate the distance and bearing between two points.
  * \param lon1          The local Longitude, decimal degrees
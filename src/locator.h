@@ -55,5 +55,21 @@ int    dec2dmmm           (double dec, int *degrees, double *minutes, int *sw);
 
 double dmmm2dec           (int degrees, double minutes, int sw);
 
+/* batch versions for bulk conversions, e.g. the pass detail rows */
+int    locator2longlat_n  (double *longitude, double *latitude,
+                           const char *const *locators, int n);
+
+int    longlat2locator_n  (const double *longitude, const double *latitude,
+                           char *locators, int pair_count, int n);
+
+/* great-circle distance (km) and initial bearing (deg) on a sphere */
+double gc_distance_km     (double lat1, double lon1, double lat2, double lon2);
+
+double gc_bearing_deg     (double lat1, double lon1, double lat2, double lon2);
+
+void   gc_distance_bearing_n (double lat1, double lon1,
+                              const double *lat2, const double *lon2,
+                              double *distance, double *bearing, int n);
+
 
 #endif
@@ -57,6 +57,7 @@
 #include "first-time.h"
 #include "tle-update.h"
 #include "mod-mgr.h"
+#include "result-cache.h"
 #include "sat-cfg.h"
 #include "sat-log.h"
 
@@ -130,7 +131,7 @@ int main(int argc, char *argv[])
     gtk_init(&argc, &argv);
     /* Load our territory CSV once at startup.
        Assumes Countries_tiles.csv sits next to the binary. */
-    tool_init("src/Countries_tiles.csv");
+    tool_init(TERRITORY_CSV_FILE);
 
     context = g_option_context_new("");
     g_option_context_add_main_entries(context, entries, GETTEXT_PACKAGE);
@@ -166,6 +167,9 @@ int main(int argc, char *argv[])
         return 1;
     }
 
+    /* drop the cached territory results of an older CSV */
+    result_cache_set_input("zone", TERRITORY_CSV_FILE, tool_get_digest());
+
     /* create application */
     gpredict_app_create();
     gtk_widget_show_all(app);
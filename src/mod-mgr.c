@@ -597,6 +597,32 @@ void mod_mgr_reload_sats()
     }
 }
 
+/** Hot-swap updated TLE data into every module. */
+void mod_mgr_update_tles()
+{
+    GSList         *node;
+
+    if (!nbook)
+    {
+        sat_log_log(SAT_LOG_LEVEL_ERROR,
+                    _("%s: Attempt to update TLEs but mod-mgr is NULL?"),
+                    __func__);
+        return;
+    }
+
+    for (node = modules; node != NULL; node = node->next)
+        gtk_sat_module_update_tles(GTK_SAT_MODULE(node->data));
+}
+
+/** Apply changed global settings to every module. */
+void mod_mgr_reconf()
+{
+    GSList         *node;
+
+    for (node = modules; node != NULL; node = node->next)
+        gtk_sat_module_reconf(GTK_SAT_MODULE(node->data), FALSE);
+}
+
 static void create_module_window(GtkWidget * module)
 {
     gint            w, h;
@@ -0,0 +1,742 @@
+/*
+  OGpredict — extensions to Gpredict for operations planning
+
+  Copyright (C) 2025 Axel Osika <osikaaxel@gmail.com>
+
+  This file is part of OGpredict, a derivative of Gpredict.
+
+  OGpredict is free software: you can redistribute it and/or modify it
+  under the terms of the GNU General Public License as published by the
+  Free Software Foundation; either version 2 of the License, or (at your
+  option) any later version.  See the GNU General Public License for details.
+*/
+
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/**
+ * pass-report.c — pass report for all satellites of a module
+ *
+ * Daily operations need "all passes of all module satellites for the next
+ * N days" as one document. Every satellite is an independent GThreadPool
+ * task that predicts its passes with get_passes() and renders its own
+ * section into a private buffer with the pass-to-txt row renderers. The
+ * sections are index-addressed by catalogue number order and concatenated
+ * after the pool has drained, so the report does not depend on the thread
+ * count or on scheduling.
+ *
+ * A planned route of the observer is snapshotted with the job; every task
+ * predicts with its own copy, since a route caches passes and is not thread
+ * safe.
+ *
+ * Formats:
+ *   - TXT: the layout of the single-satellite "Save passes" report, one
+ *     section per satellite;
+ *   - CSV: one summary table prefixed with name and catalogue number, and,
+ *     with details, a second table of all detail rows;
+ *   - JSON: one document with every field, independent of the column
+ *     settings.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <build-config.h>
+#endif
+
+#include <glib/gi18n.h>
+#include <math.h>
+#include <string.h>
+
+#include "gtk-sat-data.h"
+#include "pass-report.h"
+#include "pass-to-txt.h"
+#include "predict-tools.h"
+#include "qth-route.h"
+#include "sat-cfg.h"
+#include "sat-log.h"
+#include "sat-vis.h"
+#include "sgpsdp/sgp4sdp4.h"
+#include "time-tools.h"
+
+/** Read-only report input, shared by all tasks. */
+typedef struct {
+    pass_report_params_t params;
+    qth_t           qth;        /* snapshot: name, loc, position, route */
+    GPtrArray      *sats;       /* sat_t copies, by catalogue number */
+    pass_report_progress_func progress;
+    gpointer        progress_data;
+    GMainContext   *context;    /* progress is invoked here, or NULL */
+    gint            done;       /* finished tasks (atomic) */
+} ReportJob;
+
+/** One satellite and its rendered section. */
+typedef struct {
+    ReportJob      *job;
+    sat_t          *sat;
+    GString        *summary;    /* TXT/JSON section or CSV summary rows */
+    GString        *details;    /* CSV detail rows */
+    GCancellable   *cancel;
+} ReportTask;
+
+/** A progress update queued on the caller's main context. */
+typedef struct {
+    pass_report_progress_func func;
+    gpointer        data;
+    guint           done;
+    guint           total;
+} ReportProgress;
+
+
+void pass_report_params_init(pass_report_params_t * params, gdouble start)
+{
+    g_return_if_fail(params != NULL);
+
+    params->start = start;
+    params->duration = 7.0;
+    params->max_passes = 0;
+    params->format = PASS_REPORT_TXT;
+    params->details = FALSE;
+    params->multi_fields = sat_cfg_get_int(SAT_CFG_INT_PRED_MULTI_COL);
+    params->single_fields = sat_cfg_get_int(SAT_CFG_INT_PRED_SINGLE_COL);
+}
+
+/** File name extension matching a report format. */
+const gchar    *pass_report_extension(pass_report_format_t format)
+{
+    switch (format)
+    {
+    case PASS_REPORT_CSV:
+        return ".csv";
+    case PASS_REPORT_JSON:
+        return ".json";
+    default:
+        return ".txt";
+    }
+}
+
+static gint report_sat_cmp(gconstpointer a, gconstpointer b)
+{
+    const sat_t    *sa = *(const sat_t * const *)a;
+    const sat_t    *sb = *(const sat_t * const *)b;
+
+    return sa->tle.catnr - sb->tle.catnr;
+}
+
+/** Append a JSON string literal. */
+static void json_append_str(GString * out, const gchar * str)
+{
+    const gchar    *p;
+
+    g_string_append_c(out, '"');
+    for (p = str ? str : ""; *p; p++)
+    {
+        switch (*p)
+        {
+        case '"':
+            g_string_append(out, "\\\"");
+            break;
+        case '\\':
+            g_string_append(out, "\\\\");
+            break;
+        case '\n':
+            g_string_append(out, "\\n");
+            break;
+        case '\t':
+            g_string_append(out, "\\t");
+            break;
+        default:
+            if ((guchar) * p < 0x20)
+                g_string_append_printf(out, "\\u%04x", (guint) * p);
+            else
+                g_string_append_c(out, *p);
+            break;
+        }
+    }
+    g_string_append_c(out, '"');
+}
+
+/** Append "key":number with a locale independent decimal point. */
+static void json_append_num(GString * out, const gchar * key,
+                            const gchar * fmt, gdouble val)
+{
+    gchar           nbuff[G_ASCII_DTOSTR_BUF_SIZE];
+
+    g_string_append_printf(out, "\"%s\":%s", key,
+                           g_ascii_formatd(nbuff, sizeof(nbuff), fmt, val));
+}
+
+/** Append "key":"YYYY-MM-DDTHH:MM:SS.mmmZ". */
+static void json_append_time(GString * out, const gchar * key, gdouble jd)
+{
+    GDateTime      *dt;
+    gint64          ms;
+    gchar          *str;
+
+    ms = (gint64) floor((jd - 2440587.5) * 86400000.0 + 0.5);
+    dt = g_date_time_new_from_unix_utc(ms / 1000);
+    if (dt == NULL)
+    {
+        g_string_append_printf(out, "\"%s\":null", key);
+        return;
+    }
+
+    str = g_date_time_format(dt, "%Y-%m-%dT%H:%M:%S");
+    g_string_append_printf(out, "\"%s\":\"%s.%03dZ\"", key, str,
+                           (gint) (ms % 1000));
+    g_free(str);
+    g_date_time_unref(dt);
+}
+
+/** Append a CSV field, quoted if needed. */
+static void csv_append_field(GString * out, const gchar * str)
+{
+    const gchar    *p;
+
+    if (strpbrk(str, ",\"\n\r") == NULL)
+    {
+        g_string_append(out, str);
+        return;
+    }
+
+    g_string_append_c(out, '"');
+    for (p = str; *p; p++)
+    {
+        if (*p == '"')
+            g_string_append_c(out, '"');
+        g_string_append_c(out, *p);
+    }
+    g_string_append_c(out, '"');
+}
+
+/** Append each line of rows to out with prefix in front of it. */
+static void csv_prefix_rows(GString * out, const gchar * prefix,
+                            const GString * rows)
+{
+    const gchar    *line = rows->str;
+    const gchar    *end = rows->str + rows->len;
+    const gchar    *nl;
+
+    while (line < end)
+    {
+        nl = memchr(line, '\n', end - line);
+        if (nl == NULL)
+            nl = end;
+        g_string_append(out, prefix);
+        g_string_append_len(out, line, nl - line);
+        g_string_append_c(out, '\n');
+        line = nl + 1;
+    }
+}
+
+static void report_render_txt(ReportTask * task, GSList * passes)
+{
+    ReportJob      *job = task->job;
+    GString        *out = task->summary;
+    GSList         *node;
+    pass_t         *pass;
+    gchar          *header;
+
+    g_string_append_printf(out, _("\n%s (%d): %u passes\n"),
+                           task->sat->nickname, task->sat->tle.catnr,
+                           g_slist_length(passes));
+    if (passes == NULL)
+        return;
+
+    header = passes_to_txt_tblheader(passes, &job->qth,
+                                     job->params.multi_fields);
+    g_string_append(out, header);
+    g_free(header);
+    passes_to_txt_append_rows(out, passes, &job->qth,
+                              job->params.multi_fields, FALSE);
+
+    if (!job->params.details)
+        return;
+
+    for (node = passes; node != NULL; node = node->next)
+    {
+        pass = PASS(node->data);
+        g_string_append_printf(out, "\n Orbit %d\n", pass->orbit);
+        header = pass_to_txt_tblheader(pass, &job->qth,
+                                       job->params.single_fields);
+        g_string_append(out, header);
+        g_free(header);
+        pass_to_txt_append_rows(out, pass, &job->qth,
+                                job->params.single_fields, FALSE);
+    }
+}
+
+static void report_render_csv(ReportTask * task, GSList * passes)
+{
+    ReportJob      *job = task->job;
+    GString        *rows = g_string_sized_new(4096);
+    GString        *prefix = g_string_new(NULL);
+    GSList         *node;
+    pass_t         *pass;
+    gsize           plen;
+
+    csv_append_field(prefix, task->sat->nickname);
+    g_string_append_printf(prefix, ",%d,", task->sat->tle.catnr);
+
+    passes_to_txt_append_rows(rows, passes, &job->qth,
+                              job->params.multi_fields, TRUE);
+    csv_prefix_rows(task->summary, prefix->str, rows);
+
+    if (job->params.details)
+    {
+        plen = prefix->len;
+        for (node = passes; node != NULL; node = node->next)
+        {
+            pass = PASS(node->data);
+            g_string_truncate(rows, 0);
+            g_string_truncate(prefix, plen);
+            g_string_append_printf(prefix, "%d,", pass->orbit);
+            pass_to_txt_append_rows(rows, pass, &job->qth,
+                                    job->params.single_fields, TRUE);
+            csv_prefix_rows(task->details, prefix->str, rows);
+        }
+    }
+
+    g_string_free(rows, TRUE);
+    g_string_free(prefix, TRUE);
+}
+
+static void report_render_json(ReportTask * task, GSList * passes)
+{
+    GString        *out = task->summary;
+    GSList         *node, *dn;
+    pass_t         *pass;
+    pass_detail_t  *detail;
+    gchar           vis[2] = { 0, 0 };
+
+    g_string_append(out, "{\"name\":");
+    json_append_str(out, task->sat->nickname);
+    g_string_append_printf(out, ",\"catnum\":%d,\"passes\":[",
+                           task->sat->tle.catnr);
+
+    for (node = passes; node != NULL; node = node->next)
+    {
+        pass = PASS(node->data);
+        g_string_append_printf(out, "%s{\"orbit\":%d,",
+                               node == passes ? "" : ",", pass->orbit);
+        json_append_time(out, "aos", pass->aos);
+        g_string_append_c(out, ',');
+        json_append_time(out, "tca", pass->tca);
+        g_string_append_c(out, ',');
+        json_append_time(out, "los", pass->los);
+        g_string_append_c(out, ',');
+        json_append_num(out, "duration", "%.1f",
+                        (pass->los - pass->aos) * 86400.0);
+        g_string_append_c(out, ',');
+        json_append_num(out, "max_el", "%.2f", pass->max_el);
+        g_string_append_c(out, ',');
+        json_append_num(out, "aos_az", "%.2f", pass->aos_az);
+        g_string_append_c(out, ',');
+        json_append_num(out, "max_el_az", "%.2f", pass->maxel_az);
+        g_string_append_c(out, ',');
+        json_append_num(out, "los_az", "%.2f", pass->los_az);
+        g_string_append(out, ",\"vis\":");
+        json_append_str(out, pass->vis);
+
+        if (task->job->params.details)
+        {
+            g_string_append(out, ",\"details\":[");
+            for (dn = pass->details; dn != NULL; dn = dn->next)
+            {
+                detail = PASS_DETAIL(dn->data);
+                g_string_append(out, dn == pass->details ? "{" : ",{");
+                json_append_time(out, "time", detail->time);
+                g_string_append_c(out, ',');
+                json_append_num(out, "az", "%.2f", detail->az);
+                g_string_append_c(out, ',');
+                json_append_num(out, "el", "%.2f", detail->el);
+                g_string_append_c(out, ',');
+                json_append_num(out, "range", "%.3f", detail->range);
+                g_string_append_c(out, ',');
+                json_append_num(out, "range_rate", "%.4f",
+                                detail->range_rate);
+                g_string_append_c(out, ',');
+                json_append_num(out, "lat", "%.4f", detail->lat);
+                g_string_append_c(out, ',');
+                json_append_num(out, "lon", "%.4f", detail->lon);
+                g_string_append_c(out, ',');
+                json_append_num(out, "alt", "%.3f", detail->alt);
+                g_string_append_c(out, ',');
+                json_append_num(out, "velocity", "%.4f", detail->velo);
+                g_string_append_c(out, ',');
+                json_append_num(out, "footprint", "%.1f", detail->footprint);
+                g_string_append_c(out, ',');
+                json_append_num(out, "ma", "%.2f", detail->ma);
+                g_string_append_c(out, ',');
+                json_append_num(out, "phase", "%.2f", detail->phase);
+                vis[0] = vis_to_chr(detail->vis);
+                g_string_append(out, ",\"vis\":");
+                json_append_str(out, vis);
+                g_string_append_c(out, '}');
+            }
+            g_string_append_c(out, ']');
+        }
+        g_string_append_c(out, '}');
+    }
+
+    g_string_append(out, "]}");
+}
+
+static gboolean report_progress_idle(gpointer data)
+{
+    ReportProgress *up = data;
+
+    up->func(up->done, up->total, up->data);
+
+    return G_SOURCE_REMOVE;
+}
+
+static void report_progress(ReportJob * job, guint done)
+{
+    ReportProgress *up;
+
+    if (job->progress == NULL)
+        return;
+
+    if (job->context == NULL)
+    {
+        job->progress(done, job->sats->len, job->progress_data);
+        return;
+    }
+
+    up = g_new(ReportProgress, 1);
+    up->func = job->progress;
+    up->data = job->progress_data;
+    up->done = done;
+    up->total = job->sats->len;
+    g_main_context_invoke_full(job->context, G_PRIORITY_DEFAULT,
+                               report_progress_idle, up, g_free);
+}
+
+/** Predict and render the passes of one satellite. */
+static void report_sat_worker(gpointer data, gpointer user_data)
+{
+    ReportTask     *task = data;
+    ReportJob      *job = task->job;
+    qth_t           obs = job->qth;
+    GSList         *passes;
+
+    (void)user_data;
+
+    if (g_cancellable_is_cancelled(task->cancel))
+        return;
+
+    if (job->qth.route != NULL)
+        obs.route = qth_route_copy(job->qth.route);
+
+    passes = get_passes(task->sat, &obs, job->params.start,
+                        job->params.duration, job->params.max_passes);
+
+    if (job->qth.route != NULL)
+        qth_route_free(obs.route);
+
+    if (!g_cancellable_is_cancelled(task->cancel))
+    {
+        switch (job->params.format)
+        {
+        case PASS_REPORT_CSV:
+            report_render_csv(task, passes);
+            break;
+        case PASS_REPORT_JSON:
+            report_render_json(task, passes);
+            break;
+        default:
+            report_render_txt(task, passes);
+            break;
+        }
+    }
+
+    free_passes(passes);
+
+    report_progress(job, (guint) g_atomic_int_add(&job->done, 1) + 1);
+}
+
+/** Report header for the text format. */
+static void report_header_txt(GString * out, const ReportJob * job)
+{
+    gchar          *fmtstr = sat_cfg_get_str(SAT_CFG_STR_TIME_FORMAT);
+    gchar           t0[TIME_FORMAT_MAX_LENGTH];
+    gchar           t1[TIME_FORMAT_MAX_LENGTH];
+    const gchar    *zone;
+
+    daynum_to_str(t0, sizeof(t0), fmtstr, job->params.start);
+    daynum_to_str(t1, sizeof(t1), fmtstr,
+                  job->params.start + job->params.duration);
+    zone = sat_cfg_get_bool(SAT_CFG_BOOL_USE_LOCAL_TIME) ?
+        _("Local") : _("UTC");
+    g_free(fmtstr);
+
+    g_string_append_printf(out, _("Pass report for %u satellites\n"
+                                  "Observer: %s, %s\n"
+                                  "LAT:%.2f LON:%.2f\n"
+                                  "From: %s %s\n"
+                                  "To:   %s %s\n"),
+                           job->sats->len,
+                           job->qth.name ? job->qth.name : "",
+                           job->qth.loc ? job->qth.loc : "",
+                           job->qth.lat, job->qth.lon, t0, zone, t1, zone);
+}
+
+static gchar   *report_job_execute(ReportJob * job, GCancellable * cancel)
+{
+    ReportTask     *tasks;
+    GThreadPool    *pool;
+    GString        *out;
+    guint           nthreads;
+    guint           i;
+    gsize           size = 0;
+    gchar          *header;
+
+    tasks = g_new0(ReportTask, MAX(job->sats->len, 1));
+    nthreads = CLAMP((guint) g_get_num_processors(), 1, 8);
+    pool = g_thread_pool_new(report_sat_worker, NULL, (gint) nthreads, FALSE,
+                             NULL);
+    for (i = 0; i < job->sats->len; i++)
+    {
+        tasks[i].job = job;
+        tasks[i].sat = g_ptr_array_index(job->sats, i);
+        tasks[i].summary = g_string_sized_new(4096);
+        tasks[i].details = g_string_new(NULL);
+        tasks[i].cancel = cancel;
+        g_thread_pool_push(pool, &tasks[i], NULL);
+    }
+    g_thread_pool_free(pool, FALSE, TRUE);      /* wait for completion */
+
+    /* concatenate the sections in catalogue number order */
+    for (i = 0; i < job->sats->len; i++)
+        size += tasks[i].summary->len + tasks[i].details->len + 2;
+    out = g_string_sized_new(size + 1024);
+
+    switch (job->params.format)
+    {
+    case PASS_REPORT_CSV:
+        header = passes_to_csv_tblheader(job->params.multi_fields);
+        g_string_append_printf(out, "Satellite,Catnum,%s", header);
+        g_free(header);
+        for (i = 0; i < job->sats->len; i++)
+            g_string_append_len(out, tasks[i].summary->str,
+                                tasks[i].summary->len);
+        if (job->params.details)
+        {
+            header = pass_to_csv_tblheader(job->params.single_fields);
+            g_string_append_printf(out, "\nSatellite,Catnum,Orbit,%s",
+                                   header);
+            g_free(header);
+            for (i = 0; i < job->sats->len; i++)
+                g_string_append_len(out, tasks[i].details->str,
+                                    tasks[i].details->len);
+        }
+        break;
+
+    case PASS_REPORT_JSON:
+        g_string_append(out, "{\"observer\":{\"name\":");
+        json_append_str(out, job->qth.name);
+        g_string_append_c(out, ',');
+        json_append_num(out, "lat", "%.4f", job->qth.lat);
+        g_string_append_c(out, ',');
+        json_append_num(out, "lon", "%.4f", job->qth.lon);
+        g_string_append_printf(out, ",\"alt\":%d},", job->qth.alt);
+        json_append_time(out, "start", job->params.start);
+        g_string_append_c(out, ',');
+        json_append_time(out, "end",
+                         job->params.start + job->params.duration);
+        g_string_append(out, ",\"satellites\":[\n");
+        for (i = 0; i < job->sats->len; i++)
+        {
+            g_string_append_len(out, tasks[i].summary->str,
+                                tasks[i].summary->len);
+            g_string_append(out, i + 1 < job->sats->len ? ",\n" : "\n");
+        }
+        g_string_append(out, "]}\n");
+        break;
+
+    default:
+        report_header_txt(out, job);
+        for (i = 0; i < job->sats->len; i++)
+            g_string_append_len(out, tasks[i].summary->str,
+                                tasks[i].summary->len);
+        break;
+    }
+
+    for (i = 0; i < job->sats->len; i++)
+    {
+        g_string_free(tasks[i].summary, TRUE);
+        g_string_free(tasks[i].details, TRUE);
+    }
+    g_free(tasks);
+
+    return g_string_free(out, FALSE);
+}
+
+/** Snapshot satellites and observer; call from the main loop. */
+static ReportJob *report_job_new(GHashTable * sats, qth_t * qth,
+                                 const pass_report_params_t * params)
+{
+    ReportJob      *job = g_new0(ReportJob, 1);
+    GHashTableIter  iter;
+    gpointer        value;
+
+    job->params = *params;
+    job->qth.name = g_strdup(qth->name);
+    job->qth.loc = g_strdup(qth->loc);
+    job->qth.lat = qth->lat;
+    job->qth.lon = qth->lon;
+    job->qth.alt = qth->alt;
+    if (qth->route != NULL)
+        job->qth.route = qth_route_copy(qth->route);
+
+    job->sats = g_ptr_array_sized_new(sats ? g_hash_table_size(sats) : 0);
+    if (sats != NULL)
+    {
+        g_hash_table_iter_init(&iter, sats);
+        while (g_hash_table_iter_next(&iter, NULL, &value))
+        {
+            sat_t          *copy = g_new0(sat_t, 1);
+
+            gtk_sat_data_copy_sat(SAT(value), copy, &job->qth);
+            g_ptr_array_add(job->sats, copy);
+        }
+    }
+    g_ptr_array_sort(job->sats, report_sat_cmp);
+
+    return job;
+}
+
+static void report_job_free(gpointer data)
+{
+    ReportJob      *job = data;
+    guint           i;
+
+    if (job == NULL)
+        return;
+
+    for (i = 0; i < job->sats->len; i++)
+        gtk_sat_data_free_sat(g_ptr_array_index(job->sats, i));
+    g_ptr_array_free(job->sats, TRUE);
+    g_free(job->qth.name);
+    g_free(job->qth.loc);
+    qth_route_free(job->qth.route);
+    if (job->context)
+        g_main_context_unref(job->context);
+    g_free(job);
+}
+
+static gboolean report_params_valid(const pass_report_params_t * params,
+                                    GError ** error)
+{
+    if (params->duration <= 0.0 || params->format < PASS_REPORT_TXT ||
+        params->format > PASS_REPORT_JSON)
+    {
+        g_set_error(error, G_IO_ERROR, G_IO_ERROR_INVALID_ARGUMENT,
+                    _("Invalid pass report parameters"));
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+/**
+ * Generate a pass report synchronously.
+ *
+ * @param sats Satellites (catnr -> sat_t*); they are not modified.
+ * @param qth The observer.
+ * @param params Report parameters.
+ * @param cancel Optional cancellable.
+ * @param progress Optional progress callback, called from worker threads.
+ * @param progress_data User data for progress.
+ * @param error Location for a GError or NULL.
+ * @return The report text or NULL on error/cancellation.
+ */
+gchar          *pass_report_run(GHashTable * sats, qth_t * qth,
+                                const pass_report_params_t * params,
+                                GCancellable * cancel,
+                                pass_report_progress_func progress,
+                                gpointer progress_data, GError ** error)
+{
+    ReportJob      *job;
+    gchar          *report;
+
+    g_return_val_if_fail(qth != NULL && params != NULL, NULL);
+
+    if (!report_params_valid(params, error))
+        return NULL;
+
+    job = report_job_new(sats, qth, params);
+    job->progress = progress;
+    job->progress_data = progress_data;
+    report = report_job_execute(job, cancel);
+    report_job_free(job);
+
+    if (g_cancellable_set_error_if_cancelled(cancel, error))
+    {
+        g_free(report);
+        return NULL;
+    }
+
+    return report;
+}
+
+static void report_task_thread(GTask * task, gpointer source_object,
+                               gpointer task_data, GCancellable * cancel)
+{
+    gchar          *report;
+
+    (void)source_object;
+
+    report = report_job_execute(task_data, cancel);
+    if (g_task_return_error_if_cancelled(task))
+    {
+        g_free(report);
+        return;
+    }
+
+    g_task_return_pointer(task, report, g_free);
+}
+
+/**
+ * Generate a pass report in a worker thread.
+ *
+ * Progress is reported in the thread-default main context of the caller,
+ * before callback is invoked.
+ */
+void pass_report_run_async(GHashTable * sats, qth_t * qth,
+                           const pass_report_params_t * params,
+                           GCancellable * cancel,
+                           pass_report_progress_func progress,
+                           gpointer progress_data,
+                           GAsyncReadyCallback callback, gpointer user_data)
+{
+    GTask          *task;
+    ReportJob      *job;
+    GError         *error = NULL;
+
+    g_return_if_fail(qth != NULL && params != NULL);
+
+    task = g_task_new(NULL, cancel, callback, user_data);
+    g_task_set_source_tag(task, pass_report_run_async);
+
+    if (!report_params_valid(params, &error))
+    {
+        g_task_return_error(task, error);
+        g_object_unref(task);
+        return;
+    }
+
+    job = report_job_new(sats, qth, params);
+    job->progress = progress;
+    job->progress_data = progress_data;
+    job->context = g_main_context_ref_thread_default();
+
+    g_task_set_task_data(task, job, report_job_free);
+    g_task_run_in_thread(task, report_task_thread);
+    g_object_unref(task);
+}
+
+gchar          *pass_report_run_finish(GAsyncResult * res, GError ** error)
+{
+    g_return_val_if_fail(g_task_is_valid(res, NULL), NULL);
+
+    return g_task_propagate_pointer(G_TASK(res), error);
+}
@@ -0,0 +1,83 @@
+/*
+  OGpredict — extensions to Gpredict for operations planning
+
+  Copyright (C) 2025 Axel Osika <osikaaxel@gmail.com>
+
+  This file is part of OGpredict, a derivative of Gpredict.
+
+  OGpredict is free software: you can redistribute it and/or modify it
+  under the terms of the GNU General Public License as published by the
+  Free Software Foundation; either version 2 of the License, or (at your
+  option) any later version.  See the GNU General Public License for details.
+*/
+
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#ifndef __PASS_REPORT_H__
+#define __PASS_REPORT_H__ 1
+
+#include <gio/gio.h>
+#include <glib.h>
+
+#include "qth-data.h"
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/** Output format of a pass report. */
+typedef enum {
+    PASS_REPORT_TXT = 0,        /*!< Fixed-width text, one section per satellite */
+    PASS_REPORT_CSV,            /*!< One summary table (and one detail table) */
+    PASS_REPORT_JSON            /*!< Machine-readable JSON document */
+} pass_report_format_t;
+
+/** Pass report parameters. */
+typedef struct {
+    gdouble         start;      /*!< Start time (Julian date) */
+    gdouble         duration;   /*!< Horizon in days */
+    guint           max_passes; /*!< Passes per satellite; 0 = get_passes() default */
+    pass_report_format_t format;
+    gboolean        details;    /*!< Include the pass details */
+    gint            multi_fields;       /*!< MULTI_PASS_FLAG_* summary columns */
+    gint            single_fields;      /*!< SINGLE_PASS_FLAG_* detail columns */
+} pass_report_params_t;
+
+/**
+ * Progress callback.
+ *
+ * With pass_report_run() it is called from the worker threads; with
+ * pass_report_run_async() it is called in the thread-default main context
+ * of the caller.
+ */
+typedef void    (*pass_report_progress_func) (guint done, guint total,
+                                              gpointer data);
+
+void            pass_report_params_init(pass_report_params_t * params,
+                                        gdouble start);
+
+gchar          *pass_report_run(GHashTable * sats, qth_t * qth,
+                                const pass_report_params_t * params,
+                                GCancellable * cancel,
+                                pass_report_progress_func progress,
+                                gpointer progress_data, GError ** error);
+void            pass_report_run_async(GHashTable * sats, qth_t * qth,
+                                      const pass_report_params_t * params,
+                                      GCancellable * cancel,
+                                      pass_report_progress_func progress,
+                                      gpointer progress_data,
+                                      GAsyncReadyCallback callback,
+                                      gpointer user_data);
+gchar          *pass_report_run_finish(GAsyncResult * res, GError ** error);
+
+const gchar    *pass_report_extension(pass_report_format_t format);
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+}
+#endif
+/* *INDENT-ON* */
+
+#endif
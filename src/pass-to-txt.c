@@ -19,7 +19,11 @@
 #ifdef HAVE_CONFIG_H
 #include <build-config.h>
 #endif
-#include <gtk/gtk.h>
+#include <glib.h>
+#include <glib/gi18n.h>
+#include <math.h>
+#include <string.h>
+#include <time.h>
 
 #include "gtk-sat-data.h"
 #include "locator.h"
@@ -27,9 +31,9 @@
 #include "predict-tools.h"
 #include "sat-cfg.h"
 #include "sat-vis.h"
-#include "sat-pass-dialogs.h"
 #include "sgpsdp/sgp4sdp4.h"
 #include "time-tools.h"
+#include "view-flags.h"
 
 
 #define NUMCOL 19
@@ -110,9 +114,6 @@ const guint     MCW[] = {
 };
 
 
-static void     Calc_RADec(gdouble jul_utc, gdouble saz, gdouble sel,
-                           qth_t * qth, obs_astro_t * obs_set);
-
 gchar          *pass_to_txt_pgheader(pass_t * pass, qth_t * qth, gint fields)
 {
     gboolean        loc;
@@ -235,227 +236,12 @@ gchar          *pass_to_txt_tblheader(pass_t * pass, qth_t * qth, gint fields)
 gchar          *pass_to_txt_tblcontents(pass_t * pass, qth_t * qth,
                                         gint fields)
 {
-    gchar          *fmtstr;
-    gchar           tbuff[TIME_FORMAT_MAX_LENGTH];
-    guint           i, num;
-    gchar          *line;
-    gchar          *data = NULL;
-    gchar          *buff;
-    pass_detail_t  *detail;
-    obs_astro_t     astro;
-    gdouble         ra, dec, numf;
-    gchar          *ssp;
-
-    /* first, get the length of the time field */
-    fmtstr = sat_cfg_get_str(SAT_CFG_STR_TIME_FORMAT);
-    daynum_to_str(tbuff, TIME_FORMAT_MAX_LENGTH, fmtstr, pass->aos);
-
-    /* get number of rows */
-    num = g_slist_length(pass->details);
-
-    for (i = 0; i < num; i++)
-    {
-
-        /* get detail */
-        detail = PASS_DETAIL(g_slist_nth_data(pass->details, i));
-
-        /* time */
-        daynum_to_str(tbuff, TIME_FORMAT_MAX_LENGTH, fmtstr, detail->time);
-
-        line = g_strdup_printf(" %s", tbuff);
-
-        /* Az */
-        if (fields & SINGLE_PASS_FLAG_AZ)
-        {
-            buff = g_strdup_printf("%s %6.2f", line, detail->az);
-            g_free(line);
-            line = g_strdup(buff);
-            g_free(buff);
-        }
-
-        /* El */
-        if (fields & SINGLE_PASS_FLAG_EL)
-        {
-            buff = g_strdup_printf("%s %6.2f", line, detail->el);
-            g_free(line);
-            line = g_strdup(buff);
-            g_free(buff);
-        }
-
-        /* Ra */
-        if (fields & SINGLE_PASS_FLAG_RA)
-        {
-            Calc_RADec(detail->time, detail->az, detail->el, qth, &astro);
-            ra = Degrees(astro.ra);
-            buff = g_strdup_printf("%s %6.2f", line, ra);
-            g_free(line);
-            line = g_strdup(buff);
-            g_free(buff);
-        }
-
-        /* Dec */
-        if (fields & SINGLE_PASS_FLAG_DEC)
-        {
-            Calc_RADec(detail->time, detail->az, detail->el, qth, &astro);
-            dec = Degrees(astro.dec);
-            buff = g_strdup_printf("%s %6.2f", line, dec);
-            g_free(line);
-            line = g_strdup(buff);
-            g_free(buff);
-        }
-
-        /* Range */
-        if (fields & SINGLE_PASS_FLAG_RANGE)
-        {
-            buff = g_strdup_printf("%s %5.0f", line, detail->range);
-            g_free(line);
-            line = g_strdup(buff);
-            g_free(buff);
-        }
-
-        /* Range Rate */
-        if (fields & SINGLE_PASS_FLAG_RANGE_RATE)
-        {
-            buff = g_strdup_printf("%s %6.3f", line, detail->range_rate);
-            g_free(line);
-            line = g_strdup(buff);
-            g_free(buff);
-        }
-
-        /* Lat */
-        if (fields & SINGLE_PASS_FLAG_LAT)
-        {
-            buff = g_strdup_printf("%s %6.2f", line, detail->lat);
-            g_free(line);
-            line = g_strdup(buff);
-            g_free(buff);
-        }
-
-        /* Lon */
-        if (fields & SINGLE_PASS_FLAG_LON)
-        {
-            buff = g_strdup_printf("%s %7.2f", line, detail->lon);
-            g_free(line);
-            line = g_strdup(buff);
-            g_free(buff);
-        }
-
-        /* SSP */
-        if (fields & SINGLE_PASS_FLAG_SSP)
-        {
-            ssp = g_try_malloc(7);
-            if (longlat2locator(detail->lon, detail->lat, ssp, 3) == RIG_OK)
-            {
-                buff = g_strdup_printf("%s %s", line, ssp);
-                g_free(line);
-                line = g_strdup(buff);
-                g_free(buff);
-            }
-            g_free(ssp);
-        }
-
-        /* Footprint */
-        if (fields & SINGLE_PASS_FLAG_FOOTPRINT)
-        {
-            buff = g_strdup_printf("%s %5.0f", line, detail->footprint);
-            g_free(line);
-            line = g_strdup(buff);
-            g_free(buff);
-        }
-
-        /* Alt */
-        if (fields & SINGLE_PASS_FLAG_ALT)
-        {
-            buff = g_strdup_printf("%s %5.0f", line, detail->alt);
-            g_free(line);
-            line = g_strdup(buff);
-            g_free(buff);
-        }
-
-        /* Vel */
-        if (fields & SINGLE_PASS_FLAG_VEL)
-        {
-            buff = g_strdup_printf("%s %5.3f", line, detail->velo);
-            g_free(line);
-            line = g_strdup(buff);
-            g_free(buff);
-        }
-
-        /* Doppler */
-        if (fields & SINGLE_PASS_FLAG_DOPPLER)
-        {
-            numf = -100.0e06 * (detail->range_rate / 299792.4580);
-            buff = g_strdup_printf("%s %5.0f", line, numf);
-            g_free(line);
-            line = g_strdup(buff);
-            g_free(buff);
-        }
-
-        /* Loss */
-        if (fields & SINGLE_PASS_FLAG_LOSS)
-        {
-            numf = 72.4 + 20.0 * log10(detail->range);  // dB
-            buff = g_strdup_printf("%s %6.2f", line, numf);
-            g_free(line);
-            line = g_strdup(buff);
-            g_free(buff);
-        }
-
-        /* Delay */
-        if (fields & SINGLE_PASS_FLAG_DELAY)
-        {
-            numf = detail->range / 299.7924580; // msec 
-            buff = g_strdup_printf("%s %5.2f", line, numf);
-            g_free(line);
-            line = g_strdup(buff);
-            g_free(buff);
-        }
-
-        /* MA */
-        if (fields & SINGLE_PASS_FLAG_MA)
-        {
-            buff = g_strdup_printf("%s %6.2f", line, detail->ma);
-            g_free(line);
-            line = g_strdup(buff);
-            g_free(buff);
-        }
-
-        /* Phase */
-        if (fields & SINGLE_PASS_FLAG_PHASE)
-        {
-            buff = g_strdup_printf("%s %6.2f", line, detail->phase);
-            g_free(line);
-            line = g_strdup(buff);
-            g_free(buff);
-        }
+    GString        *data = g_string_sized_new(4096);
 
-        /* Visibility */
-        if (fields & SINGLE_PASS_FLAG_VIS)
-        {
-            buff = g_strdup_printf("%s  %c", line, vis_to_chr(detail->vis));
-            g_free(line);
-            line = g_strdup(buff);
-            g_free(buff);
-        }
+    pass_to_txt_append_rows(data, pass, qth, fields, FALSE);
 
-        /* append line to return string */
-        if (i == 0)
-        {
-            data = g_strdup_printf("%s\n", line);
-            g_free(line);
-        }
-        else
-        {
-            buff = g_strconcat(data, line, "\n", NULL);
-            g_free(data);
-            data = g_strdup(buff);
-            g_free(buff);
-        }
-    }
-
-    g_free(fmtstr);
-
-    return data;
+    /* NULL for an empty table, as before */
+    return g_string_free(data, data->len == 0);
 }
 
 gchar          *passes_to_txt_pgheader(GSList * passes, qth_t * qth,
@@ -535,189 +321,469 @@ gchar          *passes_to_txt_tblheader(GSList * passes, qth_t * qth,
 gchar          *passes_to_txt_tblcontents(GSList * passes, qth_t * qth,
                                           gint fields)
 {
-    gchar          *fmtstr;
+    GString        *data = g_string_sized_new(4096);
+
+    passes_to_txt_append_rows(data, passes, qth, fields, FALSE);
+
+    return g_string_free(data, data->len == 0);
+}
+
+/**
+ * Column renderer state, set up once per table.
+ *
+ * The time format and local/UTC setting are read from sat-cfg once instead
+ * of once per cell, and the enabled columns are resolved to a list so the
+ * row loop only visits columns that are shown.
+ */
+typedef struct {
+    gchar          *timefmt;    /*!< strftime() format */
+    gboolean        local;      /*!< Local time instead of UTC */
+    gboolean        csv;        /*!< CSV instead of fixed-width text */
+    gboolean        radec;      /*!< RA or Dec shown */
+    guint           ncols;      /*!< Number of enabled data columns */
+    guint           cols[SINGLE_PASS_COL_NUMBER];       /*!< Enabled columns */
+} pass_fmt_t;
+
+/** Fixed-width and CSV number formats, indexed by column. */
+typedef struct {
+    const gchar    *txt;
+    const gchar    *csv;
+} col_fmt_t;
+
+static const col_fmt_t SINGLE_FMT[] = {
+    {NULL, NULL},               /* time */
+    {" %6.2f", "%.2f"},         /* az */
+    {" %6.2f", "%.2f"},         /* el */
+    {" %6.2f", "%.2f"},         /* ra */
+    {" %6.2f", "%.2f"},         /* dec */
+    {" %5.0f", "%.0f"},         /* range */
+    {" %6.3f", "%.3f"},         /* range rate */
+    {" %6.2f", "%.2f"},         /* lat */
+    {" %7.2f", "%.2f"},         /* lon */
+    {NULL, NULL},               /* ssp */
+    {" %5.0f", "%.0f"},         /* footprint */
+    {" %5.0f", "%.0f"},         /* alt */
+    {" %5.3f", "%.3f"},         /* vel */
+    {" %5.0f", "%.0f"},         /* doppler */
+    {" %6.2f", "%.2f"},         /* loss */
+    {" %5.2f", "%.2f"},         /* delay */
+    {" %6.2f", "%.2f"},         /* ma */
+    {" %6.2f", "%.2f"},         /* phase */
+    {NULL, NULL}                /* vis */
+};
+
+static const col_fmt_t MULTI_FMT[] = {
+    {NULL, NULL},               /* aos */
+    {NULL, NULL},               /* tca */
+    {NULL, NULL},               /* los */
+    {NULL, NULL},               /* duration */
+    {"  %6.2f", "%.2f"},        /* max el */
+    {"  %6.2f", "%.2f"},        /* aos az */
+    {"  %9.2f", "%.2f"},        /* max el az */
+    {"  %6.2f", "%.2f"},        /* los az */
+    {NULL, NULL},               /* orbit */
+    {NULL, NULL}                /* vis */
+};
+
+/** Rows are written to the channel whenever this much text is buffered. */
+#define PASS_FLUSH_SIZE 65536
+
+static void pass_fmt_init(pass_fmt_t * f, gint fields, guint first,
+                          guint last, gboolean csv)
+{
+    guint           i;
+
+    f->timefmt = sat_cfg_get_str(SAT_CFG_STR_TIME_FORMAT);
+    f->local = sat_cfg_get_bool(SAT_CFG_BOOL_USE_LOCAL_TIME);
+    f->csv = csv;
+    f->ncols = 0;
+    for (i = first; i < last; i++)
+        if (fields & (1 << i))
+            f->cols[f->ncols++] = i;
+    f->radec = FALSE;
+}
+
+/** Same output as daynum_to_str() with the cached settings. */
+static void pass_fmt_time(GString * out, const pass_fmt_t * f, gdouble jd)
+{
     gchar           tbuff[TIME_FORMAT_MAX_LENGTH];
-    guint           i, num;
-    gchar          *line = NULL;
-    gchar          *data = NULL;
-    gchar          *buff;
-    pass_t         *pass;
+    time_t          tim = (jd - 2440587.5) * 86400.0;
+    gsize           size;
 
-    (void)qth;                  /* avoid unused parameter compiler warning */
+    size = strftime(tbuff, sizeof(tbuff), f->timefmt,
+                    f->local ? localtime(&tim) : gmtime(&tim));
+    tbuff[MIN(size, sizeof(tbuff) - 1)] = '\0';
 
-    pass = PASS(g_slist_nth_data(passes, 0));
+    if (f->csv && strpbrk(tbuff, ",\"") != NULL)
+    {
+        const gchar    *p;
 
-    /* first, get the length of the time field */
-    fmtstr = sat_cfg_get_str(SAT_CFG_STR_TIME_FORMAT);
-    daynum_to_str(tbuff, TIME_FORMAT_MAX_LENGTH, fmtstr, pass->aos);
+        g_string_append_c(out, '"');
+        for (p = tbuff; *p; p++)
+        {
+            if (*p == '"')
+                g_string_append_c(out, '"');
+            g_string_append_c(out, *p);
+        }
+        g_string_append_c(out, '"');
+    }
+    else
+    {
+        g_string_append(out, tbuff);
+    }
+}
 
-    /* get number of rows */
-    num = g_slist_length(passes);
+static void pass_fmt_num(GString * out, const pass_fmt_t * f,
+                         const col_fmt_t * cf, gdouble val)
+{
+    gchar           nbuff[G_ASCII_DTOSTR_BUF_SIZE];
 
-    for (i = 0; i < num; i++)
+    if (f->csv)
     {
+        g_string_append_c(out, ',');
+        g_string_append(out, g_ascii_formatd(nbuff, sizeof(nbuff), cf->csv,
+                                             val));
+    }
+    else
+    {
+        g_string_append_printf(out, cf->txt, val);
+    }
+}
 
-        pass = PASS(g_slist_nth_data(passes, i));
+static gboolean pass_flush(GIOChannel * chan, GString * out, gsize min,
+                           GError ** error)
+{
+    gsize           count;
 
-        /* AOS */
-        daynum_to_str(tbuff, TIME_FORMAT_MAX_LENGTH, fmtstr, pass->aos);
+    if (chan == NULL || out->len == 0 || out->len < min)
+        return TRUE;
 
-        line = g_strdup_printf(" %s", tbuff);
+    if (g_io_channel_write_chars(chan, out->str, out->len, &count, error) !=
+        G_IO_STATUS_NORMAL)
+        return FALSE;
+    g_string_truncate(out, 0);
 
-        /* TCA */
-        daynum_to_str(tbuff, TIME_FORMAT_MAX_LENGTH, fmtstr, pass->tca);
+    return TRUE;
+}
 
-        buff = g_strdup(line);
-        g_free(line);
-        line = g_strdup_printf("%s  %s", buff, tbuff);
-        g_free(buff);
+static void pass_single_row(GString * out, const pass_fmt_t * f,
+                            const pass_detail_t * detail, qth_t * qth,
+                            const gchar * ssp)
+{
+    gdouble         ra = 0.0, dec = 0.0;
+    guint           i, col;
+    gdouble         val;
 
-        /* LOS */
-        daynum_to_str(tbuff, TIME_FORMAT_MAX_LENGTH, fmtstr, pass->los);
+    if (f->radec)
+        predict_azel_to_radec(detail->time, detail->az, detail->el, qth,
+                              &ra, &dec);
 
-        buff = g_strdup(line);
-        g_free(line);
-        line = g_strdup_printf("%s  %s", buff, tbuff);
-        g_free(buff);
+    if (!f->csv)
+        g_string_append_c(out, ' ');
+    pass_fmt_time(out, f, detail->time);
 
-        /* Duration */
-        if (fields & (1 << MULTI_PASS_COL_DURATION))
+    for (i = 0; i < f->ncols; i++)
+    {
+        col = f->cols[i];
+        switch (col)
         {
-            guint           h, m, s;
+        case SINGLE_PASS_COL_AZ:
+            val = detail->az;
+            break;
+        case SINGLE_PASS_COL_EL:
+            val = detail->el;
+            break;
+        case SINGLE_PASS_COL_RA:
+            val = ra;
+            break;
+        case SINGLE_PASS_COL_DEC:
+            val = dec;
+            break;
+        case SINGLE_PASS_COL_RANGE:
+            val = detail->range;
+            break;
+        case SINGLE_PASS_COL_RANGE_RATE:
+            val = detail->range_rate;
+            break;
+        case SINGLE_PASS_COL_LAT:
+            val = detail->lat;
+            break;
+        case SINGLE_PASS_COL_LON:
+            val = detail->lon;
+            break;
+        case SINGLE_PASS_COL_SSP:
+            if (ssp != NULL)
+            {
+                g_string_append_c(out, f->csv ? ',' : ' ');
+                g_string_append(out, ssp);
+            }
+            else if (f->csv)
+            {
+                g_string_append_c(out, ',');
+            }
+            continue;
+        case SINGLE_PASS_COL_FOOTPRINT:
+            val = detail->footprint;
+            break;
+        case SINGLE_PASS_COL_ALT:
+            val = detail->alt;
+            break;
+        case SINGLE_PASS_COL_VEL:
+            val = detail->velo;
+            break;
+        case SINGLE_PASS_COL_DOPPLER:
+            val = -100.0e06 * (detail->range_rate / 299792.4580);
+            break;
+        case SINGLE_PASS_COL_LOSS:
+            val = 72.4 + 20.0 * log10(detail->range);   // dB
+            break;
+        case SINGLE_PASS_COL_DELAY:
+            val = detail->range / 299.7924580;  // msec
+            break;
+        case SINGLE_PASS_COL_MA:
+            val = detail->ma;
+            break;
+        case SINGLE_PASS_COL_PHASE:
+            val = detail->phase;
+            break;
+        case SINGLE_PASS_COL_VIS:
+            g_string_append(out, f->csv ? "," : "  ");
+            g_string_append_c(out, vis_to_chr(detail->vis));
+            continue;
+        default:
+            continue;
+        }
+        pass_fmt_num(out, f, &SINGLE_FMT[col], val);
+    }
 
+    g_string_append_c(out, '\n');
+}
+
+static void pass_multi_row(GString * out, const pass_fmt_t * f,
+                           const pass_t * pass)
+{
+    const gchar    *sep = f->csv ? "," : "  ";
+    guint           i, col;
+    guint           h, m, s;
+
+    if (!f->csv)
+        g_string_append_c(out, ' ');
+    pass_fmt_time(out, f, pass->aos);
+    g_string_append(out, sep);
+    pass_fmt_time(out, f, pass->tca);
+    g_string_append(out, sep);
+    pass_fmt_time(out, f, pass->los);
+
+    for (i = 0; i < f->ncols; i++)
+    {
+        col = f->cols[i];
+        switch (col)
+        {
+        case MULTI_PASS_COL_DURATION:
             /* convert julian date to seconds */
             s = (guint) ((pass->los - pass->aos) * 86400);
-
-            /* extract hours */
-            h = (guint) floor(s / 3600);
+            h = s / 3600;
             s -= 3600 * h;
-
-            /* extract minutes */
-            m = (guint) floor(s / 60);
+            m = s / 60;
             s -= 60 * m;
-
-            buff = g_strdup_printf("%s  %02d:%02d:%02d", line, h, m, s);
-            g_free(line);
-            line = g_strdup(buff);
-            g_free(buff);
+            g_string_append_printf(out, "%s%02d:%02d:%02d", sep, h, m, s);
+            break;
+        case MULTI_PASS_COL_MAX_EL:
+            pass_fmt_num(out, f, &MULTI_FMT[col], pass->max_el);
+            break;
+        case MULTI_PASS_COL_AOS_AZ:
+            pass_fmt_num(out, f, &MULTI_FMT[col], pass->aos_az);
+            break;
+        case MULTI_PASS_COL_MAX_EL_AZ:
+            pass_fmt_num(out, f, &MULTI_FMT[col], pass->maxel_az);
+            break;
+        case MULTI_PASS_COL_LOS_AZ:
+            pass_fmt_num(out, f, &MULTI_FMT[col], pass->los_az);
+            break;
+        case MULTI_PASS_COL_ORBIT:
+            g_string_append_printf(out, f->csv ? ",%d" : "  %5d",
+                                   pass->orbit);
+            break;
+        case MULTI_PASS_COL_VIS:
+            g_string_append(out, sep);
+            g_string_append(out, pass->vis);
+            break;
+        default:
+            break;
         }
+    }
 
-        /* Max El */
-        if (fields & (1 << MULTI_PASS_COL_MAX_EL))
-        {
-            buff = g_strdup_printf("%s  %6.2f", line, pass->max_el);
-            g_free(line);
-            line = g_strdup(buff);
-            g_free(buff);
-        }
+    g_string_append_c(out, '\n');
+}
 
-        /* AOS Az */
-        if (fields & (1 << MULTI_PASS_COL_AOS_AZ))
-        {
-            buff = g_strdup_printf("%s  %6.2f", line, pass->aos_az);
-            g_free(line);
-            line = g_strdup(buff);
-            g_free(buff);
-        }
+/* Render the rows of one pass into out, flushing to chan if not NULL. */
+static gboolean pass_rows(GIOChannel * chan, GString * out, pass_t * pass,
+                          qth_t * qth, gint fields, gboolean csv,
+                          GError ** error)
+{
+    pass_fmt_t      f;
+    GSList         *node;
+    gboolean        ok = TRUE;
+    gchar          *ssp = NULL;
+    guint           i, n;
 
-        /* Max El Az */
-        if (fields & (1 << MULTI_PASS_COL_MAX_EL_AZ))
-        {
-            buff = g_strdup_printf("%s  %9.2f", line, pass->maxel_az);
-            g_free(line);
-            line = g_strdup(buff);
-            g_free(buff);
-        }
+    pass_fmt_init(&f, fields, 1, SINGLE_PASS_COL_NUMBER, csv);
+    f.radec = (fields & (SINGLE_PASS_FLAG_RA | SINGLE_PASS_FLAG_DEC)) != 0;
 
-        /* LOS Az */
-        if (fields & (1 << MULTI_PASS_COL_LOS_AZ))
-        {
-            buff = g_strdup_printf("%s  %6.2f", line, pass->los_az);
-            g_free(line);
-            line = g_strdup(buff);
-            g_free(buff);
-        }
+    /* sub-satellite locators of all rows in one go */
+    if (fields & SINGLE_PASS_FLAG_SSP)
+    {
+        gdouble        *lon, *lat;
 
-        /* Orbit */
-        if (fields & (1 << MULTI_PASS_COL_ORBIT))
+        n = g_slist_length(pass->details);
+        lon = g_new(gdouble, 2 * n);
+        lat = lon + n;
+        for (i = 0, node = pass->details; node != NULL; node = node->next, i++)
         {
-            buff = g_strdup_printf("%s  %5d", line, pass->orbit);
-            g_free(line);
-            line = g_strdup(buff);
-            g_free(buff);
+            lon[i] = PASS_DETAIL(node->data)->lon;
+            lat[i] = PASS_DETAIL(node->data)->lat;
         }
+        ssp = g_new(gchar, 7 * n);
+        longlat2locator_n(lon, lat, ssp, 3, n);
+        g_free(lon);
+    }
 
-        /* Visibility */
-        if (fields & (1 << MULTI_PASS_COL_VIS))
-        {
-            buff = g_strdup_printf("%s  %s", line, pass->vis);
-            g_free(line);
-            line = g_strdup(buff);
-            g_free(buff);
-        }
+    for (i = 0, node = pass->details; node != NULL && ok;
+         node = node->next, i++)
+    {
+        pass_single_row(out, &f, PASS_DETAIL(node->data), qth,
+                        ssp ? ssp + 7 * i : NULL);
+        ok = pass_flush(chan, out, PASS_FLUSH_SIZE, error);
+    }
 
-        /* append line to return string */
-        if (i == 0)
-        {
-            data = g_strdup_printf("%s\n", line);
-            g_free(line);
-        }
-        else
-        {
-            buff = g_strconcat(data, line, "\n", NULL);
-            g_free(data);
-            data = g_strdup(buff);
-            g_free(buff);
-        }
+    g_free(ssp);
+    g_free(f.timefmt);
+
+    return ok;
+}
 
+static gboolean passes_rows(GIOChannel * chan, GString * out,
+                            GSList * passes, gint fields, gboolean csv,
+                            GError ** error)
+{
+    pass_fmt_t      f;
+    GSList         *node;
+    gboolean        ok = TRUE;
+
+    pass_fmt_init(&f, fields, MULTI_PASS_COL_DURATION, MULTI_PASS_COL_NUMBER,
+                  csv);
+
+    for (node = passes; node != NULL && ok; node = node->next)
+    {
+        pass_multi_row(out, &f, PASS(node->data));
+        ok = pass_flush(chan, out, PASS_FLUSH_SIZE, error);
     }
 
-    g_free(fmtstr);
+    g_free(f.timefmt);
+
+    return ok;
+}
+
+/**
+ * Append the detail rows of a pass to a string.
+ *
+ * @param out The string to append to.
+ * @param pass The pass.
+ * @param qth The observer.
+ * @param fields Bitfield of SINGLE_PASS_FLAG_* columns.
+ * @param csv Comma separated values instead of fixed-width text.
+ */
+void pass_to_txt_append_rows(GString * out, pass_t * pass, qth_t * qth,
+                             gint fields, gboolean csv)
+{
+    pass_rows(NULL, out, pass, qth, fields, csv, NULL);
+}
+
+/** Append the summary rows of a list of passes to a string. */
+void passes_to_txt_append_rows(GString * out, GSList * passes, qth_t * qth,
+                               gint fields, gboolean csv)
+{
+    (void)qth;
 
-    return data;
+    passes_rows(NULL, out, passes, fields, csv, NULL);
 }
 
-static void Calc_RADec(gdouble jul_utc, gdouble saz, gdouble sel,
-                       qth_t * qth, obs_astro_t * obs_set)
+/**
+ * Stream the detail rows of a pass to a channel.
+ *
+ * @param chan The channel to write to.
+ * @param buff Scratch buffer; reused between calls and left empty.
+ * @param pass The pass.
+ * @param qth The observer.
+ * @param fields Bitfield of SINGLE_PASS_FLAG_* columns.
+ * @param csv Comma separated values instead of fixed-width text.
+ * @param error Location for the write error or NULL.
+ * @return TRUE if all rows were written.
+ */
+gboolean pass_to_txt_write_rows(GIOChannel * chan, GString * buff,
+                                pass_t * pass, qth_t * qth, gint fields,
+                                gboolean csv, GError ** error)
 {
-    double          phi, theta, sin_theta, cos_theta, sin_phi, cos_phi,
-        az, el, Lxh, Lyh, Lzh, Sx, Ex, Zx, Sy, Ey, Zy, Sz, Ez, Zz,
-        Lx, Ly, Lz, cos_delta, sin_alpha, cos_alpha;
-    geodetic_t      geodetic;
-
-
-    geodetic.lon = qth->lon * de2ra;
-    geodetic.lat = qth->lat * de2ra;
-    geodetic.alt = qth->alt / 1000.0;
-    geodetic.theta = 0;
-
-    az = saz * de2ra;
-    el = sel * de2ra;
-    phi = geodetic.lat;
-    theta = FMod2p(ThetaG_JD(jul_utc) + geodetic.lon);
-    sin_theta = sin(theta);
-    cos_theta = cos(theta);
-    sin_phi = sin(phi);
-    cos_phi = cos(phi);
-    Lxh = -cos(az) * cos(el);
-    Lyh = sin(az) * cos(el);
-    Lzh = sin(el);
-    Sx = sin_phi * cos_theta;
-    Ex = -sin_theta;
-    Zx = cos_theta * cos_phi;
-    Sy = sin_phi * sin_theta;
-    Ey = cos_theta;
-    Zy = sin_theta * cos_phi;
-    Sz = -cos_phi;
-    Ez = 0;
-    Zz = sin_phi;
-    Lx = Sx * Lxh + Ex * Lyh + Zx * Lzh;
-    Ly = Sy * Lxh + Ey * Lyh + Zy * Lzh;
-    Lz = Sz * Lxh + Ez * Lyh + Zz * Lzh;
-    obs_set->dec = ArcSin(Lz);  /* Declination (radians) */
-    cos_delta = sqrt(1 - Sqr(Lz));
-    sin_alpha = Ly / cos_delta;
-    cos_alpha = Lx / cos_delta;
-    obs_set->ra = AcTan(sin_alpha, cos_alpha);  /* Right Ascension (radians) */
-    obs_set->ra = FMod2p(obs_set->ra);
+    g_string_truncate(buff, 0);
+
+    return pass_rows(chan, buff, pass, qth, fields, csv, error) &&
+        pass_flush(chan, buff, 0, error);
 }
+
+/** Stream the summary rows of a list of passes to a channel. */
+gboolean passes_to_txt_write_rows(GIOChannel * chan, GString * buff,
+                                  GSList * passes, qth_t * qth, gint fields,
+                                  gboolean csv, GError ** error)
+{
+    (void)qth;
+
+    g_string_truncate(buff, 0);
+
+    return passes_rows(chan, buff, passes, fields, csv, error) &&
+        pass_flush(chan, buff, 0, error);
+}
+
+/** CSV header line for the detail rows of a pass. */
+gchar          *pass_to_csv_tblheader(gint fields)
+{
+    GString        *line = g_string_new(NULL);
+    guint           i;
+
+    g_string_append(line, "Time");
+    for (i = 1; i < NUMCOL; i++)
+    {
+        if (fields & (1 << i))
+        {
+            gchar          *title = g_strstrip(g_strdup(_(SPCT[i])));
+
+            g_string_append_printf(line, ",%s", title);
+            g_free(title);
+        }
+    }
+    g_string_append_c(line, '\n');
+
+    return g_string_free(line, FALSE);
+}
+
+/** CSV header line for the summary rows of a list of passes. */
+gchar          *passes_to_csv_tblheader(gint fields)
+{
+    GString        *line = g_string_new(NULL);
+    guint           i;
+
+    g_string_append(line, "AOS,TCA,LOS");
+    for (i = 3; i < 10; i++)
+    {
+        if (fields & (1 << i))
+        {
+            gchar          *title = g_strstrip(g_strdup(_(MPCT[i])));
+
+            g_string_append_printf(line, ",%s", title);
+            g_free(title);
+        }
+    }
+    g_string_append_c(line, '\n');
+
+    return g_string_free(line, FALSE);
+}
+
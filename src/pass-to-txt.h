@@ -1,10 +1,10 @@
 #ifndef PASS_TO_TXT_H
 #define PASS_TO_TXT_H 1
 
-#include <gtk/gtk.h>
-#include "sat-pass-dialogs.h"
+#include <glib.h>
 #include "predict-tools.h"
 #include "gtk-sat-data.h"
+#include "view-flags.h"
 
 
 gchar          *pass_to_txt_pgheader(pass_t * pass, qth_t * qth, gint fields);
@@ -19,5 +19,23 @@ gchar          *passes_to_txt_tblheader(GSList * passes, qth_t * qth,
 gchar          *passes_to_txt_tblcontents(GSList * passes, qth_t * qth,
                                           gint fields);
 
+gchar          *pass_to_csv_tblheader(gint fields);
+gchar          *passes_to_csv_tblheader(gint fields);
+
+void            pass_to_txt_append_rows(GString * out, pass_t * pass,
+                                        qth_t * qth, gint fields,
+                                        gboolean csv);
+void            passes_to_txt_append_rows(GString * out, GSList * passes,
+                                          qth_t * qth, gint fields,
+                                          gboolean csv);
+gboolean        pass_to_txt_write_rows(GIOChannel * chan, GString * buff,
+                                       pass_t * pass, qth_t * qth,
+                                       gint fields, gboolean csv,
+                                       GError ** error);
+gboolean        passes_to_txt_write_rows(GIOChannel * chan, GString * buff,
+                                         GSList * passes, qth_t * qth,
+                                         gint fields, gboolean csv,
+                                         GError ** error);
+
 
 #endif
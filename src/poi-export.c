@@ -0,0 +1,86 @@
+/*
+  OGpredict — extensions to Gpredict for operations planning
+
+  Copyright (C) 2025 Axel Osika <osikaaxel@gmail.com>
+
+  This file is part of OGpredict, a derivative of Gpredict.
+
+  OGpredict is free software: you can redistribute it and/or modify it
+  under the terms of the GNU General Public License as published by the
+  Free Software Foundation; either version 2 of the License, or (at your
+  option) any later version.  See the GNU General Public License for details.
+*/
+
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "poi-export.h"
+#include <string.h> /* strpbrk */
+
+static gchar *csv_escape(const gchar *s) {
+    if (!s) return g_strdup("");
+    if (!strpbrk(s, ",\"\n\r")) return g_strdup(s);
+    GString *g = g_string_new("\"");
+    for (const char *p = s; *p; ++p) {
+        if (*p == '"') g_string_append_c(g, '"'); /* double quotes */
+        g_string_append_c(g, *p);
+    }
+    g_string_append_c(g, '"');
+    return g_string_free(g, FALSE);
+}
+
+static gchar *ensure_ext(const gchar *path, gboolean is_csv) {
+    if (!path) return NULL;
+    if (g_str_has_suffix(path, is_csv ? ".csv" : ".txt")) return g_strdup(path);
+    return g_strconcat(path, is_csv ? ".csv" : ".txt", NULL);
+}
+
+gboolean poi_export_write(const gchar *path,
+                          SubwinFormat fmt,
+                          PoiExportNextFunc next,
+                          gpointer data,
+                          GError **err)
+{
+    gboolean csv = (fmt == SUBWIN_FORMAT_CSV);
+    GString *out = g_string_new(NULL);
+    /* Excel hint: BOM makes it detect UTF-8, avoiding 'Â°' */
+    if (csv) g_string_append(out, "\xEF\xBB\xBF");
+
+    if (csv) {
+        g_string_append(out, "Time,Satellite,Latitude,Longitude,Range_km,Direction,Name,Type\n");
+    } else {
+        g_string_append(out, "Time\tSatellite\tLatitude\tLongitude\tRange (km)\tDirection\tName\tType\n");
+    }
+
+    PoiExportRow r;
+    memset(&r, 0, sizeof(r));
+    while (next(&r, data)) {
+        char slat[32], slon[32], srange[32], sbrg[32], sdir[40];
+        g_ascii_formatd(slat,  sizeof(slat),  "%.5f", r.lat);
+        g_ascii_formatd(slon,  sizeof(slon),  "%.5f", r.lon);
+        g_ascii_formatd(srange,sizeof(srange),"%.3f", r.range);
+        g_ascii_formatd(sbrg,  sizeof(sbrg),  "%.1f", r.bearing);
+        g_snprintf(sdir, sizeof(sdir), "%s°", sbrg); /* same text as the table */
+
+        if (csv) {
+            gchar *qtime = csv_escape(r.time);
+            gchar *qsat  = csv_escape(r.sat);
+            gchar *qdir  = csv_escape(sdir);
+            gchar *qname = csv_escape(r.name);
+            gchar *qtype = csv_escape(r.type);
+            g_string_append_printf(out, "%s,%s,%s,%s,%s,%s,%s,%s\n",
+                qtime, qsat, slat, slon, srange, qdir, qname, qtype);
+            g_free(qtime); g_free(qsat); g_free(qdir); g_free(qname); g_free(qtype);
+        } else {
+            g_string_append_printf(out, "%s\t%s\t%s\t%s\t%s\t%s\t%s\t%s\n",
+                r.time ? r.time : "", r.sat ? r.sat : "", slat, slon, srange,
+                sdir, r.name ? r.name : "", r.type ? r.type : "");
+        }
+        memset(&r, 0, sizeof(r));
+    }
+
+    gchar *final_path = ensure_ext(path, csv);
+    gboolean wrote = g_file_set_contents(final_path, out->str, out->len, err);
+    g_free(final_path);
+    g_string_free(out, TRUE);
+    return wrote;
+}
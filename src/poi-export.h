@@ -0,0 +1,47 @@
+/*
+  OGpredict — extensions to Gpredict for operations planning
+
+  Copyright (C) 2025 Axel Osika <osikaaxel@gmail.com>
+
+  This file is part of OGpredict, a derivative of Gpredict.
+
+  OGpredict is free software: you can redistribute it and/or modify it
+  under the terms of the GNU General Public License as published by the
+  Free Software Foundation; either version 2 of the License, or (at your
+  option) any later version.  See the GNU General Public License for details.
+*/
+
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/* src/poi-export.h — CSV/TXT writer for POI tables (GLib only) */
+#pragma once
+#include <glib.h>
+
+typedef enum {
+     SUBWIN_FORMAT_CSV,
+     SUBWIN_FORMAT_TXT
+} SubwinFormat;
+
+/* One exported row. Strings are borrowed from the producer and only need
+ * to stay valid until the next call of the row callback. */
+typedef struct {
+     const gchar *time;
+     gdouble      lat;
+     gdouble      lon;
+     gdouble      range;
+     gdouble      bearing;   /* degrees, written as the Direction column */
+     const gchar *name;
+     const gchar *type;
+     const gchar *sat;
+} PoiExportRow;
+
+/* Fills *row and returns TRUE, or returns FALSE when there are no more rows. */
+typedef gboolean (*PoiExportNextFunc)(PoiExportRow *row, gpointer data);
+
+/* Write all rows produced by next() to path (".csv"/".txt" is appended if
+ * missing). Returns TRUE on success. */
+gboolean poi_export_write(const gchar *path,
+                          SubwinFormat fmt,
+                          PoiExportNextFunc next,
+                          gpointer data,
+                          GError **err);
@@ -23,6 +23,19 @@
 /* Static cache of names (each element is a g_strdup’d char*) */
 static GPtrArray *poi_names = NULL;
 static GPtrArray *poi_types = NULL;      /* parallel array for the “Type” column */
+static GChecksum *poi_sum    = NULL;     /* bytes of the CSV the names came from */
+static gchar     *poi_digest = NULL;     /* SHA-256 of those bytes */
+
+/* Take poi_digest from poi_sum. The sum itself stays open so that rows
+   appended by points_interest_add_to_csv() can be added to it. */
+static void poi_digest_refresh(void)
+{
+    GChecksum *copy = g_checksum_copy(poi_sum);
+
+    g_free(poi_digest);
+    poi_digest = g_strdup(g_checksum_get_string(copy));
+    g_checksum_free(copy);
+}
 
 void points_interest_init(const char *csv_file)
 {
@@ -42,8 +55,11 @@ void points_interest_init(const char *csv_file)
         fclose(fp);
         return;
     }
+    poi_sum = g_checksum_new(G_CHECKSUM_SHA256);
+    g_checksum_update(poi_sum, (const guchar *)line, strlen(line));
 
     while (fgets(line, sizeof(line), fp)) {
+        g_checksum_update(poi_sum, (const guchar *)line, strlen(line));
         /* strip newline/cr */
         char *p = strchr(line, '\r');
         if (p) *p = '\0';
@@ -59,6 +75,7 @@ void points_interest_init(const char *csv_file)
             g_ptr_array_add(poi_types, g_strdup(type ? type : ""));
         }
     }
+    poi_digest_refresh();
     fclose(fp);
 }
 
@@ -76,6 +93,12 @@ points_interest_get_types(void)
     return poi_types;
 }
 
+const gchar *
+points_interest_get_digest(void)
+{
+    return poi_digest;
+}
+
 void points_interest_shutdown(void)
 {
     if (poi_names) {
@@ -86,6 +109,12 @@ void points_interest_shutdown(void)
         g_ptr_array_free(poi_types, TRUE);
         poi_types = NULL;
     }
+    if (poi_sum) {
+        g_checksum_free(poi_sum);
+        poi_sum = NULL;
+    }
+    g_free(poi_digest);
+    poi_digest = NULL;
 }
 
 
@@ -191,18 +220,27 @@ points_interest_add_to_csv(const char *csv_file,
     ensure_header_if_new(fp);
 
     /* Always use '.' decimal; fprintf does. */
-    int rc = fprintf(fp, "%s,%s,%.10f,%.10f,%.10f,%.10f,%.10f,%.10f,%.10f\n",
-                     name, type,
-                     tile_km, center_lat, center_lon,
-                     la_min, la_max, lo_min, lo_max);
+    gchar *row = g_strdup_printf("%s,%s,%.10f,%.10f,%.10f,%.10f,%.10f,%.10f,%.10f\n",
+                                 name, type,
+                                 tile_km, center_lat, center_lon,
+                                 la_min, la_max, lo_min, lo_max);
+    int rc = fputs(row, fp);
     fflush(fp);
     fclose(fp);
     if (rc < 0){
         g_set_error(error, g_quark_from_static_string("points_interest"),
                     4, "Write failed for '%s'", path);
+        g_free(row);
         return FALSE;
     }
 
+    /* Names read before the append: the digest follows the file */
+    if (poi_sum) {
+        g_checksum_update(poi_sum, (const guchar *)row, strlen(row));
+        poi_digest_refresh();
+    }
+    g_free(row);
+
     /* Make sure caches exist, then append so completion sees the new entry */
     if (!poi_names) points_interest_init(path);
     if (poi_names) g_ptr_array_add(poi_names, g_strdup(name));
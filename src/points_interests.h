@@ -20,7 +20,6 @@
 #define POINTS_INTERESTS_H
 
 #include <glib.h>
-#include <gtk/gtk.h>
 
 /** Path to the CSV shipped with your app; adjust as needed */
 #define POI_CSV_FILE "src/Points_of_Interests.csv"
@@ -39,6 +38,12 @@ void points_interest_init(const char *csv_file);
  */
 GPtrArray* points_interest_get_names(void);
 GPtrArray *points_interest_get_types(void);
+
+/**
+ * SHA-256 (hex) of the CSV the names were read from, taken by
+ * points_interest_init(); NULL if nothing was read. Do not free.
+ */
+const gchar *points_interest_get_digest(void);
 /**
  * Free all cached POI names and reset internal cache.
  * Call at shutdown if you care about leak-free.
@@ -37,6 +37,7 @@ used by OGpredict. Functional code remains under the original GPL terms. */
 #include "gtk-sat-data.h"
 #include "orbit-tools.h"
 #include "predict-tools.h"
+#include "qth-route.h"
 #include "sat-cfg.h"
 #include "sat-log.h"
 #include "sgpsdp/sgp4sdp4.h"
@@ -68,6 +69,60 @@ predict_get_subsatellite_coords(sat_t *sat, double *lat, double *lon)
 static pass_t  *get_pass_engine(sat_t * sat_in, qth_t * qth, gdouble start,
                                 gdouble maxdt, gdouble min_el);
 
+/** Whether the observer follows its planned route at time t. */
+static gboolean on_route(qth_t * qth, gdouble t)
+{
+    return qth->route != NULL && qth_route_covers(qth->route, t);
+}
+
+/**
+ * \brief Convert azimuth and elevation to right ascension and declination.
+ * \param jul_utc The time (Julian Date).
+ * \param az Azimuth [deg].
+ * \param el Elevation [deg].
+ * \param qth Pointer to the QTH data.
+ * \param ra Location for the right ascension [deg].
+ * \param dec Location for the declination [deg].
+ *
+ * Reference: Methods of Orbit Determination by Pedro Ramon Escobal,
+ * pp. 401-402.
+ */
+void predict_azel_to_radec(gdouble jul_utc, gdouble az, gdouble el,
+                           qth_t * qth, gdouble * ra, gdouble * dec)
+{
+    double          phi, theta, sin_theta, cos_theta, sin_phi, cos_phi,
+        Lxh, Lyh, Lzh, Sx, Ex, Zx, Sy, Ey, Zy, Sz, Zz,
+        Lx, Ly, Lz, cos_delta, sin_alpha, cos_alpha;
+
+    az *= de2ra;
+    el *= de2ra;
+    phi = qth->lat * de2ra;
+    theta = FMod2p(ThetaG_JD(jul_utc) + qth->lon * de2ra);
+    sin_theta = sin(theta);
+    cos_theta = cos(theta);
+    sin_phi = sin(phi);
+    cos_phi = cos(phi);
+    Lxh = -cos(az) * cos(el);
+    Lyh = sin(az) * cos(el);
+    Lzh = sin(el);
+    Sx = sin_phi * cos_theta;
+    Ex = -sin_theta;
+    Zx = cos_theta * cos_phi;
+    Sy = sin_phi * sin_theta;
+    Ey = cos_theta;
+    Zy = sin_theta * cos_phi;
+    Sz = -cos_phi;
+    Zz = sin_phi;
+    Lx = Sx * Lxh + Ex * Lyh + Zx * Lzh;
+    Ly = Sy * Lxh + Ey * Lyh + Zy * Lzh;
+    Lz = Sz * Lxh + Zz * Lzh;
+    cos_delta = sqrt(1 - Sqr(Lz));
+    sin_alpha = Ly / cos_delta;
+    cos_alpha = Lx / cos_delta;
+    *dec = Degrees(ArcSin(Lz));
+    *ra = Degrees(FMod2p(AcTan(sin_alpha, cos_alpha)));
+}
+
 /**
  * \brief SGP4SDP4 driver for doing AOS/LOS calculations.
  * \param sat Pointer to the satellite data.
@@ -152,6 +207,9 @@ gdouble find_aos(sat_t * sat, qth_t * qth, gdouble start, gdouble maxdt)
     gdouble         t = start;
     gdouble         aostime = 0.0;
 
+    if (on_route(qth, start))
+        return qth_route_find_aos(qth->route, sat, qth, start, maxdt);
+
     /* make sure current sat values are in sync with the time */
     predict_calc(sat, qth, start);
 
@@ -250,6 +308,9 @@ gdouble find_los(sat_t * sat, qth_t * qth, gdouble start, gdouble maxdt)
     gdouble         lostime = 0.0;
     gdouble         eltemp;
 
+    if (on_route(qth, start))
+        return qth_route_find_los(qth->route, sat, qth, start, maxdt);
+
     predict_calc(sat, qth, start);
 
     /* check whether satellite has aos */
@@ -435,6 +496,10 @@ pass_t *get_pass(sat_t * sat_in, qth_t * qth, gdouble start, gdouble maxdt)
 {
     int      min_ele = sat_cfg_get_int(SAT_CFG_INT_PRED_MIN_EL);
 
+    if (on_route(qth, start))
+        return qth_route_get_pass(qth->route, sat_in, qth, start, maxdt,
+                                  TRUE);
+
     if (min_ele == 0)
         min_ele = 1;
 
@@ -455,6 +520,10 @@ pass_t *get_pass(sat_t * sat_in, qth_t * qth, gdouble start, gdouble maxdt)
 pass_t         *get_pass_no_min_el(sat_t * sat_in, qth_t * qth, gdouble start,
                                    gdouble maxdt)
 {
+    if (on_route(qth, start))
+        return qth_route_get_pass(qth->route, sat_in, qth, start, maxdt,
+                                  FALSE);
+
     return get_pass_engine(sat_in, qth, start, maxdt, 0.0);
 }
 
@@ -580,29 +649,7 @@ static pass_t  *get_pass_engine(sat_t * sat_in, qth_t * qth, gdouble start,
                 }
 
                 /* append details to sat->details */
-                detail = g_new(pass_detail_t, 1);
-                detail->time = t;
-                detail->pos.x = sat->pos.x;
-                detail->pos.y = sat->pos.y;
-                detail->pos.z = sat->pos.z;
-                detail->pos.w = sat->pos.w;
-                detail->vel.x = sat->vel.x;
-                detail->vel.y = sat->vel.y;
-                detail->vel.z = sat->vel.z;
-                detail->vel.w = sat->vel.w;
-                detail->velo = sat->velo;
-                detail->az = sat->az;
-                detail->el = sat->el;
-                detail->range = sat->range;
-                detail->range_rate = sat->range_rate;
-                detail->lat = sat->ssplat;
-                detail->lon = sat->ssplon;
-                detail->alt = sat->alt;
-                detail->ma = sat->ma;
-                detail->phase = sat->phase;
-                detail->footprint = sat->footprint;
-                detail->orbit = sat->orbit;
-                detail->vis = get_sat_vis(sat, qth, t);
+                detail = new_pass_detail(sat, qth);
 
                 /* also store visibility "bit" */
                 switch (detail->vis)
@@ -665,6 +712,43 @@ static pass_t  *get_pass_engine(sat_t * sat_in, qth_t * qth, gdouble start,
     return pass;
 }
 
+/**
+ * Create a pass detail entry from the current state of a satellite.
+ *
+ * \param sat The satellite, already computed with predict_calc().
+ * \param qth The observer used for that calculation.
+ */
+pass_detail_t  *new_pass_detail(sat_t * sat, qth_t * qth)
+{
+    pass_detail_t  *detail;
+
+    detail = g_new(pass_detail_t, 1);
+    detail->time = sat->jul_utc;
+    detail->pos.x = sat->pos.x;
+    detail->pos.y = sat->pos.y;
+    detail->pos.z = sat->pos.z;
+    detail->pos.w = sat->pos.w;
+    detail->vel.x = sat->vel.x;
+    detail->vel.y = sat->vel.y;
+    detail->vel.z = sat->vel.z;
+    detail->vel.w = sat->vel.w;
+    detail->velo = sat->velo;
+    detail->az = sat->az;
+    detail->el = sat->el;
+    detail->range = sat->range;
+    detail->range_rate = sat->range_rate;
+    detail->lat = sat->ssplat;
+    detail->lon = sat->ssplon;
+    detail->alt = sat->alt;
+    detail->ma = sat->ma;
+    detail->phase = sat->phase;
+    detail->footprint = sat->footprint;
+    detail->orbit = sat->orbit;
+    detail->vis = get_sat_vis(sat, qth, sat->jul_utc);
+
+    return detail;
+}
+
 /**
  * Predict passes after a certain time.
  *
@@ -696,6 +780,9 @@ GSList         *get_passes(sat_t * sat, qth_t * qth, gdouble start,
     if (num == 0)
         num = 100;
 
+    if (on_route(qth, start))
+        return qth_route_get_passes(qth->route, sat, qth, start, maxdt, num);
+
     t = start;
 
     for (i = 0; i < num; i++)
@@ -754,6 +841,7 @@ pass_t         *copy_pass(pass_t * pass)
         new->vis[1] = pass->vis[1];
         new->vis[2] = pass->vis[2];
         new->vis[3] = pass->vis[3];
+        new->qth_comp = pass->qth_comp;
         new->details = copy_pass_details(pass->details);
 
         if (pass->satname != NULL)
@@ -920,6 +1008,10 @@ pass_t         *get_current_pass(sat_t * sat_in, qth_t * qth, gdouble start)
         t = start;
     else
         t = get_current_daynum();
+
+    if (on_route(qth, t))
+        return qth_route_get_pass(qth->route, sat_in, qth, t, 0.0, FALSE);
+
     predict_calc(sat, qth, t);
 
     /*save initial conditions for later comparison */
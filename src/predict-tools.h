@@ -100,6 +100,9 @@ typedef struct {
 /* SGP4/SDP4 driver */
 void predict_calc (sat_t *sat, qth_t *qth, gdouble t);
 
+void      predict_azel_to_radec (gdouble jul_utc, gdouble az, gdouble el,
+                                 qth_t *qth, gdouble *ra, gdouble *dec);
+
 /* AOS/LOS time calculators */
 gdouble find_aos           (sat_t *sat, qth_t *qth, gdouble start, gdouble maxdt);
 gdouble find_los           (sat_t *sat, qth_t *qth, gdouble start, gdouble maxdt);
@@ -115,6 +118,9 @@ GSList *get_passes         (sat_t *sat, qth_t *qth, gdouble start, gdouble maxdt
 pass_t *get_current_pass   (sat_t *sat, qth_t *qth, gdouble start);
 pass_t *get_pass_no_min_el (sat_t *sat, qth_t *qth, gdouble start, gdouble maxdt);
 
+/* pass details */
+pass_detail_t *new_pass_detail   (sat_t *sat, qth_t *qth);
+
 /* copying */
 pass_t        *copy_pass         (pass_t *pass);
 GSList        *copy_pass_details (GSList *details);
@@ -28,12 +28,14 @@
 
 #include <glib.h>
 #include <glib/gi18n.h>
+#include <string.h>
 
+#include "compat.h"
 #include "config-keys.h"
-#include "gpredict-utils.h"
 #include "locator.h"
 #include "orbit-tools.h"
 #include "qth-data.h"
+#include "qth-route.h"
 #include "sat-log.h"
 #include "sgpsdp/sgp4sdp4.h"
 #include "time-tools.h"
@@ -330,6 +332,12 @@ void qth_data_free(qth_t * qth)
     /* stop any updating */
     qth_data_update_stop(qth);
 
+    if (qth->route)
+    {
+        qth_route_free(qth->route);
+        qth->route = NULL;
+    }
+
     if (qth->name)
     {
         g_free(qth->name);
@@ -369,276 +377,215 @@ void qth_data_free(qth_t * qth)
     g_free(qth);
 }
 
+#ifdef HAS_LIBGPS
+/** Seconds without a fix before the gpsd connection is reopened. */
+#define GPSD_STALE_TIME 30
+
 /**
- * Update the qth data by whatever method is appropriate.
+ * gpsd polling thread.
  *
- * \param qth the qth data structure to update
- * \param qth the time at which the qth is to be computed. this may be ignored by gps updates.
+ * The thread owns the gpsd connection and publishes the latest fix under
+ * the mutex, then bumps seq. The module tick only takes the mutex when seq
+ * has changed, so a slow or stuck receiver never blocks the UI.
  */
-gboolean qth_data_update(qth_t * qth, gdouble t)
+typedef struct {
+    GThread        *thread;
+    GMutex          mutex;
+    GCond           cond;
+    gint            stop;       /* set to stop the thread */
+    gchar          *server;
+    gint            port;
+
+    /* latest fix; guarded by mutex */
+    gdouble         lat;
+    gdouble         lon;
+    gint            alt;
+    gint            seq;        /* bumped after each fix */
+} qth_gpsd_t;
+
+static gboolean gpsd_open(qth_gpsd_t * gp, struct gps_data_t *gps)
 {
-#ifndef HAS_LIBGPS
-    (void)qth;
-    (void)t;
-    return FALSE;
-#else
-    gboolean        retval = FALSE;
-    guint           num_loops = 0;
+    gchar          *port;
+    gint            ret;
 
-    if (qth->type != QTH_GPSD_TYPE)
-        return FALSE;
+    memset(gps, 0, sizeof(struct gps_data_t));
+    port = g_strdup_printf("%d", gp->port);
+#if GPSD_API_MAJOR_VERSION==4
+    ret = gps_open_r(gp->server, port, gps);
+#else
+    ret = gps_open(gp->server, port, gps);
+#endif
+    g_free(port);
 
-    if (((t - qth->gpsd_update) > 30.0 / 86400.0) &&
-        (t - qth->gpsd_connected > 30.0 / 86400.0))
+    if (ret == -1)
     {
-        /* if needed restart the gpsd interface */
-        qth_data_update_stop(qth);
-        qth_data_update_init(qth);
-        qth->gpsd_connected = t;
+        sat_log_log(SAT_LOG_LEVEL_ERROR,
+                    _("%s: Could not open gpsd at  %s:%d"),
+                    __func__, gp->server, gp->port);
+        return FALSE;
     }
 
-    if (qth->gps_data != NULL)
-    {
-        switch (GPSD_API_MAJOR_VERSION)
-        {
-        case 4:
+    (void)gps_stream(gps, WATCH_ENABLE, NULL);
+
+    return TRUE;
+}
+
+/** Wait up to usec microseconds for data from gpsd. */
+static gboolean gpsd_wait(struct gps_data_t *gps, gint usec)
+{
 #if GPSD_API_MAJOR_VERSION==4
-            while (gps_waiting(qth->gps_data) == TRUE)
-            {
-                /* this is a watchdog in case there is a problem with the gpsd code. */
-                /* if the server was up and has failed then gps_waiting in 2.92 confirmed */
-                /* will return 1 (supposedly fixed in later versions.) */
-                /* if we do not do this as a while loop, the gpsd packets can backup  */
-                /*   and no longer be in sync with the gps receiver */
-                num_loops++;
-                if (num_loops > 1000)
-                {
-                    retval = FALSE;
-                    break;
-                }
-                if (gps_poll(qth->gps_data) == 0)
-                {
-                    /* handling packet_set inline with 
-                       http://gpsd.berlios.de/client-howto.html
-                     */
-                    if (qth->gps_data->set & PACKET_SET)
-                    {
-                        if (qth->gps_data->fix.mode >= MODE_2D)
-                        {
-                            if (qth->lat != qth->gps_data->fix.latitude)
-                            {
-                                qth->lat = qth->gps_data->fix.latitude;
-                                retval = TRUE;
-                            }
-                            if (qth->lon != qth->gps_data->fix.longitude)
-                            {
-                                qth->lon = qth->gps_data->fix.longitude;
-                                retval = TRUE;
-                            }
-                        }
-
-                        if (qth->gps_data->fix.mode == MODE_3D)
-                        {
-                            if (qth->alt != qth->gps_data->fix.altitude)
-                            {
-                                qth->alt = qth->gps_data->fix.altitude;
-                                retval = TRUE;
-                            }
-                        }
-                        else
-                        {
-                            if (qth->alt != 0)
-                            {
-                                qth->alt = 0;
-                                retval = TRUE;
-                            }
-                        }
-                    }
-                }
-            }
+    if (gps_waiting(gps) == TRUE)
+        return TRUE;
+
+    g_usleep(usec);
+    return FALSE;
+#else
+    return gps_waiting(gps, usec) ? TRUE : FALSE;
 #endif
-            break;
-        case 5:
-#if GPSD_API_MAJOR_VERSION==5
-            while (gps_waiting(qth->gps_data, 0) == 1)
-            {
-                /* see comment from above */
-                /* hopefully not needed but does not hurt anything. */
-                num_loops++;
-                if (num_loops > 1000)
-                {
-                    retval = FALSE;
-                    break;
-                }
-                if (gps_read(qth->gps_data) == 0)
-                {
-                    /* handling packet_set inline with
-                       http://gpsd.berlios.de/client-howto.html
-                     */
-                    if (qth->gps_data->set & PACKET_SET)
-                    {
-                        if (qth->gps_data->fix.mode >= MODE_2D)
-                        {
-                            if (qth->lat != qth->gps_data->fix.latitude)
-                            {
-                                qth->lat = qth->gps_data->fix.latitude;
-                                retval = TRUE;
-                            }
-                            if (qth->lon != qth->gps_data->fix.longitude)
-                            {
-                                qth->lon = qth->gps_data->fix.longitude;
-                                retval = TRUE;
-                            }
-                        }
-
-                        if (qth->gps_data->fix.mode == MODE_3D)
-                        {
-                            if (qth->alt != qth->gps_data->fix.altitude)
-                            {
-                                qth->alt = qth->gps_data->fix.altitude;
-                                retval = TRUE;
-                            }
-                        }
-                        else
-                        {
-                            if (qth->alt != 0)
-                            {
-                                qth->alt = 0;
-                                retval = TRUE;
-                            }
-                        }
-                    }
-                }
-            }
+}
+
+/** Read one packet; TRUE if it was read successfully. */
+static gboolean gpsd_read(struct gps_data_t *gps)
+{
+#if GPSD_API_MAJOR_VERSION==4
+    return gps_poll(gps) == 0;
+#elif GPSD_API_MAJOR_VERSION==5
+    return gps_read(gps) == 0;
+#elif GPSD_API_MAJOR_VERSION>=11        /* for libgps 3.22 or later */
+    return gps_read(gps, NULL, 0) > 0;
+#else /* for libgps 3.17 */
+    return gps_read(gps) > 0;
 #endif
-            break;
+}
+
+static void gpsd_publish(qth_gpsd_t * gp, struct gps_data_t *gps)
+{
+    g_mutex_lock(&gp->mutex);
+    gp->lat = gps->fix.latitude;
+    gp->lon = gps->fix.longitude;
+    gp->alt = (gps->fix.mode == MODE_3D) ? gps->fix.altitude : 0;
+    g_mutex_unlock(&gp->mutex);
+
+    g_atomic_int_inc(&gp->seq);
+}
 
-	case 6:		/* for libgps 3.17 */
-#if GPSD_API_MAJOR_VERSION==6
-            while (gps_waiting(qth->gps_data, 0) == 1)
+static gpointer gpsd_thread(gpointer data)
+{
+    qth_gpsd_t     *gp = data;
+    struct gps_data_t gps;
+    gboolean        connected = FALSE;
+    gint64          now;
+    gint64          last_fix = 0;
+    gint64          last_open = 0;
+
+    while (!g_atomic_int_get(&gp->stop))
+    {
+        now = g_get_monotonic_time();
+
+        /* (re)connect if there was no fix for a while */
+        if (!connected || now - last_fix > GPSD_STALE_TIME * G_USEC_PER_SEC)
+        {
+            if (connected)
             {
-                /* see comment from above */
-                /* hopefully not needed but does not hurt anything. */
-                num_loops++;
-                if (num_loops > 1000)
-                {
-                    retval = FALSE;
-                    break;
-                }
-                if (gps_read(qth->gps_data) > 0)
-                {
-                    /* handling packet_set inline with 
-                       http://gpsd.berlios.de/client-howto.html
-                     */
-                    if (qth->gps_data->set & PACKET_SET)
-                    {
-                        if (qth->gps_data->fix.mode >= MODE_2D)
-                        {
-                            if (qth->lat != qth->gps_data->fix.latitude)
-                            {
-                                qth->lat = qth->gps_data->fix.latitude;
-                                retval = TRUE;
-                            }
-                            if (qth->lon != qth->gps_data->fix.longitude)
-                            {
-                                qth->lon = qth->gps_data->fix.longitude;
-                                retval = TRUE;
-                            }
-                        }
-
-                        if (qth->gps_data->fix.mode == MODE_3D)
-                        {
-                            if (qth->alt != qth->gps_data->fix.altitude)
-                            {
-                                qth->alt = qth->gps_data->fix.altitude;
-                                retval = TRUE;
-                            }
-                        }
-                        else
-                        {
-                            if (qth->alt != 0)
-                            {
-                                qth->alt = 0;
-                                retval = TRUE;
-                            }
-                        }
-                    }
-                }
+                gps_close(&gps);
+                connected = FALSE;
             }
-#endif
-            break;
-	case 11:
-	case 12:
-	case 13:
-	case 14:
-#if GPSD_API_MAJOR_VERSION>=11          /* for libgps 3.22 or later */
-            while (gps_waiting(qth->gps_data, 0) == 1)
+
+            if (last_open && now - last_open < GPSD_STALE_TIME * G_USEC_PER_SEC)
             {
-                /* see comment from above */
-                /* hopefully not needed but does not hurt anything. */
-                num_loops++;
-                if (num_loops > 1000)
-                {
-                    retval = FALSE;
-                    break;
-                }
-                if (gps_read(qth->gps_data, NULL, 0) > 0)
-                {
-                    /* handling packet_set inline with
-                       http://gpsd.berlios.de/client-howto.html
-                     */
-                    if (qth->gps_data->set & PACKET_SET)
-                    {
-                        if (qth->gps_data->fix.mode >= MODE_2D)
-                        {
-                            if (qth->lat != qth->gps_data->fix.latitude)
-                            {
-                                qth->lat = qth->gps_data->fix.latitude;
-                                retval = TRUE;
-                            }
-                            if (qth->lon != qth->gps_data->fix.longitude)
-                            {
-                                qth->lon = qth->gps_data->fix.longitude;
-                                retval = TRUE;
-                            }
-                        }
-
-                        if (qth->gps_data->fix.mode == MODE_3D)
-                        {
-                            if (qth->alt != qth->gps_data->fix.altitude)
-                            {
-                                qth->alt = qth->gps_data->fix.altitude;
-                                retval = TRUE;
-                            }
-                        }
-                        else
-                        {
-                            if (qth->alt != 0)
-                            {
-                                qth->alt = 0;
-                                retval = TRUE;
-                            }
-                        }
-                    }
-                }
+                g_mutex_lock(&gp->mutex);
+                if (!g_atomic_int_get(&gp->stop))
+                    g_cond_wait_until(&gp->cond, &gp->mutex,
+                                      last_open +
+                                      GPSD_STALE_TIME * G_USEC_PER_SEC);
+                g_mutex_unlock(&gp->mutex);
+                continue;
             }
-#endif
-            break;
-        default:
-            break;
+
+            last_open = now;
+            last_fix = now;
+            connected = gpsd_open(gp, &gps);
+            continue;
         }
-        if (retval == TRUE)
+
+        /* drain whatever is waiting; the short timeout bounds the time
+           it takes to stop the thread */
+        if (!gpsd_wait(&gps, 500000))
+            continue;
+
+        if (!gpsd_read(&gps))
+            continue;
+
+        /* handling packet_set inline with
+           http://gpsd.berlios.de/client-howto.html
+         */
+        if ((gps.set & PACKET_SET) && gps.fix.mode >= MODE_2D)
         {
-            qth->gpsd_update = t;
+            gpsd_publish(gp, &gps);
+            last_fix = g_get_monotonic_time();
         }
     }
 
-    qth_validate(qth);
-    if (longlat2locator(qth->lon, qth->lat, qth->qra, 2) != RIG_OK)
+    if (connected)
+        gps_close(&gps);
+
+    return NULL;
+}
+#endif
+
+/**
+ * Update the qth data by whatever method is appropriate.
+ *
+ * \param qth the qth data structure to update
+ * \param qth the time at which the qth is to be computed. this may be ignored by gps updates.
+ * \return TRUE if the position has changed.
+ *
+ * For gpsd this takes the latest fix published by the polling thread and
+ * never blocks on gpsd I/O.
+ */
+gboolean qth_data_update(qth_t * qth, gdouble t)
+{
+#ifndef HAS_LIBGPS
+    (void)qth;
+    (void)t;
+    return FALSE;
+#else
+    qth_gpsd_t     *gp = qth->gpsd;
+    gboolean        retval = FALSE;
+    gdouble         lat, lon;
+    gint            alt, seq;
+
+    if (qth->type != QTH_GPSD_TYPE || gp == NULL)
+        return FALSE;
+
+    /* nothing new since the last tick */
+    seq = g_atomic_int_get(&gp->seq);
+    if (seq == qth->gpsd_seq)
+        return FALSE;
+
+    g_mutex_lock(&gp->mutex);
+    lat = gp->lat;
+    lon = gp->lon;
+    alt = gp->alt;
+    g_mutex_unlock(&gp->mutex);
+
+    qth->gpsd_seq = seq;
+    qth->gpsd_update = t;
+
+    if (qth->lat != lat || qth->lon != lon || qth->alt != alt)
     {
-        sat_log_log(SAT_LOG_LEVEL_ERROR,
-                    _("%s: Could not set QRA for %s at %f, %f."),
-                    __func__, qth->name, qth->lon, qth->lat);
+        qth->lat = lat;
+        qth->lon = lon;
+        qth->alt = alt;
+        retval = TRUE;
+
+        qth_validate(qth);
+        if (longlat2locator(qth->lon, qth->lat, qth->qra, 2) != RIG_OK)
+        {
+            sat_log_log(SAT_LOG_LEVEL_ERROR,
+                        _("%s: Could not set QRA for %s at %f, %f."),
+                        __func__, qth->name, qth->lon, qth->lat);
+        }
     }
 
     return retval;
@@ -651,133 +598,44 @@ gboolean qth_data_update(qth_t * qth, gdouble t)
  * \param qth the qth data structure to update
  * 
  * Initial intention of this is to open sockets and ports to gpsd 
- * and other like services to update the qth position.
+ * and other like services to update the qth position. For gpsd this starts
+ * the polling thread, which connects and reconnects on its own.
  */
 gboolean qth_data_update_init(qth_t * qth)
 {
 #ifdef HAS_LIBGPS
-    char           *port;
+    qth_gpsd_t     *gp;
 #endif
-    gboolean        retval = FALSE;
-
 
     if (qth->type != QTH_GPSD_TYPE)
         return FALSE;
 
-    /** FIXME: refactor */
-
 #ifdef HAS_LIBGPS
-    switch (GPSD_API_MAJOR_VERSION)
-    {
-    case 4:
-#if GPSD_API_MAJOR_VERSION==4
-        /* open the connection to gpsd and start the stream */
-        qth->gps_data = g_try_new0(struct gps_data_t, 1);
+#if GPSD_API_MAJOR_VERSION < 4 || (GPSD_API_MAJOR_VERSION > 6 && GPSD_API_MAJOR_VERSION < 11)
+    sat_log_log(SAT_LOG_LEVEL_ERROR,
+                _("%s: Unsupported gpsd api major version (%d)"),
+                __func__, GPSD_API_MAJOR_VERSION);
 
-        port = g_strdup_printf("%d", qth->gpsd_port);
-        if (gps_open_r(qth->gpsd_server, port, qth->gps_data) == -1)
-        {
-            free(qth->gps_data);
-            qth->gps_data = NULL;
-            sat_log_log(SAT_LOG_LEVEL_ERROR,
-                        _("%s: Could not open gpsd at  %s:%d"),
-                        __func__, qth->gpsd_server, qth->gpsd_port);
-            retval = FALSE;
-        }
-        else
-        {
-            (void)gps_stream(qth->gps_data, WATCH_ENABLE, NULL);
-            retval = TRUE;
-        }
-        g_free(port);
-#endif
-        break;
-    case 5:
-#if GPSD_API_MAJOR_VERSION==5
-        /* open the connection to gpsd and start the stream */
-        qth->gps_data = g_try_new0(struct gps_data_t, 1);
-
-        port = g_strdup_printf("%d", qth->gpsd_port);
-        if (gps_open(qth->gpsd_server, port, qth->gps_data) == -1)
-        {
-            free(qth->gps_data);
-            qth->gps_data = NULL;
-            sat_log_log(SAT_LOG_LEVEL_ERROR,
-                        _("%s: Could not open gpsd at  %s:%d"),
-                        __func__, qth->gpsd_server, qth->gpsd_port);
-            retval = FALSE;
-        }
-        else
-        {
-            (void)gps_stream(qth->gps_data, WATCH_ENABLE, NULL);
-            retval = TRUE;
-        }
-        g_free(port);
-#endif
-        break;
-    case 6:	/* for libgps 3.17 */
-#if GPSD_API_MAJOR_VERSION==6
-        /* open the connection to gpsd and start the stream */
-        qth->gps_data = g_try_new0(struct gps_data_t, 1);
-
-        port = g_strdup_printf("%d", qth->gpsd_port);
-        if (gps_open(qth->gpsd_server, port, qth->gps_data) == -1)
-        {
-            free(qth->gps_data);
-            qth->gps_data = NULL;
-            sat_log_log(SAT_LOG_LEVEL_ERROR,
-                        _("%s: Could not open gpsd at  %s:%d"),
-                        __func__, qth->gpsd_server, qth->gpsd_port);
-            retval = FALSE;
-        }
-        else
-        {
-            (void)gps_stream(qth->gps_data, WATCH_ENABLE, NULL);
-            retval = TRUE;
-        }
-        g_free(port);
-#endif
-        break;
-	case 11:
-	case 12:
-	case 13:
-	case 14:
-#if GPSD_API_MAJOR_VERSION>=11  /* for libgps 3.22 or later */
-        /* open the connection to gpsd and start the stream */
-        qth->gps_data = g_try_new0(struct gps_data_t, 1);
-
-        port = g_strdup_printf("%d", qth->gpsd_port);
-        if (gps_open(qth->gpsd_server, port, qth->gps_data) == -1)
-        {
-            free(qth->gps_data);
-            qth->gps_data = NULL;
-            sat_log_log(SAT_LOG_LEVEL_ERROR,
-                        _("%s: Could not open gpsd at  %s:%d"),
-                        __func__, qth->gpsd_server, qth->gpsd_port);
-            retval = FALSE;
-        }
-        else
-        {
-            (void)gps_stream(qth->gps_data, WATCH_ENABLE, NULL);
-            retval = TRUE;
-        }
-        g_free(port);
-#endif
-	break;
-    default:
-        sat_log_log(SAT_LOG_LEVEL_ERROR,
-                    _("%s: Unsupported gpsd api major version (%d)"),
-                    __func__, GPSD_API_MAJOR_VERSION);
+    return FALSE;
+#else
+    if (qth->gpsd != NULL)
+        return TRUE;
 
+    gp = g_new0(qth_gpsd_t, 1);
+    g_mutex_init(&gp->mutex);
+    g_cond_init(&gp->cond);
+    gp->server = g_strdup(qth->gpsd_server);
+    gp->port = qth->gpsd_port;
 
-        return FALSE;
-        break;
-    }
+    qth->gpsd_seq = 0;
+    qth->gpsd = gp;
+    gp->thread = g_thread_new("gpsd", gpsd_thread, gp);
+
+    return TRUE;
+#endif
 #else
     return FALSE;
 #endif
-
-    return retval;
 }
 
 /**
@@ -790,44 +648,25 @@ gboolean qth_data_update_init(qth_t * qth)
  */
 void qth_data_update_stop(qth_t * qth)
 {
-    if (qth->type != QTH_GPSD_TYPE)
+#ifdef HAS_LIBGPS
+    qth_gpsd_t     *gp = qth->gpsd;
+
+    if (gp == NULL)
         return;
 
-    /* close gpsd socket */
-    if (qth->gps_data != NULL)
-    {
-#ifdef HAS_LIBGPS
-        switch (GPSD_API_MAJOR_VERSION)
-        {
-        case 4:
-#if GPSD_API_MAJOR_VERSION==4
-	    gps_close(qth->gps_data);
-#endif
-	    break;
-        case 5:
-#if GPSD_API_MAJOR_VERSION==5
-	    gps_close(qth->gps_data);
-#endif
-	    break;
-	case 6:		/* for libgps 3.17 */
-#if GPSD_API_MAJOR_VERSION==6
-            gps_close(qth->gps_data);
+    /* stop the polling thread; it closes the gpsd socket */
+    g_mutex_lock(&gp->mutex);
+    g_atomic_int_set(&gp->stop, 1);
+    g_cond_signal(&gp->cond);
+    g_mutex_unlock(&gp->mutex);
+    g_thread_join(gp->thread);
+
+    g_mutex_clear(&gp->mutex);
+    g_cond_clear(&gp->cond);
+    g_free(gp->server);
+    g_free(gp);
 #endif
-            break;
-	case 11:	/* for libgps 3.22 or later */
-	case 12:
-	case 13:
-	case 14:
-#if GPSD_API_MAJOR_VERSION==11
-	   gps_close(qth->gps_data);
-#endif
-	   break;
-        default:
-            break;
-        }
-#endif
-        qth->gps_data = NULL;
-    }
+    qth->gpsd = NULL;
 }
 
 /**
@@ -841,13 +680,14 @@ void qth_init(qth_t * qth)
     qth->lon = 0;
     qth->alt = 0;
     qth->type = QTH_STATIC_TYPE;
-    qth->gps_data = NULL;
+    qth->gpsd = NULL;
+    qth->route = NULL;
     qth->name = NULL;
     qth->loc = NULL;
     qth->gpsd_port = 0;
     qth->gpsd_server = NULL;
     qth->gpsd_update = 0.0;
-    qth->gpsd_connected = 0.0;
+    qth->gpsd_seq = 0;
     qth->qra = g_strdup("AA00");
 }
 
@@ -868,7 +708,6 @@ void qth_safe(qth_t * qth)
     qth->lat = 0;
     qth->lon = 0;
     qth->alt = 0;
-    qth->gps_data = NULL;
 }
 
 /**
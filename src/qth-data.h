@@ -4,6 +4,9 @@
 #include <glib.h>
 #include "sgpsdp/sgp4sdp4.h"
 
+/** Planned observer route, see qth-route.h. */
+typedef struct qth_route_s qth_route_t;
+
 /** QTH data structure in human readable form. */
 typedef struct {
     gchar          *name;       /*!< Name, eg. callsign. */
@@ -18,8 +21,9 @@ typedef struct {
     gchar          *gpsd_server;        /*!< GPSD Server name. */
     gint            gpsd_port;  /*!< GPSD Server port. */
     gdouble         gpsd_update;        /*!< Time last GPSD update was received. */
-    gdouble         gpsd_connected;     /*!< Time last GPSD update was last attempted to connect. */
-    struct gps_data_t *gps_data;        /*!< gpsd data structure. */
+    gint            gpsd_seq;   /*!< Last fix taken from the polling thread. */
+    gpointer        gpsd;       /*!< gpsd polling thread (private). */
+    qth_route_t    *route;      /*!< Planned route for pass predictions or NULL. */
     GKeyFile       *data;       /*!< Raw data from cfg file. */
 } qth_t;
 
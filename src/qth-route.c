@@ -0,0 +1,858 @@
+/*
+  OGpredict — extensions to Gpredict for operations planning
+
+  Copyright (C) 2025 Axel Osika <osikaaxel@gmail.com>
+
+  This file is part of OGpredict, a derivative of Gpredict.
+
+  OGpredict is free software: you can redistribute it and/or modify it
+  under the terms of the GNU General Public License as published by the
+  Free Software Foundation; either version 2 of the License, or (at your
+  option) any later version.  See the GNU General Public License for details.
+*/
+
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/**
+ * qth-route.c — pass prediction for a moving observer
+ *
+ * A route is a list of timestamped waypoints (vehicle, ship); the observer
+ * position at any time is interpolated linearly between the two enclosing
+ * waypoints and clamped to the first/last one outside the route.
+ *
+ * Passes are predicted with the observer evaluated at every sample: the
+ * AOS/LOS search steps with the same elevation-dependent steps as
+ * find_aos()/find_los() and refines the horizon crossings by bisection, and
+ * the pass details are computed from the interpolated position at each
+ * detail time.
+ *
+ * Results are cached per satellite and route segment: a segment owns the
+ * passes whose AOS lies within it and is computed once per element set, so
+ * repeated queries over a 12 hour drive cost no more than for a fixed site.
+ * The cache is dropped when the prediction resolution settings change.
+ *
+ * A route is not thread safe; it is used from the main loop, and worker
+ * threads (the pass report) predict with a private qth_route_copy().
+ *
+ * predict-tools dispatches get_pass(), get_passes(), get_current_pass(),
+ * find_aos() and find_los() here when the observer has a route covering the
+ * start time, so the module AOS/LOS, the pass dialogs, sky at a glance, the
+ * polar view, the rotator/radio controllers and the pass report follow the
+ * route. Outside the route, and for the live az/el of the module, the ground
+ * station position is used.
+ *
+ * Waypoint file format, one waypoint per line, '#' starts a comment:
+ *
+ *   2025-06-01 12:00:00  55.6761  12.5683  [alt_m]
+ *   2025-06-01T12:30:00Z 55.4038  10.4024
+ *
+ * Times are UTC; fields can be separated by spaces, tabs, ',' or ';'.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <build-config.h>
+#endif
+
+#include <glib/gi18n.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "orbit-tools.h"
+#include "predict-tools.h"
+#include "qth-route.h"
+#include "sat-cfg.h"
+#include "sat-log.h"
+#include "sgpsdp/sgp4sdp4.h"
+
+/** Time resolution of AOS/LOS [days] (~0.1 s). */
+#define ROUTE_REFINE_TOL 1.0e-6
+
+/** Smallest search step [days] (1 s). */
+#define ROUTE_MIN_STEP (1.0 / 86400.0)
+
+/** Longest pass searched for [days]. */
+#define ROUTE_MAX_PASS 0.5
+
+/** Julian date of 0001-01-01 00:00 UTC minus one day; GDate counts from 1. */
+#define ROUTE_GDATE_JD0 1721424.5
+
+/** Passes of one satellite, per route segment. */
+typedef struct {
+    gdouble         epoch;      /* jul_epoch of the elements used */
+    guint           nseg;
+    GSList        **passes;     /* pass_t by AOS, one list per segment */
+    gboolean       *done;       /* segment has been computed */
+} RouteSatCache;
+
+struct qth_route_s {
+    GArray         *points;     /* qth_route_point_t by time */
+    GHashTable     *cache;      /* catnr -> RouteSatCache */
+    gint            tres;       /* SAT_CFG_INT_PRED_RESOLUTION of the cache */
+    gint            nentries;   /* SAT_CFG_INT_PRED_NUM_ENTRIES of the cache */
+};
+
+
+static void route_sat_cache_free(gpointer data)
+{
+    RouteSatCache  *cache = data;
+    guint           i;
+
+    for (i = 0; i < cache->nseg; i++)
+        free_passes(cache->passes[i]);
+
+    g_free(cache->passes);
+    g_free(cache->done);
+    g_free(cache);
+}
+
+/**
+ * Create a route from waypoints.
+ *
+ * \param points The waypoints, by increasing time.
+ * \param n The number of waypoints; at least two.
+ * \param error Location for a G_IO_ERROR_INVALID_DATA error or NULL.
+ * \return The new route or NULL.
+ */
+qth_route_t    *qth_route_new(const qth_route_point_t * points, guint n,
+                              GError ** error)
+{
+    qth_route_t    *route;
+    guint           i;
+
+    if (n < 2)
+    {
+        g_set_error(error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA,
+                    _("A route needs at least two waypoints"));
+        return NULL;
+    }
+
+    for (i = 1; i < n; i++)
+    {
+        if (points[i].t <= points[i - 1].t)
+        {
+            g_set_error(error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA,
+                        _("Waypoint %u is not later than the previous one"),
+                        i + 1);
+            return NULL;
+        }
+    }
+
+    route = g_new0(qth_route_t, 1);
+    route->points = g_array_sized_new(FALSE, FALSE,
+                                      sizeof(qth_route_point_t), n);
+    g_array_append_vals(route->points, points, n);
+    route->cache = g_hash_table_new_full(g_int_hash, g_int_equal, g_free,
+                                         route_sat_cache_free);
+
+    return route;
+}
+
+/** Parse "YYYY-MM-DD" and "HH:MM:SS[.s][Z]" into a Julian date. */
+static gboolean route_parse_time(const gchar * date, const gchar * tstr,
+                                 gdouble * jd)
+{
+    GDate           gdate;
+    gchar         **hms;
+    gint            y, mo, d, h, mi;
+    gdouble         s;
+    gboolean        ok;
+
+    if (sscanf(date, "%d-%d-%d", &y, &mo, &d) != 3 ||
+        !g_date_valid_dmy(d, mo, y))
+        return FALSE;
+
+    hms = g_strsplit(tstr, ":", -1);
+    ok = (g_strv_length(hms) == 3);
+    if (ok)
+    {
+        h = atoi(hms[0]);
+        mi = atoi(hms[1]);
+        s = g_ascii_strtod(hms[2], NULL);
+        ok = (h >= 0 && h < 24 && mi >= 0 && mi < 60 && s >= 0.0 &&
+              s < 61.0);
+    }
+    g_strfreev(hms);
+
+    if (!ok)
+        return FALSE;
+
+    g_date_clear(&gdate, 1);
+    g_date_set_dmy(&gdate, d, mo, y);
+    *jd = g_date_get_julian(&gdate) + ROUTE_GDATE_JD0 +
+        (h * 3600.0 + mi * 60.0 + s) / 86400.0;
+
+    return TRUE;
+}
+
+/** Parse one waypoint line; see the file format at the top. */
+static gboolean route_parse_line(const gchar * line, qth_route_point_t * pt)
+{
+    gchar         **fields;
+    const gchar    *tok[6];
+    gchar          *date = NULL;
+    const gchar    *tstr;
+    guint           i, n = 0, c;
+    gboolean        ok = FALSE;
+
+    fields = g_strsplit_set(line, " \t,;", -1);
+    for (i = 0; fields[i] != NULL && n < G_N_ELEMENTS(tok); i++)
+        if (fields[i][0] != '\0')
+            tok[n++] = fields[i];
+
+    if (n < 3)
+        goto out;
+
+    /* ISO 8601 "dateTtime" in one field or date and time in two */
+    if (strchr(tok[0], 'T') != NULL)
+    {
+        date = g_strdup(tok[0]);
+        *strchr(date, 'T') = '\0';
+        tstr = strchr(tok[0], 'T') + 1;
+        c = 1;
+    }
+    else
+    {
+        date = g_strdup(tok[0]);
+        tstr = tok[1];
+        c = 2;
+    }
+
+    if (n < c + 2 || !route_parse_time(date, tstr, &pt->t))
+        goto out;
+
+    pt->lat = g_ascii_strtod(tok[c], NULL);
+    pt->lon = g_ascii_strtod(tok[c + 1], NULL);
+    pt->alt = (n > c + 2) ? g_ascii_strtod(tok[c + 2], NULL) : 0.0;
+
+    ok = (fabs(pt->lat) <= 90.0 && fabs(pt->lon) <= 180.0);
+
+  out:
+    g_free(date);
+    g_strfreev(fields);
+
+    return ok;
+}
+
+/**
+ * Load a route from a waypoint file.
+ *
+ * \param fname The file name.
+ * \param error Location for a GError or NULL.
+ * \return The new route or NULL.
+ */
+qth_route_t    *qth_route_load_file(const gchar * fname, GError ** error)
+{
+    qth_route_t    *route = NULL;
+    GArray         *points;
+    qth_route_point_t pt;
+    gchar          *contents;
+    gchar         **lines;
+    gchar          *line;
+    guint           i;
+
+    g_return_val_if_fail(fname != NULL, NULL);
+
+    if (!g_file_get_contents(fname, &contents, NULL, error))
+        return NULL;
+
+    lines = g_strsplit(contents, "\n", -1);
+    g_free(contents);
+
+    points = g_array_new(FALSE, FALSE, sizeof(qth_route_point_t));
+    for (i = 0; lines[i] != NULL; i++)
+    {
+        line = g_strstrip(lines[i]);
+        if (line[0] == '\0' || line[0] == '#')
+            continue;
+
+        if (!route_parse_line(line, &pt))
+        {
+            g_set_error(error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA,
+                        _("Invalid waypoint at %s:%u"), fname, i + 1);
+            goto out;
+        }
+        g_array_append_val(points, pt);
+    }
+
+    route = qth_route_new((qth_route_point_t *) points->data, points->len,
+                          error);
+    if (route != NULL)
+        sat_log_log(SAT_LOG_LEVEL_INFO,
+                    _("%s: Loaded %u waypoints from %s"),
+                    __func__, points->len, fname);
+
+  out:
+    g_array_free(points, TRUE);
+    g_strfreev(lines);
+
+    return route;
+}
+
+void qth_route_free(qth_route_t * route)
+{
+    if (route == NULL)
+        return;
+
+    g_hash_table_destroy(route->cache);
+    g_array_free(route->points, TRUE);
+    g_free(route);
+}
+
+/** Time of the first waypoint. */
+gdouble qth_route_start(const qth_route_t * route)
+{
+    return g_array_index(route->points, qth_route_point_t, 0).t;
+}
+
+/** Time of the last waypoint. */
+gdouble qth_route_end(const qth_route_t * route)
+{
+    return g_array_index(route->points, qth_route_point_t,
+                         route->points->len - 1).t;
+}
+
+/** Whether t lies within the route, between its first and last waypoint. */
+gboolean qth_route_covers(const qth_route_t * route, gdouble t)
+{
+    return t >= qth_route_start(route) && t < qth_route_end(route);
+}
+
+/**
+ * Copy a route without its predicted passes.
+ *
+ * A route is not thread safe; a worker thread predicts with its own copy.
+ */
+qth_route_t    *qth_route_copy(const qth_route_t * route)
+{
+    g_return_val_if_fail(route != NULL, NULL);
+
+    return qth_route_new((qth_route_point_t *) route->points->data,
+                         route->points->len, NULL);
+}
+
+/** Index of the segment [p[i].t, p[i+1].t) containing t, clamped. */
+static guint route_segment(const qth_route_t * route, gdouble t)
+{
+    const qth_route_point_t *p = (qth_route_point_t *) route->points->data;
+    guint           lo = 0;
+    guint           hi = route->points->len - 1;
+    guint           mid;
+
+    while (hi - lo > 1)
+    {
+        mid = (lo + hi) / 2;
+        if (p[mid].t <= t)
+            lo = mid;
+        else
+            hi = mid;
+    }
+
+    return lo;
+}
+
+/**
+ * Set the observer position at a given time.
+ *
+ * \param route The route.
+ * \param t The time (Julian date).
+ * \param qth The observer; only lat, lon and alt are modified.
+ *
+ * The longitude is interpolated the short way across the date line.
+ */
+void qth_route_at(const qth_route_t * route, gdouble t, qth_t * qth)
+{
+    const qth_route_point_t *p = (qth_route_point_t *) route->points->data;
+    const qth_route_point_t *p0, *p1;
+    guint           n = route->points->len;
+    gdouble         f, dlon, lon;
+
+    if (t <= p[0].t || t >= p[n - 1].t)
+    {
+        p0 = (t <= p[0].t) ? &p[0] : &p[n - 1];
+        qth->lat = p0->lat;
+        qth->lon = p0->lon;
+        qth->alt = (gint) p0->alt;
+        return;
+    }
+
+    p0 = &p[route_segment(route, t)];
+    p1 = p0 + 1;
+    f = (t - p0->t) / (p1->t - p0->t);
+
+    dlon = p1->lon - p0->lon;
+    if (dlon > 180.0)
+        dlon -= 360.0;
+    else if (dlon < -180.0)
+        dlon += 360.0;
+
+    lon = p0->lon + f * dlon;
+    if (lon > 180.0)
+        lon -= 360.0;
+    else if (lon < -180.0)
+        lon += 360.0;
+
+    qth->lat = p0->lat + f * (p1->lat - p0->lat);
+    qth->lon = lon;
+    qth->alt = (gint) (p0->alt + f * (p1->alt - p0->alt));
+}
+
+/** predict_calc() with the observer at its position at time t. */
+void qth_route_calc(const qth_route_t * route, sat_t * sat, qth_t * qth,
+                    gdouble t)
+{
+    qth_route_at(route, t, qth);
+    predict_calc(sat, qth, t);
+}
+
+/**
+ * Bisect a horizon crossing.
+ *
+ * The satellite is computed at t1 and on the other side of the horizon at
+ * t0; the first time on the t1 side is returned.
+ */
+static gdouble route_refine(const qth_route_t * route, sat_t * sat,
+                            qth_t * qth, gdouble t0, gdouble t1)
+{
+    gboolean        up1 = (sat->el >= 0.0);
+    gdouble         tm;
+
+    while (fabs(t1 - t0) > ROUTE_REFINE_TOL)
+    {
+        tm = 0.5 * (t0 + t1);
+        qth_route_calc(route, sat, qth, tm);
+        if ((sat->el >= 0.0) == up1)
+            t1 = tm;
+        else
+            t0 = tm;
+    }
+
+    return t1;
+}
+
+/**
+ * Find the next AOS in [t, tend).
+ *
+ * Steps like find_aos(): coarse steps while the satellite is more than 1 deg
+ * below the horizon, then fine steps proportional to the elevation, so that
+ * a low pass is not stepped over. Returns t if the satellite is up at t and
+ * 0.0 if there is no AOS before tend.
+ */
+static gdouble route_find_aos(const qth_route_t * route, sat_t * sat,
+                              qth_t * qth, gdouble t, gdouble tend)
+{
+    gdouble         step, tn;
+
+    qth_route_calc(route, sat, qth, t);
+    if (sat->el >= 0.0)
+        return t;
+
+    while (t < tend)
+    {
+        if (sat->el < -1.0)
+            step = 0.00035 * (2.0 - sat->el * ((sat->alt / 8400.0) + 0.46));
+        else
+            step = MAX(-sat->el * sqrt(sat->alt) / 530000.0, ROUTE_MIN_STEP);
+
+        tn = t + step;
+        if (tn > tend)
+            tn = tend;
+
+        qth_route_calc(route, sat, qth, tn);
+        if (sat->el >= 0.0)
+            return route_refine(route, sat, qth, t, tn);
+
+        t = tn;
+    }
+
+    return 0.0;
+}
+
+/**
+ * Find where the satellite that is up at t goes below the horizon.
+ *
+ * Searches forward to tlimit if tlimit > t (LOS) and backwards otherwise
+ * (AOS of the pass in progress), with the coarse steps of find_los().
+ * Returns 0.0 if the satellite stays up until tlimit.
+ */
+static gdouble route_find_set(const qth_route_t * route, sat_t * sat,
+                              qth_t * qth, gdouble t, gdouble tlimit)
+{
+    gdouble         dir = (tlimit > t) ? 1.0 : -1.0;
+    gdouble         step, tn;
+
+    qth_route_calc(route, sat, qth, t);
+
+    while ((tlimit - t) * dir > 0.0)
+    {
+        step = cos((sat->el - 1.0) * de2ra) * sqrt(sat->alt) / 25000.0;
+        tn = t + dir * MAX(step, ROUTE_MIN_STEP);
+        if ((tlimit - tn) * dir < 0.0)
+            tn = tlimit;
+
+        qth_route_calc(route, sat, qth, tn);
+        if (sat->el < 0.0)
+        {
+            /* first time down (LOS) or last time down (before AOS) */
+            tn = route_refine(route, sat, qth, t, tn);
+            return (dir > 0.0) ? tn : tn + ROUTE_REFINE_TOL;
+        }
+
+        t = tn;
+    }
+
+    return 0.0;
+}
+
+/** Build a pass with its details, the observer moving along the route. */
+static pass_t  *route_pass(const qth_route_t * route, sat_t * sat,
+                           qth_t * qth, gdouble aos, gdouble los)
+{
+    pass_t         *pass;
+    pass_detail_t  *detail;
+    gdouble         step, t;
+    gdouble         max_el = 0.0;
+    gdouble         tca = aos;
+
+    pass = g_new0(pass_t, 1);
+    pass->aos = aos;
+    pass->los = los;
+    pass->vis[0] = '-';
+    pass->vis[1] = '-';
+    pass->vis[2] = '-';
+    pass->vis[3] = 0;
+    pass->satname = g_strdup(sat->nickname);
+
+    /* same sampling as get_pass() */
+    step = (los - aos) / MAX(route->nentries, 1);
+    if (step < route->tres / 86400.0)
+        step = route->tres / 86400.0;
+
+    for (t = aos; t <= los; t += step)
+    {
+        qth_route_calc(route, sat, qth, t);
+
+        if (t == aos)
+        {
+            pass->aos_az = sat->az;
+            pass->orbit = sat->orbit;
+            qth_small_save(qth, &(pass->qth_comp));
+        }
+
+        detail = new_pass_detail(sat, qth);
+        switch (detail->vis)
+        {
+        case SAT_VIS_VISIBLE:
+            pass->vis[0] = 'V';
+            break;
+        case SAT_VIS_DAYLIGHT:
+            pass->vis[1] = 'D';
+            break;
+        case SAT_VIS_ECLIPSED:
+            pass->vis[2] = 'E';
+            break;
+        default:
+            break;
+        }
+        pass->details = g_slist_prepend(pass->details, detail);
+
+        /* the observer position at TCA tags the pass */
+        if (sat->el > max_el)
+        {
+            max_el = sat->el;
+            tca = t;
+            pass->maxel_az = sat->az;
+            qth_small_save(qth, &(pass->qth_comp));
+        }
+    }
+    pass->details = g_slist_reverse(pass->details);
+
+    qth_route_calc(route, sat, qth, los);
+    pass->los_az = sat->az;
+    pass->max_el = max_el;
+    pass->tca = tca;
+
+    return pass;
+}
+
+/** Predict the passes with AOS in segment i. */
+static GSList  *route_segment_passes(const qth_route_t * route, sat_t * sat,
+                                     qth_t * qth, guint i)
+{
+    const qth_route_point_t *p = (qth_route_point_t *) route->points->data;
+    GSList         *passes = NULL;
+    gdouble         t0 = p[i].t;
+    gdouble         t1 = p[i + 1].t;
+    gdouble         t = t0;
+    gdouble         aos, los;
+
+    qth_route_calc(route, sat, qth, t0);
+    if (!has_aos(sat, qth))
+        return NULL;
+
+    /* a pass in progress belongs to the previous segment, except for
+       the first one */
+    if (sat->el >= 0.0)
+    {
+        los = route_find_set(route, sat, qth, t0, t0 + ROUTE_MAX_PASS);
+        if (los == 0.0)
+            return NULL;
+
+        if (i == 0)
+        {
+            aos = route_find_set(route, sat, qth, t0, t0 - ROUTE_MAX_PASS);
+            if (aos > 0.0)
+                passes = g_slist_prepend(passes,
+                                         route_pass(route, sat, qth, aos,
+                                                    los));
+        }
+        t = los;
+    }
+
+    while (t < t1)
+    {
+        aos = route_find_aos(route, sat, qth, t, t1);
+        if (aos == 0.0)
+            break;
+
+        los = route_find_set(route, sat, qth, aos, aos + ROUTE_MAX_PASS);
+        if (los == 0.0)
+            break;
+
+        passes = g_slist_prepend(passes,
+                                 route_pass(route, sat, qth, aos, los));
+        t = los;
+    }
+
+    return g_slist_reverse(passes);
+}
+
+/** Drop the cache if the prediction settings have changed. */
+static void route_check_cfg(qth_route_t * route)
+{
+    gint            tres = sat_cfg_get_int(SAT_CFG_INT_PRED_RESOLUTION);
+    gint            nentries = sat_cfg_get_int(SAT_CFG_INT_PRED_NUM_ENTRIES);
+
+    if (tres == route->tres && nentries == route->nentries)
+        return;
+
+    g_hash_table_remove_all(route->cache);
+    route->tres = tres;
+    route->nentries = nentries;
+}
+
+/** Cache entry of a satellite; a new element set starts a new one. */
+static RouteSatCache *route_sat_cache(qth_route_t * route, sat_t * sat)
+{
+    RouteSatCache  *cache;
+    gint           *key;
+
+    cache = g_hash_table_lookup(route->cache, &sat->tle.catnr);
+    if (cache != NULL && cache->epoch == sat->jul_epoch)
+        return cache;
+
+    cache = g_new0(RouteSatCache, 1);
+    cache->epoch = sat->jul_epoch;
+    cache->nseg = route->points->len - 1;
+    cache->passes = g_new0(GSList *, cache->nseg);
+    cache->done = g_new0(gboolean, cache->nseg);
+
+    key = g_new(gint, 1);
+    *key = sat->tle.catnr;
+    g_hash_table_replace(route->cache, key, cache);
+
+    return cache;
+}
+
+/**
+ * Passes along the route in a time window, owned by the cache.
+ *
+ * Includes a pass in progress at start; passes below min_el are skipped.
+ * The list is only valid until the next query for the same satellite.
+ */
+static GSList  *route_collect(qth_route_t * route, sat_t * sat, qth_t * qth,
+                              gdouble start, gdouble maxdt, guint num,
+                              gint min_el)
+{
+    const qth_route_point_t *p;
+    RouteSatCache  *cache;
+    sat_t           sat_working;
+    qth_t           obs;
+    GSList         *passes = NULL;
+    GSList         *l;
+    pass_t         *pass;
+    gdouble         end, aos;
+    guint           i, n = 0;
+
+    route_check_cfg(route);
+    cache = route_sat_cache(route, sat);
+
+    /* work on copies; the module data must stay in sync with its time */
+    memcpy(&sat_working, sat, sizeof(sat_t));
+    obs = *qth;
+
+    p = (qth_route_point_t *) route->points->data;
+    end = (maxdt > 0.0) ? start + maxdt : p[cache->nseg].t;
+
+    /* start with the segment of the AOS of a pass in progress */
+    i = route_segment(route, start);
+    qth_route_calc(route, &sat_working, &obs, start);
+    if (sat_working.el >= 0.0)
+    {
+        aos = route_find_set(route, &sat_working, &obs, start,
+                             start - ROUTE_MAX_PASS);
+        if (aos > 0.0)
+            i = route_segment(route, aos);
+    }
+
+    for (; i < cache->nseg && p[i].t <= end && n < num; i++)
+    {
+        if (!cache->done[i])
+        {
+            cache->passes[i] = route_segment_passes(route, &sat_working,
+                                                    &obs, i);
+            cache->done[i] = TRUE;
+        }
+
+        for (l = cache->passes[i]; l != NULL && n < num; l = l->next)
+        {
+            pass = PASS(l->data);
+            if (pass->los <= start || pass->aos > end ||
+                pass->max_el < min_el)
+                continue;
+
+            passes = g_slist_prepend(passes, pass);
+            n++;
+        }
+    }
+
+    return g_slist_reverse(passes);
+}
+
+/**
+ * Predict passes along a route.
+ *
+ * \param route The route.
+ * \param sat The satellite; it is not modified.
+ * \param qth The observer; copied, only the position follows the route.
+ * \param start Start of the time window (Julian date).
+ * \param maxdt Length of the time window in days; 0.0 for the whole route.
+ * \param num Maximum number of passes; 0 for 100.
+ * \return A list of pass_t, to be freed with free_passes().
+ *
+ * Same contract as get_passes(): a pass in progress at start is included
+ * and passes below SAT_CFG_INT_PRED_MIN_EL are skipped. Only the time
+ * covered by the route is predicted.
+ */
+GSList         *qth_route_get_passes(qth_route_t * route, sat_t * sat,
+                                     qth_t * qth, gdouble start,
+                                     gdouble maxdt, guint num)
+{
+    GSList         *passes;
+    GSList         *l;
+    gdouble         end;
+
+    g_return_val_if_fail(route != NULL && sat != NULL && qth != NULL, NULL);
+
+    if (num == 0)
+        num = 100;
+
+    passes = route_collect(route, sat, qth, start, maxdt, num,
+                           sat_cfg_get_int(SAT_CFG_INT_PRED_MIN_EL));
+    for (l = passes; l != NULL; l = l->next)
+        l->data = copy_pass(PASS(l->data));
+
+    end = (maxdt > 0.0) ? start + maxdt : qth_route_end(route);
+    sat_log_log(SAT_LOG_LEVEL_INFO,
+                _("%s: Found %u passes for %s along the route in [%f;%f]"),
+                __func__, g_slist_length(passes), sat->nickname, start, end);
+
+    return passes;
+}
+
+/**
+ * Predict the first pass along a route.
+ *
+ * \param route The route.
+ * \param sat The satellite; it is not modified.
+ * \param qth The observer; copied.
+ * \param start Start of the time window (Julian date).
+ * \param maxdt Length of the time window in days; 0.0 for the whole route.
+ * \param use_min_el Skip passes below SAT_CFG_INT_PRED_MIN_EL.
+ * \return The pass in progress at start or the next one, to be freed with
+ *         free_pass(), or NULL.
+ */
+pass_t         *qth_route_get_pass(qth_route_t * route, sat_t * sat,
+                                   qth_t * qth, gdouble start, gdouble maxdt,
+                                   gboolean use_min_el)
+{
+    GSList         *passes;
+    pass_t         *pass = NULL;
+
+    g_return_val_if_fail(route != NULL && sat != NULL && qth != NULL, NULL);
+
+    passes = route_collect(route, sat, qth, start, maxdt, 1,
+                           use_min_el ?
+                           sat_cfg_get_int(SAT_CFG_INT_PRED_MIN_EL) : -90);
+    if (passes != NULL)
+        pass = copy_pass(PASS(passes->data));
+    g_slist_free(passes);
+
+    return pass;
+}
+
+/**
+ * Time of the next AOS along a route.
+ *
+ * \return The first AOS after start within maxdt (0.0 for the whole route),
+ *         or 0.0 if there is none. A pass in progress is skipped, as in
+ *         find_aos().
+ */
+gdouble qth_route_find_aos(qth_route_t * route, sat_t * sat, qth_t * qth,
+                           gdouble start, gdouble maxdt)
+{
+    GSList         *passes;
+    GSList         *l;
+    gdouble         aos = 0.0;
+
+    g_return_val_if_fail(route != NULL && sat != NULL && qth != NULL, 0.0);
+
+    passes = route_collect(route, sat, qth, start, maxdt, 2, -90);
+    for (l = passes; l != NULL && aos == 0.0; l = l->next)
+        if (PASS(l->data)->aos > start)
+            aos = PASS(l->data)->aos;
+    g_slist_free(passes);
+
+    return aos;
+}
+
+/**
+ * Time of the next LOS along a route.
+ *
+ * \return The LOS of the pass in progress at start or of the next pass
+ *         within maxdt (0.0 for the whole route), or 0.0 if there is none.
+ */
+gdouble qth_route_find_los(qth_route_t * route, sat_t * sat, qth_t * qth,
+                           gdouble start, gdouble maxdt)
+{
+    GSList         *passes;
+    gdouble         los = 0.0;
+
+    g_return_val_if_fail(route != NULL && sat != NULL && qth != NULL, 0.0);
+
+    passes = route_collect(route, sat, qth, start, maxdt, 1, -90);
+    if (passes != NULL)
+        los = PASS(passes->data)->los;
+    g_slist_free(passes);
+
+    return los;
+}
+
+/** Forget all predicted passes, e.g. after the elements have been updated. */
+void qth_route_clear_cache(qth_route_t * route)
+{
+    g_return_if_fail(route != NULL);
+
+    g_hash_table_remove_all(route->cache);
+}
@@ -0,0 +1,74 @@
+/*
+  OGpredict — extensions to Gpredict for operations planning
+
+  Copyright (C) 2025 Axel Osika <osikaaxel@gmail.com>
+
+  This file is part of OGpredict, a derivative of Gpredict.
+
+  OGpredict is free software: you can redistribute it and/or modify it
+  under the terms of the GNU General Public License as published by the
+  Free Software Foundation; either version 2 of the License, or (at your
+  option) any later version.  See the GNU General Public License for details.
+*/
+
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#ifndef __QTH_ROUTE_H__
+#define __QTH_ROUTE_H__ 1
+
+#include <gio/gio.h>
+#include <glib.h>
+
+#include "predict-tools.h"
+#include "qth-data.h"
+#include "sgpsdp/sgp4sdp4.h"
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/** One waypoint of a planned route. */
+typedef struct {
+    gdouble         t;          /*!< Time (Julian date, UTC) */
+    gdouble         lat;        /*!< Latitude in dec. deg. North */
+    gdouble         lon;        /*!< Longitude in dec. deg. East */
+    gdouble         alt;        /*!< Altitude above sea level in meters */
+} qth_route_point_t;
+
+qth_route_t    *qth_route_new(const qth_route_point_t * points, guint n,
+                              GError ** error);
+qth_route_t    *qth_route_load_file(const gchar * fname, GError ** error);
+qth_route_t    *qth_route_copy(const qth_route_t * route);
+void            qth_route_free(qth_route_t * route);
+
+gdouble         qth_route_start(const qth_route_t * route);
+gdouble         qth_route_end(const qth_route_t * route);
+gboolean        qth_route_covers(const qth_route_t * route, gdouble t);
+void            qth_route_at(const qth_route_t * route, gdouble t,
+                             qth_t * qth);
+void            qth_route_calc(const qth_route_t * route, sat_t * sat,
+                               qth_t * qth, gdouble t);
+
+GSList         *qth_route_get_passes(qth_route_t * route, sat_t * sat,
+                                     qth_t * qth, gdouble start,
+                                     gdouble maxdt, guint num);
+pass_t         *qth_route_get_pass(qth_route_t * route, sat_t * sat,
+                                   qth_t * qth, gdouble start, gdouble maxdt,
+                                   gboolean use_min_el);
+gdouble         qth_route_find_aos(qth_route_t * route, sat_t * sat,
+                                   qth_t * qth, gdouble start,
+                                   gdouble maxdt);
+gdouble         qth_route_find_los(qth_route_t * route, sat_t * sat,
+                                   qth_t * qth, gdouble start,
+                                   gdouble maxdt);
+void            qth_route_clear_cache(qth_route_t * route);
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+}
+#endif
+/* *INDENT-ON* */
+
+#endif
@@ -0,0 +1,522 @@
+/*
+  OGpredict — extensions to Gpredict for operations planning
+
+  Copyright (C) 2025 Axel Osika <osikaaxel@gmail.com>
+
+  This file is part of OGpredict, a derivative of Gpredict.
+
+  OGpredict is free software: you can redistribute it and/or modify it
+  under the terms of the GNU General Public License as published by the
+  Free Software Foundation; either version 2 of the License, or (at your
+  option) any later version.  See the GNU General Public License for details.
+*/
+
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/**
+ * result-cache.c — on-disk cache of Ephemeris window results
+ *
+ * Every stage of an Ephemeris window run (propagation, territory, POI)
+ * stores its records under USER_CONF_DIR/cache in a file named after a
+ * SHA-256 of everything the stage depends on: the elements of the
+ * satellites, the time grid, the selection and the content of the CSV
+ * files.  A run with the same inputs loads the file instead of computing;
+ * a changed input gives another name, so only the stages depending on it
+ * are computed again.
+ *
+ * Files are dropped in least-recently-used order: a hit stamps the header
+ * with the time of use and result_cache_trim() removes the entries with the
+ * oldest stamps until the cache fits its size.  The stamp is in
+ * microseconds and kept strictly increasing, so hits within the same second
+ * keep their order, which file modification times do not on most
+ * filesystems.  Entries are also removed as soon as an input is known to
+ * have changed: by result_cache_invalidate_sats() after a TLE update, and
+ * by result_cache_set_input() when the digest of a CSV file, taken by its
+ * loader, no longer matches the digest recorded for it.
+ *
+ * A file is a small header, the catalogue numbers the records depend on,
+ * padded to 8 bytes so the records are aligned for doubles, and the
+ * records in host byte order.  The header records that order and
+ * an entry written with the other one is rejected.  Files are written with
+ * g_file_set_contents(), so a reader never sees a partial file.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <build-config.h>
+#endif
+
+#include <glib/gi18n.h>
+#include <glib/gstdio.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "compat.h"
+#include "result-cache.h"
+#include "sat-log.h"
+
+#define RESULT_CACHE_MAGIC   0x4352474fu  /* "OGRC" */
+#define RESULT_CACHE_VERSION 2
+#define RESULT_CACHE_ORDER   0x01020304u  /* reads 0x04030201 when swapped */
+#define RESULT_CACHE_SUFFIX  ".bin"
+#define RESULT_CACHE_INPUTS  "inputs.ini"
+
+/** Most catalogue numbers read by result_cache_invalidate_sats(). */
+#define RESULT_CACHE_MAX_SATS 4096
+
+typedef struct {
+    guint32         magic;
+    guint32         version;
+    guint32         order;      /* RESULT_CACHE_ORDER in the writer's order */
+    guint32         elt;        /* size of one record */
+    guint64         count;      /* records after the catalogue numbers */
+    guint64         used;       /* last use, see next_use() */
+    guint32         ncatnr;     /* catalogue numbers after the header */
+    guint32         reserved;   /* zero */
+} cache_header_t;
+
+/* Serialises the updates of RESULT_CACHE_INPUTS */
+static GMutex   inputs_lock;
+
+/* Last stamp handed out by next_use() */
+static gint64   last_use;
+static GMutex   use_lock;
+
+static gchar   *cache_dir(void)
+{
+    gchar          *confdir = get_user_conf_dir();
+    gchar          *dir;
+
+    dir = g_build_filename(confdir, "cache", NULL);
+    g_free(confdir);
+
+    return dir;
+}
+
+static gchar   *entry_path(const gchar * key)
+{
+    gchar          *dir = cache_dir();
+    gchar          *name = g_strconcat(key, RESULT_CACHE_SUFFIX, NULL);
+    gchar          *path = g_build_filename(dir, name, NULL);
+
+    g_free(dir);
+    g_free(name);
+
+    return path;
+}
+
+/* Time stamp of a use, in microseconds, strictly increasing in a process */
+static guint64 next_use(void)
+{
+    gint64          now = g_get_real_time();
+
+    g_mutex_lock(&use_lock);
+    last_use = MAX(now, last_use + 1);
+    now = last_use;
+    g_mutex_unlock(&use_lock);
+
+    return (guint64) now;
+}
+
+/* TRUE if hdr is the header of an entry this build can read */
+static gboolean header_ok(const cache_header_t * hdr)
+{
+    if (hdr->magic == RESULT_CACHE_MAGIC &&
+        hdr->order == GUINT32_SWAP_LE_BE(RESULT_CACHE_ORDER))
+    {
+        sat_log_log(SAT_LOG_LEVEL_DEBUG,
+                    _("%s: entry written with the other byte order"),
+                    __func__);
+        return FALSE;
+    }
+
+    return hdr->magic == RESULT_CACHE_MAGIC &&
+        hdr->version == RESULT_CACHE_VERSION &&
+        hdr->order == RESULT_CACHE_ORDER;
+}
+
+/* Read the header of an entry from fp; FALSE if this build cannot use it */
+static gboolean read_header(FILE * fp, cache_header_t * hdr)
+{
+    return fread(hdr, sizeof(*hdr), 1, fp) == 1 && header_ok(hdr);
+}
+
+/* Offset of the records in an entry with ncatnr catalogue numbers */
+static gsize records_offset(guint64 ncatnr)
+{
+    return sizeof(cache_header_t) +
+        (((gsize) ncatnr * sizeof(guint32) + 7) & ~(gsize) 7);
+}
+
+/**
+ * Name of a cache entry.
+ *
+ * @param stage Stage the entry belongs to, e.g. "ephem".  Used as a prefix
+ *              so that result_cache_invalidate() can find the entries.
+ * @param sum SHA-256 of the inputs of the stage; not freed.
+ * @return "<stage>-<digest>", free with g_free().
+ */
+gchar          *result_cache_key(const gchar * stage, GChecksum * sum)
+{
+    return g_strdup_printf("%s-%s", stage, g_checksum_get_string(sum));
+}
+
+/** Add the elements of a satellite to a key. */
+void result_cache_add_tle(GChecksum * sum, const tle_t * tle)
+{
+    const gdouble   el[] = {
+        tle->epoch, tle->xndt2o, tle->xndd6o, tle->bstar, tle->xincl,
+        tle->xnodeo, tle->eo, tle->omegao, tle->xmo, tle->xno
+    };
+    gint32          catnr = tle->catnr;
+
+    g_checksum_update(sum, (const guchar *)el, sizeof(el));
+    g_checksum_update(sum, (const guchar *)&catnr, sizeof(catnr));
+}
+
+/**
+ * Record the digest of an input file of a stage.
+ *
+ * The digest is taken by the loader of the file from the contents it read
+ * and goes into the keys of the stage.  When it differs from the recorded
+ * one the file has changed since the entries were written, and all entries
+ * of the stage are dropped.  Called once per load of the file, by whoever
+ * loaded it; this reads and may write RESULT_CACHE_INPUTS.
+ *
+ * @param stage Stage reading the file.
+ * @param path The file.
+ * @param digest Digest of the loaded contents.
+ */
+void result_cache_set_input(const gchar * stage, const gchar * path,
+                            const gchar * digest)
+{
+    GKeyFile       *kf;
+    gchar          *dir, *ini, *name, *old;
+
+    g_return_if_fail(digest != NULL);
+
+    g_mutex_lock(&inputs_lock);
+
+    dir = cache_dir();
+    ini = g_build_filename(dir, RESULT_CACHE_INPUTS, NULL);
+    name = g_path_get_basename(path);
+    kf = g_key_file_new();
+    g_key_file_load_from_file(kf, ini, G_KEY_FILE_KEEP_COMMENTS, NULL);
+
+    old = g_key_file_get_string(kf, stage, name, NULL);
+    if (g_strcmp0(old, digest) != 0)
+    {
+        if (old != NULL)
+        {
+            sat_log_log(SAT_LOG_LEVEL_INFO,
+                        _("%s: %s changed, dropping cached %s results"),
+                        __func__, name, stage);
+            result_cache_invalidate(stage);
+        }
+        g_key_file_set_string(kf, stage, name, digest);
+        if (g_mkdir_with_parents(dir, 0755) == 0)
+            gpredict_save_key_file(kf, ini);
+    }
+
+    g_free(old);
+    g_key_file_free(kf);
+    g_free(name);
+    g_free(ini);
+    g_free(dir);
+    g_mutex_unlock(&inputs_lock);
+}
+
+/** TRUE if there is an entry for key. */
+gboolean result_cache_has(const gchar * key)
+{
+    gchar          *path = entry_path(key);
+    gboolean        has = g_file_test(path, G_FILE_TEST_IS_REGULAR);
+
+    g_free(path);
+
+    return has;
+}
+
+/* Stamp the entry at path as the most recently used one */
+static void mark_used(const gchar * path)
+{
+    FILE           *fp = g_fopen(path, "r+b");
+    guint64         used = next_use();
+
+    if (fp == NULL)
+        return;
+
+    if (fseek(fp, G_STRUCT_OFFSET(cache_header_t, used), SEEK_SET) == 0)
+        fwrite(&used, sizeof(used), 1, fp);
+    fclose(fp);
+}
+
+/**
+ * Load an entry.
+ *
+ * A hit marks the entry as recently used.  An entry that is truncated or
+ * was written by another version is removed.
+ *
+ * @param key Entry name, see result_cache_key().
+ * @param elt Expected size of one record.
+ * @return The records, or NULL on a miss.  Free with g_bytes_unref().
+ */
+GBytes         *result_cache_load(const gchar * key, gsize elt)
+{
+    gchar          *path = entry_path(key);
+    gchar          *contents;
+    gsize           len, off;
+    cache_header_t  hdr;
+    GBytes         *all, *records = NULL;
+
+    if (!g_file_get_contents(path, &contents, &len, NULL))
+    {
+        g_free(path);
+        return NULL;
+    }
+    all = g_bytes_new_take(contents, len);
+
+    if (len >= sizeof(hdr))
+    {
+        memcpy(&hdr, contents, sizeof(hdr));
+        off = records_offset(hdr.ncatnr);
+        if (header_ok(&hdr) && hdr.elt == elt &&
+            off <= len && (len - off) / elt == hdr.count &&
+            (len - off) % elt == 0)
+        {
+            records = g_bytes_new_from_bytes(all, off, len - off);
+        }
+    }
+    g_bytes_unref(all);
+
+    if (records != NULL)
+        mark_used(path);
+    else
+        g_remove(path);
+
+    g_free(path);
+
+    return records;
+}
+
+/**
+ * Store an entry and trim the cache.
+ *
+ * @param key Entry name, see result_cache_key().
+ * @param elt Size of one record.
+ * @param catnr Satellites the records depend on, for
+ *              result_cache_invalidate_sats().
+ * @param ncatnr Number of entries in catnr.
+ * @param data The records.
+ * @param count Number of records.
+ * @param max_bytes Size of the cache.  An entry larger than a quarter of
+ *                  it is not stored, so one run cannot flush the cache.
+ * @return TRUE if the entry was written.
+ */
+gboolean result_cache_store(const gchar * key, gsize elt,
+                            const guint32 * catnr, guint ncatnr,
+                            gconstpointer data, guint64 count,
+                            guint64 max_bytes)
+{
+    cache_header_t  hdr = { RESULT_CACHE_MAGIC, RESULT_CACHE_VERSION,
+        RESULT_CACHE_ORDER, (guint32) elt, count, next_use(), ncatnr, 0
+    };
+    static const guint32 pad = 0;
+    gsize           off = records_offset(ncatnr);
+    guint64         size = off + count * elt;
+    GByteArray     *buf;
+    GError         *err = NULL;
+    gchar          *dir, *path;
+    gboolean        ok;
+
+    if (size > max_bytes / 4)
+        return FALSE;
+
+    dir = cache_dir();
+    if (g_mkdir_with_parents(dir, 0755) != 0)
+    {
+        g_free(dir);
+        return FALSE;
+    }
+    g_free(dir);
+
+    buf = g_byte_array_sized_new((guint) size);
+    g_byte_array_append(buf, (const guint8 *)&hdr, sizeof(hdr));
+    g_byte_array_append(buf, (const guint8 *)catnr,
+                        ncatnr * sizeof(guint32));
+    if (buf->len < off)
+        g_byte_array_append(buf, (const guint8 *)&pad, sizeof(pad));
+    g_byte_array_append(buf, data, (guint) (count * elt));
+
+    path = entry_path(key);
+    ok = g_file_set_contents(path, (const gchar *)buf->data, buf->len, &err);
+    if (!ok)
+    {
+        sat_log_log(SAT_LOG_LEVEL_ERROR, _("%s: Could not write %s (%s)"),
+                    __func__, path, err->message);
+        g_clear_error(&err);
+    }
+    g_free(path);
+    g_byte_array_free(buf, TRUE);
+
+    if (ok)
+        result_cache_trim(max_bytes);
+
+    return ok;
+}
+
+typedef struct {
+    gchar          *path;
+    guint64         used;
+    guint64         size;
+} cache_file_t;
+
+static gint compare_used(gconstpointer a, gconstpointer b)
+{
+    const cache_file_t *fa = a;
+    const cache_file_t *fb = b;
+
+    return (fa->used > fb->used) - (fa->used < fb->used);
+}
+
+/* Paths of the entries whose name starts with prefix (all if NULL) */
+static GPtrArray *list_entries(const gchar * prefix)
+{
+    GPtrArray      *paths = g_ptr_array_new_with_free_func(g_free);
+    gchar          *dir = cache_dir();
+    GDir           *d = g_dir_open(dir, 0, NULL);
+    const gchar    *name;
+
+    while (d != NULL && (name = g_dir_read_name(d)) != NULL)
+    {
+        if (!g_str_has_suffix(name, RESULT_CACHE_SUFFIX))
+            continue;
+        if (prefix != NULL && !g_str_has_prefix(name, prefix))
+            continue;
+        g_ptr_array_add(paths, g_build_filename(dir, name, NULL));
+    }
+
+    if (d != NULL)
+        g_dir_close(d);
+    g_free(dir);
+
+    return paths;
+}
+
+/**
+ * Remove the least recently used entries until the cache fits.
+ *
+ * Entries whose header cannot be read go first.
+ *
+ * @param max_bytes Size of the cache.
+ */
+void result_cache_trim(guint64 max_bytes)
+{
+    GPtrArray      *paths = list_entries(NULL);
+    GArray         *files = g_array_new(FALSE, FALSE, sizeof(cache_file_t));
+    guint64         total = 0;
+    GStatBuf        st;
+    cache_header_t  hdr;
+    cache_file_t    f;
+    FILE           *fp;
+    guint           i;
+
+    for (i = 0; i < paths->len; i++)
+    {
+        f.path = g_ptr_array_index(paths, i);
+        if (g_stat(f.path, &st) != 0 || (fp = g_fopen(f.path, "rb")) == NULL)
+            continue;
+        f.used = read_header(fp, &hdr) ? hdr.used : 0;
+        f.size = (guint64) st.st_size;
+        fclose(fp);
+        total += f.size;
+        g_array_append_val(files, f);
+    }
+
+    g_array_sort(files, compare_used);
+    for (i = 0; i < files->len && total > max_bytes; i++)
+    {
+        f = g_array_index(files, cache_file_t, i);
+        if (g_remove(f.path) == 0)
+            total -= f.size;
+    }
+
+    g_array_free(files, TRUE);
+    g_ptr_array_free(paths, TRUE);
+}
+
+/**
+ * Remove the entries of a stage.
+ *
+ * @param stage The stage, or NULL to empty the cache.
+ */
+void result_cache_invalidate(const gchar * stage)
+{
+    gchar          *prefix = stage ? g_strconcat(stage, "-", NULL) : NULL;
+    GPtrArray      *paths = list_entries(prefix);
+    guint           i;
+
+    for (i = 0; i < paths->len; i++)
+        g_remove(g_ptr_array_index(paths, i));
+
+    g_ptr_array_free(paths, TRUE);
+    g_free(prefix);
+}
+
+/* TRUE if the entry at path depends on one of the satellites */
+static gboolean entry_uses_sats(const gchar * path, const guint32 * catnr,
+                                guint n)
+{
+    FILE           *fp = g_fopen(path, "rb");
+    cache_header_t  hdr;
+    guint32        *ids;
+    gboolean        uses = FALSE;
+    guint           i, j;
+
+    if (fp == NULL)
+        return FALSE;
+
+    if (read_header(fp, &hdr) && hdr.ncatnr <= RESULT_CACHE_MAX_SATS)
+    {
+        ids = g_new(guint32, MAX(hdr.ncatnr, 1));
+        if (fread(ids, sizeof(guint32), hdr.ncatnr, fp) == hdr.ncatnr)
+        {
+            for (i = 0; i < hdr.ncatnr && !uses; i++)
+                for (j = 0; j < n && !uses; j++)
+                    uses = (ids[i] == catnr[j]);
+        }
+        g_free(ids);
+    }
+    else
+    {
+        /* unreadable entries are of no use either */
+        uses = TRUE;
+    }
+    fclose(fp);
+
+    return uses;
+}
+
+/**
+ * Remove the entries computed from the elements of some satellites.
+ *
+ * Called after a TLE update: the keys of new runs change with the
+ * elements, so these entries could only take up space.
+ *
+ * @param catnr Catalogue numbers of the satellites with new elements.
+ * @param n Number of entries in catnr.
+ */
+void result_cache_invalidate_sats(const guint32 * catnr, guint n)
+{
+    GPtrArray      *paths;
+    guint           i;
+
+    if (n == 0)
+        return;
+
+    paths = list_entries(NULL);
+    for (i = 0; i < paths->len; i++)
+        if (entry_uses_sats(g_ptr_array_index(paths, i), catnr, n))
+            g_remove(g_ptr_array_index(paths, i));
+
+    g_ptr_array_free(paths, TRUE);
+}
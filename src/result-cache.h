@@ -0,0 +1,52 @@
+/*
+  OGpredict — extensions to Gpredict for operations planning
+
+  Copyright (C) 2025 Axel Osika <osikaaxel@gmail.com>
+
+  This file is part of OGpredict, a derivative of Gpredict.
+
+  OGpredict is free software: you can redistribute it and/or modify it
+  under the terms of the GNU General Public License as published by the
+  Free Software Foundation; either version 2 of the License, or (at your
+  option) any later version.  See the GNU General Public License for details.
+*/
+
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#ifndef __RESULT_CACHE_H__
+#define __RESULT_CACHE_H__ 1
+
+#include <glib.h>
+
+#include "sgpsdp/sgp4sdp4.h"
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+extern "C" {
+#endif
+/* *INDENT-ON* */
+
+gchar          *result_cache_key(const gchar * stage, GChecksum * sum);
+void            result_cache_add_tle(GChecksum * sum, const tle_t * tle);
+void            result_cache_set_input(const gchar * stage,
+                                       const gchar * path,
+                                       const gchar * digest);
+
+gboolean        result_cache_has(const gchar * key);
+GBytes         *result_cache_load(const gchar * key, gsize elt);
+gboolean        result_cache_store(const gchar * key, gsize elt,
+                                   const guint32 * catnr, guint ncatnr,
+                                   gconstpointer data, guint64 count,
+                                   guint64 max_bytes);
+
+void            result_cache_trim(guint64 max_bytes);
+void            result_cache_invalidate(const gchar * stage);
+void            result_cache_invalidate_sats(const guint32 * catnr, guint n);
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+}
+#endif
+/* *INDENT-ON* */
+
+#endif
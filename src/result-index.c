@@ -0,0 +1,349 @@
+/*
+  OGpredict — extensions to Gpredict for operations planning
+
+  Copyright (C) 2025 Axel Osika <osikaaxel@gmail.com>
+
+  This file is part of OGpredict, a derivative of Gpredict.
+
+  OGpredict is free software: you can redistribute it and/or modify it
+  under the terms of the GNU General Public License as published by the
+  Free Software Foundation; either version 2 of the License, or (at your
+  option) any later version.  See the GNU General Public License for details.
+*/
+
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/**
+ * result-index.c — lookups over large result tables
+ *
+ * A long ephemeris run leaves hundreds of thousands of rows in the tables
+ * and scrolling to a given time or place by hand is hopeless.  The index is
+ * built alongside the table, one append per row, and keeps:
+ *
+ *  - the row times, which are ascending, so a time is found by binary
+ *    search;
+ *  - the first row of every orbit (ascending node) or pass (gap in time);
+ *    a table of several satellites, one row each per time step, is cut at
+ *    the ascending nodes of the first one (see stride);
+ *  - a 5° lat/lon grid with the rows falling in each cell, so a box query
+ *    only visits the cells it overlaps.
+ *
+ * Nothing is sorted or rebuilt after the fact; a query on a partially
+ * filled table sees the rows appended so far.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <build-config.h>
+#endif
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "result-index.h"
+#include "time-tools.h"
+
+/** Tolerance of time lookups [days]; half a second. */
+#define RESULT_INDEX_EPS (0.5 / 86400.0)
+
+static guint cell_of(gdouble lat, gdouble lon)
+{
+    gint            r, c;
+
+    r = (gint) floor((lat + 90.0) / RESULT_INDEX_CELL);
+    c = (gint) floor((lon + 180.0) / RESULT_INDEX_CELL);
+    r = CLAMP(r, 0, RESULT_INDEX_ROWS - 1);
+    c = ((c % RESULT_INDEX_COLS) + RESULT_INDEX_COLS) % RESULT_INDEX_COLS;
+
+    return (guint) (r * RESULT_INDEX_COLS + c);
+}
+
+/**
+ * Create an empty index.
+ *
+ * @param mode How rows are grouped into segments.
+ * @param gap RESULT_SEG_PASS: a jump in time larger than this starts a new
+ *            segment [days].  Ignored for RESULT_SEG_ORBIT.
+ */
+result_index_t *result_index_new(result_seg_mode_t mode, gdouble gap)
+{
+    result_index_t *index = g_new0(result_index_t, 1);
+
+    index->jd = g_array_new(FALSE, FALSE, sizeof(gdouble));
+    index->lat = g_array_new(FALSE, FALSE, sizeof(gfloat));
+    index->lon = g_array_new(FALSE, FALSE, sizeof(gfloat));
+    index->seg = g_array_new(FALSE, FALSE, sizeof(guint));
+    index->mode = mode;
+    index->gap = gap;
+    index->stride = 1;
+
+    return index;
+}
+
+void result_index_free(result_index_t * index)
+{
+    guint           i;
+
+    if (index == NULL)
+        return;
+
+    for (i = 0; i < G_N_ELEMENTS(index->cell); i++)
+        if (index->cell[i] != NULL)
+            g_array_free(index->cell[i], TRUE);
+
+    g_array_free(index->jd, TRUE);
+    g_array_free(index->lat, TRUE);
+    g_array_free(index->lon, TRUE);
+    g_array_free(index->seg, TRUE);
+    g_free(index);
+}
+
+/**
+ * Add the next row.
+ *
+ * @param jd Row time (Julian date); must not be earlier than the last row.
+ * @param lat Latitude [deg].
+ * @param lon Longitude [deg].
+ */
+void result_index_append(result_index_t * index, gdouble jd, gdouble lat,
+                         gdouble lon)
+{
+    guint           row = index->jd->len;
+    guint           cell;
+    gfloat          flat = (gfloat) lat;
+    gfloat          flon = (gfloat) lon;
+    gboolean        start;
+
+    if (row == 0)
+    {
+        start = TRUE;
+    }
+    else if (index->mode == RESULT_SEG_ORBIT)
+    {
+        /* with several tracks interleaved row by row, follow the first */
+        guint           stride = MAX(index->stride, 1);
+
+        start = (row >= stride && row % stride == 0 &&
+                 g_array_index(index->lat, gfloat, row - stride) < 0.0f &&
+                 flat >= 0.0f);
+    }
+    else
+    {
+        start = (jd - g_array_index(index->jd, gdouble, row - 1) >
+                 index->gap);
+    }
+
+    if (start)
+        g_array_append_val(index->seg, row);
+
+    g_array_append_val(index->jd, jd);
+    g_array_append_val(index->lat, flat);
+    g_array_append_val(index->lon, flon);
+
+    cell = cell_of(lat, lon);
+    if (index->cell[cell] == NULL)
+        index->cell[cell] = g_array_new(FALSE, FALSE, sizeof(guint));
+    g_array_append_val(index->cell[cell], row);
+}
+
+/**
+ * Find the first row at or after a time.
+ *
+ * Times within half a second before a row match that row, so a time typed
+ * with whole seconds finds the row it names.
+ *
+ * @return The row, or the number of rows if jd is past the end.
+ */
+guint result_index_find_time(const result_index_t * index, gdouble jd)
+{
+    const gdouble  *t = (const gdouble *)index->jd->data;
+    guint           lo = 0;
+    guint           hi = index->jd->len;
+    guint           mid;
+
+    jd -= RESULT_INDEX_EPS;
+    while (lo < hi)
+    {
+        mid = lo + (hi - lo) / 2;
+        if (t[mid] < jd)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    return lo;
+}
+
+/** Number of orbits or passes seen so far. */
+guint result_index_n_segments(const result_index_t * index)
+{
+    return index->seg->len;
+}
+
+/**
+ * Get the rows of a segment.
+ *
+ * @param k Segment number, starting at 0.
+ * @param first Set to the first row of the segment.
+ * @param end Set to one past the last row of the segment.
+ * @return FALSE if there is no such segment.
+ */
+gboolean result_index_segment(const result_index_t * index, guint k,
+                              guint * first, guint * end)
+{
+    if (k >= index->seg->len)
+        return FALSE;
+
+    *first = g_array_index(index->seg, guint, k);
+    *end = (k + 1 < index->seg->len) ?
+        g_array_index(index->seg, guint, k + 1) : index->jd->len;
+
+    return TRUE;
+}
+
+static gboolean in_lon(gfloat lon, gdouble lon_min, gdouble lon_max)
+{
+    if (lon_min <= lon_max)
+        return (lon >= lon_min && lon <= lon_max);
+
+    /* box across the date line */
+    return (lon >= lon_min || lon <= lon_max);
+}
+
+static gint compare_row(gconstpointer a, gconstpointer b)
+{
+    guint           ra = *(const guint *)a;
+    guint           rb = *(const guint *)b;
+
+    return (ra > rb) - (ra < rb);
+}
+
+/**
+ * Find the rows inside a lat/lon box.
+ *
+ * @param lat_min Southern edge [deg].
+ * @param lat_max Northern edge [deg].
+ * @param lon_min Western edge [deg].
+ * @param lon_max Eastern edge [deg].  A box with lon_min > lon_max spans
+ *                the date line.
+ * @return A new array of guint row numbers in table order.  Free with
+ *         g_array_free().
+ */
+GArray         *result_index_box(const result_index_t * index,
+                                 gdouble lat_min, gdouble lat_max,
+                                 gdouble lon_min, gdouble lon_max)
+{
+    GArray         *rows = g_array_new(FALSE, FALSE, sizeof(guint));
+    GArray         *cell;
+    guint           r0, r1, c0, c1, r, c, k, ncols, row;
+    gboolean        all_lon = (lon_max - lon_min >= 360.0);
+    gfloat          lat;
+
+    if (lat_min > lat_max)
+        return rows;
+
+    r0 = cell_of(lat_min, 0.0) / RESULT_INDEX_COLS;
+    r1 = cell_of(lat_max, 0.0) / RESULT_INDEX_COLS;
+    c0 = cell_of(0.0, lon_min) % RESULT_INDEX_COLS;
+    c1 = cell_of(0.0, lon_max) % RESULT_INDEX_COLS;
+
+    /* number of columns walked eastwards from c0, wrapping if needed */
+    if (all_lon || (lon_min > lon_max && c0 == c1))
+        ncols = RESULT_INDEX_COLS;
+    else
+        ncols = (c1 + RESULT_INDEX_COLS - c0) % RESULT_INDEX_COLS + 1;
+
+    for (r = r0; r <= r1; r++)
+    {
+        for (k = 0; k < ncols; k++)
+        {
+            c = (c0 + k) % RESULT_INDEX_COLS;
+            cell = index->cell[r * RESULT_INDEX_COLS + c];
+            if (cell == NULL)
+                continue;
+
+            for (row = 0; row < cell->len; row++)
+            {
+                guint           i = g_array_index(cell, guint, row);
+
+                lat = g_array_index(index->lat, gfloat, i);
+                if (lat < lat_min || lat > lat_max)
+                    continue;
+                if (!all_lon &&
+                    !in_lon(g_array_index(index->lon, gfloat, i),
+                            lon_min, lon_max))
+                    continue;
+                g_array_append_val(rows, i);
+            }
+        }
+    }
+
+    g_array_sort(rows, compare_row);
+
+    return rows;
+}
+
+/**
+ * Parse a time typed by the user.
+ *
+ * Accepts "YYYY/MM/DD" or "YYYY-MM-DD", optionally followed by a space or
+ * 'T' and "HH", "HH:MM" or "HH:MM:SS[.sss]".  The time is UTC.  Anything
+ * after the time other than white space, and dates that do not exist
+ * (e.g. 02/31), are rejected.
+ *
+ * @param jd Set to the Julian date on success.
+ * @return FALSE if the text is not a valid time.
+ */
+gboolean result_index_parse_time(const gchar * text, gdouble * jd)
+{
+    gint            y, mo, d, h = 0, mi = 0;
+    gdouble         s = 0.0;
+    gchar           sep1, sep2;
+    gint            n, used = 0;
+    const gchar    *rest;
+
+    if (text == NULL)
+        return FALSE;
+
+    text += strspn(text, " \t");
+    n = sscanf(text, "%d%c%d%c%d%n", &y, &sep1, &mo, &sep2, &d, &used);
+    if (n < 5 || used == 0 || sep1 != sep2 || (sep1 != '/' && sep1 != '-'))
+        return FALSE;
+
+    rest = text + used;
+    if (*rest == 'T' || (*rest == ' ' && g_ascii_isdigit(rest[1])))
+    {
+        rest++;
+        used = 0;
+        if (sscanf(rest, "%d%n", &h, &used) < 1 || used == 0)
+            return FALSE;
+        rest += used;
+        if (*rest == ':')
+        {
+            used = 0;
+            if (sscanf(rest + 1, "%d%n", &mi, &used) < 1 || used == 0)
+                return FALSE;
+            rest += 1 + used;
+            if (*rest == ':')
+            {
+                used = 0;
+                if (sscanf(rest + 1, "%lf%n", &s, &used) < 1 || used == 0)
+                    return FALSE;
+                rest += 1 + used;
+            }
+        }
+    }
+
+    /* nothing but white space may follow */
+    if (rest[strspn(rest, " \t\r\n")] != '\0')
+        return FALSE;
+
+    if (y < 1 || y > 9999 || mo < 1 || mo > 12 || d < 1 || d > 31 ||
+        !g_date_valid_dmy(d, mo, y) || h < 0 || h > 23 ||
+        mi < 0 || mi > 59 || !(s >= 0.0 && s < 61.0))
+        return FALSE;
+
+    *jd = gregorian_to_jd(y, mo, d, h, mi, s);
+
+    return TRUE;
+}
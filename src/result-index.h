@@ -0,0 +1,78 @@
+/*
+  OGpredict — extensions to Gpredict for operations planning
+
+  Copyright (C) 2025 Axel Osika <osikaaxel@gmail.com>
+
+  This file is part of OGpredict, a derivative of Gpredict.
+
+  OGpredict is free software: you can redistribute it and/or modify it
+  under the terms of the GNU General Public License as published by the
+  Free Software Foundation; either version 2 of the License, or (at your
+  option) any later version.  See the GNU General Public License for details.
+*/
+
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#ifndef __RESULT_INDEX_H__
+#define __RESULT_INDEX_H__ 1
+
+#include <glib.h>
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/** Grid cell size of the spatial index [deg]. */
+#define RESULT_INDEX_CELL 5
+#define RESULT_INDEX_ROWS (180 / RESULT_INDEX_CELL)
+#define RESULT_INDEX_COLS (360 / RESULT_INDEX_CELL)
+
+/** How rows are grouped into segments. */
+typedef enum {
+    RESULT_SEG_ORBIT,           /*!< A new segment at each ascending node */
+    RESULT_SEG_PASS             /*!< A new segment after a gap in time */
+} result_seg_mode_t;
+
+/**
+ * Index over a time-ordered result table.
+ *
+ * Rows are appended in table order.  The index answers time lookups by
+ * binary search, lists the rows of an orbit or pass, and finds the rows in
+ * a lat/lon box through a coarse grid.
+ */
+typedef struct {
+    GArray         *jd;         /*!< gdouble per row, ascending */
+    GArray         *lat;        /*!< gfloat per row [deg] */
+    GArray         *lon;        /*!< gfloat per row [deg] */
+    GArray         *seg;        /*!< guint, first row of each segment */
+    GArray         *cell[RESULT_INDEX_ROWS * RESULT_INDEX_COLS];
+    result_seg_mode_t mode;
+    gdouble         gap;        /*!< RESULT_SEG_PASS: gap starting a segment [days] */
+    guint           stride;     /*!< RESULT_SEG_ORBIT: rows per time step, default 1 */
+} result_index_t;
+
+result_index_t *result_index_new(result_seg_mode_t mode, gdouble gap);
+void            result_index_free(result_index_t * index);
+void            result_index_append(result_index_t * index, gdouble jd,
+                                    gdouble lat, gdouble lon);
+guint           result_index_find_time(const result_index_t * index,
+                                       gdouble jd);
+guint           result_index_n_segments(const result_index_t * index);
+gboolean        result_index_segment(const result_index_t * index, guint k,
+                                     guint * first, guint * end);
+GArray         *result_index_box(const result_index_t * index,
+                                 gdouble lat_min, gdouble lat_max,
+                                 gdouble lon_min, gdouble lon_max);
+gboolean        result_index_parse_time(const gchar * text, gdouble * jd);
+
+#define RESULT_INDEX_LEN(i) ((i)->jd->len)
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+}
+#endif
+/* *INDENT-ON* */
+
+#endif
@@ -34,18 +34,12 @@
 #include <build-config.h>
 #endif
 #include <glib/gi18n.h>
-#include <gtk/gtk.h>
 
 #include "compat.h"
 #include "config-keys.h"
-#include "gpredict-utils.h"
-#include "gtk-polar-view.h"
-#include "gtk-sat-module.h"
-#include "gtk-sat-list.h"
-#include "gtk-single-sat.h"
 #include "sat-cfg.h"
 #include "sat-log.h"
-#include "sat-pass-dialogs.h"
+#include "view-flags.h"
 
 /* *INDENT-OFF* */
 #define LIST_COLUMNS_DEFAULTS (SAT_LIST_FLAG_NAME |\
@@ -207,7 +201,8 @@ sat_cfg_int_t   sat_cfg_int[SAT_CFG_INT_NUM] = {
     {"TLE", "AUTO_UPDATE_ACTION", 1},   /* notify, see tle_auto_upd_action_t */
     {"TLE", "LAST_UPDATE", 0},
     {"LOG", "CLEAN_AGE", 0},    /* 0 = Never clean */
-    {"LOG", "LEVEL", 2}
+    {"LOG", "LEVEL", 2},
+    {"EPHEMERIS", "CACHE_SIZE", 256}
 };
 
 /** Array containing the string configuration values */
@@ -42,7 +42,6 @@
 #include <glib/gi18n.h>
 #include <glib/gprintf.h>
 #include <glib/gstdio.h>
-#include <gtk/gtk.h>
 #include <time.h>
 
 #include "compat.h"
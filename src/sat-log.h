@@ -25,7 +25,7 @@
 #ifndef SAT_LOG_H
 #define SAT_LOG_H 1
 
-#include <gtk/gtk.h>
+#include <glib.h>
 
 #define SAT_LOG_MSG_SEPARATOR "|"
 
@@ -230,9 +230,6 @@ static gboolean button_press_cb(GtkWidget * treeview,
 static void     view_popup_menu(GtkWidget * treeview,
                                 GdkEventButton * event, gpointer data);
 
-static void     Calc_RADec(gdouble jul_utc, gdouble saz, gdouble sel,
-                           qth_t * qth, obs_astro_t * obs_set);
-
 static void     single_pass_response(GtkWidget * dialog, gint response,
                                      gpointer data);
 static void     multi_pass_response(GtkWidget * dialog, gint response,
@@ -277,12 +274,13 @@ void show_pass(const gchar * satname, qth_t * qth, pass_t * pass,
     guint           flags;
     guint           i, num;
     pass_detail_t  *detail;
+    GSList         *node;
     gchar          *buff;
-    gint            retcode;
+    gchar          *ssp = NULL;
+    gdouble        *lon, *lat;
     gdouble         doppler;
     gdouble         delay;
     gdouble         loss;
-    obs_astro_t     astro;
     gdouble         ra, dec;
 
     /* get columns flags */
@@ -340,6 +338,21 @@ void show_pass(const gchar * satname, qth_t * qth, pass_t * pass,
     /* add rows to list store */
     num = g_slist_length(pass->details);
 
+    /* sub-satellite locators of all rows in one go */
+    if (flags & SINGLE_PASS_FLAG_SSP)
+    {
+        lon = g_new(gdouble, 2 * num);
+        lat = lon + num;
+        for (i = 0, node = pass->details; node != NULL; node = node->next, i++)
+        {
+            lon[i] = PASS_DETAIL(node->data)->lon;
+            lat[i] = PASS_DETAIL(node->data)->lat;
+        }
+        ssp = g_new(gchar, 7 * num);
+        longlat2locator_n(lon, lat, ssp, 3, num);
+        g_free(lon);
+    }
+
     for (i = 0; i < num; i++)
     {
         detail = PASS_DETAIL(g_slist_nth_data(pass->details, i));
@@ -363,10 +376,8 @@ void show_pass(const gchar * satname, qth_t * qth, pass_t * pass,
         /*     SINGLE_PASS_COL_DEC */
         if (flags & (SINGLE_PASS_FLAG_RA | SINGLE_PASS_FLAG_DEC))
         {
-            Calc_RADec(detail->time, detail->az, detail->el, qth, &astro);
-
-            ra = Degrees(astro.ra);
-            dec = Degrees(astro.dec);
+            predict_azel_to_radec(detail->time, detail->az, detail->el, qth,
+                                  &ra, &dec);
 
             gtk_list_store_set(liststore, &item,
                                SINGLE_PASS_COL_RA, ra, SINGLE_PASS_COL_DEC,
@@ -374,17 +385,10 @@ void show_pass(const gchar * satname, qth_t * qth, pass_t * pass,
         }
 
         /*     SINGLE_PASS_COL_SSP */
-        if (flags & SINGLE_PASS_FLAG_SSP)
+        if (ssp != NULL)
         {
-            buff = g_try_malloc(7);
-            retcode = longlat2locator(detail->lon, detail->lat, buff, 3);
-            if (retcode == RIG_OK)
-            {
-                buff[6] = '\0';
-                gtk_list_store_set(liststore, &item, SINGLE_PASS_COL_SSP, buff,
-                                   -1);
-            }
-            g_free(buff);
+            gtk_list_store_set(liststore, &item, SINGLE_PASS_COL_SSP,
+                               ssp + 7 * i, -1);
         }
 
         /*      SINGLE_PASS_COL_DOPPLER */
@@ -420,6 +424,7 @@ void show_pass(const gchar * satname, qth_t * qth, pass_t * pass,
             g_free(buff);
         }
     }
+    g_free(ssp);
 
     /* connect model to tree view */
     gtk_tree_view_set_model(GTK_TREE_VIEW(list), GTK_TREE_MODEL(liststore));
@@ -865,52 +870,6 @@ static void single_pass_dialog_destroy(GtkWidget * dialog, gpointer data)
     gtk_widget_destroy(dialog);
 }
 
-/*** FIXME: other copies */
-static void Calc_RADec(gdouble jul_utc, gdouble saz, gdouble sel,
-                       qth_t * qth, obs_astro_t * obs_set)
-{
-
-    double          phi, theta, sin_theta, cos_theta, sin_phi, cos_phi,
-        az, el, Lxh, Lyh, Lzh, Sx, Ex, Zx, Sy, Ey, Zy, Sz, Ez, Zz,
-        Lx, Ly, Lz, cos_delta, sin_alpha, cos_alpha;
-    geodetic_t      geodetic;
-
-    geodetic.lon = qth->lon * de2ra;
-    geodetic.lat = qth->lat * de2ra;
-    geodetic.alt = qth->alt / 1000.0;
-    geodetic.theta = 0;
-
-    az = saz * de2ra;
-    el = sel * de2ra;
-    phi = geodetic.lat;
-    theta = FMod2p(ThetaG_JD(jul_utc) + geodetic.lon);
-    sin_theta = sin(theta);
-    cos_theta = cos(theta);
-    sin_phi = sin(phi);
-    cos_phi = cos(phi);
-    Lxh = -cos(az) * cos(el);
-    Lyh = sin(az) * cos(el);
-    Lzh = sin(el);
-    Sx = sin_phi * cos_theta;
-    Ex = -sin_theta;
-    Zx = cos_theta * cos_phi;
-    Sy = sin_phi * sin_theta;
-    Ey = cos_theta;
-    Zy = sin_theta * cos_phi;
-    Sz = -cos_phi;
-    Ez = 0;
-    Zz = sin_phi;
-    Lx = Sx * Lxh + Ex * Lyh + Zx * Lzh;
-    Ly = Sy * Lxh + Ey * Lyh + Zy * Lzh;
-    Lz = Sz * Lxh + Ez * Lyh + Zz * Lzh;
-    obs_set->dec = ArcSin(Lz);  /* Declination (radians) */
-    cos_delta = sqrt(1 - Sqr(Lz));
-    sin_alpha = Ly / cos_delta;
-    cos_alpha = Lx / cos_delta;
-    obs_set->ra = AcTan(sin_alpha, cos_alpha);  /* Right Ascension (radians) */
-    obs_set->ra = FMod2p(obs_set->ra);
-}
-
 /***   MULTI PASS  ***/
 
 /**
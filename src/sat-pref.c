@@ -25,6 +25,7 @@
 
 #include "compat.h"
 #include "gpredict-utils.h"
+#include "mod-mgr.h"
 #include "sat-cfg.h"
 #include "sat-pref.h"
 #include "sat-pref-general.h"
@@ -173,6 +174,7 @@ void sat_pref_run()
         sat_pref_interfaces_ok();
         sat_pref_predict_ok();
         sat_cfg_save();
+        mod_mgr_reconf();
         break;
 
     default:
@@ -0,0 +1,193 @@
+/*
+  OGpredict — extensions to Gpredict for operations planning
+
+  Copyright (C) 2025 Axel Osika <osikaaxel@gmail.com>
+
+  This file is part of OGpredict, a derivative of Gpredict.
+
+  OGpredict is free software: you can redistribute it and/or modify it
+  under the terms of the GNU General Public License as published by the
+  Free Software Foundation; either version 2 of the License, or (at your
+  option) any later version.  See the GNU General Public License for details.
+*/
+
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/**
+ * sat-table.c — read-side snapshot of the per-tick satellite state
+ *
+ * sat_t is close to 1 kB: element sets, deep-space and SGP4 work areas,
+ * strings and position vectors.  The views only need a dozen doubles of it
+ * on every tick, and reaching them through a hash lookup per row drags the
+ * whole record through the cache.  The module therefore keeps its
+ * satellites in a table: after each satellite is propagated, its displayed
+ * fields are copied into a contiguous array of sat_state_t, which the views
+ * read in order.
+ *
+ * This is a cache for the readers only.  predict_calc() still works on, and
+ * writes into, the full sat_t; the propagation cost per tick is unchanged
+ * and the copy comes on top of it.
+ *
+ * Indices are stable for the lifetime of a table.  The table is rebuilt when
+ * the set of satellites changes; an element set swap keeps the sat_t and
+ * only needs the record refreshed.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <build-config.h>
+#endif
+
+#include "orbit-tools.h"
+#include "predict-tools.h"
+#include "sat-table.h"
+
+static gint compare_catnr(gconstpointer a, gconstpointer b)
+{
+    const sat_t    *sa = *(sat_t * const *)a;
+    const sat_t    *sb = *(sat_t * const *)b;
+
+    return (sa->tle.catnr > sb->tle.catnr) - (sa->tle.catnr < sb->tle.catnr);
+}
+
+static void add_sat(gpointer key, gpointer value, gpointer data)
+{
+    (void)key;
+
+    g_ptr_array_add((GPtrArray *) data, value);
+}
+
+/**
+ * Build a table from a hash of satellites.
+ *
+ * @param sats Satellites keyed by catalogue number; may be NULL.
+ * @return A new table ordered by catalogue number.  The records are filled
+ *         from the current sat_t contents.
+ */
+sat_table_t    *sat_table_new(GHashTable * sats)
+{
+    sat_table_t    *table;
+    guint           n = (sats != NULL) ? g_hash_table_size(sats) : 0;
+    guint           i;
+
+    table = g_new0(sat_table_t, 1);
+    table->sats = g_ptr_array_sized_new(n);
+    table->state = g_array_sized_new(FALSE, TRUE, sizeof(sat_state_t), n);
+    table->index = g_hash_table_new(g_direct_hash, g_direct_equal);
+
+    if (sats != NULL)
+        g_hash_table_foreach(sats, add_sat, table->sats);
+
+    /* stable order so that rebuilding does not shuffle the views */
+    g_ptr_array_sort(table->sats, compare_catnr);
+    g_array_set_size(table->state, table->sats->len);
+
+    for (i = 0; i < table->sats->len; i++)
+    {
+        g_hash_table_insert(table->index,
+                            GINT_TO_POINTER(SAT_TABLE_SAT(table, i)->tle.
+                                            catnr), GUINT_TO_POINTER(i + 1));
+        sat_table_store(table, i);
+    }
+
+    return table;
+}
+
+void sat_table_free(sat_table_t * table)
+{
+    if (table == NULL)
+        return;
+
+    g_hash_table_destroy(table->index);
+    g_ptr_array_free(table->sats, TRUE);
+    g_array_free(table->state, TRUE);
+    g_free(table);
+}
+
+/**
+ * Look up a satellite.
+ *
+ * @return The index of the satellite or -1 if it is not in the table.
+ */
+gint sat_table_find(const sat_table_t * table, gint catnr)
+{
+    gpointer        idx;
+
+    idx = g_hash_table_lookup(table->index, GINT_TO_POINTER(catnr));
+
+    return (idx != NULL) ? (gint) GPOINTER_TO_UINT(idx) - 1 : -1;
+}
+
+/** Copy the hot fields of satellite i into its state record. */
+void sat_table_store(sat_table_t * table, guint i)
+{
+    sat_t          *sat = SAT_TABLE_SAT(table, i);
+    sat_state_t    *st = SAT_TABLE_STATE(table, i);
+
+    st->catnr = sat->tle.catnr;
+    st->otype = (guint16) sat->otype;
+    st->flags = decayed(sat) ? SAT_STATE_DECAYED : 0;
+    st->orbit = sat->orbit;
+    st->az = sat->az;
+    st->el = sat->el;
+    st->range = sat->range;
+    st->range_rate = sat->range_rate;
+    st->ssplat = sat->ssplat;
+    st->ssplon = sat->ssplon;
+    st->alt = sat->alt;
+    st->velo = sat->velo;
+    st->footprint = sat->footprint;
+    st->ma = sat->ma;
+    st->phase = sat->phase;
+    st->aos = sat->aos;
+    st->los = sat->los;
+    st->derived = 0;
+}
+
+void sat_table_store_all(sat_table_t * table)
+{
+    guint           i;
+
+    for (i = 0; i < SAT_TABLE_LEN(table); i++)
+        sat_table_store(table, i);
+}
+
+/**
+ * RA/Dec of satellite i in its stored state.
+ *
+ * Computed on first use after sat_table_store() and shared by all views
+ * showing the satellite.
+ *
+ * @return The state record with valid ra and dec.
+ */
+const sat_state_t *sat_table_radec(sat_table_t * table, guint i, qth_t * qth)
+{
+    sat_state_t    *st = SAT_TABLE_STATE(table, i);
+
+    if (!(st->derived & SAT_DERIVED_RADEC))
+    {
+        predict_azel_to_radec(SAT_TABLE_SAT(table, i)->jul_utc, st->az,
+                              st->el, qth, &st->ra, &st->dec);
+        st->derived |= SAT_DERIVED_RADEC;
+    }
+
+    return st;
+}
+
+/**
+ * Visibility of satellite i in its stored state.
+ *
+ * Computed on first use after sat_table_store() and shared by all views.
+ */
+sat_vis_t sat_table_vis(sat_table_t * table, guint i, qth_t * qth)
+{
+    sat_state_t    *st = SAT_TABLE_STATE(table, i);
+    sat_t          *sat = SAT_TABLE_SAT(table, i);
+
+    if (!(st->derived & SAT_DERIVED_VIS))
+    {
+        st->vis = (guint16) get_sat_vis(sat, qth, sat->jul_utc);
+        st->derived |= SAT_DERIVED_VIS;
+    }
+
+    return (sat_vis_t) st->vis;
+}
@@ -0,0 +1,96 @@
+/*
+  OGpredict — extensions to Gpredict for operations planning
+
+  Copyright (C) 2025 Axel Osika <osikaaxel@gmail.com>
+
+  This file is part of OGpredict, a derivative of Gpredict.
+
+  OGpredict is free software: you can redistribute it and/or modify it
+  under the terms of the GNU General Public License as published by the
+  Free Software Foundation; either version 2 of the License, or (at your
+  option) any later version.  See the GNU General Public License for details.
+*/
+
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#ifndef __SAT_TABLE_H__
+#define __SAT_TABLE_H__ 1
+
+#include <glib.h>
+
+#include "qth-data.h"
+#include "sat-vis.h"
+#include "sgpsdp/sgp4sdp4.h"
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/** Flags of a state record. */
+#define SAT_STATE_DECAYED   (1 << 0)    /*!< Satellite has decayed */
+
+/** Derived quantities of a state record, computed on first use. */
+#define SAT_DERIVED_RADEC   (1 << 0)    /*!< ra and dec are valid */
+#define SAT_DERIVED_VIS     (1 << 1)    /*!< vis is valid */
+
+/** Per-tick state of one satellite, copied from its sat_t for the views. */
+typedef struct {
+    gint            catnr;      /*!< Catalogue number */
+    guint16         otype;      /*!< orbit_type_t */
+    guint16         flags;      /*!< SAT_STATE_* */
+    glong           orbit;      /*!< Orbit number */
+    gdouble         az;         /*!< Azimuth [deg] */
+    gdouble         el;         /*!< Elevation [deg] */
+    gdouble         range;      /*!< Range [km] */
+    gdouble         range_rate; /*!< Range rate [km/sec] */
+    gdouble         ssplat;     /*!< SSP latitude [deg] */
+    gdouble         ssplon;     /*!< SSP longitude [deg] */
+    gdouble         alt;        /*!< Altitude [km] */
+    gdouble         velo;       /*!< Velocity [km/s] */
+    gdouble         footprint;  /*!< Footprint diameter [km] */
+    gdouble         ma;         /*!< Mean anomaly */
+    gdouble         phase;      /*!< Orbit phase */
+    gdouble         aos;        /*!< Next AOS */
+    gdouble         los;        /*!< Next LOS */
+    guint16         derived;    /*!< SAT_DERIVED_*; cleared by sat_table_store() */
+    guint16         vis;        /*!< Visibility (sat_vis_t) */
+    gdouble         ra;         /*!< Right Ascension [deg] */
+    gdouble         dec;        /*!< Declination [deg] */
+} sat_state_t;
+
+/**
+ * Satellites of a module in a fixed order.
+ *
+ * state holds the compact records the views read on every tick; sats holds
+ * the full sat_t at the same index, which is what gets propagated, and
+ * everything else.  The sat_t are owned
+ * by the hash table the table was built from.
+ */
+typedef struct {
+    GArray         *state;      /*!< sat_state_t, by index */
+    GPtrArray      *sats;       /*!< sat_t, by index */
+    GHashTable     *index;      /*!< Catalogue number -> index + 1 */
+} sat_table_t;
+
+#define SAT_TABLE_LEN(t)        ((t)->state->len)
+#define SAT_TABLE_STATE(t, i)   (&g_array_index((t)->state, sat_state_t, (i)))
+#define SAT_TABLE_SAT(t, i)     ((sat_t *) g_ptr_array_index((t)->sats, (i)))
+
+sat_table_t    *sat_table_new(GHashTable * sats);
+void            sat_table_free(sat_table_t * table);
+gint            sat_table_find(const sat_table_t * table, gint catnr);
+void            sat_table_store(sat_table_t * table, guint i);
+void            sat_table_store_all(sat_table_t * table);
+const sat_state_t *sat_table_radec(sat_table_t * table, guint i,
+                                   qth_t * qth);
+sat_vis_t       sat_table_vis(sat_table_t * table, guint i, qth_t * qth);
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+}
+#endif
+/* *INDENT-ON* */
+
+#endif
@@ -26,7 +26,7 @@
     along with this program; if not, visit http://www.fsf.org/
 */
 /** \brief Satellite visibility calculations. */
-#include <gtk/gtk.h>
+#include <glib.h>
 #include <glib/gi18n.h>
 #include "sgpsdp/sgp4sdp4.h"
 #include "gtk-sat-data.h"
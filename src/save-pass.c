@@ -48,8 +48,11 @@ static void     save_passes_exec(GtkWidget * parent,
                                  GSList * passes, qth_t * qth,
                                  const gchar * savedir, const gchar * savefile,
                                  gint format, gint contents);
-static void     save_to_file(GtkWidget * parent, const gchar * fname,
-                             const gchar * data);
+static GIOChannel *save_open_file(GtkWidget * parent, const gchar * fname);
+static gboolean save_write(GIOChannel * chan, const gchar * data,
+                           GError ** err);
+static void     save_close_file(GtkWidget * parent, GIOChannel * chan,
+                                const gchar * fname, GError * err);
 
 enum pass_content_e {
     PASS_CONTENT_ALL = 0,
@@ -63,6 +66,7 @@ enum passes_content_e {
 };
 
 #define SAVE_FORMAT_TXT     0
+#define SAVE_FORMAT_CSV     1
 
 /**
  * Save a satellite pass.
@@ -86,6 +90,7 @@ void save_pass(GtkWidget * parent)
     GtkWidget      *dirchooser;
     GtkWidget      *filchooser;
     GtkWidget      *contents;
+    GtkWidget      *format;
     GtkWidget      *label;
     gint            response;
     pass_t         *pass;
@@ -93,6 +98,7 @@ void save_pass(GtkWidget * parent)
     gchar          *savedir = NULL;
     gchar          *savefile;
     gint            cont;
+    gint            fmt;
 
 
     /* get data attached to parent */
@@ -172,6 +178,23 @@ void save_pass(GtkWidget * parent)
                              sat_cfg_get_int(SAT_CFG_INT_PRED_SAVE_CONTENTS));
     gtk_grid_attach(GTK_GRID(grid), contents, 1, 2, 1, 1);
 
+    /* file format */
+    label = gtk_label_new(_("File format:"));
+    g_object_set(G_OBJECT(label), "halign", GTK_ALIGN_START,
+                 "valign", GTK_ALIGN_CENTER, NULL);
+    gtk_grid_attach(GTK_GRID(grid), label, 0, 3, 1, 1);
+
+    format = gtk_combo_box_text_new();
+    gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(format),
+                                   _("Plain text"));
+    gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(format),
+                                   _("CSV (comma separated values)"));
+    gtk_combo_box_set_active(GTK_COMBO_BOX(format),
+                             CLAMP(sat_cfg_get_int
+                                   (SAT_CFG_INT_PRED_SAVE_FORMAT),
+                                   SAVE_FORMAT_TXT, SAVE_FORMAT_CSV));
+    gtk_grid_attach(GTK_GRID(grid), format, 1, 3, 1, 1);
+
     gtk_widget_show_all(grid);
     gtk_container_add(GTK_CONTAINER
                       (gtk_dialog_get_content_area(GTK_DIALOG(dialog))), grid);
@@ -188,14 +211,15 @@ void save_pass(GtkWidget * parent)
         savedir = gtk_file_chooser_get_filename(GTK_FILE_CHOOSER(dirchooser));
         savefile = g_strdup(gtk_entry_get_text(GTK_ENTRY(filchooser)));
         cont = gtk_combo_box_get_active(GTK_COMBO_BOX(contents));
+        fmt = gtk_combo_box_get_active(GTK_COMBO_BOX(format));
 
         /* call saver */
-        save_pass_exec(dialog, pass, qth, savedir, savefile, SAVE_FORMAT_TXT,
-                       cont);
+        save_pass_exec(dialog, pass, qth, savedir, savefile, fmt, cont);
 
         /* store new settings */
         sat_cfg_set_str(SAT_CFG_STR_PRED_SAVE_DIR, savedir);
         sat_cfg_set_int(SAT_CFG_INT_PRED_SAVE_CONTENTS, cont);
+        sat_cfg_set_int(SAT_CFG_INT_PRED_SAVE_FORMAT, fmt);
 
         /* clean up */
         g_free(savedir);
@@ -233,6 +257,7 @@ void save_passes(GtkWidget * parent)
     GtkWidget      *dirchooser;
     GtkWidget      *filchooser;
     GtkWidget      *contents;
+    GtkWidget      *format;
     GtkWidget      *label;
     gint            response;
     GSList         *passes;
@@ -241,6 +266,7 @@ void save_passes(GtkWidget * parent)
     gchar          *savedir = NULL;
     gchar          *savefile;
     gint            cont;
+    gint            fmt;
 
     /* get data attached to parent */
     sat = (gchar *) g_object_get_data(G_OBJECT(parent), "sat");
@@ -315,6 +341,23 @@ void save_passes(GtkWidget * parent)
     gtk_combo_box_set_active(GTK_COMBO_BOX(contents), 0);
     gtk_grid_attach(GTK_GRID(grid), contents, 1, 2, 1, 1);
 
+    /* file format */
+    label = gtk_label_new(_("File format:"));
+    g_object_set(G_OBJECT(label), "halign", GTK_ALIGN_START,
+                 "valign", GTK_ALIGN_CENTER, NULL);
+    gtk_grid_attach(GTK_GRID(grid), label, 0, 3, 1, 1);
+
+    format = gtk_combo_box_text_new();
+    gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(format),
+                                   _("Plain text"));
+    gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(format),
+                                   _("CSV (comma separated values)"));
+    gtk_combo_box_set_active(GTK_COMBO_BOX(format),
+                             CLAMP(sat_cfg_get_int
+                                   (SAT_CFG_INT_PRED_SAVE_FORMAT),
+                                   SAVE_FORMAT_TXT, SAVE_FORMAT_CSV));
+    gtk_grid_attach(GTK_GRID(grid), format, 1, 3, 1, 1);
+
     gtk_widget_show_all(grid);
     gtk_container_add(GTK_CONTAINER
                       (gtk_dialog_get_content_area(GTK_DIALOG(dialog))), grid);
@@ -331,13 +374,14 @@ void save_passes(GtkWidget * parent)
         savedir = gtk_file_chooser_get_filename(GTK_FILE_CHOOSER(dirchooser));
         savefile = g_strdup(gtk_entry_get_text(GTK_ENTRY(filchooser)));
         cont = gtk_combo_box_get_active(GTK_COMBO_BOX(contents));
+        fmt = gtk_combo_box_get_active(GTK_COMBO_BOX(format));
 
         /* call saver */
-        save_passes_exec(dialog, passes, qth, savedir, savefile,
-                         SAVE_FORMAT_TXT, cont);
+        save_passes_exec(dialog, passes, qth, savedir, savefile, fmt, cont);
 
         /* store new settings */
         sat_cfg_set_str(SAT_CFG_STR_PRED_SAVE_DIR, savedir);
+        sat_cfg_set_int(SAT_CFG_INT_PRED_SAVE_FORMAT, fmt);
 
         /* clean up */
         g_free(savedir);
@@ -429,68 +473,88 @@ static void save_passes_exec(GtkWidget * parent,
     gchar          *fname;
     gchar          *pgheader;
     gchar          *tblheader;
-    gchar          *tblcontents;
-    gchar          *buff = NULL;
-    gchar          *data = NULL;
+    gchar          *orbit;
+    GIOChannel     *chan;
+    GString        *buff;
+    GError         *err = NULL;
+    GSList         *node;
     pass_t         *pass;
     gint            fields;
-    guint           i, n;
+    gboolean        csv = (format == SAVE_FORMAT_CSV);
 
-    switch (format)
+    if (format != SAVE_FORMAT_TXT && format != SAVE_FORMAT_CSV)
     {
-    case SAVE_FORMAT_TXT:
+        sat_log_log(SAT_LOG_LEVEL_ERROR,
+                    _("%s: Invalid file format: %d"), __func__, format);
+        return;
+    }
+
+    /* prepare full file name */
+    fname = g_strconcat(savedir, G_DIR_SEPARATOR_S, savefile,
+                        csv ? ".csv" : ".txt", NULL);
 
-        /* prepare full file name */
-        fname =
-            g_strconcat(savedir, G_DIR_SEPARATOR_S, savefile, ".txt", NULL);
+    chan = save_open_file(parent, fname);
+    if (chan == NULL)
+    {
+        g_free(fname);
+        return;
+    }
 
-        /* get visible columns for summary */
-        fields = sat_cfg_get_int(SAT_CFG_INT_PRED_MULTI_COL);
+    buff = g_string_sized_new(65536);
 
-        /* create file contents */
+    /* summary; get visible columns for summary */
+    fields = sat_cfg_get_int(SAT_CFG_INT_PRED_MULTI_COL);
+    if (csv)
+    {
+        tblheader = passes_to_csv_tblheader(fields);
+        pgheader = NULL;
+    }
+    else
+    {
         pgheader = passes_to_txt_pgheader(passes, qth, fields);
         tblheader = passes_to_txt_tblheader(passes, qth, fields);
-        tblcontents = passes_to_txt_tblcontents(passes, qth, fields);
+    }
+
+    if (save_write(chan, pgheader, &err) && save_write(chan, tblheader, &err))
+        passes_to_txt_write_rows(chan, buff, passes, qth, fields, csv, &err);
 
-        data = g_strconcat(pgheader, tblheader, tblcontents, NULL);
+    g_free(pgheader);
+    g_free(tblheader);
 
-        g_free(pgheader);
-        g_free(tblheader);
-        g_free(tblcontents);
+    /* details of each pass, streamed one pass at a time */
+    if (err == NULL && contents == PASSES_CONTENT_FULL)
+    {
+        fields = sat_cfg_get_int(SAT_CFG_INT_PRED_SINGLE_COL);
 
-        if (contents == PASSES_CONTENT_FULL)
+        for (node = passes; node != NULL && err == NULL; node = node->next)
         {
-            fields = sat_cfg_get_int(SAT_CFG_INT_PRED_SINGLE_COL);
-            n = g_slist_length(passes);
+            pass = PASS(node->data);
 
-            for (i = 0; i < n; i++)
+            if (csv)
             {
-
-                pass = PASS(g_slist_nth_data(passes, i));
-
+                orbit = g_strdup_printf("\nOrbit,%d\n", pass->orbit);
+                tblheader = pass_to_csv_tblheader(fields);
+            }
+            else
+            {
+                orbit = g_strdup_printf("\n Orbit %d\n", pass->orbit);
                 tblheader = pass_to_txt_tblheader(pass, qth, fields);
-                tblcontents = pass_to_txt_tblcontents(pass, qth, fields);
-                buff = g_strdup_printf("%s\n Orbit %d\n%s%s",
-                                       data, pass->orbit,
-                                       tblheader, tblcontents);
-                g_free(data);
-                data = g_strdup(buff);
-                g_free(buff);
-
             }
-        }
 
-        /* save data */
-        save_to_file(parent, fname, data);
-        g_free(data);
-        g_free(fname);
-        break;
+            if (save_write(chan, orbit, &err) &&
+                save_write(chan, tblheader, &err))
+                pass_to_txt_write_rows(chan, buff, pass, qth, fields, csv,
+                                       &err);
 
-    default:
-        sat_log_log(SAT_LOG_LEVEL_ERROR,
-                    _("%s: Invalid file format: %d"), __func__, format);
-        break;
+            g_free(orbit);
+            g_free(tblheader);
+        }
     }
+
+    save_close_file(parent, chan, fname, err);
+
+    g_string_free(buff, TRUE);
+    g_free(fname);
 }
 
 /**
@@ -518,91 +582,71 @@ static void save_pass_exec(GtkWidget * parent,
                            gint format, gint contents)
 {
     gchar          *fname;
-    gchar          *pgheader;
-    gchar          *tblheader;
-    gchar          *tblcontents;
-    gchar          *buff = NULL;
-    gchar          *data = NULL;
+    gchar          *pgheader = NULL;
+    gchar          *tblheader = NULL;
+    GIOChannel     *chan;
+    GString        *buff;
+    GError         *err = NULL;
     gint            fields;
+    gboolean        csv = (format == SAVE_FORMAT_CSV);
 
-    switch (format)
+    if (format != SAVE_FORMAT_TXT && format != SAVE_FORMAT_CSV)
     {
-    case SAVE_FORMAT_TXT:
-
-        /* prepare full file name */
-        fname =
-            g_strconcat(savedir, G_DIR_SEPARATOR_S, savefile, ".txt", NULL);
-
-        /* get visible columns */
-        fields = sat_cfg_get_int(SAT_CFG_INT_PRED_SINGLE_COL);
-
-        /* create file contents */
-        pgheader = pass_to_txt_pgheader(pass, qth, fields);
-        tblheader = pass_to_txt_tblheader(pass, qth, fields);
-        tblcontents = pass_to_txt_tblcontents(pass, qth, fields);
+        sat_log_log(SAT_LOG_LEVEL_ERROR,
+                    _("%s: Invalid file format: %d"), __func__, format);
+        return;
+    }
 
-        /* Add page header if selected */
-        if (contents == PASS_CONTENT_ALL)
-        {
-            data = g_strdup(pgheader);
-        }
+    /* prepare full file name */
+    fname = g_strconcat(savedir, G_DIR_SEPARATOR_S, savefile,
+                        csv ? ".csv" : ".txt", NULL);
 
-        /* Add table header if selected */
-        if ((contents == PASS_CONTENT_ALL) || (contents == PASS_CONTENT_TABLE))
-        {
-            if (data != NULL)
-            {
-                buff = g_strdup(data);
-                g_free(data);
-                data = g_strconcat(buff, tblheader, NULL);
-                g_free(buff);
-            }
-            else
-            {
-                data = g_strdup(tblheader);
-            }
+    chan = save_open_file(parent, fname);
+    if (chan == NULL)
+    {
+        g_free(fname);
+        return;
+    }
 
-        }
+    /* get visible columns */
+    fields = sat_cfg_get_int(SAT_CFG_INT_PRED_SINGLE_COL);
 
-        /* Add data */
-        if (data != NULL)
-        {
-            buff = g_strdup(data);
-            g_free(data);
-            data = g_strconcat(buff, tblcontents, NULL);
-            g_free(buff);
-        }
-        else
-        {
-            data = g_strdup(tblcontents);
-        }
+    /* Add page header if selected; CSV files have none */
+    if (contents == PASS_CONTENT_ALL && !csv)
+        pgheader = pass_to_txt_pgheader(pass, qth, fields);
 
-        /* save data */
-        save_to_file(parent, fname, data);
+    /* Add table header if selected */
+    if ((contents == PASS_CONTENT_ALL) || (contents == PASS_CONTENT_TABLE))
+        tblheader = csv ? pass_to_csv_tblheader(fields) :
+            pass_to_txt_tblheader(pass, qth, fields);
 
-        /* clean up memory */
-        g_free(fname);
-        g_free(data);
-        g_free(pgheader);
-        g_free(tblheader);
-        g_free(tblcontents);
+    /* Add data, streamed straight into the file */
+    buff = g_string_sized_new(65536);
+    if (save_write(chan, pgheader, &err) && save_write(chan, tblheader, &err))
+        pass_to_txt_write_rows(chan, buff, pass, qth, fields, csv, &err);
 
-        break;
+    save_close_file(parent, chan, fname, err);
 
-    default:
-        sat_log_log(SAT_LOG_LEVEL_ERROR,
-                    _("%s: Invalid file format: %d"), __func__, format);
-        break;
-    }
+    /* clean up memory */
+    g_string_free(buff, TRUE);
+    g_free(fname);
+    g_free(pgheader);
+    g_free(tblheader);
 }
 
-static void save_to_file(GtkWidget * parent, const gchar * fname,
-                         const gchar * data)
+/**
+ * Create a file for writing.
+ *
+ * @param parent Parent window (needed for error dialogs).
+ * @param fname The file name.
+ * @return The open channel or NULL if the file could not be created, in
+ *         which case the user has been told.
+ */
+static GIOChannel *save_open_file(GtkWidget * parent, const gchar * fname)
 {
     GIOChannel     *chan;
     GError         *err = NULL;
     GtkWidget      *dialog;
-    gsize           count;
 
     /* create file */
     chan = g_io_channel_new_file(fname, "w", &err);
@@ -626,11 +670,39 @@ static void save_to_file(GtkWidget * parent, const gchar * fname,
         /* clean up and return */
         g_clear_error(&err);
 
-        return;
+        return NULL;
     }
 
-    /* save contents to file */
-    g_io_channel_write_chars(chan, data, -1, &count, &err);
+    return chan;
+}
+
+/** Write a string to the file; NULL strings are skipped. */
+static gboolean save_write(GIOChannel * chan, const gchar * data,
+                           GError ** err)
+{
+    gsize           count;
+
+    if (data == NULL)
+        return TRUE;
+
+    return g_io_channel_write_chars(chan, data, -1, &count, err) ==
+        G_IO_STATUS_NORMAL;
+}
+
+/**
+ * Close a file written by save_open_file() and report the outcome.
+ *
+ * @param parent Parent window (needed for error dialogs).
+ * @param chan The channel to close.
+ * @param fname The file name.
+ * @param err The first error that occurred while writing or NULL. It is
+ *            freed by this function.
+ */
+static void save_close_file(GtkWidget * parent, GIOChannel * chan,
+                            const gchar * fname, GError * err)
+{
+    GtkWidget      *dialog;
+
     if (err != NULL)
     {
         sat_log_log(SAT_LOG_LEVEL_ERROR,
@@ -651,13 +723,11 @@ static void save_to_file(GtkWidget * parent, const gchar * fname,
     }
     else
     {
-        sat_log_log(SAT_LOG_LEVEL_DEBUG,
-                    _("%s: Written %d characters to %s"),
-                    __func__, count, fname);
+        sat_log_log(SAT_LOG_LEVEL_DEBUG, _("%s: Written %s"), __func__,
+                    fname);
     }
 
     /* close file, we don't care about errors here */
     g_io_channel_shutdown(chan, TRUE, NULL);
     g_io_channel_unref(chan);
-
 }
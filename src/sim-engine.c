@@ -0,0 +1,1033 @@
+/*
+  OGpredict — extensions to Gpredict for operations planning
+
+  Copyright (C) 2025 Axel Osika <osikaaxel@gmail.com>
+
+  This file is part of OGpredict, a derivative of Gpredict.
+
+  OGpredict is free software: you can redistribute it and/or modify it
+  under the terms of the GNU General Public License as published by the
+  Free Software Foundation; either version 2 of the License, or (at your
+  option) any later version.  See the GNU General Public License for details.
+*/
+
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/**
+ * sim-engine.c — headless fixed-step simulation core
+ *
+ * The time controller can run module time faster than real time, but every
+ * simulated step goes through the full GTK tick and high throttle values
+ * simply jump over events. This engine propagates private copies of the
+ * module satellites in fixed steps, as fast as the CPU allows, and records
+ * every event into a time-ordered timeline:
+ *
+ *   - AOS/LOS, refined by bisection to SIM_REFINE_TOL;
+ *   - territory entry/exit (snapshot of the Countries_tiles.csv tiles);
+ *   - POI tile entries (snapshot of the Logic_POI_Filter tiles);
+ *   - rotator and rig commands for the target satellite.
+ *
+ * The module uses the precomputed AOS/LOS instead of find_aos()/find_los(),
+ * so the views show exact event times, and replays the events crossed by
+ * each tick: rotator/rig commands become the set points of the rotator and
+ * radio controllers, the other events go to the log.
+ *
+ * Satellites are independent, so they are propagated in a GThreadPool; each
+ * worker writes into its own index-addressed slot and keeps its events in
+ * (time, catnr, type, index) order. The slots are then k-way merged, so the
+ * timeline does not depend on the thread count or on scheduling.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <build-config.h>
+#endif
+
+#include <glib/gi18n.h>
+#include <math.h>
+
+#include "gtk-sat-data.h"
+#include "Logic_Country_Filter.h"
+#include "Logic_POI_Filter.h"
+#include "points_interests.h"
+#include "predict-tools.h"
+#include "qth-route.h"
+#include "sat-log.h"
+#include "sgpsdp/sgp4sdp4.h"
+#include "sim-engine.h"
+
+/** Time resolution of refined events [days] (~0.1 s). */
+#define SIM_REFINE_TOL 1.0e-6
+
+/** Steps between two cancellation checks. */
+#define SIM_CANCEL_STRIDE 256
+
+/** Tile grid cell size [deg]; tiles are a few degrees wide at most. */
+#define SIM_TILE_CELL 2.0
+#define SIM_TILE_ROWS 90
+#define SIM_TILE_COLS 180
+
+/** Axis-aligned tile bounds. */
+typedef struct {
+    gdouble         lat_min, lat_max;
+    gdouble         lon_min, lon_max;
+} SimRect;
+
+/** Everything a worker needs; owned by the task, read-only while running. */
+typedef struct {
+    sim_params_t    params;
+    qth_t           qth;        /* numeric snapshot; pointer members NULL */
+    GPtrArray      *sats;       /* sat_t* private copies */
+    sim_tile_table_t *terr;     /* territory tiles; NULL when not recorded */
+    GArray         *terr_canon; /* tile index -> first tile of same territory */
+    sim_tile_table_t *poi;      /* POI tiles; NULL when not recorded */
+} SimJob;
+
+/** Per-satellite work item and its index-addressed output. */
+typedef struct {
+    const SimJob   *job;
+    sat_t          *sat;
+    GArray         *events;     /* sim_event_t */
+    GArray         *passes;     /* sim_pass_t */
+    GCancellable   *cancel;
+} SimSatTask;
+
+/** State functions used for event detection and bisection. */
+typedef gint    (*sim_state_func) (const SimJob * job, const sat_t * sat);
+
+
+void sim_params_init(sim_params_t * params, gdouble start)
+{
+    g_return_if_fail(params != NULL);
+
+    params->start = start;
+    params->duration = 1.0;
+    params->step_sec = 10.0;
+    params->territories = TRUE;
+    params->pois = TRUE;
+    params->target = -1;
+    params->rot_delta = 1.0;
+    params->rig_delta = 0.005;
+}
+
+const gchar    *sim_event_type_to_str(sim_event_type_t type)
+{
+    static const gchar *names[SIM_EVENT_NUM] = {
+        N_("AOS"),
+        N_("LOS"),
+        N_("Territory entry"),
+        N_("Territory exit"),
+        N_("POI"),
+        N_("Rotator"),
+        N_("Rig")
+    };
+
+    if (type >= SIM_EVENT_NUM)
+        return "";
+
+    return _(names[type]);
+}
+
+static gint state_visible(const SimJob * job, const sat_t * sat)
+{
+    (void)job;
+
+    return sat->el > 0.0 ? 1 : 0;
+}
+
+static gint state_territory(const SimJob * job, const sat_t * sat)
+{
+    gint            idx = sim_tile_table_lookup(job->terr, sat->ssplat,
+                                            sat->ssplon);
+
+    if (idx < 0 || (guint) idx >= job->terr_canon->len)
+        return -1;
+
+    return g_array_index(job->terr_canon, gint, idx);
+}
+
+static gint state_poi(const SimJob * job, const sat_t * sat)
+{
+    return sim_tile_table_lookup(job->poi, sat->ssplat, sat->ssplon);
+}
+
+/**
+ * Find the time where the state changes between t0 and t1.
+ *
+ * The state at t0 is s0 and differs from the state at t1. The function
+ * bisects until the interval is shorter than SIM_REFINE_TOL and returns
+ * the first time with a state different from s0. On return the satellite
+ * data correspond to the returned time.
+ */
+static gdouble sim_refine(const SimJob * job, sat_t * sat,
+                          sim_state_func state, gint s0,
+                          gdouble t0, gdouble t1)
+{
+    gdouble         tm;
+    qth_t          *qth = (qth_t *) & job->qth;
+
+    while (t1 - t0 > SIM_REFINE_TOL)
+    {
+        tm = 0.5 * (t0 + t1);
+        predict_calc(sat, qth, tm);
+        if (state(job, sat) == s0)
+            t0 = tm;
+        else
+            t1 = tm;
+    }
+    predict_calc(sat, qth, t1);
+
+    return t1;
+}
+
+/** Timeline order: (jd, catnr, type, index). */
+static gint sim_event_cmp(gconstpointer a, gconstpointer b)
+{
+    const sim_event_t *ea = a;
+    const sim_event_t *eb = b;
+
+    if (ea->jd < eb->jd)
+        return -1;
+    if (ea->jd > eb->jd)
+        return 1;
+    if (ea->catnr != eb->catnr)
+        return ea->catnr < eb->catnr ? -1 : 1;
+    if (ea->type != eb->type)
+        return (gint) ea->type - (gint) eb->type;
+
+    return ea->index - eb->index;
+}
+
+/**
+ * Move the events appended since @from into place.
+ *
+ * Events refined inside one step can be out of order with each other (and,
+ * when refined onto the step end, with the commands of the previous step),
+ * but never by more than a few entries, so an insertion pass keeps each
+ * satellite's list sorted at negligible cost.
+ */
+static void sim_events_settle(GArray * events, guint from)
+{
+    guint           i, j;
+
+    for (i = MAX(from, 1); i < events->len; i++)
+    {
+        sim_event_t     ev = g_array_index(events, sim_event_t, i);
+
+        for (j = i; j > 0 &&
+             sim_event_cmp(&g_array_index(events, sim_event_t, j - 1),
+                           &ev) > 0; j--)
+            g_array_index(events, sim_event_t, j) =
+                g_array_index(events, sim_event_t, j - 1);
+        g_array_index(events, sim_event_t, j) = ev;
+    }
+}
+
+static void sim_add_event(GArray * events, const sat_t * sat, gdouble t,
+                          sim_event_type_t type, gint index)
+{
+    sim_event_t     ev;
+
+    ev.jd = t;
+    ev.catnr = sat->tle.catnr;
+    ev.type = type;
+    ev.index = index;
+    ev.az = sat->az;
+    ev.el = sat->el;
+    ev.range_rate = sat->range_rate;
+    g_array_append_val(events, ev);
+}
+
+/** Propagate one satellite over the whole simulation interval. */
+static void sim_sat_worker(gpointer data, gpointer user_data)
+{
+    SimSatTask     *task = data;
+    const SimJob   *job = task->job;
+    const sim_params_t *p = &job->params;
+    sat_t          *sat = task->sat;
+    qth_t          *qth = (qth_t *) & job->qth;
+    gdouble         step = p->step_sec / 86400.0;
+    gdouble         end = p->start + p->duration;
+    gint64          nsteps, i;
+    gdouble         t, tprev, tc;
+    gint            vis, vis_prev;
+    gint            terr = -1, terr_prev = -1;
+    gint            poi = -1, poi_prev = -1;
+    gboolean        refined;
+    guint           mark;
+    gboolean        is_target = (sat->tle.catnr == p->target);
+    gdouble         last_az = 0.0, last_el = 0.0, last_rr = 0.0;
+    gboolean        have_cmd = FALSE;
+    sim_pass_t      pass = { 0.0, 0.0 };
+
+    (void)user_data;
+
+    nsteps = (gint64) ceil(p->duration * 86400.0 / p->step_sec);
+
+    predict_calc(sat, qth, p->start);
+    vis_prev = state_visible(job, sat);
+    if (p->territories)
+        terr_prev = state_territory(job, sat);
+    if (p->pois)
+        poi_prev = state_poi(job, sat);
+    tprev = p->start;
+
+    for (i = 1; i <= nsteps; i++)
+    {
+        if ((i % SIM_CANCEL_STRIDE) == 0 &&
+            g_cancellable_is_cancelled(task->cancel))
+            return;
+
+        /* index * step from the exact start avoids accumulating rounding */
+        t = MIN(p->start + (gdouble) i * step, end);
+        predict_calc(sat, qth, t);
+        vis = state_visible(job, sat);
+        if (p->territories)
+            terr = state_territory(job, sat);
+        if (p->pois)
+            poi = state_poi(job, sat);
+        refined = FALSE;
+        mark = task->events->len;
+
+        if (vis != vis_prev)
+        {
+            tc = sim_refine(job, sat, state_visible, vis_prev, tprev, t);
+            refined = TRUE;
+            if (vis)
+            {
+                sim_add_event(task->events, sat, tc, SIM_EVENT_AOS, -1);
+                pass.aos = tc;
+                have_cmd = FALSE;
+            }
+            else
+            {
+                sim_add_event(task->events, sat, tc, SIM_EVENT_LOS, -1);
+                pass.los = tc;
+                g_array_append_val(task->passes, pass);
+                pass.aos = pass.los = 0.0;
+            }
+        }
+
+        if (p->territories && terr != terr_prev)
+        {
+            tc = sim_refine(job, sat, state_territory, terr_prev, tprev, t);
+            refined = TRUE;
+            if (terr_prev >= 0)
+                sim_add_event(task->events, sat, tc,
+                              SIM_EVENT_TERRITORY_EXIT, terr_prev);
+            if (terr >= 0)
+                sim_add_event(task->events, sat, tc,
+                              SIM_EVENT_TERRITORY_ENTRY, terr);
+        }
+
+        if (p->pois && poi != poi_prev && poi >= 0)
+        {
+            tc = sim_refine(job, sat, state_poi, poi_prev, tprev, t);
+            refined = TRUE;
+            sim_add_event(task->events, sat, tc, SIM_EVENT_POI_ENTRY, poi);
+        }
+
+        if (refined)
+            predict_calc(sat, qth, t);
+
+        /* commands that a rotator/rig controller would send */
+        if (is_target && vis)
+        {
+            gdouble         daz = fabs(sat->az - last_az);
+
+            if (daz > 180.0)
+                daz = 360.0 - daz;
+
+            if (!have_cmd || daz >= p->rot_delta ||
+                fabs(sat->el - last_el) >= p->rot_delta)
+            {
+                sim_add_event(task->events, sat, t, SIM_EVENT_ROT_CMD, -1);
+                last_az = sat->az;
+                last_el = sat->el;
+            }
+            if (!have_cmd || fabs(sat->range_rate - last_rr) >= p->rig_delta)
+            {
+                sim_add_event(task->events, sat, t, SIM_EVENT_RIG_CMD, -1);
+                last_rr = sat->range_rate;
+            }
+            have_cmd = TRUE;
+        }
+
+        if (task->events->len > mark)
+            sim_events_settle(task->events, mark);
+
+        vis_prev = vis;
+        terr_prev = terr;
+        poi_prev = poi;
+        tprev = t;
+    }
+
+    /* satellite still up at the end of the interval */
+    if (vis_prev)
+    {
+        pass.los = 0.0;
+        g_array_append_val(task->passes, pass);
+    }
+}
+
+static void sim_job_free(gpointer data)
+{
+    SimJob         *job = data;
+    guint           i;
+
+    if (job == NULL)
+        return;
+
+    for (i = 0; i < job->sats->len; i++)
+    {
+        sat_t          *sat = g_ptr_array_index(job->sats, i);
+
+        gtk_sat_data_free_sat(sat);
+    }
+    g_ptr_array_free(job->sats, TRUE);
+    sim_tile_table_free(job->terr);
+    if (job->terr_canon)
+        g_array_unref(job->terr_canon);
+    sim_tile_table_free(job->poi);
+    g_free(job);
+}
+
+/**
+ * Snapshot everything the workers need.
+ *
+ * Must be called from the main loop: it copies the module satellites and
+ * the territory/POI tables so that the workers never touch shared state.
+ */
+static SimJob  *sim_job_new(GHashTable * sats, qth_t * qth,
+                            const sim_params_t * params)
+{
+    SimJob         *job = g_new0(SimJob, 1);
+    GHashTableIter  iter;
+    gpointer        value;
+    GHashTable     *canon;
+    guint           i;
+
+    job->params = *params;
+    job->qth.lat = qth->lat;
+    job->qth.lon = qth->lon;
+    job->qth.alt = qth->alt;
+
+    job->sats = g_ptr_array_sized_new(sats ? g_hash_table_size(sats) : 0);
+    if (sats != NULL)
+    {
+        g_hash_table_iter_init(&iter, sats);
+        while (g_hash_table_iter_next(&iter, NULL, &value))
+        {
+            sat_t          *copy = g_new0(sat_t, 1);
+
+            gtk_sat_data_copy_sat(SAT(value), copy, &job->qth);
+            g_ptr_array_add(job->sats, copy);
+        }
+    }
+
+    /* territories: map each tile to the first tile of the same territory */
+    if (params->territories)
+    {
+        job->terr = sim_tile_table_new_territories();
+        job->terr_canon = g_array_new(FALSE, FALSE, sizeof(gint));
+        canon = g_hash_table_new(g_str_hash, g_str_equal);
+        for (i = 0; i < job->terr->names->len; i++)
+        {
+            gchar          *name = g_ptr_array_index(job->terr->names, i);
+            gpointer        first;
+            gint            first_idx;
+
+            if (!g_hash_table_lookup_extended(canon, name, NULL, &first))
+            {
+                first = GINT_TO_POINTER(i);
+                g_hash_table_insert(canon, name, first);
+            }
+            first_idx = GPOINTER_TO_INT(first);
+            g_array_append_val(job->terr_canon, first_idx);
+        }
+        g_hash_table_destroy(canon);
+    }
+
+    /* POI tiles */
+    if (params->pois)
+        job->poi = sim_tile_table_new_pois();
+
+    return job;
+}
+
+/** Head event of task @k during the merge. */
+#define SIM_HEAD(tasks, pos, k) \
+    (&g_array_index((tasks)[k].events, sim_event_t, (pos)[k]))
+
+/** Heap order on the task heads; ties go to the lower task index. */
+static gboolean sim_head_less(const SimSatTask * tasks, const guint * pos,
+                              guint a, guint b)
+{
+    gint            c = sim_event_cmp(SIM_HEAD(tasks, pos, a),
+                                      SIM_HEAD(tasks, pos, b));
+
+    return c < 0 || (c == 0 && a < b);
+}
+
+static void sim_heap_down(const SimSatTask * tasks, const guint * pos,
+                          guint * heap, guint n, guint i)
+{
+    for (;;)
+    {
+        guint           l = 2 * i + 1, r = l + 1, m = i, tmp;
+
+        if (l < n && sim_head_less(tasks, pos, heap[l], heap[m]))
+            m = l;
+        if (r < n && sim_head_less(tasks, pos, heap[r], heap[m]))
+            m = r;
+        if (m == i)
+            return;
+        tmp = heap[i];
+        heap[i] = heap[m];
+        heap[m] = tmp;
+        i = m;
+    }
+}
+
+/**
+ * K-way merge of the per-satellite event lists.
+ *
+ * Each list is already in timeline order, so the merged timeline is the same
+ * whatever the thread count or completion order, without sorting it again.
+ */
+static GArray  *sim_merge_events(const SimSatTask * tasks, guint ntasks)
+{
+    GArray         *out;
+    guint          *heap = g_new(guint, MAX(ntasks, 1));
+    guint          *pos = g_new0(guint, MAX(ntasks, 1));
+    guint           n = 0, total = 0, k;
+
+    for (k = 0; k < ntasks; k++)
+    {
+        total += tasks[k].events->len;
+        if (tasks[k].events->len > 0)
+            heap[n++] = k;
+    }
+    out = g_array_sized_new(FALSE, FALSE, sizeof(sim_event_t), total);
+
+    for (k = n / 2; k-- > 0;)
+        sim_heap_down(tasks, pos, heap, n, k);
+
+    while (n > 0)
+    {
+        guint           top = heap[0];
+
+        g_array_append_vals(out, SIM_HEAD(tasks, pos, top), 1);
+        if (++pos[top] >= tasks[top].events->len)
+            heap[0] = heap[--n];
+        sim_heap_down(tasks, pos, heap, n, 0);
+    }
+
+    g_free(heap);
+    g_free(pos);
+
+    return out;
+}
+
+static sim_timeline_t *sim_job_execute(SimJob * job, GCancellable * cancel)
+{
+    sim_timeline_t *tl;
+    SimSatTask     *tasks;
+    GThreadPool    *pool;
+    guint           nthreads;
+    guint           i;
+
+    tasks = g_new0(SimSatTask, job->sats->len);
+    nthreads = CLAMP((guint) g_get_num_processors(), 1, 8);
+    pool = g_thread_pool_new(sim_sat_worker, NULL, (gint) nthreads, FALSE,
+                             NULL);
+    for (i = 0; i < job->sats->len; i++)
+    {
+        tasks[i].job = job;
+        tasks[i].sat = g_ptr_array_index(job->sats, i);
+        tasks[i].events = g_array_new(FALSE, FALSE, sizeof(sim_event_t));
+        tasks[i].passes = g_array_new(FALSE, FALSE, sizeof(sim_pass_t));
+        tasks[i].cancel = cancel;
+        g_thread_pool_push(pool, &tasks[i], NULL);
+    }
+    g_thread_pool_free(pool, FALSE, TRUE);      /* wait for completion */
+
+    tl = g_new0(sim_timeline_t, 1);
+    tl->start = job->params.start;
+    tl->end = job->params.start + job->params.duration;
+    tl->qth.lat = job->qth.lat;
+    tl->qth.lon = job->qth.lon;
+    tl->qth.alt = job->qth.alt;
+    tl->events = sim_merge_events(tasks, job->sats->len);
+    tl->passes = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL,
+                                       (GDestroyNotify) g_array_unref);
+    tl->territories = job->terr ? g_ptr_array_ref(job->terr->names) :
+        g_ptr_array_new_with_free_func(g_free);
+    tl->pois = job->poi ? g_ptr_array_ref(job->poi->names) :
+        g_ptr_array_new_with_free_func(g_free);
+
+    for (i = 0; i < job->sats->len; i++)
+    {
+        g_array_unref(tasks[i].events);
+        g_hash_table_insert(tl->passes,
+                            GINT_TO_POINTER(tasks[i].sat->tle.catnr),
+                            tasks[i].passes);
+    }
+    g_free(tasks);
+
+    return tl;
+}
+
+static gboolean sim_params_valid(const sim_params_t * params, GError ** error)
+{
+    if (params->duration <= 0.0 || params->step_sec <= 0.0)
+    {
+        g_set_error(error, G_IO_ERROR, G_IO_ERROR_INVALID_ARGUMENT,
+                    _("Invalid simulation interval (%.3f days, %.1f s step)"),
+                    params->duration, params->step_sec);
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+/**
+ * Run a simulation synchronously.
+ *
+ * @param sats The module satellites (catnr -> sat_t*); they are not modified.
+ * @param qth The observer.
+ * @param params Simulation parameters.
+ * @param cancel Optional cancellable.
+ * @param error Location for a GError or NULL.
+ * @return A new timeline or NULL on error/cancellation.
+ *
+ * Must be called from the main loop (see sim_engine_run_async() for the
+ * background variant).
+ */
+sim_timeline_t *sim_engine_run(GHashTable * sats, qth_t * qth,
+                               const sim_params_t * params,
+                               GCancellable * cancel, GError ** error)
+{
+    SimJob         *job;
+    sim_timeline_t *tl;
+
+    g_return_val_if_fail(qth != NULL && params != NULL, NULL);
+
+    if (!sim_params_valid(params, error))
+        return NULL;
+
+    job = sim_job_new(sats, qth, params);
+    tl = sim_job_execute(job, cancel);
+    sim_job_free(job);
+
+    if (g_cancellable_set_error_if_cancelled(cancel, error))
+    {
+        sim_timeline_free(tl);
+        return NULL;
+    }
+
+    return tl;
+}
+
+static void sim_task_thread(GTask * task, gpointer source_object,
+                            gpointer task_data, GCancellable * cancel)
+{
+    sim_timeline_t *tl;
+
+    (void)source_object;
+
+    tl = sim_job_execute(task_data, cancel);
+    if (g_task_return_error_if_cancelled(task))
+    {
+        sim_timeline_free(tl);
+        return;
+    }
+
+    g_task_return_pointer(task, tl, (GDestroyNotify) sim_timeline_free);
+}
+
+/**
+ * Run a simulation in a worker thread.
+ *
+ * The satellites and territory/POI tables are copied before this function
+ * returns, so the caller may keep using and modifying them.
+ */
+void sim_engine_run_async(GHashTable * sats, qth_t * qth,
+                          const sim_params_t * params,
+                          GCancellable * cancel,
+                          GAsyncReadyCallback callback, gpointer user_data)
+{
+    GTask          *task;
+    GError         *error = NULL;
+
+    g_return_if_fail(qth != NULL && params != NULL);
+
+    task = g_task_new(NULL, cancel, callback, user_data);
+    g_task_set_source_tag(task, sim_engine_run_async);
+
+    if (!sim_params_valid(params, &error))
+    {
+        g_task_return_error(task, error);
+        g_object_unref(task);
+        return;
+    }
+
+    g_task_set_task_data(task, sim_job_new(sats, qth, params), sim_job_free);
+    g_task_run_in_thread(task, sim_task_thread);
+    g_object_unref(task);
+}
+
+sim_timeline_t *sim_engine_run_finish(GAsyncResult * res, GError ** error)
+{
+    g_return_val_if_fail(g_task_is_valid(res, NULL), NULL);
+
+    return g_task_propagate_pointer(G_TASK(res), error);
+}
+
+void sim_timeline_free(sim_timeline_t * tl)
+{
+    if (tl == NULL)
+        return;
+
+    g_array_unref(tl->events);
+    g_hash_table_destroy(tl->passes);
+    if (tl->territories)
+        g_ptr_array_unref(tl->territories);
+    if (tl->pois)
+        g_ptr_array_unref(tl->pois);
+    g_free(tl);
+}
+
+/**
+ * Check whether the timeline is valid for time t and the given observer.
+ *
+ * The timeline is discarded by the module when the observer has moved more
+ * than 1 km, just like the regular AOS/LOS update. It is computed for the
+ * fixed ground station, so it does not apply while a planned route does.
+ */
+gboolean sim_timeline_covers(const sim_timeline_t * tl, qth_t * qth,
+                             gdouble t)
+{
+    if (tl == NULL || t < tl->start || t > tl->end)
+        return FALSE;
+
+    if (qth->route != NULL && qth_route_covers(qth->route, t))
+        return FALSE;
+
+    return qth_small_dist(qth, tl->qth) <= 1.0;
+}
+
+/**
+ * Look up the next AOS and LOS of a satellite.
+ *
+ * @return TRUE if both the next AOS and the next LOS after t lie inside the
+ *         timeline; the caller should fall back to find_aos()/find_los()
+ *         otherwise.
+ */
+gboolean sim_timeline_get_events(const sim_timeline_t * tl, gint catnr,
+                                 gdouble t, gdouble * aos, gdouble * los)
+{
+    GArray         *passes;
+    sim_pass_t     *p;
+    guint           lo, hi, mid;
+
+    passes = g_hash_table_lookup(tl->passes, GINT_TO_POINTER(catnr));
+    if (passes == NULL)
+        return FALSE;
+
+    /* first pass that is not over yet */
+    lo = 0;
+    hi = passes->len;
+    while (lo < hi)
+    {
+        mid = (lo + hi) / 2;
+        p = &g_array_index(passes, sim_pass_t, mid);
+        if (p->los > 0.0 && p->los < t)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    if (lo >= passes->len)
+        return FALSE;
+
+    p = &g_array_index(passes, sim_pass_t, lo);
+    if (p->los == 0.0)
+        return FALSE;
+
+    *los = p->los;
+    if (p->aos > t)
+    {
+        *aos = p->aos;
+        return TRUE;
+    }
+
+    /* in range: the next AOS belongs to the following pass */
+    if (lo + 1 >= passes->len)
+        return FALSE;
+
+    *aos = g_array_index(passes, sim_pass_t, lo + 1).aos;
+
+    return TRUE;
+}
+
+/**
+ * Replay the events in (from, to].
+ *
+ * @return The number of events passed to func.
+ *
+ * Nothing is replayed when time runs backwards; the replay position is
+ * simply moved so that the next forward step continues from there.
+ */
+guint sim_timeline_replay(sim_timeline_t * tl, gdouble from, gdouble to,
+                          sim_event_func func, gpointer data)
+{
+    const sim_event_t *ev = (const sim_event_t *)tl->events->data;
+    guint           n = tl->events->len;
+    guint           lo, hi, mid;
+    guint           count = 0;
+
+    /* reuse the cursor for the common case of consecutive ticks */
+    if (!((tl->cursor == 0 || ev[tl->cursor - 1].jd <= from) &&
+          (tl->cursor == n || ev[tl->cursor].jd > from)))
+    {
+        lo = 0;
+        hi = n;
+        while (lo < hi)
+        {
+            mid = (lo + hi) / 2;
+            if (ev[mid].jd <= from)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        tl->cursor = lo;
+    }
+
+    while (tl->cursor < n && ev[tl->cursor].jd <= to)
+    {
+        if (func != NULL)
+            func(tl, &ev[tl->cursor], data);
+        tl->cursor++;
+        count++;
+    }
+
+    return count;
+}
+
+static guint tile_row(gdouble lat)
+{
+    gint            row = (gint) floor((lat + 90.0) / SIM_TILE_CELL);
+
+    return (guint) CLAMP(row, 0, SIM_TILE_ROWS - 1);
+}
+
+static guint tile_col(gdouble lon)
+{
+    gint            col;
+
+    lon = fmod(lon + 180.0, 360.0);
+    if (lon < 0.0)
+        lon += 360.0;
+    col = (gint) floor(lon / SIM_TILE_CELL);
+
+    return (guint) CLAMP(col, 0, SIM_TILE_COLS - 1);
+}
+
+static void tile_grid_add(sim_tile_table_t * table, guint row, guint c0,
+                         guint c1, guint idx)
+{
+    guint           c;
+
+    for (c = c0; c <= c1; c++)
+    {
+        GArray        **cell = &table->cells[row * SIM_TILE_COLS + c];
+
+        if (*cell == NULL)
+            *cell = g_array_new(FALSE, FALSE, sizeof(guint));
+        g_array_append_val(*cell, idx);
+    }
+}
+
+/**
+ * Index every tile in the grid cells its bounding box overlaps.
+ *
+ * Tiles are added in index order, so the first hit in a cell is the lowest
+ * matching tile index, as with a scan over all tiles.
+ */
+static void tile_grid_build(sim_tile_table_t * table)
+{
+    guint           i, row;
+
+    table->cells = g_new0(GArray *, SIM_TILE_ROWS * SIM_TILE_COLS);
+
+    for (i = 0; i < table->rects->len; i++)
+    {
+        const SimRect  *r = &g_array_index(table->rects, SimRect, i);
+        guint           c0 = tile_col(r->lon_min);
+        guint           c1 = tile_col(r->lon_max);
+
+        if (r->lat_min > r->lat_max)
+            continue;           /* empty polygon */
+
+        for (row = tile_row(r->lat_min); row <= tile_row(r->lat_max); row++)
+        {
+            if (r->lon_max - r->lon_min >= 360.0)
+            {
+                tile_grid_add(table, row, 0, SIM_TILE_COLS - 1, i);
+            }
+            else if (r->lon_min <= r->lon_max && c0 <= c1)
+            {
+                tile_grid_add(table, row, c0, c1, i);
+            }
+            else
+            {
+                /* tile spans the anti-meridian */
+                tile_grid_add(table, row, c0, SIM_TILE_COLS - 1, i);
+                tile_grid_add(table, row, 0, c1, i);
+            }
+        }
+    }
+}
+
+static sim_tile_table_t *tile_table_new(void)
+{
+    sim_tile_table_t *table = g_new0(sim_tile_table_t, 1);
+
+    table->rects = g_array_new(FALSE, FALSE, sizeof(SimRect));
+    table->names = g_ptr_array_new_with_free_func(g_free);
+
+    return table;
+}
+
+/** Append the bounding box of a polygon of {lat, lon} points. */
+static void tile_table_add_poly(sim_tile_table_t * table, const GArray * poly)
+{
+    SimRect         r = { 90.0, -90.0, 180.0, -180.0 };
+    guint           k;
+
+    for (k = 0; k < poly->len; k++)
+    {
+        const GeoPoint *pt = &g_array_index(poly, GeoPoint, k);
+
+        r.lat_min = MIN(r.lat_min, pt->lat);
+        r.lat_max = MAX(r.lat_max, pt->lat);
+        r.lon_min = MIN(r.lon_min, pt->lon);
+        r.lon_max = MAX(r.lon_max, pt->lon);
+    }
+    g_array_append_val(table->rects, r);
+}
+
+/**
+ * Snapshot the POI tiles.
+ *
+ * Must be called from the main loop; loads POI_CSV_FILE if the POI filter
+ * has not been initialised yet. Each tile is reduced to its bounding box.
+ */
+sim_tile_table_t *sim_tile_table_new_pois(void)
+{
+    sim_tile_table_t *table = tile_table_new();
+    GPtrArray      *names;
+    GError         *err = NULL;
+    GList          *l;
+    guint           i;
+
+    if (lp_get_all_polygons() == NULL && !lp_init(POI_CSV_FILE, &err))
+    {
+        sat_log_log(SAT_LOG_LEVEL_WARN,
+                    _("%s: POI tiles not available (%s)"), __func__,
+                    err ? err->message : POI_CSV_FILE);
+        g_clear_error(&err);
+    }
+
+    /* LP_GeoPoint and GeoPoint are both {lat, lon} */
+    for (l = lp_get_all_polygons(); l != NULL; l = l->next)
+        tile_table_add_poly(table, l->data);
+
+    names = points_interest_get_names();
+    for (i = 0; names != NULL && i < names->len; i++)
+        g_ptr_array_add(table->names, g_strdup(g_ptr_array_index(names, i)));
+
+    tile_grid_build(table);
+
+    return table;
+}
+
+/**
+ * Snapshot the territory tiles.
+ *
+ * Must be called from the main loop. The tiles are those loaded by
+ * tool_init() at startup, indexed like tool_get_all_countries(); the table
+ * is empty when they are not loaded.
+ */
+sim_tile_table_t *sim_tile_table_new_territories(void)
+{
+    sim_tile_table_t *table = tile_table_new();
+    GList          *l, *n;
+
+    for (l = tool_get_all_polygons(), n = tool_get_all_countries();
+         l != NULL && n != NULL; l = l->next, n = n->next)
+    {
+        tile_table_add_poly(table, l->data);
+        g_ptr_array_add(table->names, g_strdup(n->data));
+    }
+
+    tile_grid_build(table);
+
+    return table;
+}
+
+void sim_tile_table_free(sim_tile_table_t * table)
+{
+    if (table == NULL)
+        return;
+
+    if (table->cells != NULL)
+    {
+        guint           i;
+
+        for (i = 0; i < SIM_TILE_ROWS * SIM_TILE_COLS; i++)
+            if (table->cells[i] != NULL)
+                g_array_unref(table->cells[i]);
+        g_free(table->cells);
+    }
+    g_array_unref(table->rects);
+    g_ptr_array_unref(table->names);
+    g_free(table);
+}
+
+/**
+ * Find the tile containing a point.
+ *
+ * @return The tile index or -1. NULL-safe.
+ */
+gint sim_tile_table_lookup(const sim_tile_table_t * table, gdouble lat,
+                           gdouble lon)
+{
+    const GArray   *cell;
+    guint           i;
+
+    if (table == NULL || table->cells == NULL)
+        return -1;
+
+    cell = table->cells[tile_row(lat) * SIM_TILE_COLS + tile_col(lon)];
+    for (i = 0; cell != NULL && i < cell->len; i++)
+    {
+        guint           idx = g_array_index(cell, guint, i);
+        const SimRect  *r = &g_array_index(table->rects, SimRect, idx);
+
+        if (lat < r->lat_min || lat > r->lat_max)
+            continue;
+
+        if (r->lon_min <= r->lon_max)
+        {
+            if (lon >= r->lon_min && lon <= r->lon_max)
+                return (gint) idx;
+        }
+        else if (lon >= r->lon_min || lon <= r->lon_max)
+        {
+            /* tile spans the anti-meridian */
+            return (gint) idx;
+        }
+    }
+
+    return -1;
+}
@@ -0,0 +1,135 @@
+/*
+  OGpredict — extensions to Gpredict for operations planning
+
+  Copyright (C) 2025 Axel Osika <osikaaxel@gmail.com>
+
+  This file is part of OGpredict, a derivative of Gpredict.
+
+  OGpredict is free software: you can redistribute it and/or modify it
+  under the terms of the GNU General Public License as published by the
+  Free Software Foundation; either version 2 of the License, or (at your
+  option) any later version.  See the GNU General Public License for details.
+*/
+
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#ifndef __SIM_ENGINE_H__
+#define __SIM_ENGINE_H__ 1
+
+#include <gio/gio.h>
+#include <glib.h>
+
+#include "qth-data.h"
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/** Event kinds recorded in a simulation timeline. */
+typedef enum {
+    SIM_EVENT_AOS = 0,          /*!< Satellite rises above the horizon */
+    SIM_EVENT_LOS,              /*!< Satellite sets below the horizon */
+    SIM_EVENT_TERRITORY_ENTRY,  /*!< Sub-satellite point enters a territory */
+    SIM_EVENT_TERRITORY_EXIT,   /*!< Sub-satellite point leaves a territory */
+    SIM_EVENT_POI_ENTRY,        /*!< Sub-satellite point enters a POI tile */
+    SIM_EVENT_ROT_CMD,          /*!< Rotator command for the target satellite */
+    SIM_EVENT_RIG_CMD,          /*!< Doppler (rig) command for the target satellite */
+    SIM_EVENT_NUM
+} sim_event_type_t;
+
+/** One timeline entry. */
+typedef struct {
+    gdouble         jd;         /*!< Event time (Julian date, UTC) */
+    gint            catnr;      /*!< Catalogue number of the satellite */
+    sim_event_type_t type;      /*!< Event kind */
+    gint            index;      /*!< Territory / POI tile index or -1 */
+    gdouble         az;         /*!< Azimuth [deg] at the event */
+    gdouble         el;         /*!< Elevation [deg] at the event */
+    gdouble         range_rate; /*!< Range rate [km/s] at the event */
+} sim_event_t;
+
+/** One visibility window of a satellite (AOS/LOS pair). */
+typedef struct {
+    gdouble         aos;        /*!< AOS time or 0.0 if up at start */
+    gdouble         los;        /*!< LOS time or 0.0 if up at end */
+} sim_pass_t;
+
+/** Simulation parameters. */
+typedef struct {
+    gdouble         start;      /*!< Start time (Julian date) */
+    gdouble         duration;   /*!< Duration in days */
+    gdouble         step_sec;   /*!< Propagation step in seconds */
+    gboolean        territories;        /*!< Record territory entry/exit */
+    gboolean        pois;       /*!< Record POI tile entries */
+    gint            target;     /*!< Catnr for rot/rig commands; -1 = none */
+    gdouble         rot_delta;  /*!< Min. az/el change [deg] between rot commands */
+    gdouble         rig_delta;  /*!< Min. range rate change [km/s] between rig commands */
+} sim_params_t;
+
+/** Result of a simulation run, ordered by event time. */
+typedef struct {
+    gdouble         start;      /*!< First simulated time */
+    gdouble         end;        /*!< Last simulated time */
+    qth_small_t     qth;        /*!< Observer the timeline was computed for */
+    GArray         *events;     /*!< sim_event_t, sorted by (jd, catnr, type, index) */
+    GHashTable     *passes;     /*!< catnr -> GArray of sim_pass_t, sorted */
+    GPtrArray      *territories;        /*!< Territory names, by tile index */
+    GPtrArray      *pois;       /*!< POI names, by tile index */
+    guint           cursor;     /*!< Replay position in events */
+} sim_timeline_t;
+
+/**
+ * Thread-safe snapshot of the POI or territory tile bounds.
+ *
+ * Built on the main loop from the Logic_POI_Filter or Logic_Country_Filter
+ * tiles and read-only afterwards, so worker threads can classify
+ * sub-satellite points without touching the filters.
+ */
+typedef struct {
+    GArray         *rects;      /*!< Tile bounds by tile index */
+    GPtrArray      *names;      /*!< POI / territory names by tile index */
+    GArray        **cells;      /*!< Lat/lon grid of candidate tile indexes */
+} sim_tile_table_t;
+
+/** Callback used by sim_timeline_replay(). */
+typedef void    (*sim_event_func) (const sim_timeline_t * tl,
+                                   const sim_event_t * ev, gpointer data);
+
+void            sim_params_init(sim_params_t * params, gdouble start);
+
+sim_timeline_t *sim_engine_run(GHashTable * sats, qth_t * qth,
+                               const sim_params_t * params,
+                               GCancellable * cancel, GError ** error);
+void            sim_engine_run_async(GHashTable * sats, qth_t * qth,
+                                     const sim_params_t * params,
+                                     GCancellable * cancel,
+                                     GAsyncReadyCallback callback,
+                                     gpointer user_data);
+sim_timeline_t *sim_engine_run_finish(GAsyncResult * res, GError ** error);
+
+void            sim_timeline_free(sim_timeline_t * tl);
+gboolean        sim_timeline_covers(const sim_timeline_t * tl, qth_t * qth,
+                                    gdouble t);
+gboolean        sim_timeline_get_events(const sim_timeline_t * tl, gint catnr,
+                                        gdouble t, gdouble * aos,
+                                        gdouble * los);
+guint           sim_timeline_replay(sim_timeline_t * tl, gdouble from,
+                                    gdouble to, sim_event_func func,
+                                    gpointer data);
+const gchar    *sim_event_type_to_str(sim_event_type_t type);
+
+sim_tile_table_t *sim_tile_table_new_pois(void);
+sim_tile_table_t *sim_tile_table_new_territories(void);
+void            sim_tile_table_free(sim_tile_table_t * table);
+gint            sim_tile_table_lookup(const sim_tile_table_t * table,
+                                      gdouble lat, gdouble lon);
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+}
+#endif
+/* *INDENT-ON* */
+
+#endif
@@ -18,7 +18,6 @@
 /* src/sub_window_ephemeris.c */
 #include "sub_window_ephemeris.h"
 #include <time.h>
-#include <string.h> /* strpbrk */
 
 static void set_default_name(GtkFileChooser *fc, SubwinFormat fmt) {
      /* poi_YYYYMMDD_HHMMSS.ext */
@@ -86,22 +85,46 @@ void sub_window_ephemeris_spec_free(SubwinSaveSpec *spec) {
  }
 
 /* ---- CSV/TXT export --------------------------------------------------- */
-static gchar *csv_escape(const gchar *s) {
-    if (!s) return g_strdup("");
-    if (!strpbrk(s, ",\"\n\r")) return g_strdup(s);
-    GString *g = g_string_new("\"");
-    for (const char *p = s; *p; ++p) {
-        if (*p == '"') g_string_append_c(g, '"'); /* double quotes */
-        g_string_append_c(g, *p);
-    }
-    g_string_append_c(g, '"');
-    return g_string_free(g, FALSE);
+typedef struct {
+    GtkTreeModel     *m;
+    const POIColumns *c;
+    GtkTreeIter       it;
+    gboolean          ok;
+    gchar            *time, *name, *type, *sat;
+} ModelRows;
+
+static void model_rows_clear(ModelRows *mr) {
+    g_clear_pointer(&mr->time, g_free);
+    g_clear_pointer(&mr->name, g_free);
+    g_clear_pointer(&mr->type, g_free);
+    g_clear_pointer(&mr->sat, g_free);
 }
 
-static gchar *ensure_ext(const gchar *path, gboolean is_csv) {
-    if (!path) return NULL;
-    if (g_str_has_suffix(path, is_csv ? ".csv" : ".txt")) return g_strdup(path);
-    return g_strconcat(path, is_csv ? ".csv" : ".txt", NULL);
+/* Row producer for poi_export_write() walking the tree model */
+static gboolean model_rows_next(PoiExportRow *row, gpointer data) {
+    ModelRows *mr = data;
+    const POIColumns *c = mr->c;
+
+    model_rows_clear(mr);
+    if (!mr->ok) return FALSE;
+
+    gtk_tree_model_get(mr->m, &mr->it,
+        c->col_time,  &mr->time,
+        c->col_lat,   &row->lat,
+        c->col_lon,   &row->lon,
+        c->col_range, &row->range,
+        c->col_dir,   &row->bearing,
+        c->col_name,  &mr->name,
+        c->col_type,  &mr->type,
+        c->col_sat,   &mr->sat,
+        -1);
+    row->time = mr->time;
+    row->name = mr->name;
+    row->type = mr->type;
+    row->sat  = mr->sat;
+
+    mr->ok = gtk_tree_model_iter_next(mr->m, &mr->it);
+    return TRUE;
 }
 
 gboolean sub_window_ephemeris_export_poi(GtkTreeView *tv,
@@ -116,58 +139,11 @@ gboolean sub_window_ephemeris_export_poi(GtkTreeView *tv,
         return FALSE;
     }
 
-    gboolean csv = (spec->format == SUBWIN_FORMAT_CSV);
-    GString *out = g_string_new(NULL);
-    /* Excel hint: BOM makes it detect UTF-8, avoiding 'Â°' */
-    if (csv) g_string_append(out, "\xEF\xBB\xBF");
-
-    if (csv) {
-        g_string_append(out, "Time,Latitude,Longitude,Range_km,Direction,Name,Type\n");
-    } else {
-        g_string_append(out, "Time\tLatitude\tLongitude\tRange (km)\tDirection\tName\tType\n");
-    }
-
-    GtkTreeIter it;
-    gboolean ok = gtk_tree_model_get_iter_first(m, &it);
-    while (ok) {
-        gchar *time = NULL, *dir = NULL, *name = NULL, *type = NULL;
-        gdouble lat = 0, lon = 0, range = 0;
-        gtk_tree_model_get(m, &it,
-            c->col_time,  &time,
-            c->col_lat,   &lat,
-            c->col_lon,   &lon,
-            c->col_range, &range,
-            c->col_dir,   &dir,
-            c->col_name,  &name,
-            c->col_type,  &type,
-            -1);
-
-        char slat[32], slon[32], srange[32];
-        g_ascii_formatd(slat,  sizeof(slat),  "%.5f", lat);
-        g_ascii_formatd(slon,  sizeof(slon),  "%.5f", lon);
-        g_ascii_formatd(srange,sizeof(srange),"%.3f", range);
-
-        if (csv) {
-            gchar *qtime = csv_escape(time);
-            gchar *qdir  = csv_escape(dir);
-            gchar *qname = csv_escape(name);
-            gchar *qtype = csv_escape(type);
-            g_string_append_printf(out, "%s,%s,%s,%s,%s,%s,%s\n",
-                qtime, slat, slon, srange, qdir, qname, qtype);
-            g_free(qtime); g_free(qdir); g_free(qname); g_free(qtype);
-        } else {
-            g_string_append_printf(out, "%s\t%s\t%s\t%s\t%s\t%s\t%s\n",
-                time ? time : "", slat, slon, srange,
-                dir ? dir : "", name ? name : "", type ? type : "");
-        }
-
-        g_free(time); g_free(dir); g_free(name); g_free(type);
-        ok = gtk_tree_model_iter_next(m, &it);
-    }
+    ModelRows mr = { .m = m, .c = c };
+    mr.ok = gtk_tree_model_get_iter_first(m, &mr.it);
 
-    gchar *final_path = ensure_ext(spec->filepath, csv);
-    gboolean wrote = g_file_set_contents(final_path, out->str, out->len, err);
-    g_free(final_path);
-    g_string_free(out, TRUE);
+    gboolean wrote = poi_export_write(spec->filepath, spec->format,
+                                      model_rows_next, &mr, err);
+    model_rows_clear(&mr);
     return wrote;
 }
@@ -19,11 +19,7 @@
 /* src/sub_window_ephemeris.h */
 #pragma once
 #include <gtk/gtk.h>
-
-typedef enum {
-     SUBWIN_FORMAT_CSV,
-     SUBWIN_FORMAT_TXT
-} SubwinFormat;
+#include "poi-export.h"
 
 typedef struct {
      gchar         *filepath;  /* absolute path the user picked */
@@ -36,9 +32,10 @@ typedef struct {
      gint col_lat;
      gint col_lon;
      gint col_range;
-     gint col_dir;
+     gint col_dir;    /* G_TYPE_DOUBLE bearing in degrees */
      gint col_name;
      gint col_type;
+     gint col_sat;    /* satellite name */
 } POIColumns;
 
 /* Opens a native Save dialog. Returns TRUE if user confirmed, FALSE otherwise. */
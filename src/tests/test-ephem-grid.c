@@ -0,0 +1,180 @@
+/*
+  OGpredict — extensions to Gpredict for operations planning
+
+  Copyright (C) 2025 Axel Osika <osikaaxel@gmail.com>
+
+  This file is part of OGpredict, a derivative of Gpredict.
+
+  OGpredict is free software: you can redistribute it and/or modify it
+  under the terms of the GNU General Public License as published by the
+  Free Software Foundation; either version 2 of the License, or (at your
+  option) any later version.  See the GNU General Public License for details.
+*/
+
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/**
+ * test-ephem-grid.c — ephemeris time grid and block streams
+ *
+ * Links only libogpredict-core, so it also checks that the core builds and
+ * links without GTK.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <build-config.h>
+#endif
+
+#include <glib.h>
+#include <math.h>
+
+#include "ephem-pipe.h"
+
+/* 2025-01-01 00:00:00 UTC */
+#define JD_2025 2460676.5
+
+static void test_grid_format(void)
+{
+    ephem_grid_t    grid;
+    gchar           buf[32];
+
+    ephem_grid_init(&grid, JD_2025, G_GINT64_CONSTANT(1000000000));
+    ephem_grid_format(&grid, 0, buf, sizeof(buf));
+    g_assert_cmpstr(buf, ==, "2025/01/01 00:00:00");
+    ephem_grid_format(&grid, 86399, buf, sizeof(buf));
+    g_assert_cmpstr(buf, ==, "2025/01/01 23:59:59");
+    ephem_grid_format(&grid, 59 * 86400, buf, sizeof(buf));
+    g_assert_cmpstr(buf, ==, "2025/03/01 00:00:00");
+
+    /* sub-second steps show milliseconds, truncated */
+    ephem_grid_init(&grid, JD_2025, G_GINT64_CONSTANT(100000000));
+    ephem_grid_format(&grid, 15, buf, sizeof(buf));
+    g_assert_cmpstr(buf, ==, "2025/01/01 00:00:01.500");
+
+    /* before 1970 */
+    ephem_grid_init(&grid, 2440587.0, G_GINT64_CONSTANT(1000000000));
+    ephem_grid_format(&grid, 0, buf, sizeof(buf));
+    g_assert_cmpstr(buf, ==, "1969/12/31 12:00:00");
+}
+
+static void test_grid_jd(void)
+{
+    ephem_grid_t    grid;
+    guint64         i;
+
+    ephem_grid_init(&grid, JD_2025, G_GINT64_CONSTANT(1000000000));
+    g_assert_cmpfloat(ephem_grid_jd(&grid, 0), ==, JD_2025);
+    g_assert_cmpfloat(ephem_grid_jd(&grid, 86400), ==, JD_2025 + 1.0);
+
+    /* sample times do not drift with the index */
+    ephem_grid_init(&grid, JD_2025, G_GINT64_CONSTANT(100000000));
+    for (i = 0; i < 10 * 86400 * 10; i += 8641)
+        g_assert_cmpfloat(fabs(ephem_grid_jd(&grid, i) -
+                               (JD_2025 + i * 0.1 / 86400.0)), <, 1.0e-9);
+}
+
+static void test_grid_count(void)
+{
+    ephem_grid_t    grid;
+
+    ephem_grid_init(&grid, JD_2025, G_GINT64_CONSTANT(1000000000));
+    g_assert_cmpuint(ephem_grid_count(&grid, 60), ==, 61);
+    g_assert_cmpuint(ephem_grid_count(&grid, 0), ==, 1);
+
+    ephem_grid_init(&grid, JD_2025, G_GINT64_CONSTANT(7000000000));
+    g_assert_cmpuint(ephem_grid_count(&grid, 60), ==, 9);
+}
+
+static ephem_queue_t *replay(guint n, gdouble t0)
+{
+    ephem_queue_t  *queue = ephem_queue_new(16);
+    ephem_sample_t *samples = g_new0(ephem_sample_t, n);
+    guint           i;
+
+    for (i = 0; i < n; i++)
+    {
+        samples[i].jd = t0 + i;
+        samples[i].t = i;
+    }
+    g_assert_cmpuint(ephem_pipe_replay(samples, n, &queue, 1, NULL), ==, n);
+    g_free(samples);
+
+    return queue;
+}
+
+static void test_pipe_merge(void)
+{
+    ephem_queue_t  *in[2];
+    ephem_queue_t  *out = ephem_queue_new(16);
+    ephem_block_t  *block;
+    gdouble         last = -1.0;
+    guint           count = 0;
+    guint           i;
+
+    /* 2 x (EPHEM_PIPE_BLOCK + 3) samples, interleaved in time */
+    in[0] = replay(EPHEM_PIPE_BLOCK + 3, 0.0);
+    in[1] = replay(EPHEM_PIPE_BLOCK + 3, 0.5);
+    g_assert_cmpuint(ephem_pipe_merge(in, 2, &out, 1, NULL), ==,
+                     2 * (EPHEM_PIPE_BLOCK + 3));
+
+    while ((block = ephem_queue_pop(out, NULL)) != NULL)
+    {
+        for (i = 0; i < block->n; i++)
+        {
+            const ephem_sample_t *s = &block->samples[i];
+
+            g_assert_cmpfloat(s->jd, >, last);
+            g_assert_cmpuint(s->sat, ==, (s->jd != floor(s->jd)));
+            last = s->jd;
+            count++;
+        }
+        ephem_block_unref(block);
+    }
+    g_assert_cmpuint(count, ==, 2 * (EPHEM_PIPE_BLOCK + 3));
+
+    ephem_queue_free(in[0]);
+    ephem_queue_free(in[1]);
+    ephem_queue_free(out);
+}
+
+/* a producer stops once its consumers have left */
+static void test_pipe_closed(void)
+{
+    ephem_queue_t  *queues[3] = { NULL, NULL, NULL };
+    ephem_sample_t *samples = g_new0(ephem_sample_t, 4 * EPHEM_PIPE_BLOCK);
+    ephem_block_t  *block;
+
+    queues[0] = ephem_queue_new(16);
+    queues[2] = ephem_queue_new(16);
+    ephem_queue_close(queues[0]);
+    g_assert_cmpuint(ephem_pipe_replay(samples, 4 * EPHEM_PIPE_BLOCK,
+                                       queues, 3, NULL), ==,
+                     4 * EPHEM_PIPE_BLOCK);
+    ephem_queue_free(queues[0]);
+    ephem_queue_free(queues[2]);
+
+    queues[0] = ephem_queue_new(16);
+    queues[2] = ephem_queue_new(16);
+    ephem_queue_close(queues[0]);
+    ephem_queue_close(queues[2]);
+    g_assert_cmpuint(ephem_pipe_replay(samples, 4 * EPHEM_PIPE_BLOCK,
+                                       queues, 3, NULL), ==, 0);
+    block = ephem_queue_pop(queues[2], NULL);
+    g_assert_null(block);
+    ephem_queue_free(queues[0]);
+    ephem_queue_free(queues[2]);
+
+    g_free(samples);
+}
+
+int main(int argc, char **argv)
+{
+    g_test_init(&argc, &argv, NULL);
+
+    g_test_add_func("/ephem-grid/format", test_grid_format);
+    g_test_add_func("/ephem-grid/jd", test_grid_jd);
+    g_test_add_func("/ephem-grid/count", test_grid_count);
+    g_test_add_func("/ephem-pipe/merge", test_pipe_merge);
+    g_test_add_func("/ephem-pipe/closed", test_pipe_closed);
+
+    return g_test_run();
+}
@@ -0,0 +1,503 @@
+/*
+  OGpredict — extensions to Gpredict for operations planning
+
+  Copyright (C) 2025 Axel Osika <osikaaxel@gmail.com>
+
+  This file is part of OGpredict, a derivative of Gpredict.
+
+  OGpredict is free software: you can redistribute it and/or modify it
+  under the terms of the GNU General Public License as published by the
+  Free Software Foundation; either version 2 of the License, or (at your
+  option) any later version.  See the GNU General Public License for details.
+*/
+
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/**
+ * test-http-fetch.c — conditional downloads and validator bookkeeping
+ *
+ * A minimal HTTP server on the loopback interface serves the fixtures in
+ * tests/data/http-fetch with an ETag and answers 304 to a matching
+ * If-None-Match.  The tests follow the update sequence of the TLE and
+ * transponder updaters: full download, unchanged catalog, an update that
+ * is not applied, and a catalog where only some files have changed.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <build-config.h>
+#endif
+
+#include <gio/gio.h>
+#include <glib.h>
+#include <glib/gstdio.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "http-fetch.h"
+#include "sat-log.h"
+
+#define NUM_RES 2
+
+/** One file served by the stand-in server. */
+typedef struct {
+    const gchar    *path;       /* request path */
+    const gchar    *fixture;    /* file in tests/data/http-fetch */
+    const gchar    *etag;
+} resource_t;
+
+/** The stand-in server and the state of one test. */
+typedef struct {
+    GSocket        *socket;
+    GCancellable   *cancel;
+    GThread        *thread;
+    guint16         port;
+
+    GMutex          lock;
+    resource_t      res[NUM_RES];
+    guint           requests;   /* requests received */
+    guint           conditional;        /* of which with If-None-Match */
+
+    gchar          *dir;        /* download directory */
+    gchar          *meta;       /* validator cache */
+    gchar          *url[NUM_RES];
+    gchar          *file[NUM_RES];
+} fixture_t;
+
+static void send_all(GSocket * conn, const gchar * buf, gsize len)
+{
+    gssize          n;
+
+    while (len > 0 && (n = g_socket_send(conn, buf, len, NULL, NULL)) > 0)
+    {
+        buf += n;
+        len -= n;
+    }
+}
+
+/** Answer one request on conn. */
+static void serve(fixture_t * fx, GSocket * conn)
+{
+    gchar           buf[4096];
+    gchar           path[256];
+    gchar         **lines;
+    gchar          *inm = NULL;
+    gchar          *fname;
+    gchar          *body = NULL;
+    gchar          *reply;
+    resource_t      res = { NULL, NULL, NULL };
+    gsize           len = 0, blen = 0;
+    gssize          n;
+    guint           i;
+
+    buf[0] = '\0';
+    while (len < sizeof(buf) - 1 && strstr(buf, "\r\n\r\n") == NULL)
+    {
+        n = g_socket_receive(conn, buf + len, sizeof(buf) - 1 - len, NULL,
+                             NULL);
+        if (n <= 0)
+            return;
+        len += n;
+        buf[len] = '\0';
+    }
+    if (sscanf(buf, "GET %255s", path) != 1)
+        return;
+
+    lines = g_strsplit(buf, "\r\n", 0);
+    for (i = 0; lines[i] != NULL; i++)
+        if (g_ascii_strncasecmp(lines[i], "If-None-Match:", 14) == 0)
+            inm = g_strstrip(g_strdup(lines[i] + 14));
+    g_strfreev(lines);
+
+    g_mutex_lock(&fx->lock);
+    fx->requests++;
+    if (inm != NULL)
+        fx->conditional++;
+    for (i = 0; i < NUM_RES; i++)
+        if (strcmp(fx->res[i].path, path) == 0)
+            res = fx->res[i];
+    g_mutex_unlock(&fx->lock);
+
+    if (res.path == NULL)
+    {
+        reply = g_strdup("HTTP/1.1 404 Not Found\r\n"
+                         "Content-Length: 0\r\nConnection: close\r\n\r\n");
+    }
+    else if (g_strcmp0(inm, res.etag) == 0)
+    {
+        reply = g_strdup_printf("HTTP/1.1 304 Not Modified\r\n"
+                                "ETag: %s\r\nConnection: close\r\n\r\n",
+                                res.etag);
+    }
+    else
+    {
+        fname = g_build_filename(TEST_DATA_DIR, "http-fetch", res.fixture,
+                                 NULL);
+        g_assert_true(g_file_get_contents(fname, &body, &blen, NULL));
+        g_free(fname);
+        reply = g_strdup_printf("HTTP/1.1 200 OK\r\n"
+                                "Content-Length: %" G_GSIZE_FORMAT "\r\n"
+                                "ETag: %s\r\nConnection: close\r\n\r\n",
+                                blen, res.etag);
+    }
+
+    send_all(conn, reply, strlen(reply));
+    if (body != NULL)
+        send_all(conn, body, blen);
+
+    g_free(reply);
+    g_free(body);
+    g_free(inm);
+}
+
+static gpointer server_thread(gpointer data)
+{
+    fixture_t      *fx = data;
+    GSocket        *conn;
+
+    /* one connection at a time; the client queues the others */
+    while ((conn = g_socket_accept(fx->socket, fx->cancel, NULL)) != NULL)
+    {
+        serve(fx, conn);
+        g_socket_close(conn, NULL);
+        g_object_unref(conn);
+    }
+
+    return NULL;
+}
+
+static void fixture_setup(fixture_t * fx, gconstpointer data)
+{
+    GInetAddress   *lo;
+    GSocketAddress *addr;
+    guint           i;
+
+    (void)data;
+
+    memset(fx, 0, sizeof(*fx));
+    g_mutex_init(&fx->lock);
+    fx->res[0].path = "/a.tle";
+    fx->res[0].fixture = "a.tle";
+    fx->res[0].etag = "\"a1\"";
+    fx->res[1].path = "/b.tle";
+    fx->res[1].fixture = "b.tle";
+    fx->res[1].etag = "\"b1\"";
+
+    fx->socket = g_socket_new(G_SOCKET_FAMILY_IPV4, G_SOCKET_TYPE_STREAM,
+                              G_SOCKET_PROTOCOL_TCP, NULL);
+    g_assert_nonnull(fx->socket);
+    lo = g_inet_address_new_loopback(G_SOCKET_FAMILY_IPV4);
+    addr = g_inet_socket_address_new(lo, 0);
+    g_assert_true(g_socket_bind(fx->socket, addr, TRUE, NULL));
+    g_assert_true(g_socket_listen(fx->socket, NULL));
+    g_object_unref(addr);
+    g_object_unref(lo);
+
+    addr = g_socket_get_local_address(fx->socket, NULL);
+    fx->port = g_inet_socket_address_get_port(G_INET_SOCKET_ADDRESS(addr));
+    g_object_unref(addr);
+
+    fx->cancel = g_cancellable_new();
+    fx->thread = g_thread_new("http-stand-in", server_thread, fx);
+
+    fx->dir = g_dir_make_tmp("test-http-fetch-XXXXXX", NULL);
+    g_assert_nonnull(fx->dir);
+    fx->meta = g_build_filename(fx->dir, "fetch.meta", NULL);
+    for (i = 0; i < NUM_RES; i++)
+    {
+        fx->url[i] = g_strdup_printf("http://127.0.0.1:%u%s", fx->port,
+                                     fx->res[i].path);
+        fx->file[i] = g_build_filename(fx->dir, fx->res[i].path + 1, NULL);
+    }
+}
+
+static void fixture_teardown(fixture_t * fx, gconstpointer data)
+{
+    GDir           *dir;
+    const gchar    *fname;
+    gchar          *path;
+    guint           i;
+
+    (void)data;
+
+    g_cancellable_cancel(fx->cancel);
+    g_thread_join(fx->thread);
+    g_object_unref(fx->cancel);
+    g_socket_close(fx->socket, NULL);
+    g_object_unref(fx->socket);
+    g_mutex_clear(&fx->lock);
+
+    dir = g_dir_open(fx->dir, 0, NULL);
+    while ((fname = g_dir_read_name(dir)) != NULL)
+    {
+        path = g_build_filename(fx->dir, fname, NULL);
+        g_remove(path);
+        g_free(path);
+    }
+    g_dir_close(dir);
+    g_rmdir(fx->dir);
+
+    for (i = 0; i < NUM_RES; i++)
+    {
+        g_free(fx->url[i]);
+        g_free(fx->file[i]);
+    }
+    g_free(fx->meta);
+    g_free(fx->dir);
+}
+
+/** Change the content the server returns for resource i. */
+static void serve_new(fixture_t * fx, guint i, const gchar * fixture,
+                      const gchar * etag)
+{
+    g_mutex_lock(&fx->lock);
+    fx->res[i].fixture = fixture;
+    fx->res[i].etag = etag;
+    fx->requests = 0;
+    fx->conditional = 0;
+    g_mutex_unlock(&fx->lock);
+}
+
+/** Set up the items the way the updaters do. */
+static void items_init(fixture_t * fx, http_fetch_item_t * items)
+{
+    guint           i;
+
+    memset(items, 0, NUM_RES * sizeof(*items));
+    for (i = 0; i < NUM_RES; i++)
+    {
+        items[i].url = fx->url[i];
+        items[i].file = fx->file[i];
+        items[i].conditional = g_file_test(fx->file[i], G_FILE_TEST_EXISTS);
+    }
+}
+
+static guint run(fixture_t * fx, http_fetch_item_t * items,
+                 http_fetch_done_func done)
+{
+    http_fetch_params_t params;
+
+    items_init(fx, items);
+    http_fetch_params_init(&params);
+    params.meta_file = fx->meta;
+
+    return http_fetch_run(items, NUM_RES, &params, done, NULL);
+}
+
+/** Assert that the local copy of resource i holds fixture. */
+static void assert_copy(fixture_t * fx, guint i, const gchar * fixture)
+{
+    gchar          *fname;
+    gchar          *expected;
+    gchar          *actual;
+
+    fname = g_build_filename(TEST_DATA_DIR, "http-fetch", fixture, NULL);
+    g_assert_true(g_file_get_contents(fname, &expected, NULL, NULL));
+    g_assert_true(g_file_get_contents(fx->file[i], &actual, NULL, NULL));
+    g_assert_cmpstr(actual, ==, expected);
+    g_free(actual);
+    g_free(expected);
+    g_free(fname);
+}
+
+/** The ETag recorded for resource i, or NULL. */
+static gchar   *saved_etag(fixture_t * fx, guint i)
+{
+    GKeyFile       *meta = g_key_file_new();
+    gchar          *group;
+    gchar          *etag;
+
+    g_key_file_load_from_file(meta, fx->meta, G_KEY_FILE_NONE, NULL);
+    group = g_compute_checksum_for_string(G_CHECKSUM_SHA1, fx->url[i], -1);
+    etag = g_key_file_get_string(meta, group, "ETAG", NULL);
+    g_free(group);
+    g_key_file_free(meta);
+
+    return etag;
+}
+
+static void assert_etag(fixture_t * fx, guint i, const gchar * etag)
+{
+    gchar          *saved = saved_etag(fx, i);
+
+    g_assert_cmpstr(saved, ==, etag);
+    g_free(saved);
+}
+
+/** A full download followed by a successful apply. */
+static void download_all(fixture_t * fx)
+{
+    http_fetch_item_t items[NUM_RES];
+
+    g_assert_cmpuint(run(fx, items, NULL), ==, NUM_RES);
+    g_assert_true(http_fetch_save_validators(items, NUM_RES, fx->meta));
+    http_fetch_items_clear(items, NUM_RES);
+}
+
+static void test_full(fixture_t * fx, gconstpointer data)
+{
+    http_fetch_item_t items[NUM_RES];
+
+    (void)data;
+
+    g_assert_cmpuint(run(fx, items, NULL), ==, NUM_RES);
+    g_assert_cmpuint(fx->requests, ==, NUM_RES);
+    g_assert_cmpuint(fx->conditional, ==, 0);
+
+    g_assert_cmpint(items[0].status, ==, HTTP_FETCH_UPDATED);
+    g_assert_cmpint(items[1].status, ==, HTTP_FETCH_UPDATED);
+    g_assert_cmpint(items[0].response, ==, 200);
+    g_assert_cmpstr(items[0].etag, ==, "\"a1\"");
+    g_assert_cmpstr(items[1].etag, ==, "\"b1\"");
+    assert_copy(fx, 0, "a.tle");
+    assert_copy(fx, 1, "b.tle");
+
+    /* nothing is recorded until the caller has used the files */
+    g_assert_false(g_file_test(fx->meta, G_FILE_TEST_EXISTS));
+    g_assert_true(http_fetch_save_validators(items, NUM_RES, fx->meta));
+    assert_etag(fx, 0, "\"a1\"");
+    assert_etag(fx, 1, "\"b1\"");
+    http_fetch_items_clear(items, NUM_RES);
+
+    /* a missing file fails without leaving anything behind */
+    g_mutex_lock(&fx->lock);
+    fx->res[1].path = "/gone.tle";
+    g_mutex_unlock(&fx->lock);
+    g_remove(fx->file[1]);
+    g_assert_cmpuint(run(fx, items, NULL), ==, 1);
+    g_assert_cmpint(items[1].status, ==, HTTP_FETCH_FAILED);
+    g_assert_cmpint(items[1].response, ==, 404);
+    g_assert_nonnull(items[1].error);
+    g_assert_false(g_file_test(fx->file[1], G_FILE_TEST_EXISTS));
+    http_fetch_items_clear(items, NUM_RES);
+}
+
+static void test_not_modified(fixture_t * fx, gconstpointer data)
+{
+    http_fetch_item_t items[NUM_RES];
+
+    (void)data;
+
+    download_all(fx);
+    serve_new(fx, 0, "a.tle", "\"a1\"");
+
+    g_assert_cmpuint(run(fx, items, NULL), ==, NUM_RES);
+    g_assert_cmpuint(fx->conditional, ==, NUM_RES);
+    g_assert_cmpint(items[0].status, ==, HTTP_FETCH_NOT_MODIFIED);
+    g_assert_cmpint(items[1].status, ==, HTTP_FETCH_NOT_MODIFIED);
+    g_assert_cmpint(items[0].response, ==, 304);
+    g_assert_null(items[0].etag);
+
+    /* the previous copies are left alone */
+    assert_copy(fx, 0, "a.tle");
+    assert_copy(fx, 1, "b.tle");
+    g_assert_true(http_fetch_save_validators(items, NUM_RES, fx->meta));
+    assert_etag(fx, 0, "\"a1\"");
+    http_fetch_items_clear(items, NUM_RES);
+}
+
+/** Completion callback that rejects the content of the first file. */
+static void reject_a(http_fetch_item_t * item, gpointer data)
+{
+    (void)data;
+
+    if (item->status == HTTP_FETCH_UPDATED && g_str_has_suffix(item->url,
+                                                               "/a.tle"))
+    {
+        item->status = HTTP_FETCH_FAILED;
+        item->error = g_strdup("No valid TLE data");
+    }
+}
+
+static void test_failed_apply(fixture_t * fx, gconstpointer data)
+{
+    http_fetch_item_t items[NUM_RES];
+    guint           i;
+
+    (void)data;
+
+    download_all(fx);
+    serve_new(fx, 0, "a-2.tle", "\"a2\"");
+
+    /* the update is fetched but cannot be applied: the validators are not
+       saved and the new copy is dropped, as tle_update_from_network() does */
+    g_assert_cmpuint(run(fx, items, NULL), ==, NUM_RES);
+    g_assert_cmpint(items[0].status, ==, HTTP_FETCH_UPDATED);
+    assert_copy(fx, 0, "a-2.tle");
+    for (i = 0; i < NUM_RES; i++)
+        if (items[i].status == HTTP_FETCH_UPDATED)
+            g_remove(items[i].file);
+    http_fetch_items_clear(items, NUM_RES);
+    assert_etag(fx, 0, "\"a1\"");
+
+    /* so the next update asks for the whole file again */
+    serve_new(fx, 0, "a-2.tle", "\"a2\"");
+    g_assert_cmpuint(run(fx, items, NULL), ==, NUM_RES);
+    g_assert_cmpuint(fx->conditional, ==, 1);
+    g_assert_cmpint(items[0].status, ==, HTTP_FETCH_UPDATED);
+    g_assert_cmpint(items[1].status, ==, HTTP_FETCH_NOT_MODIFIED);
+    assert_copy(fx, 0, "a-2.tle");
+
+    /* content rejected by the completion callback counts as failed and
+       its validators are not saved */
+    g_remove(fx->file[0]);
+    http_fetch_items_clear(items, NUM_RES);
+    g_assert_cmpuint(run(fx, items, reject_a), ==, 1);
+    g_assert_cmpint(items[0].status, ==, HTTP_FETCH_FAILED);
+    g_assert_true(http_fetch_save_validators(items, NUM_RES, fx->meta));
+    assert_etag(fx, 0, "\"a1\"");
+    assert_etag(fx, 1, "\"b1\"");
+    http_fetch_items_clear(items, NUM_RES);
+}
+
+static void test_partial(fixture_t * fx, gconstpointer data)
+{
+    http_fetch_item_t items[NUM_RES];
+
+    (void)data;
+
+    download_all(fx);
+    serve_new(fx, 0, "a-2.tle", "\"a2\"");
+
+    g_assert_cmpuint(run(fx, items, NULL), ==, NUM_RES);
+    g_assert_cmpuint(fx->conditional, ==, NUM_RES);
+    g_assert_cmpint(items[0].status, ==, HTTP_FETCH_UPDATED);
+    g_assert_cmpint(items[1].status, ==, HTTP_FETCH_NOT_MODIFIED);
+
+    /* the unchanged file still has its copy, to be applied with the new
+       one */
+    assert_copy(fx, 0, "a-2.tle");
+    assert_copy(fx, 1, "b.tle");
+
+    /* only the updated file gets new validators */
+    g_assert_true(http_fetch_save_validators(items, NUM_RES, fx->meta));
+    assert_etag(fx, 0, "\"a2\"");
+    assert_etag(fx, 1, "\"b1\"");
+    http_fetch_items_clear(items, NUM_RES);
+
+    serve_new(fx, 0, "a-2.tle", "\"a2\"");
+    g_assert_cmpuint(run(fx, items, NULL), ==, NUM_RES);
+    g_assert_cmpint(items[0].status, ==, HTTP_FETCH_NOT_MODIFIED);
+    g_assert_cmpint(items[1].status, ==, HTTP_FETCH_NOT_MODIFIED);
+    http_fetch_items_clear(items, NUM_RES);
+}
+
+int main(int argc, char **argv)
+{
+    g_test_init(&argc, &argv, NULL);
+    sat_log_set_level(SAT_LOG_LEVEL_NONE);
+
+    /* the server is on the loopback interface */
+    g_setenv("no_proxy", "*", TRUE);
+    g_setenv("NO_PROXY", "*", TRUE);
+
+    g_test_add("/http-fetch/full", fixture_t, NULL, fixture_setup,
+               test_full, fixture_teardown);
+    g_test_add("/http-fetch/not-modified", fixture_t, NULL, fixture_setup,
+               test_not_modified, fixture_teardown);
+    g_test_add("/http-fetch/failed-apply", fixture_t, NULL, fixture_setup,
+               test_failed_apply, fixture_teardown);
+    g_test_add("/http-fetch/partial", fixture_t, NULL, fixture_setup,
+               test_partial, fixture_teardown);
+
+    return g_test_run();
+}
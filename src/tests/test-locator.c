@@ -0,0 +1,312 @@
+/*
+  OGpredict — extensions to Gpredict for operations planning
+
+  Copyright (C) 2025 Axel Osika <osikaaxel@gmail.com>
+
+  This file is part of OGpredict, a derivative of Gpredict.
+
+  OGpredict is free software: you can redistribute it and/or modify it
+  under the terms of the GNU General Public License as published by the
+  Free Software Foundation; either version 2 of the License, or (at your
+  option) any later version.  See the GNU General Public License for details.
+*/
+
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/**
+ * test-locator.c — batch locator and great-circle kernels
+ *
+ * Every batch kernel is checked against its scalar function on a grid of
+ * positions that covers the poles, the date line and a block size that is
+ * not a multiple of the kernel block. The great-circle functions and the
+ * lp_compute_* wrappers are also checked against the haversine/azimuth
+ * formulas they replaced.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <build-config.h>
+#endif
+
+#include <glib.h>
+#include <math.h>
+#include <string.h>
+
+#include "locator.h"
+#include "Logic_POI_Filter.h"
+
+#define EARTH_RADIUS_KM 6371.0
+
+typedef struct {
+    gint            n;
+    gdouble        *lat;
+    gdouble        *lon;
+} Grid;
+
+static void grid_init(Grid * g)
+{
+    gint            r, c;
+
+    /* 107 x 117 positions, not a multiple of the 64 element block */
+    g->lat = g_new(gdouble, 107 * 117);
+    g->lon = g_new(gdouble, 107 * 117);
+    g->n = 0;
+    for (r = 0; r < 107; r++)
+    {
+        for (c = 0; c < 117; c++)
+        {
+            g->lat[g->n] = -90.0 + r * 180.0 / 106;
+            g->lon[g->n] = -180.0 + c * 360.0 / 116;
+            g->n++;
+        }
+    }
+}
+
+static void grid_clear(Grid * g)
+{
+    g_free(g->lat);
+    g_free(g->lon);
+}
+
+/* the formulas of lp_compute_distance_km/bearing_deg before the kernels */
+static gdouble ref_distance(gdouble lat1, gdouble lon1, gdouble lat2,
+                            gdouble lon2)
+{
+    gdouble         dlat = (lat2 - lat1) * G_PI / 180.0;
+    gdouble         dlon = (lon2 - lon1) * G_PI / 180.0;
+    gdouble         h = sin(dlat / 2) * sin(dlat / 2) +
+        sin(dlon / 2) * sin(dlon / 2) *
+        cos(lat1 * G_PI / 180.0) * cos(lat2 * G_PI / 180.0);
+
+    /* they gave NaN where rounding takes h above 1 at the antipode */
+    h = MIN(h, 1.0);
+
+    return 2 * EARTH_RADIUS_KM * atan2(sqrt(h), sqrt(1 - h));
+}
+
+static gdouble ref_bearing(gdouble lat1, gdouble lon1, gdouble lat2,
+                           gdouble lon2)
+{
+    gdouble         p1 = lat1 * G_PI / 180.0;
+    gdouble         p2 = lat2 * G_PI / 180.0;
+    gdouble         dl = (lon2 - lon1) * G_PI / 180.0;
+    gdouble         th = atan2(sin(dl) * cos(p2),
+                               cos(p1) * sin(p2) -
+                               sin(p1) * cos(p2) * cos(dl)) * 180.0 / G_PI;
+
+    return fmod(th + 360.0, 360.0);
+}
+
+/* the bearing is undefined at the poles and for equal or antipodal points */
+static gboolean bearing_defined(gdouble lat1, gdouble lat2, gdouble d)
+{
+    return fabs(lat1) < 90.0 && fabs(lat2) < 90.0 && d > 1.0 &&
+        d < G_PI * EARTH_RADIUS_KM - 1.0;
+}
+
+/* difference of two bearings, across north */
+static gdouble bearing_diff(gdouble a, gdouble b)
+{
+    gdouble         d = fabs(a - b);
+
+    return MIN(d, 360.0 - d);
+}
+
+static void test_longlat2locator_n(void)
+{
+    Grid            g;
+    gchar          *locs;
+    gchar           loc[13];
+    gint            pairs, i, stride;
+
+    grid_init(&g);
+
+    for (pairs = 1; pairs <= 6; pairs++)
+    {
+        stride = pairs * 2 + 1;
+        locs = g_new(gchar, g.n * stride);
+        g_assert_cmpint(longlat2locator_n(g.lon, g.lat, locs, pairs, g.n),
+                        ==, RIG_OK);
+
+        for (i = 0; i < g.n; i++)
+        {
+            g_assert_cmpint(longlat2locator(g.lon[i], g.lat[i], loc, pairs),
+                            ==, RIG_OK);
+            g_assert_cmpstr(locs + i * stride, ==, loc);
+        }
+        g_free(locs);
+    }
+
+    /* same limits as the scalar function */
+    g_assert_cmpint(longlat2locator_n(g.lon, g.lat, NULL, 3, g.n), !=,
+                    RIG_OK);
+    g_assert_cmpint(longlat2locator_n(g.lon, g.lat, loc, 0, 1), !=, RIG_OK);
+    g_assert_cmpint(longlat2locator_n(g.lon, g.lat, loc, 7, 1), !=, RIG_OK);
+
+    grid_clear(&g);
+}
+
+static void test_locator2longlat_n(void)
+{
+    Grid            g;
+    gchar          *locs;
+    const gchar   **ptrs;
+    gdouble        *lon, *lat;
+    gdouble         lo, la;
+    gint            i, ok;
+
+    grid_init(&g);
+    locs = g_new(gchar, g.n * 7);
+    longlat2locator_n(g.lon, g.lat, locs, 3, g.n);
+
+    /* every 10th locator is invalid or missing */
+    ptrs = g_new(const gchar *, g.n);
+    for (i = 0; i < g.n; i++)
+        ptrs[i] = locs + i * 7;
+    for (i = 0; i < g.n; i += 10)
+        ptrs[i] = (i % 20 == 0) ? NULL : "ZZ99zz";
+
+    lon = g_new(gdouble, g.n);
+    lat = g_new(gdouble, g.n);
+    ok = locator2longlat_n(lon, lat, ptrs, g.n);
+    g_assert_cmpint(ok, ==, g.n - (g.n + 9) / 10);
+
+    for (i = 0; i < g.n; i++)
+    {
+        if (i % 10 == 0)
+        {
+            g_assert_true(isnan(lon[i]) && isnan(lat[i]));
+            continue;
+        }
+        g_assert_cmpint(locator2longlat(&lo, &la, ptrs[i]), ==, RIG_OK);
+        g_assert_cmpfloat(lon[i], ==, lo);
+        g_assert_cmpfloat(lat[i], ==, la);
+
+        /* the centre of the subsquare holding the position; 90N and 180E
+           wrap around to the first square */
+        if (fabs(g.lat[i]) < 90.0 && fabs(g.lon[i]) < 180.0)
+        {
+            g_assert_cmpfloat(fabs(la - g.lat[i]), <=, 1.0 / 48.0 + 1.0e-6);
+            g_assert_cmpfloat(fabs(lo - g.lon[i]), <=, 1.0 / 24.0 + 1.0e-6);
+        }
+    }
+
+    g_free(lon);
+    g_free(lat);
+    g_free(ptrs);
+    g_free(locs);
+    grid_clear(&g);
+}
+
+static void test_gc_scalar(void)
+{
+    Grid            g;
+    LP_GeoPoint     a, b;
+    gint            i, j;
+
+    grid_init(&g);
+
+    /* all pairs of a subsample of the grid */
+    for (i = 0; i < g.n; i += 37)
+    {
+        for (j = 0; j < g.n; j += 41)
+        {
+            gdouble         d = gc_distance_km(g.lat[i], g.lon[i],
+                                               g.lat[j], g.lon[j]);
+            gdouble         brg = gc_bearing_deg(g.lat[i], g.lon[i],
+                                                 g.lat[j], g.lon[j]);
+
+            /* 1 m; the haversine loses digits near the antipode */
+            g_assert_cmpfloat(fabs(d - ref_distance(g.lat[i], g.lon[i],
+                                                    g.lat[j], g.lon[j])),
+                              <, 1.0e-3);
+            g_assert_cmpfloat(brg, >=, 0.0);
+            g_assert_cmpfloat(brg, <, 360.0);
+            if (bearing_defined(g.lat[i], g.lat[j], d))
+                g_assert_cmpfloat(bearing_diff(brg,
+                                               ref_bearing(g.lat[i], g.lon[i],
+                                                           g.lat[j],
+                                                           g.lon[j])),
+                                  <, 1.0e-9);
+
+            a.lat = g.lat[i];
+            a.lon = g.lon[i];
+            b.lat = g.lat[j];
+            b.lon = g.lon[j];
+            g_assert_cmpfloat(lp_compute_distance_km(&a, &b), ==, d);
+            g_assert_cmpfloat(lp_compute_bearing_deg(&a, &b), ==, brg);
+        }
+    }
+
+    /* a quarter of the circumference, due east along the equator */
+    g_assert_cmpfloat(fabs(gc_distance_km(0.0, 0.0, 0.0, 90.0) -
+                           G_PI * EARTH_RADIUS_KM / 2.0), <, 1.0e-6);
+    g_assert_cmpfloat(fabs(gc_bearing_deg(0.0, 0.0, 0.0, 90.0) - 90.0), <,
+                      1.0e-9);
+
+    /* half the circumference to the antipode */
+    for (i = 0; i < g.n; i += 37)
+        g_assert_cmpfloat(fabs(gc_distance_km(g.lat[i], g.lon[i], -g.lat[i],
+                                              g.lon[i] + 180.0) -
+                               G_PI * EARTH_RADIUS_KM), <, 1.0e-3);
+
+    grid_clear(&g);
+}
+
+static void test_gc_distance_bearing_n(void)
+{
+    Grid            g;
+    gdouble        *dist, *brg;
+    gdouble         d1[1];
+    gint            i, j;
+
+    grid_init(&g);
+    dist = g_new(gdouble, g.n);
+    brg = g_new(gdouble, g.n);
+
+    for (i = 0; i < g.n; i += 211)
+    {
+        gc_distance_bearing_n(g.lat[i], g.lon[i], g.lat, g.lon, dist, brg,
+                              g.n);
+        for (j = 0; j < g.n; j++)
+        {
+            g_assert_cmpfloat(fabs(dist[j] -
+                                   gc_distance_km(g.lat[i], g.lon[i],
+                                                  g.lat[j], g.lon[j])),
+                              <, 1.0e-3);
+            g_assert_cmpfloat(brg[j], >=, 0.0);
+            g_assert_cmpfloat(brg[j], <, 360.0);
+            if (bearing_defined(g.lat[i], g.lat[j], dist[j]))
+                g_assert_cmpfloat(bearing_diff(brg[j],
+                                               gc_bearing_deg(g.lat[i],
+                                                              g.lon[i],
+                                                              g.lat[j],
+                                                              g.lon[j])),
+                                  <, 1.0e-9);
+        }
+    }
+
+    /* either output may be omitted */
+    gc_distance_bearing_n(10.0, 20.0, g.lat, g.lon, d1, NULL, 1);
+    g_assert_cmpfloat(d1[0], ==, gc_distance_km(10.0, 20.0, g.lat[0],
+                                                g.lon[0]));
+    gc_distance_bearing_n(10.0, 20.0, g.lat, g.lon, NULL, d1, 1);
+    g_assert_cmpfloat(d1[0], ==, gc_bearing_deg(10.0, 20.0, g.lat[0],
+                                                g.lon[0]));
+
+    g_free(dist);
+    g_free(brg);
+    grid_clear(&g);
+}
+
+int main(int argc, char **argv)
+{
+    g_test_init(&argc, &argv, NULL);
+
+    g_test_add_func("/locator/longlat2locator-n", test_longlat2locator_n);
+    g_test_add_func("/locator/locator2longlat-n", test_locator2longlat_n);
+    g_test_add_func("/locator/gc-scalar", test_gc_scalar);
+    g_test_add_func("/locator/gc-distance-bearing-n",
+                    test_gc_distance_bearing_n);
+
+    return g_test_run();
+}
@@ -0,0 +1,246 @@
+/*
+  OGpredict — extensions to Gpredict for operations planning
+
+  Copyright (C) 2025 Axel Osika <osikaaxel@gmail.com>
+
+  This file is part of OGpredict, a derivative of Gpredict.
+
+  OGpredict is free software: you can redistribute it and/or modify it
+  under the terms of the GNU General Public License as published by the
+  Free Software Foundation; either version 2 of the License, or (at your
+  option) any later version.  See the GNU General Public License for details.
+*/
+
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/**
+ * test-qth-route.c — pass prediction for a moving observer
+ *
+ * The AOS/LOS along a route are checked against a brute-force elevation
+ * scan with the observer at its interpolated position, and the route-aware
+ * predict-tools entry points against the route itself.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <build-config.h>
+#endif
+
+#include <glib.h>
+#include <math.h>
+#include <string.h>
+
+#include "orbit-tools.h"
+#include "predict-tools.h"
+#include "qth-route.h"
+#include "sat-log.h"
+#include "sgpsdp/sgp4sdp4.h"
+
+/* brute-force scan step [days] */
+#define SCAN_STEP (5.0 / 86400.0)
+
+/* time resolution of the route search [days], see qth-route.c */
+#define ROUTE_TOL 1.0e-6
+
+static void sat_init(sat_t * sat)
+{
+    char            lines[3][80] = {
+        "ISS (ZARYA)",
+        "1 25544U 98067A   08264.51782528 -.00002182  00000-0 -11606-4 0  2927",
+        "2 25544  51.6416 247.4627 0006703 130.5360 325.0288 15.72125391563537"
+    };
+
+    memset(sat, 0, sizeof(*sat));
+    g_assert_cmpint(Get_Next_Tle_Set(lines, &sat->tle), ==, 1);
+    sat->name = g_strdup("ISS");
+    sat->nickname = g_strdup("ISS");
+    select_ephemeris(sat);
+    sat->jul_epoch = Julian_Date_of_Epoch(sat->tle.epoch);
+    sat->orbit = sat->tle.revnum;
+    sat->otype = get_orbit_type(sat);
+}
+
+static void sat_clear(sat_t * sat)
+{
+    g_free(sat->name);
+    g_free(sat->nickname);
+}
+
+/* a 12 hour drive from Copenhagen to Vienna, starting at the epoch */
+static qth_route_t *drive_new(gdouble t0)
+{
+    qth_route_point_t pts[] = {
+        {t0, 55.6761, 12.5683, 10.0},
+        {t0 + 0.125, 53.5511, 9.9937, 10.0},
+        {t0 + 0.25, 51.0504, 13.7373, 110.0},
+        {t0 + 0.375, 50.0755, 14.4378, 200.0},
+        {t0 + 0.5, 48.2082, 16.3738, 190.0},
+    };
+    qth_route_t    *route;
+    GError         *err = NULL;
+
+    route = qth_route_new(pts, G_N_ELEMENTS(pts), &err);
+    g_assert_no_error(err);
+
+    return route;
+}
+
+static void test_route_at(void)
+{
+    qth_route_point_t pts[] = {
+        {100.0, 10.0, 179.0, 0.0},
+        {101.0, 20.0, -179.0, 100.0},
+    };
+    qth_route_t    *route;
+    qth_t           qth;
+
+    memset(&qth, 0, sizeof(qth));
+    route = qth_route_new(pts, 2, NULL);
+    g_assert_nonnull(route);
+
+    /* clamped outside the route */
+    qth_route_at(route, 99.0, &qth);
+    g_assert_cmpfloat(qth.lat, ==, 10.0);
+    g_assert_cmpfloat(qth.lon, ==, 179.0);
+    qth_route_at(route, 102.0, &qth);
+    g_assert_cmpfloat(qth.lat, ==, 20.0);
+    g_assert_cmpfloat(qth.lon, ==, -179.0);
+
+    /* the short way across the date line */
+    qth_route_at(route, 100.25, &qth);
+    g_assert_cmpfloat(fabs(qth.lat - 12.5), <, 1.0e-9);
+    g_assert_cmpfloat(fabs(qth.lon - 179.5), <, 1.0e-9);
+    g_assert_cmpint(qth.alt, ==, 25);
+    qth_route_at(route, 100.75, &qth);
+    g_assert_cmpfloat(fabs(qth.lon + 179.5), <, 1.0e-9);
+
+    g_assert_true(qth_route_covers(route, 100.0));
+    g_assert_false(qth_route_covers(route, 101.0));
+
+    qth_route_free(route);
+
+    /* waypoints must be in time order */
+    g_assert_null(qth_route_new(pts, 1, NULL));
+    pts[1].t = 100.0;
+    g_assert_null(qth_route_new(pts, 2, NULL));
+}
+
+static void test_route_aos_los(void)
+{
+    sat_t           sat;
+    qth_t           qth;
+    qth_route_t    *route;
+    GArray         *rises;
+    gdouble         t0, t1, t, aos, los, rise;
+    gboolean        up, was_up;
+    guint           n = 0;
+
+    sat_init(&sat);
+    memset(&qth, 0, sizeof(qth));
+    t0 = sat.jul_epoch;
+    t1 = t0 + 0.5;
+    route = drive_new(t0);
+
+    /* reference: rising edges of a scan with the observer moving */
+    rises = g_array_new(FALSE, FALSE, sizeof(gdouble));
+    qth_route_calc(route, &sat, &qth, t0);
+    was_up = (sat.el >= 0.0);
+    for (t = t0 + SCAN_STEP; t < t1; t += SCAN_STEP)
+    {
+        qth_route_calc(route, &sat, &qth, t);
+        up = (sat.el >= 0.0);
+        if (up && !was_up)
+            g_array_append_val(rises, t);
+        was_up = up;
+    }
+    g_assert_cmpuint(rises->len, >, 0);
+
+    for (t = t0;
+         (aos = qth_route_find_aos(route, &sat, &qth, t, t1 - t)) > 0.0;
+         t = los)
+    {
+        g_assert_cmpuint(n, <, rises->len);
+        rise = g_array_index(rises, gdouble, n);
+        g_assert_cmpfloat(aos, >, rise - SCAN_STEP);
+        g_assert_cmpfloat(aos, <=, rise + ROUTE_TOL);
+
+        /* the crossing is bracketed at the interpolated position */
+        qth_route_calc(route, &sat, &qth, aos);
+        g_assert_cmpfloat(sat.el, >=, 0.0);
+        qth_route_calc(route, &sat, &qth, aos - 2.0 * ROUTE_TOL);
+        g_assert_cmpfloat(sat.el, <, 0.0);
+
+        los = qth_route_find_los(route, &sat, &qth, aos, 0.0);
+        g_assert_cmpfloat(los, >, aos);
+        qth_route_calc(route, &sat, &qth, los);
+        g_assert_cmpfloat(sat.el, <, 0.0);
+        qth_route_calc(route, &sat, &qth, los - 2.0 * ROUTE_TOL);
+        g_assert_cmpfloat(sat.el, >=, 0.0);
+        n++;
+    }
+    g_assert_cmpuint(n, ==, rises->len);
+
+    g_array_free(rises, TRUE);
+    qth_route_free(route);
+    sat_clear(&sat);
+}
+
+static void test_predict_dispatch(void)
+{
+    sat_t           sat;
+    qth_t           qth;
+    qth_route_t    *route;
+    GSList         *passes;
+    pass_t         *pass;
+    gdouble         t0, aos, los;
+
+    sat_init(&sat);
+    memset(&qth, 0, sizeof(qth));
+    t0 = sat.jul_epoch;
+    route = drive_new(t0);
+
+    /* the fixed site is far from the route; predictions must follow it */
+    qth.lat = -33.9;
+    qth.lon = 18.4;
+    qth.route = route;
+
+    aos = qth_route_find_aos(route, &sat, &qth, t0, 0.5);
+    g_assert_cmpfloat(aos, >, 0.0);
+    g_assert_cmpfloat(find_aos(&sat, &qth, t0, 0.5), ==, aos);
+
+    qth.route = NULL;
+    g_assert_cmpfloat(fabs(find_aos(&sat, &qth, t0, 0.5) - aos), >, 1.0e-3);
+    qth.route = route;
+
+    /* passes below the minimum elevation are skipped, so the first pass
+       may start after the first AOS */
+    passes = get_passes(&sat, &qth, t0, 0.5, 0);
+    g_assert_nonnull(passes);
+    pass = PASS(passes->data);
+    g_assert_cmpfloat(pass->aos, >=, aos);
+    aos = pass->aos;
+    los = pass->los;
+    g_assert_cmpfloat(find_los(&sat, &qth, aos, 0.5), ==, los);
+    free_passes(passes);
+
+    /* the pass in progress, independent of the minimum elevation */
+    pass = get_current_pass(&sat, &qth, 0.5 * (aos + los));
+    g_assert_nonnull(pass);
+    g_assert_cmpfloat(pass->aos, ==, aos);
+    g_assert_cmpfloat(pass->los, ==, los);
+    free_pass(pass);
+
+    qth_route_free(route);
+    sat_clear(&sat);
+}
+
+int main(int argc, char **argv)
+{
+    g_test_init(&argc, &argv, NULL);
+    sat_log_set_level(SAT_LOG_LEVEL_NONE);
+
+    g_test_add_func("/qth-route/at", test_route_at);
+    g_test_add_func("/qth-route/aos-los", test_route_aos_los);
+    g_test_add_func("/qth-route/predict-dispatch", test_predict_dispatch);
+
+    return g_test_run();
+}
@@ -0,0 +1,383 @@
+/*
+  OGpredict — extensions to Gpredict for operations planning
+
+  Copyright (C) 2025 Axel Osika <osikaaxel@gmail.com>
+
+  This file is part of OGpredict, a derivative of Gpredict.
+
+  OGpredict is free software: you can redistribute it and/or modify it
+  under the terms of the GNU General Public License as published by the
+  Free Software Foundation; either version 2 of the License, or (at your
+  option) any later version.  See the GNU General Public License for details.
+*/
+
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/**
+ * test-result-cache.c — on-disk cache of Ephemeris window results
+ *
+ * The cache lives under the user configuration directory, which is moved to
+ * a scratch directory for the run.  Covers the round trip, the rejection of
+ * truncated entries and of entries written with another layout or byte
+ * order, the LRU trim and the three ways entries are invalidated.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <build-config.h>
+#endif
+
+#include <glib.h>
+#include <glib/gstdio.h>
+#include <string.h>
+
+#include "compat.h"
+#include "result-cache.h"
+#include "sat-log.h"
+
+/* large enough for every entry of the tests, see result_cache_store() */
+#define CACHE_MAX (G_GUINT64_CONSTANT(1) << 20)
+
+/* offsets in the entry header, see result-cache.c */
+#define HEADER_VERSION 4
+#define HEADER_ORDER   8
+#define HEADER_USED    24
+
+static gchar   *entry_file(const gchar * key)
+{
+    gchar          *confdir = get_user_conf_dir();
+    gchar          *name = g_strconcat(key, ".bin", NULL);
+    gchar          *path = g_build_filename(confdir, "cache", name, NULL);
+
+    g_free(confdir);
+    g_free(name);
+
+    return path;
+}
+
+/* count records 0, 1, ..., depending on one satellite */
+static void store(const gchar * key, guint32 catnr, guint count)
+{
+    guint64        *data = g_new(guint64, MAX(count, 1));
+    guint           i;
+
+    for (i = 0; i < count; i++)
+        data[i] = i;
+    g_assert_true(result_cache_store(key, sizeof(guint64), &catnr, 1, data,
+                                     count, CACHE_MAX));
+    g_free(data);
+}
+
+/* replace the contents of an entry */
+static void rewrite(const gchar * key, const gchar * data, gsize len)
+{
+    gchar          *path = entry_file(key);
+
+    g_assert_true(g_file_set_contents(path, data, len, NULL));
+    g_free(path);
+}
+
+/* set the time of last use of an entry */
+static void set_used(const gchar * key, guint64 used)
+{
+    gchar          *path = entry_file(key);
+    gchar          *contents;
+    gsize           len;
+
+    g_assert_true(g_file_get_contents(path, &contents, &len, NULL));
+    memcpy(contents + HEADER_USED, &used, sizeof(used));
+    rewrite(key, contents, len);
+    g_free(contents);
+    g_free(path);
+}
+
+static void test_load(void)
+{
+    GChecksum      *sum = g_checksum_new(G_CHECKSUM_SHA256);
+    gchar          *key;
+    GBytes         *bytes;
+    const guint64  *rec;
+    gsize           len;
+    guint           i;
+
+    result_cache_invalidate(NULL);
+
+    key = result_cache_key("ephem", sum);
+    g_assert_true(g_str_has_prefix(key, "ephem-"));
+    g_assert_false(result_cache_has(key));
+    g_assert_null(result_cache_load(key, sizeof(guint64)));
+
+    store(key, 25544, 100);
+    g_assert_true(result_cache_has(key));
+    bytes = result_cache_load(key, sizeof(guint64));
+    g_assert_nonnull(bytes);
+    rec = g_bytes_get_data(bytes, &len);
+    g_assert_cmpuint(len, ==, 100 * sizeof(guint64));
+    g_assert_cmpuint((gsize) rec % sizeof(guint64), ==, 0);
+    for (i = 0; i < 100; i++)
+        g_assert_cmpuint(rec[i], ==, i);
+    g_bytes_unref(bytes);
+
+    /* an empty result is a hit too */
+    store("zone-empty", 25544, 0);
+    bytes = result_cache_load("zone-empty", sizeof(guint64));
+    g_assert_nonnull(bytes);
+    g_assert_cmpuint(g_bytes_get_size(bytes), ==, 0);
+    g_bytes_unref(bytes);
+
+    /* too large for the cache: not stored */
+    g_assert_false(result_cache_store("ephem-big", 1, NULL, 0, "", 1024,
+                                      4095));
+    g_assert_false(result_cache_has("ephem-big"));
+
+    g_checksum_free(sum);
+    g_free(key);
+}
+
+static void test_truncated(void)
+{
+    gchar          *path, *contents;
+    gsize           len;
+
+    result_cache_invalidate(NULL);
+
+    /* one byte short of the last record */
+    store("ephem-t", 1, 10);
+    path = entry_file("ephem-t");
+    g_assert_true(g_file_get_contents(path, &contents, &len, NULL));
+    rewrite("ephem-t", contents, len - 1);
+    g_assert_null(result_cache_load("ephem-t", sizeof(guint64)));
+    g_assert_false(result_cache_has("ephem-t"));
+
+    /* a whole record short: the count no longer matches */
+    rewrite("ephem-t", contents, len - sizeof(guint64));
+    g_assert_null(result_cache_load("ephem-t", sizeof(guint64)));
+    g_assert_false(result_cache_has("ephem-t"));
+
+    /* cut inside the header */
+    rewrite("ephem-t", contents, 10);
+    g_assert_null(result_cache_load("ephem-t", sizeof(guint64)));
+    g_assert_false(result_cache_has("ephem-t"));
+
+    g_free(contents);
+    g_free(path);
+}
+
+static void test_foreign(void)
+{
+    gchar          *path, *contents;
+    gsize           len;
+    guint32         word;
+
+    result_cache_invalidate(NULL);
+
+    store("ephem-f", 1, 10);
+    path = entry_file("ephem-f");
+    g_assert_true(g_file_get_contents(path, &contents, &len, NULL));
+
+    /* written by another version */
+    memcpy(&word, contents + HEADER_VERSION, sizeof(word));
+    word++;
+    memcpy(contents + HEADER_VERSION, &word, sizeof(word));
+    rewrite("ephem-f", contents, len);
+    g_assert_null(result_cache_load("ephem-f", sizeof(guint64)));
+    g_assert_false(result_cache_has("ephem-f"));
+
+    /* written on a host with the other byte order */
+    word--;
+    memcpy(contents + HEADER_VERSION, &word, sizeof(word));
+    memcpy(&word, contents + HEADER_ORDER, sizeof(word));
+    word = GUINT32_SWAP_LE_BE(word);
+    memcpy(contents + HEADER_ORDER, &word, sizeof(word));
+    rewrite("ephem-f", contents, len);
+    g_assert_null(result_cache_load("ephem-f", sizeof(guint64)));
+    g_assert_false(result_cache_has("ephem-f"));
+
+    /* not an entry at all */
+    word = GUINT32_SWAP_LE_BE(word);
+    memcpy(contents + HEADER_ORDER, &word, sizeof(word));
+    contents[0] ^= 0xff;
+    rewrite("ephem-f", contents, len);
+    g_assert_null(result_cache_load("ephem-f", sizeof(guint64)));
+    g_assert_false(result_cache_has("ephem-f"));
+
+    /* records of another size */
+    store("ephem-f", 1, 10);
+    g_assert_null(result_cache_load("ephem-f", sizeof(guint32)));
+    g_assert_false(result_cache_has("ephem-f"));
+
+    g_free(contents);
+    g_free(path);
+}
+
+static void test_trim(void)
+{
+    gchar          *path;
+    GStatBuf        st;
+    GBytes         *bytes;
+
+    result_cache_invalidate(NULL);
+
+    store("ephem-a", 1, 100);
+    store("ephem-b", 2, 100);
+    store("ephem-c", 3, 100);
+    set_used("ephem-a", 1000);
+    set_used("ephem-b", 2000);
+    set_used("ephem-c", 3000);
+
+    path = entry_file("ephem-a");
+    g_assert_cmpint(g_stat(path, &st), ==, 0);
+    g_free(path);
+
+    /* a hit makes a the most recently used, so b goes first */
+    bytes = result_cache_load("ephem-a", sizeof(guint64));
+    g_assert_nonnull(bytes);
+    g_bytes_unref(bytes);
+
+    result_cache_trim(3 * (guint64) st.st_size);
+    g_assert_true(result_cache_has("ephem-a"));
+    g_assert_true(result_cache_has("ephem-b"));
+    g_assert_true(result_cache_has("ephem-c"));
+
+    result_cache_trim(2 * (guint64) st.st_size);
+    g_assert_true(result_cache_has("ephem-a"));
+    g_assert_false(result_cache_has("ephem-b"));
+    g_assert_true(result_cache_has("ephem-c"));
+
+    result_cache_trim((guint64) st.st_size);
+    g_assert_true(result_cache_has("ephem-a"));
+    g_assert_false(result_cache_has("ephem-c"));
+
+    result_cache_trim(0);
+    g_assert_false(result_cache_has("ephem-a"));
+}
+
+/* uses closer together than file times can tell apart keep their order */
+static void test_trim_fast(void)
+{
+    gchar          *path;
+    GStatBuf        st;
+    GBytes         *bytes;
+
+    result_cache_invalidate(NULL);
+
+    store("ephem-a", 1, 100);
+    store("ephem-b", 2, 100);
+    bytes = result_cache_load("ephem-a", sizeof(guint64));
+    g_assert_nonnull(bytes);
+    g_bytes_unref(bytes);
+    store("ephem-c", 3, 100);
+
+    path = entry_file("ephem-a");
+    g_assert_cmpint(g_stat(path, &st), ==, 0);
+    g_free(path);
+
+    result_cache_trim(2 * (guint64) st.st_size);
+    g_assert_true(result_cache_has("ephem-a"));
+    g_assert_false(result_cache_has("ephem-b"));
+    g_assert_true(result_cache_has("ephem-c"));
+}
+
+static void test_invalidate(void)
+{
+    const guint32   changed[] = { 7, 2 };
+
+    result_cache_invalidate(NULL);
+
+    store("ephem-1", 1, 10);
+    store("zone-1", 1, 10);
+    store("poi-2", 2, 10);
+    store("ephem-3", 3, 10);
+
+    /* by stage */
+    result_cache_invalidate("zone");
+    g_assert_false(result_cache_has("zone-1"));
+    g_assert_true(result_cache_has("ephem-1"));
+    g_assert_true(result_cache_has("poi-2"));
+
+    /* by satellite; an unreadable entry is of no use either */
+    rewrite("ephem-junk", "junk", 4);
+    result_cache_invalidate_sats(changed, G_N_ELEMENTS(changed));
+    g_assert_false(result_cache_has("poi-2"));
+    g_assert_false(result_cache_has("ephem-junk"));
+    g_assert_true(result_cache_has("ephem-1"));
+    g_assert_true(result_cache_has("ephem-3"));
+
+    /* all */
+    result_cache_invalidate(NULL);
+    g_assert_false(result_cache_has("ephem-1"));
+    g_assert_false(result_cache_has("ephem-3"));
+}
+
+static void test_input(void)
+{
+    result_cache_invalidate(NULL);
+
+    store("poi-x", 1, 10);
+    store("zone-x", 1, 10);
+
+    /* the first digest is only recorded, as is an unchanged one */
+    result_cache_set_input("poi", "data/Points.csv", "d1");
+    result_cache_set_input("poi", "data/Points.csv", "d1");
+    g_assert_true(result_cache_has("poi-x"));
+
+    /* the same file seen by another stage is recorded separately */
+    result_cache_set_input("zone", "data/Points.csv", "d2");
+    g_assert_true(result_cache_has("poi-x"));
+    g_assert_true(result_cache_has("zone-x"));
+
+    /* a changed file drops the entries of its stage only */
+    result_cache_set_input("poi", "other/Points.csv", "d2");
+    g_assert_false(result_cache_has("poi-x"));
+    g_assert_true(result_cache_has("zone-x"));
+}
+
+/* remove dir and what the tests left in it */
+static void remove_tree(const gchar * dir)
+{
+    GDir           *d = g_dir_open(dir, 0, NULL);
+    const gchar    *name;
+    gchar          *path;
+
+    while (d != NULL && (name = g_dir_read_name(d)) != NULL)
+    {
+        path = g_build_filename(dir, name, NULL);
+        if (g_file_test(path, G_FILE_TEST_IS_DIR))
+            remove_tree(path);
+        else
+            g_remove(path);
+        g_free(path);
+    }
+    if (d != NULL)
+        g_dir_close(d);
+    g_rmdir(dir);
+}
+
+int main(int argc, char **argv)
+{
+    gchar          *tmp;
+    int             rc;
+
+    /* keep the user's cache out of it */
+    tmp = g_dir_make_tmp("test-result-cache-XXXXXX", NULL);
+    g_assert_nonnull(tmp);
+    g_setenv("HOME", tmp, TRUE);
+    g_setenv("XDG_CONFIG_HOME", tmp, TRUE);
+
+    g_test_init(&argc, &argv, NULL);
+    sat_log_set_level(SAT_LOG_LEVEL_NONE);
+
+    g_test_add_func("/result-cache/load", test_load);
+    g_test_add_func("/result-cache/truncated", test_truncated);
+    g_test_add_func("/result-cache/foreign", test_foreign);
+    g_test_add_func("/result-cache/trim", test_trim);
+    g_test_add_func("/result-cache/trim-fast", test_trim_fast);
+    g_test_add_func("/result-cache/invalidate", test_invalidate);
+    g_test_add_func("/result-cache/input", test_input);
+
+    rc = g_test_run();
+
+    remove_tree(tmp);
+    g_free(tmp);
+
+    return rc;
+}
@@ -0,0 +1,82 @@
+/*
+  OGpredict — extensions to Gpredict for operations planning
+
+  Copyright (C) 2025 Axel Osika <osikaaxel@gmail.com>
+
+  This file is part of OGpredict, a derivative of Gpredict.
+
+  OGpredict is free software: you can redistribute it and/or modify it
+  under the terms of the GNU General Public License as published by the
+  Free Software Foundation; either version 2 of the License, or (at your
+  option) any later version.  See the GNU General Public License for details.
+*/
+
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/**
+ * test-result-index.c — time parsing of the result tables
+ *
+ * result_index_parse_time() reads both the times typed by the user and the
+ * time strings of the Tab 1 rows, so it must reject anything it cannot
+ * read completely instead of returning a partial or impossible date.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <build-config.h>
+#endif
+
+#include <glib.h>
+#include <math.h>
+
+#include "result-index.h"
+
+/* 2025-01-01 00:00:00 UTC */
+#define JD_2025 2460676.5
+
+static void assert_time(const gchar * text, gdouble expected)
+{
+    gdouble         jd = 0.0;
+
+    g_assert_true(result_index_parse_time(text, &jd));
+    g_assert_cmpfloat(fabs(jd - expected), <, 1.0e-8);
+}
+
+static void test_parse_valid(void)
+{
+    assert_time("2025/01/01", JD_2025);
+    assert_time("2025-01-01", JD_2025);
+    assert_time("2025/01/02 06", JD_2025 + 1.25);
+    assert_time("2025/01/01T12:30", JD_2025 + 0.5 + 30.0 / 1440.0);
+    assert_time("2025/01/01 00:00:01.5", JD_2025 + 1.5 / 86400.0);
+    assert_time("  2025/01/01 00:00:00  ", JD_2025);
+    assert_time("2024/02/29", JD_2025 - 307.0);
+}
+
+static void test_parse_invalid(void)
+{
+    const gchar    *bad[] = {
+        NULL, "", "2025", "2025/01", "2025/01-01", "2025.01.01",
+        "2025/02/29", "2025/02/31", "2025/04/31", "2025/13/01", "2025/00/01",
+        "2025/01/00", "2025/01/01x", "2025/01/01 12:00 junk",
+        "2025/01/01 12:00:00x", "2025/01/01 12:", "2025/01/01 24:00",
+        "2025/01/01 12:60", "2025/01/01 12:00:nan",
+    };
+    gdouble         jd = 42.0;
+    guint           i;
+
+    for (i = 0; i < G_N_ELEMENTS(bad); i++)
+    {
+        g_assert_false(result_index_parse_time(bad[i], &jd));
+        g_assert_cmpfloat(jd, ==, 42.0);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    g_test_init(&argc, &argv, NULL);
+
+    g_test_add_func("/result-index/parse-time", test_parse_valid);
+    g_test_add_func("/result-index/parse-time-invalid", test_parse_invalid);
+
+    return g_test_run();
+}
@@ -31,6 +31,11 @@
 gdouble  get_current_daynum  (void);
 //long     get_daynum_from_dmy (int d, int m, int y);
 int      daynum_to_str(char *s, size_t max, const char *format, gdouble jultime);
+void     jd_to_gregorian(double jd, int *year_out, int *month_out,
+                         int *day_out, int *hour_out, int *min_out,
+                         int *sec_out);
+double   gregorian_to_jd(int year, int month, int day,
+                         int hour, int min, double sec);
 #endif
 
 
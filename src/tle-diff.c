@@ -0,0 +1,844 @@
+/*
+  OGpredict — extensions to Gpredict for operations planning
+
+  Copyright (C) 2025 Axel Osika <osikaaxel@gmail.com>
+
+  This file is part of OGpredict, a derivative of Gpredict.
+
+  OGpredict is free software: you can redistribute it and/or modify it
+  under the terms of the GNU General Public License as published by the
+  Free Software Foundation; either version 2 of the License, or (at your
+  option) any later version.  See the GNU General Public License for details.
+*/
+
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/**
+ * tle-diff.c — TLE-age sensitivity of a satellite's predictions
+ *
+ * Trigger plans are computed from one element set; when a newer set arrives
+ * the question is whether the plan is still good. This module propagates
+ * the reference elements and any number of other sets for the same
+ * satellite over a common horizon and reports:
+ *
+ *   - the position differences in the radial / along-track / cross-track
+ *     frame of the reference orbit;
+ *   - the POI entry times predicted by each set, paired with the reference
+ *     entries, and the resulting trigger shifts.
+ *
+ * A set is flagged stale when a trigger moves by more than params.tol_sec or
+ * appears/disappears, i.e. when the plan must be regenerated.
+ *
+ * All sets are sampled on one shared time array (start + i * step). Each set
+ * is propagated by its own GThreadPool task into an index-addressed buffer;
+ * differences and trigger pairing are computed after the pool has drained,
+ * so the result does not depend on scheduling.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <build-config.h>
+#endif
+
+#include <glib/gi18n.h>
+#include <math.h>
+#include <string.h>
+
+#include "gtk-sat-data.h"
+#include "predict-tools.h"
+#include "sat-log.h"
+#include "sim-engine.h"
+#include "tle-diff.h"
+
+/** Time resolution of refined POI entries [days] (~0.1 s). */
+#define TLE_DIFF_REFINE_TOL 1.0e-6
+
+/** Samples between two cancellation checks. */
+#define TLE_DIFF_CANCEL_STRIDE 256
+
+/** Doubles stored per sample: position and velocity [km, km/s]. */
+#define TLE_DIFF_STATE 6
+
+/** A POI entry of one set. */
+typedef struct {
+    gint            poi;
+    gdouble         t;
+} TleDiffEntry;
+
+/** Everything the workers need; owned by the task, read-only while running. */
+typedef struct {
+    tle_diff_params_t params;
+    guint           nsamples;
+    gdouble        *times;
+    GArray         *tles;       /* tle_t; index 0 is the reference */
+    sim_tile_table_t *poi;      /* NULL when triggers are not compared */
+    tle_diff_progress_func progress;
+    gpointer        progress_data;
+    GMainContext   *context;    /* progress is invoked here, or NULL */
+    gint            done;       /* finished sets (atomic) */
+} TleDiffJob;
+
+/** Per-set work item and its index-addressed output. */
+typedef struct {
+    TleDiffJob     *job;
+    guint           index;
+    gdouble        *state;      /* TLE_DIFF_STATE doubles per sample */
+    GArray         *entries;    /* TleDiffEntry, by time */
+    GCancellable   *cancel;
+} TleDiffTask;
+
+/** A progress update queued on the caller's main context. */
+typedef struct {
+    tle_diff_progress_func func;
+    gpointer        data;
+    guint           done;
+    guint           total;
+} TleDiffProgress;
+
+
+void tle_diff_params_init(tle_diff_params_t * params, gdouble start)
+{
+    g_return_if_fail(params != NULL);
+
+    params->start = start;
+    params->duration = 1.0;
+    params->step_sec = 10.0;
+    params->pois = TRUE;
+    params->match_sec = 600.0;
+    params->tol_sec = 1.0;
+}
+
+/**
+ * Read all element sets of one satellite from a TLE file.
+ *
+ * @param fname The file; both 2-line and 3-line (named) sets are accepted.
+ * @param catnr The catalogue number to collect.
+ * @param sets GArray of tle_t the sets are appended to.
+ * @param error Location for a GError or NULL.
+ * @return The number of sets appended. Sets with bad checksums are skipped.
+ */
+guint tle_diff_load_file(const gchar * fname, gint catnr, GArray * sets,
+                         GError ** error)
+{
+    gchar          *contents;
+    gchar         **lines;
+    gint            last_l2 = -1;
+    guint           count = 0;
+    gint            i;
+
+    g_return_val_if_fail(fname != NULL && sets != NULL, 0);
+
+    if (!g_file_get_contents(fname, &contents, NULL, error))
+        return 0;
+
+    lines = g_strsplit(contents, "\n", -1);
+    g_free(contents);
+
+    for (i = 0; lines[i] != NULL; i++)
+        g_strchomp(lines[i]);
+
+    for (i = 0; lines[i] != NULL && lines[i + 1] != NULL; i++)
+    {
+        gchar           tle_lines[3][80];
+        tle_t           tle;
+
+        if (lines[i][0] != '1' || lines[i + 1][0] != '2' ||
+            strlen(lines[i]) < 69 || strlen(lines[i + 1]) < 69)
+            continue;
+
+        /* the line before is the name unless it ends the previous set */
+        if (i > 0 && i - 1 != last_l2 && lines[i - 1][0] != '\0')
+            g_strlcpy(tle_lines[0], lines[i - 1], sizeof(tle_lines[0]));
+        else
+            g_snprintf(tle_lines[0], sizeof(tle_lines[0]), "%d", catnr);
+        g_strlcpy(tle_lines[1], lines[i], sizeof(tle_lines[1]));
+        g_strlcpy(tle_lines[2], lines[i + 1], sizeof(tle_lines[2]));
+
+        memset(&tle, 0, sizeof(tle));
+        if (Get_Next_Tle_Set(tle_lines, &tle) != 1)
+        {
+            sat_log_log(SAT_LOG_LEVEL_DEBUG,
+                        _("%s: Skipping bad element set at %s:%d"),
+                        __func__, fname, i + 1);
+            continue;
+        }
+
+        if (tle.catnr == catnr)
+        {
+            g_array_append_val(sets, tle);
+            count++;
+        }
+
+        last_l2 = i + 1;
+        i++;
+    }
+
+    g_strfreev(lines);
+
+    return count;
+}
+
+/**
+ * Find the time where the POI state changes between t0 and t1.
+ *
+ * Same contract as the simulation engine: the state at t0 is s0 and the
+ * first time with a different state is returned.
+ */
+static gdouble tle_diff_refine(const TleDiffJob * job, sat_t * sat,
+                               qth_t * qth, gint s0, gdouble t0, gdouble t1)
+{
+    gdouble         tm;
+
+    while (t1 - t0 > TLE_DIFF_REFINE_TOL)
+    {
+        tm = 0.5 * (t0 + t1);
+        predict_calc(sat, qth, tm);
+        if (sim_tile_table_lookup(job->poi, sat->ssplat, sat->ssplon) == s0)
+            t0 = tm;
+        else
+            t1 = tm;
+    }
+
+    return t1;
+}
+
+static gboolean tle_diff_report_progress_idle(gpointer data)
+{
+    TleDiffProgress *up = data;
+
+    up->func(up->done, up->total, up->data);
+
+    return G_SOURCE_REMOVE;
+}
+
+static void tle_diff_report_progress(TleDiffJob * job)
+{
+    TleDiffProgress *up;
+    guint           done = (guint) g_atomic_int_add(&job->done, 1) + 1;
+
+    if (job->progress == NULL)
+        return;
+
+    if (job->context == NULL)
+    {
+        job->progress(done, job->tles->len, job->progress_data);
+        return;
+    }
+
+    up = g_new(TleDiffProgress, 1);
+    up->func = job->progress;
+    up->data = job->progress_data;
+    up->done = done;
+    up->total = job->tles->len;
+    g_main_context_invoke_full(job->context, G_PRIORITY_DEFAULT,
+                               tle_diff_report_progress_idle, up, g_free);
+}
+
+/** Propagate one element set over the shared time array. */
+static void tle_diff_worker(gpointer data, gpointer user_data)
+{
+    TleDiffTask    *task = data;
+    TleDiffJob     *job = task->job;
+    qth_t           qth;
+    sat_t           sat;
+    gint            poi, poi_prev = -1;
+    guint           i;
+
+    (void)user_data;
+
+    /* positions are compared in ECI; the observer is irrelevant */
+    memset(&qth, 0, sizeof(qth));
+    memset(&sat, 0, sizeof(sat));
+    sat.tle = g_array_index(job->tles, tle_t, task->index);
+    select_ephemeris(&sat);
+    gtk_sat_data_init_sat(&sat, &qth);
+
+    for (i = 0; i < job->nsamples; i++)
+    {
+        gdouble        *s = task->state + (gsize) i * TLE_DIFF_STATE;
+
+        if ((i % TLE_DIFF_CANCEL_STRIDE) == 0 &&
+            g_cancellable_is_cancelled(task->cancel))
+            return;
+
+        predict_calc(&sat, &qth, job->times[i]);
+        s[0] = sat.pos.x;
+        s[1] = sat.pos.y;
+        s[2] = sat.pos.z;
+        s[3] = sat.vel.x;
+        s[4] = sat.vel.y;
+        s[5] = sat.vel.z;
+
+        if (job->poi == NULL)
+            continue;
+
+        poi = sim_tile_table_lookup(job->poi, sat.ssplat, sat.ssplon);
+        if (i > 0 && poi != poi_prev && poi >= 0)
+        {
+            TleDiffEntry    e;
+
+            e.poi = poi;
+            e.t = tle_diff_refine(job, &sat, &qth, poi_prev,
+                                  job->times[i - 1], job->times[i]);
+            g_array_append_val(task->entries, e);
+        }
+        poi_prev = poi;
+    }
+
+    tle_diff_report_progress(job);
+}
+
+/**
+ * Express cur - ref in the radial / along-track / cross-track frame.
+ *
+ * The frame is built from the reference position r and velocity v:
+ * R = r/|r|, C = (r x v)/|r x v|, A = C x R.
+ */
+static void tle_diff_ric(const gdouble * ref, const gdouble * cur,
+                         gdouble * radial, gdouble * along, gdouble * cross)
+{
+    gdouble         h[3], a[3], d[3];
+    gdouble         rn, hn;
+
+    rn = sqrt(ref[0] * ref[0] + ref[1] * ref[1] + ref[2] * ref[2]);
+    h[0] = ref[1] * ref[5] - ref[2] * ref[4];
+    h[1] = ref[2] * ref[3] - ref[0] * ref[5];
+    h[2] = ref[0] * ref[4] - ref[1] * ref[3];
+    hn = sqrt(h[0] * h[0] + h[1] * h[1] + h[2] * h[2]);
+
+    if (rn <= 0.0 || hn <= 0.0)
+    {
+        *radial = *along = *cross = 0.0;
+        return;
+    }
+
+    h[0] /= hn;
+    h[1] /= hn;
+    h[2] /= hn;
+
+    /* A = C x R, with R = ref / rn */
+    a[0] = (h[1] * ref[2] - h[2] * ref[1]) / rn;
+    a[1] = (h[2] * ref[0] - h[0] * ref[2]) / rn;
+    a[2] = (h[0] * ref[1] - h[1] * ref[0]) / rn;
+
+    d[0] = cur[0] - ref[0];
+    d[1] = cur[1] - ref[1];
+    d[2] = cur[2] - ref[2];
+
+    *radial = (d[0] * ref[0] + d[1] * ref[1] + d[2] * ref[2]) / rn;
+    *along = d[0] * a[0] + d[1] * a[1] + d[2] * a[2];
+    *cross = d[0] * h[0] + d[1] * h[1] + d[2] * h[2];
+}
+
+static gdouble trigger_time(const tle_diff_trigger_t * t)
+{
+    return t->t_ref > 0.0 ? t->t_ref : t->t_set;
+}
+
+static gint trigger_cmp(gconstpointer a, gconstpointer b)
+{
+    gdouble         ta = trigger_time(a);
+    gdouble         tb = trigger_time(b);
+
+    if (ta < tb)
+        return -1;
+
+    return ta > tb ? 1 : 0;
+}
+
+/**
+ * Pair the POI entries of a set with the reference entries.
+ *
+ * Both lists are sorted by time. Each reference entry is paired with the
+ * closest unused entry of the same POI within params.match_sec; whatever is
+ * left on either side is reported as unmatched.
+ */
+static void tle_diff_match(const tle_diff_params_t * p, GArray * ref,
+                           GArray * cur, tle_diff_set_t * set)
+{
+    gboolean       *used = g_new0(gboolean, cur->len + 1);
+    gdouble         win = p->match_sec / 86400.0;
+    guint           i, j, lo = 0;
+
+    for (i = 0; i < ref->len; i++)
+    {
+        const TleDiffEntry *e = &g_array_index(ref, TleDiffEntry, i);
+        tle_diff_trigger_t trg;
+        gint            best = -1;
+        gdouble         best_dt = win;
+
+        while (lo < cur->len &&
+               g_array_index(cur, TleDiffEntry, lo).t < e->t - win)
+            lo++;
+
+        for (j = lo; j < cur->len; j++)
+        {
+            const TleDiffEntry *c = &g_array_index(cur, TleDiffEntry, j);
+
+            if (c->t > e->t + win)
+                break;
+            if (used[j] || c->poi != e->poi)
+                continue;
+            if (fabs(c->t - e->t) <= best_dt)
+            {
+                best_dt = fabs(c->t - e->t);
+                best = (gint) j;
+            }
+        }
+
+        trg.poi = e->poi;
+        trg.t_ref = e->t;
+        trg.t_set = 0.0;
+        if (best >= 0)
+        {
+            used[best] = TRUE;
+            trg.t_set = g_array_index(cur, TleDiffEntry, best).t;
+            set->max_shift = MAX(set->max_shift, best_dt * 86400.0);
+        }
+        else
+        {
+            set->unmatched++;
+        }
+        g_array_append_val(set->triggers, trg);
+    }
+
+    for (j = 0; j < cur->len; j++)
+    {
+        const TleDiffEntry *c = &g_array_index(cur, TleDiffEntry, j);
+        tle_diff_trigger_t trg;
+
+        if (used[j])
+            continue;
+
+        trg.poi = c->poi;
+        trg.t_ref = 0.0;
+        trg.t_set = c->t;
+        g_array_append_val(set->triggers, trg);
+        set->unmatched++;
+    }
+
+    g_array_sort(set->triggers, trigger_cmp);
+    g_free(used);
+}
+
+static void tle_diff_job_free(gpointer data)
+{
+    TleDiffJob     *job = data;
+
+    if (job == NULL)
+        return;
+
+    g_free(job->times);
+    g_array_unref(job->tles);
+    sim_tile_table_free(job->poi);
+    if (job->context)
+        g_main_context_unref(job->context);
+    g_free(job);
+}
+
+static gint tle_epoch_cmp(gconstpointer a, gconstpointer b)
+{
+    const tle_t    *ta = a;
+    const tle_t    *tb = b;
+
+    if (ta->epoch < tb->epoch)
+        return -1;
+
+    return ta->epoch > tb->epoch ? 1 : 0;
+}
+
+/**
+ * Snapshot everything the workers need.
+ *
+ * Must be called from the main loop (POI tiles). The reference comes first;
+ * the other sets follow by epoch, and sets with the same epoch as one
+ * already taken are dropped.
+ */
+static TleDiffJob *tle_diff_job_new(const tle_t * ref, GArray * sets,
+                                    const tle_diff_params_t * params)
+{
+    TleDiffJob     *job = g_new0(TleDiffJob, 1);
+    GArray         *sorted;
+    gdouble         step = params->step_sec / 86400.0;
+    guint           i, k;
+
+    job->params = *params;
+    job->nsamples = (guint) floor(params->duration * 86400.0 /
+                                  params->step_sec) + 1;
+    job->times = g_new(gdouble, job->nsamples);
+    for (i = 0; i < job->nsamples; i++)
+        job->times[i] = params->start + (gdouble) i * step;
+
+    sorted = g_array_sized_new(FALSE, FALSE, sizeof(tle_t), sets->len);
+    g_array_append_vals(sorted, sets->data, sets->len);
+    g_array_sort(sorted, tle_epoch_cmp);
+
+    job->tles = g_array_sized_new(FALSE, FALSE, sizeof(tle_t),
+                                  sets->len + 1);
+    g_array_append_vals(job->tles, ref, 1);
+    for (i = 0; i < sorted->len; i++)
+    {
+        const tle_t    *tle = &g_array_index(sorted, tle_t, i);
+        gboolean        dup = FALSE;
+
+        for (k = 0; k < job->tles->len && !dup; k++)
+            dup = (g_array_index(job->tles, tle_t, k).epoch == tle->epoch);
+
+        if (!dup)
+            g_array_append_vals(job->tles, tle, 1);
+    }
+    g_array_unref(sorted);
+
+    if (params->pois)
+        job->poi = sim_tile_table_new_pois();
+
+    return job;
+}
+
+static tle_diff_t *tle_diff_job_execute(TleDiffJob * job,
+                                        GCancellable * cancel)
+{
+    tle_diff_t     *diff;
+    TleDiffTask    *tasks;
+    GThreadPool    *pool;
+    guint           nsets = job->tles->len;
+    guint           nthreads;
+    guint           i, k;
+
+    tasks = g_new0(TleDiffTask, nsets);
+    nthreads = CLAMP((guint) g_get_num_processors(), 1, 8);
+    pool = g_thread_pool_new(tle_diff_worker, NULL, (gint) nthreads, FALSE,
+                             NULL);
+    for (k = 0; k < nsets; k++)
+    {
+        tasks[k].job = job;
+        tasks[k].index = k;
+        tasks[k].state = g_new(gdouble,
+                               (gsize) job->nsamples * TLE_DIFF_STATE);
+        tasks[k].entries = g_array_new(FALSE, FALSE, sizeof(TleDiffEntry));
+        tasks[k].cancel = cancel;
+        g_thread_pool_push(pool, &tasks[k], NULL);
+    }
+    g_thread_pool_free(pool, FALSE, TRUE);      /* wait for completion */
+
+    diff = g_new0(tle_diff_t, 1);
+    diff->params = job->params;
+    diff->nsamples = job->nsamples;
+    diff->times = g_new(gdouble, job->nsamples);
+    memcpy(diff->times, job->times, sizeof(gdouble) * job->nsamples);
+    diff->nsets = nsets;
+    diff->sets = g_new0(tle_diff_set_t, nsets);
+    diff->pois = job->poi ? g_ptr_array_ref(job->poi->names) :
+        g_ptr_array_new_with_free_func(g_free);
+
+    for (k = 0; k < nsets && !g_cancellable_is_cancelled(cancel); k++)
+    {
+        tle_diff_set_t *set = &diff->sets[k];
+        gdouble         sum = 0.0;
+
+        set->tle = g_array_index(job->tles, tle_t, k);
+        set->epoch = Julian_Date_of_Epoch(set->tle.epoch);
+        set->radial = g_new0(gdouble, job->nsamples);
+        set->along = g_new0(gdouble, job->nsamples);
+        set->cross = g_new0(gdouble, job->nsamples);
+        set->triggers = g_array_new(FALSE, FALSE,
+                                    sizeof(tle_diff_trigger_t));
+
+        for (i = 0; i < job->nsamples; i++)
+        {
+            tle_diff_ric(tasks[0].state + (gsize) i * TLE_DIFF_STATE,
+                         tasks[k].state + (gsize) i * TLE_DIFF_STATE,
+                         &set->radial[i], &set->along[i], &set->cross[i]);
+            set->max_radial = MAX(set->max_radial, fabs(set->radial[i]));
+            set->max_along = MAX(set->max_along, fabs(set->along[i]));
+            set->max_cross = MAX(set->max_cross, fabs(set->cross[i]));
+            sum += set->along[i] * set->along[i];
+        }
+        set->rms_along = sqrt(sum / job->nsamples);
+
+        tle_diff_match(&job->params, tasks[0].entries, tasks[k].entries,
+                       set);
+        set->stale = (set->max_shift > job->params.tol_sec ||
+                      set->unmatched > 0);
+    }
+
+    for (k = 0; k < nsets; k++)
+    {
+        g_free(tasks[k].state);
+        g_array_unref(tasks[k].entries);
+    }
+    g_free(tasks);
+
+    return diff;
+}
+
+static gboolean tle_diff_valid(GArray * sets,
+                               const tle_diff_params_t * params,
+                               GError ** error)
+{
+    if (params->duration <= 0.0 || params->step_sec <= 0.0)
+    {
+        g_set_error(error, G_IO_ERROR, G_IO_ERROR_INVALID_ARGUMENT,
+                    _("Invalid comparison interval (%.3f days, %.1f s step)"),
+                    params->duration, params->step_sec);
+        return FALSE;
+    }
+
+    if (sets == NULL || sets->len == 0)
+    {
+        g_set_error(error, G_IO_ERROR, G_IO_ERROR_INVALID_ARGUMENT,
+                    _("No element sets to compare"));
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+/**
+ * Compare element sets synchronously.
+ *
+ * @param ref The reference elements, usually those the plan was made with.
+ * @param sets GArray of tle_t for the same satellite.
+ * @param params Comparison parameters.
+ * @param cancel Optional cancellable.
+ * @param progress Optional progress callback, called from worker threads.
+ * @param progress_data User data for progress.
+ * @param error Location for a GError or NULL.
+ * @return A new result or NULL on error/cancellation.
+ *
+ * Must be called from the main loop (see tle_diff_run_async() for the
+ * background variant).
+ */
+tle_diff_t     *tle_diff_run(const tle_t * ref, GArray * sets,
+                             const tle_diff_params_t * params,
+                             GCancellable * cancel,
+                             tle_diff_progress_func progress,
+                             gpointer progress_data, GError ** error)
+{
+    TleDiffJob     *job;
+    tle_diff_t     *diff;
+
+    g_return_val_if_fail(ref != NULL && params != NULL, NULL);
+
+    if (!tle_diff_valid(sets, params, error))
+        return NULL;
+
+    job = tle_diff_job_new(ref, sets, params);
+    job->progress = progress;
+    job->progress_data = progress_data;
+    diff = tle_diff_job_execute(job, cancel);
+    tle_diff_job_free(job);
+
+    if (g_cancellable_set_error_if_cancelled(cancel, error))
+    {
+        tle_diff_free(diff);
+        return NULL;
+    }
+
+    return diff;
+}
+
+static void tle_diff_task_thread(GTask * task, gpointer source_object,
+                                 gpointer task_data, GCancellable * cancel)
+{
+    tle_diff_t     *diff;
+
+    (void)source_object;
+
+    diff = tle_diff_job_execute(task_data, cancel);
+    if (g_task_return_error_if_cancelled(task))
+    {
+        tle_diff_free(diff);
+        return;
+    }
+
+    g_task_return_pointer(task, diff, (GDestroyNotify) tle_diff_free);
+}
+
+/**
+ * Compare element sets in a worker thread.
+ *
+ * The sets and POI tiles are copied before this function returns. Progress
+ * is reported in the thread-default main context of the caller, before
+ * callback is invoked.
+ */
+void tle_diff_run_async(const tle_t * ref, GArray * sets,
+                        const tle_diff_params_t * params,
+                        GCancellable * cancel,
+                        tle_diff_progress_func progress,
+                        gpointer progress_data,
+                        GAsyncReadyCallback callback, gpointer user_data)
+{
+    GTask          *task;
+    TleDiffJob     *job;
+    GError         *error = NULL;
+
+    g_return_if_fail(ref != NULL && params != NULL);
+
+    task = g_task_new(NULL, cancel, callback, user_data);
+    g_task_set_source_tag(task, tle_diff_run_async);
+
+    if (!tle_diff_valid(sets, params, &error))
+    {
+        g_task_return_error(task, error);
+        g_object_unref(task);
+        return;
+    }
+
+    job = tle_diff_job_new(ref, sets, params);
+    job->progress = progress;
+    job->progress_data = progress_data;
+    job->context = g_main_context_ref_thread_default();
+
+    g_task_set_task_data(task, job, tle_diff_job_free);
+    g_task_run_in_thread(task, tle_diff_task_thread);
+    g_object_unref(task);
+}
+
+tle_diff_t     *tle_diff_run_finish(GAsyncResult * res, GError ** error)
+{
+    g_return_val_if_fail(g_task_is_valid(res, NULL), NULL);
+
+    return g_task_propagate_pointer(G_TASK(res), error);
+}
+
+void tle_diff_free(tle_diff_t * diff)
+{
+    guint           k;
+
+    if (diff == NULL)
+        return;
+
+    for (k = 0; k < diff->nsets; k++)
+    {
+        g_free(diff->sets[k].radial);
+        g_free(diff->sets[k].along);
+        g_free(diff->sets[k].cross);
+        if (diff->sets[k].triggers)
+            g_array_unref(diff->sets[k].triggers);
+    }
+    g_free(diff->sets);
+    g_free(diff->times);
+    if (diff->pois)
+        g_ptr_array_unref(diff->pois);
+    g_free(diff);
+}
+
+/** Format a Julian date as UTC. */
+static gchar   *tle_diff_jd_to_str(gdouble jd)
+{
+    GDateTime      *dt;
+    gchar          *str;
+
+    dt = g_date_time_new_from_unix_utc((gint64)
+                                       floor((jd - 2440587.5) * 86400.0 +
+                                             0.5));
+    if (dt == NULL)
+        return g_strdup("-");
+
+    str = g_date_time_format(dt, "%Y/%m/%d %H:%M:%S");
+    g_date_time_unref(dt);
+
+    return str;
+}
+
+static const gchar *tle_diff_poi_name(const tle_diff_t * diff, gint poi)
+{
+    if (poi >= 0 && (guint) poi < diff->pois->len)
+        return g_ptr_array_index(diff->pois, poi);
+
+    return "?";
+}
+
+/**
+ * Render a plain text report.
+ *
+ * One summary line per set, followed by the triggers that moved by more
+ * than params.tol_sec for every stale set.
+ */
+gchar          *tle_diff_report(const tle_diff_t * diff)
+{
+    GString        *str;
+    gchar          *t0, *t1, *ts;
+    guint           k, i;
+
+    g_return_val_if_fail(diff != NULL && diff->nsets > 0, NULL);
+
+    str = g_string_new(NULL);
+    t0 = tle_diff_jd_to_str(diff->times[0]);
+    t1 = tle_diff_jd_to_str(diff->times[diff->nsamples - 1]);
+    g_string_append_printf(str, _("Satellite: %.24s (%d)\n"),
+                           diff->sets[0].tle.sat_name,
+                           diff->sets[0].tle.catnr);
+    g_string_append_printf(str,
+                           _("Horizon: %s - %s UTC, %.0f s step, "
+                             "%u samples\n"), t0, t1,
+                           diff->params.step_sec, diff->nsamples);
+    g_free(t0);
+    g_free(t1);
+
+    g_string_append(str,
+                    _("\n#  Epoch (UTC)          dEpoch[h]  "
+                      "Radial  Along   Cross  RMS along [km]  "
+                      "Shift[s]  Unmatched  Plan\n"));
+    for (k = 0; k < diff->nsets; k++)
+    {
+        const tle_diff_set_t *set = &diff->sets[k];
+
+        ts = tle_diff_jd_to_str(set->epoch);
+        g_string_append_printf(str,
+                               "%-2u %s %+9.2f %7.3f %7.3f %7.3f %15.3f "
+                               "%9.1f %10u  %s\n", k, ts,
+                               (set->epoch - diff->sets[0].epoch) * 24.0,
+                               set->max_radial, set->max_along,
+                               set->max_cross, set->rms_along,
+                               set->max_shift, set->unmatched,
+                               k == 0 ? _("reference") :
+                               (set->stale ? _("REGENERATE") : _("ok")));
+        g_free(ts);
+    }
+
+    for (k = 1; k < diff->nsets; k++)
+    {
+        const tle_diff_set_t *set = &diff->sets[k];
+
+        if (!set->stale)
+            continue;
+
+        g_string_append_printf(str, _("\nTriggers moved by set %u:\n"), k);
+        for (i = 0; i < set->triggers->len; i++)
+        {
+            const tle_diff_trigger_t *trg =
+                &g_array_index(set->triggers, tle_diff_trigger_t, i);
+
+            if (trg->t_ref > 0.0 && trg->t_set > 0.0)
+            {
+                gdouble         shift = (trg->t_set - trg->t_ref) * 86400.0;
+
+                if (fabs(shift) <= diff->params.tol_sec)
+                    continue;
+
+                ts = tle_diff_jd_to_str(trg->t_ref);
+                g_string_append_printf(str, _("  %s  %-24s %+8.1f s\n"),
+                                       ts, tle_diff_poi_name(diff, trg->poi),
+                                       shift);
+            }
+            else if (trg->t_ref > 0.0)
+            {
+                ts = tle_diff_jd_to_str(trg->t_ref);
+                g_string_append_printf(str, _("  %s  %-24s only predicted "
+                                              "by the reference\n"),
+                                       ts, tle_diff_poi_name(diff, trg->poi));
+            }
+            else
+            {
+                ts = tle_diff_jd_to_str(trg->t_set);
+                g_string_append_printf(str, _("  %s  %-24s only predicted "
+                                              "by this set\n"),
+                                       ts, tle_diff_poi_name(diff, trg->poi));
+            }
+            g_free(ts);
+        }
+    }
+
+    return g_string_free(str, FALSE);
+}
@@ -0,0 +1,119 @@
+/*
+  OGpredict — extensions to Gpredict for operations planning
+
+  Copyright (C) 2025 Axel Osika <osikaaxel@gmail.com>
+
+  This file is part of OGpredict, a derivative of Gpredict.
+
+  OGpredict is free software: you can redistribute it and/or modify it
+  under the terms of the GNU General Public License as published by the
+  Free Software Foundation; either version 2 of the License, or (at your
+  option) any later version.  See the GNU General Public License for details.
+*/
+
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#ifndef __TLE_DIFF_H__
+#define __TLE_DIFF_H__ 1
+
+#include <gio/gio.h>
+#include <glib.h>
+
+#include "sgpsdp/sgp4sdp4.h"
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/** TLE comparison parameters. */
+typedef struct {
+    gdouble         start;      /*!< Start time (Julian date) */
+    gdouble         duration;   /*!< Horizon in days */
+    gdouble         step_sec;   /*!< Sampling step in seconds */
+    gboolean        pois;       /*!< Compare POI trigger times */
+    gdouble         match_sec;  /*!< Max. shift for pairing two POI entries */
+    gdouble         tol_sec;    /*!< Trigger shift that makes a plan stale */
+} tle_diff_params_t;
+
+/** A POI entry predicted by the reference and/or the compared set. */
+typedef struct {
+    gint            poi;        /*!< POI tile index */
+    gdouble         t_ref;      /*!< Entry time with the reference or 0.0 */
+    gdouble         t_set;      /*!< Entry time with the compared set or 0.0 */
+} tle_diff_trigger_t;
+
+/**
+ * One element set and its differences to the reference.
+ *
+ * Differences are position(set) - position(reference) in km, expressed in
+ * the radial / along-track / cross-track frame of the reference orbit, one
+ * value per sample of tle_diff_t.times.
+ */
+typedef struct {
+    tle_t           tle;        /*!< The elements */
+    gdouble         epoch;      /*!< Epoch (Julian date) */
+    gdouble        *radial;     /*!< Radial difference [km] */
+    gdouble        *along;      /*!< Along-track difference [km] */
+    gdouble        *cross;      /*!< Cross-track difference [km] */
+    gdouble         max_radial; /*!< Largest |radial| [km] */
+    gdouble         max_along;  /*!< Largest |along| [km] */
+    gdouble         max_cross;  /*!< Largest |cross| [km] */
+    gdouble         rms_along;  /*!< RMS of the along-track difference [km] */
+    GArray         *triggers;   /*!< tle_diff_trigger_t, by time */
+    gdouble         max_shift;  /*!< Largest paired trigger shift [s] */
+    guint           unmatched;  /*!< Entries predicted by only one set */
+    gboolean        stale;      /*!< Plans made with the reference must be
+                                     regenerated if this set is used */
+} tle_diff_set_t;
+
+/** Result of a comparison; sets[0] is the reference. */
+typedef struct {
+    tle_diff_params_t params;
+    guint           nsamples;   /*!< Number of samples */
+    gdouble        *times;      /*!< Sample times shared by all sets */
+    guint           nsets;      /*!< Number of sets, including the reference */
+    tle_diff_set_t *sets;       /*!< Reference followed by the others by epoch */
+    GPtrArray      *pois;       /*!< POI names, by tile index */
+} tle_diff_t;
+
+/**
+ * Progress callback, called once per finished element set.
+ *
+ * With tle_diff_run() it is called from the worker threads; with
+ * tle_diff_run_async() it is called in the thread-default main context of
+ * the caller.
+ */
+typedef void    (*tle_diff_progress_func) (guint done, guint total,
+                                           gpointer data);
+
+void            tle_diff_params_init(tle_diff_params_t * params,
+                                     gdouble start);
+guint           tle_diff_load_file(const gchar * fname, gint catnr,
+                                   GArray * sets, GError ** error);
+
+tle_diff_t     *tle_diff_run(const tle_t * ref, GArray * sets,
+                             const tle_diff_params_t * params,
+                             GCancellable * cancel,
+                             tle_diff_progress_func progress,
+                             gpointer progress_data, GError ** error);
+void            tle_diff_run_async(const tle_t * ref, GArray * sets,
+                                   const tle_diff_params_t * params,
+                                   GCancellable * cancel,
+                                   tle_diff_progress_func progress,
+                                   gpointer progress_data,
+                                   GAsyncReadyCallback callback,
+                                   gpointer user_data);
+tle_diff_t     *tle_diff_run_finish(GAsyncResult * res, GError ** error);
+
+void            tle_diff_free(tle_diff_t * diff);
+gchar          *tle_diff_report(const tle_diff_t * diff);
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+}
+#endif
+/* *INDENT-ON* */
+
+#endif
@@ -32,14 +32,9 @@
 #ifdef HAVE_CONFIG_H
 #include <build-config.h>
 #endif
-#ifdef WIN32
-#include "win32-fetch.h"
-#else
-#include <curl/curl.h>
-#endif
-
 #include "compat.h"
 #include "gpredict-utils.h"
+#include "http-fetch.h"
 #include "sat-cfg.h"
 #include "sat-log.h"
 #include "sgpsdp/sgp4sdp4.h"
@@ -47,10 +42,6 @@
 
 
 /* private function prototypes */
-#ifndef WIN32
-static size_t   my_write_func(void *ptr, size_t size, size_t nmemb,
-                              FILE * stream);
-#endif
 static gint     read_fresh_tle(const gchar * dir, const gchar * fnam,
                                GHashTable * data);
 static gboolean is_tle_file(const gchar * dir, const gchar * fnam);
@@ -66,6 +57,9 @@ static void     update_tle_in_file(const gchar * ldname,
 static guint    add_new_sats(GHashTable * data);
 static gboolean is_computer_generated_name(gchar * satname);
 
+/* held while fresh data is applied to the local database */
+static GMutex   tle_file_in_progress;
+
 
 /** Free a new_tle_t structure. */
 static void free_new_tle(gpointer data)
@@ -81,58 +75,32 @@ static void free_new_tle(gpointer data)
     g_free(tle);
 }
 
+/** Store the time of the last successful update. */
+static void store_update_time(void)
+{
+    gint64          now;
+
+    now = g_get_real_time() / G_USEC_PER_SEC;
+    sat_cfg_set_int(SAT_CFG_INT_TLE_LAST_UPDATE, now);
+}
 
 /**
- * Update TLE files from local files.
+ * Read the fresh TLE data in every TLE file of a directory.
  *
  * @param dir Directory where files are located.
- * @param filter File filter, e.g. *.txt (not used at the moment!)
+ * @param data Hash table receiving the fresh TLE data.
  * @param silent TRUE if function should execute without graphical status indicator.
  * @param label1 Activity label (can be NULL)
- * @param label2 Statistics label (can be NULL)
- * @param progress Pointer to progress indicator.
- * @param init_prgs Initial value of progress indicator, e.g 0.5 if we are updating
- *                  from network.
- *
- * This function is used to update the TLE data from local files.
+ * @return FALSE if the directory could not be opened.
  */
-void tle_update_from_files(const gchar * dir, const gchar * filter,
-                           gboolean silent, GtkWidget * progress,
-                           GtkWidget * label1, GtkWidget * label2)
+static gboolean read_fresh_dir(const gchar * dir, GHashTable * data,
+                               gboolean silent, GtkWidget * label1)
 {
-    static GMutex   tle_file_in_progress;
-
-    GHashTable     *data;       /* hash table with fresh TLE data */
     GDir           *cache_dir;  /* directory to scan fresh TLE */
-    GDir           *loc_dir;    /* directory for gpredict TLE files */
     GError         *err = NULL;
     gchar          *text;
-    gchar          *ldname;
-    gchar          *userconfdir;
     const gchar    *fnam;
     guint           num = 0;
-    guint           updated, updated_tmp;
-    guint           skipped, skipped_tmp;
-    guint           nodata, nodata_tmp;
-    guint           newsats = 0;
-    guint           total, total_tmp;
-    gdouble         fraction = 0.0;
-    gdouble         start = 0.0;
-
-    (void)filter;
-
-    if (g_mutex_trylock(&tle_file_in_progress) == FALSE)
-    {
-        sat_log_log(SAT_LOG_LEVEL_ERROR,
-                    _
-                    ("%s: A TLE update process is already running. Aborting."),
-                    __func__);
-        return;
-    }
-
-    /* create hash table */
-    data = g_hash_table_new_full(g_int_hash, g_int_equal, g_free,
-                                 free_new_tle);
 
     /* open directory and read files one by one */
     cache_dir = g_dir_open(dir, 0, &err);
@@ -155,265 +123,329 @@ void tle_update_from_files(const gchar * dir, const gchar * filter,
         }
 
         g_clear_error(&err);
-        err = NULL;
+        return FALSE;
     }
-    else
+
+    /* scan directory for tle files */
+    while ((fnam = g_dir_read_name(cache_dir)) != NULL)
     {
-        /* scan directory for tle files */
-        while ((fnam = g_dir_read_name(cache_dir)) != NULL)
+        /* check that we got a TLE file */
+        if (is_tle_file(dir, fnam))
         {
-            /* check that we got a TLE file */
-            if (is_tle_file(dir, fnam))
+            /* status message */
+            if (!silent && (label1 != NULL))
             {
-                /* status message */
-                if (!silent && (label1 != NULL))
-                {
-                    text = g_strdup_printf(_("Reading data from %s"), fnam);
-                    gtk_label_set_text(GTK_LABEL(label1), text);
-                    g_free(text);
-
-                    /* Force the drawing queue to be processed otherwise there will
-                       not be any visual feedback, ie. frozen GUI
-                       - see Gtk+ FAQ http://www.gtk.org/faq/#AEN602
-                     */
-                    while (g_main_context_iteration(NULL, FALSE));
+                text = g_strdup_printf(_("Reading data from %s"), fnam);
+                gtk_label_set_text(GTK_LABEL(label1), text);
+                g_free(text);
 
-                    /* give user a chance to follow progress */
-                    g_usleep(G_USEC_PER_SEC / 100);
-                }
+                /* Force the drawing queue to be processed otherwise there will
+                   not be any visual feedback, ie. frozen GUI
+                   - see Gtk+ FAQ http://www.gtk.org/faq/#AEN602
+                 */
+                while (g_main_context_iteration(NULL, FALSE));
 
-                /* now, do read the fresh data */
-                num = read_fresh_tle(dir, fnam, data);
-            }
-            else
-            {
-                num = 0;
+                /* give user a chance to follow progress */
+                g_usleep(G_USEC_PER_SEC / 100);
             }
 
-            if (num < 1)
-            {
-                sat_log_log(SAT_LOG_LEVEL_ERROR,
-                            _("%s: No valid TLE data found in %s"),
-                            __func__, fnam);
-            }
-            else
-            {
-                sat_log_log(SAT_LOG_LEVEL_INFO,
-                            _("%s: Read %d sats from %s into memory"),
-                            __func__, num, fnam);
-            }
+            /* now, do read the fresh data */
+            num = read_fresh_tle(dir, fnam, data);
+        }
+        else
+        {
+            num = 0;
         }
 
-        /* close directory since we don't need it anymore */
-        g_dir_close(cache_dir);
+        if (num < 1)
+        {
+            sat_log_log(SAT_LOG_LEVEL_ERROR,
+                        _("%s: No valid TLE data found in %s"),
+                        __func__, fnam);
+        }
+        else
+        {
+            sat_log_log(SAT_LOG_LEVEL_INFO,
+                        _("%s: Read %d sats from %s into memory"),
+                        __func__, num, fnam);
+        }
+    }
 
-        /* now we load each .sat file and update if we have new data */
-        userconfdir = get_user_conf_dir();
-        ldname = g_strconcat(userconfdir, G_DIR_SEPARATOR_S, "satdata", NULL);
-        g_free(userconfdir);
+    /* close directory since we don't need it anymore */
+    g_dir_close(cache_dir);
 
-        /* open directory and read files one by one */
-        loc_dir = g_dir_open(ldname, 0, &err);
+    return TRUE;
+}
 
-        if (err != NULL)
+/**
+ * Apply fresh TLE data to the local satellite database.
+ *
+ * @param data Hash table with the fresh TLE data.
+ * @param silent TRUE if function should execute without graphical status indicator.
+ * @param progress Pointer to progress indicator (can be NULL)
+ * @param label1 Activity label (can be NULL)
+ * @param label2 Statistics label (can be NULL)
+ * @return FALSE if the local database could not be opened.
+ *
+ * Each .sat file is updated if the table has new data for it, and the
+ * satellites not yet in the database are added if enabled.
+ */
+static gboolean apply_fresh_tle(GHashTable * data, gboolean silent,
+                                GtkWidget * progress, GtkWidget * label1,
+                                GtkWidget * label2)
+{
+    GDir           *loc_dir;    /* directory for gpredict TLE files */
+    GError         *err = NULL;
+    gchar          *text;
+    gchar          *ldname;
+    gchar          *userconfdir;
+    const gchar    *fnam;
+    guint           num = 0;
+    guint           updated, updated_tmp;
+    guint           skipped, skipped_tmp;
+    guint           nodata, nodata_tmp;
+    guint           newsats = 0;
+    guint           total, total_tmp;
+    gdouble         fraction = 0.0;
+    gdouble         start = 0.0;
+
+    /* now we load each .sat file and update if we have new data */
+    userconfdir = get_user_conf_dir();
+    ldname = g_strconcat(userconfdir, G_DIR_SEPARATOR_S, "satdata", NULL);
+    g_free(userconfdir);
+
+    /* open directory and read files one by one */
+    loc_dir = g_dir_open(ldname, 0, &err);
+
+    if (err != NULL)
+    {
+        /* send an error message */
+        sat_log_log(SAT_LOG_LEVEL_ERROR,
+                    _("%s: Error opening directory %s (%s)"),
+                    __func__, ldname, err->message);
+
+        /* insert error message into the status string, too */
+        if (!silent && (label1 != NULL))
         {
-            /* send an error message */
-            sat_log_log(SAT_LOG_LEVEL_ERROR,
-                        _("%s: Error opening directory %s (%s)"),
-                        __func__, dir, err->message);
+            text =
+                g_strdup_printf(_("<b>ERROR</b> opening directory %s\n%s"),
+                                ldname, err->message);
 
-            /* insert error message into the status string, too */
-            if (!silent && (label1 != NULL))
-            {
-                text =
-                    g_strdup_printf(_("<b>ERROR</b> opening directory %s\n%s"),
-                                    dir, err->message);
+            gtk_label_set_markup(GTK_LABEL(label1), text);
+            g_free(text);
+        }
 
-                gtk_label_set_markup(GTK_LABEL(label1), text);
-                g_free(text);
-            }
+        g_clear_error(&err);
+        g_free(ldname);
+        return FALSE;
+    }
 
-            g_clear_error(&err);
-            err = NULL;
+    /* clear statistics */
+    updated = 0;
+    skipped = 0;
+    nodata = 0;
+    total = 0;
+
+    /* get initial value of progress indicator */
+    if (progress != NULL)
+        start = gtk_progress_bar_get_fraction(GTK_PROGRESS_BAR(progress));
+
+    /* This is insane but I don't know how else to count the number of sats */
+    num = 0;
+    while ((fnam = g_dir_read_name(loc_dir)) != NULL)
+    {
+        /* only consider .sat files */
+        if (g_str_has_suffix(fnam, ".sat"))
+        {
+            num++;
         }
-        else
+    }
+
+    g_dir_rewind(loc_dir);
+
+    /* update TLE files one by one */
+    while ((fnam = g_dir_read_name(loc_dir)) != NULL)
+    {
+        /* only consider .sat files */
+        if (g_str_has_suffix(fnam, ".sat"))
         {
-            /* clear statistics */
-            updated = 0;
-            skipped = 0;
-            nodata = 0;
-            total = 0;
-
-            /* get initial value of progress indicator */
-            if (progress != NULL)
-                start =
-                    gtk_progress_bar_get_fraction(GTK_PROGRESS_BAR(progress));
-
-            /* This is insane but I don't know how else to count the number of sats */
-            num = 0;
-            while ((fnam = g_dir_read_name(loc_dir)) != NULL)
+            /* clear stat bufs */
+            updated_tmp = 0;
+            skipped_tmp = 0;
+            nodata_tmp = 0;
+            total_tmp = 0;
+
+            /* update TLE data in this file */
+            update_tle_in_file(ldname, fnam, data,
+                               &updated_tmp,
+                               &skipped_tmp, &nodata_tmp, &total_tmp);
+
+            /* update statistics */
+            updated += updated_tmp;
+            skipped += skipped_tmp;
+            nodata += nodata_tmp;
+            total = updated + skipped + nodata;
+
+            if (!silent)
             {
-                /* only consider .sat files */
-                if (g_str_has_suffix(fnam, ".sat"))
+                if (label1 != NULL)
                 {
-                    num++;
+                    gtk_label_set_text(GTK_LABEL(label1),
+                                       _("Updating data..."));
                 }
-            }
 
-            g_dir_rewind(loc_dir);
+                if (label2 != NULL)
+                {
+                    text =
+                        g_strdup_printf(_
+                                        ("Satellites updated:\t %d\n"
+                                         "Satellites skipped:\t %d\n"
+                                         "Missing Satellites:\t %d\n"),
+                                        updated, skipped, nodata);
+                    gtk_label_set_text(GTK_LABEL(label2), text);
+                    g_free(text);
+                }
 
-            /* update TLE files one by one */
-            while ((fnam = g_dir_read_name(loc_dir)) != NULL)
-            {
-                /* only consider .sat files */
-                if (g_str_has_suffix(fnam, ".sat"))
+                if (progress != NULL)
                 {
-                    /* clear stat bufs */
-                    updated_tmp = 0;
-                    skipped_tmp = 0;
-                    nodata_tmp = 0;
-                    total_tmp = 0;
-
-                    /* update TLE data in this file */
-                    update_tle_in_file(ldname, fnam, data,
-                                       &updated_tmp,
-                                       &skipped_tmp, &nodata_tmp, &total_tmp);
-
-                    /* update statistics */
-                    updated += updated_tmp;
-                    skipped += skipped_tmp;
-                    nodata += nodata_tmp;
-                    total = updated + skipped + nodata;
-
-                    if (!silent)
+                    /* two different calculations for completeness depending on whether 
+                       we are adding new satellites or not. */
+                    if (sat_cfg_get_bool(SAT_CFG_BOOL_TLE_ADD_NEW))
                     {
-                        if (label1 != NULL)
-                        {
-                            gtk_label_set_text(GTK_LABEL(label1),
-                                               _("Updating data..."));
-                        }
-
-                        if (label2 != NULL)
-                        {
-                            text =
-                                g_strdup_printf(_
-                                                ("Satellites updated:\t %d\n"
-                                                 "Satellites skipped:\t %d\n"
-                                                 "Missing Satellites:\t %d\n"),
-                                                updated, skipped, nodata);
-                            gtk_label_set_text(GTK_LABEL(label2), text);
-                            g_free(text);
-                        }
+                        /* In this case we are possibly processing more than num satellites
+                           How many more? We do not know yet.  Worst case is g_hash_table_size more.
+
+                           As we update skipped and updated we can reduce the denominator count
+                           as those are in both pools (files and hash table). When we have processed 
+                           all the files, updated and skipped are completely correct and the progress 
+                           is correct. It may be correct sooner if the missed satellites are the 
+                           last files to process.
+
+                           Until then, if we eliminate the ones that are updated and skipped from being 
+                           double counted, our progress will shown will always be less or equal to our 
+                           true progress since the denominator will be larger than is correct.
+
+                           Advantages to this are that the progress bar does not stall close to 
+                           finished when there are a large number of new satellites.
+                         */
+                        fraction =
+                            start + (1.0 -
+                                     start) * ((gdouble) total) /
+                            ((gdouble) num + g_hash_table_size(data) -
+                             updated - skipped);
+                    }
+                    else
+                    {
+                        /* here we only process satellites we have have files for so divide by num */
+                        fraction =
+                            start + (1.0 -
+                                     start) * ((gdouble) total) /
+                            ((gdouble) num);
+                    }
+                    gtk_progress_bar_set_fraction(GTK_PROGRESS_BAR
+                                                  (progress), fraction);
 
-                        if (progress != NULL)
-                        {
-                            /* two different calculations for completeness depending on whether 
-                               we are adding new satellites or not. */
-                            if (sat_cfg_get_bool(SAT_CFG_BOOL_TLE_ADD_NEW))
-                            {
-                                /* In this case we are possibly processing more than num satellites
-                                   How many more? We do not know yet.  Worst case is g_hash_table_size more.
-
-                                   As we update skipped and updated we can reduce the denominator count
-                                   as those are in both pools (files and hash table). When we have processed 
-                                   all the files, updated and skipped are completely correct and the progress 
-                                   is correct. It may be correct sooner if the missed satellites are the 
-                                   last files to process.
-
-                                   Until then, if we eliminate the ones that are updated and skipped from being 
-                                   double counted, our progress will shown will always be less or equal to our 
-                                   true progress since the denominator will be larger than is correct.
-
-                                   Advantages to this are that the progress bar does not stall close to 
-                                   finished when there are a large number of new satellites.
-                                 */
-                                fraction =
-                                    start + (1.0 -
-                                             start) * ((gdouble) total) /
-                                    ((gdouble) num + g_hash_table_size(data) -
-                                     updated - skipped);
-                            }
-                            else
-                            {
-                                /* here we only process satellites we have have files for so divide by num */
-                                fraction =
-                                    start + (1.0 -
-                                             start) * ((gdouble) total) /
-                                    ((gdouble) num);
-                            }
-                            gtk_progress_bar_set_fraction(GTK_PROGRESS_BAR
-                                                          (progress),
-                                                          fraction);
+                }
 
-                        }
+                /* update the gui only every so often to speed up the process */
+                /* 47 was selected empirically to balance the update looking smooth but not take too much time. */
+                /* it also tumbles all digits in the numbers so that there is no obvious pattern. */
+                /* on a developer machine this improved an update from 5 minutes to under 20 seconds. */
+                if (total % 47 == 0)
+                {
+                    /* Force the drawing queue to be processed otherwise there will
+                       not be any visual feedback, ie. frozen GUI
+                       - see Gtk+ FAQ http://www.gtk.org/faq/#AEN602
+                     */
+                    while (g_main_context_iteration(NULL, FALSE));
 
-                        /* update the gui only every so often to speed up the process */
-                        /* 47 was selected empirically to balance the update looking smooth but not take too much time. */
-                        /* it also tumbles all digits in the numbers so that there is no obvious pattern. */
-                        /* on a developer machine this improved an update from 5 minutes to under 20 seconds. */
-                        if (total % 47 == 0)
-                        {
-                            /* Force the drawing queue to be processed otherwise there will
-                               not be any visual feedback, ie. frozen GUI
-                               - see Gtk+ FAQ http://www.gtk.org/faq/#AEN602
-                             */
-                            while (g_main_context_iteration(NULL, FALSE));
-
-                            /* give user a chance to follow progress */
-                            g_usleep(G_USEC_PER_SEC / 1000);
-                        }
-                    }
+                    /* give user a chance to follow progress */
+                    g_usleep(G_USEC_PER_SEC / 1000);
                 }
             }
+        }
+    }
 
-            /* force gui update */
-            while (g_main_context_iteration(NULL, FALSE));
+    /* force gui update */
+    while (g_main_context_iteration(NULL, FALSE));
 
-            /* close directory handle */
-            g_dir_close(loc_dir);
+    /* close directory handle */
+    g_dir_close(loc_dir);
 
-            /* see if we have any new sats that need to be added */
-            if (sat_cfg_get_bool(SAT_CFG_BOOL_TLE_ADD_NEW))
-            {
-                newsats = add_new_sats(data);
+    /* see if we have any new sats that need to be added */
+    if (sat_cfg_get_bool(SAT_CFG_BOOL_TLE_ADD_NEW))
+    {
+        newsats = add_new_sats(data);
 
-                if (!silent && (label2 != NULL))
-                {
-                    text = g_strdup_printf(_("Satellites updated:\t %d\n"
-                                             "Satellites skipped:\t %d\n"
-                                             "Missing Satellites:\t %d\n"
-                                             "New Satellites:\t\t %d"),
-                                           updated, skipped, nodata, newsats);
-                    gtk_label_set_text(GTK_LABEL(label2), text);
-                    g_free(text);
-                }
+        if (!silent && (label2 != NULL))
+        {
+            text = g_strdup_printf(_("Satellites updated:\t %d\n"
+                                     "Satellites skipped:\t %d\n"
+                                     "Missing Satellites:\t %d\n"
+                                     "New Satellites:\t\t %d"),
+                                   updated, skipped, nodata, newsats);
+            gtk_label_set_text(GTK_LABEL(label2), text);
+            g_free(text);
+        }
 
-                sat_log_log(SAT_LOG_LEVEL_INFO,
-                            _("%s: Added %d new satellites to local database"),
-                            __func__, newsats);
-            }
+        sat_log_log(SAT_LOG_LEVEL_INFO,
+                    _("%s: Added %d new satellites to local database"),
+                    __func__, newsats);
+    }
 
-            /* store time of update if we have updated something */
-            if ((updated > 0) || (newsats > 0))
-            {
-		gint64          now;
+    /* store time of update if we have updated something */
+    if ((updated > 0) || (newsats > 0))
+        store_update_time();
 
-		now = g_get_real_time() / G_USEC_PER_SEC;
-                sat_cfg_set_int(SAT_CFG_INT_TLE_LAST_UPDATE, now);
-            }
-        }
+    g_free(ldname);
+    sat_log_log(SAT_LOG_LEVEL_INFO, _("%s: TLE elements updated."), __func__);
 
-        g_free(ldname);
-        sat_log_log(SAT_LOG_LEVEL_INFO,
-                    _("%s: TLE elements updated."), __func__);
+    return TRUE;
+}
+
+/**
+ * Update TLE files from local files.
+ *
+ * @param dir Directory where files are located.
+ * @param filter File filter, e.g. *.txt (not used at the moment!)
+ * @param silent TRUE if function should execute without graphical status indicator.
+ * @param label1 Activity label (can be NULL)
+ * @param label2 Statistics label (can be NULL)
+ * @param progress Pointer to progress indicator.
+ * @param init_prgs Initial value of progress indicator, e.g 0.5 if we are updating
+ *                  from network.
+ *
+ * This function is used to update the TLE data from local files.
+ */
+void tle_update_from_files(const gchar * dir, const gchar * filter,
+                           gboolean silent, GtkWidget * progress,
+                           GtkWidget * label1, GtkWidget * label2)
+{
+    GHashTable     *data;       /* hash table with fresh TLE data */
+
+    (void)filter;
+
+    if (g_mutex_trylock(&tle_file_in_progress) == FALSE)
+    {
+        sat_log_log(SAT_LOG_LEVEL_ERROR,
+                    _
+                    ("%s: A TLE update process is already running. Aborting."),
+                    __func__);
+        return;
     }
 
+    /* create hash table */
+    data = g_hash_table_new_full(g_int_hash, g_int_equal, g_free,
+                                 free_new_tle);
+
+    if (read_fresh_dir(dir, data, silent, label1))
+        apply_fresh_tle(data, silent, progress, label1, label2);
+
     /* destroy hash tables */
     g_hash_table_destroy(data);
     g_mutex_unlock(&tle_file_in_progress);
 }
 
-
 /** Check if satellite is new, if so, add it to local database */
 static void check_and_add_sat(gpointer key, gpointer value, gpointer user_data)
 {
@@ -459,6 +491,123 @@ static guint add_new_sats(GHashTable * data)
     return num;
 }
 
+/** State shared with the download completion callback. */
+typedef struct {
+    GHashTable     *data;       /* fresh TLE data read so far */
+    const gchar    *cache;      /* download directory */
+    gboolean        silent;
+    GtkWidget      *progress;
+    GtkWidget      *label1;
+    gdouble         start;      /* initial value of the progress indicator */
+    guint           numfiles;
+    guint           done;       /* completed transfers */
+    guint           updated;    /* files with new, valid content */
+} tle_fetch_t;
+
+/**
+ * Read a downloaded file into the fresh TLE data.
+ *
+ * @param fetch The update state.
+ * @param item The downloaded or unchanged file.
+ * @return FALSE if the file holds no valid TLE data.
+ *
+ * A file without valid data is removed from the cache, so that it is
+ * fetched in full next time instead of being confirmed by a 304.
+ */
+static gboolean tle_fetch_read(tle_fetch_t * fetch, http_fetch_item_t * item)
+{
+    gchar          *fnam;
+    gint            num;
+
+    fnam = g_path_get_basename(item->file);
+    num = read_fresh_tle(fetch->cache, fnam, fetch->data);
+    g_free(fnam);
+
+    if (num < 1)
+    {
+        sat_log_log(SAT_LOG_LEVEL_ERROR,
+                    _("%s: No valid TLE data found in %s"),
+                    __func__, item->url);
+        g_remove(item->file);
+        return FALSE;
+    }
+
+    sat_log_log(SAT_LOG_LEVEL_INFO,
+                _("%s: Read %d sats from %s into memory"),
+                __func__, num, item->url);
+
+    return TRUE;
+}
+
+/**
+ * Download completion callback.
+ *
+ * Parses each new file as soon as it arrives, while the other transfers
+ * are still running.  A new file without valid data is reported as failed,
+ * so its validators are not recorded.
+ */
+static void tle_fetch_done(http_fetch_item_t * item, gpointer data)
+{
+    tle_fetch_t    *fetch = data;
+    gchar          *text;
+    gdouble         fraction;
+
+    fetch->done++;
+
+    switch (item->status)
+    {
+    case HTTP_FETCH_UPDATED:
+        sat_log_log(SAT_LOG_LEVEL_INFO,
+                    _("%s: Successfully fetched %s"), __func__, item->url);
+
+        if (!fetch->silent && (fetch->label1 != NULL))
+        {
+            text = g_strdup_printf(_("Reading data from %s"), item->url);
+            gtk_label_set_text(GTK_LABEL(fetch->label1), text);
+            g_free(text);
+        }
+
+        if (tle_fetch_read(fetch, item))
+        {
+            fetch->updated++;
+        }
+        else
+        {
+            item->status = HTTP_FETCH_FAILED;
+            item->error = g_strdup(_("No valid TLE data"));
+        }
+        break;
+
+    case HTTP_FETCH_NOT_MODIFIED:
+        sat_log_log(SAT_LOG_LEVEL_INFO,
+                    _("%s: %s has not changed since the last update"),
+                    __func__, item->url);
+        break;
+
+    default:
+        sat_log_log(SAT_LOG_LEVEL_ERROR,
+                    _("%s: Error fetching %s (%s)"),
+                    __func__, item->url, item->error);
+        break;
+    }
+
+    /* update progress indicator */
+    if (!fetch->silent && (fetch->progress != NULL))
+    {
+        /* complete download corresponds to 50% */
+        fraction = fetch->start + (0.5 - fetch->start) *
+            fetch->done / (1.0 * fetch->numfiles);
+        gtk_progress_bar_set_fraction(GTK_PROGRESS_BAR(fetch->progress),
+                                      fraction);
+
+        /* Force the drawing queue to be processed otherwise there will
+           not be any visual feedback, ie. frozen GUI
+           - see Gtk+ FAQ http://www.gtk.org/faq/#AEN602
+         */
+        while (g_main_context_iteration(NULL, FALSE));
+    }
+}
+
 /**
  * Update TLE files from network.
  *
@@ -466,6 +615,14 @@ static guint add_new_sats(GHashTable * data)
  * @param progress Pointer to a GtkProgressBar progress indicator (can be NULL)
  * @param label1 GtkLabel for activity string.
  * @param label2 GtkLabel for statistics string.
+ *
+ * All files are downloaded in parallel; each one is parsed as soon as it
+ * has arrived.  The downloads are kept in the cache directory and, after
+ * the first complete update, requested conditionally.  If nothing has
+ * changed the update ends after one round trip; otherwise the cached
+ * copies of the unchanged files are applied together with the new ones.
+ * The validators of the new files are only recorded once they have been
+ * applied; a file that could not be applied is fetched in full next time.
  */
 void tle_update_from_network(gboolean silent,
                              GtkWidget * progress,
@@ -473,26 +630,23 @@ void tle_update_from_network(gboolean silent,
 {
     static GMutex   tle_in_progress;
 
+    http_fetch_params_t params;
+    http_fetch_item_t *items = NULL;
+    tle_fetch_t     fetch;
     gchar          *proxy = NULL;
     gchar          *files_tmp;
     gchar         **files;
+    gchar          *meta;
+    gchar          *digest;
     guint           numfiles, i;
-    gchar          *curfile;
     gchar          *locfile;
-    gchar          *userconfdir;
-#ifdef WIN32
-    int             res;
-#else
-    CURL           *curl;
-    CURLcode        res;
-#endif
-    gdouble         fraction, start = 0;
-    FILE           *outfile;
     GDir           *dir;
     gchar          *cache;
     const gchar    *fname;
     gchar          *text;
     GError         *err = NULL;
+    gboolean        conditional;
+    gboolean        applied = FALSE;
     guint           success = 0;        /* no. of successful downloads */
 
     /* bail out if we are already in an update process */
@@ -519,6 +673,7 @@ void tle_update_from_network(gboolean silent,
     files_tmp = sat_cfg_get_str(SAT_CFG_STR_TLE_URLS);
     files = g_strsplit(files_tmp, ";", 0);
     numfiles = g_strv_length(files);
+    cache = sat_file_name("cache");
 
     if (numfiles < 1)
     {
@@ -534,133 +689,114 @@ void tle_update_from_network(gboolean silent,
     }
     else
     {
+        memset(&fetch, 0, sizeof(fetch));
+        fetch.data = g_hash_table_new_full(g_int_hash, g_int_equal, g_free,
+                                           free_new_tle);
+        fetch.cache = cache;
+        fetch.silent = silent;
+        fetch.progress = progress;
+        fetch.label1 = label1;
+        fetch.numfiles = numfiles;
+
         /* initialise progress bar */
         if (!silent && (progress != NULL))
-            start = gtk_progress_bar_get_fraction(GTK_PROGRESS_BAR(progress));
+            fetch.start =
+                gtk_progress_bar_get_fraction(GTK_PROGRESS_BAR(progress));
 
-#ifndef WIN32
-        /* initialise curl */
-        curl = curl_easy_init();
-        if (proxy != NULL)
-            curl_easy_setopt(curl, CURLOPT_PROXY, proxy);
+        /* set activity message */
+        if (!silent && (label1 != NULL))
+        {
+            text = g_strdup_printf(_("Fetching %d files"), numfiles);
+            gtk_label_set_text(GTK_LABEL(label1), text);
+            g_free(text);
 
-        curl_easy_setopt(curl, CURLOPT_USERAGENT, "gpredict/curl");
-        curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, 10);
-#endif
+            /* Force the drawing queue to be processed otherwise there will
+               not be any visual feedback, ie. frozen GUI
+               - see Gtk+ FAQ http://www.gtk.org/faq/#AEN602
+             */
+            while (g_main_context_iteration(NULL, FALSE));
+        }
 
-        /* get files */
+        /* Validators are only trusted once a complete update has gone
+           through; until then every file is parsed. */
+        conditional = sat_cfg_get_int(SAT_CFG_INT_TLE_LAST_UPDATE) > 0;
+
+        /* local cache files ~/.config/Gpredict/satdata/cache/<url-sha1>.tle,
+           named by URL so that a copy always belongs to the validators
+           recorded for that URL */
+        items = g_new0(http_fetch_item_t, numfiles);
         for (i = 0; i < numfiles; i++)
         {
-            /* set URL */
-            curfile = g_strdup(files[i]);
-#ifndef WIN32
-            curl_easy_setopt(curl, CURLOPT_URL, curfile);
-#endif
-
-            /* set activity message */
-            if (!silent && (label1 != NULL))
-            {
+            digest = g_compute_checksum_for_string(G_CHECKSUM_SHA1, files[i],
+                                                   -1);
+            items[i].url = files[i];
+            items[i].file = g_strdup_printf("%s%s%s.tle", cache,
+                                            G_DIR_SEPARATOR_S, digest);
+            g_free(digest);
+
+            /* without a local copy a 304 would leave us with nothing */
+            items[i].conditional = conditional &&
+                g_file_test(items[i].file, G_FILE_TEST_EXISTS);
+        }
 
-                text = g_strdup_printf(_("Fetching %s"), files[i]);
-                gtk_label_set_text(GTK_LABEL(label1), text);
-                g_free(text);
+        meta = sat_file_name("tle-fetch.meta");
+        http_fetch_params_init(&params);
+        params.proxy = proxy;
+        params.meta_file = meta;
 
-                /* Force the drawing queue to be processed otherwise there will
-                   not be any visual feedback, ie. frozen GUI
-                   - see Gtk+ FAQ http://www.gtk.org/faq/#AEN602
-                 */
-                while (g_main_context_iteration(NULL, FALSE));
-            }
+        success = http_fetch_run(items, numfiles, &params, tle_fetch_done,
+                                 &fetch);
 
-            /* create local cache file ~/.config/Gpredict/satdata/cache/file-%d.tle */
-            userconfdir = get_user_conf_dir();
-            locfile = g_strdup_printf("%s%ssatdata%scache%sfile-%d.tle",
-                                      userconfdir, G_DIR_SEPARATOR_S,
-                                      G_DIR_SEPARATOR_S, G_DIR_SEPARATOR_S, i);
-            outfile = g_fopen(locfile, "wb");
-            if (outfile != NULL)
-            {
-#ifdef WIN32
-                res = win32_fetch(curfile, outfile, proxy, "gpredict/win32");
-                if (res != 0)
-                {
-                    sat_log_log(SAT_LOG_LEVEL_ERROR,
-                                _("%s: Error fetching %s (%x)"),
-                                __func__, curfile, res);
-                }
-                else
-                {
-                    sat_log_log(SAT_LOG_LEVEL_INFO,
-                                _("%s: Successfully fetched %s"),
-                                __func__, curfile);
-                    success++;
-                }
-#else
-                curl_easy_setopt(curl, CURLOPT_WRITEDATA, outfile);
-                curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, my_write_func);
-                curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+        /* continue update if we have fetched at least one file */
+        if (fetch.updated > 0)
+        {
+            sat_log_log(SAT_LOG_LEVEL_INFO,
+                        _("%s: Fetched %d files from network; updating..."),
+                        __func__, fetch.updated);
 
-                /* get file */
-                res = curl_easy_perform(curl);
+            /* the satellites of the unchanged files would otherwise be
+               counted as missing */
+            for (i = 0; i < numfiles; i++)
+                if (items[i].status == HTTP_FETCH_NOT_MODIFIED)
+                    tle_fetch_read(&fetch, &items[i]);
 
-                if (res != CURLE_OK)
-                {
-                    sat_log_log(SAT_LOG_LEVEL_ERROR,
-                                _("%s: Error fetching %s (%s)"),
-                                __func__, curfile, curl_easy_strerror(res));
-                }
-                else
-                {
-                    sat_log_log(SAT_LOG_LEVEL_INFO,
-                                _("%s: Successfully fetched %s"),
-                                __func__, curfile);
-                    success++;
-                }
-#endif
-                fclose(outfile);
+            if (g_mutex_trylock(&tle_file_in_progress))
+            {
+                applied = apply_fresh_tle(fetch.data, silent, progress,
+                                          label1, label2);
+                g_mutex_unlock(&tle_file_in_progress);
             }
             else
             {
-                sat_log_log(SAT_LOG_LEVEL_INFO,
-                            _("%s: Failed to open %s preventing update"),
-                            __func__, locfile);
+                sat_log_log(SAT_LOG_LEVEL_ERROR,
+                            _
+                            ("%s: A TLE update process is already running. Aborting."),
+                            __func__);
             }
-            /* update progress indicator */
-            if (!silent && (progress != NULL))
-            {
-
-                /* complete download corresponds to 50% */
-                fraction = start + (0.5 - start) * i / (1.0 * numfiles);
-                gtk_progress_bar_set_fraction(GTK_PROGRESS_BAR(progress),
-                                              fraction);
 
-                /* Force the drawing queue to be processed otherwise there will
-                   not be any visual feedback, ie. frozen GUI
-                   - see Gtk+ FAQ http://www.gtk.org/faq/#AEN602
-                 */
-                while (g_main_context_iteration(NULL, FALSE));
+            /* the recorded validators must describe data that is in the
+               database; otherwise drop the new copies so that they are
+               fetched in full next time */
+            if (!applied || !http_fetch_save_validators(items, numfiles, meta))
+            {
+                for (i = 0; i < numfiles; i++)
+                    if (items[i].status == HTTP_FETCH_UPDATED)
+                        g_remove(items[i].file);
             }
-
-            g_free(userconfdir);
-            g_free(curfile);
-            g_free(locfile);
         }
-
-#ifndef WIN32
-        curl_easy_cleanup(curl);
-#endif
-
-        /* continue update if we have fetched at least one file */
-        if (success > 0)
+        else if (success > 0)
         {
             sat_log_log(SAT_LOG_LEVEL_INFO,
-                        _("%s: Fetched %d files from network; updating..."),
-                        __func__, success);
-            /* call update_from_files */
-            cache = sat_file_name("cache");
-            tle_update_from_files(cache, NULL, silent, progress, label1,
-                                  label2);
-            g_free(cache);
+                        _("%s: TLE data on the server has not changed."),
+                        __func__);
+            store_update_time();
+
+            if (!silent && (label1 != NULL))
+                gtk_label_set_text(GTK_LABEL(label1),
+                                   _("TLE data is up to date"));
+            if (!silent && (progress != NULL))
+                gtk_progress_bar_set_fraction(GTK_PROGRESS_BAR(progress),
+                                              1.0);
         }
         else
         {
@@ -670,16 +806,11 @@ void tle_update_from_network(gboolean silent,
                         __func__);
         }
 
+        g_free(meta);
+        g_hash_table_destroy(fetch.data);
     }
 
-    /* clear cache and memory */
-    g_strfreev(files);
-    g_free(files_tmp);
-    if (proxy != NULL)
-        g_free(proxy);
-
     /* open cache */
-    cache = sat_file_name("cache");
     dir = g_dir_open(cache, 0, &err);
 
     if (err != NULL)
@@ -687,50 +818,43 @@ void tle_update_from_network(gboolean silent,
         /* send an error message */
         sat_log_log(SAT_LOG_LEVEL_ERROR,
                     _("%s: Error opening %s (%s)"),
-                    __func__, dir, err->message);
+                    __func__, cache, err->message);
         g_clear_error(&err);
     }
     else
     {
-        /* delete files in cache one by one */
+        /* keep the copies of the current files for the next conditional
+           update and delete everything else one by one */
         while ((fname = g_dir_read_name(dir)) != NULL)
         {
-
             locfile = g_strconcat(cache, G_DIR_SEPARATOR_S, fname, NULL);
-            if (g_remove(locfile))
-                    sat_log_log(SAT_LOG_LEVEL_ERROR,
-                                _("%s: Failed to remove %s"), __func__, locfile);
+            for (i = 0; i < numfiles; i++)
+                if (strcmp(items[i].file, locfile) == 0)
+                    break;
+
+            if (i == numfiles && g_remove(locfile))
+                sat_log_log(SAT_LOG_LEVEL_ERROR,
+                            _("%s: Failed to remove %s"), __func__, locfile);
             g_free(locfile);
         }
         /* close cache */
         g_dir_close(dir);
     }
 
+    /* clear memory */
+    for (i = 0; i < numfiles; i++)
+        g_free((gchar *) items[i].file);
+    http_fetch_items_clear(items, numfiles);
+    g_free(items);
+    g_strfreev(files);
+    g_free(files_tmp);
+    if (proxy != NULL)
+        g_free(proxy);
+
     g_free(cache);
     g_mutex_unlock(&tle_in_progress);
 }
 
-#ifndef WIN32
-/**
- * Write TLE data block to file.
- *
- * @param ptr Pointer to the data block to be written.
- * @param size Size of data block.
- * @param nmemb Size multiplier?
- * @param stream Pointer to the file handle.
- * @return The number of bytes actually written.
- *
- * This function writes the received data to the file pointed to by stream.
- * It is used as write callback by to curl exec function.
- */
-static size_t my_write_func(void *ptr, size_t size, size_t nmemb,
-                            FILE * stream)
-{
-    /*** FIXME: TBC whether this works in wintendo */
-    return fwrite(ptr, size, nmemb, stream);
-}
-#endif
-
 /**
  * Check whether file is TLE file.
  * @param dir The directory.
@@ -34,10 +34,12 @@
 #include <glib/gstdio.h>
 #include <gtk/gtk.h>
 #include <locale.h>
+#include <string.h>
 
 #include "compat.h"
 #include "trsp-update.h"
 #include "gpredict-utils.h"
+#include "http-fetch.h"
 #include "sat-cfg.h"
 #include "sat-log.h"
 #include "nxjson/nxjson.h"
@@ -46,12 +48,6 @@
 #include <build-config.h>
 #endif
 
-#ifdef WIN32
-#include "win32-fetch.h"
-#else
-#include <curl/curl.h>
-#endif
-
 /* TRSP auto update frequency. */
 typedef enum {
     TRSP_AUTO_UPDATE_NEVER = 0, /* No auto-update, just warn after one week. */
@@ -94,12 +90,6 @@ typedef struct {
     guint           numtrsp;    /* Number of transponders. */
 } new_trsp_t;
 
-#ifndef WIN32
-/* private function prototypes */
-static size_t   my_write_func(void *ptr, size_t size, size_t nmemb,
-                              FILE * stream);
-#endif
-
 //int getMODElist_intoHashMap();
 
 //static void check_and_print_mode(gpointer key, gpointer value, gpointer user_data)
@@ -387,125 +377,28 @@ void trsp_update_files(gchar * input_file)
     g_hash_table_destroy(modes_hash);
 }
 
-/** Update MODES files from network. */
-void modes_update_from_network()
+/** Download completion callback. */
+static void trsp_fetch_done(http_fetch_item_t * item, gpointer data)
 {
-    gchar          *server;
-    gchar          *proxy = NULL;
-    gchar          *modes_file;
-    gchar          *file_url;
-    gchar          *locfile;
-    gchar          *userconfdir;
-#ifdef WIN32
-    int             res;
-#else
-    CURL           *curl;
-    CURLcode        res;
-#endif
-    FILE           *outfile;
-    guint           success = 0;        /* no. of successful downloads */
-
-    server = sat_cfg_get_str(SAT_CFG_STR_TRSP_SERVER);
-    proxy = sat_cfg_get_str(SAT_CFG_STR_TRSP_PROXY);
-    modes_file = sat_cfg_get_str(SAT_CFG_STR_TRSP_MODE_FILE);
+    (void)data;
 
-#ifndef WIN32
-    /* initialise curl */
-    curl = curl_easy_init();
-    if (proxy != NULL)
-        curl_easy_setopt(curl, CURLOPT_PROXY, proxy);
-
-    curl_easy_setopt(curl, CURLOPT_USERAGENT, "gpredict/curl");
-    curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, 10);
-#endif
-
-    /* get files */
-    /* set URL */
-    file_url = g_strconcat(server, modes_file, NULL);
-#ifndef WIN32
-    curl_easy_setopt(curl, CURLOPT_URL, file_url);
-    sat_log_log(SAT_LOG_LEVEL_INFO,
-                _("%s: Ready to fetch modes list from %s"),
-                __func__, file_url);
-#endif
-
-    /* create local cache file */
-    userconfdir = get_user_conf_dir();
-    locfile = g_strconcat(userconfdir, G_DIR_SEPARATOR_S, "trsp",
-                          G_DIR_SEPARATOR_S, "modes.json", NULL);
-    sat_log_log(SAT_LOG_LEVEL_INFO, _("%s: File to open %s "), __func__,
-                locfile);
-
-    outfile = g_fopen(locfile, "wb");
-    if (outfile != NULL)
+    switch (item->status)
     {
-#ifdef WIN32
-        res = win32_fetch(file_url, outfile, proxy, "gpredict/win32");
-        if (res != 0)
-        {
-            sat_log_log(SAT_LOG_LEVEL_ERROR, _("%s: Error fetching %s (%x)"),
-                        __func__, file_url, res);
-        }
-        else
-        {
-            sat_log_log(SAT_LOG_LEVEL_INFO, _("%s: Successfully fetched %s"),
-                        __func__, file_url);
-            success++;
-        }
-#else
-        curl_easy_setopt(curl, CURLOPT_WRITEDATA, outfile);
-        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, my_write_func);
-
-        /* get file */
-        res = curl_easy_perform(curl);
-
-        if (res != CURLE_OK)
-        {
-            sat_log_log(SAT_LOG_LEVEL_ERROR, _("%s: Error fetching %s (%s)"),
-                        __func__, file_url, curl_easy_strerror(res));
-        }
-        else
-        {
-            sat_log_log(SAT_LOG_LEVEL_INFO, _("%s: Successfully fetched %s"),
-                        __func__, file_url);
-            success++;
-        }
-#endif
-        fclose(outfile);
+    case HTTP_FETCH_UPDATED:
+        sat_log_log(SAT_LOG_LEVEL_INFO, _("%s: Successfully fetched %s"),
+                    __func__, item->url);
+        break;
 
-    }
-    else
-    {
-        sat_log_log(SAT_LOG_LEVEL_INFO,
-                    _("%s: Failed to open %s preventing update"),
-                    __func__, locfile);
-    }
-
-    g_free(userconfdir);
-    g_free(file_url);
-    g_free(server);
-    g_free(proxy);
-    g_free(modes_file);
-
-#ifndef WIN32
-    curl_easy_cleanup(curl);
-#endif
-
-    /* continue update if we have fetched at least one file */
-    if (success > 0)
-    {
+    case HTTP_FETCH_NOT_MODIFIED:
         sat_log_log(SAT_LOG_LEVEL_INFO,
-                    _("%s: Fetched %d files from network; updating..."),
-                    __func__, success);
-        //here we can get the modes json file into memory as hashmap..
-        //g_free(cache);
-
-    }
-    else
-    {
-        sat_log_log(SAT_LOG_LEVEL_ERROR,
-                    _("%s: Could not fetch frequency files from network"),
-                    __func__);
+                    _("%s: %s has not changed since the last update"),
+                    __func__, item->url);
+        break;
+
+    default:
+        sat_log_log(SAT_LOG_LEVEL_ERROR, _("%s: Error fetching %s (%s)"),
+                    __func__, item->url, item->error);
+        break;
     }
 }
 
@@ -516,6 +409,10 @@ void modes_update_from_network()
  * @param progress Pointer to a GtkProgressBar progress indicator (can be NULL)
  * @param label1 GtkLabel for activity string.
  * @param label2 GtkLabel for statistics string.
+ *
+ * The modes and transmitter lists are downloaded in parallel and, once a
+ * local copy exists, conditionally.  The transponder files are only
+ * regenerated when at least one of the lists has changed.
  */
 void trsp_update_from_network(gboolean silent,
                               GtkWidget * progress,
@@ -523,24 +420,17 @@ void trsp_update_from_network(gboolean silent,
 {
     static GMutex   trsp_in_progress;
 
+    http_fetch_params_t params;
+    http_fetch_item_t items[2];
     gchar          *server;
     gchar          *proxy = NULL;
     gchar          *freq_file;
-    gchar          *file_url;
-    gchar          *locfile_trsp;
+    gchar          *modes_file;
+    gchar          *trspdir;
+    gchar          *meta;
     gchar          *userconfdir;
-#ifdef WIN32
-    int             res;
-#else
-    CURL           *curl;
-    CURLcode        res;
-#endif
-    gdouble         fraction;
-    FILE           *outfile;
-    gchar          *cache;
     gchar          *text;
-
-    guint           success = 0;        /* no. of successful downloads */
+    guint           i, success, updated = 0;
 
     (void)label2;
 
@@ -553,34 +443,11 @@ void trsp_update_from_network(gboolean silent,
         return;
     }
 
-    /* get list with modes */
-    modes_update_from_network();
-
     /* get server, proxy, and list of files */
-    //server = sprintf("%stransmitters/?format=json", sat_cfg_get_str(SAT_CFG_STR_TRSP_SERVER));
     server = sat_cfg_get_str(SAT_CFG_STR_TRSP_SERVER);
     proxy = sat_cfg_get_str(SAT_CFG_STR_TRSP_PROXY);
     freq_file = sat_cfg_get_str(SAT_CFG_STR_TRSP_FREQ_FILE);
-
-#ifndef WIN32
-    /* initialise curl */
-    curl = curl_easy_init();
-    if (proxy != NULL)
-        curl_easy_setopt(curl, CURLOPT_PROXY, proxy);
-
-    curl_easy_setopt(curl, CURLOPT_USERAGENT, "gpredict/curl");
-    curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, 10);
-#endif
-
-    /* get files */
-    /* set URL */
-    file_url = g_strconcat(server, freq_file, NULL);
-#ifndef WIN32
-    curl_easy_setopt(curl, CURLOPT_URL, file_url);
-    sat_log_log(SAT_LOG_LEVEL_INFO,
-                _("%s: Ready to fetch transponder list from %s"),
-                __func__, file_url);
-#endif
+    modes_file = sat_cfg_get_str(SAT_CFG_STR_TRSP_MODE_FILE);
 
     /* set activity message */
     if (!silent && (label1 != NULL))
@@ -597,65 +464,43 @@ void trsp_update_from_network(gboolean silent,
         while (g_main_context_iteration(NULL, FALSE));
     }
 
-    /* create local cache file */
+    /* local copies */
     userconfdir = get_user_conf_dir();
+    trspdir = g_strconcat(userconfdir, G_DIR_SEPARATOR_S, "trsp", NULL);
+    g_free(userconfdir);
 
-    locfile_trsp = g_strconcat(userconfdir, G_DIR_SEPARATOR_S, "trsp",
-                               G_DIR_SEPARATOR_S, "transmitters.json", NULL);
-    sat_log_log(SAT_LOG_LEVEL_INFO, _("%s: File to open %s "), __func__,
-                locfile_trsp);
-
-    outfile = g_fopen(locfile_trsp, "wb");
-    if (outfile != NULL)
-    {
-#ifdef WIN32
-        res = win32_fetch(file_url, outfile, proxy, "gpredict/win32");
-        if (res != 0)
-        {
-            sat_log_log(SAT_LOG_LEVEL_ERROR, _("%s: Error fetching %s (%x)"),
-                        __func__, file_url, res);
-        }
-        else
-        {
-            sat_log_log(SAT_LOG_LEVEL_INFO, _("%s: Successfully fetched %s"),
-                        __func__, file_url);
-            success++;
-        }
-#else
-        curl_easy_setopt(curl, CURLOPT_WRITEDATA, outfile);
-        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, my_write_func);
-
-        /* get file */
-        res = curl_easy_perform(curl);
-
-        if (res != CURLE_OK)
-        {
-            sat_log_log(SAT_LOG_LEVEL_ERROR, _("%s: Error fetching %s (%s)"),
-                        __func__, file_url, curl_easy_strerror(res));
-        }
-        else
-        {
-            sat_log_log(SAT_LOG_LEVEL_INFO, _("%s: Successfully fetched %s"),
-                        __func__, file_url);
-            success++;
-        }
-#endif
-        fclose(outfile);
-
-    }
-    else
+    memset(items, 0, sizeof(items));
+    items[0].url = g_strconcat(server, modes_file, NULL);
+    items[0].file = g_strconcat(trspdir, G_DIR_SEPARATOR_S, "modes.json",
+                                NULL);
+    items[1].url = g_strconcat(server, freq_file, NULL);
+    items[1].file = g_strconcat(trspdir, G_DIR_SEPARATOR_S,
+                                "transmitters.json", NULL);
+    for (i = 0; i < 2; i++)
     {
+        /* without a local copy a 304 would leave us with nothing */
+        items[i].conditional = g_file_test(items[i].file,
+                                           G_FILE_TEST_EXISTS);
         sat_log_log(SAT_LOG_LEVEL_INFO,
-                    _("%s: Failed to open %s preventing update"),
-                    __func__, locfile_trsp);
+                    _("%s: Ready to fetch %s into %s"),
+                    __func__, items[i].url, items[i].file);
     }
 
+    meta = g_strconcat(trspdir, G_DIR_SEPARATOR_S, "fetch.meta", NULL);
+    http_fetch_params_init(&params);
+    params.proxy = proxy;
+    params.meta_file = meta;
+
+    success = http_fetch_run(items, 2, &params, trsp_fetch_done, NULL);
+
+    for (i = 0; i < 2; i++)
+        if (items[i].status == HTTP_FETCH_UPDATED)
+            updated++;
+
     /* update progress indicator */
     if (!silent && (progress != NULL))
     {
-        /* complete download corresponds to 50% */
-        fraction = 1;
-        gtk_progress_bar_set_fraction(GTK_PROGRESS_BAR(progress), fraction);
+        gtk_progress_bar_set_fraction(GTK_PROGRESS_BAR(progress), 1.0);
 
         /* Force the drawing queue to be processed otherwise there will
            not be any visual feedback, ie. frozen GUI
@@ -665,26 +510,23 @@ void trsp_update_from_network(gboolean silent,
 
     }
 
-    g_free(userconfdir);
-    g_free(file_url);
-    g_free(server);
-    g_free(freq_file);
-    g_free(proxy);
-
-#ifndef WIN32
-    curl_easy_cleanup(curl);
-#endif
-
-    /* continue update if we have fetched at least one file */
-    if (success > 0)
+    /* regenerate the transponder files if a list has changed and we have
+       a usable transmitter list */
+    if (updated > 0 && items[1].status != HTTP_FETCH_FAILED)
     {
         sat_log_log(SAT_LOG_LEVEL_INFO,
                     _("%s: Fetched %d files from network; updating..."),
-                    __func__, success);
-        /* call update_from_files */
-        cache = sat_file_name("cache");
-        trsp_update_files(locfile_trsp);
-        g_free(cache);
+                    __func__, updated);
+        trsp_update_files((gchar *) items[1].file);
+
+        /* only now the new lists are in use */
+        http_fetch_save_validators(items, 2, meta);
+    }
+    else if (success == 2)
+    {
+        sat_log_log(SAT_LOG_LEVEL_INFO,
+                    _("%s: Frequency data on the server has not changed"),
+                    __func__);
     }
     else
     {
@@ -693,29 +535,21 @@ void trsp_update_from_network(gboolean silent,
                     __func__);
     }
 
-    g_mutex_unlock(&trsp_in_progress);
-}
+    for (i = 0; i < 2; i++)
+    {
+        g_free((gchar *) items[i].url);
+        g_free((gchar *) items[i].file);
+    }
+    http_fetch_items_clear(items, 2);
+    g_free(meta);
+    g_free(trspdir);
+    g_free(server);
+    g_free(freq_file);
+    g_free(modes_file);
+    g_free(proxy);
 
-#ifndef WIN32
-/**
- * Write TRSP data block to file.
- * 
- * @param ptr Pointer to the data block to be written.
- * @param size Size of data block.
- * @param nmemb Size multiplier?
- * @param stream Pointer to the file handle.
- * @return The number of bytes actually written.
- *
- * This function writes the received data to the file pointed to by stream.
- * It is used as write callback by to curl exec function.
- */
-static size_t my_write_func(void *ptr, size_t size, size_t nmemb,
-                            FILE * stream)
-{
-    /*** FIXME: TBC whether this works in wintendo */
-    return fwrite(ptr, size, nmemb, stream);
+    g_mutex_unlock(&trsp_in_progress);
 }
-#endif
 
 const gchar    *freq_to_str2[TRSP_AUTO_UPDATE_NUM] = {
     N_("Never"),
@@ -0,0 +1,264 @@
+/*
+  OGpredict — extensions to Gpredict for operations planning
+
+  Copyright (C) 2025 Axel Osika <osikaaxel@gmail.com>
+
+  This file is part of OGpredict, a derivative of Gpredict.
+
+  OGpredict is free software: you can redistribute it and/or modify it
+  under the terms of the GNU General Public License as published by the
+  Free Software Foundation; either version 2 of the License, or (at your
+  option) any later version.  See the GNU General Public License for details.
+*/
+
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/*
+ * View types and column flags.
+ *
+ * These used to live in the GTK view headers. The configuration defaults in
+ * sat-cfg.c refer to them, so they are kept free of GTK here for the core
+ * library; the view headers include this file.
+ */
+
+#ifndef __VIEW_FLAGS_H__
+#define __VIEW_FLAGS_H__ 1
+
+/* Module views (gtk-sat-module.h) */
+
+/** View types */
+typedef enum {
+    GTK_SAT_MOD_VIEW_LIST = 0,  /*!< GtkSatList */
+    GTK_SAT_MOD_VIEW_MAP,       /*!< GtkSatMap */
+    GTK_SAT_MOD_VIEW_POLAR,     /*!< GtkPolarView */
+    GTK_SAT_MOD_VIEW_SINGLE,    /*!< GtkSingleSat */
+    GTK_SAT_MOD_VIEW_EVENT,     /*!< GtkEventList */
+    GTK_SAT_MOD_VIEW_NUM,       /*!< Number of modules */
+} gtk_sat_mod_view_t;
+
+
+/* Polar view (gtk-polar-view.h) */
+
+/* graph orientation; start at 12
+   o'clock and go clockwise */
+typedef enum {
+    POLAR_VIEW_NESW = 0,        /*!< Normal / usual */
+    POLAR_VIEW_NWSE = 1,
+    POLAR_VIEW_SENW = 2,
+    POLAR_VIEW_SWNE = 3
+} polar_view_swap_t;
+
+
+/* pole identifier */
+typedef enum {
+    POLAR_VIEW_POLE_N = 0,
+    POLAR_VIEW_POLE_E = 1,
+    POLAR_VIEW_POLE_S = 2,
+    POLAR_VIEW_POLE_W = 3
+} polar_view_pole_t;
+
+
+/* Satellite list (gtk-sat-list.h) */
+
+/** Symbolic references to columns */
+typedef enum {
+    SAT_LIST_COL_NAME = 0,      /*!< Satellite name. */
+    SAT_LIST_COL_CATNUM,        /*!< Catalogue number. */
+    SAT_LIST_COL_AZ,            /*!< Azimuth. */
+    SAT_LIST_COL_EL,            /*!< Elvation. */
+    SAT_LIST_COL_DIR,           /*!< Direction, satellite on its way up or down. */
+    SAT_LIST_COL_RA,            /*!< Right Ascension. */
+    SAT_LIST_COL_DEC,           /*!< Declination. */
+    SAT_LIST_COL_RANGE,         /*!< Range. */
+    SAT_LIST_COL_RANGE_RATE,    /*!< Range rate. */
+    SAT_LIST_COL_NEXT_EVENT,    /*!< Next event AOS or LOS depending on El. */
+    SAT_LIST_COL_AOS,           /*!< Next AOS regardless of El. */
+    SAT_LIST_COL_LOS,           /*!< Next LOS regardless of El. */
+    SAT_LIST_COL_LAT,           /*!< Latitude. */
+    SAT_LIST_COL_LON,           /*!< Longitude. */
+    SAT_LIST_COL_SSP,           /*!< Sub satellite point grid square */
+    SAT_LIST_COL_FOOTPRINT,     /*!< Footprint. */
+    SAT_LIST_COL_ALT,           /*!< Altitude. */
+    SAT_LIST_COL_VEL,           /*!< Velocity. */
+    SAT_LIST_COL_DOPPLER,       /*!< Doppler shift at 100 MHz. */
+    SAT_LIST_COL_LOSS,          /*!< Path Loss at 100 MHz. */
+    SAT_LIST_COL_DELAY,         /*!< Signal delay */
+    SAT_LIST_COL_MA,            /*!< Mean Anomaly. */
+    SAT_LIST_COL_PHASE,         /*!< Phase. */
+    SAT_LIST_COL_ORBIT,         /*!< Orbit Number. */
+    SAT_LIST_COL_VISIBILITY,    /*!< Visibility. */
+    SAT_LIST_COL_DECAY,         /*!< Whether the satellite is decayed or not. */
+    SAT_LIST_COL_STAT_OPERATIONAL, /*!< Operational Status . */
+    SAT_LIST_COL_BOLD,          /*!< Used to render the satellites above the horizon bold. */
+    SAT_LIST_COL_NUMBER
+} sat_list_col_t;
+
+/** Column Flags */
+typedef enum {
+    SAT_LIST_FLAG_NAME = 1 << SAT_LIST_COL_NAME,        /*!< Satellite name. */
+    SAT_LIST_FLAG_CATNUM = 1 << SAT_LIST_COL_CATNUM,
+    SAT_LIST_FLAG_AZ = 1 << SAT_LIST_COL_AZ,    /*!< Azimuth. */
+    SAT_LIST_FLAG_EL = 1 << SAT_LIST_COL_EL,    /*!< Elvation. */
+    SAT_LIST_FLAG_DIR = 1 << SAT_LIST_COL_DIR,  /*!< Direction */
+    SAT_LIST_FLAG_RA = 1 << SAT_LIST_COL_RA,    /*!< Right Ascension. */
+    SAT_LIST_FLAG_DEC = 1 << SAT_LIST_COL_DEC,  /*!< Declination. */
+    SAT_LIST_FLAG_RANGE = 1 << SAT_LIST_COL_RANGE,      /*!< Range. */
+    SAT_LIST_FLAG_RANGE_RATE = 1 << SAT_LIST_COL_RANGE_RATE,    /*!< Range rate. */
+    SAT_LIST_FLAG_NEXT_EVENT = 1 << SAT_LIST_COL_NEXT_EVENT,    /*!< Next event. */
+    SAT_LIST_FLAG_AOS = 1 << SAT_LIST_COL_AOS,  /*!< Next AOS. */
+    SAT_LIST_FLAG_LOS = 1 << SAT_LIST_COL_LOS,  /*!< Next LOS. */
+    SAT_LIST_FLAG_LAT = 1 << SAT_LIST_COL_LAT,  /*!< Latitude. */
+    SAT_LIST_FLAG_LON = 1 << SAT_LIST_COL_LON,  /*!< Longitude. */
+    SAT_LIST_FLAG_SSP = 1 << SAT_LIST_COL_SSP,  /*!< SSP grid square */
+    SAT_LIST_FLAG_FOOTPRINT = 1 << SAT_LIST_COL_FOOTPRINT,      /*!< Footprint. */
+    SAT_LIST_FLAG_ALT = 1 << SAT_LIST_COL_ALT,  /*!< Altitude. */
+    SAT_LIST_FLAG_VEL = 1 << SAT_LIST_COL_VEL,  /*!< Velocity. */
+    SAT_LIST_FLAG_DOPPLER = 1 << SAT_LIST_COL_DOPPLER,  /*!< Doppler shift. */
+    SAT_LIST_FLAG_LOSS = 1 << SAT_LIST_COL_LOSS,        /*!< Path Loss. */
+    SAT_LIST_FLAG_DELAY = 1 << SAT_LIST_COL_DELAY,      /*!< Delay */
+    SAT_LIST_FLAG_MA = 1 << SAT_LIST_COL_MA,    /*!< Mean Anomaly. */
+    SAT_LIST_FLAG_PHASE = 1 << SAT_LIST_COL_PHASE,      /*!< Phase. */
+    SAT_LIST_FLAG_ORBIT = 1 << SAT_LIST_COL_ORBIT,      /*!< Orbit Number. */
+    SAT_LIST_FLAG_VISIBILITY = 1 << SAT_LIST_COL_VISIBILITY,    /*!< Visibility. */
+    SAT_LIST_FLAG_STAT_OPERATIONAL = 1 << SAT_LIST_COL_STAT_OPERATIONAL, /*!< Operational Status . */
+    SAT_LIST_FLAG_DECAY = 1 << SAT_LIST_COL_DECAY      /*!< Decayed. */
+} sat_list_flag_t;
+
+
+/* Single satellite view (gtk-single-sat.h) */
+
+/** Symbolic references to columns */
+typedef enum {
+    SINGLE_SAT_FIELD_AZ = 0,    /*!< Azimuth. */
+    SINGLE_SAT_FIELD_EL,        /*!< Elvation. */
+    SINGLE_SAT_FIELD_DIR,       /*!< Direction, satellite on its way up or down. */
+    SINGLE_SAT_FIELD_RA,        /*!< Right Ascension. */
+    SINGLE_SAT_FIELD_DEC,       /*!< Declination. */
+    SINGLE_SAT_FIELD_RANGE,     /*!< Range. */
+    SINGLE_SAT_FIELD_RANGE_RATE,        /*!< Range rate. */
+    SINGLE_SAT_FIELD_NEXT_EVENT,        /*!< Next event AOS or LOS depending on El. */
+    SINGLE_SAT_FIELD_AOS,       /*!< Next AOS regardless of El. */
+    SINGLE_SAT_FIELD_LOS,       /*!< Next LOS regardless of El. */
+    SINGLE_SAT_FIELD_LAT,       /*!< Latitude. */
+    SINGLE_SAT_FIELD_LON,       /*!< Longitude. */
+    SINGLE_SAT_FIELD_SSP,       /*!< Sub satellite point grid square */
+    SINGLE_SAT_FIELD_FOOTPRINT, /*!< Footprint. */
+    SINGLE_SAT_FIELD_ALT,       /*!< Altitude. */
+    SINGLE_SAT_FIELD_VEL,       /*!< Velocity. */
+    SINGLE_SAT_FIELD_DOPPLER,   /*!< Doppler shift at 100 MHz. */
+    SINGLE_SAT_FIELD_LOSS,      /*!< Path Loss at 100 MHz. */
+    SINGLE_SAT_FIELD_DELAY,     /*!< Signal delay */
+    SINGLE_SAT_FIELD_MA,        /*!< Mean Anomaly. */
+    SINGLE_SAT_FIELD_PHASE,     /*!< Phase. */
+    SINGLE_SAT_FIELD_ORBIT,     /*!< Orbit Number. */
+    SINGLE_SAT_FIELD_VISIBILITY,        /*!< Visibility. */
+    SINGLE_SAT_FIELD_NUMBER
+} single_sat_field_t;
+
+/** Fieldnum Flags */
+typedef enum {
+    SINGLE_SAT_FLAG_AZ = 1 << SINGLE_SAT_FIELD_AZ,      /*!< Azimuth. */
+    SINGLE_SAT_FLAG_EL = 1 << SINGLE_SAT_FIELD_EL,      /*!< Elvation. */
+    SINGLE_SAT_FLAG_DIR = 1 << SINGLE_SAT_FIELD_DIR,    /*!< Direction */
+    SINGLE_SAT_FLAG_RA = 1 << SINGLE_SAT_FIELD_RA,      /*!< Right Ascension. */
+    SINGLE_SAT_FLAG_DEC = 1 << SINGLE_SAT_FIELD_DEC,    /*!< Declination. */
+    SINGLE_SAT_FLAG_RANGE = 1 << SINGLE_SAT_FIELD_RANGE,        /*!< Range. */
+    SINGLE_SAT_FLAG_RANGE_RATE = 1 << SINGLE_SAT_FIELD_RANGE_RATE,      /*!< Range rate. */
+    SINGLE_SAT_FLAG_NEXT_EVENT = 1 << SINGLE_SAT_FIELD_NEXT_EVENT,      /*!< Next event. */
+    SINGLE_SAT_FLAG_AOS = 1 << SINGLE_SAT_FIELD_AOS,    /*!< Next AOS. */
+    SINGLE_SAT_FLAG_LOS = 1 << SINGLE_SAT_FIELD_LOS,    /*!< Next LOS. */
+    SINGLE_SAT_FLAG_LAT = 1 << SINGLE_SAT_FIELD_LAT,    /*!< Latitude. */
+    SINGLE_SAT_FLAG_LON = 1 << SINGLE_SAT_FIELD_LON,    /*!< Longitude. */
+    SINGLE_SAT_FLAG_SSP = 1 << SINGLE_SAT_FIELD_SSP,    /*!< SSP grid square */
+    SINGLE_SAT_FLAG_FOOTPRINT = 1 << SINGLE_SAT_FIELD_FOOTPRINT,        /*!< Footprint. */
+    SINGLE_SAT_FLAG_ALT = 1 << SINGLE_SAT_FIELD_ALT,    /*!< Altitude. */
+    SINGLE_SAT_FLAG_VEL = 1 << SINGLE_SAT_FIELD_VEL,    /*!< Velocity. */
+    SINGLE_SAT_FLAG_DOPPLER = 1 << SINGLE_SAT_FIELD_DOPPLER,    /*!< Doppler shift. */
+    SINGLE_SAT_FLAG_LOSS = 1 << SINGLE_SAT_FIELD_LOSS,  /*!< Path Loss. */
+    SINGLE_SAT_FLAG_DELAY = 1 << SINGLE_SAT_FIELD_DELAY,        /*!< Delay */
+    SINGLE_SAT_FLAG_MA = 1 << SINGLE_SAT_FIELD_MA,      /*!< Mean Anomaly. */
+    SINGLE_SAT_FLAG_PHASE = 1 << SINGLE_SAT_FIELD_PHASE,        /*!< Phase. */
+    SINGLE_SAT_FLAG_ORBIT = 1 << SINGLE_SAT_FIELD_ORBIT,        /*!< Orbit Number. */
+    SINGLE_SAT_FLAG_VISIBILITY = 1 << SINGLE_SAT_FIELD_VISIBILITY       /*!< Visibility. */
+} single_sat_flag_t;
+
+
+/* Pass listings (sat-pass-dialogs.h) */
+
+/** Column definitions for multi-pass listings. */
+typedef enum {
+    MULTI_PASS_COL_AOS_TIME = 0,        /*!< AOS time. */
+    MULTI_PASS_COL_TCA,         /*!< Time of closest approach. */
+    MULTI_PASS_COL_LOS_TIME,    /*!< LOS time. */
+    MULTI_PASS_COL_DURATION,    /*!< Duration. */
+    MULTI_PASS_COL_MAX_EL,      /*!< Maximum elevation. */
+    MULTI_PASS_COL_AOS_AZ,      /*!< Azimuth at AOS. */
+    MULTI_PASS_COL_MAX_EL_AZ,   /*!< Azimuth at max el. */
+    MULTI_PASS_COL_LOS_AZ,      /*!< Azimuth at LOS. */
+    MULTI_PASS_COL_ORBIT,       /*!< Orbit number. */
+    MULTI_PASS_COL_VIS,         /*!< Visibility. */
+    MULTI_PASS_COL_NUMBER
+} multi_pass_col_t;
+
+/** Column flags for multi-pass listings. */
+typedef enum {
+    MULTI_PASS_FLAG_AOS_TIME = 1 << MULTI_PASS_COL_AOS_TIME,    /*!< AOS time. */
+    MULTI_PASS_FLAG_TCA = 1 << MULTI_PASS_COL_TCA,      /*!< Time of closest approach. */
+    MULTI_PASS_FLAG_LOS_TIME = 1 << MULTI_PASS_COL_LOS_TIME,    /*!< LOS time. */
+    MULTI_PASS_FLAG_DURATION = 1 << MULTI_PASS_COL_DURATION,    /*!< Duration. */
+    MULTI_PASS_FLAG_MAX_EL = 1 << MULTI_PASS_COL_MAX_EL,        /*!< Maximum elevation. */
+    MULTI_PASS_FLAG_AOS_AZ = 1 << MULTI_PASS_COL_AOS_AZ,        /*!< Azimuth at AOS. */
+    MULTI_PASS_FLAG_MAX_EL_AZ = 1 << MULTI_PASS_COL_MAX_EL_AZ,  /*!< Azimuth at max el. */
+    MULTI_PASS_FLAG_LOS_AZ = 1 << MULTI_PASS_COL_LOS_AZ,        /*!< Azimuth at LOS. */
+    MULTI_PASS_FLAG_ORBIT = 1 << MULTI_PASS_COL_ORBIT,  /*!< Orbit number. */
+    MULTI_PASS_FLAG_VIS = 1 << MULTI_PASS_COL_VIS       /*!< Visibility. */
+} multi_pass_flag_t;
+
+/** Column definition for single-pass listings. */
+typedef enum {
+    SINGLE_PASS_COL_TIME = 0,
+    SINGLE_PASS_COL_AZ,         /*!< Azimuth. */
+    SINGLE_PASS_COL_EL,         /*!< Elvation. */
+    SINGLE_PASS_COL_RA,         /*!< Right Ascension. */
+    SINGLE_PASS_COL_DEC,        /*!< Declination. */
+    SINGLE_PASS_COL_RANGE,      /*!< Range. */
+    SINGLE_PASS_COL_RANGE_RATE, /*!< Range rate. */
+    SINGLE_PASS_COL_LAT,        /*!< Latitude. */
+    SINGLE_PASS_COL_LON,        /*!< Longitude. */
+    SINGLE_PASS_COL_SSP,        /*!< Sub satellite point grid square */
+    SINGLE_PASS_COL_FOOTPRINT,  /*!< Footprint. */
+    SINGLE_PASS_COL_ALT,        /*!< Altitude. */
+    SINGLE_PASS_COL_VEL,        /*!< Velocity. */
+    SINGLE_PASS_COL_DOPPLER,    /*!< Doppler shift at 100 MHz. */
+    SINGLE_PASS_COL_LOSS,       /*!< Path Loss at 100 MHz. */
+    SINGLE_PASS_COL_DELAY,      /*!< Signal delay */
+    SINGLE_PASS_COL_MA,         /*!< Mean Anomaly. */
+    SINGLE_PASS_COL_PHASE,      /*!< Phase. */
+    SINGLE_PASS_COL_VIS,        /*!< Visibility. */
+    SINGLE_PASS_COL_NUMBER
+} single_pass_col_t;
+
+/** Column flags for single-pass listings. */
+typedef enum {
+    SINGLE_PASS_FLAG_TIME = 1 << SINGLE_PASS_COL_TIME,
+    SINGLE_PASS_FLAG_AZ = 1 << SINGLE_PASS_COL_AZ,      /*!< Azimuth. */
+    SINGLE_PASS_FLAG_EL = 1 << SINGLE_PASS_COL_EL,      /*!< Elvation. */
+    SINGLE_PASS_FLAG_RA = 1 << SINGLE_PASS_COL_RA,      /*!< Right Ascension. */
+    SINGLE_PASS_FLAG_DEC = 1 << SINGLE_PASS_COL_DEC,    /*!< Declination. */
+    SINGLE_PASS_FLAG_RANGE = 1 << SINGLE_PASS_COL_RANGE,        /*!< Range. */
+    SINGLE_PASS_FLAG_RANGE_RATE = 1 << SINGLE_PASS_COL_RANGE_RATE,      /*!< Range rate. */
+    SINGLE_PASS_FLAG_LAT = 1 << SINGLE_PASS_COL_LAT,    /*!< Latitude. */
+    SINGLE_PASS_FLAG_LON = 1 << SINGLE_PASS_COL_LON,    /*!< Longitude. */
+    SINGLE_PASS_FLAG_SSP = 1 << SINGLE_PASS_COL_SSP,    /*!< Sub satellite point grid square */
+    SINGLE_PASS_FLAG_FOOTPRINT = 1 << SINGLE_PASS_COL_FOOTPRINT,        /*!< Footprint. */
+    SINGLE_PASS_FLAG_ALT = 1 << SINGLE_PASS_COL_ALT,    /*!< Altitude. */
+    SINGLE_PASS_FLAG_VEL = 1 << SINGLE_PASS_COL_VEL,    /*!< Velocity. */
+    SINGLE_PASS_FLAG_DOPPLER = 1 << SINGLE_PASS_COL_DOPPLER,    /*!< Doppler shift at 100 MHz. */
+    SINGLE_PASS_FLAG_LOSS = 1 << SINGLE_PASS_COL_LOSS,  /*!< Path Loss at 100 MHz. */
+    SINGLE_PASS_FLAG_DELAY = 1 << SINGLE_PASS_COL_DELAY,        /*!< Signal delay */
+    SINGLE_PASS_FLAG_MA = 1 << SINGLE_PASS_COL_MA,      /*!< Mean Anomaly. */
+    SINGLE_PASS_FLAG_PHASE = 1 << SINGLE_PASS_COL_PHASE,        /*!< Phase. */
+    SINGLE_PASS_FLAG_VIS = 1 << SINGLE_PASS_COL_VIS     /*!< Visibility. */
+} single_pass_flag_t;
+
+#endif